@@ -0,0 +1,335 @@
+/*  Plate solving cache test.
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "ekos/align/solvecache.h"
+
+#include <QtTest>
+
+#include <QElapsedTimer>
+#include <QObject>
+
+#include <cmath>
+#include <random>
+
+using Ekos::SolveCache;
+
+// Random stars on the sky around a position, seen through frames of known solution.
+class SkyField
+{
+    public:
+        static constexpr int Width { 1280 };
+        static constexpr int Height { 1024 };
+        static constexpr double PixScale { 1.8 };
+
+        SkyField(double ra, double dec, double radius, int count, unsigned int seed) : m_Generator(seed)
+        {
+            std::uniform_real_distribution<double> uniform(-1, 1);
+            std::uniform_real_distribution<double> magnitude(0, 1);
+            for (int i = 0; i < count; ++i)
+            {
+                Star star;
+                star.dec = dec + radius * uniform(m_Generator);
+                star.ra = ra + radius * uniform(m_Generator) / std::cos(star.dec * M_PI / 180);
+                // Many faint stars, few bright ones
+                star.flux = 1000 * std::pow(magnitude(m_Generator), -1.5);
+                m_Stars.append(star);
+            }
+        }
+
+        // Detected stars on a frame of the given solution, with a little centroid noise.
+        QVector<SolveCache::Star> detect(const SolveCache::Solution &solution)
+        {
+            std::normal_distribution<double> noise(0, 0.3);
+            QVector<SolveCache::Star> detected;
+            for (const Star &star : m_Stars)
+            {
+                double x = 0, y = 0;
+                if (!solution.skyToPixel(star.ra, star.dec, &x, &y))
+                    continue;
+                x += noise(m_Generator);
+                y += noise(m_Generator);
+                if (x >= 0 && y >= 0 && x < solution.width && y < solution.height)
+                    detected.append(SolveCache::Star(x, y, star.flux));
+            }
+            return detected;
+        }
+
+        static SolveCache::Solution frame(double ra, double dec, double orientation, int parity = 1)
+        {
+            return SolveCache::Solution(ra, dec, orientation, PixScale, Width, Height, parity);
+        }
+
+    private:
+        struct Star
+        {
+            double ra { 0 };
+            double dec { 0 };
+            double flux { 0 };
+        };
+
+        QVector<Star> m_Stars;
+        std::mt19937 m_Generator;
+};
+
+class TestSolveCache : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestSolveCache() = default;
+
+        /** @short Destructor */
+        ~TestSolveCache() override = default;
+
+    private slots:
+        void projectionTest_data();
+        void projectionTest();
+        void lookupTest_data();
+        void lookupTest();
+        void missTest();
+        void evictionTest();
+        void statisticsTest();
+
+    private:
+        // Adds two overlapping frames to the cache, solved with the given parity.
+        static void prime(SolveCache &cache, SkyField &field, int parity);
+};
+
+#include "test_solvecache.moc"
+
+namespace
+{
+SolveCache::Hint makeHint(double ra, double dec, double orientation = SolveCache::INVALID_ORIENTATION)
+{
+    SolveCache::Hint hint;
+    hint.ra = ra;
+    hint.dec = dec;
+    hint.radius = 2;
+    hint.pixscale = SkyField::PixScale;
+    hint.orientation = orientation;
+    return hint;
+}
+}
+
+void TestSolveCache::prime(SolveCache &cache, SkyField &field, int parity)
+{
+    const SolveCache::Solution first = SkyField::frame(83.8, -5.4, 12, parity);
+    cache.insert(first, field.detect(first));
+
+    const SolveCache::Solution second = SkyField::frame(83.9, -5.35, 15, parity);
+    cache.insert(second, field.detect(second));
+    QCOMPARE(cache.count(), 2);
+}
+
+void TestSolveCache::projectionTest_data()
+{
+    QTest::addColumn<double>("RA");
+    QTest::addColumn<double>("DEC");
+    QTest::addColumn<double>("ORIENTATION");
+    QTest::addColumn<int>("PARITY");
+
+    QTest::newRow("equator") << 83.8 << -5.4 << 12.0 << 1;
+    QTest::newRow("mirrored") << 83.8 << -5.4 << 12.0 << -1;
+    QTest::newRow("RA wrap") << 359.9 << 40.0 << -135.0 << 1;
+    QTest::newRow("near the pole") << 10.0 << 89.8 << 170.0 << -1;
+}
+
+void TestSolveCache::projectionTest()
+{
+    QFETCH(double, RA);
+    QFETCH(double, DEC);
+    QFETCH(double, ORIENTATION);
+    QFETCH(int, PARITY);
+
+    const SolveCache::Solution solution = SkyField::frame(RA, DEC, ORIENTATION, PARITY);
+
+    // The center of the frame is the solution
+    double ra = 0, dec = 0;
+    solution.pixelToSky(SkyField::Width / 2.0, SkyField::Height / 2.0, &ra, &dec);
+    QVERIFY(std::fabs(std::remainder(ra - RA, 360)) * std::cos(DEC * M_PI / 180) < 1e-9);
+    QVERIFY(std::fabs(dec - DEC) < 1e-9);
+
+    // Pixels go to the sky and back
+    for (double y : {0.0, 300.5, 1023.0})
+    {
+        for (double x : {0.0, 700.25, 1279.0})
+        {
+            double px = 0, py = 0;
+            solution.pixelToSky(x, y, &ra, &dec);
+            QVERIFY(solution.skyToPixel(ra, dec, &px, &py));
+            QVERIFY(std::fabs(px - x) < 1e-6);
+            QVERIFY(std::fabs(py - y) < 1e-6);
+        }
+    }
+
+    // The orientation is the position angle of the top of the frame, with east on the left if not mirrored
+    double northRA = 0, northDec = 0, eastRA = 0, eastDec = 0;
+    const SolveCache::Solution up = SkyField::frame(RA, DEC, 0, PARITY);
+    up.pixelToSky(SkyField::Width / 2.0, 0, &northRA, &northDec);
+    up.pixelToSky(0, SkyField::Height / 2.0, &eastRA, &eastDec);
+    QVERIFY(northDec > DEC);
+    QVERIFY(std::remainder(eastRA - RA, 360) * PARITY > 0);
+
+    // The opposite hemisphere is not on the frame
+    double x = 0, y = 0;
+    QVERIFY(!solution.skyToPixel(RA + 180, -DEC, &x, &y));
+}
+
+void TestSolveCache::lookupTest_data()
+{
+    QTest::addColumn<double>("RA");
+    QTest::addColumn<double>("DEC");
+    QTest::addColumn<double>("ORIENTATION");
+    QTest::addColumn<bool>("KNOWN_ORIENTATION");
+    QTest::addColumn<int>("PARITY");
+
+    QTest::newRow("same frame") << 83.8 << -5.4 << 12.0 << true << 1;
+    QTest::newRow("offset") << 83.95 << -5.25 << 12.0 << true << 1;
+    QTest::newRow("offset and rotated") << 83.7 << -5.5 << 20.0 << true << 1;
+    QTest::newRow("unknown orientation") << 83.85 << -5.3 << 95.0 << false << 1;
+    QTest::newRow("mirrored") << 83.9 << -5.45 << 10.0 << true << -1;
+    QTest::newRow("mirrored, unknown orientation") << 83.75 << -5.35 << -60.0 << false << -1;
+}
+
+void TestSolveCache::lookupTest()
+{
+    QFETCH(double, RA);
+    QFETCH(double, DEC);
+    QFETCH(double, ORIENTATION);
+    QFETCH(bool, KNOWN_ORIENTATION);
+    QFETCH(int, PARITY);
+
+    SkyField field(83.8, -5.4, 1.5, 6000, 1);
+    SolveCache cache;
+    prime(cache, field, PARITY);
+
+    // The mount reports a position a little off the actual one
+    const SolveCache::Solution actual = SkyField::frame(RA, DEC, ORIENTATION, PARITY);
+    const SolveCache::Hint hint = makeHint(RA + 0.3, DEC - 0.2, KNOWN_ORIENTATION ? ORIENTATION + 4 :
+                                           SolveCache::INVALID_ORIENTATION);
+    SolveCache::Solution solution;
+    QVERIFY(cache.lookup(field.detect(actual), SkyField::Width, SkyField::Height, hint, &solution));
+
+    // Within a pixel of the actual solution
+    const double raError = std::remainder(solution.ra - RA, 360) * std::cos(DEC * M_PI / 180) * 3600;
+    const double decError = (solution.dec - DEC) * 3600;
+    QVERIFY2(std::hypot(raError, decError) < SkyField::PixScale,
+             qPrintable(QString("RA error %1\" DEC error %2\"").arg(raError).arg(decError)));
+    QVERIFY(std::fabs(std::remainder(solution.orientation - ORIENTATION, 360)) < 0.1);
+    QVERIFY(std::fabs(solution.pixscale - SkyField::PixScale) < 0.01);
+    QCOMPARE(solution.width, static_cast<int>(SkyField::Width));
+    QCOMPARE(solution.height, static_cast<int>(SkyField::Height));
+    QCOMPARE(solution.parity, PARITY);
+}
+
+void TestSolveCache::missTest()
+{
+    SkyField field(83.8, -5.4, 1.5, 6000, 2);
+    SolveCache cache;
+    SolveCache::Solution solution;
+
+    // Nothing matches an empty cache
+    const SolveCache::Solution first = SkyField::frame(83.8, -5.4, 12);
+    QVERIFY(!cache.lookup(field.detect(first), SkyField::Width, SkyField::Height, makeHint(83.8, -5.4), &solution));
+
+    prime(cache, field, 1);
+
+    // Far from the hint
+    SkyField elsewhere(120, 30, 1.5, 6000, 3);
+    const SolveCache::Solution far = SkyField::frame(120, 30, 12);
+    QVERIFY(!cache.lookup(elsewhere.detect(far), SkyField::Width, SkyField::Height, makeHint(120, 30), &solution));
+
+    // Another field, at a wrong hint
+    QVERIFY(!cache.lookup(elsewhere.detect(far), SkyField::Width, SkyField::Height, makeHint(83.8, -5.4), &solution));
+
+    // A mirrored frame is not a rotation of the cached ones
+    const SolveCache::Solution mirrored = SkyField::frame(83.85, -5.4, 12, -1);
+    QVERIFY(!cache.lookup(field.detect(mirrored), SkyField::Width, SkyField::Height, makeHint(83.8, -5.4), &solution));
+
+    // Another pixel scale
+    SolveCache::Solution zoomed = SkyField::frame(83.85, -5.4, 12);
+    zoomed.pixscale = 2.5;
+    QVERIFY(!cache.lookup(field.detect(zoomed), SkyField::Width, SkyField::Height, makeHint(83.8, -5.4), &solution));
+
+    // Too few stars
+    QVector<SolveCache::Star> stars = field.detect(first);
+    stars.resize(SolveCache::MinMatches - 1);
+    QVERIFY(!cache.lookup(stars, SkyField::Width, SkyField::Height, makeHint(83.8, -5.4), &solution));
+
+    cache.clear();
+    QCOMPARE(cache.count(), 0);
+}
+
+void TestSolveCache::evictionTest()
+{
+    SkyField field(84, -5.4, 3, 24000, 4);
+    SolveCache cache(3);
+    prime(cache, field, 1);
+
+    // The first frame is used again, then two more frames push out the second one
+    SolveCache::Solution solution;
+    const SolveCache::Solution first = SkyField::frame(83.8, -5.4, 12);
+    QVERIFY(cache.lookup(field.detect(first), SkyField::Width, SkyField::Height, makeHint(83.8, -5.4, 12), &solution));
+    for (double ra : {85.0, 86.0})
+    {
+        const SolveCache::Solution frame = SkyField::frame(ra, -5.4, 12);
+        cache.insert(frame, field.detect(frame));
+    }
+    QCOMPARE(cache.count(), 3);
+
+    // The second frame was forgotten, and the first one is outside the search radius
+    SolveCache::Hint hint = makeHint(83.95, -5.3, 15);
+    hint.radius = 0.1;
+    const SolveCache::Solution second = SkyField::frame(83.95, -5.3, 15);
+    QVERIFY(!cache.lookup(field.detect(second), SkyField::Width, SkyField::Height, hint, &solution));
+    QVERIFY(cache.lookup(field.detect(first), SkyField::Width, SkyField::Height, makeHint(83.8, -5.4, 12), &solution));
+}
+
+void TestSolveCache::statisticsTest()
+{
+    SkyField field(83.8, -5.4, 1.5, 6000, 5);
+    SolveCache cache;
+    prime(cache, field, 1);
+    cache.recordSolve(false, 4000);
+    cache.recordSolve(false, 6000);
+
+    SolveCache::Solution solution;
+    for (int i = 0; i < 4; ++i)
+    {
+        const SolveCache::Solution frame = SkyField::frame(83.8 + 0.05 * i, -5.4, 12 + i);
+        QElapsedTimer timer;
+        timer.start();
+        const bool hit = cache.lookup(field.detect(frame), SkyField::Width, SkyField::Height, makeHint(83.8, -5.4, 12), &solution);
+        cache.recordSolve(hit, timer.elapsed());
+        QVERIFY(hit);
+    }
+    SkyField elsewhere(120, 30, 1.5, 6000, 6);
+    QVERIFY(!cache.lookup(elsewhere.detect(SkyField::frame(120, 30, 12)), SkyField::Width, SkyField::Height,
+                          makeHint(83.8, -5.4), &solution));
+
+    // A lookup that cannot be attempted is not counted
+    QVector<SolveCache::Star> stars = field.detect(SkyField::frame(83.8, -5.4, 12));
+    stars.resize(SolveCache::MinMatches - 1);
+    QVERIFY(!cache.lookup(stars, SkyField::Width, SkyField::Height, makeHint(83.8, -5.4), &solution));
+
+    const SolveCache::Statistics &statistics = cache.statistics();
+    qInfo() << QString("%1 hits in %2 lookups, %3 ms from the cache, %4 ms from the solver")
+            .arg(statistics.hits).arg(statistics.lookups)
+            .arg(statistics.averageCachedMilliseconds()).arg(statistics.averageSolverMilliseconds());
+    QCOMPARE(statistics.lookups, 5);
+    QCOMPARE(statistics.hits, 4);
+    QCOMPARE(statistics.hitRate(), 0.8);
+    QCOMPARE(statistics.cachedSolves, 4);
+    QCOMPARE(statistics.solverSolves, 2);
+    QCOMPARE(statistics.averageSolverMilliseconds(), 5000.0);
+    QVERIFY(statistics.averageCachedMilliseconds() < statistics.averageSolverMilliseconds());
+}
+
+QTEST_GUILESS_MAIN(TestSolveCache)
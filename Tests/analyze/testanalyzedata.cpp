@@ -0,0 +1,199 @@
+/*  Analyze data structures test.
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "ekos/analyze/intervaltree.h"
+#include "ekos/analyze/timeseries.h"
+
+#include <QtTest>
+
+#include <QObject>
+#include <cmath>
+#include <random>
+
+class TestAnalyzeData : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestAnalyzeData() = default;
+
+        /** @short Destructor */
+        ~TestAnalyzeData() override = default;
+
+    private slots:
+        void intervalTreeTest();
+        void timeSeriesSearchTest();
+        void decimateTest();
+        void decimateBenchmark();
+};
+
+#include "testanalyzedata.moc"
+
+using Ekos::IntervalTree;
+using Ekos::TimeSeries;
+
+namespace
+{
+struct Interval
+{
+    double start;
+    double end;
+    int id;
+};
+
+// Random walk with a few gaps, like guide errors.
+TimeSeries makeSeries(int size)
+{
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> step(-0.5, 0.5);
+    TimeSeries series;
+    double value = 0;
+    for (int i = 0; i < size; ++i)
+    {
+        value += step(rng);
+        series.append(i * 0.5, (i % 997 == 500) ? qQNaN() : value);
+    }
+    return series;
+}
+}  // namespace
+
+void TestAnalyzeData::intervalTreeTest()
+{
+    std::mt19937 rng(2);
+    auto uniform = [&rng](double max)
+    {
+        return std::uniform_real_distribution<double>(0, max)(rng);
+    };
+    IntervalTree<Interval> tree;
+    QVector<Interval> all;
+    // Mostly consecutive sessions, with some overlapping and out of order ones.
+    double t = 0;
+    for (int i = 0; i < 1000; ++i)
+    {
+        Interval interval;
+        if (i % 50 == 49)
+            interval.start = uniform(t);
+        else
+            interval.start = t + uniform(10.0);
+        interval.end = interval.start + uniform(100.0);
+        interval.id = i;
+        t = interval.start;
+        tree.add(interval);
+        all.append(interval);
+    }
+    QCOMPARE(tree.size(), all.size());
+
+    for (int q = 0; q < 2000; ++q)
+    {
+        const double time = uniform(t + 200);
+        const QList<Interval> found = tree.find(time);
+        int expected = 0;
+        for (const auto &interval : all)
+            if (interval.start <= time && time <= interval.end)
+                expected++;
+        QCOMPARE(found.size(), expected);
+        for (int i = 0; i < found.size(); ++i)
+        {
+            QVERIFY(found[i].start <= time && time <= found[i].end);
+            if (i > 0)
+                QVERIFY(found[i - 1].start <= found[i].start);
+        }
+    }
+
+    tree.clear();
+    QCOMPARE(tree.find(10).size(), 0);
+}
+
+void TestAnalyzeData::timeSeriesSearchTest()
+{
+    TimeSeries series;
+    series.append(1, 10);
+    series.append(3, 30);
+    series.append(2, 20);
+    series.append(4, 40);
+    QCOMPARE(series.size(), 4);
+    QCOMPARE(series.time(1), 2.0);
+    QCOMPARE(series.value(1), 20.0);
+
+    QCOMPARE(series.findBegin(0), 0);
+    QCOMPARE(series.findBegin(2), 0);
+    QCOMPARE(series.findBegin(2.5), 1);
+    QCOMPARE(series.findEnd(2.5), 3);
+    QCOMPARE(series.findEnd(3), 4);
+    QCOMPARE(series.findEnd(10), 4);
+
+    const quint64 revision = series.revision();
+    series.clear();
+    QVERIFY(series.isEmpty());
+    QVERIFY(series.revision() != revision);
+}
+
+void TestAnalyzeData::decimateTest()
+{
+    const TimeSeries series = makeSeries(200000);
+    const double start = 10000, end = 60000;
+    const int pixels = 800;
+    QVector<double> keys, values;
+    series.decimate(start, end, pixels, &keys, &values);
+
+    QVERIFY(keys.size() <= 5 * pixels + 10);
+    QCOMPARE(keys.size(), values.size());
+    for (int i = 1; i < keys.size(); ++i)
+        QVERIFY(keys[i - 1] < keys[i]);
+
+    // The first and last samples reach past the range.
+    QVERIFY(keys.first() < start);
+    QVERIFY(keys.last() > end);
+
+    // Every pixel column has the same extremes and gaps as the full data.
+    const double columnWidth = (end - start) / pixels;
+    auto column = [&](double t)
+    {
+        return static_cast<int>(std::floor((t - start) / columnWidth));
+    };
+    QMap<int, QPair<double, double>> expected, actual;
+    QSet<int> expectedGaps, actualGaps;
+    auto accumulate = [&](QMap<int, QPair<double, double>> &extremes, QSet<int> &gaps, double t, double v)
+    {
+        const int c = column(t);
+        if (qIsNaN(v))
+        {
+            gaps.insert(c);
+            return;
+        }
+        auto it = extremes.find(c);
+        if (it == extremes.end())
+            extremes.insert(c, qMakePair(v, v));
+        else
+            *it = qMakePair(std::min(it->first, v), std::max(it->second, v));
+    };
+    for (int i = series.findBegin(start); i < series.findEnd(end); ++i)
+        accumulate(expected, expectedGaps, series.time(i), series.value(i));
+    for (int i = 0; i < keys.size(); ++i)
+        accumulate(actual, actualGaps, keys[i], values[i]);
+    QCOMPARE(actual, expected);
+    QCOMPARE(actualGaps, expectedGaps);
+
+    // Small ranges are drawn as is.
+    series.decimate(1000, 1010, pixels, &keys, &values);
+    QCOMPARE(keys.size(), series.findEnd(1010) - series.findBegin(1000));
+}
+
+void TestAnalyzeData::decimateBenchmark()
+{
+    const TimeSeries series = makeSeries(1000000);
+    QVector<double> keys, values;
+    QBENCHMARK
+    {
+        series.decimate(0, 500000, 1000, &keys, &values);
+    }
+}
+
+QTEST_GUILESS_MAIN(TestAnalyzeData)
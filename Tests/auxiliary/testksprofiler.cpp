@@ -0,0 +1,145 @@
+/*  KStars profiler tests
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "testksprofiler.h"
+
+#include "auxiliary/cachingdms.h"
+#include "auxiliary/ksprofiler.h"
+
+#include <thread>
+#include <vector>
+
+namespace
+{
+KSProfiler::Statistic find(const QString &name)
+{
+    for (const auto &s : KSProfiler::Registry::Instance()->statistics())
+        if (s.name == name)
+            return s;
+    return KSProfiler::Statistic();
+}
+}
+
+TestKSProfiler::TestKSProfiler(QObject *parent) : QObject(parent)
+{
+}
+
+void TestKSProfiler::cleanup()
+{
+    KSProfiler::Registry::Instance()->setEnabled(false);
+    KSProfiler::Registry::Instance()->reset();
+}
+
+void TestKSProfiler::testDisabled()
+{
+    KSProfiler::Registry *registry = KSProfiler::Registry::Instance();
+    registry->reset();
+
+    QVERIFY(!KSProfiler::isEnabled());
+    dms angle(30);
+    for (int i = 0; i < 10; ++i)
+        QVERIFY(angle.sin() > 0);
+
+    // Disabling aggregates the counters
+    registry->setEnabled(true);
+    registry->setEnabled(false);
+
+    QCOMPARE(find("dms/trig").calls, 0ull);
+}
+
+void TestKSProfiler::testCounters()
+{
+    KSProfiler::Registry *registry = KSProfiler::Registry::Instance();
+    registry->reset();
+    registry->setEnabled(true);
+
+    dms angle(30);
+    for (int i = 0; i < 10; ++i)
+        QVERIFY(angle.sin() > 0);
+
+    CachingDms cached(30);
+    for (int i = 0; i < 3; ++i)
+        QVERIFY(cached.cos() > 0);
+
+    const int timerCounter = KSProfiler::counter("test/timer");
+    {
+        KSProfiler::ScopedTimer timer(timerCounter);
+        QThread::msleep(5);
+    }
+
+    registry->setEnabled(false);
+
+    // Constructing the CachingDms computes its sine and cosine too
+    QCOMPARE(find("dms/trig").calls, 11ull);
+    QCOMPARE(find("CachingDms/computed").calls, 1ull);
+    QCOMPARE(find("CachingDms/cacheHits").calls, 3ull);
+
+    const KSProfiler::Statistic timer = find("test/timer");
+    QCOMPARE(timer.calls, 1ull);
+    QVERIFY(timer.seconds >= 0.004);
+
+    registry->reset();
+    QCOMPARE(find("test/timer").calls, 0ull);
+}
+
+void TestKSProfiler::testThreads()
+{
+    KSProfiler::Registry *registry = KSProfiler::Registry::Instance();
+    registry->reset();
+    registry->setEnabled(true);
+
+    const int counter = KSProfiler::counter("test/threads");
+    QVERIFY(counter >= KSProfiler::BuiltinCounters);
+    QCOMPARE(KSProfiler::counter("test/threads"), counter);
+
+    // Threads that exit before the aggregation must not lose their counts
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([counter]()
+        {
+            for (int j = 0; j < 1000; ++j)
+                KSProfiler::add(counter);
+        });
+    }
+    for (auto &t : threads)
+        t.join();
+
+    KSProfiler::add(counter, 10);
+
+    registry->setEnabled(false);
+
+    QCOMPARE(find("test/threads").calls, 4010ull);
+}
+
+void TestKSProfiler::testJson()
+{
+    KSProfiler::Registry *registry = KSProfiler::Registry::Instance();
+    registry->setEnabled(true);
+    KSProfiler::add(KSProfiler::StarUpdateCoords, 2, 1000);
+    registry->setEnabled(false);
+
+    const QJsonDocument doc = QJsonDocument::fromJson(registry->toJson().toUtf8());
+    QVERIFY(doc.isArray());
+
+    bool found = false;
+    for (const auto &value : doc.array())
+    {
+        const QJsonObject counter = value.toObject();
+        if (counter["name"].toString() == "StarObject/updateCoords")
+        {
+            found = true;
+            QCOMPARE(counter["calls"].toInt(), 2);
+            QVERIFY(counter.contains("load"));
+        }
+    }
+    QVERIFY(found);
+}
+
+QTEST_GUILESS_MAIN(TestKSProfiler)
@@ -0,0 +1,31 @@
+/*  KStars profiler tests
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#ifndef TESTKSPROFILER_H
+#define TESTKSPROFILER_H
+
+#include <QtTest>
+#include <QObject>
+
+class TestKSProfiler : public QObject
+{
+    Q_OBJECT
+public:
+    explicit TestKSProfiler(QObject *parent = nullptr);
+
+private slots:
+    void cleanup();
+
+    void testDisabled();
+    void testCounters();
+    void testThreads();
+    void testJson();
+};
+
+#endif // TESTKSPROFILER_H
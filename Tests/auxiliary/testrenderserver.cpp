@@ -0,0 +1,130 @@
+/*  KStars render server tests
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "testrenderserver.h"
+
+#include "auxiliary/colorscheme.h"
+#include "auxiliary/renderserver.h"
+#include "kstarsdata.h"
+#include "Options.h"
+#include "simclock.h"
+#include "skymap.h"
+
+#include <QBuffer>
+#include <QJsonDocument>
+
+TestRenderServer::TestRenderServer(QObject *parent) : QObject(parent)
+{
+}
+
+void TestRenderServer::testInvalidJobs_data()
+{
+    QTest::addColumn<QByteArray>("JOB");
+
+    QTest::newRow("size") << QByteArray(R"({"width": 0, "height": 100})");
+    QTest::newRow("center") << QByteArray(R"({"ra": 25, "dec": 0})");
+    QTest::newRow("fov") << QByteArray(R"({"fov": -1})");
+    QTest::newRow("projection") << QByteArray(R"({"projection": "Mercator"})");
+    QTest::newRow("time") << QByteArray(R"({"time": "yesterday"})");
+}
+
+void TestRenderServer::testInvalidJobs()
+{
+    QFETCH(QByteArray, JOB);
+
+    // Jobs are validated before anything is rendered
+    RenderServer server(nullptr, nullptr);
+    QJsonObject job = QJsonDocument::fromJson(JOB).object();
+    job.insert("id", 7);
+
+    const QJsonObject reply = server.process(job);
+    QCOMPARE(reply.value("status").toString(), QString("error"));
+    QVERIFY(!reply.value("error").toString().isEmpty());
+    QCOMPARE(reply.value("id").toInt(), 7);
+    QCOMPARE(server.statistics().value("errors").toInt(), 1);
+}
+
+void TestRenderServer::testCommands()
+{
+    RenderServer server(nullptr, nullptr);
+
+    QByteArray input("not json\n"
+                     "{\"command\": \"stats\", \"id\": \"s\"}\n"
+                     "{\"command\": \"quit\"}\n"
+                     "{\"command\": \"stats\"}\n");
+    QBuffer in(&input), out;
+    in.open(QIODevice::ReadOnly);
+    out.open(QIODevice::WriteOnly);
+
+    server.serve(&in, &out);
+
+    // One reply per line, nothing is read after quit
+    const QList<QByteArray> replies = out.data().trimmed().split('\n');
+    QCOMPARE(replies.size(), 3);
+
+    QCOMPARE(QJsonDocument::fromJson(replies[0]).object().value("status").toString(), QString("error"));
+
+    const QJsonObject stats = QJsonDocument::fromJson(replies[1]).object();
+    QCOMPARE(stats.value("status").toString(), QString("ok"));
+    QCOMPARE(stats.value("id").toString(), QString("s"));
+    QCOMPARE(stats.value("jobs").toInt(), 0);
+    QCOMPARE(stats.value("errors").toInt(), 1);
+
+    QCOMPARE(QJsonDocument::fromJson(replies[2]).object().value("status").toString(), QString("ok"));
+}
+
+void TestRenderServer::testFixedField()
+{
+    KStarsData *data = KStarsData::Create();
+    if (!data->initialize())
+        QSKIP("KStars data files are not installed");
+    data->setLocationFromOptions();
+    data->colorScheme()->loadFromConfig();
+    data->clock()->stop();
+
+    SkyMap *map = SkyMap::Create();
+    RenderServer server(data, map);
+
+    // The Pleiades, at a fixed time
+    const QJsonObject pleiades = QJsonDocument::fromJson(R"({"ra": 3.79, "dec": 24.1, "fov": 10,
+        "projection": "Stereographic", "width": 640, "height": 480, "time": "2026-01-01T00:00:00Z"})").object();
+    const QJsonObject orion = QJsonDocument::fromJson(R"({"ra": 5.5, "dec": -5, "fov": 30,
+        "projection": "Lambert", "width": 800, "height": 600, "time": "2026-06-01T12:00:00Z"})").object();
+
+    const double zoom     = Options::zoomFactor();
+    const auto projection = Options::projection();
+
+    const QJsonObject first = server.process(pleiades);
+    QCOMPARE(first.value("status").toString(), QString("ok"));
+    QCOMPARE(first.value("width").toInt(), 640);
+    QCOMPARE(first.value("height").toInt(), 480);
+    QVERIFY(first.value("renderMs").toDouble() > 0);
+
+    // Another job must not change how the same field renders
+    QCOMPARE(server.process(orion).value("status").toString(), QString("ok"));
+    const QJsonObject second = server.process(pleiades);
+    QCOMPARE(second.value("checksum").toString(), first.value("checksum").toString());
+
+    // The jobs do not touch the user's view
+    QCOMPARE(Options::zoomFactor(), zoom);
+    QCOMPARE(Options::projection(), projection);
+
+    // Rendering depends on fonts and data, so the reference checksum is given by the environment
+    const QString reference = QString::fromLatin1(qgetenv("KSTARS_RENDER_CHECKSUM"));
+    if (!reference.isEmpty())
+        QCOMPARE(first.value("checksum").toString(), reference);
+
+    const QJsonObject stats = server.statistics();
+    QCOMPARE(stats.value("jobs").toInt(), 3);
+    QVERIFY(stats.value("jobsPerSecond").toDouble() > 0);
+
+    delete map;
+}
+
+QTEST_MAIN(TestRenderServer)
@@ -0,0 +1,29 @@
+/*  KStars render server tests
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#ifndef TESTRENDERSERVER_H
+#define TESTRENDERSERVER_H
+
+#include <QtTest>
+#include <QObject>
+
+class TestRenderServer : public QObject
+{
+    Q_OBJECT
+public:
+    explicit TestRenderServer(QObject *parent = nullptr);
+
+private slots:
+    void testInvalidJobs_data();
+    void testInvalidJobs();
+    void testCommands();
+    void testFixedField();
+};
+
+#endif // TESTRENDERSERVER_H
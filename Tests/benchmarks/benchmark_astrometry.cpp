@@ -0,0 +1,232 @@
+/*  Astrometry benchmarks.
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "ksnumbers.h"
+#include "skypoint.h"
+#include "htmesh/HTMesh.h"
+#include "projections/azimuthalequidistantprojector.h"
+#include "projections/equirectangularprojector.h"
+#include "projections/gnomonicprojector.h"
+#include "projections/lambertprojector.h"
+#include "projections/orthographicprojector.h"
+#include "projections/stereographicprojector.h"
+#include "skycomponents/deepstarcomponent.h"
+#include "skycomponents/starblockfactory.h"
+#include "skycomponents/starblocklist.h"
+#include "time/kstarsdatetime.h"
+
+#include <QtTest>
+
+#include <QObject>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+// Benchmarks of the coordinate and sky index kernels the sky map runs for every object it draws.
+// Run with "-o results.xml,xml" to get machine-readable results, see the benchmark target.
+class BenchmarkAstrometry : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        BenchmarkAstrometry() = default;
+
+        /** @short Destructor */
+        ~BenchmarkAstrometry() override = default;
+
+    private slots:
+        void initTestCase();
+
+        void updateCoordsBenchmark();
+        void equatorialToHorizontalBenchmark();
+        void toScreenBenchmark_data();
+        void toScreenBenchmark();
+        void htmCircleBenchmark();
+        void htmPolygonBenchmark();
+        void fillToMagBenchmark();
+
+    private:
+        // Number of points each benchmark iteration processes.
+        static constexpr int PointCount { 10000 };
+
+        std::vector<SkyPoint> m_Points;
+};
+
+#include "benchmark_astrometry.moc"
+
+void BenchmarkAstrometry::initTestCase()
+{
+    // Fixed seed, so runs are comparable.
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> ra(0, 360);
+    std::uniform_real_distribution<double> z(-1, 1);
+
+    m_Points.reserve(PointCount);
+    for (int i = 0; i < PointCount; i++)
+        m_Points.emplace_back(dms(ra(generator)), dms(asin(z(generator)) / dms::DegToRad));
+}
+
+void BenchmarkAstrometry::updateCoordsBenchmark()
+{
+    // Precession, nutation and aberration from J2000
+    KSNumbers num(KStarsDateTime::epochToJd(2026.5));
+
+    QBENCHMARK
+    {
+        for (auto &p : m_Points)
+            p.updateCoordsNow(&num);
+    }
+}
+
+void BenchmarkAstrometry::equatorialToHorizontalBenchmark()
+{
+    const CachingDms lst(123.4), latitude(45.6);
+
+    QBENCHMARK
+    {
+        for (auto &p : m_Points)
+            p.EquatorialToHorizontal(&lst, &latitude);
+    }
+}
+
+void BenchmarkAstrometry::toScreenBenchmark_data()
+{
+    QTest::addColumn<int>("PROJECTION");
+
+    QTest::newRow("Lambert") << static_cast<int>(Projector::Lambert);
+    QTest::newRow("AzimuthalEquidistant") << static_cast<int>(Projector::AzimuthalEquidistant);
+    QTest::newRow("Orthographic") << static_cast<int>(Projector::Orthographic);
+    QTest::newRow("Equirectangular") << static_cast<int>(Projector::Equirectangular);
+    QTest::newRow("Stereographic") << static_cast<int>(Projector::Stereographic);
+    QTest::newRow("Gnomonic") << static_cast<int>(Projector::Gnomonic);
+}
+
+void BenchmarkAstrometry::toScreenBenchmark()
+{
+    QFETCH(int, PROJECTION);
+
+    // Equatorial coordinates, so the projection does not depend on the location and time.
+    SkyPoint focus(dms(180.0), dms(30.0));
+    ViewParams params;
+    params.width         = 1920;
+    params.height        = 1080;
+    params.zoomFactor    = 1000;
+    params.useRefraction = false;
+    params.useAltAz      = false;
+    params.fillGround    = false;
+    params.focus         = &focus;
+
+    std::unique_ptr<Projector> projector;
+    switch (PROJECTION)
+    {
+        case Projector::Lambert:
+            projector.reset(new LambertProjector(params));
+            break;
+        case Projector::AzimuthalEquidistant:
+            projector.reset(new AzimuthalEquidistantProjector(params));
+            break;
+        case Projector::Orthographic:
+            projector.reset(new OrthographicProjector(params));
+            break;
+        case Projector::Equirectangular:
+            projector.reset(new EquirectangularProjector(params));
+            break;
+        case Projector::Stereographic:
+            projector.reset(new StereographicProjector(params));
+            break;
+        default:
+            projector.reset(new GnomonicProjector(params));
+            break;
+    }
+
+    int visible = 0;
+    QBENCHMARK
+    {
+        visible = 0;
+        for (const auto &p : m_Points)
+        {
+            bool onVisibleHemisphere = false;
+            const QPointF point = projector->toScreen(&p, false, &onVisibleHemisphere);
+            if (onVisibleHemisphere && projector->onScreen(point))
+                visible++;
+        }
+    }
+    QVERIFY(visible > 0);
+}
+
+void BenchmarkAstrometry::htmCircleBenchmark()
+{
+    // Level of the mesh indexing the star catalogs
+    HTMesh mesh(3, 3);
+    int trixels = 0;
+
+    QBENCHMARK
+    {
+        trixels = 0;
+        for (int i = 0; i < 1000; i++)
+        {
+            const SkyPoint &p = m_Points[i];
+            mesh.intersect(p.ra0().Degrees(), p.dec0().Degrees(), 10.0);
+            trixels += mesh.intersectSize();
+        }
+    }
+    QVERIFY(trixels > 0);
+}
+
+void BenchmarkAstrometry::htmPolygonBenchmark()
+{
+    HTMesh mesh(5, 5);
+    int trixels = 0;
+
+    QBENCHMARK
+    {
+        trixels = 0;
+        for (int i = 0; i < 1000; i++)
+        {
+            // A 10x10 degree field, as drawn by the sky map
+            const double ra = m_Points[i].ra0().Degrees(), dec = qBound(-80.0, m_Points[i].dec0().Degrees(), 80.0);
+            mesh.intersect(ra - 5, dec - 5, ra + 5, dec - 5, ra + 5, dec + 5, ra - 5, dec + 5);
+            trixels += mesh.intersectSize();
+        }
+    }
+    QVERIFY(trixels > 0);
+}
+
+void BenchmarkAstrometry::fillToMagBenchmark()
+{
+    // The deep star catalogs are downloaded separately.
+    DeepStarComponent component(nullptr, "deepstars.dat", 8.0);
+    if (!component.fileOpen())
+        QSKIP("Skipping fillToMag benchmark because the deep star catalog is not installed");
+
+    std::vector<std::unique_ptr<StarBlockList>> lists;
+    long stars = 0;
+
+    QBENCHMARK
+    {
+        // Blocks are recycled through their list, so the previous lists are dropped from the factory first.
+        StarBlockFactory::Instance()->freeAll();
+        lists.clear();
+
+        stars = 0;
+        for (Trixel trixel = 0; trixel < 64; trixel++)
+        {
+            lists.emplace_back(new StarBlockList(trixel, &component));
+            lists.back()->fillToMag(12.0);
+            stars += lists.back()->getStarCount();
+        }
+    }
+    QVERIFY(stars > 0);
+
+    StarBlockFactory::Instance()->freeAll();
+}
+
+QTEST_GUILESS_MAIN(BenchmarkAstrometry)
@@ -0,0 +1,220 @@
+/*  Custom catalog database benchmarks.
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "catalogdb.h"
+#include "catalogentrydata.h"
+#include "dms.h"
+#include "kspaths.h"
+#include "skyobject.h"
+
+#include <QtTest>
+
+#include <QDir>
+#include <QFile>
+#include <QObject>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Benchmarks of the import of a large custom catalog, and of loading a field of view from it
+// rather than the whole catalog. The catalog is synthetic, with one million objects spread
+// uniformly over the sky by default. KSTARS_CATALOG_ROWS sets another number of objects.
+class BenchmarkCatalogDB : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        BenchmarkCatalogDB() = default;
+
+        /** @short Destructor */
+        ~BenchmarkCatalogDB() override = default;
+
+    private slots:
+        void initTestCase();
+        void cleanupTestCase();
+
+        void importBenchmark();
+        void sameResultsTest_data();
+        void sameResultsTest();
+        void loadBenchmark_data();
+        void loadBenchmark();
+
+    private:
+        struct Object
+        {
+            double ra, dec;
+            float mag;
+        };
+
+        /** @return the number of generated objects within radius of the center, brighter than maglim */
+        int bruteForce(double ra, double dec, double radius, double maglim) const;
+
+        QTemporaryDir m_Dir;
+        QString m_CatalogFile;
+        std::vector<Object> m_Objects;
+        std::unique_ptr<CatalogDB> m_DB;
+};
+
+#include "benchmark_catalogdb.moc"
+
+void BenchmarkCatalogDB::initTestCase()
+{
+    QVERIFY(m_Dir.isValid());
+
+    // Start from an empty database, away from the user's one
+    QStandardPaths::setTestModeEnabled(true);
+    const QString dataDir = KSPaths::writableLocation(QStandardPaths::GenericDataLocation);
+    QVERIFY(QDir().mkpath(dataDir));
+    QFile::remove(dataDir + "skycomponents.sqlite");
+    QFile::remove(dataDir + "skycomponents.sqlite-wal");
+    QFile::remove(dataDir + "skycomponents.sqlite-shm");
+
+    m_DB.reset(new CatalogDB());
+    QVERIFY(m_DB->Initialize());
+
+    int rows = qEnvironmentVariableIntValue("KSTARS_CATALOG_ROWS");
+    if (rows <= 0)
+        rows = 1000000;
+
+    // Fixed seed, so runs are comparable.
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> ra(0.0, 24.0);
+    std::uniform_real_distribution<double> sinDec(-1.0, 1.0);
+    std::uniform_real_distribution<double> mag(5.0, 20.0);
+    std::uniform_int_distribution<int> type(3, 8);
+
+    m_CatalogFile = m_Dir.filePath("synthetic.txt");
+    QFile file(m_CatalogFile);
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Text));
+    QTextStream out(&file);
+    out << "# Name: Synthetic\n"
+        << "# Prefix: SYN\n"
+        << "# Color: #00FF00\n"
+        << "# Epoch: 2000\n"
+        << "# ID RA Dc Tp Mg Mj Mn PA Nm\n";
+
+    m_Objects.reserve(rows);
+    for (int i = 1; i <= rows; i++)
+    {
+        const QString raText  = QString::number(ra(generator), 'f', 6);
+        const QString decText = QString::number(std::asin(sinDec(generator)) / dms::DegToRad, 'f', 5);
+        const float m         = static_cast<float>(mag(generator));
+
+        out << i << ' ' << raText << ' ' << decText << ' ' << type(generator) << ' ' << QString::number(m, 'f', 2)
+            << " 1.0 0.5 30 Syn" << i << '\n';
+
+        // The coordinates as the catalog import reads them. It rejects zero coordinates.
+        const Object o { dms(raText, false).Degrees(), dms(decText, true).Degrees(),
+                         QString::number(m, 'f', 2).toFloat() };
+        if (o.ra != 0.0 && o.dec != 0.0)
+            m_Objects.push_back(o);
+    }
+    file.close();
+}
+
+void BenchmarkCatalogDB::cleanupTestCase()
+{
+    m_DB.reset();
+    QSqlDatabase::removeDatabase("skydb");
+}
+
+int BenchmarkCatalogDB::bruteForce(double ra, double dec, double radius, double maglim) const
+{
+    const double cosRadius = std::cos(radius * dms::DegToRad);
+    const double sinDec    = std::sin(dec * dms::DegToRad);
+    const double cosDec    = std::cos(dec * dms::DegToRad);
+
+    int count = 0;
+    for (const auto &o : m_Objects)
+    {
+        const double d = o.dec * dms::DegToRad;
+        if (o.mag <= maglim &&
+                sinDec * std::sin(d) + cosDec * std::cos(d) * std::cos((o.ra - ra) * dms::DegToRad) >= cosRadius)
+            count++;
+    }
+    return count;
+}
+
+void BenchmarkCatalogDB::importBenchmark()
+{
+    // Each import adds the whole catalog, so it is only measured once
+    QBENCHMARK_ONCE
+    {
+        QVERIFY(m_DB->AddCatalogContents(m_CatalogFile));
+    }
+
+    QVERIFY(m_DB->FindCatalog("Synthetic") >= 0);
+}
+
+void BenchmarkCatalogDB::sameResultsTest_data()
+{
+    QTest::addColumn<double>("RA");
+    QTest::addColumn<double>("DEC");
+    QTest::addColumn<double>("RADIUS");
+    QTest::addColumn<double>("MAGLIM");
+
+    QTest::newRow("equator") << 180.0 << 0.0 << 2.0 << 99.0;
+    QTest::newRow("wrapping RA 0") << 359.5 << 20.0 << 3.0 << 99.0;
+    QTest::newRow("high declination") << 45.0 << 85.0 << 4.0 << 15.0;
+    QTest::newRow("north pole") << 0.0 << 88.0 << 5.0 << 99.0;
+    QTest::newRow("south") << 270.0 << -60.0 << 1.0 << 12.0;
+}
+
+void BenchmarkCatalogDB::sameResultsTest()
+{
+    QFETCH(double, RA);
+    QFETCH(double, DEC);
+    QFETCH(double, RADIUS);
+    QFETCH(double, MAGLIM);
+
+    const QList<CatalogEntryData> entries = m_DB->QueryRegion(RA, DEC, RADIUS, MAGLIM, m_DB->FindCatalog("Synthetic"));
+    QCOMPARE(entries.size(), bruteForce(RA, DEC, RADIUS, MAGLIM));
+
+    for (const auto &entry : entries)
+        QCOMPARE(entry.catalog_name, QString("Synthetic"));
+}
+
+void BenchmarkCatalogDB::loadBenchmark_data()
+{
+    QTest::addColumn<bool>("REGION");
+
+    QTest::newRow("field of view") << true;
+    QTest::newRow("whole catalog") << false;
+}
+
+void BenchmarkCatalogDB::loadBenchmark()
+{
+    QFETCH(bool, REGION);
+
+    int loaded = 0;
+    QBENCHMARK
+    {
+        if (REGION)
+        {
+            // A 3 degree field, as a telescope view would need
+            loaded = m_DB->QueryRegion(83.8, -5.4, 1.5, 99.0).size();
+        }
+        else
+        {
+            QList<SkyObject *> objects;
+            QList<QPair<int, QString>> names;
+            m_DB->GetAllObjects("Synthetic", objects, names, nullptr);
+            loaded = objects.size();
+            qDeleteAll(objects);
+        }
+    }
+    QVERIFY(loaded > 0);
+}
+
+QTEST_GUILESS_MAIN(BenchmarkCatalogDB)
@@ -0,0 +1,156 @@
+/*  FITS image benchmarks.
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "fitsviewer/fitsdata.h"
+#include "fitsviewer/stretch.h"
+
+#include <QtTest>
+
+#include <QObject>
+
+#include <memory>
+
+Q_DECLARE_METATYPE(StarAlgorithm)
+
+// Benchmarks of the image kernels run on every captured frame, on the FITS fixtures bundled with the tests.
+// Run with "-o results.xml,xml" to get machine-readable results, see the benchmark target.
+class BenchmarkFITSData : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        BenchmarkFITSData() = default;
+
+        /** @short Destructor */
+        ~BenchmarkFITSData() override = default;
+
+    private slots:
+        void loadBenchmark_data();
+        void loadBenchmark();
+        void statisticsBenchmark_data();
+        void statisticsBenchmark();
+        void stretchBenchmark_data();
+        void stretchBenchmark();
+        void detectBenchmark_data();
+        void detectBenchmark();
+
+    private:
+        static void addFixtures();
+        // Loads a fixture, or skips the benchmark if it is missing.
+        static std::unique_ptr<FITSData> load(const QString &name);
+};
+
+#include "benchmark_fitsdata.moc"
+
+void BenchmarkFITSData::addFixtures()
+{
+    QTest::addColumn<QString>("NAME");
+
+    const QStringList names = { "m47_sim_stars.fits", "ngc4535-autofocus1.fits", "ngc4535-autofocus2.fits",
+                                "bahtinov-focus.fits"
+                              };
+    for (const QString &name : names)
+        QTest::newRow(name.toLatin1().constData()) << name;
+}
+
+std::unique_ptr<FITSData> BenchmarkFITSData::load(const QString &name)
+{
+    std::unique_ptr<FITSData> data(new FITSData(FITS_NORMAL));
+    if (QFile::exists(name) && data->loadFromFile(name).result())
+        return data;
+    return nullptr;
+}
+
+void BenchmarkFITSData::loadBenchmark_data()
+{
+    addFixtures();
+}
+
+void BenchmarkFITSData::loadBenchmark()
+{
+    QFETCH(QString, NAME);
+    if (!QFile::exists(NAME))
+        QSKIP("Skipping benchmark because of missing fixture");
+
+    // Includes the statistics computed while loading
+    QBENCHMARK
+    {
+        FITSData data(FITS_NORMAL);
+        QVERIFY(data.loadFromFile(NAME).result());
+    }
+}
+
+void BenchmarkFITSData::statisticsBenchmark_data()
+{
+    addFixtures();
+}
+
+void BenchmarkFITSData::statisticsBenchmark()
+{
+    QFETCH(QString, NAME);
+    std::unique_ptr<FITSData> data = load(NAME);
+    if (!data)
+        QSKIP("Skipping benchmark because of missing fixture");
+
+    QBENCHMARK { data->calculateStats(true); }
+}
+
+void BenchmarkFITSData::stretchBenchmark_data()
+{
+    addFixtures();
+}
+
+void BenchmarkFITSData::stretchBenchmark()
+{
+    QFETCH(QString, NAME);
+    std::unique_ptr<FITSData> data = load(NAME);
+    if (!data)
+        QSKIP("Skipping benchmark because of missing fixture");
+
+    const FITSImage::Statistic &stats = data->getStatistics();
+    Stretch stretch(stats.width, stats.height, stats.channels, stats.dataType);
+    QImage image(stats.width, stats.height, stats.channels == 1 ? QImage::Format_Grayscale8 : QImage::Format_RGB32);
+
+    QBENCHMARK
+    {
+        stretch.setParams(stretch.computeParams(data->getImageBuffer()));
+        stretch.run(data->getImageBuffer(), &image);
+    }
+}
+
+void BenchmarkFITSData::detectBenchmark_data()
+{
+    QTest::addColumn<QString>("NAME");
+    QTest::addColumn<StarAlgorithm>("ALGORITHM");
+    QTest::addColumn<QRect>("TRACKING_BOX");
+
+    QTest::newRow("centroid") << "m47_sim_stars.fits" << ALGORITHM_CENTROID << QRect();
+    QTest::newRow("gradient") << "m47_sim_stars.fits" << ALGORITHM_GRADIENT << QRect();
+    QTest::newRow("threshold") << "m47_sim_stars.fits" << ALGORITHM_THRESHOLD << QRect();
+    QTest::newRow("sep") << "m47_sim_stars.fits" << ALGORITHM_SEP << QRect();
+    // As the internal guider does
+    QTest::newRow("sep-tracking-box") << "m47_sim_stars.fits" << ALGORITHM_SEP << QRect(591 - 16 / 2, 482 - 16 / 2, 16, 16);
+    // The bahtinov detector works on the selected star only
+    QTest::newRow("bahtinov") << "bahtinov-focus.fits" << ALGORITHM_BAHTINOV << QRect(204, 240, 128, 128);
+}
+
+void BenchmarkFITSData::detectBenchmark()
+{
+    QFETCH(QString, NAME);
+    QFETCH(StarAlgorithm, ALGORITHM);
+    QFETCH(QRect, TRACKING_BOX);
+    std::unique_ptr<FITSData> data = load(NAME);
+    if (!data)
+        QSKIP("Skipping benchmark because of missing fixture");
+
+    QBENCHMARK { data->findStars(ALGORITHM, TRACKING_BOX).waitForFinished(); }
+}
+
+QTEST_GUILESS_MAIN(BenchmarkFITSData)
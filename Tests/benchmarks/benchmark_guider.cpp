@@ -0,0 +1,108 @@
+/*  Guider benchmarks.
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "ekos/guide/internalguide/MPI_IS_gaussian_process/src/gaussian_process_guider.h"
+#include "Options.h"
+
+#include <QtTest>
+
+#include <QObject>
+
+#include <cmath>
+#include <memory>
+#include <random>
+
+// Benchmarks of a Gaussian Process guider step, after various lengths of guiding history.
+// Run with "-o results.xml,xml" to get machine-readable results, see the benchmark target.
+class BenchmarkGuider : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        BenchmarkGuider() = default;
+
+        /** @short Destructor */
+        ~BenchmarkGuider() override = default;
+
+    private slots:
+        void gpgStepBenchmark_data();
+        void gpgStepBenchmark();
+
+    private:
+        // Guiding exposure, in seconds
+        static constexpr double TimeStep { 2.0 };
+
+        // Same parameters as the internal guider
+        static GaussianProcessGuider::guide_parameters parameters();
+        // Periodic error of the mount with some seeing, in arcseconds
+        static double error(double t, std::mt19937 &generator);
+};
+
+#include "benchmark_guider.moc"
+
+GaussianProcessGuider::guide_parameters BenchmarkGuider::parameters()
+{
+    GaussianProcessGuider::guide_parameters parameters;
+    parameters.control_gain_                      = Options::gPGcWeight();
+    parameters.min_periods_for_inference_         = Options::gPGMinPeriodsForInference();
+    parameters.min_move_                          = Options::gPGMinMove();
+    parameters.SE0KLengthScale_                   = Options::gPGSE0KLengthScale();
+    parameters.SE0KSignalVariance_                = Options::gPGSE0KSignalVariance();
+    parameters.PKLengthScale_                     = Options::gPGPKLengthScale();
+    parameters.PKPeriodLength_                    = Options::gPGPeriod();
+    parameters.PKSignalVariance_                  = Options::gPGPKSignalVariance();
+    parameters.SE1KLengthScale_                   = Options::gPGSE1KLengthScale();
+    parameters.SE1KSignalVariance_                = Options::gPGSE1KSignalVariance();
+    parameters.min_periods_for_period_estimation_ = Options::gPGMinPeriodsForPeriodEstimate();
+    parameters.points_for_approximation_          = Options::gPGPointsForApproximation();
+    parameters.prediction_gain_                   = Options::gPGpWeight();
+    parameters.compute_period_                    = Options::gPGEstimatePeriod();
+    return parameters;
+}
+
+double BenchmarkGuider::error(double t, std::mt19937 &generator)
+{
+    std::normal_distribution<double> seeing(0, 0.3);
+    return 4.0 * sin(2 * M_PI * t / 480.0) + seeing(generator);
+}
+
+void BenchmarkGuider::gpgStepBenchmark_data()
+{
+    QTest::addColumn<int>("HISTORY");
+
+    // From the start of guiding to a few worm periods
+    QTest::newRow("10 steps") << 10;
+    QTest::newRow("100 steps") << 100;
+    QTest::newRow("500 steps") << 500;
+    QTest::newRow("2000 steps") << 2000;
+}
+
+void BenchmarkGuider::gpgStepBenchmark()
+{
+    QFETCH(int, HISTORY);
+
+    std::mt19937 generator(42);
+    std::unique_ptr<GaussianProcessGuider> gpg(new GaussianProcessGuider(parameters()));
+
+    // Timestamps are injected, so the history does not depend on how fast the benchmark runs.
+    double t = 0;
+    for (int i = 0; i < HISTORY; i++, t += TimeStep)
+        gpg->inject_data_point(t, error(t, generator), 50.0, 0.0);
+
+    double pulse = 0;
+    QBENCHMARK
+    {
+        pulse = gpg->result(error(t, generator), 50.0, TimeStep, t + TimeStep);
+        t += TimeStep;
+    }
+    QVERIFY(std::isfinite(pulse));
+}
+
+QTEST_GUILESS_MAIN(BenchmarkGuider)
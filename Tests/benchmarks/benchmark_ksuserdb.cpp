@@ -0,0 +1,250 @@
+/*  User database benchmarks.
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "artificialhorizoncomponent.h"
+#include "kspaths.h"
+#include "ksuserdb.h"
+#include "kstarsdata.h"
+#include "linelist.h"
+
+#include <QtTest>
+
+#include <QDir>
+#include <QFile>
+#include <QObject>
+
+#include <memory>
+#include <random>
+
+// Benchmarks of saving and reloading the artificial horizon and the flags, and of opening
+// the user database at startup. The database is a temporary one, filled with a synthetic
+// horizon of 50 regions of 200 points and 5000 flags by default. KSTARS_USERDB_ROWS sets
+// another number of horizon points and flags.
+class BenchmarkKSUserDB : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        BenchmarkKSUserDB() = default;
+
+        /** @short Destructor */
+        ~BenchmarkKSUserDB() override = default;
+
+    private slots:
+        void initTestCase();
+        void cleanupTestCase();
+
+        void sameResultsTest();
+        void insertBenchmark_data();
+        void insertBenchmark();
+        void reloadBenchmark_data();
+        void reloadBenchmark();
+        void startupBenchmark();
+
+    private:
+        void save(bool horizons);
+        int reload(bool horizons);
+
+        static constexpr int Regions { 50 };
+
+        QList<ArtificialHorizonEntity *> m_Horizons;
+        QList<QStringList> m_Flags;
+        int m_Points { 0 };
+        std::unique_ptr<KSUserDB> m_DB;
+};
+
+#include "benchmark_ksuserdb.moc"
+
+void BenchmarkKSUserDB::initTestCase()
+{
+    // Start from an empty database, away from the user's one
+    QStandardPaths::setTestModeEnabled(true);
+    const QString dataDir = KSPaths::writableLocation(QStandardPaths::GenericDataLocation);
+    QVERIFY(QDir().mkpath(dataDir));
+    QFile::remove(dataDir + "userdb.sqlite");
+    QFile::remove(dataDir + "userdb.sqlite-wal");
+    QFile::remove(dataDir + "userdb.sqlite-shm");
+
+    // Horizon points are converted with the local sidereal time and latitude of KStarsData
+    KStarsData::Create();
+
+    m_DB.reset(new KSUserDB());
+    QVERIFY(m_DB->Initialize());
+
+    int rows = qEnvironmentVariableIntValue("KSTARS_USERDB_ROWS");
+    if (rows <= 0)
+        rows = 10000;
+
+    // Fixed seed, so runs are comparable.
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> az(0.0, 360.0);
+    std::uniform_real_distribution<double> alt(0.0, 30.0);
+    std::uniform_real_distribution<double> ra(0.0, 360.0);
+    std::uniform_real_distribution<double> dec(-90.0, 90.0);
+
+    for (int i = 0; i < Regions; i++)
+    {
+        std::shared_ptr<LineList> list(new LineList());
+        for (int j = 0; j < rows / Regions; j++)
+        {
+            std::shared_ptr<SkyPoint> p(new SkyPoint());
+            p->setAz(az(generator));
+            p->setAlt(alt(generator));
+            list->append(std::move(p));
+            m_Points++;
+        }
+
+        ArtificialHorizonEntity *horizon = new ArtificialHorizonEntity;
+        horizon->setRegion(QString("Region %1").arg(i + 1));
+        horizon->setEnabled(i % 2 == 0);
+        horizon->setList(list);
+        m_Horizons.append(horizon);
+    }
+
+    for (int i = 0; i < rows / 2; i++)
+    {
+        m_Flags.append(QStringList() << QString::number(ra(generator)) << QString::number(dec(generator)) << "J2000"
+                                     << "Default" << QString("Flag %1").arg(i + 1) << "#00ff00");
+    }
+}
+
+void BenchmarkKSUserDB::cleanupTestCase()
+{
+    qDeleteAll(m_Horizons);
+    m_Horizons.clear();
+
+    m_DB.reset();
+    QSqlDatabase::removeDatabase("userdb");
+}
+
+void BenchmarkKSUserDB::save(bool horizons)
+{
+    if (horizons)
+    {
+        m_DB->DeleteAllHorizons();
+        m_DB->AddHorizons(m_Horizons);
+    }
+    else
+    {
+        m_DB->DeleteAllFlags();
+        m_DB->AddFlags(m_Flags);
+    }
+}
+
+int BenchmarkKSUserDB::reload(bool horizons)
+{
+    if (!horizons)
+        return m_DB->GetAllFlags().size();
+
+    QList<ArtificialHorizonEntity *> list = m_DB->GetAllHorizons();
+    int points = 0;
+    for (ArtificialHorizonEntity *horizon : list)
+        points += horizon->list()->points()->size();
+    qDeleteAll(list);
+
+    return points;
+}
+
+void BenchmarkKSUserDB::sameResultsTest()
+{
+    save(true);
+    save(false);
+
+    // The horizon is reloaded in the order it was saved
+    QList<ArtificialHorizonEntity *> horizons = m_DB->GetAllHorizons();
+    QCOMPARE(horizons.size(), m_Horizons.size());
+    for (int i = 0; i < horizons.size(); i++)
+    {
+        QCOMPARE(horizons[i]->region(), m_Horizons[i]->region());
+        QCOMPARE(horizons[i]->enabled(), m_Horizons[i]->enabled());
+
+        const SkyList *loaded = horizons[i]->list()->points();
+        const SkyList *saved  = m_Horizons[i]->list()->points();
+        QCOMPARE(loaded->size(), saved->size());
+        for (int j = 0; j < loaded->size(); j++)
+        {
+            QCOMPARE(loaded->at(j)->az().Degrees(), saved->at(j)->az().Degrees());
+            QCOMPARE(loaded->at(j)->alt().Degrees(), saved->at(j)->alt().Degrees());
+        }
+    }
+    qDeleteAll(horizons);
+
+    QCOMPARE(m_DB->GetAllFlags(), m_Flags);
+
+    // Saving again replaces the previous entries
+    save(true);
+    save(false);
+    QCOMPARE(reload(true), m_Points);
+    QCOMPARE(reload(false), m_Flags.size());
+}
+
+void BenchmarkKSUserDB::insertBenchmark_data()
+{
+    QTest::addColumn<bool>("HORIZONS");
+
+    QTest::newRow("horizons") << true;
+    QTest::newRow("flags") << false;
+}
+
+void BenchmarkKSUserDB::insertBenchmark()
+{
+    QFETCH(bool, HORIZONS);
+
+    QBENCHMARK
+    {
+        save(HORIZONS);
+    }
+    QCOMPARE(reload(HORIZONS), HORIZONS ? m_Points : m_Flags.size());
+}
+
+void BenchmarkKSUserDB::reloadBenchmark_data()
+{
+    QTest::addColumn<bool>("HORIZONS");
+
+    QTest::newRow("horizons") << true;
+    QTest::newRow("flags") << false;
+}
+
+void BenchmarkKSUserDB::reloadBenchmark()
+{
+    QFETCH(bool, HORIZONS);
+
+    save(HORIZONS);
+
+    int count = 0;
+    QBENCHMARK
+    {
+        count = reload(HORIZONS);
+    }
+    QCOMPARE(count, HORIZONS ? m_Points : m_Flags.size());
+}
+
+void BenchmarkKSUserDB::startupBenchmark()
+{
+    save(true);
+    save(false);
+
+    // What KStars reads from the user database while it starts
+    int count = 0;
+    QBENCHMARK
+    {
+        QVERIFY(m_DB->Initialize());
+
+        QList<std::shared_ptr<ProfileInfo>> profiles;
+        m_DB->GetAllProfiles(profiles);
+        QList<QMap<QString, QVariant>> DSLRInfos;
+        m_DB->GetAllDSLRInfos(DSLRInfos);
+
+        count = reload(true) + reload(false);
+    }
+    QCOMPARE(count, m_Points + m_Flags.size());
+}
+
+QTEST_GUILESS_MAIN(BenchmarkKSUserDB)
@@ -0,0 +1,214 @@
+/*  Name lookup benchmarks.
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "skycomponents/nameindex.h"
+#include "skyobjects/skyobject.h"
+
+#include <QtTest>
+
+#include <QObject>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+// Benchmarks of the name index against the lookups it replaces: one lower-cased hash per
+// component for SkyMapComposite::findByName(), and a regular expression over all names for
+// the first match in FindDialog. The names are synthetic but have the shape of catalog
+// designations, about 100000 of them over several object types.
+class BenchmarkNameIndex : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        BenchmarkNameIndex() = default;
+
+        /** @short Destructor */
+        ~BenchmarkNameIndex() override = default;
+
+    private slots:
+        void initTestCase();
+
+        void sameResultsTest();
+        void findBenchmark_data();
+        void findBenchmark();
+        void prefixBenchmark_data();
+        void prefixBenchmark();
+
+    private:
+        /** @return the object found by walking the hashes of each type in search order */
+        const SkyObject *findInHashes(const QString &name) const;
+
+        /** @return the first name starting with prefix, the way FindDialog used to select it */
+        QString firstWithRegExp(const QString &prefix) const;
+
+        std::vector<std::unique_ptr<SkyObject>> m_Objects;
+        NameIndex::Lists m_Lists;
+        QVector<QPair<int, QHash<QString, const SkyObject *>>> m_Hashes;
+        QStringList m_Queries;
+        QStringList m_Prefixes;
+};
+
+#include "benchmark_nameindex.moc"
+
+void BenchmarkNameIndex::initTestCase()
+{
+    // Fixed seed, so runs are comparable.
+    std::mt19937 generator(42);
+
+    const struct
+    {
+        int type;
+        const char *catalog;
+        int count;
+    } catalogs[] =
+    {
+        { SkyObject::ASTEROID, "Minor", 20000 },   { SkyObject::GALAXY, "NGC", 7840 },
+        { SkyObject::GALAXY, "UGC", 12000 },       { SkyObject::GALAXY, "PGC", 30000 },
+        { SkyObject::OPEN_CLUSTER, "IC", 5386 },   { SkyObject::STAR, "HD", 25000 },
+    };
+
+    for (const auto &catalog : catalogs)
+    {
+        for (int i = 1; i <= catalog.count; i++)
+        {
+            const QString name = QString("%1 %2").arg(QString::fromLatin1(catalog.catalog)).arg(i);
+            m_Objects.emplace_back(new SkyObject(catalog.type, 0.0, 0.0, 0.0, name));
+            m_Lists[catalog.type].append(NameIndex::Entry(name, m_Objects.back().get()));
+        }
+    }
+
+    // Hashes in the order findByName() searches the components
+    for (int type : { SkyObject::ASTEROID, SkyObject::OPEN_CLUSTER, SkyObject::GALAXY, SkyObject::STAR })
+    {
+        QHash<QString, const SkyObject *> hash;
+        for (const auto &entry : m_Lists[type])
+            hash.insert(entry.first.toLower(), entry.second);
+        m_Hashes.append(qMakePair(type, hash));
+    }
+
+    // Mostly hits, some misses which walk all the hashes
+    std::uniform_int_distribution<int> object(0, static_cast<int>(m_Objects.size()) - 1);
+    std::uniform_int_distribution<int> miss(0, 9);
+    for (int i = 0; i < 1000; i++)
+    {
+        const QString name = m_Objects[object(generator)]->name();
+        m_Queries.append(miss(generator) == 0 ? name + "x" : name.toLower());
+    }
+
+    // What is typed in the find dialog, one character at a time
+    for (const QString name : { "NGC 7331", "HD 12345", "Minor 1999", "PGC 2557" })
+    {
+        for (int i = 1; i <= name.size(); i++)
+            m_Prefixes.append(name.left(i));
+    }
+}
+
+const SkyObject *BenchmarkNameIndex::findInHashes(const QString &name) const
+{
+    const QString key = name.toLower();
+    for (const auto &hash : m_Hashes)
+    {
+        const auto it = hash.second.constFind(key);
+        if (it != hash.second.constEnd())
+            return it.value();
+    }
+    return nullptr;
+}
+
+QString BenchmarkNameIndex::firstWithRegExp(const QString &prefix) const
+{
+    QRegExp regExp('^' + prefix, Qt::CaseInsensitive);
+    QStringList names;
+    for (const auto &list : m_Lists)
+    {
+        for (const auto &entry : list)
+        {
+            if (regExp.indexIn(entry.first) != -1)
+                names.append(entry.first);
+        }
+    }
+    names.sort();
+    return names.isEmpty() ? QString() : names.first();
+}
+
+void BenchmarkNameIndex::sameResultsTest()
+{
+    NameIndex index(&m_Lists);
+
+    for (const auto &query : m_Queries)
+        QCOMPARE(index.find(query), findInHashes(query));
+
+    for (const auto &prefix : m_Prefixes)
+    {
+        const QVector<NameIndex::Entry> found = index.withPrefix(prefix, QVector<int>(), 1);
+        const QString expected                = firstWithRegExp(prefix);
+        QCOMPARE(found.isEmpty() ? QString() : found[0].first, expected);
+    }
+}
+
+void BenchmarkNameIndex::findBenchmark_data()
+{
+    QTest::addColumn<bool>("INDEX");
+
+    QTest::newRow("index") << true;
+    QTest::newRow("hashes") << false;
+}
+
+void BenchmarkNameIndex::findBenchmark()
+{
+    QFETCH(bool, INDEX);
+
+    NameIndex index(&m_Lists);
+    // Sort outside of the measure, like after loading the catalogs
+    index.size();
+
+    int found = 0;
+    QBENCHMARK
+    {
+        found = 0;
+        for (const auto &query : m_Queries)
+        {
+            if ((INDEX ? index.find(query) : findInHashes(query)) != nullptr)
+                found++;
+        }
+    }
+    QVERIFY(found > 0);
+}
+
+void BenchmarkNameIndex::prefixBenchmark_data()
+{
+    QTest::addColumn<bool>("INDEX");
+
+    QTest::newRow("index") << true;
+    QTest::newRow("regexp") << false;
+}
+
+void BenchmarkNameIndex::prefixBenchmark()
+{
+    QFETCH(bool, INDEX);
+
+    NameIndex index(&m_Lists);
+    index.size();
+
+    int found = 0;
+    QBENCHMARK
+    {
+        found = 0;
+        for (const auto &prefix : m_Prefixes)
+        {
+            if (INDEX ? !index.withPrefix(prefix, QVector<int>(), 1).isEmpty() : !firstWithRegExp(prefix).isEmpty())
+                found++;
+        }
+    }
+    QCOMPARE(found, m_Prefixes.size());
+}
+
+QTEST_GUILESS_MAIN(BenchmarkNameIndex)
@@ -0,0 +1,200 @@
+/*  Label placement benchmarks.
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "skycomponents/labeloccupancy.h"
+
+#include <QtTest>
+
+#include <QFile>
+#include <QObject>
+#include <QTextStream>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+// Benchmarks of the screen occupancy tests SkyLabeler runs for every label it places.
+// The workload is a dense star field by default. A recorded workload may be replayed instead
+// by setting KSTARS_LABEL_WORKLOAD to a file with one "minX maxX minY maxY" region per line,
+// frames being separated by empty lines.
+class BenchmarkSkyLabeler : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        BenchmarkSkyLabeler() = default;
+
+        /** @short Destructor */
+        ~BenchmarkSkyLabeler() override = default;
+
+    private slots:
+        void initTestCase();
+
+        void sameResultsTest();
+        void markBenchmark_data();
+        void markBenchmark();
+
+    private:
+        struct Region
+        {
+            int minX, maxX, minY, maxY;
+        };
+        typedef std::vector<Region> Frame;
+
+        bool loadWorkload(const QString &fileName);
+        void generateWorkload();
+
+        /** @return the number of regions marked over all frames */
+        int replay(LabelOccupancy &occupancy) const;
+
+        // Screen size, in pixels and label rows, and SkyLabeler's default minimum gap.
+        static constexpr int ScreenWidth { 1920 };
+        static constexpr int ScreenRows { 75 };
+        static constexpr int MinGap { 8 };
+
+        std::vector<Frame> m_Frames;
+};
+
+#include "benchmark_skylabeler.moc"
+
+void BenchmarkSkyLabeler::initTestCase()
+{
+    const QString fileName = QString::fromLocal8Bit(qgetenv("KSTARS_LABEL_WORKLOAD"));
+
+    if (fileName.isEmpty() || !loadWorkload(fileName))
+        generateWorkload();
+
+    QVERIFY(!m_Frames.empty());
+}
+
+bool BenchmarkSkyLabeler::loadWorkload(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        qWarning() << "Cannot read label workload" << fileName;
+        return false;
+    }
+
+    QTextStream in(&file);
+    Frame frame;
+    while (!in.atEnd())
+    {
+        const QStringList fields = in.readLine().split(' ', QString::SkipEmptyParts);
+        if (fields.size() == 4)
+        {
+            Region r { fields[0].toInt(), fields[1].toInt(), fields[2].toInt(), fields[3].toInt() };
+            if (r.minY >= 0 && r.maxY < ScreenRows && r.minY <= r.maxY && r.minX <= r.maxX)
+                frame.push_back(r);
+        }
+        else if (!frame.empty())
+        {
+            m_Frames.push_back(frame);
+            frame.clear();
+        }
+    }
+    if (!frame.empty())
+        m_Frames.push_back(frame);
+
+    return !m_Frames.empty();
+}
+
+void BenchmarkSkyLabeler::generateWorkload()
+{
+    // Fixed seed, so runs are comparable.
+    std::mt19937 generator(42);
+
+    // Labels are clustered like a Milky Way field, with some partly off screen.
+    std::normal_distribution<double> x(ScreenWidth / 2.0, ScreenWidth / 4.0);
+    std::normal_distribution<double> y(ScreenRows / 2.0, ScreenRows / 4.0);
+    std::uniform_int_distribution<int> length(3, 20);
+    std::uniform_int_distribution<int> tall(0, 9);
+
+    for (int i = 0; i < 100; i++)
+    {
+        Frame frame;
+        frame.reserve(3000);
+        for (int j = 0; j < 3000; j++)
+        {
+            Region r;
+            r.minX = static_cast<int>(x(generator));
+            r.maxX = r.minX + 7 * length(generator);
+            r.minY = qBound(0, static_cast<int>(y(generator)), ScreenRows - 1);
+            // Some labels, like guide labels or bordered ones, cover two rows
+            r.maxY = qMin(r.minY + (tall(generator) == 0 ? 1 : 0), ScreenRows - 1);
+            frame.push_back(r);
+        }
+        m_Frames.push_back(frame);
+    }
+}
+
+int BenchmarkSkyLabeler::replay(LabelOccupancy &occupancy) const
+{
+    int marked = 0;
+
+    for (const auto &frame : m_Frames)
+    {
+        occupancy.reset(ScreenRows, ScreenWidth, MinGap);
+        for (const auto &r : frame)
+        {
+            if (occupancy.mark(r.minX, r.maxX, r.minY, r.maxY))
+                marked++;
+        }
+    }
+
+    return marked;
+}
+
+void BenchmarkSkyLabeler::sameResultsTest()
+{
+    // Both implementations must place the same labels, at least for regions within the screen
+    LabelRunOccupancy runs;
+    LabelBitmapOccupancy bitmap;
+
+    for (const auto &frame : m_Frames)
+    {
+        runs.reset(ScreenRows, ScreenWidth, MinGap);
+        bitmap.reset(ScreenRows, ScreenWidth, MinGap);
+        for (const auto &r : frame)
+        {
+            if (r.minX < 0 || r.maxX >= ScreenWidth)
+                continue;
+            QCOMPARE(bitmap.mark(r.minX, r.maxX, r.minY, r.maxY), runs.mark(r.minX, r.maxX, r.minY, r.maxY));
+        }
+    }
+}
+
+void BenchmarkSkyLabeler::markBenchmark_data()
+{
+    QTest::addColumn<bool>("RUNLISTS");
+
+    QTest::newRow("bitmap") << false;
+    QTest::newRow("runlists") << true;
+}
+
+void BenchmarkSkyLabeler::markBenchmark()
+{
+    QFETCH(bool, RUNLISTS);
+
+    std::unique_ptr<LabelOccupancy> occupancy;
+    if (RUNLISTS)
+        occupancy.reset(new LabelRunOccupancy());
+    else
+        occupancy.reset(new LabelBitmapOccupancy());
+
+    int marked = 0;
+    QBENCHMARK
+    {
+        marked = replay(*occupancy);
+    }
+    QVERIFY(marked > 0);
+}
+
+QTEST_GUILESS_MAIN(BenchmarkSkyLabeler)
@@ -0,0 +1,207 @@
+/*  Image write queue test.
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "indi/imagewritequeue.h"
+
+#include <QtTest>
+
+#include <QObject>
+#include <QTemporaryDir>
+
+#include <fitsio.h>
+
+using ISD::ImageWriteQueue;
+
+class TestImageWriteQueue : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestImageWriteQueue() = default;
+
+        /** @short Destructor */
+        ~TestImageWriteQueue() override = default;
+
+    private slots:
+        void init();
+        void rawTest();
+        void fitsKeywordsTest();
+        void compressedTest();
+        void memoryLimitTest();
+        void failureTest();
+
+    private:
+        // Returns a 16-bit FITS image whose pixels are their index.
+        static QByteArray fitsImage(int width, int height);
+
+        QTemporaryDir m_Dir;
+};
+
+#include "test_imagewritequeue.moc"
+
+QByteArray TestImageWriteQueue::fitsImage(int width, int height)
+{
+    int status = 0;
+    fitsfile *fptr = nullptr;
+    size_t size = 2880;
+    void *memory = malloc(size);
+    long naxes[2] = { width, height };
+
+    QVector<uint16_t> pixels(width * height);
+    for (int i = 0; i < pixels.size(); i++)
+        pixels[i] = static_cast<uint16_t>(i);
+
+    fits_create_memfile(&fptr, &memory, &size, 2880, realloc, &status);
+    fits_create_img(fptr, USHORT_IMG, 2, naxes, &status);
+    fits_write_img(fptr, TUSHORT, 1, pixels.size(), pixels.data(), &status);
+    fits_flush_file(fptr, &status);
+
+    LONGLONG headStart = 0, dataStart = 0, dataEnd = 0;
+    fits_get_hduaddrll(fptr, &headStart, &dataStart, &dataEnd, &status);
+    QByteArray data(static_cast<const char *>(memory), static_cast<int>(dataEnd));
+
+    fits_close_file(fptr, &status);
+    free(memory);
+    return status == 0 ? data : QByteArray();
+}
+
+void TestImageWriteQueue::init()
+{
+    ImageWriteQueue *queue = ImageWriteQueue::Instance();
+    queue->setMemoryLimit(1024LL * 1024 * 1024);
+    queue->setSyncEnabled(false);
+    queue->setVerifyEnabled(false);
+}
+
+void TestImageWriteQueue::rawTest()
+{
+    ImageWriteQueue *queue = ImageWriteQueue::Instance();
+    queue->setSyncEnabled(true);
+    queue->setVerifyEnabled(true);
+
+    const ImageWriteQueue::Statistics before = queue->statistics();
+
+    QVector<QByteArray> contents;
+    for (int i = 0; i < 8; i++)
+    {
+        contents.append(QByteArray(100000 + i, static_cast<char>('a' + i)));
+        queue->enqueue(m_Dir.filePath(QString("raw_%1.cr2").arg(i)), contents.last(), ImageWriteQueue::FORMAT_RAW);
+    }
+
+    QVERIFY(queue->flush(10000));
+
+    const ImageWriteQueue::Statistics after = queue->statistics();
+    QCOMPARE(after.depth, 0);
+    QCOMPARE(after.queuedBytes, 0LL);
+    QCOMPARE(after.written, before.written + 8);
+    QCOMPARE(after.failed, before.failed);
+    QVERIFY(after.bytesPerSecond > 0);
+
+    for (int i = 0; i < contents.size(); i++)
+    {
+        QFile file(m_Dir.filePath(QString("raw_%1.cr2").arg(i)));
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        QCOMPARE(file.readAll(), contents[i]);
+    }
+}
+
+void TestImageWriteQueue::fitsKeywordsTest()
+{
+    const QByteArray image = fitsImage(64, 48);
+    QVERIFY(!image.isEmpty());
+
+    const QString filename = m_Dir.filePath("light.fits");
+    ImageWriteQueue::Instance()->enqueue(filename, image, ImageWriteQueue::FORMAT_FITS, "H Alpha");
+    QVERIFY(ImageWriteQueue::Instance()->flush(10000));
+
+    int status = 0, dataOK = 0, hduOK = 0;
+    char filter[FLEN_VALUE] = {0};
+    fitsfile *fptr = nullptr;
+
+    QVERIFY(fits_open_diskfile(&fptr, filename.toLocal8Bit(), READONLY, &status) == 0);
+    fits_read_key_str(fptr, "FILTER", filter, nullptr, &status);
+    fits_verify_chksum(fptr, &dataOK, &hduOK, &status);
+    fits_close_file(fptr, &status);
+
+    QCOMPARE(status, 0);
+    QCOMPARE(QString(filter), QString("H_Alpha"));
+    QCOMPARE(dataOK, 1);
+    QCOMPARE(hduOK, 1);
+}
+
+void TestImageWriteQueue::compressedTest()
+{
+    const int width = 256, height = 128;
+    const QByteArray image = fitsImage(width, height);
+    QVERIFY(!image.isEmpty());
+
+    const QString filename = m_Dir.filePath("light.fits.fz");
+    ImageWriteQueue::Instance()->enqueue(filename, image, ImageWriteQueue::FORMAT_COMPRESSED_FITS, "Red");
+    QVERIFY(ImageWriteQueue::Instance()->flush(10000));
+
+    QVERIFY(QFileInfo(filename).size() < image.size());
+
+    int status = 0, anynul = 0;
+    char filter[FLEN_VALUE] = {0};
+    fitsfile *fptr = nullptr;
+    QVector<uint16_t> pixels(width * height);
+
+    QVERIFY(fits_open_diskfile(&fptr, filename.toLocal8Bit(), READONLY, &status) == 0);
+    fits_movabs_hdu(fptr, 2, nullptr, &status);
+    QVERIFY(fits_is_compressed_image(fptr, &status));
+    fits_read_key_str(fptr, "FILTER", filter, nullptr, &status);
+    fits_read_img(fptr, TUSHORT, 1, pixels.size(), nullptr, pixels.data(), &anynul, &status);
+    fits_close_file(fptr, &status);
+
+    QCOMPARE(status, 0);
+    QCOMPARE(QString(filter), QString("Red"));
+    for (int i = 0; i < pixels.size(); i++)
+        QCOMPARE(pixels[i], static_cast<uint16_t>(i));
+}
+
+void TestImageWriteQueue::memoryLimitTest()
+{
+    ImageWriteQueue *queue = ImageWriteQueue::Instance();
+    // Smaller than a single image. The images are queued without waiting for the writer, the
+    // queue only reports that it is full so that the next captures are deferred.
+    queue->setMemoryLimit(1000);
+    QVERIFY(queue->isFull() == false);
+
+    const QByteArray data(4000, 'x');
+    for (int i = 0; i < 16; i++)
+        queue->enqueue(m_Dir.filePath(QString("limit_%1.raw").arg(i)), data, ImageWriteQueue::FORMAT_RAW);
+
+    QVERIFY(queue->flush(10000));
+    QVERIFY(queue->isFull() == false);
+    QCOMPARE(queue->statistics().queuedBytes, 0LL);
+    for (int i = 0; i < 16; i++)
+        QCOMPARE(QFileInfo(m_Dir.filePath(QString("limit_%1.raw").arg(i))).size(), static_cast<qint64>(data.size()));
+}
+
+void TestImageWriteQueue::failureTest()
+{
+    ImageWriteQueue *queue = ImageWriteQueue::Instance();
+    QSignalSpy failed(queue, &ImageWriteQueue::writeFailed);
+    const ImageWriteQueue::Statistics before = queue->statistics();
+
+    const QString filename = m_Dir.filePath("missing/directory/image.fits");
+    queue->enqueue(filename, QByteArray(100, 'x'), ImageWriteQueue::FORMAT_RAW);
+    QVERIFY(queue->flush(10000));
+
+    QCOMPARE(failed.count(), 1);
+    QCOMPARE(failed.first().first().toString(), filename);
+
+    const ImageWriteQueue::Statistics after = queue->statistics();
+    QCOMPARE(after.failed, before.failed + 1);
+    QCOMPARE(after.retried, before.retried + ImageWriteQueue::MaxRetries);
+    QCOMPARE(after.written, before.written);
+}
+
+QTEST_GUILESS_MAIN(TestImageWriteQueue)
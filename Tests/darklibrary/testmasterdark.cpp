@@ -0,0 +1,191 @@
+/*  Master dark test.
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "ekos/auxiliary/masterdark.h"
+
+#include <QtTest>
+
+#include <QObject>
+#include <QTemporaryDir>
+
+#include <fitsio.h>
+#include <random>
+
+using Ekos::MasterDark;
+
+class TestMasterDark : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestMasterDark() = default;
+
+        /** @short Destructor */
+        ~TestMasterDark() override = default;
+
+    private slots:
+        void subtractTest();
+        void subframeTest();
+        void parallelTest();
+        void rawFileTest();
+        void hotPixelsTest();
+        void subtractBenchmark();
+
+    private:
+        static QByteArray frame(const QVector<uint16_t> &pixels)
+        {
+            return QByteArray(reinterpret_cast<const char *>(pixels.constData()), pixels.size() * sizeof(uint16_t));
+        }
+        static QVector<uint16_t> randomPixels(int count, int mean, int spread, unsigned int seed);
+};
+
+#include "testmasterdark.moc"
+
+QVector<uint16_t> TestMasterDark::randomPixels(int count, int mean, int spread, unsigned int seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<int> distribution(mean - spread, mean + spread);
+    QVector<uint16_t> pixels(count);
+    for (auto &pixel : pixels)
+        pixel = static_cast<uint16_t>(distribution(generator));
+    return pixels;
+}
+
+void TestMasterDark::subtractTest()
+{
+    MasterDark dark(frame({ 10, 20, 30, 40, 50, 60 }), TUSHORT, 3, 2);
+    QCOMPARE(dark.size(), 12LL);
+
+    // Subtraction stops at zero
+    QVector<uint16_t> light { 100, 10, 35, 40, 1000, 0 };
+    QVERIFY(dark.subtract(reinterpret_cast<uint8_t *>(light.data()), 3, 2, 1, 0, 0));
+    QCOMPARE(light, QVector<uint16_t>({ 90, 0, 5, 0, 950, 0 }));
+
+    // Signed and floating point data
+    MasterDark floatDark(QByteArray(reinterpret_cast<const char *>(QVector<float>({ 1.5f, 2.5f }).constData()), 8), TFLOAT,
+                         2, 1);
+    QVector<float> floatLight { 2.0f, 2.0f };
+    QVERIFY(floatDark.subtract(reinterpret_cast<uint8_t *>(floatLight.data()), 2, 1, 1, 0, 0));
+    QCOMPARE(floatLight, QVector<float>({ 0.5f, 0.0f }));
+}
+
+void TestMasterDark::subframeTest()
+{
+    // 4x3 dark, value is 10 * row + column
+    QVector<uint16_t> darkPixels;
+    for (int y = 0; y < 3; y++)
+        for (int x = 0; x < 4; x++)
+            darkPixels.append(10 * y + x);
+    MasterDark dark(frame(darkPixels), TUSHORT, 4, 3);
+
+    // 2x2 light at (1, 1)
+    QVector<uint16_t> light(4, 100);
+    QVERIFY(dark.subtract(reinterpret_cast<uint8_t *>(light.data()), 2, 2, 1, 1, 1));
+    QCOMPARE(light, QVector<uint16_t>({ 89, 88, 79, 78 }));
+
+    // Light frames that do not fit are refused
+    QVERIFY(!dark.subtract(reinterpret_cast<uint8_t *>(light.data()), 2, 2, 1, 3, 0));
+    QVERIFY(!dark.subtract(reinterpret_cast<uint8_t *>(light.data()), 2, 2, 2, 0, 0));
+}
+
+void TestMasterDark::parallelTest()
+{
+    // Large enough to be split in bands
+    const int width = 1000, height = 700;
+    const QVector<uint16_t> darkPixels = randomPixels(width * height, 1000, 500, 1);
+    QVector<uint16_t> light = randomPixels(width * height, 1200, 800, 2);
+
+    QVector<uint16_t> expected(light.size());
+    for (int i = 0; i < light.size(); i++)
+        expected[i] = light[i] > darkPixels[i] ? light[i] - darkPixels[i] : 0;
+
+    MasterDark dark(frame(darkPixels), TUSHORT, width, height);
+    QVERIFY(dark.subtract(reinterpret_cast<uint8_t *>(light.data()), width, height, 1, 0, 0));
+    QCOMPARE(light, expected);
+}
+
+void TestMasterDark::rawFileTest()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString filename = dir.filePath("darkframe.fits");
+
+    // No raw copy yet
+    QFile fits(filename);
+    QVERIFY(fits.open(QIODevice::WriteOnly));
+    fits.close();
+    QVERIFY(MasterDark::map(filename).isNull());
+
+    const QVector<uint16_t> pixels = randomPixels(64 * 48, 1000, 100, 3);
+    MasterDark dark(frame(pixels), TUSHORT, 64, 48);
+    QVERIFY(dark.writeRaw(filename));
+
+    QSharedPointer<MasterDark> mapped = MasterDark::map(filename);
+    QVERIFY(!mapped.isNull());
+    QCOMPARE(mapped->dataType(), static_cast<int>(TUSHORT));
+    QCOMPARE(mapped->width(), 64);
+    QCOMPARE(mapped->height(), 48);
+    QCOMPARE(mapped->channels(), 1);
+
+    // Mapped pixels subtract the same
+    QVector<uint16_t> light1(pixels.size(), 1050), light2(pixels.size(), 1050);
+    QVERIFY(dark.subtract(reinterpret_cast<uint8_t *>(light1.data()), 64, 48, 1, 0, 0));
+    QVERIFY(mapped->subtract(reinterpret_cast<uint8_t *>(light2.data()), 64, 48, 1, 0, 0));
+    QCOMPARE(light1, light2);
+
+    // Truncated copies are ignored
+    mapped.clear();
+    QFile raw(MasterDark::rawFilename(filename));
+    QVERIFY(raw.resize(raw.size() - 2));
+    QVERIFY(MasterDark::map(filename).isNull());
+}
+
+void TestMasterDark::hotPixelsTest()
+{
+    const int width = 50, height = 40;
+    QVector<uint16_t> darkPixels = randomPixels(width * height, 500, 10, 4);
+    darkPixels[10 * width + 20] = 20000;
+    darkPixels[30 * width + 5] = 30000;
+
+    MasterDark dark(frame(darkPixels), TUSHORT, width, height);
+    QCOMPARE(dark.hotPixels(), QVector<qint64>({ 10 * width + 20, 30 * width + 5 }));
+
+    // Light subframe at (2, 5) with a neighbour pattern around the first hot pixel
+    const int lightW = 30, lightH = 20;
+    QVector<uint16_t> light(lightW * lightH, 100);
+    const int x = 20 - 2, y = 10 - 5;
+    light[y * lightW + x] = 5000;
+    light[y * lightW + x - 1] = 110;
+    light[y * lightW + x + 1] = 120;
+    light[(y - 1) * lightW + x] = 130;
+    light[(y + 1) * lightW + x] = 140;
+
+    dark.removeHotPixels(reinterpret_cast<uint8_t *>(light.data()), lightW, lightH, 1, 2, 5);
+    QCOMPARE(light[y * lightW + x], static_cast<uint16_t>(125));
+    // Other pixels are left alone
+    QCOMPARE(light[y * lightW + x - 1], static_cast<uint16_t>(110));
+}
+
+void TestMasterDark::subtractBenchmark()
+{
+    const int width = 4096, height = 3072;
+    const QVector<uint16_t> darkPixels = randomPixels(width * height, 1000, 200, 5);
+    const QVector<uint16_t> lightPixels = randomPixels(width * height, 1500, 500, 6);
+    MasterDark dark(frame(darkPixels), TUSHORT, width, height);
+
+    QVector<uint16_t> light;
+    QBENCHMARK
+    {
+        light = lightPixels;
+        dark.subtract(reinterpret_cast<uint8_t *>(light.data()), width, height, 1, 0, 0);
+    }
+}
+
+QTEST_GUILESS_MAIN(TestMasterDark)
@@ -0,0 +1,165 @@
+/*  EkosLive adaptive image encoder test.
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "ekos/ekoslive/adaptiveencoder.h"
+
+#include <QtTest>
+
+#include <QJsonDocument>
+#include <QObject>
+
+using EkosLive::AdaptiveEncoder;
+
+class TestAdaptiveEncoder : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestAdaptiveEncoder() = default;
+
+        /** @short Destructor */
+        ~TestAdaptiveEncoder() override = default;
+
+    private slots:
+        void init();
+        void throughputTest();
+        void settingsTest();
+        void encodeTest();
+
+    private:
+        // A clock returning the simulated time, for the encoders to measure the throughput with.
+        AdaptiveEncoder::Clock clock();
+        // Simulates a message taking msecs to be written out.
+        void transfer(AdaptiveEncoder &encoder, qint64 bytes, int msecs);
+        static QImage testImage(int width, int height);
+
+        // Simulated time, in milliseconds
+        qint64 m_Now { 0 };
+};
+
+#include "testadaptiveencoder.moc"
+
+void TestAdaptiveEncoder::init()
+{
+    m_Now = 0;
+}
+
+AdaptiveEncoder::Clock TestAdaptiveEncoder::clock()
+{
+    return [this]()
+    {
+        return m_Now;
+    };
+}
+
+void TestAdaptiveEncoder::transfer(AdaptiveEncoder &encoder, qint64 bytes, int msecs)
+{
+    encoder.messageQueued(bytes);
+    m_Now += msecs / 2;
+    encoder.bytesWritten(bytes / 2);
+    m_Now += msecs - msecs / 2;
+    encoder.bytesWritten(bytes - bytes / 2);
+}
+
+QImage TestAdaptiveEncoder::testImage(int width, int height)
+{
+    QImage image(width, height, QImage::Format_Grayscale8);
+    for (int y = 0; y < height; y++)
+    {
+        uchar *line = image.scanLine(y);
+        for (int x = 0; x < width; x++)
+            line[x] = static_cast<uchar>((x * 7 + y * 13) % 256);
+    }
+    return image;
+}
+
+void TestAdaptiveEncoder::throughputTest()
+{
+    AdaptiveEncoder encoder(clock());
+    QCOMPARE(encoder.throughput(), 0.0);
+
+    // 100 kB in 200 ms
+    transfer(encoder, 100000, 200);
+    QCOMPARE(encoder.throughput(), 500000.0);
+
+    // Later measures are smoothed
+    transfer(encoder, 100000, 1000);
+    QCOMPARE(encoder.throughput(), 380000.0);
+
+    // Partial writes do not count until the message is out
+    encoder.messageQueued(100000);
+    m_Now += 100;
+    encoder.bytesWritten(1000);
+    QCOMPARE(encoder.throughput(), 380000.0);
+
+    // Messages written out within 50 ms only tell that the link is at least that fast
+    encoder.reset();
+    QCOMPARE(encoder.throughput(), 0.0);
+    transfer(encoder, 10000, 10);
+    QCOMPARE(encoder.throughput(), 200000.0);
+    transfer(encoder, 1000, 10);
+    QCOMPARE(encoder.throughput(), 200000.0);
+}
+
+void TestAdaptiveEncoder::settingsTest()
+{
+    const QSize size(4000, 3000);
+
+    // Unknown throughput, the widest image at the best quality
+    AdaptiveEncoder encoder(clock());
+    AdaptiveEncoder::Settings settings = encoder.settings(size, 960, 90, 1.0);
+    QCOMPARE(settings.width, 960);
+    QCOMPARE(settings.quality, 90);
+
+    // Images are never upscaled
+    settings = encoder.settings(QSize(640, 480), 960, 90, 1.0);
+    QCOMPARE(settings.width, 640);
+
+    // Fast link, about 5 MB/s
+    transfer(encoder, 1000000, 200);
+    settings = encoder.settings(size, 960, 90, 1.0);
+    QCOMPARE(settings.width, 960);
+    QCOMPARE(settings.quality, 90);
+
+    // Slow link, about 20 kB/s: the image is narrowed
+    encoder.reset();
+    transfer(encoder, 4000, 200);
+    settings = encoder.settings(size, 960, 90, 1.0);
+    QVERIFY(settings.width < 960);
+    QVERIFY(settings.width >= AdaptiveEncoder::MinWidth);
+
+    // Never better than asked for
+    settings = encoder.settings(size, 960, 40, 10.0);
+    QCOMPARE(settings.width, 960);
+    QVERIFY(settings.quality <= 40);
+}
+
+void TestAdaptiveEncoder::encodeTest()
+{
+    AdaptiveEncoder encoder;
+    const QImage image = testImage(800, 600);
+
+    AdaptiveEncoder::Settings settings;
+    settings.width = 400;
+    settings.quality = 75;
+    const QByteArray data = encoder.encode(image, settings, {{"uuid", "test"}}, 256);
+
+    // Metadata, padded to its packet
+    const QByteArray header = data.left(256);
+    QCOMPARE(QJsonDocument::fromJson(header.left(header.indexOf('\0'))).object()["uuid"].toString(), QString("test"));
+
+    // Followed by the scaled JPEG
+    QImage decoded;
+    QVERIFY(decoded.loadFromData(data.mid(256), "jpg"));
+    QCOMPARE(decoded.width(), 400);
+    QCOMPARE(decoded.height(), 300);
+}
+
+QTEST_GUILESS_MAIN(TestAdaptiveEncoder)
@@ -0,0 +1,212 @@
+/*  EkosLive property publisher test.
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "ekos/ekoslive/propertypublisher.h"
+
+#include <QtTest>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QObject>
+#include <QtWebSockets/QWebSocket>
+#include <QtWebSockets/QWebSocketServer>
+
+using EkosLive::PropertyPublisher;
+
+class TestPropertyPublisher : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestPropertyPublisher() = default;
+
+        /** @short Destructor */
+        ~TestPropertyPublisher() override = default;
+
+    private slots:
+        void init();
+        void cleanup();
+
+        void deltaTest();
+        void coalesceTest();
+        void batchTest();
+        void binaryBatchTest();
+
+    private:
+        static QJsonObject number(const QString &name, double value, const QString &state = "Ok");
+
+        // Stands for the EkosLive server, receiving what the publisher sends.
+        QWebSocketServer *m_Server { nullptr };
+        QWebSocket *m_Peer { nullptr };
+        QWebSocket *m_Client { nullptr };
+        QList<QJsonObject> m_Received;
+};
+
+#include "testpropertypublisher.moc"
+
+QJsonObject TestPropertyPublisher::number(const QString &name, double value, const QString &state)
+{
+    return
+    {
+        {"device", "Mount"},
+        {"name", name},
+        {"state", state},
+        {
+            "numbers", QJsonArray{
+                QJsonObject{{"name", "RA"}, {"value", value}},
+                QJsonObject{{"name", "DE"}, {"value", 45.0}}
+            }
+        }
+    };
+}
+
+void TestPropertyPublisher::init()
+{
+    m_Received.clear();
+
+    m_Server = new QWebSocketServer("test", QWebSocketServer::NonSecureMode, this);
+    QVERIFY(m_Server->listen(QHostAddress::LocalHost));
+    connect(m_Server, &QWebSocketServer::newConnection, this, [this]()
+    {
+        m_Peer = m_Server->nextPendingConnection();
+        connect(m_Peer, &QWebSocket::textMessageReceived, this, [this](const QString & message)
+        {
+            m_Received.append(QJsonDocument::fromJson(message.toUtf8()).object());
+        });
+        connect(m_Peer, &QWebSocket::binaryMessageReceived, this, [this](const QByteArray & message)
+        {
+            m_Received.append(QJsonDocument::fromJson(qUncompress(message)).object());
+        });
+    });
+
+    m_Client = new QWebSocket();
+    m_Client->open(QUrl(QString("ws://127.0.0.1:%1").arg(m_Server->serverPort())));
+    QTRY_COMPARE(m_Client->state(), QAbstractSocket::ConnectedState);
+    QTRY_VERIFY(m_Peer != nullptr);
+}
+
+void TestPropertyPublisher::cleanup()
+{
+    delete m_Client;
+    m_Client = nullptr;
+    delete m_Server;
+    m_Server = nullptr;
+    m_Peer = nullptr;
+}
+
+void TestPropertyPublisher::deltaTest()
+{
+    const QJsonObject first = number("EQUATORIAL_EOD_COORD", 10);
+
+    // Nothing changed
+    QVERIFY(PropertyPublisher::delta(first, first).isEmpty());
+
+    // Only the element that changed is sent
+    QJsonObject changes = PropertyPublisher::delta(first, number("EQUATORIAL_EOD_COORD", 11));
+    QCOMPARE(changes["device"].toString(), QString("Mount"));
+    QCOMPARE(changes["name"].toString(), QString("EQUATORIAL_EOD_COORD"));
+    QVERIFY(!changes.contains("state"));
+    QJsonArray numbers = changes["numbers"].toArray();
+    QCOMPARE(numbers.size(), 1);
+    QCOMPARE(numbers[0].toObject()["name"].toString(), QString("RA"));
+    QCOMPARE(numbers[0].toObject()["value"].toDouble(), 11.0);
+
+    // Only the state is sent
+    changes = PropertyPublisher::delta(first, number("EQUATORIAL_EOD_COORD", 10, "Busy"));
+    QCOMPARE(changes["state"].toString(), QString("Busy"));
+    QVERIFY(!changes.contains("numbers"));
+}
+
+void TestPropertyPublisher::coalesceTest()
+{
+    PropertyPublisher publisher(m_Client);
+    publisher.setInterval(50);
+
+    for (int i = 0; i < 10; i++)
+        publisher.publish(number("EQUATORIAL_EOD_COORD", i));
+    publisher.publish(number("TELESCOPE_INFO", 1));
+
+    // One message per property, with the latest values
+    QTRY_COMPARE(m_Received.size(), 2);
+    QTest::qWait(100);
+    QCOMPARE(m_Received.size(), 2);
+
+    QCOMPARE(m_Received[0]["type"].toString(), QString("device_property_get"));
+    const QJsonObject payload = m_Received[0]["payload"].toObject();
+    QCOMPARE(payload["name"].toString(), QString("EQUATORIAL_EOD_COORD"));
+    QCOMPARE(payload["numbers"].toArray()[0].toObject()["value"].toDouble(), 9.0);
+    QCOMPARE(m_Received[1]["payload"].toObject()["name"].toString(), QString("TELESCOPE_INFO"));
+
+    const PropertyPublisher::Statistics stats = publisher.statistics();
+    QCOMPARE(stats.updates, 11ULL);
+    QCOMPARE(stats.coalesced, 9ULL);
+    QCOMPARE(stats.messages, 2ULL);
+    QVERIFY(stats.bytes > 0);
+}
+
+void TestPropertyPublisher::batchTest()
+{
+    PropertyPublisher publisher(m_Client);
+    publisher.setDeltaEncoding(true);
+
+    publisher.publish(number("EQUATORIAL_EOD_COORD", 10));
+    publisher.publish(number("TELESCOPE_INFO", 1));
+    publisher.flush();
+    QTRY_COMPARE(m_Received.size(), 1);
+
+    // First batch holds the full properties
+    QCOMPARE(m_Received[0]["type"].toString(), QString("device_property_batch"));
+    QJsonArray batch = m_Received[0]["payload"].toArray();
+    QCOMPARE(batch.size(), 2);
+    QCOMPARE(batch[0].toObject(), number("EQUATORIAL_EOD_COORD", 10));
+
+    // Unchanged properties are left out, changed ones only hold their changes
+    publisher.publish(number("EQUATORIAL_EOD_COORD", 12));
+    publisher.publish(number("TELESCOPE_INFO", 1));
+    publisher.flush();
+    QTRY_COMPARE(m_Received.size(), 2);
+    batch = m_Received[1]["payload"].toArray();
+    QCOMPARE(batch.size(), 1);
+    QCOMPARE(batch[0].toObject()["numbers"].toArray().size(), 1);
+
+    // Nothing is sent when nothing changed
+    publisher.publish(number("TELESCOPE_INFO", 1));
+    publisher.flush();
+    QTest::qWait(100);
+    QCOMPARE(m_Received.size(), 2);
+
+    // A forgotten property is sent in full again
+    publisher.forget("Mount", "TELESCOPE_INFO");
+    publisher.publish(number("TELESCOPE_INFO", 1));
+    publisher.flush();
+    QTRY_COMPARE(m_Received.size(), 3);
+    QCOMPARE(m_Received[2]["payload"].toArray()[0].toObject(), number("TELESCOPE_INFO", 1));
+}
+
+void TestPropertyPublisher::binaryBatchTest()
+{
+    PropertyPublisher publisher(m_Client);
+    publisher.setDeltaEncoding(true);
+    publisher.setBinaryEncoding(true);
+
+    for (int i = 0; i < 50; i++)
+        publisher.publish(number(QString("PROPERTY_%1").arg(i), i));
+    publisher.flush();
+
+    QTRY_COMPARE(m_Received.size(), 1);
+    QCOMPARE(m_Received[0]["type"].toString(), QString("device_property_batch"));
+    QCOMPARE(m_Received[0]["payload"].toArray().size(), 50);
+
+    // Compressed batch is smaller than its JSON document
+    const QByteArray json = QJsonDocument(m_Received[0]).toJson(QJsonDocument::Compact);
+    QVERIFY(publisher.statistics().bytes < static_cast<quint64>(json.size()));
+}
+
+QTEST_GUILESS_MAIN(TestPropertyPublisher)
@@ -0,0 +1,187 @@
+/*  Bayer decoding test.
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "fitsviewer/bayerdecoder.h"
+
+#include <QtTest>
+
+#include <QImage>
+#include <QObject>
+
+#include <random>
+#include <vector>
+
+// Checks that decoding a frame in parallel bands, as BayerDecoder does, gives
+// the same pixels as decoding the whole frame at once, and measures the
+// throughput of each method.
+
+class TestBayer : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestBayer() = default;
+
+        /** @short Destructor */
+        ~TestBayer() override = default;
+
+    private slots:
+        void planarTest_data();
+        void planarTest();
+        void imageTest_data();
+        void imageTest();
+        void benchmark_data();
+        void benchmark();
+
+    private:
+        void addMethods();
+};
+
+#include "testbayer.moc"
+
+namespace
+{
+template <typename T>
+std::vector<T> randomFrame(int width, int height, int bits)
+{
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> distribution(0, (1 << bits) - 1);
+    std::vector<T> frame(static_cast<size_t>(width) * height);
+    for (auto &sample : frame)
+        sample = distribution(generator);
+    return frame;
+}
+
+// Whole frame decoding, in the layout of BayerDecoder::toPlanar().
+template <typename T>
+std::vector<T> serialPlanar(const std::vector<T> &frame, int width, int height, const BayerParams &params)
+{
+    const size_t size = static_cast<size_t>(width) * height;
+    std::vector<T> rgb(size * 3, 0), planes(size * 3, 0);
+    const T *source = frame.data();
+    int rows = height;
+    if (params.offsetY == 1)
+    {
+        source += width;
+        rows--;
+    }
+
+    dc1394error_t error;
+    if (sizeof(T) == 1)
+        error = dc1394_bayer_decoding_8bit(reinterpret_cast<const uint8_t *>(source), reinterpret_cast<uint8_t *>(rgb.data()),
+                                           width, rows, params.filter, params.method);
+    else
+        error = dc1394_bayer_decoding_16bit(reinterpret_cast<const uint16_t *>(source), reinterpret_cast<uint16_t *>(rgb.data()),
+                                            width, rows, params.filter, params.method, 16);
+    if (error != DC1394_SUCCESS)
+        return std::vector<T>();
+
+    for (size_t i = 0; i < static_cast<size_t>(width) * rows; ++i)
+    {
+        planes[i] = rgb[3 * i];
+        planes[i + size] = rgb[3 * i + 1];
+        planes[i + 2 * size] = rgb[3 * i + 2];
+    }
+    return planes;
+}
+}
+
+void TestBayer::addMethods()
+{
+    QTest::addColumn<int>("method");
+
+    QTest::newRow("nearest") << static_cast<int>(DC1394_BAYER_METHOD_NEAREST);
+    QTest::newRow("simple") << static_cast<int>(DC1394_BAYER_METHOD_SIMPLE);
+    QTest::newRow("bilinear") << static_cast<int>(DC1394_BAYER_METHOD_BILINEAR);
+    QTest::newRow("hqlinear") << static_cast<int>(DC1394_BAYER_METHOD_HQLINEAR);
+    QTest::newRow("downsample") << static_cast<int>(DC1394_BAYER_METHOD_DOWNSAMPLE);
+    QTest::newRow("edgesense") << static_cast<int>(DC1394_BAYER_METHOD_EDGESENSE);
+    QTest::newRow("vng") << static_cast<int>(DC1394_BAYER_METHOD_VNG);
+    QTest::newRow("ahd") << static_cast<int>(DC1394_BAYER_METHOD_AHD);
+}
+
+void TestBayer::planarTest_data()
+{
+    addMethods();
+}
+
+void TestBayer::planarTest()
+{
+    QFETCH(int, method);
+
+    // Several bands, the last one partial.
+    constexpr int width = 320, height = 300;
+
+    for (int offsetY = 0; offsetY <= 1; ++offsetY)
+    {
+        const BayerParams params = { static_cast<dc1394bayer_method_t>(method), DC1394_COLOR_FILTER_RGGB, 0, offsetY };
+
+        const auto frame8 = randomFrame<uint8_t>(width, height, 8);
+        std::vector<uint8_t> planes8(frame8.size() * 3);
+        QCOMPARE(BayerDecoder::toPlanar(frame8.data(), planes8.data(), width, height, params), DC1394_SUCCESS);
+        QVERIFY(planes8 == serialPlanar(frame8, width, height, params));
+
+        const auto frame16 = randomFrame<uint16_t>(width, height, 16);
+        std::vector<uint16_t> planes16(frame16.size() * 3);
+        QCOMPARE(BayerDecoder::toPlanar(frame16.data(), planes16.data(), width, height, params), DC1394_SUCCESS);
+        QVERIFY(planes16 == serialPlanar(frame16, width, height, params));
+    }
+}
+
+void TestBayer::imageTest_data()
+{
+    addMethods();
+}
+
+void TestBayer::imageTest()
+{
+    QFETCH(int, method);
+
+    constexpr int width = 320, height = 300;
+    const BayerParams params = { static_cast<dc1394bayer_method_t>(method), DC1394_COLOR_FILTER_GBRG, 0, 0 };
+    const auto frame = randomFrame<uint8_t>(width, height, 8);
+
+    std::vector<uint8_t> rgb(frame.size() * 3);
+    QCOMPARE(dc1394_bayer_decoding_8bit(frame.data(), rgb.data(), width, height, params.filter, params.method),
+             DC1394_SUCCESS);
+
+    QImage image(width, height, QImage::Format_RGB888);
+    QCOMPARE(BayerDecoder::toImage(frame.data(), &image, width, height, params), DC1394_SUCCESS);
+    for (int row = 0; row < height; ++row)
+        QVERIFY(memcmp(image.constScanLine(row), rgb.data() + row * width * 3, width * 3) == 0);
+
+    // Decoding again into the same image must not need a new one.
+    const uchar *bits = image.constBits();
+    QCOMPARE(BayerDecoder::toImage(frame.data(), &image, width, height, params), DC1394_SUCCESS);
+    QCOMPARE(image.constBits(), bits);
+}
+
+void TestBayer::benchmark_data()
+{
+    addMethods();
+}
+
+void TestBayer::benchmark()
+{
+    QFETCH(int, method);
+
+    // A 16 Mpixel, 16 bit sensor.
+    constexpr int width = 4656, height = 3520;
+    const BayerParams params = { static_cast<dc1394bayer_method_t>(method), DC1394_COLOR_FILTER_RGGB, 0, 0 };
+    const auto frame = randomFrame<uint16_t>(width, height, 16);
+    std::vector<uint16_t> planes(frame.size() * 3);
+
+    QBENCHMARK
+    {
+        BayerDecoder::toPlanar(frame.data(), planes.data(), width, height, params);
+    }
+}
+
+QTEST_GUILESS_MAIN(TestBayer)
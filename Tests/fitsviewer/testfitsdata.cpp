@@ -288,6 +288,48 @@ void TestFitsData::testLoadFits()
 #endif
 }
 
+void TestFitsData::testLoadCompressedFits()
+{
+    const QString name("m47_sim_stars.fits");
+    if(!QFile::exists(name))
+        QSKIP("Skipping load test because of missing fixture");
+
+    // Compress the fixture the way fpack does
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString packedName = dir.filePath("m47_sim_stars.fits.fz");
+
+    int status = 0;
+    fitsfile *in = nullptr, *out = nullptr;
+    fits_open_diskfile(&in, name.toLocal8Bit(), READONLY, &status);
+    fits_create_diskfile(&out, packedName.toLocal8Bit(), &status);
+    fits_create_img(out, BYTE_IMG, 0, nullptr, &status);
+    fits_set_compression_type(out, RICE_1, &status);
+    fits_img_compress(in, out, &status);
+    fits_close_file(out, &status);
+    fits_close_file(in, &status);
+    QCOMPARE(status, 0);
+
+    std::unique_ptr<FITSData> plain(new FITSData(FITS_NORMAL));
+    QVERIFY(plain->loadFromFile(name).result());
+
+    std::unique_ptr<FITSData> packed(new FITSData(FITS_NORMAL));
+    QVERIFY(packed->loadFromFile(packedName).result());
+    QVERIFY(packed->isCompressed());
+
+    // Decompressed in memory, without a temporary file
+    QCOMPARE(packed->filename(), packedName);
+    QCOMPARE(QDir(dir.path()).entryList(QDir::Files).count(), 1);
+
+    QCOMPARE(packed->width(), plain->width());
+    QCOMPARE(packed->height(), plain->height());
+    QCOMPARE(packed->getStatistics().dataType, plain->getStatistics().dataType);
+    const int size = plain->width() * plain->height() * plain->getBytesPerPixel();
+    QVERIFY(memcmp(packed->getImageBuffer(), plain->getImageBuffer(), size) == 0);
+    QCOMPARE(packed->getMax(), plain->getMax());
+    QCOMPARE(packed->getMean(), plain->getMean());
+}
+
 void TestFitsData::testCentroidAlgorithmBenchmark_data()
 {
 #if QT_VERSION < 0x050900
@@ -0,0 +1,135 @@
+/*  Stretch test.
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "fitsviewer/fitspyramid.h"
+#include "fitsviewer/stretch.h"
+
+#include <QtTest>
+
+#include <QObject>
+
+#include <fitsio.h>
+
+#include <vector>
+
+// Checks that stretching an image region by region, as FITSPyramid does,
+// gives the same pixels as stretching the whole image.
+
+class TestStretch : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestStretch() = default;
+
+        /** @short Destructor */
+        ~TestStretch() override = default;
+
+    private slots:
+        void regionTest_data();
+        void regionTest();
+        void pyramidTest_data();
+        void pyramidTest();
+};
+
+#include "teststretch.moc"
+
+void TestStretch::regionTest_data()
+{
+    QTest::addColumn<int>("channels");
+    QTest::addColumn<int>("sampling");
+
+    QTest::newRow("mono") << 1 << 1;
+    QTest::newRow("mono sampled by 2") << 1 << 2;
+    QTest::newRow("mono sampled by 4") << 1 << 4;
+    QTest::newRow("color") << 3 << 1;
+    QTest::newRow("color sampled by 2") << 3 << 2;
+}
+
+void TestStretch::regionTest()
+{
+    QFETCH(int, channels);
+    QFETCH(int, sampling);
+
+    // Odd sizes, so the last tiles are partial.
+    constexpr int width = 301, height = 203, tile = 64;
+    std::vector<uint16_t> buffer(width * height * channels);
+    for (size_t i = 0; i < buffer.size(); ++i)
+        buffer[i] = (i * 7919) % 65536;
+    const uint8_t *input = reinterpret_cast<const uint8_t *>(buffer.data());
+
+    Stretch stretch(width, height, channels, TUSHORT);
+    stretch.setParams(stretch.computeParams(input));
+
+    const QImage::Format format = channels == 1 ? QImage::Format_Grayscale8 : QImage::Format_RGB32;
+    QImage full((width + sampling - 1) / sampling, (height + sampling - 1) / sampling, format);
+    stretch.run(input, &full, sampling);
+
+    const int span = tile * sampling;
+    for (int y = 0; y < height; y += span)
+    {
+        for (int x = 0; x < width; x += span)
+        {
+            const QRect region = QRect(x, y, span, span).intersected(QRect(0, 0, width, height));
+            QImage part((region.width() + sampling - 1) / sampling, (region.height() + sampling - 1) / sampling, format);
+            stretch.run(input, &part, region, sampling);
+            QCOMPARE(part, full.copy(x / sampling, y / sampling, part.width(), part.height()));
+        }
+    }
+}
+
+void TestStretch::pyramidTest_data()
+{
+    QTest::addColumn<int>("channels");
+    QTest::addColumn<int>("sampling");
+
+    QTest::newRow("mono") << 1 << 1;
+    QTest::newRow("mono sampled by 3") << 1 << 3;
+    QTest::newRow("color") << 3 << 1;
+}
+
+void TestStretch::pyramidTest()
+{
+    QFETCH(int, channels);
+    QFETCH(int, sampling);
+
+    // Several bands and levels, the last ones partial.
+    constexpr int width = 1301, height = 997;
+    std::vector<uint16_t> buffer(width * height * channels);
+    for (size_t i = 0; i < buffer.size(); ++i)
+        buffer[i] = (i * 7919) % 65536;
+    const uint8_t *input = reinterpret_cast<const uint8_t *>(buffer.data());
+
+    Stretch stretch(width, height, channels, TUSHORT);
+    const StretchParams params = stretch.computeParams(input);
+    stretch.setParams(params);
+
+    const QImage::Format format = channels == 1 ? QImage::Format_Grayscale8 : QImage::Format_RGB32;
+    QImage full((width + sampling - 1) / sampling, (height + sampling - 1) / sampling, format);
+    stretch.run(input, &full, sampling);
+
+    FITSPyramid pyramid;
+    pyramid.setSource(input, width, height, channels, TUSHORT, params, sampling);
+    QVERIFY(pyramid.levels() > 1);
+    const QFuture<QImage> image = pyramid.image();
+    QCOMPARE(image.result(), full);
+
+    // The same source is not stretched again.
+    pyramid.setSource(input, width, height, channels, TUSHORT, params, sampling);
+    QVERIFY(pyramid.image() == image);
+
+    // Another stretch is built again, or stopped.
+    pyramid.setSource(input, width, height, channels, TUSHORT, StretchParams(), sampling);
+    QVERIFY(pyramid.image() != image);
+    pyramid.clear();
+    QVERIFY(pyramid.isEmpty());
+}
+
+QTEST_GUILESS_MAIN(TestStretch)
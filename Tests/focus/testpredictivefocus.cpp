@@ -0,0 +1,330 @@
+/*  Predictive focus test.
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "ekos/focus/focusalgorithms.h"
+#include "ekos/focus/hfrsampler.h"
+#include "ekos/focus/hyperbolafit.h"
+
+#include <QtTest>
+
+#include <QElapsedTimer>
+#include <QObject>
+
+#include <cmath>
+#include <memory>
+#include <random>
+
+using Ekos::FocusAlgorithmInterface;
+using Ekos::HFRSampler;
+using Ekos::HyperbolaFit;
+
+// Renders a field of defocused stars for a focuser position, the way a reflector shows them:
+// a ring whose radius grows linearly with the distance to the focus, blurred by the seeing.
+// The stars drift a little between frames, and the seeing changes from frame to frame.
+class StarField
+{
+    public:
+        static constexpr int Width { 512 };
+        static constexpr int Height { 512 };
+        // Ring radius in pixels per focuser step away from the focus
+        static constexpr double RingRadiusPerStep { 0.02 };
+        static constexpr double Background { 100 };
+        static constexpr double Flux { 20000 };
+
+        StarField(double focus, double seeingNoise, unsigned int seed)
+            : m_Focus(focus), m_SeeingNoise(seeingNoise), m_Generator(seed)
+        {
+            // A 5x5 grid of stars, away from the edges
+            for (int i = 0; i < 25; ++i)
+                m_Centers.append(QPointF(56.3 + 100 * (i % 5), 58.7 + 100 * (i / 5)));
+        }
+
+        const QVector<QPointF> &centers() const
+        {
+            return m_Centers;
+        }
+
+        // Renders a frame at the given focuser position, then moves the stars for the next one.
+        QVector<float> render(int position)
+        {
+            std::normal_distribution<double> seeing(0, m_SeeingNoise);
+            std::normal_distribution<double> noise(0, 3);
+
+            const double radius = RingRadiusPerStep * std::fabs(position - m_Focus);
+            const double sigma = 1.5 * std::max(0.5, 1 + seeing(m_Generator));
+            // Peak of the ring, so that every star has the same flux whatever the focus
+            const double integral = 2 * M_PI * (sigma * sigma * std::exp(-radius * radius / (2 * sigma * sigma)) +
+                                                std::sqrt(M_PI / 2) * sigma * radius * (1 + std::erf(radius / (M_SQRT2 * sigma))));
+            const double peak = Flux / integral;
+
+            QVector<float> frame(Width * Height);
+            for (float &pixel : frame)
+                pixel = static_cast<float>(Background + noise(m_Generator));
+
+            const int extent = static_cast<int>(std::ceil(radius + 5 * sigma));
+            for (const QPointF &center : m_Centers)
+            {
+                const int cx = static_cast<int>(center.x()), cy = static_cast<int>(center.y());
+                for (int y = std::max(0, cy - extent); y <= std::min(Height - 1, cy + extent); ++y)
+                {
+                    for (int x = std::max(0, cx - extent); x <= std::min(Width - 1, cx + extent); ++x)
+                    {
+                        const double r = std::hypot(x - center.x(), y - center.y());
+                        frame[y * Width + x] += static_cast<float>(peak * std::exp(-(r - radius) * (r - radius) / (2 * sigma * sigma)));
+                    }
+                }
+            }
+
+            for (QPointF &center : m_Centers)
+                center += QPointF(0.3, -0.2);
+
+            return frame;
+        }
+
+    private:
+        QVector<QPointF> m_Centers;
+        double m_Focus { 0 };
+        double m_SeeingNoise { 0 };
+        std::mt19937 m_Generator;
+};
+
+class TestPredictiveFocus : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestPredictiveFocus() = default;
+
+        /** @short Destructor */
+        ~TestPredictiveFocus() override = default;
+
+    private slots:
+        void hyperbolaFitTest();
+        void samplerTest();
+        void convergenceTest_data();
+        void convergenceTest();
+        void samplerBenchmark();
+
+    private:
+        struct Run
+        {
+            bool solved { false };
+            int solution { -1 };
+            int steps { 0 };
+            qint64 milliseconds { 0 };
+        };
+
+        // Runs a focus algorithm on the star field, measuring every frame with the sampler.
+        static Run runFocuser(FocusAlgorithmInterface *focuser, StarField &field);
+};
+
+#include "testpredictivefocus.moc"
+
+namespace
+{
+FocusAlgorithmInterface::FocusParams makeParams()
+{
+    const int maxTravel = 100000;
+    const int initialStepSize = 100;
+    const int startPosition = 10000;
+    const int minPositionAllowed = 0;
+    const int maxPositionAllowed = 1000000;
+    const int maxIterations = 30;
+    const double focusTolerance = 0.05;
+    const QString filterName = "Red";
+    const double temperature = 20.0;
+    const double initialOutwardSteps = 5;
+    return FocusAlgorithmInterface::FocusParams(
+               maxTravel, initialStepSize, startPosition, minPositionAllowed,
+               maxPositionAllowed, maxIterations, focusTolerance, filterName,
+               temperature, initialOutwardSteps);
+}
+
+double hyperbola(double position)
+{
+    return std::sqrt(2.0 * 2.0 + std::pow((position - 10150) / 50.0, 2));
+}
+}
+
+void TestPredictiveFocus::hyperbolaFitTest()
+{
+    // An exact hyperbola is fitted exactly, from any 3 positions
+    HyperbolaFit fit(10000, 100);
+    QVERIFY(!fit.isValid());
+    for (int position = 10500; position >= 9500; position -= 100)
+        fit.add(position, hyperbola(position));
+    QVERIFY(fit.isValid());
+    QVERIFY(std::fabs(fit.minimumPosition() - 10150) < 0.01);
+    QVERIFY(std::fabs(fit.minimumValue() - 2.0) < 0.001);
+    QVERIFY(std::fabs(fit.value(10650) - hyperbola(10650)) < 0.001);
+    QVERIFY(fit.positionError() < 0.01);
+
+    // Samples without stars are ignored
+    fit.add(10000, -1);
+    QCOMPARE(fit.count(), 11);
+
+    // With noise, the error of the minimum shrinks as samples are added, and covers the actual error
+    std::mt19937 generator(7);
+    std::normal_distribution<double> noise(0, 0.03);
+    fit.clear();
+    QCOMPARE(fit.count(), 0);
+    double previousError = 0;
+    for (int position = 10500; position >= 9500; position -= 50)
+    {
+        fit.add(position, hyperbola(position) * (1 + noise(generator)));
+        if (fit.count() == 6)
+            previousError = fit.positionError();
+    }
+    QVERIFY(fit.isValid());
+    QVERIFY(fit.positionError() < previousError);
+    QVERIFY(std::fabs(fit.minimumPosition() - 10150) < 4 * fit.positionError());
+}
+
+void TestPredictiveFocus::samplerTest()
+{
+    QCOMPARE(HFRSampler::boxSize(1), static_cast<int>(HFRSampler::MinBoxSize));
+    QCOMPARE(HFRSampler::boxSize(10), 60);
+    QCOMPARE(HFRSampler::boxSize(1000), static_cast<int>(HFRSampler::MaxBoxSize));
+
+    StarField field(10000, 0, 1);
+
+    // Start a little off the actual centers, as a detection would
+    HFRSampler sampler;
+    QVERIFY(sampler.isEmpty());
+    QVector<QPointF> centers = field.centers();
+    for (QPointF &center : centers)
+        center += QPointF(1.5, -1.0);
+    sampler.setStars(centers);
+
+    // The HFR grows with the distance to the focus, while the sampler follows the drifting stars
+    double previousHFR = 0;
+    for (int position = 10000; position <= 10500; position += 100)
+    {
+        const QVector<float> frame = field.render(position);
+        const double hfr = sampler.measure(frame.constData(), StarField::Width, StarField::Height,
+                                           HFRSampler::boxSize(previousHFR));
+        QVERIFY2(hfr > previousHFR, qPrintable(QString("HFR %1 at %2 after %3").arg(hfr).arg(position).arg(previousHFR)));
+        previousHFR = hfr;
+
+        QCOMPARE(sampler.samples().size(), field.centers().size());
+        for (int i = 0; i < field.centers().size(); ++i)
+        {
+            // The field already moved the stars for the next frame
+            const QPointF rendered = field.centers()[i] - QPointF(0.3, -0.2);
+            QVERIFY(sampler.samples()[i].HFR > 0);
+            QVERIFY((sampler.samples()[i].center - rendered).manhattanLength() < 1);
+        }
+    }
+
+    // Stars lost by more than half the boxes are reported, so that they get detected again
+    QVector<QPointF> lost = sampler.stars();
+    for (int i = 0; i < lost.size() / 2 + 1; ++i)
+        lost[i] = QPointF(-100, -100);
+    sampler.setStars(lost);
+    const QVector<float> frame = field.render(10000);
+    QCOMPARE(sampler.measure(frame.constData(), StarField::Width, StarField::Height, 64), -1.0);
+
+    // A measure of a copy of the stars leaves the sampler alone until it is applied
+    sampler.setStars(field.centers());
+    const HFRSampler::Measurement measurement = HFRSampler::measure(frame.constData(), StarField::Width,
+            StarField::Height, sampler.stars(), 64);
+    QVERIFY(measurement.HFR > 0);
+    QCOMPARE(sampler.stars(), field.centers());
+    QVERIFY(sampler.apply(measurement));
+    QCOMPARE(sampler.stars(), measurement.followed);
+
+    // It is dropped if the stars changed meanwhile
+    sampler.clear();
+    QVERIFY(sampler.apply(measurement) == false);
+    QVERIFY(sampler.isEmpty());
+}
+
+TestPredictiveFocus::Run TestPredictiveFocus::runFocuser(FocusAlgorithmInterface *focuser, StarField &field)
+{
+    Run run;
+    QElapsedTimer timer;
+    timer.start();
+
+    HFRSampler sampler;
+    sampler.setStars(field.centers());
+    double hfr = -1;
+    int position = focuser->initialPosition();
+    while (position >= 0 && run.steps < 100)
+    {
+        const QVector<float> frame = field.render(position);
+        hfr = sampler.measure(frame.constData(), StarField::Width, StarField::Height, HFRSampler::boxSize(hfr));
+        run.steps++;
+        position = focuser->newMeasurement(position, hfr);
+    }
+
+    run.milliseconds = timer.elapsed();
+    run.solved = focuser->isDone() && focuser->solution() != -1;
+    run.solution = focuser->solution();
+    return run;
+}
+
+void TestPredictiveFocus::convergenceTest_data()
+{
+    QTest::addColumn<double>("OFFSET");
+    QTest::addColumn<double>("SEEING");
+
+    QTest::newRow("in focus") << 0.0 << 0.0;
+    QTest::newRow("inward") << -320.0 << 0.0;
+    QTest::newRow("outward") << 270.0 << 0.0;
+    QTest::newRow("beyond the first sample") << 830.0 << 0.0;
+    QTest::newRow("in focus, poor seeing") << 40.0 << 0.03;
+    QTest::newRow("inward, poor seeing") << -260.0 << 0.03;
+    QTest::newRow("outward, poor seeing") << 310.0 << 0.03;
+}
+
+void TestPredictiveFocus::convergenceTest()
+{
+    QFETCH(double, OFFSET);
+    QFETCH(double, SEEING);
+
+    const FocusAlgorithmInterface::FocusParams params = makeParams();
+    const double focus = params.startPosition + OFFSET;
+
+    StarField predictiveField(focus, SEEING, 3);
+    std::unique_ptr<FocusAlgorithmInterface> predictive(MakePredictiveFocuser(params));
+    const Run predictiveRun = runFocuser(predictive.get(), predictiveField);
+
+    StarField linearField(focus, SEEING, 3);
+    std::unique_ptr<FocusAlgorithmInterface> linear(MakeLinearFocuser(params));
+    const Run linearRun = runFocuser(linear.get(), linearField);
+
+    qInfo() << QString("Focus %1: predictive %2 in %3 steps %4 ms, linear %5 in %6 steps %7 ms")
+            .arg(focus).arg(predictiveRun.solution).arg(predictiveRun.steps).arg(predictiveRun.milliseconds)
+            .arg(linearRun.solution).arg(linearRun.steps).arg(linearRun.milliseconds);
+
+    QVERIFY2(predictiveRun.solved, qPrintable(predictive->doneReason()));
+    // Within the HFR tolerance, i.e. less than a step from the focus with this field
+    QVERIFY(std::fabs(predictiveRun.solution - focus) < params.initialStepSize);
+    QVERIFY(predictiveRun.steps <= params.maxIterations);
+    if (linearRun.solved)
+        QVERIFY(predictiveRun.steps <= linearRun.steps);
+}
+
+void TestPredictiveFocus::samplerBenchmark()
+{
+    StarField field(10000, 0, 5);
+    const QVector<float> frame = field.render(10300);
+
+    HFRSampler sampler;
+    double hfr = -1;
+    QBENCHMARK
+    {
+        sampler.setStars(field.centers());
+        hfr = sampler.measure(frame.constData(), StarField::Width, StarField::Height, HFRSampler::boxSize(6));
+    }
+    QVERIFY(hfr > 0);
+}
+
+QTEST_GUILESS_MAIN(TestPredictiveFocus)
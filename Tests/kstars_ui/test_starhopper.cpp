@@ -0,0 +1,94 @@
+/*  KStars UI tests
+    Copyright (C) 2026 KStars developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "test_starhopper.h"
+
+#include "kstars.h"
+#include "kstarsdata.h"
+#include "kstars_ui_tests.h"
+#include "test_kstars_startup.h"
+#include "skycomponents/skymapcomposite.h"
+#include "skyobjects/starobject.h"
+#include "tools/starhopper.h"
+
+TestStarHopper::TestStarHopper(QObject *parent) : QObject(parent)
+{
+}
+
+void TestStarHopper::initTestCase()
+{
+    KTRY_SHOW_KSTARS();
+}
+
+void TestStarHopper::cleanupTestCase()
+{
+}
+
+void TestStarHopper::testComputePath_data()
+{
+#if QT_VERSION < 0x050900
+    QSKIP("Skipping fixture-based test on old QT version.");
+#else
+    QTest::addColumn<QString>("SOURCE");
+    QTest::addColumn<QString>("DESTINATION");
+    QTest::addColumn<float>("FOV");
+    QTest::addColumn<float>("MAGLIM");
+
+    // Short hop from a bright star, then a long one across Cygnus, for binoculars, finders and eyepieces
+    for (auto const &hop : QList<QPair<QString, QString>> { { "Vega", "M 57" }, { "Deneb", "M 27" } })
+    {
+        QTest::addRow("%s-%s binoculars", qPrintable(hop.first), qPrintable(hop.second)) << hop.first << hop.second << 5.0f << 8.0f;
+        QTest::addRow("%s-%s finder", qPrintable(hop.first), qPrintable(hop.second)) << hop.first << hop.second << 2.0f << 9.0f;
+        QTest::addRow("%s-%s wide eyepiece", qPrintable(hop.first), qPrintable(hop.second)) << hop.first << hop.second << 1.0f << 10.0f;
+        QTest::addRow("%s-%s eyepiece", qPrintable(hop.first), qPrintable(hop.second)) << hop.first << hop.second << 0.5f << 11.0f;
+    }
+#endif
+}
+
+void TestStarHopper::testComputePath()
+{
+#if QT_VERSION < 0x050900
+    QSKIP("Skipping fixture-based test on old QT version.");
+#else
+    QFETCH(QString, SOURCE);
+    QFETCH(QString, DESTINATION);
+    QFETCH(float, FOV);
+    QFETCH(float, MAGLIM);
+
+    SkyObject const * const src = KStarsData::Instance()->skyComposite()->findByName(SOURCE);
+    QVERIFY(src != nullptr);
+    SkyObject const * const dest = KStarsData::Instance()->skyComposite()->findByName(DESTINATION);
+    QVERIFY(dest != nullptr);
+
+    StarHopper hopper;
+    QList<StarObject *> * path = nullptr;
+
+    QBENCHMARK
+    {
+        delete path;
+        path = hopper.computePath(*src, *dest, FOV, MAGLIM);
+    }
+
+    QVERIFY(path != nullptr);
+    qDebug() << SOURCE << "to" << DESTINATION << "with a FOV of" << FOV << "degrees at magnitude" << MAGLIM
+             << "takes" << path->count() << "hops";
+
+    // Every hop must stay within one field of view of the previous one
+    SkyPoint const * previous = src;
+    for (StarObject const * star : *path)
+    {
+        QVERIFY(star->mag() <= MAGLIM);
+        QVERIFY(previous->angularDistanceTo(star).Degrees() <= FOV);
+        previous = star;
+    }
+    delete path;
+#endif
+}
+
+QTEST_KSTARS_MAIN(TestStarHopper)
@@ -0,0 +1,36 @@
+/*  KStars UI tests
+    Copyright (C) 2026 KStars developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#ifndef TEST_STARHOPPER_H
+#define TEST_STARHOPPER_H
+
+#include "config-kstars.h"
+
+#include <QObject>
+#include <QtTest>
+
+/** @brief Benchmarks star hop computations for typical finder and eyepiece setups.
+ * The star catalogs must be loaded for the hops to be meaningful, so this runs inside the KStars UI test harness.
+ */
+class TestStarHopper : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TestStarHopper(QObject *parent = nullptr);
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testComputePath_data();
+    void testComputePath();
+};
+
+#endif // TEST_STARHOPPER_H
@@ -0,0 +1,135 @@
+/***************************************************************************
+          test_constellationlookupgrid.cpp  -  KStars Planetarium
+                             -------------------
+    begin                : 2026
+    copyright            : (c) 2026 KStars Developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+/* Project Includes */
+#include "test_constellationlookupgrid.h"
+#include "skycomponents/polylist.h"
+
+#include <QTemporaryDir>
+
+TestConstellationLookupGrid::TestConstellationLookupGrid() : QObject()
+{
+}
+
+void TestConstellationLookupGrid::initTestCase()
+{
+    // Read the boundaries the way ConstellationBoundaryLines does
+    QFile file(CBOUNDS_FILE);
+    QVERIFY(file.open(QIODevice::ReadOnly | QIODevice::Text));
+
+    std::shared_ptr<PolyList> polyList;
+    while (!file.atEnd())
+    {
+        const QString line = QString::fromLatin1(file.readLine());
+        if (line.startsWith('#'))
+            continue;
+        if (line.startsWith(':'))
+        {
+            polyList.reset(new PolyList(line.mid(1).trimmed()));
+            boundaries.append(polyList);
+            continue;
+        }
+
+        const double ra  = line.midRef(0, 12).toDouble();
+        const double dec = line.midRef(13, 12).toDouble();
+        QVERIFY(polyList);
+        polyList->append(QPointF(ra, dec));
+        if (ra < 0)
+            polyList->setWrapRA(true);
+    }
+
+    QCOMPARE(boundaries.size(), 89);
+    for (const auto &b : boundaries)
+        bounds.append(b->poly()->boundingRect());
+
+    QElapsedTimer timer;
+    timer.start();
+    grid.build(boundaries);
+    qDebug() << "Built the grid in" << timer.elapsed() << "ms," << grid.mixedCells() << "cells need polygon tests";
+}
+
+int TestConstellationLookupGrid::bruteForce(double ra, double dec) const
+{
+    for (int id = 0; id < boundaries.size(); ++id)
+    {
+        // The polygon test is always false outside the bounding box, skipping it only saves time
+        const double x = (ra > 12.0 && boundaries[id]->wrapRA()) ? ra - 24.0 : ra;
+        if (bounds[id].contains(QPointF(x, dec)) && ConstellationLookupGrid::contains(boundaries[id].get(), ra, dec))
+            return id;
+    }
+    return -1;
+}
+
+void TestConstellationLookupGrid::testEveryCell()
+{
+    const double raStep  = 24.0 / ConstellationLookupGrid::RAColumns;
+    const double decStep = 180.0 / ConstellationLookupGrid::DecRows;
+
+    // The center and four points near the corners of each cell
+    const double offsets[5][2] = { { 0.5, 0.5 }, { 0.01, 0.01 }, { 0.99, 0.01 }, { 0.01, 0.99 }, { 0.99, 0.99 } };
+
+    int unknown = 0;
+    for (int row = 0; row < ConstellationLookupGrid::DecRows; ++row)
+    {
+        for (int column = 0; column < ConstellationLookupGrid::RAColumns; ++column)
+        {
+            for (const auto &offset : offsets)
+            {
+                const double ra  = (column + offset[0]) * raStep;
+                const double dec = -90.0 + (row + offset[1]) * decStep;
+                const int expected = bruteForce(ra, dec);
+
+                if (grid.find(ra, dec) != expected)
+                    QFAIL(qPrintable(QString("Mismatch at RA %1h Dec %2").arg(ra).arg(dec)));
+                if (expected < 0)
+                    unknown++;
+            }
+        }
+    }
+
+    // The boundaries cover the whole sky
+    QCOMPARE(unknown, 0);
+}
+
+void TestConstellationLookupGrid::testSaveLoad()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath("cbounds.grid");
+
+    QVERIFY(grid.save(fileName));
+
+    ConstellationLookupGrid loaded;
+    QVERIFY(loaded.load(fileName, boundaries));
+    QCOMPARE(loaded.mixedCells(), grid.mixedCells());
+
+    qsrand(42);
+    for (int i = 0; i < 10000; ++i)
+    {
+        const double ra  = 24.0 * qrand() / RAND_MAX;
+        const double dec = 180.0 * qrand() / RAND_MAX - 90.0;
+        QCOMPARE(loaded.find(ra, dec), grid.find(ra, dec));
+    }
+
+    // A grid saved for other boundaries is not used
+    ConstellationLookupGrid::Boundaries other = boundaries;
+    other.removeLast();
+    ConstellationLookupGrid stale;
+    QVERIFY(!stale.load(fileName, other));
+    QVERIFY(stale.isEmpty());
+}
+
+QTEST_GUILESS_MAIN(TestConstellationLookupGrid)
@@ -0,0 +1,50 @@
+/***************************************************************************
+           test_constellationlookupgrid.h  -  KStars Planetarium
+                             -------------------
+    begin                : 2026
+    copyright            : (c) 2026 KStars Developers
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TEST_CONSTELLATIONLOOKUPGRID_H
+#define TEST_CONSTELLATIONLOOKUPGRID_H
+
+#include "skycomponents/constellationlookupgrid.h"
+
+#include <QtTest/QtTest>
+
+/**
+ * @class TestConstellationLookupGrid
+ * @short Checks the constellation lookup grid against the polygon test of the boundaries
+ */
+class TestConstellationLookupGrid : public QObject
+{
+        Q_OBJECT
+
+    public:
+        TestConstellationLookupGrid();
+
+    private slots:
+        void initTestCase();
+
+        void testEveryCell();
+        void testSaveLoad();
+
+    private:
+        /** @return the first boundary containing the point, testing all of them */
+        int bruteForce(double ra, double dec) const;
+
+        ConstellationLookupGrid::Boundaries boundaries;
+        QVector<QRectF> bounds;
+        ConstellationLookupGrid grid;
+};
+
+#endif
@@ -0,0 +1,269 @@
+/***************************************************************************
+               test_deepskysnapshot.cpp  -  KStars Planetarium
+                             -------------------
+    begin                : 2026
+    copyright            : (c) 2026 KStars Developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+/* Project Includes */
+#include "test_deepskysnapshot.h"
+
+#include "kstarsdata.h"
+#include "auxiliary/kspaths.h"
+#include "skycomponents/deepskycomponent.h"
+#include "skycomponents/skymesh.h"
+#include "skyobjects/deepskyobject.h"
+
+#include <QDir>
+#include <QStandardPaths>
+
+namespace
+{
+const int MeshSize = 512;
+
+// The names of the objects in the lists of a component, by type
+QHash<int, QStringList> listedNames(SkyComponent &component)
+{
+    QHash<int, QStringList> names;
+    for (auto list = component.objectLists().constBegin(); list != component.objectLists().constEnd(); ++list)
+    {
+        for (const auto &entry : list.value())
+            names[list.key()].append(entry.first);
+    }
+    return names;
+}
+
+void compareObjects(const DeepSkyObject *loaded, const DeepSkyObject *parsed)
+{
+    QCOMPARE(loaded->type(), parsed->type());
+    QCOMPARE(loaded->name(), parsed->name());
+    QCOMPARE(loaded->name2(), parsed->name2());
+    QCOMPARE(loaded->longname(), parsed->longname());
+    QCOMPARE(loaded->ra0().Degrees(), parsed->ra0().Degrees());
+    QCOMPARE(loaded->dec0().Degrees(), parsed->dec0().Degrees());
+    QCOMPARE(loaded->mag(), parsed->mag());
+    QCOMPARE(loaded->a(), parsed->a());
+    QCOMPARE(loaded->b(), parsed->b());
+    QCOMPARE(loaded->pa(), parsed->pa());
+    QCOMPARE(loaded->pgc(), parsed->pgc());
+    QCOMPARE(loaded->ugc(), parsed->ugc());
+    QCOMPARE(loaded->isCatalogM(), parsed->isCatalogM());
+    QCOMPARE(loaded->isCatalogNGC(), parsed->isCatalogNGC());
+    QCOMPARE(loaded->isCatalogIC(), parsed->isCatalogIC());
+}
+}
+
+TestDeepSkySnapshot::TestDeepSkySnapshot() : QObject()
+{
+}
+
+void TestDeepSkySnapshot::initTestCase()
+{
+    QVERIFY(dir.isValid());
+
+    // Work on a copy of the catalog, which the tests modify
+    sourceFile   = dir.filePath("ngcic.dat");
+    snapshotFile = dir.filePath("ngcic.snapshot");
+    QVERIFY(QFile::copy(NGCIC_FILE, sourceFile));
+    QVERIFY(QFile::setPermissions(sourceFile, QFile::ReadOwner | QFile::WriteOwner));
+
+    // Records covering the kinds of catalog lines
+    DeepSkySnapshot::Record m31;
+    m31.type     = 8;
+    m31.ra       = 10.6847083;
+    m31.dec      = 41.2687500;
+    m31.mag      = 4.36f;
+    m31.name     = "M 31";
+    m31.name2    = "NGC 224";
+    m31.longname = "Andromeda Galaxy";
+    m31.catalog  = "M";
+    m31.a        = 177.83f;
+    m31.b        = 69.66f;
+    m31.pa       = 55;
+    m31.pgc      = 2557;
+    m31.ugc      = 454;
+    m31.hasName  = true;
+    m31.trixel   = 17;
+    snapshot.append(m31);
+
+    DeepSkySnapshot::Record ic;
+    ic.type    = 3;
+    ic.ra      = 359.99;
+    ic.dec     = -89.5;
+    ic.mag     = 99.9f;
+    ic.name    = "IC 5332A";
+    ic.catalog = "IC";
+    ic.pa      = 90;
+    ic.hasName = true;
+    ic.trixel  = MeshSize - 1;
+    snapshot.append(ic);
+
+    // Unnamed objects are stored without a name, and a long name may be anything
+    DeepSkySnapshot::Record unnamed;
+    unnamed.type   = 1;
+    unnamed.ra     = 123.456;
+    unnamed.dec    = 0.0;
+    unnamed.mag    = 12.5f;
+    unnamed.trixel = 0;
+    snapshot.append(unnamed);
+
+    DeepSkySnapshot::Record named = unnamed;
+    named.name = named.longname = QString::fromUtf8("\xce\x9f\xce\xbc\xce\xb5\xce\xb3\xce\xb1 Nebula");
+    named.hasName  = true;
+    named.trixel   = 42;
+    snapshot.append(named);
+}
+
+void TestDeepSkySnapshot::testRoundTrip()
+{
+    QVERIFY(snapshot.save(snapshotFile, sourceFile, MeshSize));
+
+    DeepSkySnapshot loaded;
+    QVERIFY(loaded.load(snapshotFile, sourceFile, MeshSize));
+
+    QCOMPARE(loaded.records().size(), snapshot.records().size());
+    for (int i = 0; i < snapshot.records().size(); ++i)
+        QVERIFY(loaded.records()[i] == snapshot.records()[i]);
+
+    // Loading replaces the records
+    QVERIFY(loaded.load(snapshotFile, sourceFile, MeshSize));
+    QCOMPARE(loaded.records().size(), snapshot.records().size());
+}
+
+void TestDeepSkySnapshot::testStaleSource()
+{
+    QVERIFY(snapshot.save(snapshotFile, sourceFile, MeshSize));
+    const QByteArray key = DeepSkySnapshot::sourceKey(sourceFile);
+    QVERIFY(!key.isEmpty());
+
+    // Same size and contents, other time
+    QFile file(sourceFile);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    const QByteArray first = file.read(1);
+    QTest::qWait(1100);
+    QVERIFY(file.seek(0));
+    QCOMPARE(file.write(first), 1ll);
+    file.close();
+    QVERIFY(DeepSkySnapshot::sourceKey(sourceFile) != key);
+
+    DeepSkySnapshot loaded;
+    QVERIFY(!loaded.load(snapshotFile, sourceFile, MeshSize));
+    QVERIFY(loaded.records().isEmpty());
+
+    // A modified catalog
+    QVERIFY(snapshot.save(snapshotFile, sourceFile, MeshSize));
+    QVERIFY(file.open(QIODevice::Append));
+    QVERIFY(file.write("I9999 A 00 00 0.0 +00 00 00                                   \n") > 0);
+    file.close();
+    QVERIFY(!loaded.load(snapshotFile, sourceFile, MeshSize));
+
+    // A missing catalog
+    QVERIFY(!loaded.load(snapshotFile, dir.filePath("missing.dat"), MeshSize));
+    QVERIFY(!snapshot.save(snapshotFile, dir.filePath("missing.dat"), MeshSize));
+}
+
+void TestDeepSkySnapshot::testOtherMesh()
+{
+    QVERIFY(snapshot.save(snapshotFile, sourceFile, MeshSize));
+
+    DeepSkySnapshot loaded;
+    QVERIFY(!loaded.load(snapshotFile, sourceFile, MeshSize * 4));
+
+    // Trixels must fit in the mesh
+    QVERIFY(snapshot.save(snapshotFile, sourceFile, MeshSize / 2));
+    QVERIFY(!loaded.load(snapshotFile, sourceFile, MeshSize / 2));
+}
+
+void TestDeepSkySnapshot::testDamaged()
+{
+    QVERIFY(snapshot.save(snapshotFile, sourceFile, MeshSize));
+
+    QFile file(snapshotFile);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    const qint64 size = file.size();
+
+    // Truncated
+    QVERIFY(file.resize(size - 5));
+    DeepSkySnapshot loaded;
+    QVERIFY(!loaded.load(snapshotFile, sourceFile, MeshSize));
+
+    file.close();
+
+    // Trailing data
+    QVERIFY(snapshot.save(snapshotFile, sourceFile, MeshSize));
+    QVERIFY(file.open(QIODevice::Append));
+    QVERIFY(file.write("ngcic") > 0);
+    file.close();
+    QCOMPARE(QFileInfo(snapshotFile).size(), size + 5);
+    QVERIFY(!loaded.load(snapshotFile, sourceFile, MeshSize));
+
+    // Not a snapshot
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    QVERIFY(file.write("ngcic") > 0);
+    file.close();
+    QVERIFY(!loaded.load(snapshotFile, sourceFile, MeshSize));
+    QVERIFY(!loaded.load(dir.filePath("missing.snapshot"), sourceFile, MeshSize));
+}
+
+void TestDeepSkySnapshot::testCatalog()
+{
+    // The component finds the catalog and saves its snapshot in the data directory
+    QStandardPaths::setTestModeEnabled(true);
+    const QDir dataDir(KSPaths::writableLocation(QStandardPaths::GenericDataLocation));
+    QVERIFY(dataDir.mkpath("."));
+    QFile::remove(dataDir.filePath("ngcic.dat"));
+    QFile::remove(dataDir.filePath("ngcic.snapshot"));
+    QVERIFY(QFile::copy(NGCIC_FILE, dataDir.filePath("ngcic.dat")));
+
+    KStarsData::Create();
+    SkyMesh *mesh = SkyMesh::Create(3);
+
+    // Without a parent, the components share the same object lists
+    DeepSkyComponent parsed(nullptr);
+    QVERIFY(parsed.objectList().size() > 10000);
+    const QHash<int, QStringList> parsedNames = listedNames(parsed);
+    parsed.objectLists().clear();
+    parsed.objectNames().clear();
+
+    DeepSkySnapshot snapshot;
+    QVERIFY(snapshot.load(dataDir.filePath("ngcic.snapshot"), dataDir.filePath("ngcic.dat"), mesh->size()));
+    QCOMPARE(snapshot.records().size(), parsed.objectList().size());
+
+    DeepSkyComponent loaded(nullptr);
+    QCOMPARE(loaded.objectList().size(), parsed.objectList().size());
+    for (int i = 0; i < parsed.objectList().size(); ++i)
+    {
+        compareObjects(loaded.objectList()[i], parsed.objectList()[i]);
+        if (QTest::currentTestFailed())
+            QFAIL(qPrintable(QString("Object %1 differs").arg(parsed.objectList()[i]->name())));
+    }
+
+    QCOMPARE(listedNames(loaded), parsedNames);
+
+    // The same objects in each trixel, in the same order
+    for (Trixel trixel = 0; trixel < static_cast<Trixel>(mesh->size()); ++trixel)
+    {
+        SkyRegion region;
+        region.insert(trixel, true);
+        QList<SkyObject *> parsedObjects, loadedObjects;
+        parsed.objectsInArea(parsedObjects, region);
+        loaded.objectsInArea(loadedObjects, region);
+
+        QCOMPARE(loadedObjects.size(), parsedObjects.size());
+        for (int i = 0; i < parsedObjects.size(); ++i)
+            QCOMPARE(loadedObjects[i]->name(), parsedObjects[i]->name());
+    }
+
+    QDir(KSPaths::writableLocation(QStandardPaths::GenericDataLocation)).removeRecursively();
+}
+
+QTEST_GUILESS_MAIN(TestDeepSkySnapshot)
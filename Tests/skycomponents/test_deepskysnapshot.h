@@ -0,0 +1,54 @@
+/***************************************************************************
+                test_deepskysnapshot.h  -  KStars Planetarium
+                             -------------------
+    begin                : 2026
+    copyright            : (c) 2026 KStars Developers
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TEST_DEEPSKYSNAPSHOT_H
+#define TEST_DEEPSKYSNAPSHOT_H
+
+#include "skycomponents/deepskysnapshot.h"
+
+#include <QtTest/QtTest>
+
+#include <QTemporaryDir>
+
+/**
+ * @class TestDeepSkySnapshot
+ * @short Checks that the NGC/IC snapshot gives back the records it was saved with, and only for its catalog,
+ * and that DeepSkyComponent loads the same objects from it as from ngcic.dat
+ */
+class TestDeepSkySnapshot : public QObject
+{
+        Q_OBJECT
+
+    public:
+        TestDeepSkySnapshot();
+
+    private slots:
+        void initTestCase();
+
+        void testRoundTrip();
+        void testStaleSource();
+        void testOtherMesh();
+        void testDamaged();
+        void testCatalog();
+
+    private:
+        QTemporaryDir dir;
+        QString sourceFile;
+        QString snapshotFile;
+        DeepSkySnapshot snapshot;
+};
+
+#endif
@@ -0,0 +1,132 @@
+/***************************************************************************
+             test_linelistprojection.cpp  -  KStars Planetarium
+                             -------------------
+    begin                : 2026
+    copyright            : (c) 2026 KStars Developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+/* Project Includes */
+#include "test_linelistprojection.h"
+
+#include "kstarsdata.h"
+#include "projections/equirectangularprojector.h"
+#include "skycomponents/linelistindex.h"
+
+namespace
+{
+// Ticks before the sidereal time must have left its bucket at the test zoom
+const int MaxTicks = 100;
+}
+
+TestLineListProjection::TestLineListProjection() : QObject()
+{
+}
+
+void TestLineListProjection::initTestCase()
+{
+    data = KStarsData::Create();
+    QVERIFY(data != nullptr);
+}
+
+void TestLineListProjection::init()
+{
+    data->clock()->setUTC(KStarsDateTime(QDateTime(QDate(2026, 3, 20), QTime(22, 0, 0), Qt::UTC)));
+    data->syncLST();
+
+    focus.setAlt(45);
+    focus.setAz(180);
+    focus.HorizontalToEquatorial(data->lst(), data->geo()->lat());
+
+    vp.width         = 1600;
+    vp.height        = 1200;
+    vp.zoomFactor    = 250;
+    vp.useRefraction = false;
+    vp.useAltAz      = true;
+    vp.fillGround    = false;
+    vp.focus         = &focus;
+    projector.reset(new EquirectangularProjector(vp));
+}
+
+void TestLineListProjection::tick(bool tracking)
+{
+    data->clock()->setUTC(data->ut().addSecs(1));
+    data->syncLST();
+
+    // The sky drifts by in horizontal mode, the focus follows its object in equatorial mode
+    if (tracking)
+        focus.EquatorialToHorizontal(data->lst(), data->geo()->lat());
+    else
+        focus.HorizontalToEquatorial(data->lst(), data->geo()->lat());
+
+    // The sky map sets the view parameters before each repaint
+    projector->setViewParams(vp);
+}
+
+quint64 TestLineListProjection::nextBucket(bool tracking)
+{
+    const quint64 start = key();
+    for (int i = 0; i < MaxTicks; ++i)
+    {
+        tick(tracking);
+        if (key() != start)
+            return key();
+    }
+    return start;
+}
+
+quint64 TestLineListProjection::key()
+{
+    return LineListIndex::projectionKey(projector.get(), data);
+}
+
+void TestLineListProjection::testHorizontalTick()
+{
+    const quint64 start = key();
+    QVERIFY(start != 0);
+
+    // The recomputed right ascension of the focus is not part of the key
+    const quint64 bucket = nextBucket(false);
+    QVERIFY(bucket != start);
+    tick(false);
+    QCOMPARE(key(), bucket);
+}
+
+void TestLineListProjection::testEquatorialTracking()
+{
+    vp.useAltAz = false;
+    projector->setViewParams(vp);
+
+    // The recomputed altitude of the focus is not part of the key
+    const quint64 bucket = nextBucket(true);
+    const double alt     = focus.alt().Degrees();
+    tick(true);
+    QVERIFY(focus.alt().Degrees() != alt);
+    QCOMPARE(key(), bucket);
+}
+
+void TestLineListProjection::testFocusMove()
+{
+    const quint64 start = key();
+
+    // A few pixels
+    focus.setAz(focus.az().Degrees() + 4 / vp.zoomFactor / dms::DegToRad);
+    projector->setViewParams(vp);
+    const quint64 moved = key();
+    QVERIFY(moved != start);
+
+    // Another zoom
+    vp.zoomFactor *= 2;
+    projector->setViewParams(vp);
+    QVERIFY(key() != moved);
+}
+
+QTEST_GUILESS_MAIN(TestLineListProjection)
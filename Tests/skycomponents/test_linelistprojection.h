@@ -0,0 +1,63 @@
+/***************************************************************************
+              test_linelistprojection.h  -  KStars Planetarium
+                             -------------------
+    begin                : 2026
+    copyright            : (c) 2026 KStars Developers
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TEST_LINELISTPROJECTION_H
+#define TEST_LINELISTPROJECTION_H
+
+#include "projections/projector.h"
+#include "skyobjects/skypoint.h"
+
+#include <QtTest/QtTest>
+
+#include <memory>
+
+class KStarsData;
+
+/**
+ * @class TestLineListProjection
+ * @short Checks that the projection key of the cached polylines survives the clock ticks
+ */
+class TestLineListProjection : public QObject
+{
+        Q_OBJECT
+
+    public:
+        TestLineListProjection();
+
+    private slots:
+        void initTestCase();
+        void init();
+
+        void testHorizontalTick();
+        void testEquatorialTracking();
+        void testFocusMove();
+
+    private:
+        /** @short Advance the clock by one second, and update the focus as SkyMap::updateFocus() does */
+        void tick(bool tracking);
+
+        /** @short Tick until the sidereal time enters a new bucket, then return the key */
+        quint64 nextBucket(bool tracking);
+
+        quint64 key();
+
+        KStarsData *data { nullptr };
+        SkyPoint focus;
+        ViewParams vp;
+        std::unique_ptr<Projector> projector;
+};
+
+#endif
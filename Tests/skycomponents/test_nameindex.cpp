@@ -0,0 +1,165 @@
+/***************************************************************************
+                  test_nameindex.cpp  -  KStars Planetarium
+                             -------------------
+    begin                : 2026
+    copyright            : (c) 2026 KStars Developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+/* Project Includes */
+#include "test_nameindex.h"
+
+TestNameIndex::TestNameIndex() : QObject()
+{
+}
+
+const SkyObject *TestNameIndex::add(int type, const QString &name)
+{
+    std::shared_ptr<SkyObject> object(new SkyObject(type, 0.0, 0.0, 0.0, name));
+    objects.append(object);
+    lists[type].append(NameIndex::Entry(name, object.get()));
+    return object.get();
+}
+
+void TestNameIndex::init()
+{
+    lists.clear();
+    objects.clear();
+}
+
+void TestNameIndex::testFind()
+{
+    const SkyObject *m31   = add(SkyObject::GALAXY, "M 31");
+    const SkyObject *vega  = add(SkyObject::STAR, "Vega");
+    const SkyObject *ceres = add(SkyObject::ASTEROID, "Ceres");
+    NameIndex index(&lists);
+
+    QCOMPARE(index.find("M 31"), m31);
+    QCOMPARE(index.find("Vega"), vega);
+    QCOMPARE(index.find("ceres"), ceres);
+
+    // Case and whitespace are not significant
+    QCOMPARE(index.find("m 31"), m31);
+    QCOMPARE(index.find("  M   31 "), m31);
+    QCOMPARE(index.find("VEGA"), vega);
+
+    // Prefixes and unknown names are not found
+    QCOMPARE(index.find("M 3"), static_cast<const SkyObject *>(nullptr));
+    QCOMPARE(index.find("Sirius"), static_cast<const SkyObject *>(nullptr));
+    QCOMPARE(index.find(QString()), static_cast<const SkyObject *>(nullptr));
+
+    // Restricted to some types
+    QCOMPARE(index.find("Vega", { SkyObject::GALAXY }), static_cast<const SkyObject *>(nullptr));
+    QCOMPARE(index.find("Vega", { SkyObject::GALAXY, SkyObject::STAR }), vega);
+
+    QCOMPARE(index.size(), 3);
+}
+
+void TestNameIndex::testSearchOrder()
+{
+    // Stars come after the solar system, like in SkyMapComposite::findByName()
+    const SkyObject *star   = add(SkyObject::STAR, "Mars");
+    const SkyObject *planet = add(SkyObject::PLANET, "Mars");
+    NameIndex index(&lists);
+
+    QCOMPARE(index.find("Mars"), planet);
+    QCOMPARE(index.find("Mars", { SkyObject::STAR, SkyObject::PLANET }), star);
+
+    // The first object listed under a name wins within a type
+    const SkyObject *first = add(SkyObject::GALAXY, "Twin");
+    add(SkyObject::GALAXY, "Twin");
+    index.invalidate(SkyObject::GALAXY);
+    index.update();
+    QCOMPARE(index.find("twin"), first);
+}
+
+void TestNameIndex::testPrefix()
+{
+    add(SkyObject::GALAXY, "NGC 224");
+    add(SkyObject::GALAXY, "NGC 1");
+    add(SkyObject::OPEN_CLUSTER, "NGC 188");
+    add(SkyObject::GALAXY, "M 31");
+    add(SkyObject::STAR, "Nunki");
+    NameIndex index(&lists);
+
+    QVector<NameIndex::Entry> found = index.withPrefix("ngc");
+    QCOMPARE(found.size(), 3);
+    QCOMPARE(found[0].first, QString("NGC 1"));
+    QCOMPARE(found[1].first, QString("NGC 188"));
+    QCOMPARE(found[2].first, QString("NGC 224"));
+
+    found = index.withPrefix("N");
+    QCOMPARE(found.size(), 4);
+    QCOMPARE(found[3].first, QString("Nunki"));
+
+    found = index.withPrefix("ngc", QVector<int>(), 2);
+    QCOMPARE(found.size(), 2);
+    QCOMPARE(found[1].first, QString("NGC 188"));
+
+    found = index.withPrefix("NGC", { SkyObject::OPEN_CLUSTER });
+    QCOMPARE(found.size(), 1);
+    QCOMPARE(found[0].first, QString("NGC 188"));
+
+    QVERIFY(index.withPrefix("IC").isEmpty());
+
+    // An empty prefix matches all names
+    QCOMPARE(index.withPrefix(QString()).size(), 5);
+}
+
+void TestNameIndex::testEntries()
+{
+    add(SkyObject::STAR, "Vega");
+    add(SkyObject::GALAXY, "M 31");
+    add(SkyObject::GALAXY, "M 101");
+    NameIndex index(&lists);
+
+    QCOMPARE(index.entries().size(), 3);
+    QCOMPARE(index.entries({ SkyObject::GALAXY }).size(), 2);
+    QCOMPARE(index.entries({ SkyObject::COMET }).size(), 0);
+}
+
+void TestNameIndex::testInvalidate()
+{
+    add(SkyObject::COMET, "Halley");
+    const SkyObject *vega = add(SkyObject::STAR, "Vega");
+    NameIndex index(&lists);
+
+    QVERIFY(index.find("Halley") != nullptr);
+
+    // The comets are reloaded
+    const quint64 generation = index.generation();
+    lists[SkyObject::COMET].clear();
+    const SkyObject *encke = add(SkyObject::COMET, "Encke");
+    index.invalidate(SkyObject::COMET);
+    QVERIFY(index.generation() != generation);
+
+    // Stale names are not found until the index is updated, the other types are
+    QCOMPARE(index.find("Encke"), static_cast<const SkyObject *>(nullptr));
+    QCOMPARE(index.find("Vega"), vega);
+
+    index.update();
+    QCOMPARE(index.find("Halley"), static_cast<const SkyObject *>(nullptr));
+    QCOMPARE(index.find("Encke"), encke);
+    QCOMPARE(index.find("Vega"), vega);
+
+    // A type that was not indexed yet
+    const SkyObject *m1 = add(SkyObject::SUPERNOVA_REMNANT, "M 1");
+    QCOMPARE(index.find("M 1"), static_cast<const SkyObject *>(nullptr));
+    index.update();
+    QCOMPARE(index.find("M 1"), m1);
+
+    index.invalidateAll();
+    QCOMPARE(index.size(), 0);
+    index.update();
+    QCOMPARE(index.size(), 3);
+}
+
+QTEST_GUILESS_MAIN(TestNameIndex)
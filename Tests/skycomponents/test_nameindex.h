@@ -0,0 +1,55 @@
+/***************************************************************************
+                   test_nameindex.h  -  KStars Planetarium
+                             -------------------
+    begin                : 2026
+    copyright            : (c) 2026 KStars Developers
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TEST_NAMEINDEX_H
+#define TEST_NAMEINDEX_H
+
+#include "skycomponents/nameindex.h"
+#include "skyobjects/skyobject.h"
+
+#include <QtTest/QtTest>
+
+#include <memory>
+
+/**
+ * @class TestNameIndex
+ * @short Checks the lookups of the name index against the object lists
+ */
+class TestNameIndex : public QObject
+{
+        Q_OBJECT
+
+    public:
+        TestNameIndex();
+
+    private slots:
+        void init();
+
+        void testFind();
+        void testSearchOrder();
+        void testPrefix();
+        void testEntries();
+        void testInvalidate();
+
+    private:
+        /** @short Add an object of the given type, listed under its name */
+        const SkyObject *add(int type, const QString &name);
+
+        QList<std::shared_ptr<SkyObject>> objects;
+        NameIndex::Lists lists;
+};
+
+#endif
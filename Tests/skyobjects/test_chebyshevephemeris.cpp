@@ -0,0 +1,236 @@
+/***************************************************************************
+             test_chebyshevephemeris.cpp  -  KStars Planetarium
+                             -------------------
+    begin                : 2026
+    copyright            : (c) 2026 KStars Developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+/* Project Includes */
+#include "test_chebyshevephemeris.h"
+#include "skyobjects/chebyshevephemeris.h"
+#include "skyobjects/ksmoon.h"
+#include "skyobjects/ksplanet.h"
+#include "time/kstarsdatetime.h"
+#include "Options.h"
+
+#include <atomic>
+#include <memory>
+
+namespace
+{
+// Angle between two ecliptic positions, in radians
+double separation(const EclipticPosition &a, const EclipticPosition &b)
+{
+    double sinL1, cosL1, sinB1, cosB1, sinL2, cosL2, sinB2, cosB2;
+    a.longitude.SinCos(sinL1, cosL1);
+    a.latitude.SinCos(sinB1, cosB1);
+    b.longitude.SinCos(sinL2, cosL2);
+    b.latitude.SinCos(sinB2, cosB2);
+
+    const double dx = cosB1 * cosL1 - cosB2 * cosL2;
+    const double dy = cosB1 * sinL1 - cosB2 * sinL2;
+    const double dz = sinB1 - sinB2;
+    return sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+// The series are evaluated on the worker threads of the cache, so they hold on to their planet
+ChebyshevEphemeris::SeriesSource sourceOf(const ChebyshevEphemeris::SeriesFunction &evaluate,
+        const QByteArray &checksum = "test")
+{
+    return [evaluate, checksum]()
+    {
+        ChebyshevEphemeris::Series series;
+        series.evaluate = evaluate;
+        series.checksum = checksum;
+        return series;
+    };
+}
+
+ChebyshevEphemeris::SeriesFunction jupiterSeries(std::atomic<int> &calls)
+{
+    auto jupiter = std::make_shared<KSPlanet>(KSPlanetBase::JUPITER);
+    return [jupiter, &calls](double jd, EclipticPosition & ret)
+    {
+        ++calls;
+        jupiter->calcEclipticSeries((jd - J2000) / 365250.0, ret);
+    };
+}
+}
+
+TestChebyshevEphemeris::TestChebyshevEphemeris() : QObject()
+{
+}
+
+void TestChebyshevEphemeris::initTestCase()
+{
+    useEphemerisCache = Options::useEphemerisCache();
+    Options::setUseEphemerisCache(true);
+
+    QVERIFY(storage.isValid());
+    ChebyshevEphemeris::Instance()->setStorageDirectory(storage.path());
+}
+
+void TestChebyshevEphemeris::cleanupTestCase()
+{
+    Options::setUseEphemerisCache(useEphemerisCache);
+}
+
+void TestChebyshevEphemeris::cleanup()
+{
+    // Each test starts from the stored blocks only
+    ChebyshevEphemeris::Instance()->waitForFits();
+    ChebyshevEphemeris::Instance()->clear();
+}
+
+void TestChebyshevEphemeris::testAccuracy_data()
+{
+    QTest::addColumn<int>("PLANET");
+    QTest::addColumn<double>("JD");
+
+    // Dates spread across the cached range, some on segment boundaries
+    QList<double> const dates { 2378496.5, 2415020.0, 2451545.0, 2451545.0 + 1.0 / 3.0, 2460000.25, 2488069.5, 2524593.0 };
+
+    for (int planet : { KSPlanetBase::MERCURY, KSPlanetBase::VENUS, KSPlanetBase::MARS, KSPlanetBase::JUPITER,
+                        KSPlanetBase::SATURN, KSPlanetBase::URANUS, KSPlanetBase::NEPTUNE, KSPlanetBase::MOON })
+        for (double jd : dates)
+            QTest::newRow(QString("%1 at %2").arg(planet).arg(jd, 0, 'f', 3).toLatin1().constData()) << planet << jd;
+}
+
+void TestChebyshevEphemeris::testAccuracy()
+{
+    QFETCH(int, PLANET);
+    QFETCH(double, JD);
+
+    EclipticPosition expected, interpolated;
+    QString body;
+    ChebyshevEphemeris::SeriesFunction series;
+
+    std::shared_ptr<KSPlanetBase> planet;
+    if (PLANET == KSPlanetBase::MOON)
+    {
+        auto moon = std::make_shared<KSMoon>();
+        planet    = moon;
+        body      = "Moon";
+        series    = [moon](double jd, EclipticPosition & ret)
+        {
+            moon->calcEclipticSeries((jd - J2000) / 36525.0, ret);
+        };
+    }
+    else
+    {
+        auto p = std::make_shared<KSPlanet>(PLANET);
+        planet = p;
+        body   = p->untranslatedName();
+        series = [p](double jd, EclipticPosition & ret)
+        {
+            p->calcEclipticSeries((jd - J2000) / 365250.0, ret);
+        };
+    }
+
+    if (!planet->loadData())
+        QSKIP("The orbital data of the planet is not installed");
+
+    // The block is fitted in the background, the caller sums the series meanwhile
+    series(JD, expected);
+    ChebyshevEphemeris::Instance()->position(body, JD, sourceOf(series), interpolated);
+    ChebyshevEphemeris::Instance()->waitForFits();
+    QVERIFY(ChebyshevEphemeris::Instance()->position(body, JD, sourceOf(series), interpolated));
+
+    QVERIFY(separation(expected, interpolated) < ChebyshevEphemeris::Tolerance);
+    QVERIFY(fabs(expected.radius - interpolated.radius) / expected.radius < ChebyshevEphemeris::Tolerance);
+    QVERIFY(interpolated.longitude.Degrees() >= 0 && interpolated.longitude.Degrees() < 360);
+
+    // KSPlanet goes through the cache transparently
+    if (PLANET != KSPlanetBase::MOON)
+    {
+        EclipticPosition viaPlanet;
+        static_cast<KSPlanet *>(planet.get())->calcEcliptic((JD - J2000) / 365250.0, viaPlanet);
+        QVERIFY(separation(expected, viaPlanet) < ChebyshevEphemeris::Tolerance);
+    }
+
+    QVERIFY(ChebyshevEphemeris::Instance()->maxFitError() < ChebyshevEphemeris::Tolerance);
+}
+
+void TestChebyshevEphemeris::testOutOfRange()
+{
+    int sources = 0;
+    auto source = [&sources]()
+    {
+        ++sources;
+        return ChebyshevEphemeris::Series();
+    };
+    EclipticPosition pos;
+
+    QVERIFY(!ChebyshevEphemeris::Instance()->position("Mars", ChebyshevEphemeris::MinJD - 1, source, pos));
+    QVERIFY(!ChebyshevEphemeris::Instance()->position("Mars", ChebyshevEphemeris::MaxJD, source, pos));
+    QVERIFY(!ChebyshevEphemeris::Instance()->position("Halley", 2451545.0, source, pos));
+    QCOMPARE(sources, 0);
+
+    Options::setUseEphemerisCache(false);
+    QVERIFY(!ChebyshevEphemeris::Instance()->position("Mars", 2451545.0, source, pos));
+    Options::setUseEphemerisCache(true);
+    QCOMPARE(sources, 0);
+}
+
+void TestChebyshevEphemeris::testStorage()
+{
+    if (!KSPlanet(KSPlanetBase::JUPITER).loadData())
+        QSKIP("The orbital data of the planet is not installed");
+
+    std::atomic<int> calls { 0 };
+    const ChebyshevEphemeris::SeriesFunction series = jupiterSeries(calls);
+
+    // A date in a block no other test has touched
+    const double jd = 2440000.5;
+    EclipticPosition first, second;
+
+    // The first request does not wait for the fit
+    QVERIFY(!ChebyshevEphemeris::Instance()->position("Jupiter", jd, sourceOf(series), first));
+    ChebyshevEphemeris::Instance()->waitForFits();
+    QVERIFY(calls > 0);
+    QVERIFY(ChebyshevEphemeris::Instance()->position("Jupiter", jd, sourceOf(series), first));
+    QVERIFY(QFile::exists(QDir(storage.path()).filePath("jupiter.cheb")));
+
+    // Blocks are read back from disk instead of being fitted again
+    ChebyshevEphemeris::Instance()->clear();
+    calls = 0;
+    QVERIFY(ChebyshevEphemeris::Instance()->position("Jupiter", jd, sourceOf(series), second));
+    ChebyshevEphemeris::Instance()->waitForFits();
+    QCOMPARE(calls.load(), 0);
+    QCOMPARE(second.longitude.Degrees(), first.longitude.Degrees());
+    QCOMPARE(second.latitude.Degrees(), first.latitude.Degrees());
+    QCOMPARE(second.radius, first.radius);
+}
+
+void TestChebyshevEphemeris::testChecksum()
+{
+    if (!KSPlanet(KSPlanetBase::JUPITER).loadData())
+        QSKIP("The orbital data of the planet is not installed");
+
+    std::atomic<int> calls { 0 };
+    const ChebyshevEphemeris::SeriesFunction series = jupiterSeries(calls);
+    const double jd = 2440000.5;
+    EclipticPosition pos;
+
+    QVERIFY(ChebyshevEphemeris::Instance()->position("Jupiter", jd, sourceOf(series), pos));
+    ChebyshevEphemeris::Instance()->waitForFits();
+    QCOMPARE(calls.load(), 0);
+
+    // Blocks stored for other series data are discarded and fitted again
+    ChebyshevEphemeris::Instance()->clear();
+    QVERIFY(!ChebyshevEphemeris::Instance()->position("Jupiter", jd, sourceOf(series, "updated"), pos));
+    ChebyshevEphemeris::Instance()->waitForFits();
+    QVERIFY(calls > 0);
+    QVERIFY(ChebyshevEphemeris::Instance()->position("Jupiter", jd, sourceOf(series, "updated"), pos));
+}
+
+QTEST_GUILESS_MAIN(TestChebyshevEphemeris)
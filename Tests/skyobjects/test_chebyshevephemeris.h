@@ -0,0 +1,50 @@
+/***************************************************************************
+              test_chebyshevephemeris.h  -  KStars Planetarium
+                             -------------------
+    begin                : 2026
+    copyright            : (c) 2026 KStars Developers
+***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TEST_CHEBYSHEVEPHEMERIS_H
+#define TEST_CHEBYSHEVEPHEMERIS_H
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+
+/**
+ * @class TestChebyshevEphemeris
+ * @short Checks the interpolated planetary and lunar positions against their series
+ */
+class TestChebyshevEphemeris : public QObject
+{
+        Q_OBJECT
+
+    public:
+        TestChebyshevEphemeris();
+
+    private slots:
+        void initTestCase();
+        void cleanupTestCase();
+        void cleanup();
+
+        void testAccuracy_data();
+        void testAccuracy();
+        void testOutOfRange();
+        void testStorage();
+        void testChecksum();
+
+    private:
+        bool useEphemerisCache { true };
+        QTemporaryDir storage;
+};
+
+#endif // TEST_CHEBYSHEVEPHEMERIS_H
@@ -0,0 +1,141 @@
+/*  KStars tests
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "testvisibilityengine.h"
+
+#include "geolocation.h"
+#include "kstarsdata.h"
+#include "Options.h"
+#include "skyobjects/skyobject.h"
+#include "tools/visibilityengine.h"
+
+TestVisibilityEngine::TestVisibilityEngine(QObject *parent) : QObject(parent)
+{
+}
+
+void TestVisibilityEngine::initTestCase()
+{
+    // Light bending is checked while batches are evaluated. Without a sky composite there is no
+    // Sun, so no light is bent, but the parallel batches still run with the correction enabled.
+    KStarsData::Create();
+    m_UseRelativistic = Options::useRelativistic();
+    Options::setUseRelativistic(true);
+}
+
+void TestVisibilityEngine::cleanupTestCase()
+{
+    Options::setUseRelativistic(m_UseRelativistic);
+}
+
+void TestVisibilityEngine::testAnalyticFraction_data()
+{
+    QTest::addColumn<double>("LAT");
+    QTest::addColumn<double>("RA");
+    QTest::addColumn<double>("DEC");
+    QTest::addColumn<double>("MINALT");
+    QTest::addColumn<double>("MAXALT");
+
+    QTest::newRow("circumpolar") << 48.0 << 37.95 << 89.26 << 15.0 << 90.0;
+    QTest::newRow("never rises") << 48.0 << 95.98 << -52.69 << 0.0 << 90.0;
+    QTest::newRow("rises and sets") << 48.0 << 279.23 << 38.78 << 15.0 << 90.0;
+    QTest::newRow("clipped by max alt") << 48.0 << 279.23 << 38.78 << 15.0 << 60.0;
+    QTest::newRow("southern sky") << -33.0 << 201.30 << -11.16 << 30.0 << 80.0;
+    QTest::newRow("near zenith") << 48.0 << 0.0 << 48.0 << 6.0 << 89.0;
+}
+
+void TestVisibilityEngine::testAnalyticFraction()
+{
+    QFETCH(double, LAT);
+    QFETCH(double, RA);
+    QFETCH(double, DEC);
+    QFETCH(double, MINALT);
+    QFETCH(double, MAXALT);
+
+    GeoLocation geo(dms(2.35), dms(LAT));
+    KStarsDateTime const midnightUT(QDate(2026, 6, 21), QTime(0, 0, 0), Qt::UTC);
+    VisibilityEngine engine(&geo, midnightUT);
+
+    // Check a few ranges against a dense sampling of the altitude
+    for (int hours : { 1, 6, 12, 24 })
+    {
+        KStarsDateTime const startUT = midnightUT.addSecs(-hours * 1800);
+        KStarsDateTime const endUT   = midnightUT.addSecs(hours * 1800);
+
+        int samples = 0, visible = 0;
+        for (KStarsDateTime t = startUT; t < endUT; t = t.addSecs(30))
+        {
+            SkyPoint p(RA / 15.0, DEC);
+            dms const LST = geo.GSTtoLST(t.gst());
+            p.EquatorialToHorizontal(&LST, geo.lat());
+            samples++;
+            if (p.alt().Degrees() >= MINALT && p.alt().Degrees() <= MAXALT)
+                visible++;
+        }
+
+        double const sampled  = static_cast<double>(visible) / samples;
+        double const analytic = engine.visibleFraction(RA, DEC, startUT, endUT, MINALT, MAXALT);
+        QVERIFY2(fabs(sampled - analytic) < 4.0 / samples + 1e-6,
+                 qPrintable(QString("%1h range: sampled %2, analytic %3").arg(hours).arg(sampled).arg(analytic)));
+    }
+}
+
+void TestVisibilityEngine::testBatchMatchesSingle()
+{
+    GeoLocation geo(dms(-70.0), dms(-30.0));
+    KStarsDateTime const midnightUT(QDate(2026, 1, 15), QTime(4, 0, 0), Qt::UTC);
+    KStarsDateTime const startUT = midnightUT.addSecs(-5 * 3600);
+    KStarsDateTime const endUT   = midnightUT.addSecs(5 * 3600);
+
+    QList<SkyObject *> objects;
+    QVector<const SkyObject *> batch;
+    for (int ra = 0; ra < 360; ra += 15)
+    {
+        for (int dec = -80; dec <= 80; dec += 20)
+        {
+            objects.append(new SkyObject(SkyObject::STAR, dms(ra), dms(dec), 5.0));
+            batch.append(objects.last());
+        }
+    }
+
+    VisibilityEngine engine(&geo, midnightUT);
+    QVector<double> const fractions = engine.visibleFractions(batch, startUT, endUT, 10.0, 90.0);
+    QCOMPARE(fractions.size(), batch.size());
+
+    QVERIFY(engine.isForNight(&geo, midnightUT));
+    GeoLocation otherGeo(dms(-70.0), dms(-29.0));
+    QVERIFY(!engine.isForNight(&otherGeo, midnightUT));
+    QVERIFY(!engine.isForNight(&geo, midnightUT.addDays(1)));
+
+    for (int i = 0; i < batch.size(); ++i)
+    {
+        QVERIFY(fractions[i] >= 0.0 && fractions[i] <= 1.0);
+        QCOMPARE(engine.visibleFraction(batch[i], startUT, endUT, 10.0, 90.0), fractions[i]);
+    }
+
+    qDeleteAll(objects);
+}
+
+void TestVisibilityEngine::testReusedObject()
+{
+    GeoLocation geo(dms(10.0), dms(50.0));
+    KStarsDateTime const midnightUT(QDate(2026, 3, 1), QTime(23, 0, 0), Qt::UTC);
+    KStarsDateTime const startUT = midnightUT.addSecs(-4 * 3600);
+    KStarsDateTime const endUT   = midnightUT.addSecs(4 * 3600);
+
+    // A circumpolar object, then a southern one at the same address, as after a catalog reload
+    SkyObject object(SkyObject::STAR, dms(30.0), dms(80.0), 5.0);
+    VisibilityEngine engine(&geo, midnightUT);
+    QCOMPARE(engine.visibleFractions({ &object }, startUT, endUT, 10.0).first(), 1.0);
+
+    object.setDec0(dms(-60.0));
+    QCOMPARE(engine.visibleFractions({ &object }, startUT, endUT, 10.0).first(), 0.0);
+    QCOMPARE(engine.visibleFraction(&object, startUT, endUT, 10.0), 0.0);
+}
+
+QTEST_GUILESS_MAIN(TestVisibilityEngine)
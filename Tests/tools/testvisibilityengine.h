@@ -0,0 +1,35 @@
+/*  KStars tests
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#ifndef TESTVISIBILITYENGINE_H
+#define TESTVISIBILITYENGINE_H
+
+#include <QtTest>
+#include <QObject>
+
+class TestVisibilityEngine : public QObject
+{
+    Q_OBJECT
+public:
+    explicit TestVisibilityEngine(QObject *parent = nullptr);
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testAnalyticFraction_data();
+    void testAnalyticFraction();
+    void testBatchMatchesSingle();
+    void testReusedObject();
+
+private:
+    bool m_UseRelativistic { false };
+};
+
+#endif // TESTVISIBILITYENGINE_H
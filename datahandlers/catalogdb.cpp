@@ -20,6 +20,7 @@
 #include "catalogdata.h"
 #include "catalogentrydata.h"
 #include "kstars/version.h"
+#include "../kstars/nan.h"
 #include "../kstars/auxiliary/kspaths.h"
 #include "starobject.h"
 #include "deepskyobject.h"
@@ -32,6 +33,28 @@
 
 #include <catalog_debug.h>
 
+#include <cmath>
+
+namespace
+{
+// Matching tolerances of FindFuzzyEntry(), in degrees and magnitudes
+const double FuzzPosition  = 0.0016;
+const double FuzzMagnitude = 0.1;
+}
+
+struct CatalogDB::InsertQueries
+{
+    explicit InsertQueries(const QSqlDatabase &db) : fuzzy(db), dso(db), index(db), designation(db), next_designation(db)
+    {
+    }
+
+    QSqlQuery fuzzy;
+    QSqlQuery dso;
+    QSqlQuery index;
+    QSqlQuery designation;
+    QSqlQuery next_designation;
+};
+
 bool CatalogDB::Initialize()
 {
     skydb_ = QSqlDatabase::addDatabase("QSQLITE", "skydb");
@@ -65,11 +88,36 @@ bool CatalogDB::Initialize()
         {
             FirstRun();
         }
+        SetupSpatialIndex();
     }
     skydb_.close();
     return true;
 }
 
+void CatalogDB::SetupSpatialIndex()
+{
+    QSqlQuery query(skydb_);
+
+    // Persistent, lets the catalogs be read while another one is being imported
+    if (!query.exec("PRAGMA journal_mode=WAL"))
+        qCWarning(KSTARS_CATALOG) << query.lastError();
+
+    bool upgrade       = !skydb_.tables().contains("DSOIndex");
+    has_spatial_index_ = query.exec("CREATE VIRTUAL TABLE IF NOT EXISTS DSOIndex USING rtree("
+                                    "id, MinRA, MaxRA, MinDec, MaxDec)");
+    if (!has_spatial_index_)
+    {
+        qCWarning(KSTARS_CATALOG) << "SQLite has no R*Tree support, using a plain index on DSO:" << query.lastError();
+        if (!query.exec("CREATE INDEX IF NOT EXISTS DSO_RA_Dec ON DSO (RA, Dec)"))
+            qCWarning(KSTARS_CATALOG) << query.lastError();
+        return;
+    }
+
+    // Databases created before the index existed
+    if (upgrade && !query.exec("INSERT INTO DSOIndex SELECT UID, RA, RA, Dec, Dec FROM DSO"))
+        qCWarning(KSTARS_CATALOG) << query.lastError();
+}
+
 void CatalogDB::FirstRun()
 {
     qCWarning(KSTARS_CATALOG) << "Rebuilding Additional Sky Catalog Database";
@@ -260,41 +308,69 @@ void CatalogDB::ClearDSOEntries(int catalog_id)
     skydb_.close();
 }
 
-int CatalogDB::FindFuzzyEntry(const double ra, const double dec, const double magnitude)
+bool CatalogDB::PrepareFuzzyQuery(QSqlQuery &query)
 {
     /*
      * FIXME (spacetime): Match the incoming entry with the ones from the db
      * with certain fuzz. If found, store it in rowuid
      * This Fuzz has not been established after due discussion
     */
-    //skydb_.open();
-    QSqlTableModel dsoentries(nullptr, skydb_);
-
-    QString filter = "((RA - " + QString().setNum(ra) +
-                     ") between -0.0016 and 0.0016) and "
-                     "((Dec - " +
-                     QString().setNum(dec) +
-                     ") between -0.0016 and 0.0016) and"
-                     "((Magnitude - " +
-                     QString().setNum(magnitude) + ") between -0.1 and 0.1)";
-    //   qDebug() << filter;
-    dsoentries.setTable("DSO");
-    dsoentries.setFilter(filter);
-    dsoentries.select();
-
-    int entry_count   = dsoentries.rowCount();
-    QSqlRecord record = dsoentries.record(0);
+    const QString fuzz = QString("(DSO.RA - :ra) BETWEEN -%1 AND %1 AND "
+                                 "(DSO.Dec - :dec) BETWEEN -%1 AND %1 AND "
+                                 "(DSO.Magnitude - :mag) BETWEEN -%2 AND %2 ")
+                         .arg(FuzzPosition)
+                         .arg(FuzzMagnitude);
+
+    // The R*Tree stores single precision bounds, the DSO columns are checked as well
+    if (has_spatial_index_)
+        return query.prepare("SELECT DSO.UID FROM DSOIndex JOIN DSO ON DSO.UID = DSOIndex.id WHERE "
+                             "DSOIndex.MaxRA >= :minRA AND DSOIndex.MinRA <= :maxRA AND "
+                             "DSOIndex.MaxDec >= :minDec AND DSOIndex.MinDec <= :maxDec AND " +
+                             fuzz + "ORDER BY DSO.UID LIMIT 1");
+
+    return query.prepare("SELECT DSO.UID FROM DSO WHERE "
+                         "DSO.RA BETWEEN :minRA AND :maxRA AND DSO.Dec BETWEEN :minDec AND :maxDec AND " +
+                         fuzz + "ORDER BY DSO.UID LIMIT 1");
+}
 
-    int returnval = -1;
-    if (entry_count > 0)
-        returnval = record.value("UID").toInt();
+int CatalogDB::FindFuzzyEntry(const double ra, const double dec, const double magnitude)
+{
+    //skydb_.open();
+    QSqlQuery query(skydb_);
+    if (!PrepareFuzzyQuery(query))
+    {
+        qCWarning(KSTARS_CATALOG) << query.lastError();
+        return -1;
+    }
 
-    dsoentries.clear();
+    int returnval = FindFuzzyEntry(query, ra, dec, magnitude);
     //skydb_.close();
     //   qDebug() << returnval;
     return returnval;
 }
 
+int CatalogDB::FindFuzzyEntry(QSqlQuery &query, const double ra, const double dec, const double magnitude)
+{
+    // Slightly wider bounds for the index, the exact test is done on the DSO columns
+    const double margin = FuzzPosition * 1.01;
+    query.bindValue(":minRA", ra - margin);
+    query.bindValue(":maxRA", ra + margin);
+    query.bindValue(":minDec", dec - margin);
+    query.bindValue(":maxDec", dec + margin);
+    query.bindValue(":ra", ra);
+    query.bindValue(":dec", dec);
+    query.bindValue(":mag", magnitude);
+
+    int returnval = -1;
+    if (!query.exec())
+        qCWarning(KSTARS_CATALOG) << query.lastError();
+    else if (query.next())
+        returnval = query.value(0).toInt();
+
+    query.finish();
+    return returnval;
+}
+
 bool CatalogDB::AddEntry(const CatalogEntryData &catalog_entry, int catid)
 {
     if (!skydb_.open())
@@ -303,12 +379,45 @@ bool CatalogDB::AddEntry(const CatalogEntryData &catalog_entry, int catid)
         qCWarning(KSTARS_CATALOG) << LastError();
         return false;
     }
-    bool retVal = _AddEntry(catalog_entry, catid);
+    bool retVal = false;
+    {
+        InsertQueries queries(skydb_);
+        if (PrepareInsertQueries(queries))
+            retVal = _AddEntry(catalog_entry, catid, queries);
+    }
     skydb_.close();
     return retVal;
 }
 
-bool CatalogDB::_AddEntry(const CatalogEntryData &catalog_entry, int catid)
+bool CatalogDB::PrepareInsertQueries(InsertQueries &queries)
+{
+    bool ok = PrepareFuzzyQuery(queries.fuzzy);
+
+    ok = ok && queries.dso.prepare("INSERT INTO DSO (RA, Dec, Type, Magnitude, PositionAngle,"
+                                   " MajorAxis, MinorAxis, Flux) VALUES (:RA, :Dec, :Type,"
+                                   " :Magnitude, :PositionAngle, :MajorAxis, :MinorAxis,"
+                                   " :Flux)");
+
+    if (has_spatial_index_)
+        ok = ok && queries.index.prepare("INSERT INTO DSOIndex (id, MinRA, MaxRA, MinDec, MaxDec)"
+                                         " VALUES (:rowuid, :minRA, :maxRA, :minDec, :maxDec)");
+
+    ok = ok && queries.designation.prepare("INSERT INTO ObjectDesignation (id_Catalog, UID_DSO, LongName"
+                                           ", IDNumber) VALUES (:catid, :rowuid, :longname, :id)");
+
+    //qWarning() << "FIXME: This query has not been tested!!!!";
+    ok = ok && queries.next_designation.prepare(
+                "INSERT INTO ObjectDesignation (id_Catalog, UID_DSO, LongName"
+                ", IDNumber) VALUES (:catid, :rowuid, :longname,"
+                "(SELECT MAX(ISNULL(IDNumber,1))+1 FROM ObjectDesignation WHERE id_Catalog = :catid) )");
+
+    if (!ok)
+        qCWarning(KSTARS_CATALOG) << "Cannot prepare catalog entry queries:" << LastError();
+
+    return ok;
+}
+
+bool CatalogDB::_AddEntry(const CatalogEntryData &catalog_entry, int catid, InsertQueries &queries)
 {
     // Verification step
     // If RA, Dec are Null, it denotes an invalid object and should not be written
@@ -329,16 +438,12 @@ bool CatalogDB::_AddEntry(const CatalogEntryData &catalog_entry, int catid)
     // out the lastInsertId
 
     // Part 2: Fuzzy Match or Create New Entry
-    int rowuid = FindFuzzyEntry(catalog_entry.ra, catalog_entry.dec, catalog_entry.magnitude);
+    int rowuid = FindFuzzyEntry(queries.fuzzy, catalog_entry.ra, catalog_entry.dec, catalog_entry.magnitude);
     //skydb_.open();
 
     if (rowuid == -1) //i.e. No fuzzy match found. Proceed to add new entry
     {
-        QSqlQuery add_query(skydb_);
-        add_query.prepare("INSERT INTO DSO (RA, Dec, Type, Magnitude, PositionAngle,"
-                          " MajorAxis, MinorAxis, Flux) VALUES (:RA, :Dec, :Type,"
-                          " :Magnitude, :PositionAngle, :MajorAxis, :MinorAxis,"
-                          " :Flux)");
+        QSqlQuery &add_query = queries.dso;
         add_query.bindValue(":RA", catalog_entry.ra);
         add_query.bindValue(":Dec", catalog_entry.dec);
         add_query.bindValue(":Type", catalog_entry.type);
@@ -356,7 +461,20 @@ bool CatalogDB::_AddEntry(const CatalogEntryData &catalog_entry, int catid)
 
         // Find UID of the Row just added
         rowuid = add_query.lastInsertId().toInt();
-        add_query.clear();
+        add_query.finish();
+
+        if (has_spatial_index_)
+        {
+            QSqlQuery &add_index = queries.index;
+            add_index.bindValue(":rowuid", rowuid);
+            add_index.bindValue(":minRA", catalog_entry.ra);
+            add_index.bindValue(":maxRA", catalog_entry.ra);
+            add_index.bindValue(":minDec", catalog_entry.dec);
+            add_index.bindValue(":maxDec", catalog_entry.dec);
+            if (!add_index.exec())
+                qCWarning(KSTARS_CATALOG) << "Custom Catalog Index Query FAILED!" << add_index.lastError();
+            add_index.finish();
+        }
     }
     int ID = catalog_entry.ID;
 
@@ -374,20 +492,9 @@ bool CatalogDB::_AddEntry(const CatalogEntryData &catalog_entry, int catid)
 
     // Part 3: Add in Object Designation
     //skydb_.open();
-    QSqlQuery add_od(skydb_);
+    QSqlQuery &add_od = ID >= 0 ? queries.designation : queries.next_designation;
     if (ID >= 0)
-    {
-        add_od.prepare("INSERT INTO ObjectDesignation (id_Catalog, UID_DSO, LongName"
-                       ", IDNumber) VALUES (:catid, :rowuid, :longname, :id)");
         add_od.bindValue(":id", ID);
-    }
-    else
-    {
-        //qWarning() << "FIXME: This query has not been tested!!!!";
-        add_od.prepare("INSERT INTO ObjectDesignation (id_Catalog, UID_DSO, LongName"
-                       ", IDNumber) VALUES (:catid, :rowuid, :longname,"
-                       "(SELECT MAX(ISNULL(IDNumber,1))+1 FROM ObjectDesignation WHERE id_Catalog = :catid) )");
-    }
     add_od.bindValue(":catid", catid);
     add_od.bindValue(":rowuid", rowuid);
     add_od.bindValue(":longname", catalog_entry.long_name);
@@ -399,7 +506,7 @@ bool CatalogDB::_AddEntry(const CatalogEntryData &catalog_entry, int catid)
         qWarning() << skydb_.lastError();
         retVal = false;
     }
-    add_od.clear();
+    add_od.finish();
     //skydb_.close();
 
     return retVal;
@@ -548,8 +655,22 @@ bool CatalogDB::AddCatalogContents(const QString &fname)
         int catid = FindCatalog(catalog_name);
 
         skydb_.open();
+
+        // Safe with the WAL journal, a crash may only lose the last transactions
+        QSqlQuery pragma(skydb_);
+        if (!pragma.exec("PRAGMA synchronous=NORMAL") || !pragma.exec("PRAGMA cache_size=-65536"))
+            qCWarning(KSTARS_CATALOG) << pragma.lastError();
+
+        InsertQueries queries(skydb_);
+        if (!PrepareInsertQueries(queries))
+        {
+            skydb_.close();
+            return false;
+        }
+
         skydb_.transaction();
 
+        int entries = 0;
         QHash<QString, QVariant> row_content;
         while (catalog_text_parser.HasNextRow())
         {
@@ -572,7 +693,14 @@ bool CatalogDB::AddCatalogContents(const QString &fname)
             catalog_entry.minor_axis     = row_content["Mn"].toFloat();
             catalog_entry.flux           = row_content["Flux"].toFloat();
 
-            _AddEntry(catalog_entry, catid);
+            _AddEntry(catalog_entry, catid, queries);
+
+            // Keeps the journal small
+            if (++entries % BulkBatchSize == 0)
+            {
+                skydb_.commit();
+                skydb_.transaction();
+            }
         }
 
         skydb_.commit();
@@ -1008,6 +1136,111 @@ void CatalogDB::GetAllObjects(const QString &catalog, QList<SkyObject *> &sky_li
     skydb_.close();
 }
 
+QList<CatalogEntryData> CatalogDB::QueryRegion(double ra, double dec, double radius, double maglim, int catid)
+{
+    QList<CatalogEntryData> entries;
+
+    // Bounding boxes of the circle, in the RA range [0, 360)
+    QList<QPair<double, double>> ra_ranges;
+    double min_dec    = dec - radius;
+    double max_dec    = dec + radius;
+    double cos_dec    = std::cos(dec * dms::DegToRad);
+    double sin_radius = std::sin(radius * dms::DegToRad);
+
+    if (min_dec <= -90.0 || max_dec >= 90.0 || sin_radius >= cos_dec)
+    {
+        // The circle contains a pole
+        ra_ranges.append(qMakePair(0.0, 360.0));
+    }
+    else
+    {
+        double half_width = std::asin(sin_radius / cos_dec) / dms::DegToRad;
+        double min_ra     = std::fmod(ra - half_width + 360.0, 360.0);
+        double max_ra     = min_ra + 2 * half_width;
+        if (max_ra > 360.0)
+        {
+            ra_ranges.append(qMakePair(min_ra, 360.0));
+            ra_ranges.append(qMakePair(0.0, max_ra - 360.0));
+        }
+        else
+            ra_ranges.append(qMakePair(min_ra, max_ra));
+    }
+
+    QString sql = has_spatial_index_ ?
+                  "SELECT Catalog.Name, IDNumber, LongName, DSO.RA, DSO.Dec, Type, Magnitude, "
+                  "PositionAngle, MajorAxis, MinorAxis, Flux FROM DSOIndex "
+                  "JOIN DSO ON DSO.UID = DSOIndex.id "
+                  "JOIN ObjectDesignation ON ObjectDesignation.UID_DSO = DSO.UID "
+                  "JOIN Catalog ON Catalog.id = ObjectDesignation.id_Catalog WHERE "
+                  "DSOIndex.MaxRA >= :minRA AND DSOIndex.MinRA <= :maxRA AND "
+                  "DSOIndex.MaxDec >= :minDec AND DSOIndex.MinDec <= :maxDec AND "
+                  "(Magnitude IS NULL OR Magnitude <= :maglim)" :
+                  "SELECT Catalog.Name, IDNumber, LongName, DSO.RA, DSO.Dec, Type, Magnitude, "
+                  "PositionAngle, MajorAxis, MinorAxis, Flux FROM DSO "
+                  "JOIN ObjectDesignation ON ObjectDesignation.UID_DSO = DSO.UID "
+                  "JOIN Catalog ON Catalog.id = ObjectDesignation.id_Catalog WHERE "
+                  "DSO.RA BETWEEN :minRA AND :maxRA AND DSO.Dec BETWEEN :minDec AND :maxDec AND "
+                  "(Magnitude IS NULL OR Magnitude <= :maglim)";
+    if (catid >= 0)
+        sql += " AND Catalog.id = :catid";
+
+    skydb_.open();
+    {
+        QSqlQuery query(skydb_);
+        query.setForwardOnly(true);
+        if (!query.prepare(sql))
+            qCWarning(KSTARS_CATALOG) << query.lastError();
+
+        double sin_dec    = std::sin(dec * dms::DegToRad);
+        double cos_radius = std::cos(radius * dms::DegToRad);
+
+        for (const auto &range : ra_ranges)
+        {
+            query.bindValue(":minRA", range.first);
+            query.bindValue(":maxRA", range.second);
+            query.bindValue(":minDec", min_dec);
+            query.bindValue(":maxDec", max_dec);
+            query.bindValue(":maglim", maglim);
+            if (catid >= 0)
+                query.bindValue(":catid", catid);
+
+            if (!query.exec())
+            {
+                qCWarning(KSTARS_CATALOG) << query.lastQuery();
+                qCWarning(KSTARS_CATALOG) << query.lastError();
+                continue;
+            }
+
+            while (query.next())
+            {
+                CatalogEntryData entry;
+                entry.ra  = query.value(3).toDouble();
+                entry.dec = query.value(4).toDouble();
+
+                // The boxes are wider than the circle
+                double d = entry.dec * dms::DegToRad;
+                if (sin_dec * std::sin(d) + cos_dec * std::cos(d) * std::cos((entry.ra - ra) * dms::DegToRad) <
+                    cos_radius)
+                    continue;
+
+                entry.catalog_name   = query.value(0).toString();
+                entry.ID             = query.value(1).toInt();
+                entry.long_name      = query.value(2).toString();
+                entry.type           = query.value(5).toInt();
+                entry.magnitude      = query.value(6).isNull() ? NaN::f : query.value(6).toFloat();
+                entry.position_angle = query.value(7).toInt();
+                entry.major_axis     = query.value(8).toFloat();
+                entry.minor_axis     = query.value(9).toFloat();
+                entry.flux           = query.value(10).toFloat();
+                entries.append(entry);
+            }
+        }
+    }
+    skydb_.close();
+
+    return entries;
+}
+
 QList<QPair<QString, KSParser::DataTypes>> CatalogDB::buildParserSequence(const QStringList &Columns)
 {
     QList<QPair<QString, KSParser::DataTypes>> sequence;
@@ -27,6 +27,7 @@
 #include <QSqlDatabase>
 #include <QSqlError>
 
+class QSqlQuery;
 class SkyObject;
 class CatalogComponent;
 class CatalogData;
@@ -38,6 +39,9 @@ class CatalogEntryData;
  *    hence, the uid is a qint64 i.e. a 64 bit signed integer. Coincidentally,
  *    this is the max limit of an int in Sqlite3.
  *    Hence, the db is compatible with the uid, but doesn't use it as of now.
+ * 2) The DSOIndex table is an R*Tree on the RA and Dec of the DSO table, in
+ *    degrees. It is used for region queries and for the fuzzy matching of new
+ *    entries. Without the R*Tree module, a plain index on DSO is used instead.
  */
 
 class CatalogDB
@@ -89,11 +93,29 @@ class CatalogDB
     /**
      * @short Add contents of custom catalog to the program database
      *
+     * The entries are inserted with prepared statements, in transactions
+     * committed every BulkBatchSize entries.
+     *
      * @p filename the name of the file containing the data to be read
      * @return true if catalog was successfully added
      */
     bool AddCatalogContents(const QString &filename);
 
+    /**
+     * @brief Finds the entries within a circle of the sky.
+     * This lets large catalogs be loaded by field of view rather than whole.
+     *
+     * @note The coordinates are those stored in the database, in the epoch of their catalog.
+     *
+     * @param ra Right Ascension of the center of the circle, in degrees
+     * @param dec Declination of the center of the circle, in degrees
+     * @param radius Radius of the circle, in degrees
+     * @param maglim Faintest magnitude of the entries. Entries without magnitude are always included
+     * @param catid Database ID of the catalog to search, or -1 for all catalogs
+     * @return the entries found, with their catalog name
+     **/
+    QList<CatalogEntryData> QueryRegion(double ra, double dec, double radius, double maglim, int catid = -1);
+
     /**
      * @brief returns the id of the row if it matches with certain fuzz.
      * Else return -1 if none found
@@ -192,7 +214,13 @@ class CatalogDB
      **/
     void AddCatalog(const CatalogData &catalog_data);
 
+    /** Number of entries inserted per transaction by AddCatalogContents() */
+    static const int BulkBatchSize = 50000;
+
   private:
+    /** Prepared statements used to add entries */
+    struct InsertQueries;
+
     /**
      * @brief Used to add a cross referenced entry into the database
      *
@@ -201,15 +229,41 @@ class CatalogDB
      *
      * @param catalog_entry Data structure with entry details
      * @param catid Category ID in the database
+     * @param queries Statements prepared on the opened DB
      * @return false if adding was unsuccessful
      **/
-    bool _AddEntry(const CatalogEntryData &catalog_entry, int catid);
+    bool _AddEntry(const CatalogEntryData &catalog_entry, int catid, InsertQueries &queries);
+
+    /**
+     * @brief Same as the public FindFuzzyEntry(), with the statement prepared
+     * by PrepareFuzzyQuery() on an already-opened DB.
+     **/
+    int FindFuzzyEntry(QSqlQuery &query, const double ra, const double dec, const double magnitude);
+
+    /** @brief Prepares the statement used by FindFuzzyEntry() */
+    bool PrepareFuzzyQuery(QSqlQuery &query);
+
+    /** @brief Prepares the statements used by _AddEntry() on the opened DB */
+    bool PrepareInsertQueries(InsertQueries &queries);
+
+    /**
+     * @brief Creates the DSOIndex R*Tree, and fills it when upgrading an
+     * older database. Falls back to a plain index on DSO without R*Tree support.
+     *
+     * @return void
+     **/
+    void SetupSpatialIndex();
 
     /**
      * @brief Database object for the sky object. Assigned and Initialized by Initialize()
      **/
     QSqlDatabase skydb_;
 
+    /**
+     * @brief True if the DSOIndex R*Tree is available
+     **/
+    bool has_spatial_index_ { false };
+
     /**
      * @brief Returns the last error the database encountered
      *
@@ -35,6 +35,7 @@ unsigned long CachingDms::cachingdms_bad_uses = 0;
 CachingDms::CachingDms(const double &x) : dms(x)
 {
     dms::SinCos(m_sin, m_cos);
+    KSProfiler::count(KSProfiler::CachingDmsComputed);
 #ifdef COUNT_DMS_SINCOS_CALLS
     ++cachingdms_constructor_calls;
     cachingdms_delta -= 2;
@@ -53,6 +54,7 @@ CachingDms::~CachingDms()
 CachingDms::CachingDms(const QString &s, bool isDeg) : dms(s, isDeg)
 {
     dms::SinCos(m_sin, m_cos);
+    KSProfiler::count(KSProfiler::CachingDmsComputed);
 #ifdef COUNT_DMS_SINCOS_CALLS
     ++cachingdms_constructor_calls;
     cachingdms_delta -= 2;
@@ -63,6 +65,7 @@ CachingDms::CachingDms(const QString &s, bool isDeg) : dms(s, isDeg)
 CachingDms::CachingDms(const int &d, const int &m, const int &s, const int &ms) : dms(d, m, s, ms)
 {
     dms::SinCos(m_sin, m_cos);
+    KSProfiler::count(KSProfiler::CachingDmsComputed);
 #ifdef COUNT_DMS_SINCOS_CALLS
     ++cachingdms_constructor_calls;
     cachingdms_delta -= 2;
@@ -145,6 +148,7 @@ CachingDms::CachingDms(const dms &angle)
 {
     D = angle.Degrees();
     dms::SinCos(m_sin, m_cos);
+    KSProfiler::count(KSProfiler::CachingDmsComputed);
 #ifdef COUNT_DMS_SINCOS_CALLS
     ++cachingdms_constructor_calls;
     cachingdms_delta -= 2;
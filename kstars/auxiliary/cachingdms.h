@@ -71,6 +71,7 @@ class CachingDms : public dms
     {
         dms::setD(x);
         dms::SinCos(m_sin, m_cos);
+        KSProfiler::count(KSProfiler::CachingDmsComputed);
 #ifdef COUNT_DMS_SINCOS_CALLS
         cachingdms_delta -= 2;
         if (!m_cacheUsed)
@@ -86,6 +87,7 @@ class CachingDms : public dms
     {
         dms::setD(d, m, s, ms);
         dms::SinCos(m_sin, m_cos);
+        KSProfiler::count(KSProfiler::CachingDmsComputed);
 #ifdef COUNT_DMS_SINCOS_CALLS
         cachingdms_delta -= 2;
         if (!m_cacheUsed)
@@ -103,6 +105,7 @@ class CachingDms : public dms
     {
         dms::setH(x);
         dms::SinCos(m_sin, m_cos);
+        KSProfiler::count(KSProfiler::CachingDmsComputed);
 #ifdef COUNT_DMS_SINCOS_CALLS
         cachingdms_delta -= 2;
         if (!m_cacheUsed)
@@ -119,6 +122,7 @@ class CachingDms : public dms
     {
         dms::setH(h, m, s, ms);
         dms::SinCos(m_sin, m_cos);
+        KSProfiler::count(KSProfiler::CachingDmsComputed);
 #ifdef COUNT_DMS_SINCOS_CALLS
         cachingdms_delta -= 2;
 #endif
@@ -132,6 +136,7 @@ class CachingDms : public dms
     {
         bool retval = dms::setFromString(s, isDeg);
         dms::SinCos(m_sin, m_cos);
+        KSProfiler::count(KSProfiler::CachingDmsComputed);
 #ifdef COUNT_DMS_SINCOS_CALLS
         cachingdms_delta -= 2;
         if (!m_cacheUsed)
@@ -148,6 +153,7 @@ class CachingDms : public dms
     {
         dms::setRadians(a);
         dms::SinCos(m_sin, m_cos);
+        KSProfiler::count(KSProfiler::CachingDmsComputed);
 #ifdef COUNT_DMS_SINCOS_CALLS
         cachingdms_delta -= 2;
         if (!m_cacheUsed)
@@ -187,6 +193,7 @@ class CachingDms : public dms
     {
         s = m_sin;
         c = m_cos;
+        KSProfiler::count(KSProfiler::CachingDmsCacheHits);
 #ifdef COUNT_DMS_SINCOS_CALLS
         cachingdms_delta += 2;
         m_cacheUsed = true;
@@ -200,6 +207,7 @@ class CachingDms : public dms
      */
     inline double sin() const
     {
+        KSProfiler::count(KSProfiler::CachingDmsCacheHits);
 #ifdef COUNT_DMS_SINCOS_CALLS
         ++cachingdms_delta;
         m_cacheUsed = true;
@@ -214,6 +222,7 @@ class CachingDms : public dms
      */
     inline double cos() const
     {
+        KSProfiler::count(KSProfiler::CachingDmsCacheHits);
 #ifdef COUNT_DMS_SINCOS_CALLS
         ++cachingdms_delta;
         m_cacheUsed = true;
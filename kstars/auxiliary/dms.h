@@ -18,6 +18,7 @@
 #pragma once
 
 #include "../nan.h"
+#include "ksprofilercounters.h"
 
 #include <QString>
 #include <QDataStream>
@@ -25,11 +26,6 @@
 #include <cmath>
 
 //#define COUNT_DMS_SINCOS_CALLS true
-//#define PROFILE_SINCOS true
-
-#ifdef PROFILE_SINCOS
-#include <ctime>
-#endif
 
 /** @class dms
  * @short An angle, stored as degrees, but expressible in many ways.
@@ -280,17 +276,8 @@ class dms
             ++redundant_trig_function_calls;
         ++trig_function_calls;
 #endif
-#ifdef PROFILE_SINCOS
-        std::clock_t start, stop;
-        double s;
-        start = std::clock();
-        s     = ::sin(D * DegToRad);
-        stop  = std::clock();
-        seconds_in_trig += double(stop - start) / double(CLOCKS_PER_SEC);
-        return s;
-#else
+        KSProfiler::count(KSProfiler::TrigCalls);
         return ::sin(D * DegToRad);
-#endif
     }
 
     /** @short Compute the Angle's Cosine.
@@ -312,17 +299,8 @@ class dms
             ++redundant_trig_function_calls;
         ++trig_function_calls;
 #endif
-#ifdef PROFILE_SINCOS
-        std::clock_t start, stop;
-        double c;
-        start = std::clock();
-        c     = ::cos(D * DegToRad);
-        stop  = std::clock();
-        seconds_in_trig += double(stop - start) / double(CLOCKS_PER_SEC);
-        return c;
-#else
+        KSProfiler::count(KSProfiler::TrigCalls);
         return ::cos(D * DegToRad);
-#endif
     }
 
     /** @short Express the angle in radians.
@@ -417,7 +395,6 @@ class dms
     static long unsigned dms_with_sincos_called;
     static long unsigned trig_function_calls;           // total number of trig function calls
     static long unsigned redundant_trig_function_calls; // counts number of redundant trig function calls
-    static double seconds_in_trig;                      // accumulates number of seconds spent in trig function calls
 #endif
 
   protected:
@@ -449,10 +426,7 @@ inline dms operator-(dms a, dms b)
 // Inline sincos
 inline void dms::SinCos(double &s, double &c) const
 {
-#ifdef PROFILE_SINCOS
-    std::clock_t start, stop;
-    start = std::clock();
-#endif
+    KSProfiler::count(KSProfiler::TrigCalls);
 
 #ifdef __GLIBC__
 #if (__GLIBC__ >= 2 && __GLIBC_MINOR__ >= 1 && !defined(__UCLIBC__))
@@ -469,11 +443,6 @@ inline void dms::SinCos(double &s, double &c) const
     c = ::cos(radians());
 #endif
 
-#ifdef PROFILE_SINCOS
-    stop = std::clock();
-    seconds_in_trig += double(stop - start) / double(CLOCKS_PER_SEC);
-#endif
-
 #ifdef COUNT_DMS_SINCOS_CALLS
     if (!m_sinCosCalled)
     {
@@ -0,0 +1,288 @@
+/***************************************************************************
+                          ksprofiler.cpp  -  K Desktop Planetarium
+                             -------------------
+    begin                : 2026
+    copyright            : (C) 2026 KStars Developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "ksprofiler.h"
+
+#include <QCoreApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QThread>
+#include <QTimer>
+
+#include <algorithm>
+
+namespace KSProfiler
+{
+std::atomic<bool> s_Enabled { false };
+
+/**
+ * Counters of one thread. Only the owning thread writes them, the registry
+ * reads them while aggregating.
+ */
+struct ThreadCounters
+{
+    ThreadCounters()
+    {
+        for (int i = 0; i < MaxCounters; ++i)
+        {
+            calls[i].store(0, std::memory_order_relaxed);
+            nsecs[i].store(0, std::memory_order_relaxed);
+        }
+        Registry::Instance()->attach(this);
+    }
+
+    ~ThreadCounters()
+    {
+        Registry::Instance()->detach(this);
+    }
+
+    std::atomic<quint64> calls[MaxCounters];
+    std::atomic<quint64> nsecs[MaxCounters];
+};
+
+namespace
+{
+const char *builtinNames[BuiltinCounters] =
+{
+    "dms/trig", "CachingDms/computed", "CachingDms/cacheHits", "SkyPoint/EquatorialToHorizontal",
+    "StarObject/updateCoords"
+};
+
+ThreadCounters &threadCounters()
+{
+    thread_local ThreadCounters counters;
+    return counters;
+}
+}
+
+void add(int counter, quint64 calls, qint64 nsecs)
+{
+    if (counter < 0 || counter >= MaxCounters)
+        return;
+
+    ThreadCounters &t = threadCounters();
+
+    // No other thread writes to this block, so there is no need for a read-modify-write
+    t.calls[counter].store(t.calls[counter].load(std::memory_order_relaxed) + calls, std::memory_order_relaxed);
+    if (nsecs > 0)
+        t.nsecs[counter].store(t.nsecs[counter].load(std::memory_order_relaxed) + nsecs, std::memory_order_relaxed);
+}
+
+int counter(const QString &name)
+{
+    return Registry::Instance()->registerCounter(name);
+}
+
+Registry *Registry::Instance()
+{
+    // Never deleted, threads may still detach from it while the application exits
+    static Registry *instance = new Registry();
+    return instance;
+}
+
+Registry::Registry()
+{
+    // Counters may be registered from a worker thread first
+    if (QCoreApplication::instance() != nullptr)
+        moveToThread(QCoreApplication::instance()->thread());
+
+    for (const char *name : builtinNames)
+    {
+        m_Index.insert(QLatin1String(name), m_Names.size());
+        m_Names.append(QLatin1String(name));
+    }
+
+    m_Retired.resize(MaxCounters);
+    m_Baseline.resize(MaxCounters);
+    m_Previous.resize(MaxCounters);
+    m_Period.start();
+}
+
+void Registry::setEnabled(bool enable)
+{
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    if (m_Timer == nullptr)
+    {
+        m_Timer = new QTimer(this);
+        m_Timer->setInterval(AggregationPeriod);
+        connect(m_Timer, &QTimer::timeout, this, &Registry::aggregate);
+    }
+
+    if (enable == isEnabled())
+        return;
+
+    if (enable)
+    {
+        {
+            QMutexLocker locker(&m_Mutex);
+            m_Previous = totals();
+        }
+        m_Period.restart();
+        s_Enabled.store(true);
+        m_Timer->start();
+    }
+    else
+    {
+        s_Enabled.store(false);
+        m_Timer->stop();
+        aggregate();
+    }
+}
+
+void Registry::reset()
+{
+    QMutexLocker locker(&m_Mutex);
+
+    m_Baseline = totals();
+    for (auto &s : m_Statistics)
+    {
+        s.calls   = 0;
+        s.seconds = 0;
+    }
+}
+
+QVector<Statistic> Registry::statistics() const
+{
+    QMutexLocker locker(&m_Mutex);
+    return m_Statistics;
+}
+
+QString Registry::toJson() const
+{
+    QJsonArray counters;
+
+    for (const auto &s : statistics())
+    {
+        QJsonObject counter;
+        counter.insert("name", s.name);
+        counter.insert("calls", static_cast<double>(s.calls));
+        counter.insert("seconds", s.seconds);
+        counter.insert("callsPerSecond", s.callsPerSecond);
+        counter.insert("load", s.load);
+        counters.append(counter);
+    }
+
+    return QString::fromUtf8(QJsonDocument(counters).toJson(QJsonDocument::Compact));
+}
+
+QStringList Registry::report(int lines) const
+{
+    QVector<Statistic> stats = statistics();
+
+    stats.erase(std::remove_if(stats.begin(), stats.end(), [](const Statistic & s)
+    {
+        return s.callsPerSecond <= 0;
+    }), stats.end());
+
+    // Timed counters first, busiest first
+    std::sort(stats.begin(), stats.end(), [](const Statistic & a, const Statistic & b)
+    {
+        if (a.load != b.load)
+            return a.load > b.load;
+        return a.callsPerSecond > b.callsPerSecond;
+    });
+
+    QStringList text;
+    for (int i = 0; i < stats.size() && i < lines; ++i)
+    {
+        const Statistic &s = stats[i];
+        QString line = QString("%1 %2/s").arg(s.name, -32).arg(s.callsPerSecond, 10, 'f', 0);
+        if (s.load > 0)
+            line += QString(" %1 ms/s").arg(s.load * 1000, 7, 'f', 1);
+        text << line;
+    }
+
+    return text;
+}
+
+void Registry::aggregate()
+{
+    {
+        QMutexLocker locker(&m_Mutex);
+
+        const double period           = std::max<qint64>(m_Period.restart(), 1) / 1000.0;
+        const QVector<Totals> current = totals();
+
+        m_Statistics.clear();
+        for (int i = 0; i < m_Names.size(); ++i)
+        {
+            Statistic s;
+            s.name           = m_Names[i];
+            s.calls          = current[i].calls - m_Baseline[i].calls;
+            s.seconds        = (current[i].nsecs - m_Baseline[i].nsecs) / 1e9;
+            s.callsPerSecond = (current[i].calls - m_Previous[i].calls) / period;
+            s.load           = (current[i].nsecs - m_Previous[i].nsecs) / 1e9 / period;
+            m_Statistics.append(s);
+        }
+
+        m_Previous = current;
+    }
+
+    emit updated();
+}
+
+QVector<Registry::Totals> Registry::totals() const
+{
+    QVector<Totals> current = m_Retired;
+
+    for (const ThreadCounters *t : m_Threads)
+    {
+        for (int i = 0; i < m_Names.size(); ++i)
+        {
+            current[i].calls += t->calls[i].load(std::memory_order_relaxed);
+            current[i].nsecs += t->nsecs[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    return current;
+}
+
+int Registry::registerCounter(const QString &name)
+{
+    QMutexLocker locker(&m_Mutex);
+
+    auto it = m_Index.constFind(name);
+    if (it != m_Index.constEnd())
+        return it.value();
+
+    if (m_Names.size() >= MaxCounters)
+        return -1;
+
+    m_Index.insert(name, m_Names.size());
+    m_Names.append(name);
+    return m_Names.size() - 1;
+}
+
+void Registry::attach(ThreadCounters *counters)
+{
+    QMutexLocker locker(&m_Mutex);
+    m_Threads.append(counters);
+}
+
+void Registry::detach(ThreadCounters *counters)
+{
+    QMutexLocker locker(&m_Mutex);
+
+    for (int i = 0; i < MaxCounters; ++i)
+    {
+        m_Retired[i].calls += counters->calls[i].load(std::memory_order_relaxed);
+        m_Retired[i].nsecs += counters->nsecs[i].load(std::memory_order_relaxed);
+    }
+    m_Threads.removeOne(counters);
+}
+}
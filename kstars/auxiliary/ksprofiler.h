@@ -0,0 +1,169 @@
+/***************************************************************************
+                          ksprofiler.h  -  K Desktop Planetarium
+                             -------------------
+    begin                : 2026
+    copyright            : (C) 2026 KStars Developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include "ksprofilercounters.h"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class QTimer;
+
+/**
+ * @namespace KSProfiler
+ * @short Counters and timers that can be switched on while KStars runs.
+ *
+ * This replaces the PROFILE_SINCOS, PROFILE_UPDATECOORDS and
+ * PROFILE_COORDINATE_CONVERSION build switches. When profiling is disabled,
+ * an instrumented call only costs a relaxed atomic load.
+ *
+ * Each thread accumulates into its own block of counters, so that hot paths
+ * never take a lock. The Registry sums the blocks of all threads once a
+ * second to compute call rates and load.
+ *
+ * Besides the built-in counters, named counters such as "draw/Stars" are
+ * registered on first use. Call sites keep the id of a named counter in a
+ * static, as registering takes the lock of the Registry.
+ */
+namespace KSProfiler
+{
+/**
+ * @return the counter with the given name, registered on first use, or -1
+ * if all MaxCounters counters are in use.
+ */
+int counter(const QString &name);
+
+/**
+ * @class ScopedTimer
+ * @short Count a call and the time spent until the end of the scope.
+ *
+ * Nothing is measured if profiling is disabled when the timer is created.
+ */
+class ScopedTimer
+{
+  public:
+    explicit ScopedTimer(int counter)
+    {
+        if (isEnabled())
+        {
+            m_Counter = counter;
+            m_Timer.start();
+        }
+    }
+
+    ~ScopedTimer()
+    {
+        if (m_Counter >= 0)
+            add(m_Counter, 1, m_Timer.nsecsElapsed());
+    }
+
+  private:
+    Q_DISABLE_COPY(ScopedTimer)
+
+    int m_Counter { -1 };
+    QElapsedTimer m_Timer;
+};
+
+/** Aggregated values of a counter. */
+struct Statistic
+{
+    QString name;
+    /// Calls since the last reset
+    quint64 calls { 0 };
+    /// Time spent since the last reset, in seconds. Zero for counters that are not timed.
+    double seconds { 0 };
+    /// Calls per second during the last aggregation period
+    double callsPerSecond { 0 };
+    /// Fraction of the last aggregation period spent in the counter
+    double load { 0 };
+};
+
+struct ThreadCounters;
+
+/**
+ * @class Registry
+ * @short Owns the counter names and aggregates the counters of all threads.
+ *
+ * The registry lives in the GUI thread.
+ */
+class Registry : public QObject
+{
+    Q_OBJECT
+
+  public:
+    static Registry *Instance();
+
+    /** @short Enable or disable profiling. Counters keep their values while disabled. */
+    void setEnabled(bool enable);
+
+    /** @short Restart all counters from zero. */
+    void reset();
+
+    /** @return the counters as of the last aggregation, in registration order */
+    QVector<Statistic> statistics() const;
+
+    /** @return the statistics as a JSON array */
+    QString toJson() const;
+
+    /** @return a short text report of the busiest counters, one per line */
+    QStringList report(int lines) const;
+
+    /** Interval between two aggregations, in milliseconds. */
+    static const int AggregationPeriod = 1000;
+
+  signals:
+    /** Emitted after each aggregation. */
+    void updated();
+
+  private:
+    Registry();
+
+    struct Totals
+    {
+        quint64 calls { 0 };
+        quint64 nsecs { 0 };
+    };
+
+    void aggregate();
+    /** @return the sum of the counters of all threads. Must be called with the mutex held. */
+    QVector<Totals> totals() const;
+
+    int registerCounter(const QString &name);
+    void attach(ThreadCounters *counters);
+    void detach(ThreadCounters *counters);
+
+    mutable QMutex m_Mutex;
+    QStringList m_Names;
+    QHash<QString, int> m_Index;
+    QVector<ThreadCounters *> m_Threads;
+    // Counters of the threads that have exited
+    QVector<Totals> m_Retired;
+    QVector<Totals> m_Baseline;
+    QVector<Totals> m_Previous;
+    QVector<Statistic> m_Statistics;
+    QElapsedTimer m_Period;
+    QTimer *m_Timer { nullptr };
+
+    friend int KSProfiler::counter(const QString &name);
+    friend struct ThreadCounters;
+};
+}
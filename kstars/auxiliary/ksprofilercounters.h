@@ -0,0 +1,66 @@
+/***************************************************************************
+                          ksprofilercounters.h  -  K Desktop Planetarium
+                             -------------------
+    begin                : 2026
+    copyright            : (C) 2026 KStars Developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QtGlobal>
+
+#include <atomic>
+
+/*
+ * The part of KSProfiler that instrumented hot paths need. dms.h includes
+ * this rather than ksprofiler.h, so that the Registry and its Qt
+ * dependencies stay out of nearly every translation unit.
+ */
+namespace KSProfiler
+{
+/** Counters that are always registered, in this order. */
+enum Counter
+{
+    TrigCalls,              ///< dms::sin(), dms::cos() and dms::SinCos()
+    CachingDmsComputed,     ///< sine and cosine pairs computed by CachingDms
+    CachingDmsCacheHits,    ///< sine or cosine read from the CachingDms cache
+    EquatorialToHorizontal, ///< SkyPoint::EquatorialToHorizontal()
+    StarUpdateCoords,       ///< StarObject::updateCoords()
+    BuiltinCounters
+};
+
+/** Maximum number of counters, built-in ones included. */
+const int MaxCounters = 256;
+
+extern std::atomic<bool> s_Enabled;
+
+/** @return true if profiling is enabled */
+inline bool isEnabled()
+{
+    return s_Enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * @short Add to a counter of the calling thread.
+ * @param counter built-in counter or value returned by counter()
+ * @param calls number of calls to add
+ * @param nsecs time spent in these calls, in nanoseconds
+ */
+void add(int counter, quint64 calls = 1, qint64 nsecs = 0);
+
+/** @short Count one call if profiling is enabled. */
+inline void count(int counter)
+{
+    if (isEnabled())
+        add(counter);
+}
+}
@@ -39,6 +39,15 @@
 
 KSUserDB::~KSUserDB()
 {
+    // Fold the write-ahead log back into the database file before it is copied
+    if (m_UserDB.isOpen())
+    {
+        QSqlQuery query(m_UserDB);
+        if (!query.exec("PRAGMA wal_checkpoint(TRUNCATE)"))
+            qCWarning(KSTARS) << query.lastError();
+    }
+
+    m_Statements.clear();
     m_UserDB.close();
 
     // Backup
@@ -50,6 +59,15 @@ KSUserDB::~KSUserDB()
 
 bool KSUserDB::Initialize()
 {
+    // Release a previous connection, its statements included
+    if (m_UserDB.isValid())
+    {
+        m_Statements.clear();
+        m_UserDB.close();
+        m_UserDB = QSqlDatabase();
+        QSqlDatabase::removeDatabase("userdb");
+    }
+
     // Every logged in user has their own db.
     m_UserDB = QSqlDatabase::addDatabase("QSQLITE", "userdb");
     QString dbfile = KSPaths::writableLocation(QStandardPaths::GenericDataLocation) + "userdb.sqlite";
@@ -62,7 +80,7 @@ bool KSUserDB::Initialize()
     }
     m_UserDB.setDatabaseName(dbfile);
     // If main files fail, write to backup.
-    if (!m_UserDB.open())
+    if (!OpenDatabase())
     {
         qCWarning(KSTARS) << "Unable to open user database file. Recovering from backup...";
         qCritical(KSTARS) << LastError();
@@ -82,7 +100,7 @@ bool KSUserDB::Initialize()
             QString backup_file = KSPaths::writableLocation(QStandardPaths::GenericDataLocation) + "userdb.sqlite.backup";
             QFile::remove(dbfile);
             QFile::copy(backup_file, dbfile);
-            if (!m_UserDB.open())
+            if (!OpenDatabase())
             {
                 qCritical(KSTARS) << LastError();
                 return false;
@@ -192,7 +210,8 @@ bool KSUserDB::Initialize()
                 qCWarning(KSTARS) << query.lastError();
         }
     }
-    m_UserDB.close();
+
+    // The connection stays open, so that prepared statements can be reused
     return true;
 }
 
@@ -202,6 +221,41 @@ QSqlError KSUserDB::LastError()
     return m_UserDB.lastError();
 }
 
+bool KSUserDB::OpenDatabase()
+{
+    if (m_UserDB.isOpen())
+        return true;
+
+    m_Statements.clear();
+    if (!m_UserDB.open())
+        return false;
+
+    // With a write-ahead log, readers do not block writers and commits do not rewrite the database file.
+    // A commit may then be lost on power failure, but the database stays consistent.
+    QSqlQuery query(m_UserDB);
+    if (!query.exec("PRAGMA journal_mode=WAL") || !query.exec("PRAGMA synchronous=NORMAL"))
+        qCWarning(KSTARS) << query.lastError();
+
+    return true;
+}
+
+QSqlQuery &KSUserDB::Statement(const QString &sql)
+{
+    auto it = m_Statements.find(sql);
+    if (it == m_Statements.end())
+    {
+        QSqlQuery query(m_UserDB);
+        query.setForwardOnly(true);
+        if (!query.prepare(sql))
+            qCWarning(KSTARS) << sql << query.lastError();
+        it = m_Statements.insert(sql, query);
+    }
+    else
+        it->finish();
+
+    return *it;
+}
+
 bool KSUserDB::FirstRun()
 {
     if (!RebuildDB())
@@ -397,6 +451,7 @@ bool KSUserDB::RebuildDB()
                   "Exec TEXT DEFAULT NULL, "
                   "Version TEXT DEFAULT 1.0)");
 
+    m_UserDB.transaction();
     for (int i = 0; i < tables.count(); ++i)
     {
         QSqlQuery query(m_UserDB);
@@ -406,6 +461,7 @@ bool KSUserDB::RebuildDB()
             qCDebug(KSTARS) << query.executedQuery();
         }
     }
+    m_UserDB.commit();
 
     return true;
 }
@@ -415,7 +471,7 @@ bool KSUserDB::RebuildDB()
 */
 void KSUserDB::AddObserver(const QString &name, const QString &surname, const QString &contact)
 {
-    m_UserDB.open();
+    OpenDatabase();
     QSqlTableModel users(nullptr, m_UserDB);
     users.setTable("user");
     users.setFilter("Name LIKE \'" + name + "\' AND Surname LIKE \'" + surname + "\'");
@@ -439,13 +495,11 @@ void KSUserDB::AddObserver(const QString &name, const QString &surname, const QS
         users.setData(users.index(row, 3), contact);
         users.submitAll();
     }
-
-    m_UserDB.close();
 }
 
 bool KSUserDB::FindObserver(const QString &name, const QString &surname)
 {
-    m_UserDB.open();
+    OpenDatabase();
     QSqlTableModel users(nullptr, m_UserDB);
     users.setTable("user");
     users.setFilter("Name LIKE \'" + name + "\' AND Surname LIKE \'" + surname + "\'");
@@ -454,14 +508,13 @@ bool KSUserDB::FindObserver(const QString &name, const QString &surname)
     int observer_count = users.rowCount();
 
     users.clear();
-    m_UserDB.close();
     return (observer_count > 0);
 }
 
 // TODO(spacetime): This method is currently unused.
 bool KSUserDB::DeleteObserver(const QString &id)
 {
-    m_UserDB.open();
+    OpenDatabase();
     QSqlTableModel users(nullptr, m_UserDB);
     users.setTable("user");
     users.setFilter("id = \'" + id + "\'");
@@ -473,18 +526,17 @@ bool KSUserDB::DeleteObserver(const QString &id)
     int observer_count = users.rowCount();
 
     users.clear();
-    m_UserDB.close();
     return (observer_count > 0);
 }
 QSqlDatabase KSUserDB::GetDatabase()
 {
-    m_UserDB.open();
+    OpenDatabase();
     return m_UserDB;
 }
 #ifndef KSTARS_LITE
 void KSUserDB::GetAllObservers(QList<Observer *> &observer_list)
 {
-    m_UserDB.open();
+    OpenDatabase();
     observer_list.clear();
     QSqlTableModel users(nullptr, m_UserDB);
     users.setTable("user");
@@ -502,7 +554,6 @@ void KSUserDB::GetAllObservers(QList<Observer *> &observer_list)
     }
 
     users.clear();
-    m_UserDB.close();
 }
 #endif
 
@@ -510,7 +561,7 @@ void KSUserDB::GetAllObservers(QList<Observer *> &observer_list)
 
 void KSUserDB::AddDarkFrame(const QVariantMap &oneFrame)
 {
-    m_UserDB.open();
+    OpenDatabase();
     QSqlTableModel darkframe(nullptr, m_UserDB);
     darkframe.setTable("darkframe");
     darkframe.select();
@@ -528,13 +579,11 @@ void KSUserDB::AddDarkFrame(const QVariantMap &oneFrame)
     darkframe.insertRecord(-1, record);
 
     darkframe.submitAll();
-
-    m_UserDB.close();
 }
 
 bool KSUserDB::DeleteDarkFrame(const QString &filename)
 {
-    m_UserDB.open();
+    OpenDatabase();
     QSqlTableModel darkframe(nullptr, m_UserDB);
     darkframe.setTable("darkframe");
     darkframe.setFilter("filename = \'" + filename + "\'");
@@ -544,8 +593,6 @@ bool KSUserDB::DeleteDarkFrame(const QString &filename)
     darkframe.removeRows(0, 1);
     darkframe.submitAll();
 
-    m_UserDB.close();
-
     return true;
 }
 
@@ -553,7 +600,7 @@ void KSUserDB::GetAllDarkFrames(QList<QVariantMap> &darkFrames)
 {
     darkFrames.clear();
 
-    m_UserDB.open();
+    OpenDatabase();
     QSqlTableModel darkframe(nullptr, m_UserDB);
     darkframe.setTable("darkframe");
     darkframe.select();
@@ -567,8 +614,6 @@ void KSUserDB::GetAllDarkFrames(QList<QVariantMap> &darkFrames)
 
         darkFrames.append(recordMap);
     }
-
-    m_UserDB.close();
 }
 
 
@@ -576,7 +621,7 @@ void KSUserDB::GetAllDarkFrames(QList<QVariantMap> &darkFrames)
 
 void KSUserDB::AddEffectiveFOV(const QVariantMap &oneFOV)
 {
-    m_UserDB.open();
+    OpenDatabase();
     QSqlTableModel effectivefov(nullptr, m_UserDB);
     effectivefov.setTable("effectivefov");
     effectivefov.select();
@@ -592,13 +637,11 @@ void KSUserDB::AddEffectiveFOV(const QVariantMap &oneFOV)
     effectivefov.insertRecord(-1, record);
 
     effectivefov.submitAll();
-
-    m_UserDB.close();
 }
 
 bool KSUserDB::DeleteEffectiveFOV(const QString &id)
 {
-    m_UserDB.open();
+    OpenDatabase();
     QSqlTableModel effectivefov(nullptr, m_UserDB);
     effectivefov.setTable("effectivefov");
     effectivefov.setFilter("id = \'" + id + "\'");
@@ -608,8 +651,6 @@ bool KSUserDB::DeleteEffectiveFOV(const QString &id)
     effectivefov.removeRows(0, 1);
     effectivefov.submitAll();
 
-    m_UserDB.close();
-
     return true;
 }
 
@@ -617,7 +658,7 @@ void KSUserDB::GetAllEffectiveFOVs(QList<QVariantMap> &effectiveFOVs)
 {
     effectiveFOVs.clear();
 
-    m_UserDB.open();
+    OpenDatabase();
     QSqlTableModel effectivefov(nullptr, m_UserDB);
     effectivefov.setTable("effectivefov");
     effectivefov.select();
@@ -631,15 +672,13 @@ void KSUserDB::GetAllEffectiveFOVs(QList<QVariantMap> &effectiveFOVs)
 
         effectiveFOVs.append(recordMap);
     }
-
-    m_UserDB.close();
 }
 
 /* Driver Alias Section */
 
 bool KSUserDB::AddCustomDriver(const QVariantMap &oneDriver)
 {
-    m_UserDB.open();
+    OpenDatabase();
     QSqlTableModel CustomDriver(nullptr, m_UserDB);
     CustomDriver.setTable("customdrivers");
     CustomDriver.select();
@@ -658,14 +697,12 @@ bool KSUserDB::AddCustomDriver(const QVariantMap &oneDriver)
 
     rc = CustomDriver.submitAll();
 
-    m_UserDB.close();
-
     return rc;
 }
 
 bool KSUserDB::DeleteCustomDriver(const QString &id)
 {
-    m_UserDB.open();
+    OpenDatabase();
     QSqlTableModel CustomDriver(nullptr, m_UserDB);
     CustomDriver.setTable("customdrivers");
     CustomDriver.setFilter("id = \'" + id + "\'");
@@ -675,8 +712,6 @@ bool KSUserDB::DeleteCustomDriver(const QString &id)
     CustomDriver.removeRows(0, 1);
     CustomDriver.submitAll();
 
-    m_UserDB.close();
-
     return true;
 }
 
@@ -684,7 +719,7 @@ void KSUserDB::GetAllCustomDrivers(QList<QVariantMap> &CustomDrivers)
 {
     CustomDrivers.clear();
 
-    m_UserDB.open();
+    OpenDatabase();
     QSqlTableModel CustomDriver(nullptr, m_UserDB);
     CustomDriver.setTable("customdrivers");
     CustomDriver.select();
@@ -698,15 +733,13 @@ void KSUserDB::GetAllCustomDrivers(QList<QVariantMap> &CustomDrivers)
 
         CustomDrivers.append(recordMap);
     }
-
-    m_UserDB.close();
 }
 
 /* HiPS Section */
 
 void KSUserDB::AddHIPSSource(const QMap<QString, QString> &oneSource)
 {
-    m_UserDB.open();
+    OpenDatabase();
     QSqlTableModel HIPSSource(nullptr, m_UserDB);
     HIPSSource.setTable("hips");
     HIPSSource.select();
@@ -719,13 +752,11 @@ void KSUserDB::AddHIPSSource(const QMap<QString, QString> &oneSource)
     HIPSSource.insertRecord(-1, record);
 
     HIPSSource.submitAll();
-
-    m_UserDB.close();
 }
 
 bool KSUserDB::DeleteHIPSSource(const QString &ID)
 {
-    m_UserDB.open();
+    OpenDatabase();
     QSqlTableModel HIPSSource(nullptr, m_UserDB);
     HIPSSource.setTable("hips");
     HIPSSource.setFilter("ID = \'" + ID + "\'");
@@ -735,8 +766,6 @@ bool KSUserDB::DeleteHIPSSource(const QString &ID)
     HIPSSource.removeRows(0, 1);
     HIPSSource.submitAll();
 
-    m_UserDB.close();
-
     return true;
 }
 
@@ -744,7 +773,7 @@ void KSUserDB::GetAllHIPSSources(QList<QMap<QString, QString>> &HIPSSources)
 {
     HIPSSources.clear();
 
-    m_UserDB.open();
+    OpenDatabase();
     QSqlTableModel HIPSSource(nullptr, m_UserDB);
     HIPSSource.setTable("hips");
     HIPSSource.select();
@@ -758,8 +787,6 @@ void KSUserDB::GetAllHIPSSources(QList<QMap<QString, QString>> &HIPSSources)
 
         HIPSSources.append(recordMap);
     }
-
-    m_UserDB.close();
 }
 
 
@@ -767,51 +794,48 @@ void KSUserDB::GetAllHIPSSources(QList<QMap<QString, QString>> &HIPSSources)
 
 void KSUserDB::AddDSLRInfo(const QMap<QString, QVariant> &oneInfo)
 {
-    m_UserDB.open();
-    QSqlTableModel DSLRInfo(nullptr, m_UserDB);
-    DSLRInfo.setTable("dslr");
-    DSLRInfo.select();
+    OpenDatabase();
 
-    QSqlRecord record = DSLRInfo.record();
+    // Keys are column names, e.g. Model, Width, Height, PixelW and PixelH
+    QStringList placeholders;
+    for (int i = 0; i < oneInfo.size(); ++i)
+        placeholders << "?";
 
-    for (QMap<QString, QVariant>::const_iterator iter = oneInfo.begin(); iter != oneInfo.end(); ++iter)
-        record.setValue(iter.key(), iter.value());
-
-    DSLRInfo.insertRecord(-1, record);
-
-    DSLRInfo.submitAll();
+    QSqlQuery &query = Statement(QString("INSERT INTO dslr (%1) VALUES (%2)")
+                                 .arg(QStringList(oneInfo.keys()).join(", "), placeholders.join(", ")));
+    for (const QVariant &value : oneInfo)
+        query.addBindValue(value);
 
-    m_UserDB.close();
+    if (!query.exec())
+        qCWarning(KSTARS) << query.lastQuery() << query.lastError().text();
 }
 
 bool KSUserDB::DeleteAllDSLRInfo()
 {
-    m_UserDB.open();
-    QSqlTableModel DSLRInfo(nullptr, m_UserDB);
-    DSLRInfo.setTable("dslr");
-    DSLRInfo.select();
+    OpenDatabase();
 
-    DSLRInfo.removeRows(0, DSLRInfo.rowCount());
-    DSLRInfo.submitAll();
-
-    m_UserDB.close();
+    QSqlQuery &query = Statement("DELETE FROM dslr");
+    if (!query.exec())
+    {
+        qCWarning(KSTARS) << query.lastQuery() << query.lastError().text();
+        return false;
+    }
 
     return true;
 }
 
 bool KSUserDB::DeleteDSLRInfo(const QString &model)
 {
-    m_UserDB.open();
-    QSqlTableModel DSLRInfo(nullptr, m_UserDB);
-    DSLRInfo.setTable("dslr");
-    DSLRInfo.setFilter("model = \'" + model + "\'");
-
-    DSLRInfo.select();
-
-    DSLRInfo.removeRows(0, 1);
-    DSLRInfo.submitAll();
+    OpenDatabase();
 
-    m_UserDB.close();
+    // Only the first entry of the model, as before
+    QSqlQuery &query = Statement("DELETE FROM dslr WHERE id = (SELECT id FROM dslr WHERE Model = ? LIMIT 1)");
+    query.addBindValue(model);
+    if (!query.exec())
+    {
+        qCWarning(KSTARS) << query.lastQuery() << query.lastError().text();
+        return false;
+    }
 
     return true;
 }
@@ -820,22 +844,22 @@ void KSUserDB::GetAllDSLRInfos(QList<QMap<QString, QVariant>> &DSLRInfos)
 {
     DSLRInfos.clear();
 
-    m_UserDB.open();
-    QSqlTableModel DSLRInfo(nullptr, m_UserDB);
-    DSLRInfo.setTable("dslr");
-    DSLRInfo.select();
+    OpenDatabase();
+
+    QSqlQuery &query = Statement("SELECT * FROM dslr");
+    if (!query.exec())
+        qCWarning(KSTARS) << query.lastQuery() << query.lastError().text();
 
-    for (int i = 0; i < DSLRInfo.rowCount(); ++i)
+    while (query.next())
     {
         QMap<QString, QVariant> recordMap;
-        QSqlRecord record = DSLRInfo.record(i);
+        QSqlRecord record = query.record();
         for (int j = 1; j < record.count(); j++)
             recordMap[record.fieldName(j)] = record.value(j);
 
         DSLRInfos.append(recordMap);
     }
-
-    m_UserDB.close();
+    query.finish();
 }
 
 /*
@@ -844,71 +868,64 @@ void KSUserDB::GetAllDSLRInfos(QList<QMap<QString, QVariant>> &DSLRInfos)
 
 void KSUserDB::DeleteAllFlags()
 {
-    m_UserDB.open();
-    QSqlTableModel flags(nullptr, m_UserDB);
-    flags.setEditStrategy(QSqlTableModel::OnManualSubmit);
-    flags.setTable("flags");
-    flags.select();
+    OpenDatabase();
 
-    flags.removeRows(0, flags.rowCount());
-    flags.submitAll();
-
-    flags.clear();
-    m_UserDB.close();
+    QSqlQuery &query = Statement("DELETE FROM flags");
+    if (!query.exec())
+        qCWarning(KSTARS) << query.lastQuery() << query.lastError().text();
 }
 
 void KSUserDB::AddFlag(const QString &ra, const QString &dec, const QString &epoch, const QString &image_name,
                        const QString &label, const QString &labelColor)
 {
-    m_UserDB.open();
-    QSqlTableModel flags(nullptr, m_UserDB);
-    flags.setTable("flags");
+    AddFlags(QList<QStringList>() << (QStringList() << ra << dec << epoch << image_name << label << labelColor));
+}
 
-    int row = 0;
-    flags.insertRows(row, 1);
-    flags.setData(flags.index(row, 1), ra); // row,0 is autoincerement ID
-    flags.setData(flags.index(row, 2), dec);
-    flags.setData(flags.index(row, 3), image_name);
-    flags.setData(flags.index(row, 4), label);
-    flags.setData(flags.index(row, 5), labelColor);
-    flags.setData(flags.index(row, 6), epoch);
-    flags.submitAll();
-
-    flags.clear();
-    m_UserDB.close();
+void KSUserDB::AddFlags(const QList<QStringList> &flags)
+{
+    OpenDatabase();
+
+    // One transaction, so that the flags are written to disk once
+    m_UserDB.transaction();
+
+    QSqlQuery &query = Statement("INSERT INTO flags (RA, Dec, Epoch, Icon, Label, Color) VALUES (?, ?, ?, ?, ?, ?)");
+    for (const QStringList &flag : flags)
+    {
+        if (flag.size() < 6)
+        {
+            qCWarning(KSTARS) << "Incomplete flag" << flag;
+            continue;
+        }
+
+        for (int i = 0; i < 6; ++i)
+            query.bindValue(i, flag.at(i));
+        if (!query.exec())
+            qCWarning(KSTARS) << query.lastQuery() << query.lastError().text();
+    }
+
+    m_UserDB.commit();
 }
 
 QList<QStringList> KSUserDB::GetAllFlags()
 {
     QList<QStringList> flagList;
 
-    m_UserDB.open();
-    QSqlTableModel flags(nullptr, m_UserDB);
-    flags.setTable("flags");
-    flags.select();
+    OpenDatabase();
+
+    // Columns in the order of the flag entries, which differs from the order of the table
+    QSqlQuery &query = Statement("SELECT RA, Dec, Epoch, Icon, Label, Color FROM flags ORDER BY id");
+    if (!query.exec())
+        qCWarning(KSTARS) << query.lastQuery() << query.lastError().text();
 
-    for (int i = 0; i < flags.rowCount(); ++i)
+    while (query.next())
     {
         QStringList flagEntry;
-        QSqlRecord record = flags.record(i);
-        /* flagEntry order description
-         * The variation in the order is due to variation
-         * in flag entry description order and flag database
-         * description order.
-         * flag (database): ra, dec, icon, label, color, epoch
-         * flag (object):  ra, dec, epoch, icon, label, color
-        */
-        flagEntry.append(record.value(1).toString());
-        flagEntry.append(record.value(2).toString());
-        flagEntry.append(record.value(6).toString());
-        flagEntry.append(record.value(3).toString());
-        flagEntry.append(record.value(4).toString());
-        flagEntry.append(record.value(5).toString());
+        for (int i = 0; i < 6; ++i)
+            flagEntry.append(query.value(i).toString());
         flagList.append(flagEntry);
     }
+    query.finish();
 
-    flags.clear();
-    m_UserDB.close();
     return flagList;
 }
 
@@ -917,7 +934,7 @@ QList<QStringList> KSUserDB::GetAllFlags()
  */
 void KSUserDB::DeleteEquipment(const QString &type, const int &id)
 {
-    m_UserDB.open();
+    OpenDatabase();
     QSqlTableModel equip(nullptr, m_UserDB);
     equip.setTable(type);
     equip.setFilter("id = " + QString::number(id));
@@ -927,12 +944,11 @@ void KSUserDB::DeleteEquipment(const QString &type, const int &id)
     equip.submitAll();
 
     equip.clear();
-    m_UserDB.close();
 }
 
 void KSUserDB::DeleteAllEquipment(const QString &type)
 {
-    m_UserDB.open();
+    OpenDatabase();
     QSqlTableModel equip(nullptr, m_UserDB);
     equip.setEditStrategy(QSqlTableModel::OnManualSubmit);
     equip.setTable(type);
@@ -942,7 +958,6 @@ void KSUserDB::DeleteAllEquipment(const QString &type)
     equip.submitAll();
 
     equip.clear();
-    m_UserDB.close();
 }
 
 /*
@@ -951,7 +966,7 @@ void KSUserDB::DeleteAllEquipment(const QString &type)
 void KSUserDB::AddScope(const QString &model, const QString &vendor, const QString &driver, const QString &type,
                         const double &focalLength, const double &aperture)
 {
-    m_UserDB.open();
+    OpenDatabase();
     QSqlTableModel equip(nullptr, m_UserDB);
     equip.setTable("telescope");
 
@@ -966,13 +981,12 @@ void KSUserDB::AddScope(const QString &model, const QString &vendor, const QStri
     equip.submitAll();
 
     equip.clear(); //DB will not close if linked object not cleared
-    m_UserDB.close();
 }
 
 void KSUserDB::AddScope(const QString &model, const QString &vendor, const QString &driver, const QString &type,
                         const double &focalLength, const double &aperture, const QString &id)
 {
-    m_UserDB.open();
+    OpenDatabase();
     QSqlTableModel equip(nullptr, m_UserDB);
     equip.setTable("telescope");
     equip.setFilter("id = " + id);
@@ -990,15 +1004,13 @@ void KSUserDB::AddScope(const QString &model, const QString &vendor, const QStri
         equip.setRecord(0, record);
         equip.submitAll();
     }
-
-    m_UserDB.close();
 }
 #ifndef KSTARS_LITE
 void KSUserDB::GetAllScopes(QList<Scope *> &scope_list)
 {
     scope_list.clear();
 
-    m_UserDB.open();
+    OpenDatabase();
     QSqlTableModel equip(nullptr, m_UserDB);
     equip.setTable("telescope");
     equip.select();
@@ -1019,7 +1031,6 @@ void KSUserDB::GetAllScopes(QList<Scope *> &scope_list)
     }
 
     equip.clear();
-    m_UserDB.close();
 }
 #endif
 /*
@@ -1028,7 +1039,7 @@ void KSUserDB::GetAllScopes(QList<Scope *> &scope_list)
 void KSUserDB::AddEyepiece(const QString &vendor, const QString &model, const double &focalLength, const double &fov,
                            const QString &fovunit)
 {
-    m_UserDB.open();
+    OpenDatabase();
     QSqlTableModel equip(nullptr, m_UserDB);
     equip.setTable("eyepiece");
 
@@ -1042,13 +1053,12 @@ void KSUserDB::AddEyepiece(const QString &vendor, const QString &model, const do
     equip.submitAll();
 
     equip.clear();
-    m_UserDB.close();
 }
 
 void KSUserDB::AddEyepiece(const QString &vendor, const QString &model, const double &focalLength, const double &fov,
                            const QString &fovunit, const QString &id)
 {
-    m_UserDB.open();
+    OpenDatabase();
     QSqlTableModel equip(nullptr, m_UserDB);
     equip.setTable("eyepiece");
     equip.setFilter("id = " + id);
@@ -1065,15 +1075,13 @@ void KSUserDB::AddEyepiece(const QString &vendor, const QString &model, const do
         equip.setRecord(0, record);
         equip.submitAll();
     }
-
-    m_UserDB.close();
 }
 #ifndef KSTARS_LITE
 void KSUserDB::GetAllEyepieces(QList<OAL::Eyepiece *> &eyepiece_list)
 {
     eyepiece_list.clear();
 
-    m_UserDB.open();
+    OpenDatabase();
     QSqlTableModel equip(nullptr, m_UserDB);
     equip.setTable("eyepiece");
     equip.select();
@@ -1093,7 +1101,6 @@ void KSUserDB::GetAllEyepieces(QList<OAL::Eyepiece *> &eyepiece_list)
     }
 
     equip.clear();
-    m_UserDB.close();
 }
 #endif
 /*
@@ -1101,7 +1108,7 @@ void KSUserDB::GetAllEyepieces(QList<OAL::Eyepiece *> &eyepiece_list)
  */
 void KSUserDB::AddLens(const QString &vendor, const QString &model, const double &factor)
 {
-    m_UserDB.open();
+    OpenDatabase();
     QSqlTableModel equip(nullptr, m_UserDB);
     equip.setTable("lens");
 
@@ -1113,12 +1120,11 @@ void KSUserDB::AddLens(const QString &vendor, const QString &model, const double
     equip.submitAll();
 
     equip.clear();
-    m_UserDB.close();
 }
 
 void KSUserDB::AddLens(const QString &vendor, const QString &model, const double &factor, const QString &id)
 {
-    m_UserDB.open();
+    OpenDatabase();
     QSqlTableModel equip(nullptr, m_UserDB);
     equip.setTable("lens");
     equip.setFilter("id = " + id);
@@ -1132,15 +1138,13 @@ void KSUserDB::AddLens(const QString &vendor, const QString &model, const double
         record.setValue(3, factor);
         equip.submitAll();
     }
-
-    m_UserDB.close();
 }
 #ifndef KSTARS_LITE
 void KSUserDB::GetAllLenses(QList<OAL::Lens *> &lens_list)
 {
     lens_list.clear();
 
-    m_UserDB.open();
+    OpenDatabase();
     QSqlTableModel equip(nullptr, m_UserDB);
     equip.setTable("lens");
     equip.select();
@@ -1157,7 +1161,6 @@ void KSUserDB::GetAllLenses(QList<OAL::Lens *> &lens_list)
     }
 
     equip.clear();
-    m_UserDB.close();
 }
 #endif
 /*
@@ -1166,7 +1169,7 @@ void KSUserDB::GetAllLenses(QList<OAL::Lens *> &lens_list)
 void KSUserDB::AddFilter(const QString &vendor, const QString &model, const QString &type, const QString &color,
                          int offset, double exposure, bool useAutoFocus, const QString &lockedFilter, int absFocusPos)
 {
-    m_UserDB.open();
+    OpenDatabase();
     QSqlTableModel equip(nullptr, m_UserDB);
     equip.setTable("filter");
 
@@ -1200,13 +1203,12 @@ void KSUserDB::AddFilter(const QString &vendor, const QString &model, const QStr
         qCritical() << "AddFilter:" << equip.lastError();
 
     equip.clear();
-    m_UserDB.close();
 }
 
 void KSUserDB::AddFilter(const QString &vendor, const QString &model, const QString &type, const QString &color,
                          int offset, double exposure, bool useAutoFocus, const QString &lockedFilter, int absFocusPos, const QString &id)
 {
-    m_UserDB.open();
+    OpenDatabase();
     QSqlTableModel equip(nullptr, m_UserDB);
     equip.setTable("filter");
     equip.setFilter("id = " + id);
@@ -1228,13 +1230,11 @@ void KSUserDB::AddFilter(const QString &vendor, const QString &model, const QStr
         if (equip.submitAll() == false)
             qCritical() << "AddFilter:" << equip.lastError();
     }
-
-    m_UserDB.close();
 }
 #ifndef KSTARS_LITE
 void KSUserDB::GetAllFilters(QList<OAL::Filter *> &filter_list)
 {
-    m_UserDB.open();
+    OpenDatabase();
     filter_list.clear();
     QSqlTableModel equip(nullptr, m_UserDB);
     equip.setTable("filter");
@@ -1259,7 +1259,6 @@ void KSUserDB::GetAllFilters(QList<OAL::Filter *> &filter_list)
     }
 
     equip.clear();
-    m_UserDB.close();
 }
 #endif
 #if 0
@@ -1669,22 +1668,20 @@ QList<ArtificialHorizonEntity *> KSUserDB::GetAllHorizons()
 {
     QList<ArtificialHorizonEntity *> horizonList;
 
-    m_UserDB.open();
-    QSqlTableModel regions(nullptr, m_UserDB);
-    regions.setTable("horizons");
-    regions.select();
+    OpenDatabase();
 
-    QSqlTableModel points(nullptr, m_UserDB);
+    QSqlQuery &regions = Statement("SELECT name, label, enabled FROM horizons ORDER BY id");
+    if (!regions.exec())
+        qCWarning(KSTARS) << regions.lastQuery() << regions.lastError().text();
 
-    for (int i = 0; i < regions.rowCount(); ++i)
-    {
-        QSqlRecord record   = regions.record(i);
-        QString regionTable = record.value("name").toString();
-        QString regionName  = record.value("label").toString();
-        bool enabled        = record.value("enabled").toInt() == 1 ? true : false;
+    QSqlQuery points(m_UserDB);
+    points.setForwardOnly(true);
 
-        points.setTable(regionTable);
-        points.select();
+    while (regions.next())
+    {
+        QString regionTable = regions.value(0).toString();
+        QString regionName  = regions.value(1).toString();
+        bool enabled        = regions.value(2).toInt() == 1 ? true : false;
 
         std::shared_ptr<LineList> skyList(new LineList());
 
@@ -1696,95 +1693,115 @@ QList<ArtificialHorizonEntity *> KSUserDB::GetAllHorizons()
 
         horizonList.append(horizon);
 
-        for (int j = 0; j < points.rowCount(); j++)
+        // Points are kept in insertion order, which is the order of the polygon
+        if (!points.exec(QString("SELECT Az, Alt FROM %1 ORDER BY rowid").arg(regionTable)))
+            qCWarning(KSTARS) << points.lastQuery() << points.lastError().text();
+
+        while (points.next())
         {
             std::shared_ptr<SkyPoint> p(new SkyPoint());
 
-            record = points.record(j);
-            p->setAz(record.value(0).toDouble());
-            p->setAlt(record.value(1).toDouble());
+            p->setAz(points.value(0).toDouble());
+            p->setAlt(points.value(1).toDouble());
             p->HorizontalToEquatorial(KStarsData::Instance()->lst(), KStarsData::Instance()->geo()->lat());
             skyList->append(std::move(p));
         }
-
-        points.clear();
     }
+    regions.finish();
 
-    regions.clear();
-    m_UserDB.close();
     return horizonList;
 }
 
 void KSUserDB::DeleteAllHorizons()
 {
-    m_UserDB.open();
-    QSqlTableModel regions(nullptr, m_UserDB);
-    regions.setEditStrategy(QSqlTableModel::OnManualSubmit);
-    regions.setTable("horizons");
-    regions.select();
+    OpenDatabase();
+
+    QSqlQuery &regions = Statement("SELECT name FROM horizons");
+    if (!regions.exec())
+        qCWarning(KSTARS) << regions.lastQuery() << regions.lastError().text();
+
+    QStringList tables;
+    while (regions.next())
+        tables << regions.value(0).toString();
+    // Tables cannot be dropped while a statement reads from the database
+    regions.finish();
+
+    m_UserDB.transaction();
 
     QSqlQuery query(m_UserDB);
 
-    for (int i = 0; i < regions.rowCount(); ++i)
+    for (const QString &table : tables)
     {
-        QSqlRecord record  = regions.record(i);
-        QString tableQuery = QString("DROP TABLE %1").arg(record.value("name").toString());
+        QString tableQuery = QString("DROP TABLE %1").arg(table);
         if (!query.exec(tableQuery))
             qCWarning(KSTARS) << query.lastError().text();
     }
 
-    regions.removeRows(0, regions.rowCount());
-    regions.submitAll();
+    if (!query.exec("DELETE FROM horizons"))
+        qCWarning(KSTARS) << query.lastError().text();
 
-    regions.clear();
-    m_UserDB.close();
+    m_UserDB.commit();
 }
 
 void KSUserDB::AddHorizon(ArtificialHorizonEntity *horizon)
 {
-    m_UserDB.open();
-    QSqlTableModel regions(nullptr, m_UserDB);
-    regions.setTable("horizons");
+    AddHorizons(QList<ArtificialHorizonEntity *>() << horizon);
+}
+
+void KSUserDB::AddHorizons(const QList<ArtificialHorizonEntity *> &horizons)
+{
+    OpenDatabase();
 
-    regions.select();
-    QString tableName = QString("horizon_%1").arg(regions.rowCount() + 1);
+    QSqlQuery &count = Statement("SELECT COUNT(*) FROM horizons");
+    int regionCount  = count.exec() && count.next() ? count.value(0).toInt() : 0;
+    count.finish();
 
-    regions.insertRow(0);
-    regions.setData(regions.index(0, 1), tableName);
-    regions.setData(regions.index(0, 2), horizon->region());
-    regions.setData(regions.index(0, 3), horizon->enabled() ? 1 : 0);
-    regions.submitAll();
-    regions.clear();
+    // One transaction for all regions, so that the points are written to disk once
+    m_UserDB.transaction();
 
-    QString tableQuery = QString("CREATE TABLE %1 (Az REAL NOT NULL, Alt REAL NOT NULL)").arg(tableName);
+    QSqlQuery &regions = Statement("INSERT INTO horizons (name, label, enabled) VALUES (?, ?, ?)");
     QSqlQuery query(m_UserDB);
-    query.exec(tableQuery);
 
-    QSqlTableModel points(nullptr, m_UserDB);
+    for (ArtificialHorizonEntity *horizon : horizons)
+    {
+        QString tableName = QString("horizon_%1").arg(++regionCount);
 
-    points.setTable(tableName);
+        regions.bindValue(0, tableName);
+        regions.bindValue(1, horizon->region());
+        regions.bindValue(2, horizon->enabled() ? 1 : 0);
+        if (!regions.exec())
+            qCWarning(KSTARS) << regions.lastQuery() << regions.lastError().text();
 
-    SkyList *skyList = horizon->list()->points();
+        QString tableQuery = QString("CREATE TABLE %1 (Az REAL NOT NULL, Alt REAL NOT NULL)").arg(tableName);
+        if (!query.exec(tableQuery))
+            qCWarning(KSTARS) << query.lastError().text();
 
-    for (const auto &item : *skyList)
-    {
-        points.select();
-        QSqlRecord rec(points.record());
+        SkyList *skyList = horizon->list()->points();
 
-        rec.setValue("Az", item->az().Degrees());
-        rec.setValue("Alt", item->alt().Degrees());
-        points.insertRecord(-1, rec);
-    }
+        QVariantList az, alt;
+        az.reserve(skyList->size());
+        alt.reserve(skyList->size());
+        for (const auto &item : *skyList)
+        {
+            az << item->az().Degrees();
+            alt << item->alt().Degrees();
+        }
 
-    points.submitAll();
-    points.clear();
+        // Prepared once per region, the point tables differ
+        query.prepare(QString("INSERT INTO %1 (Az, Alt) VALUES (?, ?)").arg(tableName));
+        query.addBindValue(az);
+        query.addBindValue(alt);
+        if (!query.execBatch())
+            qCWarning(KSTARS) << query.lastQuery() << query.lastError().text();
+        query.finish();
+    }
 
-    m_UserDB.close();
+    m_UserDB.commit();
 }
 
 int KSUserDB::AddProfile(const QString &name)
 {
-    m_UserDB.open();
+    OpenDatabase();
     int id = -1;
 
     QSqlQuery query(m_UserDB);
@@ -1795,14 +1812,12 @@ int KSUserDB::AddProfile(const QString &name)
     else
         id = query.lastInsertId().toInt();
 
-    m_UserDB.close();
-
     return id;
 }
 
 bool KSUserDB::DeleteProfile(ProfileInfo *pi)
 {
-    m_UserDB.open();
+    OpenDatabase();
 
     QSqlQuery query(m_UserDB);
     bool rc;
@@ -1812,17 +1827,19 @@ bool KSUserDB::DeleteProfile(ProfileInfo *pi)
     if (rc == false)
         qCWarning(KSTARS) << query.lastQuery() << query.lastError().text();
 
-    m_UserDB.close();
-
     return rc;
 }
 
 void KSUserDB::SaveProfile(ProfileInfo *pi)
 {
+    OpenDatabase();
+
+    // All the updates are written at once
+    m_UserDB.transaction();
+
     // Remove all drivers
     DeleteProfileDrivers(pi);
 
-    m_UserDB.open();
     QSqlQuery query(m_UserDB);
 
     // Clear data
@@ -1894,27 +1911,27 @@ void KSUserDB::SaveProfile(ProfileInfo *pi)
     if (!query.exec(QString("UPDATE profile SET remotedrivers='%1' WHERE id=%2").arg(pi->remotedrivers).arg(pi->id)))
         qCWarning(KSTARS) << query.executedQuery() << query.lastError().text();
 
+    QSqlQuery &driver = Statement("INSERT INTO driver (label, role, profile) VALUES (?, ?, ?)");
     QMapIterator<QString, QString> i(pi->drivers);
     while (i.hasNext())
     {
         i.next();
-        if (!query.exec(QString("INSERT INTO driver (label, role, profile) VALUES('%1','%2',%3)")
-                        .arg(i.value(), i.key())
-                        .arg(pi->id)))
-        {
-            qCWarning(KSTARS) << query.executedQuery() << query.lastError().text();
-        }
+        driver.bindValue(0, i.value());
+        driver.bindValue(1, i.key());
+        driver.bindValue(2, pi->id);
+        if (!driver.exec())
+            qCWarning(KSTARS) << driver.lastQuery() << driver.lastError().text();
     }
 
     /*if (pi->customDrivers.isEmpty() == false && !query.exec(QString("INSERT INTO custom_driver (drivers, profile) VALUES('%1',%2)").arg(pi->customDrivers).arg(pi->id)))
         qDebug()  << query.lastQuery() << query.lastError().text();*/
 
-    m_UserDB.close();
+    m_UserDB.commit();
 }
 
 void KSUserDB::GetAllProfiles(QList<std::shared_ptr<ProfileInfo>> &profiles)
 {
-    m_UserDB.open();
+    OpenDatabase();
     QSqlTableModel profile(nullptr, m_UserDB);
     profile.setTable("profile");
     profile.select();
@@ -1960,30 +1977,26 @@ void KSUserDB::GetAllProfiles(QList<std::shared_ptr<ProfileInfo>> &profiles)
     }
 
     profile.clear();
-    m_UserDB.close();
 }
 
 void KSUserDB::GetProfileDrivers(ProfileInfo *pi)
 {
-    m_UserDB.open();
+    OpenDatabase();
 
-    QSqlTableModel driver(nullptr, m_UserDB);
-    driver.setTable("driver");
-    driver.setFilter("profile=" + QString::number(pi->id));
-    if (driver.select() == false)
+    // Run once per profile
+    QSqlQuery &driver = Statement("SELECT label, role FROM driver WHERE profile = ?");
+    driver.addBindValue(pi->id);
+    if (driver.exec() == false)
         qCWarning(KSTARS) << "Driver select error:" << driver.lastError().text();
 
-    for (int i = 0; i < driver.rowCount(); ++i)
+    while (driver.next())
     {
-        QSqlRecord record = driver.record(i);
-        QString label     = record.value("label").toString();
-        QString role      = record.value("role").toString();
+        QString label = driver.value(0).toString();
+        QString role  = driver.value(1).toString();
 
         pi->drivers[role] = label;
     }
-
-    driver.clear();
-    m_UserDB.close();
+    driver.finish();
 }
 
 /*void KSUserDB::GetProfileCustomDrivers(ProfileInfo* pi)
@@ -2004,7 +2017,7 @@ void KSUserDB::GetProfileDrivers(ProfileInfo *pi)
 
 void KSUserDB::DeleteProfileDrivers(ProfileInfo *pi)
 {
-    m_UserDB.open();
+    OpenDatabase();
 
     QSqlQuery query(m_UserDB);
 
@@ -2013,6 +2026,4 @@ void KSUserDB::DeleteProfileDrivers(ProfileInfo *pi)
 
     if (!query.exec("DELETE FROM driver WHERE profile=" + QString::number(pi->id)))
         qCWarning(KSTARS) << query.executedQuery() << query.lastError().text();
-
-    m_UserDB.close();
 }
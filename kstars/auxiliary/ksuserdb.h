@@ -24,8 +24,10 @@
 #include "skyobjects/skyobject.h"
 
 #include <QFile>
+#include <QHash>
 #include <QSqlDatabase>
 #include <QSqlError>
+#include <QSqlQuery>
 #include <QStringList>
 #include <QVariantMap>
 #include <QXmlStreamReader>
@@ -40,6 +42,10 @@ class ArtificialHorizonEntity;
  *
  * usage: Call QSqlDatabase::removeDatabase("userdb"); after the object
  * of this class is deallocated
+ *
+ * The connection stays open from Initialize() until the object is destroyed,
+ * and the database is kept in write-ahead log mode. Frequent statements are
+ * prepared once, and bulk writes are made in a single transaction.
  * @author Rishab Arora
  * @author Jasem Mutlaq
  * @version 1.2
@@ -154,6 +160,11 @@ class KSUserDB
         // Jasem: Add API doc
         void DeleteAllHorizons();
         void AddHorizon(ArtificialHorizonEntity *horizon);
+        /**
+         * @brief Add the given horizon regions, in a single transaction
+         * @param horizons regions to add, in order
+         */
+        void AddHorizons(const QList<ArtificialHorizonEntity *> &horizons);
         QList<ArtificialHorizonEntity *> GetAllHorizons();
 
         /************************************************************************
@@ -180,6 +191,13 @@ class KSUserDB
          **/
         void AddFlag(const QString &ra, const QString &dec, const QString &epoch, const QString &image_name,
                      const QString &label, const QString &labelColor);
+        /**
+         * @brief Add the given flags, in a single transaction
+         *
+         * @param flags flag entries, each in the order returned by GetAllFlags()
+         * @return void
+         **/
+        void AddFlags(const QList<QStringList> &flags);
         /**
          * @brief Returns a QList populated with all stored flags
          * Order: const QString &ra, const QString &dec, const QString &epoch,
@@ -374,8 +392,25 @@ class KSUserDB
          **/
         inline QSqlError LastError();
 
+        /**
+         * @brief Open the user database, unless it is already open
+         *
+         * @return false if the database cannot be opened
+         **/
+        bool OpenDatabase();
+
+        /**
+         * @brief Return the prepared statement of sql, prepared on first use
+         * The statement is reset, and must be finished by the caller once read.
+         *
+         * @return QSqlQuery
+         **/
+        QSqlQuery &Statement(const QString &sql);
+
         /** Linked to the user database _once_. **/
         QSqlDatabase m_UserDB;
+        /** Prepared statements of the open connection, by SQL **/
+        QHash<QString, QSqlQuery> m_Statements;
         /** XML reader for importing old formats **/
         QXmlStreamReader *reader_ { nullptr };
 
@@ -0,0 +1,314 @@
+/***************************************************************************
+                      renderserver.cpp  -  K Desktop Planetarium
+                             -------------------
+    begin                : 2026
+    copyright            : (C) 2026 KStars Developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "renderserver.h"
+
+#include "kstars_debug.h"
+#include "kstarsdata.h"
+#include "kstarsdatetime.h"
+#include "ksutils.h"
+#include "Options.h"
+#include "simclock.h"
+#include "skymap.h"
+#include "projections/projector.h"
+
+#include <QCryptographicHash>
+#include <QFile>
+#include <QImage>
+#include <QJsonDocument>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QMetaEnum>
+
+#include <algorithm>
+
+namespace
+{
+const int DefaultWidth  = 1024;
+const int DefaultHeight = 768;
+const int MaxSize       = 16384;
+}
+
+RenderServer::RenderServer(KStarsData *data, SkyMap *map, QObject *parent) : QObject(parent), m_Data(data), m_Map(map)
+{
+    m_Uptime.start();
+}
+
+bool RenderServer::listen(const QString &name)
+{
+    m_Server = new QLocalServer(this);
+    connect(m_Server, &QLocalServer::newConnection, this, &RenderServer::newConnection);
+
+    // A server that crashed may have left its socket behind
+    QLocalServer::removeServer(name);
+    if (!m_Server->listen(name))
+    {
+        qCCritical(KSTARS) << "Render server cannot listen on" << name << ":" << m_Server->errorString();
+        return false;
+    }
+
+    qCInfo(KSTARS) << "Render server listening on" << m_Server->fullServerName();
+    return true;
+}
+
+void RenderServer::serve(QIODevice *in, QIODevice *out)
+{
+    bool quit = false;
+    QMetaObject::Connection connection = connect(this, &RenderServer::quitRequested, [&quit]()
+    {
+        quit = true;
+    });
+
+    while (!quit)
+    {
+        // Blocks until a full line or the end of the input
+        const QByteArray line = in->readLine();
+        if (line.isEmpty())
+            break;
+        if (line.trimmed().isEmpty())
+            continue;
+
+        out->write(processLine(line));
+        if (QFile *file = qobject_cast<QFile *>(out))
+            file->flush();
+    }
+
+    disconnect(connection);
+}
+
+void RenderServer::newConnection()
+{
+    while (QLocalSocket *client = m_Server->nextPendingConnection())
+    {
+        connect(client, &QLocalSocket::readyRead, this, &RenderServer::readRequests);
+        connect(client, &QLocalSocket::disconnected, client, &QLocalSocket::deleteLater);
+    }
+}
+
+void RenderServer::readRequests()
+{
+    QLocalSocket *client = qobject_cast<QLocalSocket *>(sender());
+    if (client == nullptr)
+        return;
+
+    while (client->canReadLine())
+    {
+        const QByteArray line = client->readLine();
+        if (line.trimmed().isEmpty())
+            continue;
+
+        client->write(processLine(line));
+        client->flush();
+    }
+}
+
+QByteArray RenderServer::processLine(const QByteArray &line)
+{
+    QJsonParseError parseError;
+    const QJsonDocument request = QJsonDocument::fromJson(line, &parseError);
+
+    QJsonObject reply;
+    if (!request.isObject())
+    {
+        m_Errors++;
+        reply.insert("status", "error");
+        reply.insert("error", QString("Invalid request: %1").arg(parseError.errorString()));
+    }
+    else
+        reply = process(request.object());
+
+    return QJsonDocument(reply).toJson(QJsonDocument::Compact) + '\n';
+}
+
+QJsonObject RenderServer::process(const QJsonObject &request)
+{
+    QJsonObject reply;
+    const QString command = request.value("command").toString("render");
+
+    if (command == "stats")
+        reply = statistics();
+    else if (command == "quit")
+        emit quitRequested();
+    else if (command != "render")
+    {
+        m_Errors++;
+        reply.insert("status", "error");
+        reply.insert("error", QString("Unknown command: %1").arg(command));
+    }
+    else
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        QImage image;
+        QString error;
+        if (!render(request, image, error))
+        {
+            m_Errors++;
+            reply.insert("status", "error");
+            reply.insert("error", error);
+        }
+        else
+        {
+            const double renderMs = timer.nsecsElapsed() / 1e6;
+
+            const QString output = request.value("output").toString();
+            if (!output.isEmpty() && !image.save(output))
+            {
+                m_Errors++;
+                reply.insert("status", "error");
+                reply.insert("error", QString("Cannot save %1").arg(output));
+            }
+
+            const double totalMs = timer.nsecsElapsed() / 1e6;
+
+            m_Jobs++;
+            m_TotalMs += totalMs;
+            m_MaxMs = std::max(m_MaxMs, totalMs);
+
+            reply.insert("output", output);
+            reply.insert("width", image.width());
+            reply.insert("height", image.height());
+            reply.insert("checksum", checksum(image));
+            reply.insert("renderMs", renderMs);
+            reply.insert("saveMs", totalMs - renderMs);
+            reply.insert("totalMs", totalMs);
+
+            qCDebug(KSTARS) << "Render server job" << m_Jobs << output << "rendered in" << renderMs << "ms, saved in"
+                            << totalMs - renderMs << "ms";
+        }
+    }
+
+    if (!reply.contains("status"))
+        reply.insert("status", "ok");
+    if (request.contains("id"))
+        reply.insert("id", request.value("id"));
+
+    return reply;
+}
+
+bool RenderServer::render(const QJsonObject &job, QImage &image, QString &error)
+{
+    const int width  = job.value("width").toInt(DefaultWidth);
+    const int height = job.value("height").toInt(DefaultHeight);
+    if (width < 1 || height < 1 || width > MaxSize || height > MaxSize)
+    {
+        error = QString("Invalid image size %1x%2").arg(width).arg(height);
+        return false;
+    }
+
+    const double ra  = job.value("ra").toDouble(Options::focusRA());
+    const double dec = job.value("dec").toDouble(Options::focusDec());
+    if (ra < 0 || ra >= 24 || dec < -90 || dec > 90)
+    {
+        error = QString("Invalid center RA %1h, Dec %2").arg(ra).arg(dec);
+        return false;
+    }
+
+    double zoom = Options::zoomFactor();
+    if (job.contains("fov"))
+    {
+        const double fov = job.value("fov").toDouble();
+        if (fov <= 0 || fov > 360)
+        {
+            error = QString("Invalid field of view %1").arg(fov);
+            return false;
+        }
+        zoom = KSUtils::clamp(width / (fov * dms::DegToRad), MINZOOM, MAXZOOM);
+    }
+
+    int projection = Options::projection();
+    if (job.contains("projection"))
+    {
+        bool ok = false;
+        const QByteArray name = job.value("projection").toString().toLatin1();
+        projection            = QMetaEnum::fromType<Projector::Projection>().keyToValue(name.constData(), &ok);
+        if (!ok || projection == Projector::UnknownProjection)
+        {
+            error = QString("Unknown projection %1").arg(QString::fromLatin1(name));
+            return false;
+        }
+    }
+
+    KStarsDateTime ut = KStarsDateTime::currentDateTimeUtc();
+    if (job.contains("time"))
+    {
+        QDateTime time = QDateTime::fromString(job.value("time").toString(), Qt::ISODate);
+        if (!time.isValid())
+        {
+            error = QString("Invalid time %1").arg(job.value("time").toString());
+            return false;
+        }
+        // Times without an offset are UTC
+        if (time.timeSpec() == Qt::LocalTime)
+            time.setTimeSpec(Qt::UTC);
+        ut = KStarsDateTime(time.toUTC());
+    }
+
+    // The sky components read the zoom from the options, so they hold the job's view while
+    // rendering. The user's values are put back before anything could save the configuration.
+    const double userZoom      = Options::zoomFactor();
+    const auto userProjection  = Options::projection();
+    Options::setZoomFactor(zoom);
+    Options::setProjection(projection);
+
+    m_Data->clock()->setUTC(ut);
+    m_Data->setFullTimeUpdate();
+    m_Data->updateTime(m_Data->geo(), true);
+
+    m_Map->resize(width, height);
+    m_Map->setDestination(SkyPoint(ra, dec));
+    m_Map->destination()->EquatorialToHorizontal(m_Data->lst(), m_Data->geo()->lat());
+    m_Map->setFocus(m_Map->destination());
+    m_Map->focus()->EquatorialToHorizontal(m_Data->lst(), m_Data->geo()->lat());
+    m_Map->setupProjector();
+
+    image = QImage(width, height, QImage::Format_ARGB32_Premultiplied);
+    m_Map->exportSkyImage(&image);
+
+    Options::setZoomFactor(userZoom);
+    Options::setProjection(userProjection);
+    m_Map->setupProjector();
+
+    return true;
+}
+
+QString RenderServer::checksum(const QImage &image)
+{
+    QCryptographicHash hash(QCryptographicHash::Md5);
+
+    // Scan lines may be padded, only hash the pixels
+    const int lineBytes = image.width() * image.depth() / 8;
+    for (int y = 0; y < image.height(); y++)
+        hash.addData(reinterpret_cast<const char *>(image.constScanLine(y)), lineBytes);
+
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+QJsonObject RenderServer::statistics() const
+{
+    QJsonObject stats;
+
+    stats.insert("jobs", static_cast<double>(m_Jobs));
+    stats.insert("errors", static_cast<double>(m_Errors));
+    stats.insert("meanMs", m_Jobs > 0 ? m_TotalMs / m_Jobs : 0.0);
+    stats.insert("maxMs", m_MaxMs);
+    // Throughput while rendering, idle time excluded
+    stats.insert("jobsPerSecond", m_TotalMs > 0 ? m_Jobs * 1000.0 / m_TotalMs : 0.0);
+    stats.insert("uptimeSeconds", m_Uptime.elapsed() / 1000.0);
+
+    return stats;
+}
@@ -0,0 +1,115 @@
+/***************************************************************************
+                      renderserver.h  -  K Desktop Planetarium
+                             -------------------
+    begin                : 2026
+    copyright            : (C) 2026 KStars Developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QObject>
+
+class QImage;
+class QIODevice;
+class QLocalServer;
+class KStarsData;
+class SkyMap;
+
+/**
+ * @class RenderServer
+ * @short Renders sky images on request, without the KStars main window.
+ *
+ * This is the persistent counterpart of the --dump command line option. The
+ * data and catalogs are loaded once, and each request then only costs the
+ * rendering of one image through SkyMap::exportSkyImage().
+ *
+ * Requests are JSON objects, one per line, read from stdin or from the
+ * clients of a local socket. Each request gets a JSON reply on one line.
+ * A render job has the following keys, all optional but "output":
+ * - "id": returned as is in the reply
+ * - "ra", "dec": center of the image, in hours and degrees
+ * - "fov": field of view across the width of the image, in degrees
+ * - "projection": name of the projection, e.g. "Stereographic"
+ * - "width", "height": size of the image in pixels
+ * - "time": UTC date and time in ISO 8601 format, the current time by default
+ * - "output": image file, its format is chosen from the extension. Without
+ *   it the image is only rendered, which is useful to measure throughput.
+ *
+ * The reply holds the MD5 checksum of the pixels and the time spent setting up,
+ * rendering and saving. The {"command": "stats"} request returns the job count,
+ * latencies and throughput since the server started, and {"command": "quit"}
+ * stops the server.
+ *
+ * Jobs without "fov" or "projection" use the zoom and projection of the user's
+ * configuration, which the jobs never change.
+ *
+ * @author KStars Developers
+ */
+class RenderServer : public QObject
+{
+        Q_OBJECT
+
+    public:
+        RenderServer(KStarsData *data, SkyMap *map, QObject *parent = nullptr);
+        ~RenderServer() override = default;
+
+        /**
+         * @short Accept requests from the clients of a local socket.
+         * Requests are served from the event loop.
+         * @return false if the socket could not be created
+         */
+        bool listen(const QString &name);
+
+        /**
+         * @short Serve the requests read from in, until the end of in or a quit request.
+         * Replies are written to out.
+         */
+        void serve(QIODevice *in, QIODevice *out);
+
+        /** @short Process a request and return its reply. */
+        QJsonObject process(const QJsonObject &request);
+
+        /**
+         * @short Render the image described by a job.
+         * @return false and set error if the job is invalid.
+         */
+        bool render(const QJsonObject &job, QImage &image, QString &error);
+
+        /** @return the MD5 checksum of the pixels of image, in hexadecimal */
+        static QString checksum(const QImage &image);
+
+        /** @return the job count, latencies and throughput since the server started */
+        QJsonObject statistics() const;
+
+    signals:
+        /** A client requested the server to stop */
+        void quitRequested();
+
+    private slots:
+        void newConnection();
+        void readRequests();
+
+    private:
+        QByteArray processLine(const QByteArray &line);
+
+        KStarsData *m_Data { nullptr };
+        SkyMap *m_Map { nullptr };
+        QLocalServer *m_Server { nullptr };
+
+        QElapsedTimer m_Uptime;
+        quint64 m_Jobs { 0 };
+        quint64 m_Errors { 0 };
+        double m_TotalMs { 0 };
+        double m_MaxMs { 0 };
+};
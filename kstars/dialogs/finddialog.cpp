@@ -25,6 +25,7 @@
 #include "skymap.h"
 #include "skyobjects/skyobject.h"
 #include "skyobjects/deepskyobject.h"
+#include "skycomponents/nameindex.h"
 #include "skycomponents/starcomponent.h"
 #include "skycomponents/syncedcatalogcomponent.h"
 #include "skycomponents/skymapcomposite.h"
@@ -227,74 +228,56 @@ void FindDialog::initSelection()
     listFiltered = true;
 }
 
-void FindDialog::filterByType()
+QVector<int> FindDialog::filterTypes() const
 {
-    KStarsData *data = KStarsData::Instance();
-
     switch (ui->FilterType->currentIndex())
     {
-        case 0: // All object types
-        {
-            QVector<QPair<QString, const SkyObject *>> allObjects;
-            foreach (int type, data->skyComposite()->objectLists().keys())
-            {
-                allObjects.append(data->skyComposite()->objectLists(SkyObject::TYPE(type)));
-            }
-            fModel->setSkyObjectsList(allObjects);
-            break;
-        }
         case 1: //Stars
-        {
-            QVector<QPair<QString, const SkyObject *>> starObjects;
-            starObjects.append(data->skyComposite()->objectLists(SkyObject::STAR));
-            starObjects.append(data->skyComposite()->objectLists(SkyObject::CATALOG_STAR));
-            fModel->setSkyObjectsList(starObjects);
-            break;
-        }
+            return { SkyObject::STAR, SkyObject::CATALOG_STAR };
         case 2: //Solar system
-        {
-            QVector<QPair<QString, const SkyObject *>> ssObjects;
-            ssObjects.append(data->skyComposite()->objectLists(SkyObject::PLANET));
-            ssObjects.append(data->skyComposite()->objectLists(SkyObject::COMET));
-            ssObjects.append(data->skyComposite()->objectLists(SkyObject::ASTEROID));
-            ssObjects.append(data->skyComposite()->objectLists(SkyObject::MOON));
-
-            fModel->setSkyObjectsList(ssObjects);
-            break;
-        }
+            return { SkyObject::PLANET, SkyObject::COMET, SkyObject::ASTEROID, SkyObject::MOON };
         case 3: //Open Clusters
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::OPEN_CLUSTER));
-            break;
+            return { SkyObject::OPEN_CLUSTER };
         case 4: //Globular Clusters
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::GLOBULAR_CLUSTER));
-            break;
+            return { SkyObject::GLOBULAR_CLUSTER };
         case 5: //Gaseous nebulae
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::GASEOUS_NEBULA));
-            break;
+            return { SkyObject::GASEOUS_NEBULA };
         case 6: //Planetary nebula
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::PLANETARY_NEBULA));
-            break;
+            return { SkyObject::PLANETARY_NEBULA };
         case 7: //Galaxies
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::GALAXY));
-            break;
+            return { SkyObject::GALAXY };
         case 8: //Comets
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::COMET));
-            break;
+            return { SkyObject::COMET };
         case 9: //Asteroids
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::ASTEROID));
-            break;
+            return { SkyObject::ASTEROID };
         case 10: //Constellations
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::CONSTELLATION));
-            break;
+            return { SkyObject::CONSTELLATION };
         case 11: //Supernovae
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::SUPERNOVA));
-            break;
+            return { SkyObject::SUPERNOVA };
         case 12: //Satellites
-            fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::SATELLITE));
-            break;
+            return { SkyObject::SATELLITE };
+        default: // All object types
+            return QVector<int>();
     }
 }
 
+void FindDialog::filterByType()
+{
+    NameIndex &index = KStarsData::Instance()->skyComposite()->nameIndex();
+
+    // Index the names of the lists modified since the last search
+    index.update();
+
+    // The model only needs to be filled again when the type or the names changed, not on each keystroke
+    if (ui->FilterType->currentIndex() == m_FilteredType && index.generation() == m_FilteredGeneration)
+        return;
+
+    fModel->setSkyObjectsList(index.entries(filterTypes()));
+
+    m_FilteredType       = ui->FilterType->currentIndex();
+    m_FilteredGeneration = index.generation();
+}
+
 void FindDialog::filterList()
 {
     QString SearchText = processSearchText();
@@ -306,12 +289,13 @@ void FindDialog::filterList()
     //Select the first item in the list that begins with the filter string
     if (!SearchText.isEmpty())
     {
-        QStringList mItems = fModel->filter(QRegExp('^' + SearchText, Qt::CaseInsensitive));
-        mItems.sort();
+        const NameIndex &index = KStarsData::Instance()->skyComposite()->nameIndex();
+        const QVector<int> types = filterTypes();
+        const QVector<NameIndex::Entry> mItems = index.withPrefix(SearchText, types, 1);
 
         if (mItems.size())
         {
-            QModelIndex qmi        = fModel->index(fModel->indexOf(mItems[0]));
+            QModelIndex qmi        = fModel->index(fModel->indexOf(mItems[0].first));
             QModelIndex selectItem = sortModel->mapFromSource(qmi);
 
             if (selectItem.isValid())
@@ -323,8 +307,8 @@ void FindDialog::filterList()
                 okB->setEnabled(true);
             }
         }
-        ui->InternetSearchButton->setEnabled(!mItems.contains(
-                SearchText)); // Disable searching the internet when an exact match for SearchText exists in KStars
+        ui->InternetSearchButton->setEnabled(index.find(SearchText, types) ==
+                                             nullptr); // Disable searching the internet when an exact match for SearchText exists in KStars
     }
     else
         ui->InternetSearchButton->setEnabled(false);
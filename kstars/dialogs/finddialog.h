@@ -21,6 +21,7 @@
 
 #include <QDialog>
 #include <QKeyEvent>
+#include <QVector>
 
 class QTimer;
 class QComboBox;
@@ -134,11 +135,16 @@ class FindDialog : public QDialog
     /** @short pre-filter the list of objects according to the selected object type. */
     void filterByType();
 
+    /** @return the object types selected by the type filter, or none if all types are */
+    QVector<int> filterTypes() const;
+
     FindDialogUI *ui { nullptr };
     SkyObjectListModel *fModel { nullptr };
     QSortFilterProxyModel *sortModel { nullptr };
     QTimer *timer { nullptr };
     bool listFiltered { false };
+    int m_FilteredType { -1 };
+    quint64 m_FilteredGeneration { 0 };
     QPushButton *okB { nullptr };
     SkyObject *m_targetObject { nullptr };
 
@@ -45,6 +45,8 @@
 #include <basedevice.h>
 #include <indicom.h>
 
+#include <QtConcurrent>
+
 #include <memory>
 
 #include <ekos_align_debug.h>
@@ -223,6 +225,8 @@ Align::Align(ProfileInfo *activeProfile) : m_ActiveProfile(activeProfile)
     m_AlignTimer.setInterval(Options::astrometryTimeout() * 1000);
     connect(&m_AlignTimer, &QTimer::timeout, this, &Ekos::Align::checkAlignmentTimeout);
 
+    connect(&m_SolveCacheWatcher, &QFutureWatcher<SolveCacheLookup>::finished, this, &Ekos::Align::processSolveCacheLookup);
+
     currentGotoMode = static_cast<GotoMode>(Options::solverGotoOption());
     gotoModeButtonGroup->button(currentGotoMode)->setChecked(true);
 
@@ -527,6 +531,9 @@ Align::~Align()
     dir.setFilter(QDir::Files);
     for (auto &dirFile : dir.entryList())
         dir.remove(dirFile);
+
+    // The solve cache lookup uses the cache of this module
+    m_SolveCacheWatcher.waitForFinished();
 }
 void Align::selectSolutionTableRow(int row, int column)
 {
@@ -2357,6 +2364,81 @@ void Align::calculateEffectiveFocalLength(double newFOVW)
     }
 }
 
+bool Align::solveFromCache()
+{
+    m_SolveCacheStars.clear();
+    m_SolveCacheParity = 0;
+    m_SolveCacheHit = false;
+
+    // Load & Slew images may come from another setup, and remote solves are done server-side.
+    QSharedPointer<FITSData> data = alignView->getSharedImageData();
+    if (!Options::astrometryUseSolveCache() || data.isNull() || solverModeButtonGroup->checkedId() != SOLVER_LOCAL ||
+            loadSlewState != IPS_IDLE || fov_pixscale <= 0)
+        return false;
+
+    // A lookup of an aborted solve may still be using the image
+    m_SolveCacheWatcher.waitForFinished();
+
+    solverTimer.start();
+
+    // Use the solver settings from the align tab for star detection.
+    QVariantMap settings;
+    settings["optionsProfileIndex"] = Options::solveOptionsProfile();
+    settings["optionsProfileGroup"] = static_cast<int>(Ekos::AlignProfiles);
+    data->setSourceExtractorSettings(settings);
+    const QFuture<bool> extraction = data->findStars(ALGORITHM_SEP);
+
+    SolveCache::Hint hint;
+    hint.ra = telescopeCoord.ra().Degrees();
+    hint.dec = telescopeCoord.dec().Degrees();
+    hint.radius = Options::astrometrySolveCacheRadius();
+    hint.pixscale = fov_pixscale;
+    if (sOrientation != INVALID_VALUE)
+        hint.orientation = sOrientation;
+
+    m_SolveCacheWatcher.setFuture(QtConcurrent::run([this, data, extraction, hint]()
+    {
+        SolveCacheLookup lookup;
+
+        QFuture<bool> stars = extraction;
+        stars.waitForFinished();
+        for (const Edge *star : data->getStarCenters())
+            lookup.stars.append(SolveCache::Star(star->x, star->y, star->sum));
+
+        QMutexLocker locker(&m_SolveCacheMutex);
+        lookup.hit = m_SolveCache.lookup(lookup.stars, data->width(), data->height(), hint, &lookup.solution);
+        return lookup;
+    }));
+
+    return true;
+}
+
+void Align::processSolveCacheLookup()
+{
+    // The solve was aborted meanwhile
+    if (m_SolveCacheWatcher.isCanceled())
+        return;
+
+    const SolveCacheLookup lookup = m_SolveCacheWatcher.result();
+    m_SolveCacheStars = lookup.stars;
+
+    if (!lookup.hit)
+    {
+        qCDebug(KSTARS_EKOS_ALIGN) << "Solve cache missed after" << solverTimer.elapsed() << "ms with"
+                                   << m_SolveCacheStars.size() << "stars.";
+        startSolver();
+        return;
+    }
+
+    m_SolveCacheHit = true;
+    appendLogText(i18n("Image matched a recent solution, skipping the solver."));
+
+    state = ALIGN_PROGRESS;
+    emit newStatus(state);
+
+    solverFinished(lookup.solution.orientation, lookup.solution.ra, lookup.solution.dec, lookup.solution.pixscale);
+}
+
 void Align::calculateFOV()
 {
     // Calculate FOV
@@ -3298,11 +3380,21 @@ void Align::startSolving()
     else if (m_PAHStage == PAH_THIRD_CAPTURE)
         PAHWidgets->setCurrentWidget(PAHThirdSolverPage);
 
+    disconnect(alignView, &FITSView::loaded, this, &Align::startSolving);
+
+    // The solver starts once the cache missed
+    if (solveFromCache())
+        return;
+
+    startSolver();
+}
+
+void Align::startSolver()
+{
     // This is needed because they might have directories stored in the config file.
     // So we can't just use the options folder list.
     QStringList astrometryDataDirs = KSUtils::getAstrometryDataDirs();
     FITSData *data = alignView->getImageData();
-    disconnect(alignView, &FITSView::loaded, this, &Align::startSolving);
 
     if (solverModeButtonGroup->checkedId() == SOLVER_LOCAL)
     {
@@ -3490,6 +3582,12 @@ void Align::solverComplete()
     else
     {
         FITSImage::Solution solution = m_StellarSolver->getSolution();
+        // Negative parity is the sky as seen, with east on the left when north is up, on images
+        // stored top row first.
+        if (solution.parity == "neg")
+            m_SolveCacheParity = 1;
+        else if (solution.parity == "pos")
+            m_SolveCacheParity = -1;
         solverFinished(solution.orientation, solution.ra, solution.dec, solution.pixscale);
     }
 }
@@ -3508,6 +3606,29 @@ void Align::solverFinished(double orientation, double ra, double dec, double pix
     double elapsed = solverTimer.elapsed() / 1000.0;
     appendLogText(i18n("Solver completed after %1 seconds.", QString::number(elapsed, 'f', 2)));
 
+    // Keep the solutions of the solver, with the stars detected on their image, for the next solves
+    QMutexLocker solveCacheLocker(&m_SolveCacheMutex);
+    m_SolveCache.recordSolve(m_SolveCacheHit, solverTimer.elapsed());
+    if (!m_SolveCacheHit && !m_SolveCacheStars.isEmpty() && m_SolveCacheParity != 0)
+    {
+        FITSData *data = alignView->getImageData();
+        if (data != nullptr)
+            m_SolveCache.insert(SolveCache::Solution(ra, dec, orientation, pixscale, data->width(), data->height(),
+                                m_SolveCacheParity), m_SolveCacheStars);
+    }
+    m_SolveCacheStars.clear();
+    m_SolveCacheParity = 0;
+    m_SolveCacheHit = false;
+    if (Options::alignmentLogging())
+    {
+        const SolveCache::Statistics &statistics = m_SolveCache.statistics();
+        appendLogText(i18n("Solve cache: %1 hits in %2 lookups, %3 ms from the cache, %4 ms from the solver on average.",
+                           statistics.hits, statistics.lookups,
+                           QString::number(statistics.averageCachedMilliseconds(), 'f', 0),
+                           QString::number(statistics.averageSolverMilliseconds(), 'f', 0)));
+    }
+    solveCacheLocker.unlock();
+
     // Reset Telescope Type to remembered value
     if (rememberTelescopeType != ISD::CCD::TELESCOPE_UNKNOWN)
     {
@@ -3839,6 +3960,7 @@ void Align::solverFinished(double orientation, double ra, double dec, double pix
 
 void Align::solverFailed()
 {
+    m_SolveCacheStars.clear();
     appendLogText(i18n("Solver Failed."));
     if(!Options::alignmentLogging())
         appendLogText(
@@ -3880,6 +4002,7 @@ void Align::solverFailed()
 void Align::abort()
 {
     m_CaptureTimer.stop();
+    m_SolveCacheWatcher.cancel();
     if (solverModeButtonGroup->checkedId() == SOLVER_LOCAL && m_StellarSolver)
         m_StellarSolver->abort();
     else if (solverModeButtonGroup->checkedId() == SOLVER_REMOTE && remoteParser)
@@ -3961,6 +4084,18 @@ QList<double> Align::getSolutionResult()
     return result;
 }
 
+QList<double> Align::getSolveCacheStatistics()
+{
+    QMutexLocker locker(&m_SolveCacheMutex);
+    const SolveCache::Statistics &statistics = m_SolveCache.statistics();
+    QList<double> result;
+
+    result << statistics.lookups << statistics.hits << statistics.hitRate()
+           << statistics.averageCachedMilliseconds() << statistics.averageSolverMilliseconds();
+
+    return result;
+}
+
 void Align::appendLogText(const QString &text)
 {
     m_LogText.insert(0, i18nc("log entry; %1 is the date, %2 is the text", "%1 %2",
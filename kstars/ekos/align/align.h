@@ -22,10 +22,13 @@
 #include "ekos/auxiliary/filtermanager.h"
 #include "ekos/guide/internalguide/starcorrespondence.h"
 #include "polaralign.h"
+#include "solvecache.h"
 
 #include <QTime>
 #include <QTimer>
 #include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <QMutex>
 #include <KConfigDialog>
 
 #if QT_VERSION >= QT_VERSION_CHECK(5, 8, 0)
@@ -193,6 +196,13 @@ class Align : public QWidget, public Ui::Align
              */
         Q_SCRIPTABLE QList<double> getSolutionResult();
 
+        /** DBUS interface function.
+             * Returns the statistics of the plate solving cache
+             * @return Returns array of doubles. Number of lookups, number of hits, hit rate, then average duration
+             * in milliseconds of the solves from the cache and from the solver.
+             */
+        Q_SCRIPTABLE QList<double> getSolveCacheStatistics();
+
         /** DBUS interface function.
              * Returns the solver's current status
              * @return Returns solver status (Ekos::AlignState)
@@ -671,6 +681,23 @@ class Align : public QWidget, public Ui::Align
             */
         void calculateFOV();
 
+        /**
+            * @brief Look the image up in the plate solving cache, in the background, for a recent solution near the
+            * mount position that matches it.
+            * @return true if the lookup was started, in which case processSolveCacheLookup() carries on with solving.
+            */
+        bool solveFromCache();
+
+        /**
+            * @brief Finish the solve with the cached solution if the lookup matched, or start the solver otherwise.
+            */
+        void processSolveCacheLookup();
+
+        /**
+            * @brief Solve the image in the align view with the selected local or remote solver.
+            */
+        void startSolver();
+
         /**
          * @brief calculateEffectiveFocalLength Calculate Focal Length purely form astrometric data.
          */
@@ -858,6 +885,22 @@ class Align : public QWidget, public Ui::Align
         std::unique_ptr<StellarSolver> m_StellarSolver;
         QList<SSolver::Parameters> m_StellarSolverProfiles;
 
+        // Plate solving cache, the stars detected on the image being solved, and the parity reported
+        // by the solver for it, or 0 if unknown
+        SolveCache m_SolveCache;
+        QVector<SolveCache::Star> m_SolveCacheStars;
+        int m_SolveCacheParity { 0 };
+        bool m_SolveCacheHit { false };
+        // The stars are extracted and looked up on a worker thread, which holds the mutex while using the cache
+        struct SolveCacheLookup
+        {
+            bool hit { false };
+            QVector<SolveCache::Star> stars;
+            SolveCache::Solution solution;
+        };
+        QFutureWatcher<SolveCacheLookup> m_SolveCacheWatcher;
+        QMutex m_SolveCacheMutex;
+
         /// Have we slewed?
         bool m_wasSlewStarted { false };
         // Above flag only stays false for 10s after slew start.
@@ -0,0 +1,448 @@
+/*  Ekos plate solving cache
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include "solvecache.h"
+
+#include <QSet>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace Ekos
+{
+
+namespace
+{
+constexpr double DegToRad = M_PI / 180.0;
+constexpr double RadToDeg = 180.0 / M_PI;
+
+// Stars of each frame used to build the candidate transforms
+constexpr int PatternStars = 15;
+// Shortest separation of a pair of pattern stars, in pixels
+constexpr double MinSeparation = 10;
+// Tolerance on the pixel scale of the new frame
+constexpr double ScaleTolerance = 0.1;
+// Largest distance between a transformed star and its match, in pixels, before and after refining
+constexpr double MatchTolerance = 3;
+constexpr double RefineTolerance = 2;
+// Most cached solutions tried per lookup, nearest first
+constexpr int MaxCandidates = 8;
+
+using Complex = std::complex<double>;
+
+double normalizeRA(double ra)
+{
+    ra = std::fmod(ra, 360.0);
+    return ra < 0 ? ra + 360 : ra;
+}
+
+// Angular distance between two positions, in degrees
+double distance(double ra1, double dec1, double ra2, double dec2)
+{
+    const double sdec = std::sin((dec2 - dec1) * DegToRad / 2);
+    const double sra = std::sin((ra2 - ra1) * DegToRad / 2);
+    const double h = sdec * sdec + std::cos(dec1 * DegToRad) * std::cos(dec2 * DegToRad) * sra * sra;
+    return 2 * std::asin(std::min(1.0, std::sqrt(h))) * RadToDeg;
+}
+
+// Position angle of the second position from the first one, in degrees east of north, in (-180, 180]
+double positionAngle(double ra1, double dec1, double ra2, double dec2)
+{
+    const double dra = (ra2 - ra1) * DegToRad;
+    const double d1 = dec1 * DegToRad, d2 = dec2 * DegToRad;
+    double angle = std::atan2(std::sin(dra) * std::cos(d2),
+                              std::cos(d1) * std::sin(d2) - std::sin(d1) * std::cos(d2) * std::cos(dra)) * RadToDeg;
+    return angle <= -180 ? angle + 360 : angle;
+}
+
+Complex position(const SolveCache::Star &star)
+{
+    return Complex(star.x, star.y);
+}
+
+// Index of the star nearest to z within tolerance, or -1
+int nearest(const QVector<SolveCache::Star> &stars, const Complex &z, double tolerance)
+{
+    int found = -1;
+    double best = tolerance * tolerance;
+    for (int i = 0; i < stars.size(); ++i)
+    {
+        const double d = std::norm(position(stars[i]) - z);
+        if (d <= best)
+        {
+            best = d;
+            found = i;
+        }
+    }
+    return found;
+}
+
+QVector<SolveCache::Star> brightest(const QVector<SolveCache::Star> &stars)
+{
+    QVector<SolveCache::Star> sorted = stars;
+    std::sort(sorted.begin(), sorted.end(), [](const SolveCache::Star & a, const SolveCache::Star & b)
+    {
+        return a.flux > b.flux;
+    });
+    if (sorted.size() > SolveCache::MaxStars)
+        sorted.resize(SolveCache::MaxStars);
+    return sorted;
+}
+}
+
+void SolveCache::Solution::pixelToSky(double x, double y, double *ra_, double *dec_) const
+{
+    const double s = pixscale / 3600.0 * DegToRad;
+    const double dx = parity * (x - width / 2.0), dy = y - height / 2.0;
+    const double theta = orientation * DegToRad;
+
+    // Standard coordinates, north and east of the center
+    const double eta = s * (-dy * std::cos(theta) + dx * std::sin(theta));
+    const double xi = s * (-dy * std::sin(theta) - dx * std::cos(theta));
+
+    const double d0 = dec * DegToRad;
+    const double D = std::cos(d0) - eta * std::sin(d0);
+    *ra_ = normalizeRA(ra + std::atan2(xi, D) * RadToDeg);
+    *dec_ = std::atan2(std::sin(d0) + eta * std::cos(d0), std::sqrt(xi * xi + D * D)) * RadToDeg;
+}
+
+bool SolveCache::Solution::skyToPixel(double ra_, double dec_, double *x, double *y) const
+{
+    const double d0 = dec * DegToRad, d = dec_ * DegToRad;
+    const double dra = (ra_ - ra) * DegToRad;
+    const double cosc = std::sin(d0) * std::sin(d) + std::cos(d0) * std::cos(d) * std::cos(dra);
+    if (cosc <= 0)
+        return false;
+
+    const double xi = std::cos(d) * std::sin(dra) / cosc;
+    const double eta = (std::cos(d0) * std::sin(d) - std::sin(d0) * std::cos(d) * std::cos(dra)) / cosc;
+
+    const double s = pixscale / 3600.0 * DegToRad;
+    const double theta = orientation * DegToRad;
+    *x = width / 2.0 + parity * (eta * std::sin(theta) - xi * std::cos(theta)) / s;
+    *y = height / 2.0 + (-eta * std::cos(theta) - xi * std::sin(theta)) / s;
+    return true;
+}
+
+uint qHash(const SolveCache::Key &key, uint seed)
+{
+    return ::qHash(((key.scale * 37 + key.rotation) * 181 + key.dec) * 181 + key.ra, seed);
+}
+
+SolveCache::SolveCache(int capacity) : m_Capacity(std::max(1, capacity))
+{
+}
+
+int SolveCache::scaleBucket(double pixscale)
+{
+    return static_cast<int>(std::lround(std::log(pixscale) / std::log(1.1)));
+}
+
+int SolveCache::rotationBucket(double orientation)
+{
+    double angle = std::fmod(orientation, 360.0);
+    if (angle < 0)
+        angle += 360;
+    return static_cast<int>(std::floor(angle / 10)) % 36;
+}
+
+int SolveCache::decBucket(double dec)
+{
+    const int buckets = static_cast<int>(180 / CellSize);
+    return std::max(0, std::min(buckets - 1, static_cast<int>(std::floor((dec + 90) / CellSize))));
+}
+
+int SolveCache::raCells(int decBucket)
+{
+    // About square cells, fewer of them towards the poles
+    const double center = -90 + (decBucket + 0.5) * CellSize;
+    return std::max(1, static_cast<int>(std::floor(360 * std::cos(center * DegToRad) / CellSize)));
+}
+
+int SolveCache::raBucket(double ra, int decBucket)
+{
+    const int cells = raCells(decBucket);
+    return static_cast<int>(std::floor(normalizeRA(ra) / 360 * cells)) % cells;
+}
+
+SolveCache::Key SolveCache::key(const Solution &solution)
+{
+    const int dec = decBucket(solution.dec);
+    return Key{scaleBucket(solution.pixscale), rotationBucket(solution.orientation), dec, raBucket(solution.ra, dec)};
+}
+
+void SolveCache::insert(const Solution &solution, const QVector<Star> &stars)
+{
+    if (!(solution.pixscale > 0) || stars.size() < MinMatches)
+        return;
+
+    const QVector<Star> sorted = brightest(stars);
+
+    const int id = m_NextId++;
+    m_Entries.insert(id, Entry{solution, sorted});
+    m_Index.insert(key(solution), id);
+    m_Recent.append(id);
+
+    while (m_Recent.size() > m_Capacity)
+    {
+        const int oldest = m_Recent.takeFirst();
+        m_Index.remove(key(m_Entries[oldest].solution), oldest);
+        m_Entries.remove(oldest);
+    }
+}
+
+int SolveCache::match(const QVector<Star> &stars, const Entry &entry, double expectedScale, Complex *a, Complex *b)
+{
+    const QVector<Star> &cached = entry.stars;
+    const int n = std::min(PatternStars, stars.size());
+    const int m = std::min(PatternStars, cached.size());
+
+    // Counts the stars mapped onto a cached star by the transform
+    auto count = [&](const Complex & ta, const Complex & tb, double tolerance)
+    {
+        int matches = 0;
+        for (const Star &star : stars)
+        {
+            if (nearest(cached, ta * position(star) + tb, tolerance) >= 0)
+                matches++;
+        }
+        return matches;
+    };
+
+    // Mapping two stars onto two cached stars gives a similarity transform, z' = a z + b.
+    // Only pairs separated by the expected scale are tried.
+    int best = 0;
+    Complex bestA, bestB;
+    const int enough = std::max(static_cast<int>(MinMatches), std::min(stars.size(), cached.size()) / 2);
+    for (int i = 0; i < n && best < enough; ++i)
+    {
+        for (int j = i + 1; j < n && best < enough; ++j)
+        {
+            const Complex zi = position(stars[i]), zj = position(stars[j]);
+            const double d = std::abs(zj - zi);
+            if (d < MinSeparation)
+                continue;
+
+            for (int p = 0; p < m && best < enough; ++p)
+            {
+                for (int q = p + 1; q < m && best < enough; ++q)
+                {
+                    const Complex zp = position(cached[p]), zq = position(cached[q]);
+                    const double ratio = std::abs(zq - zp) / d;
+                    if (std::fabs(ratio / expectedScale - 1) > ScaleTolerance)
+                        continue;
+
+                    for (const auto &target : {std::make_pair(zp, zq), std::make_pair(zq, zp)})
+                    {
+                        const Complex ta = (target.second - target.first) / (zj - zi);
+                        const Complex tb = target.first - ta * zi;
+                        const int matches = count(ta, tb, MatchTolerance);
+                        if (matches > best)
+                        {
+                            best = matches;
+                            bestA = ta;
+                            bestB = tb;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    if (best < MinMatches)
+        return 0;
+
+    // Least squares fit of the transform to the matched stars
+    int matches = 0;
+    double residual = 0;
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        QVector<std::pair<Complex, Complex>> pairs;
+        for (const Star &star : stars)
+        {
+            const Complex z = position(star);
+            const int k = nearest(cached, bestA * z + bestB, RefineTolerance);
+            if (k >= 0)
+                pairs.append(std::make_pair(z, position(cached[k])));
+        }
+        if (pairs.size() < MinMatches)
+            return 0;
+
+        Complex zm, wm;
+        for (const auto &pair : pairs)
+        {
+            zm += pair.first;
+            wm += pair.second;
+        }
+        zm /= static_cast<double>(pairs.size());
+        wm /= static_cast<double>(pairs.size());
+
+        Complex numerator;
+        double denominator = 0;
+        for (const auto &pair : pairs)
+        {
+            numerator += (pair.second - wm) * std::conj(pair.first - zm);
+            denominator += std::norm(pair.first - zm);
+        }
+        if (!(denominator > 0))
+            return 0;
+        bestA = numerator / denominator;
+        bestB = wm - bestA * zm;
+
+        residual = 0;
+        for (const auto &pair : pairs)
+            residual += std::norm(pair.second - (bestA * pair.first + bestB));
+        residual = std::sqrt(residual / pairs.size());
+        matches = pairs.size();
+    }
+
+    if (residual > MaxResidual)
+        return 0;
+
+    *a = bestA;
+    *b = bestB;
+    return matches;
+}
+
+SolveCache::Solution SolveCache::derive(const Solution &cached, const Complex &a, const Complex &b, int width,
+                                        int height)
+{
+    // The center of the frame, and a point above it, on the cached frame
+    const Complex center = a * Complex(width / 2.0, height / 2.0) + b;
+    const Complex up = a * Complex(width / 2.0, height / 2.0 - 100) + b;
+
+    Solution solution;
+    double upRA = 0, upDec = 0;
+    cached.pixelToSky(center.real(), center.imag(), &solution.ra, &solution.dec);
+    cached.pixelToSky(up.real(), up.imag(), &upRA, &upDec);
+    solution.orientation = positionAngle(solution.ra, solution.dec, upRA, upDec);
+    solution.pixscale = cached.pixscale * std::abs(a);
+    solution.width = width;
+    solution.height = height;
+    // The transform has no reflection, both frames have the same parity
+    solution.parity = cached.parity;
+    return solution;
+}
+
+QVector<int> SolveCache::candidates(const Hint &hint)
+{
+    // Buckets around the hint
+    QVector<int> scales, rotations;
+    const int scale = scaleBucket(hint.pixscale);
+    for (int s = scale - 1; s <= scale + 1; ++s)
+        scales.append(s);
+    if (hint.orientation == INVALID_ORIENTATION)
+    {
+        for (int r = 0; r < 36; ++r)
+            rotations.append(r);
+    }
+    else
+    {
+        const int rotation = rotationBucket(hint.orientation);
+        for (int r = rotation - 1; r <= rotation + 1; ++r)
+            rotations.append((r + 36) % 36);
+    }
+
+    // Half width in RA of the search region, or 180 if it holds a pole
+    const double edge = std::fabs(hint.dec) + hint.radius;
+    const double halfWidth = edge < 89 ? hint.radius / std::cos(edge * DegToRad) : 180;
+
+    QSet<int> ids;
+    const int decMin = decBucket(hint.dec - hint.radius), decMax = decBucket(hint.dec + hint.radius);
+    for (int dec = decMin; dec <= decMax; ++dec)
+    {
+        const int cells = raCells(dec);
+        QVector<int> ras;
+        if (halfWidth >= 180)
+        {
+            for (int ra = 0; ra < cells; ++ra)
+                ras.append(ra);
+        }
+        else
+        {
+            const double cellWidth = 360.0 / cells;
+            const int first = static_cast<int>(std::floor((hint.ra - halfWidth) / cellWidth));
+            const int last = static_cast<int>(std::floor((hint.ra + halfWidth) / cellWidth));
+            for (int ra = first; ra <= last && ra - first < cells; ++ra)
+                ras.append(((ra % cells) + cells) % cells);
+        }
+
+        for (int s : scales)
+            for (int r : rotations)
+                for (int ra : ras)
+                    for (int id : m_Index.values(Key{s, r, dec, ra}))
+                        ids.insert(id);
+    }
+
+    // Nearest cached solutions first
+    QVector<std::pair<double, int>> candidates;
+    for (int id : ids)
+    {
+        const Solution &cached = m_Entries[id].solution;
+        const double d = distance(hint.ra, hint.dec, cached.ra, cached.dec);
+        if (d <= hint.radius)
+            candidates.append(std::make_pair(d, id));
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    QVector<int> nearest;
+    for (int i = 0; i < candidates.size() && i < MaxCandidates; ++i)
+        nearest.append(candidates[i].second);
+    return nearest;
+}
+
+bool SolveCache::lookup(const QVector<Star> &stars, int width, int height, const Hint &hint, Solution *solution)
+{
+    if (m_Entries.isEmpty() || stars.size() < MinMatches || !(hint.pixscale > 0) || !(hint.radius > 0))
+        return false;
+
+    m_Statistics.lookups++;
+
+    const QVector<Star> sorted = brightest(stars);
+    for (int candidate : candidates(hint))
+    {
+        const Entry &entry = m_Entries[candidate];
+        Complex a, b;
+        if (match(sorted, entry, hint.pixscale / entry.solution.pixscale, &a, &b) == 0)
+            continue;
+
+        *solution = derive(entry.solution, a, b, width, height);
+
+        m_Recent.removeOne(candidate);
+        m_Recent.append(candidate);
+        m_Statistics.hits++;
+        return true;
+    }
+
+    return false;
+}
+
+void SolveCache::recordSolve(bool cached, qint64 milliseconds)
+{
+    if (cached)
+    {
+        m_Statistics.cachedSolves++;
+        m_Statistics.cachedMilliseconds += milliseconds;
+    }
+    else
+    {
+        m_Statistics.solverSolves++;
+        m_Statistics.solverMilliseconds += milliseconds;
+    }
+}
+
+void SolveCache::clear()
+{
+    m_Entries.clear();
+    m_Index.clear();
+    m_Recent.clear();
+}
+
+}
@@ -0,0 +1,216 @@
+/*  Ekos plate solving cache
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QVector>
+
+#include <complex>
+
+namespace Ekos
+{
+
+/**
+ * @class SolveCache
+ * @short Recent plate solving solutions, and a fast match of new frames against them.
+ *
+ * Each solution is kept with the stars detected on its frame, and indexed by buckets of
+ * pixel scale, orientation and position. When a new frame is taken near a cached one, its
+ * stars are matched against the stars of the cached frame: pairs of bright stars with the
+ * same separation give candidate similarity transforms, and the transform that maps the
+ * most stars is refined by least squares. The solution of the new frame follows from the
+ * transform and the cached solution, without running the solver.
+ *
+ * The transforms do not mirror the frames, so a new frame takes the parity reported by the
+ * solver for the cached one. Frames that overlap no cached frame, are mirrored against it,
+ * or have too few matching stars are left to the solver.
+ */
+class SolveCache
+{
+    public:
+        static constexpr double INVALID_ORIENTATION { -1e6 };
+
+        struct Star
+        {
+            Star() = default;
+            Star(double x_, double y_, double flux_) : x(x_), y(y_), flux(flux_) {}
+
+            // Pixel position on the frame
+            double x { 0 };
+            double y { 0 };
+            double flux { 0 };
+        };
+
+        /**
+         * @brief Gnomonic projection of a frame, as reported by the solvers.
+         *
+         * The orientation is the position angle of the top of the frame (decreasing y), east of north.
+         * East is on the left of the frame when north is up, unless the frame is mirrored.
+         */
+        struct Solution
+        {
+            Solution() = default;
+            Solution(double ra_, double dec_, double orientation_, double pixscale_, int width_, int height_, int parity_ = 1)
+                : ra(ra_), dec(dec_), orientation(orientation_), pixscale(pixscale_), width(width_), height(height_),
+                  parity(parity_) {}
+
+            // J2000 coordinates of the center of the frame, in degrees
+            double ra { 0 };
+            double dec { 0 };
+            // Degrees east of north
+            double orientation { 0 };
+            // Arcseconds per pixel
+            double pixscale { 0 };
+            // Frame size in pixels
+            int width { 0 };
+            int height { 0 };
+            // 1, or -1 if the frame is mirrored
+            int parity { 1 };
+
+            // Converts a pixel position to J2000 coordinates, in degrees.
+            void pixelToSky(double x, double y, double *ra, double *dec) const;
+            // Converts J2000 coordinates to a pixel position. Returns false for the opposite hemisphere.
+            bool skyToPixel(double ra, double dec, double *x, double *y) const;
+        };
+
+        // What is known of a new frame before solving it
+        struct Hint
+        {
+            // Approximate J2000 coordinates of the frame, in degrees
+            double ra { 0 };
+            double dec { 0 };
+            // Search radius around them, in degrees
+            double radius { 2 };
+            // Expected pixel scale in arcseconds per pixel
+            double pixscale { 0 };
+            // Expected orientation in degrees, or INVALID_ORIENTATION if unknown
+            double orientation { INVALID_ORIENTATION };
+        };
+
+        struct Statistics
+        {
+            // Lookups attempted, with cached solutions and enough stars, and those that matched
+            int lookups { 0 };
+            int hits { 0 };
+            // Number and total duration in milliseconds of the solves from the cache and from the solver
+            int cachedSolves { 0 };
+            qint64 cachedMilliseconds { 0 };
+            int solverSolves { 0 };
+            qint64 solverMilliseconds { 0 };
+
+            double hitRate() const
+            {
+                return lookups > 0 ? static_cast<double>(hits) / lookups : 0;
+            }
+            double averageCachedMilliseconds() const
+            {
+                return cachedSolves > 0 ? static_cast<double>(cachedMilliseconds) / cachedSolves : 0;
+            }
+            double averageSolverMilliseconds() const
+            {
+                return solverSolves > 0 ? static_cast<double>(solverMilliseconds) / solverSolves : 0;
+            }
+        };
+
+        // Brightest stars kept per solution
+        static constexpr int MaxStars { 40 };
+        // Fewest matched stars to accept a match
+        static constexpr int MinMatches { 8 };
+        // Largest RMS distance between matched stars, in pixels
+        static constexpr double MaxResidual { 1.5 };
+
+        explicit SolveCache(int capacity = 64);
+
+        // Adds the solution of a frame and the stars detected on it, forgetting the oldest
+        // solution beyond the capacity. Only solutions from the solver, with the parity it
+        // reported, should be added.
+        void insert(const Solution &solution, const QVector<Star> &stars);
+
+        /**
+         * @brief Match the stars of a new frame against the cached solutions around the hint.
+         * @param stars stars detected on the new frame
+         * @param width width of the new frame in pixels
+         * @param height height of the new frame in pixels
+         * @param hint approximate position, scale and orientation of the new frame
+         * @param solution set to the solution of the new frame if a cached solution matched
+         * @return true if a cached solution matched
+         */
+        bool lookup(const QVector<Star> &stars, int width, int height, const Hint &hint, Solution *solution);
+
+        // Records the duration of a solve, from the cache or from the solver, for the statistics.
+        void recordSolve(bool cached, qint64 milliseconds);
+
+        const Statistics &statistics() const
+        {
+            return m_Statistics;
+        }
+
+        int count() const
+        {
+            return m_Entries.size();
+        }
+
+        void clear();
+
+    private:
+        struct Entry
+        {
+            Solution solution;
+            // Brightest stars first
+            QVector<Star> stars;
+        };
+
+        struct Key
+        {
+            int scale;
+            int rotation;
+            int dec;
+            int ra;
+
+            bool operator==(const Key &other) const
+            {
+                return scale == other.scale && rotation == other.rotation && dec == other.dec && ra == other.ra;
+            }
+        };
+        friend uint qHash(const Key &key, uint seed);
+
+        // Buckets of 10% in pixel scale, 10 degrees in orientation, and cells of CellSize degrees on the sky.
+        static constexpr double CellSize { 2 };
+        static int scaleBucket(double pixscale);
+        static int rotationBucket(double orientation);
+        static int decBucket(double dec);
+        static int raCells(int decBucket);
+        static int raBucket(double ra, int decBucket);
+        static Key key(const Solution &solution);
+
+        // Ids of the cached solutions around the hint, nearest first.
+        QVector<int> candidates(const Hint &hint);
+
+        // Fits the transform from the pixels of a frame to those of a cached entry, z' = a z + b
+        // in complex notation. Returns the number of matched stars, or 0 if the frames do not match.
+        static int match(const QVector<Star> &stars, const Entry &entry, double expectedScale,
+                         std::complex<double> *a, std::complex<double> *b);
+
+        // Solution of a frame of the given size, mapped onto a cached frame by z' = a z + b.
+        static Solution derive(const Solution &cached, const std::complex<double> &a, const std::complex<double> &b,
+                               int width, int height);
+
+        int m_Capacity { 64 };
+        int m_NextId { 0 };
+        QHash<int, Entry> m_Entries;
+        QMultiHash<Key, int> m_Index;
+        // Entry ids, least recently used first
+        QList<int> m_Recent;
+
+        Statistics m_Statistics;
+};
+
+}
@@ -12,6 +12,7 @@
 #include <KNotifications/KNotification>
 #include <QDateTime>
 #include <QShortcut>
+#include <QtConcurrent>
 #include <QtGlobal>
 
 #include "auxiliary/kspaths.h"
@@ -19,6 +20,7 @@
 #include "ekos/manager.h"
 #include "fitsviewer/fitsdata.h"
 #include "fitsviewer/fitsviewer.h"
+#include "intervaltree.h"
 #include "ksmessagebox.h"
 #include "kstars.h"
 #include "Options.h"
@@ -62,7 +64,7 @@ constexpr int MAX_SCROLL_VALUE = 10000;
 constexpr double halfTimelineHeight = 0.35;
 
 // These are initialized in initStatsPlot when the graphs are added.
-// They index the graphs in statsPlot, e.g. statsPlot->graph(HFR_GRAPH)->addData(...)
+// They index the graphs in statsPlot and statsData, e.g. addStatsData(HFR_GRAPH, ...)
 int HFR_GRAPH = -1;
 int TEMPERATURE_GRAPH = -1;
 int NUM_CAPTURE_STARS_GRAPH = -1;
@@ -250,42 +252,13 @@ QString findFilename(const QString &filename, const QString &alternateDirectory)
     return "";
 }
 
-// This is an exhaustive search for now.
-// This is reasonable as the number of sessions should be limited.
-template <class T>
-class IntervalFinder
-{
-    public:
-        IntervalFinder() {}
-        ~IntervalFinder() {}
-        void add(T value)
-        {
-            intervals.append(value);
-        }
-        void clear()
-        {
-            intervals.clear();
-        }
-        QList<T> find(double t)
-        {
-            QList<T> result;
-            for (const auto i : intervals)
-            {
-                if (t >= i.start && t <= i.end)
-                    result.push_back(i);
-            }
-            return result;
-        }
-    private:
-        QList<T> intervals;
-};
-
-IntervalFinder<Ekos::Analyze::CaptureSession> captureSessions;
-IntervalFinder<Ekos::Analyze::FocusSession> focusSessions;
-IntervalFinder<Ekos::Analyze::GuideSession> guideSessions;
-IntervalFinder<Ekos::Analyze::MountSession> mountSessions;
-IntervalFinder<Ekos::Analyze::AlignSession> alignSessions;
-IntervalFinder<Ekos::Analyze::MountFlipSession> mountFlipSessions;
+// Sessions of each Timeline line, looked up when the Timeline is clicked.
+Ekos::IntervalTree<Ekos::Analyze::CaptureSession> captureSessions;
+Ekos::IntervalTree<Ekos::Analyze::FocusSession> focusSessions;
+Ekos::IntervalTree<Ekos::Analyze::GuideSession> guideSessions;
+Ekos::IntervalTree<Ekos::Analyze::MountSession> mountSessions;
+Ekos::IntervalTree<Ekos::Analyze::AlignSession> alignSessions;
+Ekos::IntervalTree<Ekos::Analyze::MountFlipSession> mountFlipSessions;
 
 }  // namespace
 
@@ -566,8 +539,8 @@ void Analyze::addGuideStats(double raDrift, double decDrift, int raPulse, int de
                 (time - lastCaptureRmsTime > MAX_GUIDE_STATS_GAP))
         {
             // this is the first sample in a series with a gap behind us.
-            statsPlot->graph(CAPTURE_RMS_GRAPH)->addData(lastCaptureRmsTime + .0001, qQNaN());
-            statsPlot->graph(CAPTURE_RMS_GRAPH)->addData(time - .0001, qQNaN());
+            addStatsData(CAPTURE_RMS_GRAPH, lastCaptureRmsTime + .0001, qQNaN());
+            addStatsData(CAPTURE_RMS_GRAPH, time - .0001, qQNaN());
             // I can go either way on this. E.g. resetting the filter will start the RMS
             // average over again, e.g. after a autofocus where the guider was suspended
             // for a couple minutes. Not having it will average the new capture's guide
@@ -578,7 +551,7 @@ void Analyze::addGuideStats(double raDrift, double decDrift, int raPulse, int de
             // captureRms->resetFilter();
         }
         const double rmsC = captureRms->newSample(raDrift, decDrift);
-        statsPlot->graph(CAPTURE_RMS_GRAPH)->addData(time, rmsC);
+        addStatsData(CAPTURE_RMS_GRAPH, time, rmsC);
         lastCaptureRmsTime = time;
     }
 
@@ -590,12 +563,12 @@ void Analyze::addGuideStatsInternal(double raDrift, double decDrift, double raPu
                                     double numStars, double skyBackground,
                                     double drift, double rms, double time)
 {
-    statsPlot->graph(RA_GRAPH)->addData(time, raDrift);
-    statsPlot->graph(DEC_GRAPH)->addData(time, decDrift);
-    statsPlot->graph(RA_PULSE_GRAPH)->addData(time, raPulse);
-    statsPlot->graph(DEC_PULSE_GRAPH)->addData(time, decPulse);
-    statsPlot->graph(DRIFT_GRAPH)->addData(time, drift);
-    statsPlot->graph(RMS_GRAPH)->addData(time, rms);
+    addStatsData(RA_GRAPH, time, raDrift);
+    addStatsData(DEC_GRAPH, time, decDrift);
+    addStatsData(RA_PULSE_GRAPH, time, raPulse);
+    addStatsData(DEC_PULSE_GRAPH, time, decPulse);
+    addStatsData(DRIFT_GRAPH, time, drift);
+    addStatsData(RMS_GRAPH, time, rms);
 
     // Set the SNR axis' maximum to 95% of the way up from the middle to the top.
     if (!qIsNaN(snr))
@@ -611,15 +584,15 @@ void Analyze::addGuideStatsInternal(double raDrift, double decDrift, double raPu
     skyBgAxis->setRange(0, std::max(10.0, 1.15 * skyBgMax));
     numStarsAxis->setRange(0, std::max(10.0, 1.25 * numStarsMax));
 
-    statsPlot->graph(SNR_GRAPH)->addData(time, snr);
-    statsPlot->graph(NUMSTARS_GRAPH)->addData(time, numStars);
-    statsPlot->graph(SKYBG_GRAPH)->addData(time, skyBackground);
+    addStatsData(SNR_GRAPH, time, snr);
+    addStatsData(NUMSTARS_GRAPH, time, numStars);
+    addStatsData(SKYBG_GRAPH, time, skyBackground);
 }
 
 void Analyze::addTemperature(double temperature, double time)
 {
     // The HFR corresponds to the last capture
-    statsPlot->graph(TEMPERATURE_GRAPH)->addData(time, temperature);
+    addStatsData(TEMPERATURE_GRAPH, time, temperature);
 }
 
 // Add the HFR values to the Stats graph, as a constant value between startTime and time.
@@ -627,25 +600,25 @@ void Analyze::addHFR(double hfr, int numCaptureStars, int median, double eccentr
                      double time, double startTime)
 {
     // The HFR corresponds to the last capture
-    statsPlot->graph(HFR_GRAPH)->addData(startTime - .0001, qQNaN());
-    statsPlot->graph(HFR_GRAPH)->addData(startTime, hfr);
-    statsPlot->graph(HFR_GRAPH)->addData(time, hfr);
-    statsPlot->graph(HFR_GRAPH)->addData(time + .0001, qQNaN());
-
-    statsPlot->graph(NUM_CAPTURE_STARS_GRAPH)->addData(startTime - .0001, qQNaN());
-    statsPlot->graph(NUM_CAPTURE_STARS_GRAPH)->addData(startTime, numCaptureStars);
-    statsPlot->graph(NUM_CAPTURE_STARS_GRAPH)->addData(time, numCaptureStars);
-    statsPlot->graph(NUM_CAPTURE_STARS_GRAPH)->addData(time + .0001, qQNaN());
-
-    statsPlot->graph(MEDIAN_GRAPH)->addData(startTime - .0001, qQNaN());
-    statsPlot->graph(MEDIAN_GRAPH)->addData(startTime, median);
-    statsPlot->graph(MEDIAN_GRAPH)->addData(time, median);
-    statsPlot->graph(MEDIAN_GRAPH)->addData(time + .0001, qQNaN());
-
-    statsPlot->graph(ECCENTRICITY_GRAPH)->addData(startTime - .0001, qQNaN());
-    statsPlot->graph(ECCENTRICITY_GRAPH)->addData(startTime, eccentricity);
-    statsPlot->graph(ECCENTRICITY_GRAPH)->addData(time, eccentricity);
-    statsPlot->graph(ECCENTRICITY_GRAPH)->addData(time + .0001, qQNaN());
+    addStatsData(HFR_GRAPH, startTime - .0001, qQNaN());
+    addStatsData(HFR_GRAPH, startTime, hfr);
+    addStatsData(HFR_GRAPH, time, hfr);
+    addStatsData(HFR_GRAPH, time + .0001, qQNaN());
+
+    addStatsData(NUM_CAPTURE_STARS_GRAPH, startTime - .0001, qQNaN());
+    addStatsData(NUM_CAPTURE_STARS_GRAPH, startTime, numCaptureStars);
+    addStatsData(NUM_CAPTURE_STARS_GRAPH, time, numCaptureStars);
+    addStatsData(NUM_CAPTURE_STARS_GRAPH, time + .0001, qQNaN());
+
+    addStatsData(MEDIAN_GRAPH, startTime - .0001, qQNaN());
+    addStatsData(MEDIAN_GRAPH, startTime, median);
+    addStatsData(MEDIAN_GRAPH, time, median);
+    addStatsData(MEDIAN_GRAPH, time + .0001, qQNaN());
+
+    addStatsData(ECCENTRICITY_GRAPH, startTime - .0001, qQNaN());
+    addStatsData(ECCENTRICITY_GRAPH, startTime, eccentricity);
+    addStatsData(ECCENTRICITY_GRAPH, time, eccentricity);
+    addStatsData(ECCENTRICITY_GRAPH, time + .0001, qQNaN());
 
     medianMax = std::max(median, medianMax);
     numCaptureStarsMax = std::max(numCaptureStars, numCaptureStarsMax);
@@ -656,28 +629,65 @@ void Analyze::addHFR(double hfr, int numCaptureStars, int median, double eccentr
 void Analyze::addMountCoords(double ra, double dec, double az,
                              double alt, int pierSide, double ha, double time)
 {
-    statsPlot->graph(MOUNT_RA_GRAPH)->addData(time, ra);
-    statsPlot->graph(MOUNT_DEC_GRAPH)->addData(time, dec);
-    statsPlot->graph(MOUNT_HA_GRAPH)->addData(time, ha);
-    statsPlot->graph(AZ_GRAPH)->addData(time, az);
-    statsPlot->graph(ALT_GRAPH)->addData(time, alt);
-    statsPlot->graph(PIER_SIDE_GRAPH)->addData(time, double(pierSide));
+    addStatsData(MOUNT_RA_GRAPH, time, ra);
+    addStatsData(MOUNT_DEC_GRAPH, time, dec);
+    addStatsData(MOUNT_HA_GRAPH, time, ha);
+    addStatsData(AZ_GRAPH, time, az);
+    addStatsData(ALT_GRAPH, time, alt);
+    addStatsData(PIER_SIDE_GRAPH, time, double(pierSide));
+}
+
+void Analyze::addStatsData(int graph, double time, double value)
+{
+    statsData[graph].append(time, value);
+}
+
+void Analyze::updateStatsGraphs()
+{
+    const double start = statsPlot->xAxis->range().lower;
+    const double end = statsPlot->xAxis->range().upper;
+    const int pixels = statsPlot->axisRect()->width();
+    QVector<double> keys, values;
+
+    for (int i = 0; i < statsData.size(); ++i)
+    {
+        StatsGraphState &state = statsGraphStates[i];
+        if (state.revision == statsData[i].revision() && state.start == start &&
+                state.end == end && state.pixels == pixels)
+            continue;
+
+        statsData[i].decimate(start, end, pixels, &keys, &values);
+        statsPlot->graph(i)->setData(keys, values, true);
+        state = { statsData[i].revision(), start, end, pixels };
+    }
 }
 
 // Read a .analyze file, and setup all the graphics.
+// The file is read in chunks of lines. The lines of a chunk are parsed in
+// parallel, then processed in order, as they drive the sessions' state machines.
 double Analyze::readDataFromFile(const QString &filename)
 {
+    constexpr int CHUNK_LINES = 20000;
     double lastTime = 10;
     QFile inputFile(filename);
     if (inputFile.open(QIODevice::ReadOnly))
     {
         QTextStream in(&inputFile);
+        QStringList lines;
+        lines.reserve(CHUNK_LINES);
         while (!in.atEnd())
         {
-            QString line = in.readLine();
-            double time = processInputLine(line);
-            if (time > lastTime)
-                lastTime = time;
+            lines.clear();
+            while (lines.size() < CHUNK_LINES && !in.atEnd())
+                lines.append(in.readLine());
+
+            const QList<LogLine> parsed = QtConcurrent::blockingMapped(lines, &Analyze::parseInputLine);
+            for (const auto &line : parsed)
+            {
+                double time = processLogLine(line);
+                if (time > lastTime)
+                    lastTime = time;
+            }
         }
         inputFile.close();
     }
@@ -687,163 +697,232 @@ double Analyze::readDataFromFile(const QString &filename)
 // Process an input line read from a .analyze file.
 double Analyze::processInputLine(const QString &line)
 {
+    return processLogLine(parseInputLine(line));
+}
+
+// Parses and validates a line of a .analyze file.
+// Returns a line of type INVALID for comments and malformed lines.
+Analyze::LogLine Analyze::parseInputLine(const QString &line)
+{
+    LogLine result;
     bool ok;
     // Break the line into comma-separated components
     QStringList list = line.split(QLatin1Char(','));
     // We need at least a command and a timestamp
     if (list.size() < 2)
-        return 0;
+        return result;
     if (list[0].at(0).toLatin1() == '#')
     {
         // Comment character # must be at start of line.
-        return 0;
+        return result;
     }
 
     if ((list[0] == "AnalyzeStartTime") && list.size() == 3)
     {
-        displayStartTime = QDateTime::fromString(list[1], timeFormat);
-        startTimeInitialized = true;
-        analyzeTimeZone = list[2];
-        return 0;
+        result.type = LogLine::START_TIME;
+        result.strings << list[1] << list[2];
+        return result;
     }
 
     // Except for comments and the above AnalyzeStartTime, the second item
     // in the csv line is a double which represents seconds since start of the log.
     const double time = QString(list[1]).toDouble(&ok);
     if (!ok)
-        return 0;
+        return result;
     if (time < 0 || time > 3600 * 24 * 10)
-        return 0;
+        return result;
+
+    // Field conversions, which set ok.
+    auto toInt = [&](int index)
+    {
+        const int value = QString(list[index]).toInt(&ok);
+        return ok ? value : 0;
+    };
+    auto toDouble = [&](int index)
+    {
+        const double value = QString(list[index]).toDouble(&ok);
+        return ok ? value : 0.0;
+    };
 
+    LogLine::Type type = LogLine::INVALID;
+    bool valid = true;
     if ((list[0] == "CaptureStarting") && (list.size() == 4))
     {
-        const double exposureSeconds = QString(list[2]).toDouble(&ok);
-        if (!ok)
-            return 0;
-        const QString filter = list[3];
-        processCaptureStarting(time, exposureSeconds, filter, true);
+        type = LogLine::CAPTURE_STARTING;
+        result.numbers[0] = toDouble(2);
+        valid = ok;
+        result.strings << list[3];
     }
     else if ((list[0] == "CaptureComplete") && (list.size() >= 6) && (list.size() <= 9))
     {
-        const double exposureSeconds = QString(list[2]).toDouble(&ok);
-        if (!ok)
-            return 0;
-        const QString filter = list[3];
-        const double hfr = QString(list[4]).toDouble(&ok);
-        if (!ok)
-            return 0;
-        const QString filename = list[5];
-        const int numStars = (list.size() > 6) ? QString(list[6]).toInt(&ok) : 0;
-        if (!ok)
-            return 0;
-        const int median = (list.size() > 7) ? QString(list[7]).toInt(&ok) : 0;
-        if (!ok)
-            return 0;
-        const double eccentricity = (list.size() > 8) ? QString(list[8]).toDouble(&ok) : 0;
-        if (!ok)
-            return 0;
-        processCaptureComplete(time, filename, exposureSeconds, filter, hfr, numStars, median, eccentricity, true);
+        type = LogLine::CAPTURE_COMPLETE;
+        // exposure, hfr, numStars, median, eccentricity; filter, filename
+        result.numbers[0] = toDouble(2);
+        valid = ok;
+        result.numbers[1] = toDouble(4);
+        valid = valid && ok;
+        if (list.size() > 6)
+        {
+            result.numbers[2] = toInt(6);
+            valid = valid && ok;
+        }
+        if (list.size() > 7)
+        {
+            result.numbers[3] = toInt(7);
+            valid = valid && ok;
+        }
+        if (list.size() > 8)
+        {
+            result.numbers[4] = toDouble(8);
+            valid = valid && ok;
+        }
+        result.strings << list[3] << list[5];
     }
     else if ((list[0] == "CaptureAborted") && (list.size() == 3))
     {
-        const double exposureSeconds = QString(list[2]).toDouble(&ok);
-        if (!ok)
-            return 0;
-        processCaptureAborted(time, exposureSeconds, true);
+        type = LogLine::CAPTURE_ABORTED;
+        result.numbers[0] = toDouble(2);
+        valid = ok;
     }
     else if ((list[0] == "AutofocusStarting") && (list.size() == 4))
     {
-        QString filter = list[2];
-        double temperature = QString(list[3]).toDouble(&ok);
-        if (!ok)
-            return 0;
-        processAutofocusStarting(time, temperature, filter, true);
+        type = LogLine::AUTOFOCUS_STARTING;
+        result.numbers[0] = toDouble(3);
+        valid = ok;
+        result.strings << list[2];
     }
     else if ((list[0] == "AutofocusComplete") && (list.size() == 4))
     {
-        QString filter = list[2];
-        QString samples = list[3];
-        processAutofocusComplete(time, filter, samples, true);
+        type = LogLine::AUTOFOCUS_COMPLETE;
+        result.strings << list[2] << list[3];
     }
     else if ((list[0] == "AutofocusAborted") && (list.size() == 4))
     {
-        QString filter = list[2];
-        QString samples = list[3];
-        processAutofocusAborted(time, filter, samples, true);
+        type = LogLine::AUTOFOCUS_ABORTED;
+        result.strings << list[2] << list[3];
     }
     else if ((list[0] == "GuideState") && list.size() == 3)
     {
-        processGuideState(time, list[2], true);
+        type = LogLine::GUIDE_STATE;
+        result.strings << list[2];
     }
     else if ((list[0] == "GuideStats") && list.size() == 9)
     {
-        const double ra = QString(list[2]).toDouble(&ok);
-        if (!ok)
-            return 0;
-        const double dec = QString(list[3]).toDouble(&ok);
-        if (!ok)
-            return 0;
-        const double raPulse = QString(list[4]).toInt(&ok);
-        if (!ok)
-            return 0;
-        const double decPulse = QString(list[5]).toInt(&ok);
-        if (!ok)
-            return 0;
-        const double snr = QString(list[6]).toDouble(&ok);
-        if (!ok)
-            return 0;
-        const double skyBg = QString(list[7]).toDouble(&ok);
-        if (!ok)
-            return 0;
-        const double numStars = QString(list[8]).toInt(&ok);
-        if (!ok)
-            return 0;
-        processGuideStats(time, ra, dec, raPulse, decPulse, snr, skyBg, numStars, true);
+        type = LogLine::GUIDE_STATS;
+        // ra, dec, raPulse, decPulse, snr, skyBg, numStars
+        const bool isInt[] = { false, false, true, true, false, false, true };
+        for (int i = 0; i < 7 && valid; ++i)
+        {
+            result.numbers[i] = isInt[i] ? toInt(i + 2) : toDouble(i + 2);
+            valid = ok;
+        }
     }
     else if ((list[0] == "Temperature") && list.size() == 3)
     {
-        const double temperature = QString(list[2]).toDouble(&ok);
-        if (!ok)
-            return 0;
-        processTemperature(time, temperature, true);
+        type = LogLine::TEMPERATURE;
+        result.numbers[0] = toDouble(2);
+        valid = ok;
     }
     else if ((list[0] == "MountState") && list.size() == 3)
     {
-        processMountState(time, list[2], true);
+        type = LogLine::MOUNT_STATE;
+        result.strings << list[2];
     }
     else if ((list[0] == "MountCoords") && (list.size() == 7 || list.size() == 8))
     {
-        const double ra = QString(list[2]).toDouble(&ok);
-        if (!ok)
-            return 0;
-        const double dec = QString(list[3]).toDouble(&ok);
-        if (!ok)
-            return 0;
-        const double az = QString(list[4]).toDouble(&ok);
-        if (!ok)
-            return 0;
-        const double alt = QString(list[5]).toDouble(&ok);
-        if (!ok)
-            return 0;
-        const int side = QString(list[6]).toInt(&ok);
-        if (!ok)
-            return 0;
-        const double ha = (list.size() > 7) ? QString(list[7]).toDouble(&ok) : 0;
-        if (!ok)
-            return 0;
-        processMountCoords(time, ra, dec, az, alt, side, ha, true);
+        type = LogLine::MOUNT_COORDS;
+        // ra, dec, az, alt, pierSide, ha
+        for (int i = 0; i < 4 && valid; ++i)
+        {
+            result.numbers[i] = toDouble(i + 2);
+            valid = ok;
+        }
+        if (valid)
+        {
+            result.numbers[4] = toInt(6);
+            valid = ok;
+        }
+        if (valid && list.size() > 7)
+        {
+            result.numbers[5] = toDouble(7);
+            valid = ok;
+        }
     }
     else if ((list[0] == "AlignState") && list.size() == 3)
     {
-        processAlignState(time, list[2], true);
+        type = LogLine::ALIGN_STATE;
+        result.strings << list[2];
     }
     else if ((list[0] == "MeridianFlipState") && list.size() == 3)
     {
-        processMountFlipState(time, list[2], true);
+        type = LogLine::MOUNT_FLIP_STATE;
+        result.strings << list[2];
     }
-    else
+
+    if (valid)
     {
-        return 0;
+        result.type = type;
+        result.time = time;
+    }
+    return result;
+}
+
+// Process a parsed line of a .analyze file.
+// Returns the time of the line, or 0 if it wasn't processed.
+double Analyze::processLogLine(const LogLine &line)
+{
+    const double time = line.time;
+    const double *n = line.numbers;
+    switch (line.type)
+    {
+        case LogLine::INVALID:
+            return 0;
+        case LogLine::START_TIME:
+            displayStartTime = QDateTime::fromString(line.strings[0], timeFormat);
+            startTimeInitialized = true;
+            analyzeTimeZone = line.strings[1];
+            return 0;
+        case LogLine::CAPTURE_STARTING:
+            processCaptureStarting(time, n[0], line.strings[0], true);
+            break;
+        case LogLine::CAPTURE_COMPLETE:
+            processCaptureComplete(time, line.strings[1], n[0], line.strings[0], n[1],
+                                   static_cast<int>(n[2]), static_cast<int>(n[3]), n[4], true);
+            break;
+        case LogLine::CAPTURE_ABORTED:
+            processCaptureAborted(time, n[0], true);
+            break;
+        case LogLine::AUTOFOCUS_STARTING:
+            processAutofocusStarting(time, n[0], line.strings[0], true);
+            break;
+        case LogLine::AUTOFOCUS_COMPLETE:
+            processAutofocusComplete(time, line.strings[0], line.strings[1], true);
+            break;
+        case LogLine::AUTOFOCUS_ABORTED:
+            processAutofocusAborted(time, line.strings[0], line.strings[1], true);
+            break;
+        case LogLine::GUIDE_STATE:
+            processGuideState(time, line.strings[0], true);
+            break;
+        case LogLine::GUIDE_STATS:
+            processGuideStats(time, n[0], n[1], static_cast<int>(n[2]), static_cast<int>(n[3]),
+                              n[4], n[5], static_cast<int>(n[6]), true);
+            break;
+        case LogLine::TEMPERATURE:
+            processTemperature(time, n[0], true);
+            break;
+        case LogLine::MOUNT_STATE:
+            processMountState(time, line.strings[0], true);
+            break;
+        case LogLine::MOUNT_COORDS:
+            processMountCoords(time, n[0], n[1], n[2], n[3], static_cast<int>(n[4]), n[5], true);
+            break;
+        case LogLine::ALIGN_STATE:
+            processAlignState(time, line.strings[0], true);
+            break;
+        case LogLine::MOUNT_FLIP_STATE:
+            processMountFlipState(time, line.strings[0], true);
+            break;
     }
     return time;
 }
@@ -1084,20 +1163,19 @@ void Analyze::displayGuideGraphics(double start, double end, double *raRMS,
                                    double *decRMS, double *totalRMS, int *numSamples)
 {
     resetGraphicsPlot();
-    auto ra = statsPlot->graph(RA_GRAPH)->data()->findBegin(start);
-    auto dec = statsPlot->graph(DEC_GRAPH)->data()->findBegin(start);
-    auto raEnd = statsPlot->graph(RA_GRAPH)->data()->findEnd(end);
-    auto decEnd = statsPlot->graph(DEC_GRAPH)->data()->findEnd(end);
+    const TimeSeries &ra = statsData[RA_GRAPH];
+    const TimeSeries &dec = statsData[DEC_GRAPH];
+    int r = ra.findBegin(start);
+    int d = dec.findBegin(start);
+    const int raEnd = ra.findEnd(end);
+    const int decEnd = dec.findEnd(end);
     int num = 0;
     double raSquareErrorSum = 0, decSquareErrorSum = 0;
-    while (ra != raEnd && dec != decEnd &&
-            ra->mainKey() < end && dec->mainKey() < end &&
-            ra != statsPlot->graph(RA_GRAPH)->data()->constEnd() &&
-            dec != statsPlot->graph(DEC_GRAPH)->data()->constEnd() &&
-            ra->mainKey() < end && dec->mainKey() < end)
-    {
-        const double raVal = ra->mainValue();
-        const double decVal = dec->mainValue();
+    while (r < raEnd && d < decEnd &&
+            ra.time(r) < end && dec.time(d) < end)
+    {
+        const double raVal = ra.value(r);
+        const double decVal = dec.value(d);
         graphicsPlot->graph(GUIDER_GRAPHICS)->addData(raVal, decVal);
         if (!qIsNaN(raVal) && !qIsNaN(decVal))
         {
@@ -1105,8 +1183,8 @@ void Analyze::displayGuideGraphics(double start, double end, double *raRMS,
             decSquareErrorSum += decVal * decVal;
             num++;
         }
-        ra++;
-        dec++;
+        r++;
+        d++;
     }
     if (numSamples != nullptr)
         *numSamples = num;
@@ -1388,6 +1466,8 @@ void Analyze::replot(bool adjustSlider)
 
     dateTicker->setOffset(displayStartTime.toMSecsSinceEpoch() / 1000.0);
 
+    updateStatsGraphs();
+
     timelinePlot->replot();
     statsPlot->replot();
     graphicsPlot->replot();
@@ -1399,23 +1479,23 @@ namespace
 // Pass in a function that converts the double graph value to a string
 // for the value box.
 template<typename Func>
-void updateStat(double time, QLineEdit *valueBox, QCPGraph *graph, Func func, bool useLastRealVal = false)
+void updateStat(double time, QLineEdit *valueBox, const Ekos::TimeSeries &series, Func func, bool useLastRealVal = false)
 {
-    auto begin = graph->data()->findBegin(time);
+    const int begin = series.findBegin(time);
     double timeDiffThreshold = 10000000.0;
-    if ((begin != graph->data()->constEnd()) &&
-            (fabs(begin->mainKey() - time) < timeDiffThreshold))
+    if ((begin < series.size()) &&
+            (fabs(series.time(begin) - time) < timeDiffThreshold))
     {
-        double foundVal = begin->mainValue();
+        double foundVal = series.value(begin);
         valueBox->setDisabled(false);
         if (qIsNaN(foundVal))
         {
-            int index = graph->findBegin(time);
+            int index = begin;
             const double MAX_TIME_DIFF = 600;
             while (useLastRealVal && index >= 0)
             {
-                const double val = graph->data()->at(index)->mainValue();
-                const double t = graph->data()->at(index)->mainKey();
+                const double val = series.value(index);
+                const double t = series.time(index);
                 if (time - t > MAX_TIME_DIFF)
                     break;
                 if (!qIsNaN(val))
@@ -1443,18 +1523,18 @@ void Analyze::updateStatsValues()
     auto d2Fcn = [](double d) -> QString { return QString::number(d, 'f', 2); };
     // HFR, numCaptureStars, median & eccentricity are the only ones to use the last real value,
     // that is, it keeps those values from the last exposure.
-    updateStat(time, hfrOut, statsPlot->graph(HFR_GRAPH), d2Fcn, true);
-    updateStat(time, eccentricityOut, statsPlot->graph(ECCENTRICITY_GRAPH), d2Fcn, true);
-    updateStat(time, skyBgOut, statsPlot->graph(SKYBG_GRAPH), d2Fcn);
-    updateStat(time, snrOut, statsPlot->graph(SNR_GRAPH), d2Fcn);
-    updateStat(time, raOut, statsPlot->graph(RA_GRAPH), d2Fcn);
-    updateStat(time, decOut, statsPlot->graph(DEC_GRAPH), d2Fcn);
-    updateStat(time, driftOut, statsPlot->graph(DRIFT_GRAPH), d2Fcn);
-    updateStat(time, rmsOut, statsPlot->graph(RMS_GRAPH), d2Fcn);
-    updateStat(time, rmsCOut, statsPlot->graph(CAPTURE_RMS_GRAPH), d2Fcn);
-    updateStat(time, azOut, statsPlot->graph(AZ_GRAPH), d2Fcn);
-    updateStat(time, altOut, statsPlot->graph(ALT_GRAPH), d2Fcn);
-    updateStat(time, temperatureOut, statsPlot->graph(TEMPERATURE_GRAPH), d2Fcn);
+    updateStat(time, hfrOut, statsData[HFR_GRAPH], d2Fcn, true);
+    updateStat(time, eccentricityOut, statsData[ECCENTRICITY_GRAPH], d2Fcn, true);
+    updateStat(time, skyBgOut, statsData[SKYBG_GRAPH], d2Fcn);
+    updateStat(time, snrOut, statsData[SNR_GRAPH], d2Fcn);
+    updateStat(time, raOut, statsData[RA_GRAPH], d2Fcn);
+    updateStat(time, decOut, statsData[DEC_GRAPH], d2Fcn);
+    updateStat(time, driftOut, statsData[DRIFT_GRAPH], d2Fcn);
+    updateStat(time, rmsOut, statsData[RMS_GRAPH], d2Fcn);
+    updateStat(time, rmsCOut, statsData[CAPTURE_RMS_GRAPH], d2Fcn);
+    updateStat(time, azOut, statsData[AZ_GRAPH], d2Fcn);
+    updateStat(time, altOut, statsData[ALT_GRAPH], d2Fcn);
+    updateStat(time, temperatureOut, statsData[TEMPERATURE_GRAPH], d2Fcn);
 
     auto hmsFcn = [](double d) -> QString
     {
@@ -1463,9 +1543,9 @@ void Analyze::updateStatsValues()
         return QString("%1:%2:%3").arg(ra.hour()).arg(ra.minute()).arg(ra.second());
         //return ra.toHMSString();
     };
-    updateStat(time, mountRaOut, statsPlot->graph(MOUNT_RA_GRAPH), hmsFcn);
+    updateStat(time, mountRaOut, statsData[MOUNT_RA_GRAPH], hmsFcn);
     auto dmsFcn = [](double d) -> QString { dms dec; dec.setD(d); return dec.toDMSString(); };
-    updateStat(time, mountDecOut, statsPlot->graph(MOUNT_DEC_GRAPH), dmsFcn);
+    updateStat(time, mountDecOut, statsData[MOUNT_DEC_GRAPH], dmsFcn);
     auto haFcn = [](double d) -> QString
     {
         dms ha;
@@ -1480,21 +1560,21 @@ void Analyze::updateStatsValues()
         return QString("%1%2:%3").arg(sgn).arg(ha.hour(), 2, 10, z)
         .arg(ha.minute(), 2, 10, z);
     };
-    updateStat(time, mountHaOut, statsPlot->graph(MOUNT_HA_GRAPH), haFcn);
+    updateStat(time, mountHaOut, statsData[MOUNT_HA_GRAPH], haFcn);
 
     auto intFcn = [](double d) -> QString { return QString::number(d, 'f', 0); };
-    updateStat(time, numStarsOut, statsPlot->graph(NUMSTARS_GRAPH), intFcn);
-    updateStat(time, raPulseOut, statsPlot->graph(RA_PULSE_GRAPH), intFcn);
-    updateStat(time, decPulseOut, statsPlot->graph(DEC_PULSE_GRAPH), intFcn);
-    updateStat(time, numCaptureStarsOut, statsPlot->graph(NUM_CAPTURE_STARS_GRAPH), intFcn, true);
-    updateStat(time, medianOut, statsPlot->graph(MEDIAN_GRAPH), intFcn, true);
+    updateStat(time, numStarsOut, statsData[NUMSTARS_GRAPH], intFcn);
+    updateStat(time, raPulseOut, statsData[RA_PULSE_GRAPH], intFcn);
+    updateStat(time, decPulseOut, statsData[DEC_PULSE_GRAPH], intFcn);
+    updateStat(time, numCaptureStarsOut, statsData[NUM_CAPTURE_STARS_GRAPH], intFcn, true);
+    updateStat(time, medianOut, statsData[MEDIAN_GRAPH], intFcn, true);
 
 
     auto pierFcn = [](double d) -> QString
     {
         return d == 0.0 ? "W->E" : d == 1.0 ? "E->W" : "?";
     };
-    updateStat(time, pierSideOut, statsPlot->graph(PIER_SIDE_GRAPH), pierFcn);
+    updateStat(time, pierSideOut, statsData[PIER_SIDE_GRAPH], pierFcn);
 }
 
 void Analyze::initStatsCheckboxes()
@@ -1794,6 +1874,10 @@ void Analyze::initStatsPlot()
     // Didn't include QCP::iRangeDrag as it  interacts poorly with the curson logic.
     statsPlot->setInteractions(QCP::iRangeZoom);
     statsPlot->axisRect()->setRangeZoomAxes(0, statsPlot->yAxis);
+
+    // The samples of each graph, of which the graph itself only gets the visible part.
+    statsData.resize(statsPlot->graphCount());
+    statsGraphStates.fill({ 0, 0, 0, -1 }, statsPlot->graphCount());
 }
 
 // Clear the graphics and state when changing input data.
@@ -1810,6 +1894,8 @@ void Analyze::reset()
 
     for (int i = 0; i < statsPlot->graphCount(); ++i)
         statsPlot->graph(i)->data()->clear();
+    for (auto &series : statsData)
+        series.clear();
     statsPlot->clearItems();
 
     for (int i = 0; i < timelinePlot->graphCount(); ++i)
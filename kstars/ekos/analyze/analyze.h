@@ -16,6 +16,7 @@
 #include "ekos/ekos.h"
 #include "ekos/mount/mount.h"
 #include "indi/inditelescope.h"
+#include "timeseries.h"
 #include "ui_analyze.h"
 
 class FITSViewer;
@@ -286,6 +287,11 @@ class Analyze : public QWidget, public Ui::Analyze
                     const double time, double startTime);
         void addTemperature(double temperature, const double time);
 
+        // Adds a sample to one of the statsPlot graphs.
+        void addStatsData(int graph, double time, double value);
+        // Loads the graphs with the decimated samples of the visible range.
+        void updateStatsGraphs();
+
         // Initialize the graphs (axes, linestyle, pen, name, checkbox callbacks).
         // Returns the graph index.
         int initGraph(QCustomPlot *plot, QCPAxis *yAxis, QCPGraph::LineStyle lineStyle,
@@ -334,9 +340,29 @@ class Analyze : public QWidget, public Ui::Analyze
         void resetMountFlipState();
         void resetTemperature();
 
+        // A line of a .analyze file, parsed and validated but not yet processed.
+        // Parsing is independent of Analyze's state, so it runs on several threads,
+        // while the processing that drives the state machines runs in file order.
+        struct LogLine
+        {
+            enum Type
+            {
+                INVALID, START_TIME, CAPTURE_STARTING, CAPTURE_COMPLETE, CAPTURE_ABORTED,
+                AUTOFOCUS_STARTING, AUTOFOCUS_COMPLETE, AUTOFOCUS_ABORTED, GUIDE_STATE,
+                GUIDE_STATS, TEMPERATURE, MOUNT_STATE, MOUNT_COORDS, ALIGN_STATE, MOUNT_FLIP_STATE
+            };
+            Type type { INVALID };
+            double time { 0 };
+            // The numeric and text fields of the message, in file order.
+            double numbers[7] { 0, 0, 0, 0, 0, 0, 0 };
+            QStringList strings;
+        };
+
         // Read and display an input .analyze file.
         double readDataFromFile(const QString &filename);
         double processInputLine(const QString &line);
+        static LogLine parseInputLine(const QString &line);
+        double processLogLine(const LogLine &line);
 
         // Opens a FITS file for viewing.
         void displayFITS(const QString &filename);
@@ -378,6 +404,18 @@ class Analyze : public QWidget, public Ui::Analyze
         std::unique_ptr<RmsFilter> guiderRms;
         std::unique_ptr<RmsFilter> captureRms;
 
+        // Full resolution samples of the statsPlot graphs, indexed like the graphs.
+        // The graphs themselves only hold what is drawn, see updateStatsGraphs().
+        QVector<TimeSeries> statsData;
+        // What each graph was last loaded with, so unchanged graphs are skipped.
+        struct StatsGraphState
+        {
+            quint64 revision;
+            double start, end;
+            int pixels;
+        };
+        QVector<StatsGraphState> statsGraphStates;
+
         // Y-axes for the for several plots where we rescale based on data.
         // QCustomPlot owns these pointers' memory, don't free it.
         QCPAxis *snrAxis;
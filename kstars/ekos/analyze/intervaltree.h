@@ -0,0 +1,110 @@
+/*  Ekos Analyze interval tree
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#pragma once
+
+#include <QList>
+#include <QVector>
+
+#include <algorithm>
+#include <limits>
+
+namespace Ekos
+{
+
+/**
+ * @class IntervalTree
+ * @short Finds the intervals that contain a given time.
+ *
+ * The intervals are kept sorted by start time, and an implicit balanced binary
+ * tree is laid over that array: the node for the range [lo, hi) is the middle
+ * element, and it records the latest end time in its range. A query only
+ * descends into subtrees that can contain a match, so it costs O(log n + k)
+ * for k matches, instead of scanning every session of a multi-night log.
+ *
+ * Sessions are mostly added in time order, so the sort is usually a no-op.
+ * The tree is rebuilt on the first query after new intervals were added.
+ *
+ * T must have public double members start and end.
+ */
+template <class T>
+class IntervalTree
+{
+    public:
+        void add(const T &value)
+        {
+            if (!intervals.isEmpty() && value.start < intervals.last().start)
+                sorted = false;
+            intervals.append(value);
+            dirty = true;
+        }
+        void clear()
+        {
+            intervals.clear();
+            maxEnd.clear();
+            sorted = true;
+            dirty = false;
+        }
+        int size() const
+        {
+            return intervals.size();
+        }
+        // Returns the intervals with start <= t <= end, ordered by start time.
+        QList<T> find(double t)
+        {
+            if (dirty)
+                build();
+            QList<T> result;
+            find(0, intervals.size(), t, result);
+            return result;
+        }
+
+    private:
+        void build()
+        {
+            if (!sorted)
+                std::stable_sort(intervals.begin(), intervals.end(),
+                                 [](const T & a, const T & b) { return a.start < b.start; });
+            sorted = true;
+            maxEnd.resize(intervals.size());
+            build(0, intervals.size());
+            dirty = false;
+        }
+        double build(int lo, int hi)
+        {
+            if (lo >= hi)
+                return std::numeric_limits<double>::lowest();
+            const int mid = lo + (hi - lo) / 2;
+            maxEnd[mid] = std::max({intervals[mid].end, build(lo, mid), build(mid + 1, hi)});
+            return maxEnd[mid];
+        }
+        void find(int lo, int hi, double t, QList<T> &result) const
+        {
+            if (lo >= hi)
+                return;
+            const int mid = lo + (hi - lo) / 2;
+            // Nothing in this subtree ends late enough.
+            if (maxEnd[mid] < t)
+                return;
+            find(lo, mid, t, result);
+            // Everything from mid on starts after t.
+            if (intervals[mid].start > t)
+                return;
+            if (t <= intervals[mid].end)
+                result.push_back(intervals[mid]);
+            find(mid + 1, hi, t, result);
+        }
+
+        QVector<T> intervals;
+        QVector<double> maxEnd;
+        bool sorted { true };
+        bool dirty { false };
+};
+
+}  // namespace Ekos
@@ -0,0 +1,123 @@
+/*  Ekos Analyze time series
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "timeseries.h"
+
+#include <QtGlobal>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Ekos
+{
+
+void TimeSeries::append(double time, double value)
+{
+    if (times.isEmpty() || time >= times.last())
+    {
+        times.append(time);
+        values.append(value);
+    }
+    else
+    {
+        const int index = std::upper_bound(times.cbegin(), times.cend(), time) - times.cbegin();
+        times.insert(index, time);
+        values.insert(index, value);
+    }
+    rev++;
+}
+
+void TimeSeries::clear()
+{
+    times.clear();
+    values.clear();
+    rev++;
+}
+
+int TimeSeries::findBegin(double time) const
+{
+    const int index = std::lower_bound(times.cbegin(), times.cend(), time) - times.cbegin();
+    return std::max(0, index - 1);
+}
+
+int TimeSeries::findEnd(double time) const
+{
+    const int index = std::upper_bound(times.cbegin(), times.cend(), time) - times.cbegin();
+    return std::min(times.size(), index + 1);
+}
+
+void TimeSeries::decimate(double start, double end, int pixels,
+                          QVector<double> *keys, QVector<double> *vals) const
+{
+    keys->clear();
+    vals->clear();
+
+    const int first = findBegin(start);
+    const int last = findEnd(end);
+    if (first >= last)
+        return;
+
+    // Few enough samples, draw them all.
+    pixels = std::max(1, pixels);
+    if (last - first <= 4 * pixels)
+    {
+        keys->reserve(last - first);
+        vals->reserve(last - first);
+        for (int i = first; i < last; ++i)
+        {
+            keys->append(times[i]);
+            vals->append(values[i]);
+        }
+        return;
+    }
+
+    keys->reserve(5 * pixels + 2);
+    vals->reserve(5 * pixels + 2);
+
+    const double columnWidth = (end - start) / pixels;
+    int i = first;
+    while (i < last)
+    {
+        // The samples of the pixel column that holds sample i.
+        const int column = static_cast<int>(std::floor((times[i] - start) / columnWidth));
+        const double columnEnd = start + (column + 1) * columnWidth;
+        int j = i;
+        int minIndex = -1, maxIndex = -1, nanIndex = -1;
+        for (; j < last && (times[j] < columnEnd || j == i); ++j)
+        {
+            const double v = values[j];
+            if (qIsNaN(v))
+            {
+                if (nanIndex < 0)
+                    nanIndex = j;
+                continue;
+            }
+            if (minIndex < 0 || v < values[minIndex])
+                minIndex = j;
+            if (maxIndex < 0 || v > values[maxIndex])
+                maxIndex = j;
+        }
+
+        // Keep the column's samples in time order.
+        int picks[5] = { i, minIndex, maxIndex, nanIndex, j - 1 };
+        std::sort(std::begin(picks), std::end(picks));
+        int previous = -1;
+        for (int pick : picks)
+        {
+            if (pick < 0 || pick == previous)
+                continue;
+            keys->append(times[pick]);
+            vals->append(values[pick]);
+            previous = pick;
+        }
+        i = j;
+    }
+}
+
+}  // namespace Ekos
@@ -0,0 +1,78 @@
+/*  Ekos Analyze time series
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#pragma once
+
+#include <QVector>
+
+namespace Ekos
+{
+
+/**
+ * @class TimeSeries
+ * @short Columnar storage for one of the Analyze stats graphs.
+ *
+ * Times and values live in two flat arrays sorted by time, which is compact
+ * for the hundreds of thousands of guide samples of a multi-night log.
+ * NaN values mark gaps, where the graph line must be broken.
+ *
+ * The plot does not draw the full series. decimate() reduces the visible range
+ * to a few samples per pixel column: the first, lowest, highest and last
+ * samples of each column, plus a NaN if the column holds a gap. The drawn
+ * line then looks exactly the same as with every sample.
+ */
+class TimeSeries
+{
+    public:
+        // Appends a sample. Out-of-order samples are inserted at their place.
+        void append(double time, double value);
+        void clear();
+
+        int size() const
+        {
+            return times.size();
+        }
+        bool isEmpty() const
+        {
+            return times.isEmpty();
+        }
+        double time(int index) const
+        {
+            return times[index];
+        }
+        double value(int index) const
+        {
+            return values[index];
+        }
+
+        // Incremented on each change, so users can tell if their copy is stale.
+        quint64 revision() const
+        {
+            return rev;
+        }
+
+        // Same conventions as QCPDataContainer::findBegin/findEnd with expandedRange:
+        // findBegin returns the index of the last sample before time (or 0),
+        // findEnd the index one past the first sample after time (or size()).
+        int findBegin(double time) const;
+        int findEnd(double time) const;
+
+        // Fills keys and vals with the samples to draw between start and end
+        // on a plot that is pixels wide. One sample on each side of the range
+        // is included, so lines reach the edges of the plot.
+        void decimate(double start, double end, int pixels,
+                      QVector<double> *keys, QVector<double> *vals) const;
+
+    private:
+        QVector<double> times;
+        QVector<double> values;
+        quint64 rev { 0 };
+};
+
+}  // namespace Ekos
@@ -18,6 +18,8 @@
 #include "fitsviewer/fitsdata.h"
 #include "fitsviewer/fitsview.h"
 
+#include <QFileInfo>
+
 namespace Ekos
 {
 DarkLibrary *DarkLibrary::_DarkLibrary = nullptr;
@@ -44,6 +46,9 @@ DarkLibrary::DarkLibrary(QObject *parent) : QObject(parent)
 
     captureSubtractTimer.setInterval(1000);
     captureSubtractTimer.setSingleShot(true);
+
+    darkFiles.setMaxCost(DARK_CACHE_SIZE);
+    removeStaleRawFiles();
 }
 
 DarkLibrary::~DarkLibrary()
@@ -53,9 +58,27 @@ DarkLibrary::~DarkLibrary()
 void DarkLibrary::refreshFromDB()
 {
     KStarsData::Instance()->userdb()->GetAllDarkFrames(darkFrames);
+
+    // Frames may have been removed from the library
+    darkFiles.clear();
+    removeStaleRawFiles();
 }
 
-bool DarkLibrary::getDarkFrame(ISD::CCDChip *targetChip, double duration, QSharedPointer<FITSData> &darkData)
+void DarkLibrary::removeStaleRawFiles()
+{
+    QSet<QString> rawFiles;
+    for (auto &map : darkFrames)
+        rawFiles.insert(QFileInfo(MasterDark::rawFilename(map["filename"].toString())).fileName());
+
+    QDir darkDir(KSPaths::writableLocation(QStandardPaths::GenericDataLocation) + "darks");
+    for (const QString &oneFile : darkDir.entryList(QStringList("*.raw"), QDir::Files))
+    {
+        if (!rawFiles.contains(oneFile))
+            QFile::remove(darkDir.filePath(oneFile));
+    }
+}
+
+bool DarkLibrary::getDarkFrame(ISD::CCDChip *targetChip, double duration, QSharedPointer<MasterDark> &darkData)
 {
     for (auto &map : darkFrames)
     {
@@ -93,22 +116,20 @@ bool DarkLibrary::getDarkFrame(ISD::CCDChip *targetChip, double duration, QShare
 
                 if (darkFiles.contains(filename))
                 {
-                    darkData = darkFiles[filename];
+                    darkData = *darkFiles.object(filename);
                     return true;
                 }
 
-                // Finally we made it, let's put it in the hash
-                if (loadDarkFile(filename))
-                {
-                    darkData = darkFiles[filename];
+                // Finally we made it, let's put it in the cache
+                if (loadDarkFile(filename, darkData))
                     return true;
-                }
                 else
                 {
                     // Remove bad dark frame
                     emit newLog(i18n("Removing bad dark frame file %1", filename));
                     darkFiles.remove(filename);
                     QFile::remove(filename);
+                    QFile::remove(MasterDark::rawFilename(filename));
                     KStarsData::Instance()->userdb()->DeleteDarkFrame(filename);
                     return false;
                 }
@@ -119,15 +140,33 @@ bool DarkLibrary::getDarkFrame(ISD::CCDChip *targetChip, double duration, QShare
     return false;
 }
 
-bool DarkLibrary::loadDarkFile(const QString &filename)
+bool DarkLibrary::loadDarkFile(const QString &filename, QSharedPointer<MasterDark> &masterDark)
 {
+    // The raw copy written the first time the file was loaded is mapped instead
+    masterDark = MasterDark::map(filename);
+    if (masterDark)
+    {
+        cacheDarkFile(filename, masterDark);
+        return true;
+    }
+
     QSharedPointer<FITSData> darkData;
     darkData.reset(new FITSData(), &QObject::deleteLater);
 
     bool rc = darkData->loadFromFile(filename);
 
     if (rc)
-        darkFiles[filename] = darkData;
+    {
+        masterDark.reset(new MasterDark(darkData));
+        if (masterDark->writeRaw(filename))
+        {
+            // Mapped pixels can be dropped by the system under memory pressure, so prefer them
+            QSharedPointer<MasterDark> mappedDark = MasterDark::map(filename);
+            if (mappedDark)
+                masterDark = mappedDark;
+        }
+        cacheDarkFile(filename, masterDark);
+    }
     else
     {
         emit newLog(i18n("Failed to load dark frame file %1", filename));
@@ -136,6 +175,12 @@ bool DarkLibrary::loadDarkFile(const QString &filename)
     return rc;
 }
 
+void DarkLibrary::cacheDarkFile(const QString &filename, const QSharedPointer<MasterDark> &darkData)
+{
+    const int cost = static_cast<int>(qMax<qint64>(1, darkData->size() / 1024));
+    darkFiles.insert(filename, new QSharedPointer<MasterDark>(darkData), cost);
+}
+
 bool DarkLibrary::saveDarkFile(const QSharedPointer<FITSData> data)
 {
     // IS8601 contains colons but they are illegal under Windows OS, so replacing them with '-'
@@ -150,7 +195,9 @@ bool DarkLibrary::saveDarkFile(const QSharedPointer<FITSData> data)
         return false;
     }
 
-    darkFiles[path] = data;
+    QSharedPointer<MasterDark> masterDark(new MasterDark(data));
+    masterDark->writeRaw(path);
+    cacheDarkFile(path, masterDark);
 
     QVariantMap map;
     int binX, binY;
@@ -180,47 +227,10 @@ void DarkLibrary::subtract(const QSharedPointer<FITSData> &darkData, const QShar
                            FITSScale filter, uint16_t offsetX,
                            uint16_t offsetY)
 {
-    switch (darkData->getStatistics().dataType)
-    {
-        case TBYTE:
-            subtract<uint8_t>(darkData, lightData, filter, offsetX, offsetY);
-            break;
-
-        case TSHORT:
-            subtract<int16_t>(darkData, lightData, filter, offsetX, offsetY);
-            break;
-
-        case TUSHORT:
-            subtract<uint16_t>(darkData, lightData, filter, offsetX, offsetY);
-            break;
-
-        case TLONG:
-            subtract<int32_t>(darkData, lightData, filter, offsetX, offsetY);
-            break;
-
-        case TULONG:
-            subtract<uint32_t>(darkData, lightData, filter, offsetX, offsetY);
-            break;
-
-        case TFLOAT:
-            subtract<float>(darkData, lightData, filter, offsetX, offsetY);
-            break;
-
-        case TLONGLONG:
-            subtract<int64_t>(darkData, lightData, filter, offsetX, offsetY);
-            break;
-
-        case TDOUBLE:
-            subtract<double>(darkData, lightData, filter, offsetX, offsetY);
-            break;
-
-        default:
-            break;
-    }
+    subtract(QSharedPointer<MasterDark>(new MasterDark(darkData)), lightData, filter, offsetX, offsetY);
 }
 
-template <typename T>
-void DarkLibrary::subtract(const QSharedPointer<FITSData> &darkData, const QSharedPointer<FITSData> &lightData,
+void DarkLibrary::subtract(const QSharedPointer<MasterDark> &darkData, const QSharedPointer<FITSData> &lightData,
                            FITSScale filter, uint16_t offsetX, uint16_t offsetY)
 {
     // If telescope is covered, let's uncover it
@@ -282,39 +292,19 @@ void DarkLibrary::subtract(const QSharedPointer<FITSData> &darkData, const QShar
         return;
     }
 
-    T *lightBuffer = reinterpret_cast<T *>(lightData->getWritableImageBuffer());
-    int lightW      = lightData->width();
-    int lightH      = lightData->height();
-
-    int darkW      = darkData->width();
-    int darkoffset = offsetX + offsetY * darkW;
-    T const *darkBuffer  = reinterpret_cast<T const*>(darkData->getImageBuffer()) + darkoffset;
-
-    for (int i = 0; i < lightH; i++)
+    const int channels = qMin(lightData->channels(), darkData->channels());
+    if (darkData->dataType() != lightData->getStatistics().dataType ||
+            !darkData->subtract(lightData->getWritableImageBuffer(), lightData->width(), lightData->height(), channels,
+                                offsetX, offsetY))
     {
-        for (int j = 0; j < lightW; j++)
-            lightBuffer[j] = (lightBuffer[j] > darkBuffer[j]) ? (lightBuffer[j] - darkBuffer[j]) : 0;
-
-        lightBuffer += lightW;
-        darkBuffer += darkW;
+        emit newLog(i18n("Dark frame does not match the image, it was not subtracted."));
+        emit darkFrameCompleted(false);
+        return;
     }
 
-#if 0
-    int lightOffset = 0;
-    for (int i = 0; i < lightH; i++)
-    {
-        for (int j = 0; j < lightW; j++)
-        {
-            if (lightBuffer[j + lightOffset] > darkBuffer[j + darkoffset])
-                lightBuffer[j + lightOffset] -= darkBuffer[j + darkoffset];
-            else
-                lightBuffer[j + lightOffset] = 0;
-        }
-
-        lightOffset += lightW;
-        darkoffset += darkW;
-    }
-#endif
+    if (Options::darkHotPixels())
+        darkData->removeHotPixels(lightData->getWritableImageBuffer(), lightData->width(), lightData->height(), channels,
+                                  offsetX, offsetY, lightData->hasDebayer() ? 2 : 1);
 
     lightData->applyFilter(filter);
     if (filter == FITS_NONE)
@@ -329,7 +319,7 @@ void DarkLibrary::captureAndSubtract(ISD::CCDChip *targetChip, const QSharedPoin
                                      FITSScale filter, uint16_t offsetX, uint16_t offsetY)
 {
     // Check if we have valid dark data and then use it.
-    QSharedPointer<FITSData> darkData;
+    QSharedPointer<MasterDark> darkData;
     if (getDarkFrame(targetChip, duration, darkData))
     {
         subtractParams.targetChip  = targetChip;
@@ -11,7 +11,9 @@
 
 #include "indi/indiccd.h"
 #include "indi/indicap.h"
+#include "masterdark.h"
 
+#include <QCache>
 #include <QObject>
 
 namespace Ekos
@@ -31,9 +33,11 @@ class DarkLibrary : public QObject
     public:
         static DarkLibrary *Instance();
 
-        bool getDarkFrame(ISD::CCDChip *targetChip, double duration, QSharedPointer<FITSData> &darkData);
+        bool getDarkFrame(ISD::CCDChip *targetChip, double duration, QSharedPointer<MasterDark> &darkData);
         void subtract(const QSharedPointer<FITSData> &darkData, const QSharedPointer<FITSData> &lightData, FITSScale filter,
                       uint16_t offsetX, uint16_t offsetY);
+        void subtract(const QSharedPointer<MasterDark> &darkData, const QSharedPointer<FITSData> &lightData, FITSScale filter,
+                      uint16_t offsetX, uint16_t offsetY);
         // Return false if canceled. True if dark capture proceeds
         void captureAndSubtract(ISD::CCDChip *targetChip, const QSharedPointer<FITSData> &targetData, double duration,
                                 FITSScale filter, uint16_t offsetX, uint16_t offsetY);
@@ -57,15 +61,16 @@ class DarkLibrary : public QObject
 
         static DarkLibrary *_DarkLibrary;
 
-        bool loadDarkFile(const QString &filename);
+        bool loadDarkFile(const QString &filename, QSharedPointer<MasterDark> &masterDark);
         bool saveDarkFile(const QSharedPointer<FITSData> data);
-
-        template <typename T>
-        void subtract(const QSharedPointer<FITSData> &darkData, const QSharedPointer<FITSData> &lightData, FITSScale filter,
-                      uint16_t offsetX, uint16_t offsetY);
+        void cacheDarkFile(const QString &filename, const QSharedPointer<MasterDark> &darkData);
+        // Removes the raw copies of the dark frames that are no longer in the library.
+        void removeStaleRawFiles();
 
         QList<QVariantMap> darkFrames;
-        QHash<QString, QSharedPointer<FITSData>> darkFiles;
+        // Master darks by file name, a file being recorded for a camera, binning, duration and temperature.
+        // Cost is in kilobytes.
+        QCache<QString, QSharedPointer<MasterDark>> darkFiles;
 
         struct
         {
@@ -83,5 +88,8 @@ class DarkLibrary : public QObject
 
         QTimer captureSubtractTimer;
         ISD::DustCap *m_RemoteCap {nullptr};
+
+        // Memory used by the cached master darks, in kilobytes
+        static const int DARK_CACHE_SIZE = 1024 * 1024;
 };
 }
@@ -0,0 +1,373 @@
+/*  Ekos Master Dark
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "masterdark.h"
+
+#include "fitsviewer/fitsdata.h"
+
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Ekos
+{
+
+namespace
+{
+// "KSDK", followed by the format version
+const quint32 RawMagic = 0x4B53444B;
+const quint32 RawVersion = 1;
+// The pixels follow the header at this offset, aligned for any data type.
+const qint64 RawHeaderSize = 64;
+
+struct RawHeader
+{
+    quint32 magic;
+    quint32 version;
+    qint32 dataType;
+    qint32 width;
+    qint32 height;
+    qint32 channels;
+};
+
+// Rows subtracted by each task.
+const int bandRows = 64;
+// Frames smaller than this are subtracted on the calling thread.
+const qint64 parallelPixels = 1 << 18;
+
+int bytesPerPixel(int dataType)
+{
+    switch (dataType)
+    {
+        case TBYTE:
+            return 1;
+        case TSHORT:
+        case TUSHORT:
+            return 2;
+        case TLONG:
+        case TULONG:
+        case TFLOAT:
+            return 4;
+        case TLONGLONG:
+        case TDOUBLE:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+template <typename Function>
+void forEachBand(int height, qint64 pixels, Function function)
+{
+    if (pixels < parallelPixels)
+    {
+        for (int first = 0; first < height; first += bandRows)
+            function(first);
+        return;
+    }
+
+    QVector<int> bands;
+    for (int first = 0; first < height; first += bandRows)
+        bands.append(first);
+    QtConcurrent::blockingMap(bands, function);
+}
+
+template <typename T>
+void subtractDark(T *light, const T *dark, int width, int height, int channels, int darkWidth, int darkHeight,
+                  int offsetX, int offsetY)
+{
+    forEachBand(height, static_cast<qint64>(width) * height * channels, [ = ](int first)
+    {
+        const int last = std::min(height, first + bandRows);
+        for (int c = 0; c < channels; c++)
+        {
+            for (int y = first; y < last; y++)
+            {
+                T *l = light + (static_cast<qint64>(c) * height + y) * width;
+                const T *d = dark + (static_cast<qint64>(c) * darkHeight + y + offsetY) * darkWidth + offsetX;
+                // Branch free, so it is vectorized into saturated subtractions
+                for (int x = 0; x < width; x++)
+                    l[x] = l[x] - std::min(l[x], d[x]);
+            }
+        }
+    });
+}
+
+template <typename T>
+void findHotPixels(const T *dark, int width, int height, int channels, QVector<qint64> &hotPixels)
+{
+    const qint64 planeSize = static_cast<qint64>(width) * height;
+    for (int c = 0; c < channels; c++)
+    {
+        const T *plane = dark + c * planeSize;
+
+        double sum = 0, squares = 0;
+        for (qint64 i = 0; i < planeSize; i++)
+        {
+            sum += plane[i];
+            squares += static_cast<double>(plane[i]) * plane[i];
+        }
+        const double mean = sum / planeSize;
+        const double sigma = std::sqrt(std::max(0.0, squares / planeSize - mean * mean));
+        const double threshold = mean + MasterDark::HotPixelSigma * sigma;
+
+        for (qint64 i = 0; i < planeSize; i++)
+        {
+            if (plane[i] > threshold)
+                hotPixels.append(c * planeSize + i);
+        }
+    }
+}
+
+template <typename T>
+void replaceHotPixels(T *light, const QVector<qint64> &hotPixels, int width, int height, int darkWidth, int darkHeight,
+                      int channels, int offsetX, int offsetY, int step)
+{
+    const qint64 darkPlane = static_cast<qint64>(darkWidth) * darkHeight;
+    for (qint64 offset : hotPixels)
+    {
+        const int c = offset / darkPlane;
+        const int x = (offset % darkPlane) % darkWidth - offsetX;
+        const int y = (offset % darkPlane) / darkWidth - offsetY;
+        if (c >= channels || x < 0 || x >= width || y < 0 || y >= height)
+            continue;
+
+        T *plane = light + static_cast<qint64>(c) * width * height;
+        T neighbours[4];
+        int count = 0;
+        if (x >= step)
+            neighbours[count++] = plane[y * width + x - step];
+        if (x + step < width)
+            neighbours[count++] = plane[y * width + x + step];
+        if (y >= step)
+            neighbours[count++] = plane[(y - step) * width + x];
+        if (y + step < height)
+            neighbours[count++] = plane[(y + step) * width + x];
+        if (count == 0)
+            continue;
+
+        std::sort(neighbours, neighbours + count);
+        plane[y * width + x] = (count % 2) ? neighbours[count / 2] :
+                               static_cast<T>((static_cast<double>(neighbours[count / 2 - 1]) + neighbours[count / 2]) / 2);
+    }
+}
+}
+
+MasterDark::MasterDark(const QSharedPointer<FITSData> &data) : m_Data(data)
+{
+    m_DataType = data->getStatistics().dataType;
+    m_Width = data->width();
+    m_Height = data->height();
+    m_Channels = data->channels();
+    m_Pixels = data->getImageBuffer();
+}
+
+MasterDark::MasterDark(const QByteArray &pixels, int dataType, int width, int height, int channels) :
+    m_DataType(dataType), m_Width(width), m_Height(height), m_Channels(channels), m_Buffer(pixels)
+{
+    m_Pixels = reinterpret_cast<const uint8_t *>(m_Buffer.constData());
+}
+
+qint64 MasterDark::size() const
+{
+    return static_cast<qint64>(m_Width) * m_Height * m_Channels * bytesPerPixel(m_DataType);
+}
+
+QString MasterDark::rawFilename(const QString &filename)
+{
+    return filename + ".raw";
+}
+
+QSharedPointer<MasterDark> MasterDark::map(const QString &filename)
+{
+    const QFileInfo raw(rawFilename(filename));
+    if (!raw.exists() || raw.lastModified() < QFileInfo(filename).lastModified())
+        return QSharedPointer<MasterDark>();
+
+    QSharedPointer<MasterDark> dark(new MasterDark());
+    dark->m_Mapping.setFileName(raw.filePath());
+    if (!dark->m_Mapping.open(QIODevice::ReadOnly))
+        return QSharedPointer<MasterDark>();
+
+    RawHeader header;
+    if (dark->m_Mapping.read(reinterpret_cast<char *>(&header), sizeof(header)) != sizeof(header) ||
+            header.magic != RawMagic || header.version != RawVersion || header.width <= 0 || header.height <= 0 ||
+            header.channels <= 0 || bytesPerPixel(header.dataType) == 0)
+        return QSharedPointer<MasterDark>();
+
+    dark->m_DataType = header.dataType;
+    dark->m_Width = header.width;
+    dark->m_Height = header.height;
+    dark->m_Channels = header.channels;
+
+    if (dark->m_Mapping.size() != RawHeaderSize + dark->size())
+        return QSharedPointer<MasterDark>();
+
+    dark->m_Pixels = dark->m_Mapping.map(RawHeaderSize, dark->size());
+    if (dark->m_Pixels == nullptr)
+        return QSharedPointer<MasterDark>();
+
+    return dark;
+}
+
+bool MasterDark::writeRaw(const QString &filename) const
+{
+    QSaveFile file(rawFilename(filename));
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    RawHeader header { RawMagic, RawVersion, m_DataType, m_Width, m_Height, m_Channels };
+    QByteArray headerData(reinterpret_cast<const char *>(&header), sizeof(header));
+    headerData = headerData.leftJustified(RawHeaderSize, 0);
+
+    file.write(headerData);
+    file.write(reinterpret_cast<const char *>(m_Pixels), size());
+    return file.commit();
+}
+
+bool MasterDark::subtract(uint8_t *light, int width, int height, int channels, int offsetX, int offsetY) const
+{
+    if (offsetX < 0 || offsetY < 0 || offsetX + width > m_Width || offsetY + height > m_Height || channels > m_Channels)
+        return false;
+
+    switch (m_DataType)
+    {
+        case TBYTE:
+            subtractDark(light, m_Pixels, width, height, channels, m_Width, m_Height, offsetX, offsetY);
+            break;
+
+        case TSHORT:
+            subtractDark(reinterpret_cast<int16_t *>(light), reinterpret_cast<const int16_t *>(m_Pixels), width, height,
+                         channels, m_Width, m_Height, offsetX, offsetY);
+            break;
+
+        case TUSHORT:
+            subtractDark(reinterpret_cast<uint16_t *>(light), reinterpret_cast<const uint16_t *>(m_Pixels), width, height,
+                         channels, m_Width, m_Height, offsetX, offsetY);
+            break;
+
+        case TLONG:
+            subtractDark(reinterpret_cast<int32_t *>(light), reinterpret_cast<const int32_t *>(m_Pixels), width, height,
+                         channels, m_Width, m_Height, offsetX, offsetY);
+            break;
+
+        case TULONG:
+            subtractDark(reinterpret_cast<uint32_t *>(light), reinterpret_cast<const uint32_t *>(m_Pixels), width, height,
+                         channels, m_Width, m_Height, offsetX, offsetY);
+            break;
+
+        case TFLOAT:
+            subtractDark(reinterpret_cast<float *>(light), reinterpret_cast<const float *>(m_Pixels), width, height,
+                         channels, m_Width, m_Height, offsetX, offsetY);
+            break;
+
+        case TLONGLONG:
+            subtractDark(reinterpret_cast<int64_t *>(light), reinterpret_cast<const int64_t *>(m_Pixels), width, height,
+                         channels, m_Width, m_Height, offsetX, offsetY);
+            break;
+
+        case TDOUBLE:
+            subtractDark(reinterpret_cast<double *>(light), reinterpret_cast<const double *>(m_Pixels), width, height,
+                         channels, m_Width, m_Height, offsetX, offsetY);
+            break;
+
+        default:
+            return false;
+    }
+
+    return true;
+}
+
+const QVector<qint64> &MasterDark::hotPixels()
+{
+    if (m_HotPixelsFound)
+        return m_HotPixels;
+
+    m_HotPixelsFound = true;
+    switch (m_DataType)
+    {
+        case TBYTE:
+            findHotPixels(m_Pixels, m_Width, m_Height, m_Channels, m_HotPixels);
+            break;
+        case TSHORT:
+            findHotPixels(reinterpret_cast<const int16_t *>(m_Pixels), m_Width, m_Height, m_Channels, m_HotPixels);
+            break;
+        case TUSHORT:
+            findHotPixels(reinterpret_cast<const uint16_t *>(m_Pixels), m_Width, m_Height, m_Channels, m_HotPixels);
+            break;
+        case TLONG:
+            findHotPixels(reinterpret_cast<const int32_t *>(m_Pixels), m_Width, m_Height, m_Channels, m_HotPixels);
+            break;
+        case TULONG:
+            findHotPixels(reinterpret_cast<const uint32_t *>(m_Pixels), m_Width, m_Height, m_Channels, m_HotPixels);
+            break;
+        case TFLOAT:
+            findHotPixels(reinterpret_cast<const float *>(m_Pixels), m_Width, m_Height, m_Channels, m_HotPixels);
+            break;
+        case TLONGLONG:
+            findHotPixels(reinterpret_cast<const int64_t *>(m_Pixels), m_Width, m_Height, m_Channels, m_HotPixels);
+            break;
+        case TDOUBLE:
+            findHotPixels(reinterpret_cast<const double *>(m_Pixels), m_Width, m_Height, m_Channels, m_HotPixels);
+            break;
+        default:
+            break;
+    }
+
+    return m_HotPixels;
+}
+
+void MasterDark::removeHotPixels(uint8_t *light, int width, int height, int channels, int offsetX, int offsetY,
+                                 int step)
+{
+    const QVector<qint64> &hot = hotPixels();
+    if (hot.isEmpty())
+        return;
+
+    switch (m_DataType)
+    {
+        case TBYTE:
+            replaceHotPixels(light, hot, width, height, m_Width, m_Height, channels, offsetX, offsetY, step);
+            break;
+        case TSHORT:
+            replaceHotPixels(reinterpret_cast<int16_t *>(light), hot, width, height, m_Width, m_Height, channels, offsetX,
+                             offsetY, step);
+            break;
+        case TUSHORT:
+            replaceHotPixels(reinterpret_cast<uint16_t *>(light), hot, width, height, m_Width, m_Height, channels, offsetX,
+                             offsetY, step);
+            break;
+        case TLONG:
+            replaceHotPixels(reinterpret_cast<int32_t *>(light), hot, width, height, m_Width, m_Height, channels, offsetX,
+                             offsetY, step);
+            break;
+        case TULONG:
+            replaceHotPixels(reinterpret_cast<uint32_t *>(light), hot, width, height, m_Width, m_Height, channels, offsetX,
+                             offsetY, step);
+            break;
+        case TFLOAT:
+            replaceHotPixels(reinterpret_cast<float *>(light), hot, width, height, m_Width, m_Height, channels, offsetX,
+                             offsetY, step);
+            break;
+        case TLONGLONG:
+            replaceHotPixels(reinterpret_cast<int64_t *>(light), hot, width, height, m_Width, m_Height, channels, offsetX,
+                             offsetY, step);
+            break;
+        case TDOUBLE:
+            replaceHotPixels(reinterpret_cast<double *>(light), hot, width, height, m_Width, m_Height, channels, offsetX,
+                             offsetY, step);
+            break;
+        default:
+            break;
+    }
+}
+}
@@ -0,0 +1,107 @@
+/*  Ekos Master Dark
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QSharedPointer>
+#include <QVector>
+
+class FITSData;
+
+namespace Ekos
+{
+/**
+ * @class MasterDark
+ * @short Pixels of a master dark frame, ready to be subtracted from light frames.
+ *
+ * The pixels either belong to a loaded FITSData, or to a memory-mapped raw copy of
+ * the dark frame file. The raw copy holds the pixels as they are laid out in memory,
+ * so mapping it again skips reading the FITS file and computing its statistics, and
+ * its pages can be dropped by the system when memory runs low.
+ *
+ * Subtraction splits the frame in bands of rows, processed in parallel.
+ */
+class MasterDark
+{
+    public:
+        // Uses the pixels of a loaded frame, which is kept alive by the dark.
+        explicit MasterDark(const QSharedPointer<FITSData> &data);
+        // Uses a copy of the pixels, of the given FITS data type.
+        MasterDark(const QByteArray &pixels, int dataType, int width, int height, int channels = 1);
+
+        /**
+         * @brief map Map the raw copy of a dark frame file.
+         * @param filename the dark frame FITS file.
+         * @return the dark, or null if the raw copy is missing or older than the FITS file.
+         */
+        static QSharedPointer<MasterDark> map(const QString &filename);
+        // Writes the raw copy of the dark frame file, to be mapped next time.
+        bool writeRaw(const QString &filename) const;
+        static QString rawFilename(const QString &filename);
+
+        int dataType() const
+        {
+            return m_DataType;
+        }
+        int width() const
+        {
+            return m_Width;
+        }
+        int height() const
+        {
+            return m_Height;
+        }
+        int channels() const
+        {
+            return m_Channels;
+        }
+        // Size of the pixels, in bytes.
+        qint64 size() const;
+
+        /**
+         * @brief subtract Subtract the dark from a light frame, clamping the result at zero.
+         * @param light the pixels of the light frame, which must be of the same data type.
+         * @param offsetX,offsetY position of the light frame in the dark frame, for subframes.
+         * @return false if the light frame does not fit in the dark frame.
+         */
+        bool subtract(uint8_t *light, int width, int height, int channels, int offsetX, int offsetY) const;
+
+        /**
+         * @brief removeHotPixels Replace the pixels that are hot in the dark by the median of their neighbours.
+         * @param step distance to the neighbours, 2 to stay on the same color of a Bayer pattern.
+         * @note The hot pixels are looked for the first time this is called.
+         */
+        void removeHotPixels(uint8_t *light, int width, int height, int channels, int offsetX, int offsetY, int step = 1);
+
+        // Offsets of the hot pixels in the dark frame, found the first time they are needed.
+        const QVector<qint64> &hotPixels();
+
+        // Pixels brighter than the mean by this many standard deviations are hot.
+        static constexpr double HotPixelSigma { 5 };
+
+    private:
+        MasterDark() = default;
+
+        int m_DataType { 0 };
+        int m_Width { 0 };
+        int m_Height { 0 };
+        int m_Channels { 1 };
+        const uint8_t *m_Pixels { nullptr };
+
+        // Owners of the pixels, one of them.
+        QSharedPointer<FITSData> m_Data;
+        QByteArray m_Buffer;
+        QFile m_Mapping;
+
+        bool m_HotPixelsFound { false };
+        QVector<qint64> m_HotPixels;
+};
+}
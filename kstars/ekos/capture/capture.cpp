@@ -27,8 +27,11 @@
 #include "indi/driverinfo.h"
 #include "indi/indifilter.h"
 #include "indi/clientmanager.h"
+#include "indi/imagewritequeue.h"
 #include "oal/observeradd.h"
 
+#include <KFormat>
+
 #include <basedevice.h>
 
 #include <ekos_capture_debug.h>
@@ -77,6 +80,16 @@ Capture::Capture()
 
     dirPath = QUrl::fromLocalFile(QDir::homePath());
 
+    // Images are written in the background, show how far behind the disk is.
+    connect(ISD::ImageWriteQueue::Instance(), &ISD::ImageWriteQueue::statisticsChanged, this,
+            &Ekos::Capture::updateWriteQueue);
+    connect(ISD::ImageWriteQueue::Instance(), &ISD::ImageWriteQueue::writeFailed, this,
+            [this](const QString & filename, const QString & error)
+    {
+        appendLogText(i18n("Failed to save %1: %2", filename, error));
+    });
+    updateWriteQueue();
+
     //isAutoGuiding   = false;
 
     rotatorSettings.reset(new RotatorSettings(this));
@@ -2234,6 +2247,14 @@ void Capture::captureImage()
         return;
     }
 
+    // Let slow storage catch up rather than queue more images than the write queue may hold
+    if (ISD::ImageWriteQueue::Instance()->isFull())
+    {
+        secondsLabel->setText(i18n("Writing images..."));
+        QTimer::singleShot(1000, this, &Ekos::Capture::captureImage);
+        return;
+    }
+
     // Bail out if we have no CCD anymore
     if (currentCCD->isConnected() == false)
     {
@@ -4803,6 +4824,28 @@ int Capture::getPendingJobCount()
     return (jobs.count() - completedJobs);
 }
 
+int Capture::getWriteQueueDepth()
+{
+    return ISD::ImageWriteQueue::Instance()->statistics().depth;
+}
+
+double Capture::getWriteThroughput()
+{
+    return ISD::ImageWriteQueue::Instance()->statistics().bytesPerSecond;
+}
+
+void Capture::updateWriteQueue()
+{
+    const ISD::ImageWriteQueue::Statistics statistics = ISD::ImageWriteQueue::Instance()->statistics();
+
+    QString text = i18np("%1 image pending", "%1 images pending", statistics.depth);
+    if (statistics.bytesPerSecond > 0)
+        text += i18n(", %1/s", KFormat().formatByteSize(statistics.bytesPerSecond));
+    if (statistics.failed > 0)
+        text += i18np(", %1 failed", ", %1 failed", statistics.failed);
+    writeQueueOUT->setText(text);
+}
+
 QString Capture::getJobState(int id)
 {
     if (id < jobs.count())
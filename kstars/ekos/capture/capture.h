@@ -224,6 +224,16 @@ class Capture : public QWidget, public Ui::Capture
              */
         Q_SCRIPTABLE int getPendingJobCount();
 
+        /** DBUS interface function.
+             * @return Returns the number of captured images still waiting to be written to disk.
+             */
+        Q_SCRIPTABLE int getWriteQueueDepth();
+
+        /** DBUS interface function.
+             * @return Returns the recent write throughput of captured images, in bytes per second.
+             */
+        Q_SCRIPTABLE double getWriteThroughput();
+
         /** DBUS interface function.
              * @return Returns ID of current active job if any, or -1 if there are no active jobs.
              */
@@ -707,6 +717,7 @@ class Capture : public QWidget, public Ui::Capture
         void setDefaultCCD(QString ccd);
         void setDefaultFilterWheel(QString filterWheel);
         void setNewRemoteFile(QString file);
+        void updateWriteQueue();
 
         // Sequence Queue
         void loadSequenceQueue();
@@ -0,0 +1,186 @@
+/*  Ekos Live Client
+
+    Copyright (C) 2026 KStars Developers
+
+    Adaptive Image Encoder
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include "adaptiveencoder.h"
+
+#include <QBuffer>
+#include <QImageWriter>
+#include <QJsonDocument>
+
+namespace EkosLive
+{
+
+namespace
+{
+// Qualities to pick from, best first.
+const int qualitySteps[] = { 90, 75, 60, 45, 30 };
+// Starting compression ratios, typical of stretched astronomical images.
+const double initialBytesPerPixel[] = { 0.45, 0.28, 0.2, 0.15, 0.11 };
+// Lowest quality used before the image is narrowed.
+const int preferredMinQuality = 45;
+// A write that drains faster than this only tells the link is at least that fast.
+const qint64 minMeasureTime = 50;
+}
+
+AdaptiveEncoder::AdaptiveEncoder(Clock clock) : m_Clock(clock)
+{
+    if (!m_Clock)
+    {
+        m_Elapsed.start();
+        m_Clock = [this]()
+        {
+            return m_Elapsed.elapsed();
+        };
+    }
+
+    for (double bpp : initialBytesPerPixel)
+        m_BytesPerPixel.append(bpp);
+}
+
+void AdaptiveEncoder::messageQueued(qint64 bytes)
+{
+    QMutexLocker locker(&m_Mutex);
+
+    if (m_Pending == 0)
+    {
+        m_Written = 0;
+        m_Start = m_Clock();
+    }
+    m_Pending += bytes;
+}
+
+void AdaptiveEncoder::bytesWritten(qint64 bytes)
+{
+    QMutexLocker locker(&m_Mutex);
+
+    // Written bytes include the websocket framing, and text messages are not queued here.
+    if (m_Pending == 0 || m_Start < 0)
+        return;
+
+    m_Pending = qMax<qint64>(0, m_Pending - bytes);
+    m_Written += bytes;
+
+    if (m_Pending > 0)
+        return;
+
+    const qint64 elapsed = m_Clock() - m_Start;
+    const double rate = m_Written * 1000.0 / qMax(elapsed, minMeasureTime);
+
+    if (m_Throughput == 0)
+        m_Throughput = rate;
+    else if (elapsed >= minMeasureTime || rate > m_Throughput)
+        m_Throughput = 0.7 * m_Throughput + 0.3 * rate;
+}
+
+void AdaptiveEncoder::reset()
+{
+    QMutexLocker locker(&m_Mutex);
+
+    m_Throughput = 0;
+    m_Pending = m_Written = 0;
+    m_Start = -1;
+}
+
+double AdaptiveEncoder::throughput() const
+{
+    QMutexLocker locker(&m_Mutex);
+    return m_Throughput;
+}
+
+int AdaptiveEncoder::qualityStep(int quality)
+{
+    int step = 0;
+    for (int i = 1; i < static_cast<int>(sizeof(qualitySteps) / sizeof(qualitySteps[0])); i++)
+    {
+        if (qAbs(qualitySteps[i] - quality) < qAbs(qualitySteps[step] - quality))
+            step = i;
+    }
+    return step;
+}
+
+AdaptiveEncoder::Settings AdaptiveEncoder::settings(const QSize &size, int maxWidth, int maxQuality,
+        double seconds) const
+{
+    Settings best;
+    best.width = qMin(maxWidth, size.width());
+    best.quality = maxQuality;
+
+    QMutexLocker locker(&m_Mutex);
+
+    if (m_Throughput == 0 || size.isEmpty())
+        return best;
+
+    const double budget = m_Throughput * seconds;
+    const double aspect = static_cast<double>(size.height()) / size.width();
+
+    // Lower the quality first, then halve the width and try again.
+    for (int width = best.width; ; width /= 2)
+    {
+        const double pixels = width * width * aspect;
+        bool tried = false;
+        for (int step = 0; step < m_BytesPerPixel.size(); step++)
+        {
+            const int quality = qualitySteps[step];
+            if (quality > maxQuality)
+                continue;
+
+            if (quality < preferredMinQuality && tried && width / 2 >= MinWidth)
+                break;
+            tried = true;
+
+            if (pixels * m_BytesPerPixel[step] <= budget)
+            {
+                best.width = width;
+                best.quality = quality;
+                return best;
+            }
+        }
+
+        if (width / 2 < MinWidth)
+        {
+            // Nothing fits, send the smallest image.
+            best.width = width;
+            best.quality = qMin(maxQuality, qualitySteps[m_BytesPerPixel.size() - 1]);
+            return best;
+        }
+    }
+}
+
+QByteArray AdaptiveEncoder::encode(const QImage &image, const Settings &settings, const QJsonObject &metadata,
+                                   int headerSize)
+{
+    QByteArray data = QJsonDocument(metadata).toJson(QJsonDocument::Compact).leftJustified(headerSize, 0);
+
+    const QImage scaledImage = (settings.width > 0 && settings.width < image.width()) ?
+                               image.scaledToWidth(settings.width, settings.transformation) : image;
+
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly | QIODevice::Append);
+    QImageWriter writer(&buffer, "jpg");
+    writer.setQuality(settings.quality);
+    writer.write(scaledImage);
+    buffer.close();
+
+    const double pixels = static_cast<double>(scaledImage.width()) * scaledImage.height();
+    if (pixels > 0)
+    {
+        const int step = qualityStep(settings.quality);
+        const double bpp = (data.size() - headerSize) / pixels;
+
+        QMutexLocker locker(&m_Mutex);
+        m_BytesPerPixel[step] = 0.5 * m_BytesPerPixel[step] + 0.5 * bpp;
+    }
+
+    return data;
+}
+
+}
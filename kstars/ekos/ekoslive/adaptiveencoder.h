@@ -0,0 +1,102 @@
+/*  Ekos Live Client
+
+    Copyright (C) 2026 KStars Developers
+
+    Adaptive Image Encoder
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QImage>
+#include <QJsonObject>
+#include <QMutex>
+#include <QVector>
+
+#include <functional>
+
+namespace EkosLive
+{
+/**
+ * @brief Sizes the JPEG images sent to the client after the measured throughput of the link.
+ *
+ * The throughput is measured from how fast the websocket writes out the binary messages
+ * queued on it. Given a delivery time, the widest image at the best quality that is
+ * expected to fit is then picked, predicting the size of the JPEG from the compression
+ * ratios of the previous images.
+ *
+ * The throughput is measured on the GUI thread while images are encoded on worker
+ * threads, so all the functions may be called from any thread.
+ */
+class AdaptiveEncoder
+{
+    public:
+        struct Settings
+        {
+            int width { 0 };
+            int quality { 0 };
+            Qt::TransformationMode transformation { Qt::SmoothTransformation };
+        };
+
+        // Milliseconds elapsed on a monotonic clock.
+        typedef std::function<qint64()> Clock;
+
+        // The throughput is measured with the given clock, or with a QElapsedTimer by default.
+        explicit AdaptiveEncoder(Clock clock = Clock());
+
+        // Call when a binary message is queued on the socket, and when the socket wrote bytes.
+        void messageQueued(qint64 bytes);
+        void bytesWritten(qint64 bytes);
+        // Forgets the throughput, e.g. on a new connection.
+        void reset();
+
+        // Bytes per second, or 0 until measured.
+        double throughput() const;
+
+        /**
+         * @brief settings Pick the width and quality of an image.
+         * @param size size of the source image. It is never upscaled.
+         * @param maxWidth widest image to send.
+         * @param maxQuality best JPEG quality to use.
+         * @param seconds time in which the image should be transferred.
+         * @return the widest image at the best quality that fits. Until the throughput is
+         * measured, maxWidth and maxQuality.
+         */
+        Settings settings(const QSize &size, int maxWidth, int maxQuality, double seconds) const;
+
+        /**
+         * @brief encode Scale the image and encode it as JPEG, after its metadata.
+         * @param metadata written as compact JSON, padded with zeros to headerSize bytes.
+         * @return the metadata followed by the JPEG data.
+         */
+        QByteArray encode(const QImage &image, const Settings &settings, const QJsonObject &metadata, int headerSize);
+
+        // Narrowest image picked when the link is slow.
+        static constexpr int MinWidth { 160 };
+
+    private:
+        // Index of the quality step closest to quality.
+        static int qualityStep(int quality);
+
+        mutable QMutex m_Mutex;
+
+        QElapsedTimer m_Elapsed;
+        Clock m_Clock;
+
+        double m_Throughput { 0 };
+        // Bytes queued on the socket and not written yet.
+        qint64 m_Pending { 0 };
+        // Bytes written since the measure started.
+        qint64 m_Written { 0 };
+        // Clock time when the measure started, or -1.
+        qint64 m_Start { -1 };
+
+        // Compressed bytes per pixel, for each quality step.
+        QVector<double> m_BytesPerPixel;
+};
+}
@@ -157,10 +157,16 @@ enum COMMANDS
     OPTION_SET_IMAGE_TRANSFER,
     OPTION_SET_NOTIFICATIONS,
     OPTION_SET_CLOUD_STORAGE,
+    OPTION_SET_PROPERTY_DELTAS,
+    OPTION_SET_BINARY_PROPERTIES,
+    OPTION_SET_PROGRESSIVE_IMAGES,
 
     // Storage Options
     SET_BLOBS,
 
+    // Media
+    IMAGE_GET_TILE,
+
     // DSLRs
     DSLR_GET_INFO,
     DSLR_SET_INFO,
@@ -176,6 +182,7 @@ enum COMMANDS
     DEVICE_PROPERTY_REMOVE,
     DEVICE_PROPERTY_SUBSCRIBE,
     DEVICE_PROPERTY_UNSUBSCRIBE,
+    DEVICE_PROPERTY_BATCH,
 
     // Dialogs
     DIALOG_GET_INFO,
@@ -316,9 +323,14 @@ static QMap<COMMANDS, QString> const commands =
     {OPTION_SET_IMAGE_TRANSFER, "option_set_image_transfer"},
     {OPTION_SET_NOTIFICATIONS, "option_set_notifications"},
     {OPTION_SET_CLOUD_STORAGE, "option_set_cloud_storage"},
+    {OPTION_SET_PROPERTY_DELTAS, "option_set_property_deltas"},
+    {OPTION_SET_BINARY_PROPERTIES, "option_set_binary_properties"},
+    {OPTION_SET_PROGRESSIVE_IMAGES, "option_set_progressive_images"},
 
     {SET_BLOBS, "set_blobs"},
 
+    {IMAGE_GET_TILE, "image_get_tile"},
+
     {DSLR_GET_INFO, "dslr_get_info"},
     {DSLR_SET_INFO, "dslr_set_info"},
     {DSLR_SET_MODE, "dslr_set_mode"},
@@ -332,6 +344,7 @@ static QMap<COMMANDS, QString> const commands =
     {DEVICE_PROPERTY_REMOVE, "device_property_remove"},
     {DEVICE_PROPERTY_SUBSCRIBE, "device_property_subscribe"},
     {DEVICE_PROPERTY_UNSUBSCRIBE, "device_property_unsubscribe"},
+    {DEVICE_PROPERTY_BATCH, "device_property_batch"},
 
     {DIALOG_GET_INFO, "dialog_get_info"},
     {DIALOG_GET_RESPONSE, "dialog_get_response"},
@@ -20,6 +20,7 @@
 #include "ekos_debug.h"
 
 #include <QtConcurrent>
+#include <QJsonArray>
 #include <KFormat>
 
 namespace EkosLive
@@ -32,8 +33,15 @@ Media::Media(Ekos::Manager * manager): m_Manager(manager)
     connect(&m_WebSocket, static_cast<void(QWebSocket::*)(QAbstractSocket::SocketError)>(&QWebSocket::error), this,
             &Media::onError);
 
+    connect(&m_WebSocket, &QWebSocket::bytesWritten, this, [this](qint64 bytes)
+    {
+        m_Encoder.bytesWritten(bytes);
+    });
+
     connect(this, &Media::newMetadata, this, &Media::uploadMetadata);
     connect(this, &Media::newImage, this, &Media::uploadImage);
+
+    connect(&m_FrameWatcher, &QFutureWatcher<void>::finished, this, &Media::onFrameEncoded);
 }
 
 void Media::connectServer()
@@ -76,6 +84,7 @@ void Media::onConnected()
 
     m_isConnected = true;
     m_ReconnectTries = 0;
+    m_Encoder.reset();
 
     emit connected();
 }
@@ -90,6 +99,12 @@ void Media::onDisconnected()
 
     m_sendBlobs = true;
 
+    {
+        QMutexLocker locker(&m_ImageMutex);
+        m_LastImage = QImage();
+        m_LastUUID.clear();
+    }
+
     for (const QString &oneFile : temporaryFiles)
         QFile::remove(oneFile);
     temporaryFiles.clear();
@@ -127,6 +142,23 @@ void Media::onTextReceived(const QString &message)
         extension = payload["ext"].toString();
     else if (command == commands[SET_BLOBS])
         m_sendBlobs = msgObj["payload"].toBool();
+    // Region of the last image, in its own pixels, to send at up to max_width
+    else if (command == commands[IMAGE_GET_TILE])
+    {
+        QImage image;
+        QString uuid;
+        {
+            QMutexLocker locker(&m_ImageMutex);
+            image = m_LastImage;
+            uuid = m_LastUUID;
+        }
+
+        if (image.isNull() || payload["uuid"].toString() != uuid)
+            return;
+
+        const QRect region(payload["x"].toInt(), payload["y"].toInt(), payload["width"].toInt(), payload["height"].toInt());
+        QtConcurrent::run(this, &Media::sendTile, image, uuid, region, payload["max_width"].toInt(HB_WIDTH));
+    }
 }
 
 void Media::onBinaryReceived(const QByteArray &message)
@@ -195,23 +227,11 @@ void Media::sendPreviewImage(FITSView * view, const QString &uuid)
 
 void Media::sendImage()
 {
-    QtConcurrent::run(this, &Media::upload, previewImage.get());
+    upload(previewImage.get());
 }
 
-void Media::upload(FITSView * view)
+QJsonObject Media::imageMetadata(const FITSData * imageData) const
 {
-    QString ext = "jpg";
-    QByteArray jpegData;
-    QBuffer buffer(&jpegData);
-    buffer.open(QIODevice::WriteOnly);
-
-    //    QString uuid;
-    //    // Only send UUID for non-temporary compressed file or non-tempeorary files
-    //    if  ( (imageData->isCompressed() && imageData->compressedFilename().startsWith(QDir::tempPath()) == false) ||
-    //            (imageData->isTempFile() == false))
-    //        uuid = m_UUID;
-
-    const FITSData * imageData = view->getImageData();
     QString resolution = QString("%1x%2").arg(imageData->width()).arg(imageData->height());
     QString sizeBytes = KFormat().formatByteSize(imageData->size());
     QVariant xbin(1), ybin(1), exposure(0), focal_length(0), gain(0), pixel_size(0), aperture(0);
@@ -238,116 +258,162 @@ void Media::upload(FITSView * view)
         {"aperture", aperture.toString()},
         {"gain", gain.toString()},
         {"pixel_size", QString::number(binned_pixel, 'f', 4)},
-        {"ext", ext}
+        {"ext", "jpg"}
     };
 
-    // First METADATA_PACKET bytes of the binary data is always allocated
-    // to the metadata
-    // the rest to the image data.
-    QByteArray meta = QJsonDocument(metadata).toJson(QJsonDocument::Compact);
-    meta = meta.leftJustified(METADATA_PACKET, 0);
-    buffer.write(meta);
+    return metadata;
+}
 
-    // For low bandwidth images
-    if (!m_Options[OPTION_SET_HIGH_BANDWIDTH] || m_UUID[0] == "+")
+void Media::upload(FITSView * view)
+{
+    //    QString uuid;
+    //    // Only send UUID for non-temporary compressed file or non-tempeorary files
+    //    if  ( (imageData->isCompressed() && imageData->compressedFilename().startsWith(QDir::tempPath()) == false) ||
+    //            (imageData->isTempFile() == false))
+    //        uuid = m_UUID;
+
+    const QJsonObject metadata = imageMetadata(view->getImageData());
+    const bool lowBandwidth = !m_Options[OPTION_SET_HIGH_BANDWIDTH] || m_UUID[0] == "+";
+    // Module frames are replaced too often to be worth browsing.
+    const bool progressive = m_Options[OPTION_SET_PROGRESSIVE_IMAGES] && m_UUID[0] != "+";
+    // The view and its image data belong to the GUI thread, only the stretched image is handed over.
+    // Large images are still being stretched in the background, so wait for them on the worker.
+    const QFuture<QImage> image = view->getDisplayImageFuture();
+
+    if (view == previewImage.get())
     {
-        QPixmap scaledImage = view->getDisplayPixmap().scaledToWidth(HB_WIDTH / 2, Qt::FastTransformation);
-        scaledImage.save(&buffer, ext.toLatin1().constData(), HB_IMAGE_QUALITY / 2);
-        //ext = "jpg";
+        // Dropping the view would stop its stretch, so only drop it once its image is ready.
+        FITSView *preview = previewImage.release();
+        QFutureWatcher<QImage> *watcher = new QFutureWatcher<QImage>(preview);
+        connect(watcher, &QFutureWatcher<QImage>::finished, preview, &QObject::deleteLater);
+        watcher->setFuture(image);
     }
-    // For high bandwidth images
-    else
+
+    // Scaling and encoding are left to a worker thread.
+    QtConcurrent::run([this, image, metadata, lowBandwidth, progressive]()
     {
-        QImage scaledImage = view->getDisplayImage().scaledToWidth(HB_WIDTH, Qt::SmoothTransformation);
-        scaledImage.save(&buffer, ext.toLatin1().constData(), HB_IMAGE_QUALITY);
-        //ext = "png";
-    }
-    buffer.close();
+        deliverImage(image.result(), metadata, lowBandwidth, progressive);
+    });
+}
 
-    emit newImage(jpegData);
+void Media::deliverImage(const QImage &image, const QJsonObject &metadata, bool lowBandwidth, bool progressive)
+{
+    // The view was given a new image before this one was stretched.
+    if (image.isNull())
+        return;
 
-    //m_WebSocket.sendTextMessage(QJsonDocument(metadata).toJson(QJsonDocument::Compact));
-    //m_WebSocket.sendBinaryMessage(jpegData);
+    // The first METADATA_PACKET bytes of the binary data are always allocated
+    // to the metadata, the rest to the image data.
+    if (progressive)
+    {
+        {
+            QMutexLocker locker(&m_ImageMutex);
+            m_LastImage = image;
+            m_LastUUID = metadata["uuid"].toString();
+        }
+
+        // A thumbnail first, so the client has something to show while the preview is on its way.
+        AdaptiveEncoder::Settings thumbnail = m_Encoder.settings(image.size(), THUMBNAIL_WIDTH, THUMBNAIL_IMAGE_QUALITY,
+                                              THUMBNAIL_DELIVERY_TIME / 1000.0);
+        thumbnail.transformation = Qt::FastTransformation;
+        QJsonObject thumbnailMetadata = metadata;
+        thumbnailMetadata.insert("thumbnail", true);
+        emit newImage(m_Encoder.encode(image, thumbnail, thumbnailMetadata, METADATA_PACKET));
+    }
 
-    if (view == previewImage.get())
-        previewImage.reset();
+    AdaptiveEncoder::Settings preview = m_Encoder.settings(image.size(), lowBandwidth ? HB_WIDTH / 2 : HB_WIDTH,
+                                        lowBandwidth ? HB_IMAGE_QUALITY / 2 : HB_IMAGE_QUALITY,
+                                        PREVIEW_DELIVERY_TIME / 1000.0);
+    if (lowBandwidth)
+        preview.transformation = Qt::FastTransformation;
+    emit newImage(m_Encoder.encode(image, preview, metadata, METADATA_PACKET));
 }
 
-void Media::sendUpdatedFrame(FITSView *view)
+void Media::sendTile(const QImage &image, const QString &uuid, const QRect &region, int maxWidth)
 {
-    QString ext = "jpg";
-    QByteArray jpegData;
-    QBuffer buffer(&jpegData);
-    buffer.open(QIODevice::WriteOnly);
-
-    const FITSData * imageData = view->getImageData();
-
-    if (!imageData)
+    const QRect tile = region.intersected(image.rect());
+    if (tile.isEmpty())
         return;
 
-    QString resolution = QString("%1x%2").arg(imageData->width()).arg(imageData->height());
-    QString sizeBytes = KFormat().formatByteSize(imageData->size());
-    QVariant xbin(1), ybin(1), exposure(0), focal_length(0), gain(0), pixel_size(0), aperture(0);
-    imageData->getRecordValue("XBINNING", xbin);
-    imageData->getRecordValue("YBINNING", ybin);
-    imageData->getRecordValue("EXPTIME", exposure);
-    imageData->getRecordValue("GAIN", gain);
-    imageData->getRecordValue("PIXSIZE1", pixel_size);
-    imageData->getRecordValue("FOCALLEN", focal_length);
-    imageData->getRecordValue("APTDIA", aperture);
+    const QImage tileImage = image.copy(tile);
+    const int width = qBound(static_cast<int>(THUMBNAIL_WIDTH), maxWidth, HB_WIDTH * 2);
+    const AdaptiveEncoder::Settings settings = m_Encoder.settings(tileImage.size(), width, HB_IMAGE_QUALITY,
+            TILE_DELIVERY_TIME / 1000.0);
 
-    // Account for binning
-    const double binned_pixel = pixel_size.toDouble() * xbin.toInt();
-    // Send everything as strings
     QJsonObject metadata =
     {
-        {"resolution", resolution},
-        {"size", sizeBytes},
-        {"bin", QString("%1x%2").arg(xbin.toString()).arg(ybin.toString())},
-        {"bpp", QString::number(imageData->bpp())},
-        {"uuid", m_UUID},
-        {"exposure", exposure.toString()},
-        {"focal_length", focal_length.toString()},
-        {"aperture", aperture.toString()},
-        {"gain", gain.toString()},
-        {"pixel_size", QString::number(binned_pixel, 'f', 4)},
-        {"ext", ext}
+        {"uuid", uuid},
+        {"region", QJsonArray{tile.x(), tile.y(), tile.width(), tile.height()}},
+        {"resolution", QString("%1x%2").arg(settings.width).arg(tile.height() * settings.width / tile.width())},
+        {"ext", "jpg"}
     };
 
-    // First METADATA_PACKET bytes of the binary data is always allocated
-    // to the metadata
-    // the rest to the image data.
-    QByteArray meta = QJsonDocument(metadata).toJson(QJsonDocument::Compact);
-    meta = meta.leftJustified(METADATA_PACKET, 0);
-    buffer.write(meta);
+    emit newImage(m_Encoder.encode(tileImage, settings, metadata, METADATA_PACKET));
+}
+
+void Media::sendUpdatedFrame(FITSView *view)
+{
+    const FITSData * imageData = view->getImageData();
+
+    if (!imageData)
+        return;
+
+    const QJsonObject metadata = imageMetadata(imageData);
 
     // For low bandwidth images
-    QPixmap scaledImage;
+    QImage frame;
+    int maxWidth = HB_WIDTH / 2;
     // Align images
     if (correctionVector.isNull() == false)
     {
-        scaledImage = view->getDisplayPixmap();
+        const QPixmap &displayPixmap = view->getDisplayPixmap();
         QPointF center = 0.5 * correctionVector.p1() + 0.5 * correctionVector.p2();
         uint32_t length = qMax(static_cast<uint32_t>(correctionVector.length()), 100u);
         QRect boundingRectable;
         boundingRectable.setSize(QSize(length * 2, length * 2));
         QPoint topLeft = (center - QPointF(length, length)).toPoint();
         boundingRectable.moveTo(topLeft);
-        boundingRectable = boundingRectable.intersected(scaledImage.rect());
+        boundingRectable = boundingRectable.intersected(displayPixmap.rect());
 
-        emit newBoundingRect(boundingRectable, scaledImage.size());
+        emit newBoundingRect(boundingRectable, displayPixmap.size());
 
-        scaledImage = scaledImage.copy(boundingRectable);
+        frame = displayPixmap.copy(boundingRectable).toImage();
+        maxWidth = frame.width();
     }
     else
     {
-        scaledImage = view->getDisplayPixmap().scaledToWidth(HB_WIDTH / 2, Qt::FastTransformation);
+        frame = view->getDisplayPixmap().toImage();
         emit newBoundingRect(QRect(), QSize());
     }
 
-    scaledImage.save(&buffer, ext.toLatin1().constData(), HB_IMAGE_QUALITY);
-    buffer.close();
-    emit newImage(jpegData);
+    // Frames may come faster than they are encoded, then only the latest one is sent.
+    if (m_FrameWatcher.isRunning())
+    {
+        m_PendingFrame = frame;
+        m_PendingFrameMetadata = metadata;
+        m_PendingFrameWidth = maxWidth;
+        return;
+    }
+
+    m_FrameWatcher.setFuture(QtConcurrent::run(this, &Media::encodeFrame, frame, metadata, maxWidth));
+}
+
+void Media::onFrameEncoded()
+{
+    if (m_PendingFrame.isNull())
+        return;
+
+    m_FrameWatcher.setFuture(QtConcurrent::run(this, &Media::encodeFrame, m_PendingFrame, m_PendingFrameMetadata,
+                             m_PendingFrameWidth));
+    m_PendingFrame = QImage();
+}
+
+void Media::encodeFrame(const QImage &frame, const QJsonObject &metadata, int maxWidth)
+{
+    AdaptiveEncoder::Settings settings = m_Encoder.settings(frame.size(), maxWidth, HB_IMAGE_QUALITY,
+                                         FRAME_DELIVERY_TIME / 1000.0);
+    settings.transformation = Qt::FastTransformation;
+    emit newImage(m_Encoder.encode(frame, settings, metadata, METADATA_PACKET));
 }
 
 void Media::sendVideoFrame(const QSharedPointer<QImage> &frame)
@@ -383,6 +449,7 @@ void Media::sendVideoFrame(const QSharedPointer<QImage> &frame)
     writer.write(videoImage);
     buffer.close();
 
+    m_Encoder.messageQueued(image.size());
     m_WebSocket.sendBinaryMessage(image);
 }
 
@@ -412,6 +479,7 @@ void Media::uploadMetadata(const QByteArray &metadata)
 
 void Media::uploadImage(const QByteArray &image)
 {
+    m_Encoder.messageQueued(image.size());
     m_WebSocket.sendBinaryMessage(image);
 }
 
@@ -13,10 +13,13 @@
 #pragma once
 
 #include <QtWebSockets/QWebSocket>
+#include <QFutureWatcher>
+#include <QMutex>
 #include <memory>
 
 #include "ekos/ekos.h"
 #include "ekos/manager.h"
+#include "adaptiveencoder.h"
 
 class FITSView;
 
@@ -96,6 +99,8 @@ class Media : public QObject
 
         // Send image
         void sendImage();
+        // Send the latest frame that came while the previous one was encoded
+        void onFrameEncoded();
 
         // Metadata and Image upload
         void uploadMetadata(const QByteArray &metadata);
@@ -103,6 +108,12 @@ class Media : public QObject
 
     private:
         void upload(FITSView * view);
+        QJsonObject imageMetadata(const FITSData * imageData) const;
+
+        // Encoding, run in worker threads
+        void deliverImage(const QImage &image, const QJsonObject &metadata, bool lowBandwidth, bool progressive);
+        void sendTile(const QImage &image, const QString &uuid, const QRect &region, int maxWidth);
+        void encodeFrame(const QImage &frame, const QJsonObject &metadata, int maxWidth);
 
         QWebSocket m_WebSocket;
         QJsonObject m_AuthResponse;
@@ -121,6 +132,20 @@ class Media : public QObject
         bool m_isConnected { false };
         bool m_sendBlobs { true};
 
+        // Sizes images after the throughput of the link
+        AdaptiveEncoder m_Encoder;
+
+        // Last image sent progressively, for the tile requests
+        QMutex m_ImageMutex;
+        QImage m_LastImage;
+        QString m_LastUUID;
+
+        // Updated frames are encoded one at a time, and only the latest waiting one is kept
+        QFutureWatcher<void> m_FrameWatcher;
+        QImage m_PendingFrame;
+        QJsonObject m_PendingFrameMetadata;
+        int m_PendingFrameWidth { 0 };
+
         // Image width for high-bandwidth setting
         static const uint16_t HB_WIDTH = 960;
         // Image high bandwidth image quality (jpg)
@@ -131,6 +156,17 @@ class Media : public QObject
         static const uint8_t HB_PAH_IMAGE_QUALITY = 50;
         // Video high bandwidth video quality (jpg) for PAH
         static const uint8_t HB_PAH_VIDEO_QUALITY = 24;
+        // Thumbnail width, sent first when images are sent progressively
+        static const uint16_t THUMBNAIL_WIDTH = 240;
+        // Thumbnail image quality (jpg)
+        static const uint8_t THUMBNAIL_IMAGE_QUALITY = 50;
+
+        // Time in ms within which each kind of image should reach the client.
+        // Images are made smaller and more compressed on slow links to meet them.
+        static const uint16_t THUMBNAIL_DELIVERY_TIME = 500;
+        static const uint16_t PREVIEW_DELIVERY_TIME = 2000;
+        static const uint16_t TILE_DELIVERY_TIME = 1000;
+        static const uint16_t FRAME_DELIVERY_TIME = 1000;
 
         // Retry every 5 seconds in case remote server is down
         static const uint16_t RECONNECT_INTERVAL = 5000;
@@ -36,6 +36,8 @@ Message::Message(Ekos::Manager *manager): m_Manager(manager)
     connect(manager, &Ekos::Manager::newModule, this, &Message::sendModuleState);
 
     m_ThrottleTS = QDateTime::currentDateTime();
+
+    m_PropertyPublisher.reset(new PropertyPublisher(&m_WebSocket, this));
 }
 
 void Message::connectServer()
@@ -73,6 +75,7 @@ void Message::onConnected()
 
     m_isConnected = true;
     m_ReconnectTries = 0;
+    m_PropertyPublisher->reset();
 
     connect(&m_WebSocket, &QWebSocket::textMessageReceived,  this, &Message::onTextReceived);
 
@@ -86,6 +89,7 @@ void Message::onDisconnected()
 {
     qCInfo(KSTARS_EKOS) << "Disconnected from Message Websocket server.";
     m_isConnected = false;
+    m_PropertyPublisher->reset();
     disconnect(&m_WebSocket, &QWebSocket::textMessageReceived,  this, &Message::onTextReceived);
 
     emit disconnected();
@@ -1149,6 +1153,18 @@ void Message::processOptionsCommands(const QString &command, const QJsonObject &
         m_Options[OPTION_SET_NOTIFICATIONS] = payload["value"].toBool(true);
     else if (command == commands[OPTION_SET_CLOUD_STORAGE])
         m_Options[OPTION_SET_CLOUD_STORAGE] = payload["value"].toBool(false);
+    else if (command == commands[OPTION_SET_PROPERTY_DELTAS])
+    {
+        m_Options[OPTION_SET_PROPERTY_DELTAS] = payload["value"].toBool(false);
+        m_PropertyPublisher->setDeltaEncoding(m_Options[OPTION_SET_PROPERTY_DELTAS]);
+    }
+    else if (command == commands[OPTION_SET_BINARY_PROPERTIES])
+    {
+        m_Options[OPTION_SET_BINARY_PROPERTIES] = payload["value"].toBool(false);
+        m_PropertyPublisher->setBinaryEncoding(m_Options[OPTION_SET_BINARY_PROPERTIES]);
+    }
+    else if (command == commands[OPTION_SET_PROGRESSIVE_IMAGES])
+        m_Options[OPTION_SET_PROGRESSIVE_IMAGES] = payload["value"].toBool(false);
 
     emit optionsChanged(m_Options);
 }
@@ -1250,7 +1266,7 @@ void Message::processDeviceCommands(const QString &command, const QJsonObject &p
             QJsonDocument::Compact));
     }
     // Subscribe to one or more properties
-    // When subscribed, the updates are immediately pushed as soon as they are received.
+    // When subscribed, the updates are pushed as they are received, coalesced by PropertyPublisher.
     else if (command == commands[DEVICE_PROPERTY_SUBSCRIBE])
     {
         const QString property = payload["property"].toString();
@@ -1264,10 +1280,8 @@ void Message::processDeviceCommands(const QString &command, const QJsonObject &p
     {
         const QString property = payload["property"].toString();
         if (m_PropertySubscriptions.contains(device))
-        {
-            QSet<QString> props = m_PropertySubscriptions[device];
-            props.remove(property);
-        }
+            m_PropertySubscriptions[device].remove(property);
+        m_PropertyPublisher->forget(device, property);
     }
 }
 
@@ -1459,6 +1473,8 @@ void Message::processNewProperty(INDI::Property * prop)
 
 void Message::processDeleteProperty(const QString &device, const QString &name)
 {
+    m_PropertyPublisher->forget(device, name);
+
     QJsonObject payload =
     {
         {"device", device},
@@ -1469,63 +1485,49 @@ void Message::processDeleteProperty(const QString &device, const QString &name)
         QJsonDocument::Compact));
 }
 
+bool Message::isSubscribed(const char *device, const char *name) const
+{
+    auto subscription = m_PropertySubscriptions.constFind(device);
+    return subscription != m_PropertySubscriptions.constEnd() && subscription->contains(name);
+}
+
 void Message::processNewNumber(INumberVectorProperty * nvp)
 {
-    if (m_PropertySubscriptions.contains(nvp->device))
+    if (isSubscribed(nvp->device, nvp->name))
     {
-        QSet<QString> subProps = m_PropertySubscriptions[nvp->device];
-        if (subProps.contains(nvp->name))
-        {
-            QJsonObject propObject;
-            ISD::propertyToJson(nvp, propObject);
-            m_WebSocket.sendTextMessage(QJsonDocument({{"type", commands[DEVICE_PROPERTY_GET]}, {"payload", propObject}}).toJson(
-                QJsonDocument::Compact));
-        }
+        QJsonObject propObject;
+        ISD::propertyToJson(nvp, propObject);
+        m_PropertyPublisher->publish(propObject);
     }
 }
 
 void Message::processNewText(ITextVectorProperty * tvp)
 {
-    if (m_PropertySubscriptions.contains(tvp->device))
+    if (isSubscribed(tvp->device, tvp->name))
     {
-        QSet<QString> subProps = m_PropertySubscriptions[tvp->device];
-        if (subProps.contains(tvp->name))
-        {
-            QJsonObject propObject;
-            ISD::propertyToJson(tvp, propObject);
-            m_WebSocket.sendTextMessage(QJsonDocument({{"type", commands[DEVICE_PROPERTY_GET]}, {"payload", propObject}}).toJson(
-                QJsonDocument::Compact));
-        }
+        QJsonObject propObject;
+        ISD::propertyToJson(tvp, propObject);
+        m_PropertyPublisher->publish(propObject);
     }
 }
 
 void Message::processNewSwitch(ISwitchVectorProperty * svp)
 {
-    if (m_PropertySubscriptions.contains(svp->device))
+    if (isSubscribed(svp->device, svp->name))
     {
-        QSet<QString> subProps = m_PropertySubscriptions[svp->device];
-        if (subProps.contains(svp->name))
-        {
-            QJsonObject propObject;
-            ISD::propertyToJson(svp, propObject);
-            m_WebSocket.sendTextMessage(QJsonDocument({{"type", commands[DEVICE_PROPERTY_GET]}, {"payload", propObject}}).toJson(
-                QJsonDocument::Compact));
-        }
+        QJsonObject propObject;
+        ISD::propertyToJson(svp, propObject);
+        m_PropertyPublisher->publish(propObject);
     }
 }
 
 void Message::processNewLight(ILightVectorProperty * lvp)
 {
-    if (m_PropertySubscriptions.contains(lvp->device))
+    if (isSubscribed(lvp->device, lvp->name))
     {
-        QSet<QString> subProps = m_PropertySubscriptions[lvp->device];
-        if (subProps.contains(lvp->name))
-        {
-            QJsonObject propObject;
-            ISD::propertyToJson(lvp, propObject);
-            m_WebSocket.sendTextMessage(QJsonDocument({{"type", commands[DEVICE_PROPERTY_GET]}, {"payload", propObject}}).toJson(
-                QJsonDocument::Compact));
-        }
+        QJsonObject propObject;
+        ISD::propertyToJson(lvp, propObject);
+        m_PropertyPublisher->publish(propObject);
     }
 }
 
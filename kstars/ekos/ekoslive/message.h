@@ -17,6 +17,7 @@
 
 #include "ekos/ekos.h"
 #include "ekos/manager.h"
+#include "propertypublisher.h"
 
 namespace EkosLive
 {
@@ -59,6 +60,12 @@ class Message : public QObject
         void sendDrivers();
         void sendDevices();
 
+        // Traffic of the subscribed property updates
+        PropertyPublisher::Statistics propertyStatistics() const
+        {
+            return m_PropertyPublisher->statistics();
+        }
+
     signals:
         void connected();
         void disconnected();
@@ -179,6 +186,7 @@ class Message : public QObject
 
         // Low-level Device commands
         void processDeviceCommands(const QString &command, const QJsonObject &payload);
+        bool isSubscribed(const char *device, const char *name) const;
 
         QWebSocket m_WebSocket;
         QJsonObject m_AuthResponse;
@@ -191,6 +199,8 @@ class Message : public QObject
 
         QMap<int, bool> m_Options;
         QMap<QString, QSet<QString>> m_PropertySubscriptions;
+        // Coalesces the updates of the subscribed properties
+        std::unique_ptr<PropertyPublisher> m_PropertyPublisher;
         QLineF correctionVector;
         QRect boundingRect;
         QSize viewSize;
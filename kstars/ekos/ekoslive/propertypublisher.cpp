@@ -0,0 +1,201 @@
+/*  Ekos Live Client
+
+    Copyright (C) 2026 KStars Developers
+
+    Property Publisher
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include "propertypublisher.h"
+#include "commands.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QtWebSockets/QWebSocket>
+
+namespace EkosLive
+{
+
+PropertyPublisher::PropertyPublisher(QWebSocket *socket, QObject *parent) : QObject(parent), m_Socket(socket)
+{
+    m_Timer.setSingleShot(true);
+    m_Timer.setInterval(200);
+    connect(&m_Timer, &QTimer::timeout, this, &PropertyPublisher::flush);
+
+    m_RateTimer.start();
+}
+
+void PropertyPublisher::publish(const QJsonObject &property)
+{
+    const QString id = key(property["device"].toString(), property["name"].toString());
+
+    m_Statistics.updates++;
+    if (m_Pending.contains(id))
+        m_Statistics.coalesced++;
+    else
+        m_PendingOrder.append(id);
+    m_Pending[id] = property;
+
+    if (!m_Timer.isActive())
+        m_Timer.start();
+}
+
+void PropertyPublisher::forget(const QString &device, const QString &name)
+{
+    const QString id = key(device, name);
+    if (m_Pending.remove(id))
+        m_PendingOrder.removeOne(id);
+    m_Sent.remove(id);
+}
+
+void PropertyPublisher::reset()
+{
+    m_Timer.stop();
+    m_Pending.clear();
+    m_PendingOrder.clear();
+    m_Sent.clear();
+}
+
+void PropertyPublisher::setDeltaEncoding(bool enabled)
+{
+    m_Delta = enabled;
+    // The client needs full properties to apply deltas to.
+    m_Sent.clear();
+}
+
+void PropertyPublisher::flush()
+{
+    m_Timer.stop();
+
+    if (m_Delta)
+    {
+        QJsonArray batch;
+        for (const QString &id : m_PendingOrder)
+        {
+            const QJsonObject &property = m_Pending[id];
+            auto sent = m_Sent.find(id);
+            if (sent == m_Sent.end())
+            {
+                batch.append(property);
+                m_Sent.insert(id, property);
+                continue;
+            }
+
+            const QJsonObject changes = delta(sent.value(), property);
+            if (!changes.isEmpty())
+            {
+                batch.append(changes);
+                sent.value() = property;
+            }
+        }
+
+        if (!batch.isEmpty())
+        {
+            const QByteArray message = QJsonDocument({{"type", commands[DEVICE_PROPERTY_BATCH]}, {"payload", batch}}).toJson(
+                                           QJsonDocument::Compact);
+            send(m_Binary ? qCompress(message) : message, m_Binary);
+        }
+    }
+    else
+    {
+        for (const QString &id : m_PendingOrder)
+            send(QJsonDocument({{"type", commands[DEVICE_PROPERTY_GET]}, {"payload", m_Pending[id]}}).toJson(
+                     QJsonDocument::Compact), false);
+    }
+
+    m_Pending.clear();
+    m_PendingOrder.clear();
+}
+
+QJsonObject PropertyPublisher::delta(const QJsonObject &previous, const QJsonObject &current)
+{
+    QJsonObject changes;
+    bool changed = false;
+
+    for (auto it = current.constBegin(); it != current.constEnd(); ++it)
+    {
+        if (it.key() == "device" || it.key() == "name")
+            continue;
+
+        if (!it.value().isArray())
+        {
+            if (previous.value(it.key()) != it.value())
+            {
+                changes.insert(it.key(), it.value());
+                changed = true;
+            }
+            continue;
+        }
+
+        // Elements, sent when any of their fields changed.
+        QHash<QString, QJsonObject> previousElements;
+        for (const auto &element : previous.value(it.key()).toArray())
+        {
+            const QJsonObject object = element.toObject();
+            previousElements.insert(object["name"].toString(), object);
+        }
+
+        QJsonArray elements;
+        for (const auto &element : it.value().toArray())
+        {
+            const QJsonObject object = element.toObject();
+            auto before = previousElements.constFind(object["name"].toString());
+            if (before == previousElements.constEnd() || before.value() != object)
+                elements.append(object);
+        }
+
+        if (!elements.isEmpty())
+        {
+            changes.insert(it.key(), elements);
+            changed = true;
+        }
+    }
+
+    if (!changed)
+        return QJsonObject();
+
+    changes.insert("device", current["device"]);
+    changes.insert("name", current["name"]);
+    return changes;
+}
+
+void PropertyPublisher::send(const QByteArray &message, bool binary)
+{
+    if (binary)
+        m_Socket->sendBinaryMessage(message);
+    else
+        m_Socket->sendTextMessage(QString::fromUtf8(message));
+
+    m_Statistics.messages++;
+    m_Statistics.bytes += message.size();
+    m_RateMessages++;
+    m_RateBytes += message.size();
+
+    const qint64 elapsed = m_RateTimer.elapsed();
+    if (elapsed >= 1000)
+    {
+        m_Statistics.messagesPerSecond = m_RateMessages * 1000.0 / elapsed;
+        m_Statistics.bytesPerSecond = m_RateBytes * 1000.0 / elapsed;
+        m_RateMessages = m_RateBytes = 0;
+        m_RateTimer.restart();
+    }
+}
+
+PropertyPublisher::Statistics PropertyPublisher::statistics() const
+{
+    Statistics stats = m_Statistics;
+    // Nothing was sent for a while, so the last rates are out of date.
+    const qint64 elapsed = m_RateTimer.elapsed();
+    if (elapsed >= 1000)
+    {
+        stats.messagesPerSecond = m_RateMessages * 1000.0 / elapsed;
+        stats.bytesPerSecond = m_RateBytes * 1000.0 / elapsed;
+    }
+    return stats;
+}
+
+}
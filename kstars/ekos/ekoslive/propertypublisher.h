@@ -0,0 +1,105 @@
+/*  Ekos Live Client
+
+    Copyright (C) 2026 KStars Developers
+
+    Property Publisher
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonObject>
+#include <QStringList>
+#include <QTimer>
+
+class QWebSocket;
+
+namespace EkosLive
+{
+/**
+ * @brief Publishes subscribed INDI property updates over the message websocket, once per tick.
+ *
+ * Updates of the same property received within a tick are coalesced, and only the
+ * latest one is sent. By default, each property goes out in its own device_property_get
+ * message, as before. Clients that enable delta encoding instead receive a single
+ * device_property_batch message per tick, holding for each property only the state and
+ * the elements that changed since it was last sent. The batch can also be sent as a
+ * binary message, holding the qCompress()ed JSON document.
+ */
+class PropertyPublisher : public QObject
+{
+        Q_OBJECT
+
+    public:
+        struct Statistics
+        {
+            // Over the last second or so.
+            double messagesPerSecond { 0 };
+            double bytesPerSecond { 0 };
+            // Since the publisher was created.
+            quint64 messages { 0 };
+            quint64 bytes { 0 };
+            quint64 updates { 0 };
+            quint64 coalesced { 0 };
+        };
+
+        explicit PropertyPublisher(QWebSocket *socket, QObject *parent = nullptr);
+
+        /**
+         * @brief publish Queue a property update for the next tick.
+         * @param property the property, as filled by ISD::propertyToJson in compact form.
+         */
+        void publish(const QJsonObject &property);
+
+        // Drops what is known of a property, which will be sent in full next time.
+        void forget(const QString &device, const QString &name);
+        // Drops all pending updates and what was sent, e.g. on a new connection.
+        void reset();
+        // Sends the pending updates now.
+        void flush();
+
+        void setInterval(int msecs)
+        {
+            m_Timer.setInterval(msecs);
+        }
+        void setDeltaEncoding(bool enabled);
+        void setBinaryEncoding(bool enabled)
+        {
+            m_Binary = enabled;
+        }
+
+        Statistics statistics() const;
+
+        // Returns the changes from previous to current, or an empty object if there are none.
+        static QJsonObject delta(const QJsonObject &previous, const QJsonObject &current);
+
+    private:
+        static QString key(const QString &device, const QString &name)
+        {
+            return device + QLatin1Char('/') + name;
+        }
+        void send(const QByteArray &message, bool binary);
+
+        QWebSocket *m_Socket { nullptr };
+        QTimer m_Timer;
+        bool m_Delta { false };
+        bool m_Binary { false };
+
+        // Pending updates, in their arrival order.
+        QHash<QString, QJsonObject> m_Pending;
+        QStringList m_PendingOrder;
+        // Last sent state of each property, for delta encoding.
+        QHash<QString, QJsonObject> m_Sent;
+
+        Statistics m_Statistics;
+        QElapsedTimer m_RateTimer;
+        quint64 m_RateMessages { 0 };
+        quint64 m_RateBytes { 0 };
+};
+}
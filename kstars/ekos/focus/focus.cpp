@@ -28,6 +28,8 @@
 
 #include <basedevice.h>
 
+#include <QtConcurrent>
+
 #include <gsl/gsl_fit.h>
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_min.h>
@@ -84,6 +86,7 @@ Focus::Focus()
     initSettingsConnections();
 
     connect(&m_StarFinderWatcher, &QFutureWatcher<bool>::finished, this, &Focus::calculateHFR);
+    connect(&m_HFRSamplerWatcher, &QFutureWatcher<HFRSampler::Measurement>::finished, this, &Focus::calculateSampledHFR);
 
     //Note:  This is to prevent a button from being called the default button
     //and then executing when the user hits the enter key such as when on a Text Box
@@ -844,8 +847,11 @@ void Focus::start()
 
     KSNotification::event(QLatin1String("FocusStarted"), i18n("Autofocus operation started"));
 
+    // The stars are detected again on the first frame of the run
+    m_HFRSampler.clear();
+
     // Used for all the focuser types.
-    if (focusAlgorithm == FOCUS_LINEAR)
+    if (useLinearFocuser())
     {
         const int position = static_cast<int>(currentPosition);
         FocusAlgorithmInterface::FocusParams params(
@@ -855,7 +861,10 @@ void Focus::start()
             Options::initialFocusOutSteps());
         if (canAbsMove)
             initialFocuserAbsPosition = position;
-        linearFocuser.reset(MakeLinearFocuser(params));
+        if (focusAlgorithm == FOCUS_PREDICTIVE)
+            linearFocuser.reset(MakePredictiveFocuser(params));
+        else
+            linearFocuser.reset(MakeLinearFocuser(params));
         linearRequestedPosition = linearFocuser->initialPosition();
         const int newPosition = adjustLinearPosition(position, linearRequestedPosition);
         if (newPosition != position)
@@ -1283,6 +1292,18 @@ void Focus::calculateHFR()
 
             // Get the average HFR of the whole frame
             hfr = m_ImageData->getHFR(HFR_AVERAGE);
+
+            // Track the brightest stars for the next frames of the run. This frame is measured
+            // the same way, so that all the samples of the run are consistent.
+            if (useHFRSampler())
+            {
+                m_HFRSampler.selectStars(m_ImageData->getStarCenters());
+                const double sampledHFR = m_HFRSampler.measure(m_ImageData.data(), HFRSampler::boxSize(hfr));
+                if (sampledHFR > 0)
+                    hfr = sampledHFR;
+                else
+                    m_HFRSampler.clear();
+            }
         }
         else
         {
@@ -1305,8 +1326,53 @@ void Focus::calculateHFR()
     setCurrentHFR(hfr);
 }
 
+void Focus::calculateSampledHFR()
+{
+    const HFRSampler::Measurement measurement = m_HFRSamplerWatcher.result();
+
+    // The stars were cleared or selected again while this frame was measured, e.g. by a new run
+    if (m_HFRSampler.apply(measurement) == false)
+    {
+        qCDebug(KSTARS_EKOS_FOCUS) << "Discarding the measure of stars that are no longer tracked.";
+        return;
+    }
+
+    const double hfr = measurement.HFR;
+
+    // Too many of the tracked stars were lost, detect them again on this frame
+    if (hfr < 0)
+    {
+        qCDebug(KSTARS_EKOS_FOCUS) << "Lost the tracked stars, detecting sources again.";
+        m_HFRSampler.clear();
+        analyzeSources();
+        return;
+    }
+
+    appendLogText(i18n("Measurement complete."));
+    hfrInProgress = false;
+    resetButtons();
+    setCurrentHFR(hfr);
+}
+
 void Focus::analyzeSources()
 {
+    // During a predictive autofocus run, only the boxes around the stars found on the first frame are measured
+    if (useHFRSampler() && m_HFRSampler.isEmpty() == false)
+    {
+        appendLogText(i18n("Measuring %1 stars...", m_HFRSampler.stars().size()));
+        hfrInProgress = true;
+
+        // The task works on a copy of the stars, the sampler only follows them once the result is back
+        QSharedPointer<FITSData> imageData = m_ImageData;
+        const QVector<QPointF> stars = m_HFRSampler.stars();
+        const int boxSize = HFRSampler::boxSize(currentHFR);
+        m_HFRSamplerWatcher.setFuture(QtConcurrent::run([imageData, stars, boxSize]()
+        {
+            return HFRSampler::measure(imageData.data(), stars, boxSize);
+        }));
+        return;
+    }
+
     appendLogText(i18n("Detecting sources..."));
     hfrInProgress = true;
 
@@ -1613,7 +1679,7 @@ void Focus::setCurrentHFR(double value)
         // We'd only want to execute this if the focus linear algorithm is not being used, as that
         // algorithm simulates a position-based system even for timer-based focusers.
         if (inFocusLoop || (inAutoFocus && canAbsMove == false && canRelMove == false &&
-                            focusAlgorithm != FOCUS_LINEAR))
+                            !useLinearFocuser()))
         {
             if (hfr_position.empty())
                 hfr_position.append(1);
@@ -1940,7 +2006,7 @@ void Focus::setHFRComplete()
 
     // Now let's kick in the algorithms
 
-    if (focusAlgorithm == FOCUS_LINEAR)
+    if (useLinearFocuser())
         autoFocusLinear();
     else if (canAbsMove || canRelMove)
         // Position-based algorithms
@@ -1995,7 +2061,7 @@ void Focus::drawHFRPlot()
         minHFRVal = std::max(0, static_cast<int>(0.9 * *std::min_element(hfr_value.begin(), hfr_value.end())));
 
     // True for the position-based algorithms and those that simulate position.
-    if (inFocusLoop == false && (canAbsMove || canRelMove || (focusAlgorithm == FOCUS_LINEAR)))
+    if (inFocusLoop == false && (canAbsMove || canRelMove || useLinearFocuser()))
     {
         const double minPosition = hfr_position.empty() ?
                                    0 : *std::min_element(hfr_position.constBegin(), hfr_position.constEnd());
@@ -2081,7 +2147,7 @@ bool Focus::autoFocusChecks()
             capture();
             return false;
         }
-        else if (focusAlgorithm == FOCUS_LINEAR)
+        else if (useLinearFocuser())
         {
             appendLogText(i18n("Failed to detect any stars at position %1. Continuing...", currentPosition));
             noStarCount = 0;
@@ -2561,7 +2627,7 @@ void Focus::autoFocusRel()
             capture();
             return;
         }
-        else if (focusAlgorithm == FOCUS_LINEAR)
+        else if (useLinearFocuser())
         {
             appendLogText(i18n("Failed to detect any stars at position %1. Continuing...", currentPosition));
             noStarCount = 0;
@@ -4210,6 +4276,7 @@ void Focus::setFocusAlgorithm(FocusAlgorithm algorithm)
             break;
 
         case FOCUS_LINEAR:
+        case FOCUS_PREDICTIVE:
             initialFocusOutStepsIN->setEnabled(true);  // Out step multiple
             maxTravelIN->setEnabled(true);             // Max Travel
             stepIN->setEnabled(true);                  // Initial Step Size
@@ -4218,6 +4285,16 @@ void Focus::setFocusAlgorithm(FocusAlgorithm algorithm)
     }
 }
 
+bool Focus::useLinearFocuser() const
+{
+    return focusAlgorithm == FOCUS_LINEAR || focusAlgorithm == FOCUS_PREDICTIVE;
+}
+
+bool Focus::useHFRSampler() const
+{
+    return focusAlgorithm == FOCUS_PREDICTIVE && inAutoFocus && Options::focusUseFullField();
+}
+
 void Focus::initView()
 {
     focusView = new FITSView(focusingWidget, FITS_FOCUS);
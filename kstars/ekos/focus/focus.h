@@ -10,6 +10,7 @@
 #pragma once
 
 #include "ui_focus.h"
+#include "hfrsampler.h"
 #include "ekos/ekos.h"
 #include "ekos/auxiliary/filtermanager.h"
 #include "ekos/auxiliary/stellarsolverprofileeditor.h"
@@ -56,7 +57,7 @@ class Focus : public QWidget, public Ui::Focus
 
         typedef enum { FOCUS_NONE, FOCUS_IN, FOCUS_OUT } FocusDirection;
         typedef enum { FOCUS_MANUAL, FOCUS_AUTO } FocusType;
-        typedef enum { FOCUS_ITERATIVE, FOCUS_POLYNOMIAL, FOCUS_LINEAR } FocusAlgorithm;
+        typedef enum { FOCUS_ITERATIVE, FOCUS_POLYNOMIAL, FOCUS_LINEAR, FOCUS_PREDICTIVE } FocusAlgorithm;
         typedef enum { FOCUSER_TEMPERATURE, OBSERVATORY_TEMPERATURE, NO_TEMPERATURE } TemperatureSource;
 
         /** @defgroup FocusDBusInterface Ekos DBus Interface - Focus Module
@@ -407,6 +408,7 @@ class Focus : public QWidget, public Ui::Focus
         void graphPolynomialFunction();
 
         void calculateHFR();
+        void calculateSampledHFR();
         void setCurrentHFR(double value);
 
     signals:
@@ -507,6 +509,16 @@ class Focus : public QWidget, public Ui::Focus
          */
         void analyzeSources();
 
+        /** @internal Returns true if the focus algorithm is driven by linearFocuser,
+         * which simulates positions for timer-based focusers.
+         */
+        bool useLinearFocuser() const;
+
+        /** @internal Returns true if the HFR of the frames can be measured around the stars
+         * detected on the first frame of the autofocus run, instead of detecting them again.
+         */
+        bool useHFRSampler() const;
+
         /** @internal Add a new HFR for the current focuser position.
          * @param newHFR is the new HFR to consider for the current focuser position.
          * @return true if a new sample is required, else false.
@@ -639,6 +651,9 @@ class Focus : public QWidget, public Ui::Focus
         bool rememberCCDExposureLooping = { false };
         // Future Watch
         QFutureWatcher<bool> m_StarFinderWatcher;
+        // Stars tracked during a predictive autofocus run, and the measure of the last frame
+        HFRSampler m_HFRSampler;
+        QFutureWatcher<HFRSampler::Measurement> m_HFRSamplerWatcher;
 
         /// Autofocus log file info.
         QStringList m_LogText;
@@ -9,10 +9,14 @@
 
 #include "focusalgorithms.h"
 
+#include "hyperbolafit.h"
 #include "polynomialfit.h"
 #include <QVector>
 #include "kstars.h"
 
+#include <cmath>
+#include <limits>
+
 #include <ekos_focus_debug.h>
 
 namespace Ekos
@@ -473,5 +477,377 @@ bool LinearFocusAlgorithm::gettingWorse()
     return true;
 }
 
+/**
+ * @class PredictiveFocusAlgorithm
+ * @short Autofocus algorithm that stops sampling once a fitted V-curve predicts the minimum.
+ *
+ * Like the linear algorithm, it starts outward of the current position and samples
+ * inward. Each sample is added to a hyperbola fit, and the sweep stops as soon as
+ * the samples bracket the minimum of the fit and its standard error costs less HFR
+ * than the focus tolerance. The focuser then moves to the minimum, where one more
+ * sample confirms the prediction.
+ *
+ * @author KStars Developers
+ */
+class PredictiveFocusAlgorithm : public FocusAlgorithmInterface
+{
+    public:
+
+        PredictiveFocusAlgorithm(const FocusParams &params);
+
+        int initialPosition() override
+        {
+            return requestedPosition;
+        }
+
+        int newMeasurement(int position, double value) override;
+
+        FocusAlgorithmInterface *Copy() override;
+
+    private:
+
+        // Returns true if there are samples on both sides of the minimum of the fit.
+        bool bracketed() const;
+
+        // Returns the position of the smallest HFR sampled so far, or -1.
+        int bestPosition() const;
+
+        // Returns true if the samples on one side of the minimum of the fit rise above the noise.
+        bool rises(double minimum, bool outward) const;
+
+        // Returns true if the minimum is bracketed, and known well enough that the HFR lost
+        // by an error of a few standard errors is within the focus tolerance.
+        bool converged() const;
+
+        // Sets up the move to the minimum of the fit, to confirm it with one more sample.
+        int setupVerification(int position, double value);
+
+        // Returns true if a sample at the minimum confirms the fit, given the scatter of the samples.
+        bool confirms(double value) const;
+
+        // Returns the RMS of the relative differences between the samples and the fit.
+        double scatter() const;
+
+        // Steps the sweep inward, or settles for the current fit at the end of the travel.
+        int completeIteration();
+
+        // Does the bookkeeping for the final focus solution.
+        int setupSolution(int position, double value);
+
+        // Terminates the algorithm without a solution.
+        int setupFailure(const QString &reason);
+
+        // Adds to the debug log a line summarizing the result of running this algorithm.
+        void debugLog();
+
+        // Used to time the focus algorithm.
+        QTime stopWatch;
+
+        // The HFR values sampled so far, and their focus positions.
+        QVector<double> values;
+        QVector<int> positions;
+
+        // The V-curve fitted to the samples.
+        HyperbolaFit fit;
+
+        // Focus position requested by this algorithm the previous step.
+        int requestedPosition;
+        // Position of the inward sweep, which goes on if a verification fails.
+        int sweepPosition;
+        // Number of iterations processed so far.
+        int numSteps { 0 };
+        // The focus position limits, computed from the focuser limits and maxTravel.
+        int minPositionLimit;
+        int maxPositionLimit;
+        // True if the last requested position is the minimum of the fit.
+        bool verifying { false };
+        // Number of moves to the minimum of the fit so far.
+        int numVerifications { 0 };
+        // HFR predicted at the minimum when the verification was requested.
+        double predictedValue { -1 };
+        // Number of times the sweep passed the minimum and was restarted outward of it.
+        int numRestarts { 0 };
+};
+
+FocusAlgorithmInterface *PredictiveFocusAlgorithm::Copy()
+{
+    PredictiveFocusAlgorithm *alg = new PredictiveFocusAlgorithm(params);
+    *alg = *this;
+    return dynamic_cast<FocusAlgorithmInterface*>(alg);
+}
+
+FocusAlgorithmInterface *MakePredictiveFocuser(const FocusAlgorithmInterface::FocusParams &params)
+{
+    return new PredictiveFocusAlgorithm(params);
+}
+
+PredictiveFocusAlgorithm::PredictiveFocusAlgorithm(const FocusParams &focusParams)
+    : FocusAlgorithmInterface(focusParams), fit(focusParams.startPosition, focusParams.initialStepSize)
+{
+    stopWatch.start();
+    maxPositionLimit = std::min(params.maxPositionAllowed, params.startPosition + params.maxTravel);
+    minPositionLimit = std::max(params.minPositionAllowed, params.startPosition - params.maxTravel);
+
+    requestedPosition = std::min(maxPositionLimit,
+                                 static_cast<int>(params.startPosition + params.initialOutwardSteps * params.initialStepSize));
+    sweepPosition = requestedPosition;
+
+    qCDebug(KSTARS_EKOS_FOCUS)
+            << QString("Predictive: Travel %1 step %2 pos %3 min %4 max %5 maxIters %6 tolerance %7 initialPosition %8")
+            .arg(params.maxTravel).arg(params.initialStepSize).arg(params.startPosition).arg(minPositionLimit)
+            .arg(maxPositionLimit).arg(params.maxIterations).arg(params.focusTolerance).arg(requestedPosition);
+}
+
+int PredictiveFocusAlgorithm::newMeasurement(int position, double value)
+{
+    ++numSteps;
+    qCDebug(KSTARS_EKOS_FOCUS) << QString("Predictive: step %1, newMeasurement(%2, %3)").arg(numSteps).arg(position).arg(value);
+
+    constexpr int POSITION_TOLERANCE = 25;
+    if (abs(position - requestedPosition) > POSITION_TOLERANCE)
+    {
+        qCDebug(KSTARS_EKOS_FOCUS) << QString("Predictive: error didn't get the requested position");
+        return requestedPosition;
+    }
+    if (focusSolution != -1)
+    {
+        doneString = i18n("Called newMeasurement after a solution was found.");
+        qCDebug(KSTARS_EKOS_FOCUS) << QString("Predictive: error %1").arg(doneString);
+        debugLog();
+        return -1;
+    }
+
+    // Samples without stars are kept for the log, but not fitted.
+    values.push_back(value);
+    positions.push_back(position);
+    fit.add(position, value);
+
+    if (verifying)
+    {
+        verifying = false;
+        if (confirms(value))
+            return setupSolution(position, value);
+
+        constexpr int kMaxVerifications = 2;
+        qCDebug(KSTARS_EKOS_FOCUS) << QString("Predictive: minimum not confirmed, %1 instead of %2")
+                                   .arg(value).arg(predictedValue);
+        if (numVerifications >= kMaxVerifications)
+            return setupFailure(i18n("The predicted focus position could not be confirmed."));
+    }
+
+    if (fit.isValid())
+        qCDebug(KSTARS_EKOS_FOCUS) << QString("Predictive: fit(%1): %2 +/- %3 = %4")
+                                   .arg(fit.count()).arg(fit.minimumPosition()).arg(fit.positionError())
+                                   .arg(fit.minimumValue());
+
+    if (converged())
+        return setupVerification(position, value);
+
+    // The minimum may be outward of the start of the sweep, or so close to it that the sweep
+    // passed it without enough samples outward of it. The samples may also all be on the outer
+    // side of the V-curve, where the fit follows the noise. Sweep again from further out,
+    // the samples taken so far remain in the fit.
+    constexpr int kMinSamples = 5;
+    constexpr int kMaxRestarts = 3;
+    constexpr int kRestartSteps = 3;
+    if (fit.isValid() && fit.count() >= kMinSamples)
+    {
+        const double minimum = fit.minimumPosition();
+        const int step = params.initialStepSize;
+        const int highestPosition = *std::max_element(positions.begin(), positions.end());
+        const bool outward = minimum > highestPosition + step || bestPosition() == highestPosition;
+        const bool passed = !outward && sweepPosition < minimum - 2 * step && !rises(minimum, true);
+
+        if (outward || passed)
+        {
+            if (highestPosition >= maxPositionLimit)
+                return setupFailure(i18n("The minimum is beyond the maximum travel."));
+            if (passed && numRestarts >= kMaxRestarts)
+                return setupFailure(i18n("The samples outward of the minimum do not rise."));
+
+            // Far enough to get samples outward of the minimum, but not further than a new sweep start,
+            // as an extrapolated minimum is unreliable.
+            int target = highestPosition + static_cast<int>(params.initialOutwardSteps * step);
+            if (minimum > highestPosition || passed)
+                target = std::min(target, static_cast<int>(std::lround(minimum)) + kRestartSteps * step);
+            sweepPosition = std::min(maxPositionLimit, std::max(highestPosition + step, target));
+            requestedPosition = sweepPosition;
+            if (passed)
+                ++numRestarts;
+            qCDebug(KSTARS_EKOS_FOCUS) << QString("Predictive: minimum %1, restarting at %2").arg(minimum).arg(requestedPosition);
+            return requestedPosition;
+        }
+    }
+
+    return completeIteration();
+}
+
+bool PredictiveFocusAlgorithm::bracketed() const
+{
+    constexpr int kMinSamples = 5;
+
+    if (!fit.isValid() || fit.count() < kMinSamples)
+        return false;
+
+    const double minimum = fit.minimumPosition();
+    if (minimum < minPositionLimit || minimum > maxPositionLimit || !(fit.minimumValue() > 0))
+        return false;
+
+    return rises(minimum, true) && rises(minimum, false);
+}
+
+bool PredictiveFocusAlgorithm::rises(double minimum, bool outward) const
+{
+    constexpr int kMinSamplesPerSide = 2;
+
+    // On the steep sides of the V-curve the noise alone can bend the fit. Require the samples
+    // to rise on the side by more than the noise, not just to be there.
+    int count = 0;
+    double lowest = std::numeric_limits<double>::max(), highest = 0;
+    for (int i = 0; i < values.size(); ++i)
+    {
+        if (values[i] > 0)
+        {
+            lowest = std::min(lowest, values[i]);
+            if ((positions[i] > minimum) == outward)
+            {
+                highest = std::max(highest, values[i]);
+                count++;
+            }
+        }
+    }
+    return count >= kMinSamplesPerSide && highest > lowest * (1.0 + params.focusTolerance + 2.0 * scatter());
+}
+
+bool PredictiveFocusAlgorithm::converged() const
+{
+    // Two standard errors, so that the tolerance holds for about 95% of the runs.
+    constexpr double kConfidence = 2.0;
+
+    if (!bracketed())
+        return false;
+
+    const double minimum = fit.minimumPosition();
+    return fit.value(minimum + kConfidence * fit.positionError()) <= fit.minimumValue() * (1.0 + params.focusTolerance);
+}
+
+int PredictiveFocusAlgorithm::bestPosition() const
+{
+    int best = -1;
+    for (int i = 0; i < values.size(); ++i)
+    {
+        if (values[i] > 0 && (best < 0 || values[i] < values[best]))
+            best = i;
+    }
+    return best < 0 ? -1 : positions[best];
+}
+
+int PredictiveFocusAlgorithm::setupVerification(int position, double value)
+{
+    verifying = true;
+    ++numVerifications;
+    predictedValue = fit.minimumValue();
+
+    requestedPosition = std::max(minPositionLimit,
+                                 std::min(maxPositionLimit, static_cast<int>(std::lround(fit.minimumPosition()))));
+    qCDebug(KSTARS_EKOS_FOCUS) << QString("Predictive: minimum %1 +/- %2 = %3, verifying at %4")
+                               .arg(fit.minimumPosition()).arg(fit.positionError()).arg(predictedValue)
+                               .arg(requestedPosition);
+
+    // Already there
+    if (requestedPosition == position && confirms(value))
+        return setupSolution(position, value);
+
+    return requestedPosition;
+}
+
+bool PredictiveFocusAlgorithm::confirms(double value) const
+{
+    // Two standard deviations of the measurement noise, on top of the tolerance.
+    constexpr double kConfidence = 2.0;
+    return value > 0 && value <= predictedValue * (1.0 + params.focusTolerance + kConfidence * scatter());
+}
+
+double PredictiveFocusAlgorithm::scatter() const
+{
+    if (!fit.isValid() || fit.count() <= 3)
+        return 0;
+
+    double sum = 0;
+    for (int i = 0; i < values.size(); ++i)
+    {
+        if (values[i] > 0)
+        {
+            const double residual = values[i] / fit.value(positions[i]) - 1.0;
+            sum += residual * residual;
+        }
+    }
+    return std::sqrt(sum / (fit.count() - 3));
+}
+
+int PredictiveFocusAlgorithm::completeIteration()
+{
+    if (numSteps >= params.maxIterations)
+    {
+        // Settle for the current fit, if it brackets a minimum.
+        if (bracketed() && numSteps == params.maxIterations)
+            return setupVerification(positions.last(), values.last());
+        return setupFailure(i18n("Too many steps."));
+    }
+
+    sweepPosition -= params.initialStepSize;
+    if (sweepPosition < minPositionLimit)
+    {
+        if (bracketed())
+            return setupVerification(positions.last(), values.last());
+        return setupFailure(i18n("Reached the end of the travel without a minimum."));
+    }
+
+    requestedPosition = sweepPosition;
+    qCDebug(KSTARS_EKOS_FOCUS) << QString("Predictive: requesting position %1").arg(requestedPosition);
+    return requestedPosition;
+}
+
+int PredictiveFocusAlgorithm::setupSolution(int position, double value)
+{
+    focusSolution = position;
+    focusHFR = value;
+    done = true;
+    doneString = i18n("Solution found.");
+    qCDebug(KSTARS_EKOS_FOCUS) << QString("Predictive: solution @ %1 = %2 (predicted %3)")
+                               .arg(position).arg(value).arg(predictedValue);
+    debugLog();
+    return -1;
+}
+
+int PredictiveFocusAlgorithm::setupFailure(const QString &reason)
+{
+    done = true;
+    doneString = reason;
+    qCDebug(KSTARS_EKOS_FOCUS) << QString("Predictive: error %1").arg(doneString);
+    debugLog();
+    return -1;
+}
+
+void PredictiveFocusAlgorithm::debugLog()
+{
+    QString str("Predictive: points=[");
+    for (int i = 0; i < positions.size(); ++i)
+    {
+        str.append(QString("(%1, %2)").arg(positions[i]).arg(values[i]));
+        if (i < positions.size() - 1)
+            str.append(", ");
+    }
+    str.append(QString("];iterations=%1").arg(numSteps));
+    str.append(QString(";duration=%1").arg(stopWatch.elapsed() / 1000));
+    str.append(QString(";solution=%1").arg(focusSolution));
+    str.append(QString(";HFR=%1").arg(focusHFR));
+    str.append(QString(";error=%1").arg(fit.positionError()));
+    str.append(QString(";filter='%1'").arg(params.filterName));
+    str.append(QString(";temperature=%1").arg(params.temperature));
+
+    qCDebug(KSTARS_EKOS_FOCUS) << str;
+}
+
 }
 
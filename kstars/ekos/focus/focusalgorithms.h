@@ -100,5 +100,10 @@ public:
 
 // Creates a LinearFocuser. Caller responsible for the memory.
 FocusAlgorithmInterface *MakeLinearFocuser(const FocusAlgorithmInterface::FocusParams& params);
+
+// Creates a PredictiveFocuser, which sweeps inward while fitting a hyperbola to the samples,
+// and stops once the minimum of the fit is known within the focus tolerance.
+// Caller responsible for the memory.
+FocusAlgorithmInterface *MakePredictiveFocuser(const FocusAlgorithmInterface::FocusParams& params);
 }
 
@@ -0,0 +1,273 @@
+/*  Ekos parallel HFR sampler
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include "hfrsampler.h"
+
+#include "fitsviewer/fitsdata.h"
+#include "fitsviewer/fitsstardetector.h"
+
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+namespace Ekos
+{
+
+void HFRSampler::selectStars(const QList<Edge *> &detected, int maxStars)
+{
+    QList<Edge *> sorted;
+    for (Edge *star : detected)
+    {
+        if (star->HFR > 0)
+            sorted.append(star);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const Edge * a, const Edge * b)
+    {
+        return a->sum > b->sum;
+    });
+
+    m_Stars.clear();
+    for (int i = 0; i < sorted.size() && i < maxStars; ++i)
+        m_Stars.append(QPointF(sorted[i]->x, sorted[i]->y));
+}
+
+int HFRSampler::boxSize(double HFR)
+{
+    // Three HFR on each side of the star holds the wings of a focused star and the ring of a defocused one
+    if (!(HFR > 0))
+        return MaxBoxSize / 4;
+    return std::max(static_cast<int>(MinBoxSize), std::min(static_cast<int>(std::ceil(6 * HFR)), static_cast<int>(MaxBoxSize)));
+}
+
+template <typename T>
+HFRSampler::Sample HFRSampler::measureStar(const T *buffer, int width, int height, const QPointF &center, int boxSize)
+{
+    Sample sample;
+    sample.center = center;
+
+    const int half = boxSize / 2;
+    QPointF c = center;
+    std::vector<double> border;
+
+    // A second pass centers the box on the centroid if the star moved
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        const int cx = static_cast<int>(std::lround(c.x()));
+        const int cy = static_cast<int>(std::lround(c.y()));
+        const int x0 = std::max(0, cx - half), x1 = std::min(width - 1, cx + half);
+        const int y0 = std::max(0, cy - half), y1 = std::min(height - 1, cy + half);
+        if (x1 - x0 < 4 || y1 - y0 < 4)
+            return sample;
+
+        // Background and noise from the border of the box
+        border.clear();
+        for (int x = x0; x <= x1; ++x)
+        {
+            border.push_back(buffer[static_cast<qint64>(y0) * width + x]);
+            border.push_back(buffer[static_cast<qint64>(y1) * width + x]);
+        }
+        for (int y = y0 + 1; y < y1; ++y)
+        {
+            border.push_back(buffer[static_cast<qint64>(y) * width + x0]);
+            border.push_back(buffer[static_cast<qint64>(y) * width + x1]);
+        }
+        const auto middle = border.begin() + border.size() / 2;
+        std::nth_element(border.begin(), middle, border.end());
+        const double background = *middle;
+        for (auto &value : border)
+            value = std::fabs(value - background);
+        std::nth_element(border.begin(), middle, border.end());
+        // Few enough noise pixels pass 3 sigma not to bias the HFR of a large box
+        const double threshold = background + 3 * 1.4826 * *middle;
+
+        double sum = 0, sumX = 0, sumY = 0;
+        int pixels = 0;
+        for (int y = y0; y <= y1; ++y)
+        {
+            const T *row = buffer + static_cast<qint64>(y) * width;
+            for (int x = x0; x <= x1; ++x)
+            {
+                if (row[x] > threshold)
+                {
+                    const double value = row[x] - background;
+                    sum += value;
+                    sumX += value * x;
+                    sumY += value * y;
+                    pixels++;
+                }
+            }
+        }
+        if (pixels < 3 || !(sum > 0))
+            return sample;
+
+        const QPointF centroid(sumX / sum, sumY / sum);
+        const bool moved = (centroid - c).manhattanLength() > 1;
+        c = centroid;
+        if (pass == 0 && moved)
+            continue;
+
+        double sumR = 0;
+        for (int y = y0; y <= y1; ++y)
+        {
+            const T *row = buffer + static_cast<qint64>(y) * width;
+            for (int x = x0; x <= x1; ++x)
+            {
+                if (row[x] > threshold)
+                    sumR += (row[x] - background) * std::hypot(x - c.x(), y - c.y());
+            }
+        }
+
+        sample.center = c;
+        sample.flux = sum;
+        sample.HFR = sumR / sum;
+
+        // A star cut by the edge of the box or frame would look smaller
+        if (c.x() - x0 < sample.HFR || x1 - c.x() < sample.HFR || c.y() - y0 < sample.HFR || y1 - c.y() < sample.HFR)
+            sample.HFR = -1;
+        return sample;
+    }
+
+    return sample;
+}
+
+template <typename T>
+HFRSampler::Measurement HFRSampler::measure(const T *buffer, int width, int height, const QVector<QPointF> &stars,
+        int boxSize)
+{
+    Measurement measurement;
+    measurement.stars = stars;
+    measurement.followed = stars;
+
+    const int count = stars.size();
+    measurement.samples.fill(Sample(), count);
+    if (count == 0)
+        return measurement;
+
+    // The box of a star must not hold its neighbours
+    QVector<int> boxSizes(count, boxSize);
+    for (int i = 0; i < count; ++i)
+    {
+        for (int j = 0; j < count; ++j)
+        {
+            const QPointF distance = stars[i] - stars[j];
+            const int separation = static_cast<int>(std::max(std::fabs(distance.x()), std::fabs(distance.y())));
+            if (j != i && separation < boxSizes[i])
+                boxSizes[i] = std::max(static_cast<int>(MinBoxSize), separation);
+        }
+    }
+
+    QVector<int> indices(count);
+    std::iota(indices.begin(), indices.end(), 0);
+    Sample *samples = measurement.samples.data();
+    const QPointF *centers = stars.constData();
+    const int *sizes = boxSizes.constData();
+    QtConcurrent::blockingMap(indices, [ = ](int i)
+    {
+        samples[i] = measureStar(buffer, width, height, centers[i], sizes[i]);
+    });
+
+    std::vector<double> HFRs;
+    for (int i = 0; i < count; ++i)
+    {
+        if (samples[i].HFR > 0)
+        {
+            HFRs.push_back(samples[i].HFR);
+            // Follow the star to the next frame
+            measurement.followed[i] = samples[i].center;
+        }
+    }
+    if (2 * static_cast<int>(HFRs.size()) < count)
+        return measurement;
+
+    const auto middle = HFRs.begin() + HFRs.size() / 2;
+    std::nth_element(HFRs.begin(), middle, HFRs.end());
+    measurement.HFR = *middle;
+    return measurement;
+}
+
+HFRSampler::Measurement HFRSampler::measure(const FITSData *data, const QVector<QPointF> &stars, int boxSize)
+{
+    const FITSImage::Statistic &stats = data->getStatistics();
+    const uint8_t *buffer = data->getImageBuffer();
+
+    switch (stats.dataType)
+    {
+        case TBYTE:
+            return measure(buffer, stats.width, stats.height, stars, boxSize);
+        case TSHORT:
+            return measure(reinterpret_cast<const int16_t *>(buffer), stats.width, stats.height, stars, boxSize);
+        case TUSHORT:
+            return measure(reinterpret_cast<const uint16_t *>(buffer), stats.width, stats.height, stars, boxSize);
+        case TLONG:
+            return measure(reinterpret_cast<const int32_t *>(buffer), stats.width, stats.height, stars, boxSize);
+        case TULONG:
+            return measure(reinterpret_cast<const uint32_t *>(buffer), stats.width, stats.height, stars, boxSize);
+        case TFLOAT:
+            return measure(reinterpret_cast<const float *>(buffer), stats.width, stats.height, stars, boxSize);
+        case TLONGLONG:
+            return measure(reinterpret_cast<const int64_t *>(buffer), stats.width, stats.height, stars, boxSize);
+        case TDOUBLE:
+            return measure(reinterpret_cast<const double *>(buffer), stats.width, stats.height, stars, boxSize);
+        default:
+        {
+            Measurement measurement;
+            measurement.stars = stars;
+            measurement.followed = stars;
+            return measurement;
+        }
+    }
+}
+
+bool HFRSampler::apply(const Measurement &measurement)
+{
+    if (measurement.stars != m_Stars)
+        return false;
+
+    m_Samples = measurement.samples;
+    m_Stars = measurement.followed;
+    return true;
+}
+
+template <typename T>
+double HFRSampler::measure(const T *buffer, int width, int height, int boxSize)
+{
+    const Measurement measurement = measure(buffer, width, height, m_Stars, boxSize);
+    apply(measurement);
+    return measurement.HFR;
+}
+
+double HFRSampler::measure(const FITSData *data, int boxSize)
+{
+    const Measurement measurement = measure(data, m_Stars, boxSize);
+    apply(measurement);
+    return measurement.HFR;
+}
+
+template double HFRSampler::measure(const uint8_t *, int, int, int);
+template double HFRSampler::measure(const int16_t *, int, int, int);
+template double HFRSampler::measure(const uint16_t *, int, int, int);
+template double HFRSampler::measure(const int32_t *, int, int, int);
+template double HFRSampler::measure(const uint32_t *, int, int, int);
+template double HFRSampler::measure(const float *, int, int, int);
+template double HFRSampler::measure(const int64_t *, int, int, int);
+template double HFRSampler::measure(const double *, int, int, int);
+
+template HFRSampler::Measurement HFRSampler::measure(const uint8_t *, int, int, const QVector<QPointF> &, int);
+template HFRSampler::Measurement HFRSampler::measure(const int16_t *, int, int, const QVector<QPointF> &, int);
+template HFRSampler::Measurement HFRSampler::measure(const uint16_t *, int, int, const QVector<QPointF> &, int);
+template HFRSampler::Measurement HFRSampler::measure(const int32_t *, int, int, const QVector<QPointF> &, int);
+template HFRSampler::Measurement HFRSampler::measure(const uint32_t *, int, int, const QVector<QPointF> &, int);
+template HFRSampler::Measurement HFRSampler::measure(const float *, int, int, const QVector<QPointF> &, int);
+template HFRSampler::Measurement HFRSampler::measure(const int64_t *, int, int, const QVector<QPointF> &, int);
+template HFRSampler::Measurement HFRSampler::measure(const double *, int, int, const QVector<QPointF> &, int);
+
+}
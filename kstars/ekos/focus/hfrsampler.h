@@ -0,0 +1,123 @@
+/*  Ekos parallel HFR sampler
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+#include <QList>
+#include <QPointF>
+#include <QVector>
+
+class Edge;
+class FITSData;
+
+namespace Ekos
+{
+
+/**
+ * @class HFRSampler
+ * @short Measures the HFR of known stars in small regions of interest, in parallel.
+ *
+ * During an autofocus run the stars barely move between frames, only their size
+ * changes. Once the stars were detected on a full frame, the following frames are
+ * measured in a box around each of them, so that the detection does not run on the
+ * whole frame again. Each box is measured by its own task:
+ * - the background and noise are the median and median absolute deviation of the
+ *   pixels on the border of the box, which is kept smaller than the distance to
+ *   the nearest tracked star,
+ * - the star is centered again on its flux-weighted centroid, which follows drifts,
+ * - the HFR is the flux-weighted mean distance to the centroid, sum(r I) / sum(I),
+ *   of the pixels more than 3 sigma above the background.
+ *
+ * The HFR of a frame is the median over the stars, which ignores the few stars
+ * lost to a satellite trail or a passing cloud.
+ */
+class HFRSampler
+{
+    public:
+        struct Sample
+        {
+            // Centroid of the star, in pixels
+            QPointF center;
+            // Half flux radius in pixels, or -1 if the star was not measured
+            double HFR { -1 };
+            // Flux above the background
+            double flux { 0 };
+        };
+
+        struct Measurement
+        {
+            // Median HFR of the stars, or -1 if fewer than half of them were measured
+            double HFR { -1 };
+            // Star centers the measure started from
+            QVector<QPointF> stars;
+            // Star centers followed to their centroids on the frame
+            QVector<QPointF> followed;
+            QVector<Sample> samples;
+        };
+
+        // Smallest and largest box sizes, in pixels.
+        static constexpr int MinBoxSize { 16 };
+        static constexpr int MaxBoxSize { 256 };
+
+        // Returns true if no star is tracked.
+        bool isEmpty() const { return m_Stars.isEmpty(); }
+
+        // Forgets the tracked stars.
+        void clear() { m_Stars.clear(); }
+
+        // Returns the tracked star centers.
+        const QVector<QPointF> &stars() const { return m_Stars; }
+
+        // Tracks the given star centers.
+        void setStars(const QVector<QPointF> &centers) { m_Stars = centers; }
+
+        // Tracks the brightest of the detected stars, up to maxStars.
+        void selectStars(const QList<Edge *> &detected, int maxStars = 32);
+
+        // Returns a box size suited to stars of the given HFR, e.g. the HFR of the previous frame.
+        static int boxSize(double HFR);
+
+        /**
+         * @brief Measure the tracked stars on a frame, in parallel, and follow their centroids.
+         * @return the median HFR of the stars, or -1 if fewer than half of them were measured,
+         * in which case the stars should be detected again.
+         */
+        double measure(const FITSData *data, int boxSize);
+        template <typename T>
+        double measure(const T *buffer, int width, int height, int boxSize);
+
+        /**
+         * @brief Measure the given stars on a frame, in parallel, without touching any sampler.
+         * This is the variant to run on a worker thread: pass a copy of stars() and apply() the
+         * result on the thread that owns the sampler.
+         */
+        static Measurement measure(const FITSData *data, const QVector<QPointF> &stars, int boxSize);
+        template <typename T>
+        static Measurement measure(const T *buffer, int width, int height, const QVector<QPointF> &stars, int boxSize);
+
+        /**
+         * @brief Follow the stars to the centroids of a measurement.
+         * @return false, leaving the sampler untouched, if the tracked stars changed since the
+         * measure started, e.g. because they were cleared or selected again meanwhile.
+         */
+        bool apply(const Measurement &measurement);
+
+        // Returns the samples of the last measure().
+        const QVector<Sample> &samples() const { return m_Samples; }
+
+        // Measures a single star in a box of the given size around center.
+        template <typename T>
+        static Sample measureStar(const T *buffer, int width, int height, const QPointF &center, int boxSize);
+
+    private:
+        QVector<QPointF> m_Stars;
+        QVector<Sample> m_Samples;
+};
+
+}
@@ -0,0 +1,109 @@
+/*  Ekos incremental focus curve fit
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include "hyperbolafit.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Ekos
+{
+
+HyperbolaFit::HyperbolaFit(double origin_, double scale_)
+    : origin(origin_), scale(scale_ != 0 ? scale_ : 1), error(std::numeric_limits<double>::infinity())
+{
+}
+
+void HyperbolaFit::add(double position, double hfr)
+{
+    if (!(hfr > 0))
+        return;
+
+    const double u = (position - origin) / scale;
+    const double y = hfr * hfr;
+    // The noise of HFR^2 grows with HFR, weight the samples accordingly.
+    const double w = 1.0 / y;
+
+    double uk = w;
+    for (int k = 0; k < 5; ++k)
+    {
+        su[k] += uk;
+        if (k < 3)
+            suy[k] += uk * y;
+        uk *= u;
+    }
+    syy += w * y * y;
+    ++n;
+
+    solve();
+}
+
+void HyperbolaFit::clear()
+{
+    *this = HyperbolaFit(origin, scale);
+}
+
+void HyperbolaFit::solve()
+{
+    valid = false;
+    error = std::numeric_limits<double>::infinity();
+    if (n < 3)
+        return;
+
+    // Inverse of the symmetric normal matrix [[s0 s1 s2] [s1 s2 s3] [s2 s3 s4]], by cofactors.
+    const double c00 = su[2] * su[4] - su[3] * su[3];
+    const double c01 = su[2] * su[3] - su[1] * su[4];
+    const double c02 = su[1] * su[3] - su[2] * su[2];
+    const double c11 = su[0] * su[4] - su[2] * su[2];
+    const double c12 = su[1] * su[2] - su[0] * su[3];
+    const double c22 = su[0] * su[2] - su[1] * su[1];
+    const double det = su[0] * c00 + su[1] * c01 + su[2] * c02;
+    // Fewer than 3 distinct positions
+    if (!(std::fabs(det) > 1e-12 * su[0] * su[2] * su[4]))
+        return;
+
+    p[0] = (c00 * suy[0] + c01 * suy[1] + c02 * suy[2]) / det;
+    p[1] = (c01 * suy[0] + c11 * suy[1] + c12 * suy[2]) / det;
+    p[2] = (c02 * suy[0] + c12 * suy[1] + c22 * suy[2]) / det;
+
+    // An inverted parabola has no minimum.
+    if (!(p[2] > 0))
+        return;
+    valid = true;
+
+    if (n <= 3)
+        return;
+
+    // Residual variance, then the variance of -p1 / 2p2 by propagation of errors.
+    const double rss = std::max(0.0, syy - p[0] * suy[0] - p[1] * suy[1] - p[2] * suy[2]);
+    const double variance = rss / (n - 3);
+    const double g1 = -1.0 / (2 * p[2]);
+    const double g2 = p[1] / (2 * p[2] * p[2]);
+    const double positionVariance = variance * (g1 * g1 * c11 + 2 * g1 * g2 * c12 + g2 * g2 * c22) / det;
+    error = scale * std::sqrt(std::max(0.0, positionVariance));
+}
+
+double HyperbolaFit::minimumPosition() const
+{
+    return origin + scale * (-p[1] / (2 * p[2]));
+}
+
+double HyperbolaFit::minimumValue() const
+{
+    return std::sqrt(std::max(0.0, p[0] - p[1] * p[1] / (4 * p[2])));
+}
+
+double HyperbolaFit::value(double position) const
+{
+    const double u = (position - origin) / scale;
+    return std::sqrt(std::max(0.0, p[0] + u * (p[1] + u * p[2])));
+}
+
+}
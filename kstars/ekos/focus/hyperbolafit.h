@@ -0,0 +1,78 @@
+/*  Ekos incremental focus curve fit
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+namespace Ekos
+{
+
+/**
+ * @class HyperbolaFit
+ * @short Incremental fit of a focus curve, with the uncertainty of its minimum.
+ *
+ * The HFR of a defocused star follows a hyperbola of the focuser position,
+ * HFR(x)^2 = a + b (x - c)^2, which is a parabola in HFR^2. The parabola is
+ * fitted by weighted least squares, keeping only the sums of the normal
+ * equations, so adding a sample and solving both take constant time.
+ *
+ * The residuals give the variance of the coefficients, from which the
+ * standard error of the best focus position c is derived.
+ *
+ * Positions are shifted and scaled internally by the given origin and scale,
+ * e.g. the start position and step size of the sweep, to keep the normal
+ * equations well conditioned.
+ */
+class HyperbolaFit
+{
+    public:
+        explicit HyperbolaFit(double origin = 0, double scale = 1);
+
+        // Adds the HFR measured at a focuser position, and solves the fit again.
+        // Non-positive HFR values are ignored.
+        void add(double position, double hfr);
+
+        // Removes all samples.
+        void clear();
+
+        // Returns the number of samples.
+        int count() const { return n; }
+
+        // Returns true if the fitted curve has a minimum.
+        bool isValid() const { return valid; }
+
+        // Returns the focuser position of the minimum.
+        double minimumPosition() const;
+
+        // Returns the HFR at the minimum.
+        double minimumValue() const;
+
+        // Returns the standard error of minimumPosition(), in focuser steps.
+        // Infinite until there are more samples than coefficients.
+        double positionError() const { return error; }
+
+        // Returns the HFR predicted at a focuser position.
+        double value(double position) const;
+
+    private:
+        void solve();
+
+        double origin, scale;
+        int n { 0 };
+        // Weighted sums of u^k, u^k y for k = 0..4 and 0..2, and of y^2, with y = HFR^2.
+        double su[5] {};
+        double suy[3] {};
+        double syy { 0 };
+
+        bool valid { false };
+        // Coefficients of y in u = (x - origin) / scale.
+        double p[3] {};
+        double error;
+};
+
+}
@@ -0,0 +1,149 @@
+/*  Parallel Bayer decoding
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include "bayerdecoder.h"
+
+#include <QImage>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+// Rows of the neighbouring bands decoded with each band. The widest method, AHD,
+// needs 6 to give the same result as a full frame decoding. Even, to keep the
+// pattern phase.
+constexpr int haloRows = 8;
+// Rows written by each band. Even, to keep the pattern phase.
+constexpr int bandRows = 128;
+
+dc1394error_t decodeRows(const uint8_t *bayer, uint8_t *rgb, int width, int height, const BayerParams &params)
+{
+    return dc1394_bayer_decoding_8bit(bayer, rgb, width, height, params.filter, params.method);
+}
+
+dc1394error_t decodeRows(const uint16_t *bayer, uint16_t *rgb, int width, int height, const BayerParams &params)
+{
+    return dc1394_bayer_decoding_16bit(bayer, rgb, width, height, params.filter, params.method, 16);
+}
+
+// Decodes the frame band by band. For each band, output(rgb, firstRow, rowCount) receives
+// the interleaved RGB samples of rows [firstRow, firstRow + rowCount) of the frame.
+template <typename T, typename Output>
+dc1394error_t decodeBands(const T *bayer, int width, int height, const BayerParams &params, Output output)
+{
+    if (params.offsetY == 1)
+    {
+        bayer += width;
+        height--;
+    }
+    if (width <= 0 || height <= 0)
+        return DC1394_INVALID_ARGUMENT_VALUE;
+
+    // Downsampling packs a smaller image at the start of the buffer, so it can't be banded.
+    const int rows = params.method == DC1394_BAYER_METHOD_DOWNSAMPLE ? height : bandRows;
+
+    std::atomic<int> error { DC1394_SUCCESS };
+    auto decodeBand = [&](int first)
+    {
+        const int last = std::min(height, first + rows);
+        const int top = std::max(0, first - haloRows);
+        const int bottom = std::min(height, last + haloRows);
+
+        thread_local std::vector<T> band;
+        band.resize(static_cast<size_t>(bottom - top) * width * 3);
+
+        const dc1394error_t result = decodeRows(bayer + static_cast<size_t>(top) * width, band.data(), width,
+                                                bottom - top, params);
+        if (result != DC1394_SUCCESS)
+        {
+            error = result;
+            return;
+        }
+        output(band.data() + static_cast<size_t>(first - top) * width * 3, first, last - first);
+    };
+
+    QVector<int> bands;
+    for (int first = 0; first < height; first += rows)
+        bands.append(first);
+
+    // AHD sets up its tables on first use, which is not thread safe. Decoding
+    // the first band here takes care of it.
+    decodeBand(bands.takeFirst());
+    if (error == DC1394_SUCCESS && !bands.isEmpty())
+        QtConcurrent::blockingMap(bands, decodeBand);
+
+    return static_cast<dc1394error_t>(error.load());
+}
+
+template <typename T>
+dc1394error_t decodePlanar(const T *bayer, T *planes, int width, int height, const BayerParams &params)
+{
+    const size_t planeSize = static_cast<size_t>(width) * height;
+    T *red = planes;
+    T *green = planes + planeSize;
+    T *blue = planes + 2 * planeSize;
+
+    const dc1394error_t result = decodeBands(bayer, width, height, params, [&](const T * rgb, int first, int count)
+    {
+        const size_t start = static_cast<size_t>(first) * width;
+        const size_t end = start + static_cast<size_t>(count) * width;
+        for (size_t i = start; i < end; ++i, rgb += 3)
+        {
+            red[i] = rgb[0];
+            green[i] = rgb[1];
+            blue[i] = rgb[2];
+        }
+    });
+
+    // The row skipped by the offset.
+    if (result == DC1394_SUCCESS && params.offsetY == 1)
+    {
+        const size_t last = planeSize - width;
+        for (T *plane : { red, green, blue })
+            std::fill(plane + last, plane + planeSize, 0);
+    }
+    return result;
+}
+}
+
+namespace BayerDecoder
+{
+dc1394error_t toPlanar(const uint8_t *bayer, uint8_t *planes, int width, int height, const BayerParams &params)
+{
+    return decodePlanar(bayer, planes, width, height, params);
+}
+
+dc1394error_t toPlanar(const uint16_t *bayer, uint16_t *planes, int width, int height, const BayerParams &params)
+{
+    return decodePlanar(bayer, planes, width, height, params);
+}
+
+dc1394error_t toImage(const uint8_t *bayer, QImage *image, int width, int height, const BayerParams &params)
+{
+    if (image->width() != width || image->height() != height || image->format() != QImage::Format_RGB888)
+        return DC1394_INVALID_ARGUMENT_VALUE;
+
+    // Detach here, not from the worker threads.
+    image->bits();
+
+    const dc1394error_t result = decodeBands(bayer, width, height, params, [&](const uint8_t * rgb, int first, int count)
+    {
+        for (int row = first; row < first + count; ++row, rgb += width * 3)
+            memcpy(image->scanLine(row), rgb, width * 3);
+    });
+
+    if (result == DC1394_SUCCESS && params.offsetY == 1)
+        memset(image->scanLine(height - 1), 0, width * 3);
+    return result;
+}
+}
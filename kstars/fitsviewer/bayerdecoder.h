@@ -0,0 +1,46 @@
+/*  Parallel Bayer decoding
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+#include "bayer.h"
+
+#include <cstdint>
+
+class QImage;
+
+/**
+ * @brief Decodes Bayer frames with the dc1394 methods, in parallel horizontal bands.
+ *
+ * Each band is decoded together with a few rows of its neighbours, so that the
+ * result is the same as decoding the whole frame at once, and only the band's own
+ * rows are written out. The output goes straight to its final layout: the RGB
+ * planes of a FITS image, or the scan lines of an RGB888 QImage. The interleaved
+ * band buffers are kept per thread and reused from frame to frame.
+ *
+ * The offsetY param is applied here, as the frame is one row shorter then and the
+ * last output row is cleared. The offsetX param must be applied by the caller.
+ */
+namespace BayerDecoder
+{
+/**
+ * @brief Debayers an 8 bit frame into three planes of width x height samples, red then green then blue.
+ */
+dc1394error_t toPlanar(const uint8_t *bayer, uint8_t *planes, int width, int height, const BayerParams &params);
+
+/**
+ * @brief Debayers a 16 bit frame into three planes of width x height samples, red then green then blue.
+ */
+dc1394error_t toPlanar(const uint16_t *bayer, uint16_t *planes, int width, int height, const BayerParams &params);
+
+/**
+ * @brief Debayers an 8 bit frame into an RGB888 image, which must be width x height.
+ */
+dc1394error_t toImage(const uint8_t *bayer, QImage *image, int width, int height, const BayerParams &params);
+}
@@ -18,14 +18,13 @@
  ***************************************************************************/
 
 #include "fitsdata.h"
+#include "bayerdecoder.h"
 #include "fitsbahtinovdetector.h"
 #include "fitsthresholddetector.h"
 #include "fitsgradientdetector.h"
 #include "fitscentroiddetector.h"
 #include "fitssepdetector.h"
 
-#include "fpack.h"
-
 #include "kstarsdata.h"
 #include "ksutils.h"
 #include "kspaths.h"
@@ -52,8 +51,10 @@
 #include <libraw/libraw.h>
 #endif
 
+#include <atomic>
 #include <cfloat>
 #include <cmath>
+#include <vector>
 
 #include <fits_debug.h>
 
@@ -64,6 +65,10 @@
 #define ZOOM_HIGH_INCR 50
 
 const QString FITSData::m_TemporaryPath = QStandardPaths::writableLocation(QStandardPaths::TempLocation);
+QMutex FITSData::m_SparePlanesMutex;
+uint8_t *FITSData::m_SparePlanes = nullptr;
+uint32_t FITSData::m_SparePlanesSize = 0;
+int FITSData::m_Instances = 0;
 const QStringList RAWFormats = { "cr2", "cr3", "crw", "nef", "raf", "dng", "arw" };
 
 
@@ -74,12 +79,20 @@ FITSData::FITSData(FITSMode fitsMode): m_Mode(fitsMode)
     debayerParams.method  = DC1394_BAYER_METHOD_NEAREST;
     debayerParams.filter  = DC1394_COLOR_FILTER_RGGB;
     debayerParams.offsetX = debayerParams.offsetY = 0;
+
+    QMutexLocker locker(&m_SparePlanesMutex);
+    m_Instances++;
 }
 
 FITSData::FITSData(const FITSData * other)
 {
     qRegisterMetaType<FITSMode>("FITSMode");
 
+    {
+        QMutexLocker locker(&m_SparePlanesMutex);
+        m_Instances++;
+    }
+
     debayerParams.method  = DC1394_BAYER_METHOD_NEAREST;
     debayerParams.filter  = DC1394_COLOR_FILTER_RGGB;
     debayerParams.offsetX = debayerParams.offsetY = 0;
@@ -101,6 +114,17 @@ FITSData::~FITSData()
 
     clearImageBuffers();
 
+    {
+        // The spare planes only serve the next frame, they go with the last image
+        QMutexLocker locker(&m_SparePlanesMutex);
+        if (--m_Instances == 0)
+        {
+            delete[] m_SparePlanes;
+            m_SparePlanes = nullptr;
+            m_SparePlanesSize = 0;
+        }
+    }
+
 #ifdef HAVE_WCSLIB
     if (m_WCSHandle != nullptr)
         wcsvfree(&m_nwcs, &m_WCSHandle);
@@ -182,6 +206,145 @@ bool fitsOpenError(int status, const QString &message, bool silent)
     qCCritical(KSTARS_FITS) << errMessage;
     return false;
 }
+
+// Moves to the first tile compressed image of a file.
+bool moveToCompressedImage(fitsfile *fptr, int *status)
+{
+    int hdus = 0;
+    if (fits_get_num_hdus(fptr, &hdus, status))
+        return false;
+
+    for (int hdu = 1; hdu <= hdus; ++hdu)
+    {
+        if (fits_movabs_hdu(fptr, hdu, nullptr, status))
+            return false;
+        if (fits_is_compressed_image(fptr, status))
+            return true;
+    }
+    return false;
+}
+
+// Type to read and write the stored values of an image with, without any scaling.
+int storedDataType(int bitpix)
+{
+    switch (bitpix)
+    {
+        case BYTE_IMG:
+            return TBYTE;
+        case SHORT_IMG:
+            return TSHORT;
+        case LONG_IMG:
+            return TINT;
+        case LONGLONG_IMG:
+            return TLONGLONG;
+        case FLOAT_IMG:
+            return TFLOAT;
+        case DOUBLE_IMG:
+            return TDOUBLE;
+        default:
+            return 0;
+    }
+}
+
+// Decompresses the tile compressed image of an fpack file into an in-memory FITS file, with the
+// same header. Bands of tiles are decompressed in parallel when cfitsio is reentrant.
+bool decompressToMemory(const QString &filename, fitsfile **memfptr, int *status)
+{
+    fitsfile *packed = nullptr;
+    if (fits_open_diskfile(&packed, filename.toLocal8Bit(), READONLY, status))
+        return false;
+
+    int bitpix = 0, naxis = 0;
+    long naxes[3] = { 1, 1, 1 };
+    long tileRows = 1;
+    if (!moveToCompressedImage(packed, status) ||
+            fits_get_img_type(packed, &bitpix, status) ||
+            fits_get_img_dim(packed, &naxis, status) ||
+            fits_get_img_size(packed, 3, naxes, status))
+    {
+        if (*status == 0)
+            *status = NOT_IMAGE;
+        int closeStatus = 0;
+        fits_close_file(packed, &closeStatus);
+        return false;
+    }
+
+    int tileStatus = 0;
+    fits_read_key(packed, TLONG, "ZTILE2", &tileRows, nullptr, &tileStatus);
+    tileRows = std::max(1L, tileRows);
+
+    const int dataType = storedDataType(bitpix);
+    const size_t rowSize = naxes[0];
+    const long rows = naxis < 2 ? 1 : (naxis < 3 ? naxes[1] : naxes[1] * naxes[2]);
+    const size_t bytesPerValue = std::abs(bitpix) / 8;
+    std::vector<uint8_t> values(rowSize * rows * bytesPerValue);
+
+    // Reads the stored values of rows [first, first + count).
+    auto readRows = [&](fitsfile * fptr, long first, long count, int *readStatus)
+    {
+        int anynull = 0;
+        fits_set_bscale(fptr, 1.0, 0.0, readStatus);
+        return fits_read_img(fptr, dataType, first * rowSize + 1, count * rowSize, nullptr,
+                             values.data() + first * rowSize * bytesPerValue, &anynull, readStatus) == 0;
+    };
+
+    const int nThreads = fits_is_reentrant() ? std::min<long>(QThread::idealThreadCount(), rows / tileRows) : 1;
+    if (nThreads > 1)
+    {
+        // Each band has its own file handle, and whole tiles.
+        const long bandRows = ((rows + nThreads - 1) / nThreads + tileRows - 1) / tileRows * tileRows;
+        std::atomic<int> bandStatus { 0 };
+        QList<QFuture<void>> futures;
+        for (long first = 0; first < rows; first += bandRows)
+        {
+            futures.append(QtConcurrent::run([ =, &readRows, &bandStatus]()
+            {
+                int readStatus = 0;
+                fitsfile *fptr = nullptr;
+                if (fits_open_diskfile(&fptr, filename.toLocal8Bit(), READONLY, &readStatus) == 0)
+                {
+                    if (moveToCompressedImage(fptr, &readStatus))
+                        readRows(fptr, first, std::min(bandRows, rows - first), &readStatus);
+                    int closeStatus = 0;
+                    fits_close_file(fptr, &closeStatus);
+                }
+                if (readStatus)
+                    bandStatus = readStatus;
+            }));
+        }
+        for (QFuture<void> future : futures)
+            future.waitForFinished();
+        *status = bandStatus;
+    }
+    else
+        readRows(packed, 0, rows, status);
+
+    // The header is copied from the compressed image, then the values are written as they were stored.
+    if (*status == 0 && fits_create_file(memfptr, "mem://", status) == 0)
+    {
+        double bscale = 1.0, bzero = 0.0;
+        int keyStatus = 0;
+        fits_img_decompress_header(packed, *memfptr, status);
+        fits_set_bscale(*memfptr, 1.0, 0.0, status);
+        fits_write_img(*memfptr, dataType, 1, rowSize * rows, values.data(), status);
+        fits_read_key_dbl(*memfptr, "BSCALE", &bscale, nullptr, &keyStatus);
+        keyStatus = 0;
+        fits_read_key_dbl(*memfptr, "BZERO", &bzero, nullptr, &keyStatus);
+        fits_set_bscale(*memfptr, bscale, bzero, status);
+        fits_flush_file(*memfptr, status);
+    }
+
+    int closeStatus = 0;
+    fits_close_file(packed, &closeStatus);
+
+    if (*status && *memfptr)
+    {
+        closeStatus = 0;
+        fits_close_file(*memfptr, &closeStatus);
+        *memfptr = nullptr;
+    }
+    return *status == 0;
+}
 }
 
 bool FITSData::privateLoad(const QByteArray &buffer, const QString &extension, bool silent)
@@ -206,32 +369,16 @@ bool FITSData::loadFITSImage(const QByteArray &buffer, const QString &extension,
 
     if (buffer.isEmpty() && extension.contains(".fz"))
     {
-        // Store so we don't lose.
+        // Decompressed in memory, the compressed file stays the one we refer to.
         m_compressedFilename = m_Filename;
+        m_isCompressed = true;
 
-        QString uncompressedFile = QDir::tempPath() + QString("/%1").arg(QUuid::createUuid().toString().remove(
-                                       QRegularExpression("[-{}]")));
-        fpstate fpvar;
-        fp_init (&fpvar);
-        if (fp_unpack(m_Filename.toLocal8Bit().data(), uncompressedFile.toLocal8Bit().data(), fpvar) < 0)
-        {
-            errMessage = i18n("Failed to unpack compressed fits");
-            if (!silent)
-                KSNotification::error(errMessage, i18n("FITS Open"));
-            qCCritical(KSTARS_FITS) << errMessage;
-            return false;
-        }
-
-        // Remove compressed .fz if it was temporary
-        if (m_isTemporary && autoRemoveTemporaryFITS)
-            QFile::remove(m_Filename);
+        if (!decompressToMemory(m_Filename, &fptr, &status))
+            return fitsOpenError(status, i18n("Failed to unpack compressed fits"), silent);
 
-        m_Filename = uncompressedFile;
-        m_isTemporary = true;
-        m_isCompressed = true;
+        m_Statistics.size = QFile(m_Filename).size();
     }
-
-    if (buffer.isEmpty())
+    else if (buffer.isEmpty())
     {
         // Use open diskfile as it does not use extended file names which has problems opening
         // files with [ ] or ( ) in their names.
@@ -892,8 +1039,12 @@ bool FITSData::saveImage(const QString &newFilename)
 
 void FITSData::clearImageBuffers()
 {
-    delete[] m_ImageBuffer;
+    if (m_ImageBuffer != nullptr && m_ImageBuffer == m_PlanesBuffer)
+        releasePlanes(m_ImageBuffer, m_ImageBufferSize);
+    else
+        delete[] m_ImageBuffer;
     m_ImageBuffer = nullptr;
+    m_PlanesBuffer = nullptr;
     //m_BayerBuffer = nullptr;
 }
 
@@ -2724,6 +2875,7 @@ bool FITSData::rotFITS(int rotate, int mirror)
 
     delete[] m_ImageBuffer;
     m_ImageBuffer = rotimage;
+    m_PlanesBuffer = nullptr;
 
     return true;
 }
@@ -3025,6 +3177,7 @@ void FITSData::setImageBuffer(uint8_t * buffer)
 {
     delete[] m_ImageBuffer;
     m_ImageBuffer = buffer;
+    m_PlanesBuffer = nullptr;
 }
 
 bool FITSData::checkDebayer()
@@ -3159,14 +3312,24 @@ bool FITSData::debayer(bool reload)
 
 bool FITSData::debayer_8bit()
 {
-    dc1394error_t error_code;
+    return debayerToPlanes<uint8_t>(TBYTE);
+}
+
+bool FITSData::debayer_16bit()
+{
+    return debayerToPlanes<uint16_t>(TUSHORT);
+}
 
+template <typename T>
+bool FITSData::debayerToPlanes(int dataType)
+{
     uint32_t rgb_size = m_Statistics.samples_per_channel * 3 * m_Statistics.bytesPerPixel;
     uint8_t * destinationBuffer = nullptr;
 
     try
     {
-        destinationBuffer = new uint8_t[rgb_size];
+        // Streams and sequences debayer many frames of the same size, which then share their planes
+        destinationBuffer = takePlanes(rgb_size);
     }
     catch (const std::bad_alloc &e)
     {
@@ -3174,160 +3337,58 @@ bool FITSData::debayer_8bit()
         return false;
     }
 
-    auto * bayer_source_buffer      = reinterpret_cast<uint8_t *>(m_ImageBuffer);
-    auto * bayer_destination_buffer = reinterpret_cast<uint8_t *>(destinationBuffer);
-
-    if (bayer_destination_buffer == nullptr)
-    {
-        KSNotification::error(i18n("Unable to allocate memory for temporary bayer buffer."), i18n("Debayer error"));
-        return false;
-    }
-
-    int ds1394_height = m_Statistics.height;
-    auto dc1394_source = bayer_source_buffer;
-
-    if (debayerParams.offsetY == 1)
-    {
-        dc1394_source += m_Statistics.width;
-        ds1394_height--;
-    }
-    // offsetX == 1 is handled in checkDebayer() and should be 0 here.
-
-    error_code = dc1394_bayer_decoding_8bit(dc1394_source, bayer_destination_buffer, m_Statistics.width, ds1394_height,
-                                            debayerParams.filter,
-                                            debayerParams.method);
+    // The bands are decoded in parallel and written straight into the 3 layers for FITS.
+    // offsetY == 1 is handled by the decoder, and offsetX == 1 in checkDebayer(), so it should be 0 here.
+    dc1394error_t error_code = BayerDecoder::toPlanar(reinterpret_cast<const T *>(m_ImageBuffer),
+                               reinterpret_cast<T *>(destinationBuffer), m_Statistics.width, m_Statistics.height, debayerParams);
 
     if (error_code != DC1394_SUCCESS)
     {
         KSNotification::error(i18n("Debayer failed (%1)", error_code), i18n("Debayer error"));
         m_Statistics.channels = 1;
-        delete[] destinationBuffer;
+        releasePlanes(destinationBuffer, rgb_size);
         return false;
     }
 
-    if (m_ImageBufferSize != rgb_size)
-    {
-        delete[] m_ImageBuffer;
-        try
-        {
-            m_ImageBuffer = new uint8_t[rgb_size];
-        }
-        catch (const std::bad_alloc &e)
-        {
-            delete[] destinationBuffer;
-            KSNotification::error(i18n("Unable to allocate memory for temporary bayer buffer: %1", e.what()), i18n("Debayer error"));
-            return false;
-        }
-
-        m_ImageBufferSize = rgb_size;
-    }
-
-    auto bayered_buffer = reinterpret_cast<uint8_t *>(m_ImageBuffer);
-
-    // Data in R1G1B1, we need to copy them into 3 layers for FITS
-
-    uint8_t * rBuff = bayered_buffer;
-    uint8_t * gBuff = bayered_buffer + (m_Statistics.width * m_Statistics.height);
-    uint8_t * bBuff = bayered_buffer + (m_Statistics.width * m_Statistics.height * 2);
-
-    int imax = m_Statistics.samples_per_channel * 3 - 3;
-    for (int i = 0; i <= imax; i += 3)
-    {
-        *rBuff++ = bayer_destination_buffer[i];
-        *gBuff++ = bayer_destination_buffer[i + 1];
-        *bBuff++ = bayer_destination_buffer[i + 2];
-    }
+    // The image buffer holds the previous planes when debayering again
+    clearImageBuffers();
+    m_ImageBuffer = destinationBuffer;
+    m_PlanesBuffer = destinationBuffer;
+    m_ImageBufferSize = rgb_size;
 
     m_Statistics.channels = (m_Mode == FITS_NORMAL) ? 3 : 1;
-    m_Statistics.dataType = TBYTE;
-    delete[] destinationBuffer;
+    m_Statistics.dataType = dataType;
     return true;
 }
 
-bool FITSData::debayer_16bit()
+uint8_t *FITSData::takePlanes(uint32_t size)
 {
-    dc1394error_t error_code;
-
-    uint32_t rgb_size = m_Statistics.samples_per_channel * 3 * m_Statistics.bytesPerPixel;
-    uint8_t *destinationBuffer = nullptr;
-    try
     {
-        destinationBuffer = new uint8_t[rgb_size];
-    }
-    catch (const std::bad_alloc &e)
-    {
-        KSNotification::error(i18n("Unable to allocate memory for temporary bayer buffer: %1", e.what()), i18n("Debayer error"));
-        return false;
-    }
-
-    auto * bayer_source_buffer      = reinterpret_cast<uint16_t *>(m_ImageBuffer);
-    auto * bayer_destination_buffer = reinterpret_cast<uint16_t *>(destinationBuffer);
-
-    if (bayer_destination_buffer == nullptr)
-    {
-        KSNotification::error(i18n("Unable to allocate memory for temporary bayer buffer."), i18n("Debayer error"));
-        return false;
-    }
-
-    int ds1394_height = m_Statistics.height;
-    auto dc1394_source = bayer_source_buffer;
-
-    if (debayerParams.offsetY == 1)
-    {
-        dc1394_source += m_Statistics.width;
-        ds1394_height--;
-    }
-    // offsetX == 1 is handled in checkDebayer() and should be 0 here.
-
-    error_code = dc1394_bayer_decoding_16bit(dc1394_source, bayer_destination_buffer, m_Statistics.width, ds1394_height,
-                 debayerParams.filter,
-                 debayerParams.method, 16);
-
-    if (error_code != DC1394_SUCCESS)
-    {
-        KSNotification::error(i18n("Debayer failed (%1)", error_code), i18n("Debayer error"));
-        m_Statistics.channels = 1;
-        delete[] destinationBuffer;
-        return false;
-    }
-
-    if (m_ImageBufferSize != rgb_size)
-    {
-        delete[] m_ImageBuffer;
-        try
-        {
-            m_ImageBuffer = new uint8_t[rgb_size];
-        }
-        catch (const std::bad_alloc &e)
+        QMutexLocker locker(&m_SparePlanesMutex);
+        if (m_SparePlanes != nullptr && m_SparePlanesSize == size)
         {
-            delete[] destinationBuffer;
-            KSNotification::error(i18n("Unable to allocate memory for temporary bayer buffer: %1", e.what()), i18n("Debayer error"));
-            return false;
+            uint8_t *planes = m_SparePlanes;
+            m_SparePlanes = nullptr;
+            m_SparePlanesSize = 0;
+            return planes;
         }
-
-        m_ImageBufferSize = rgb_size;
     }
 
-    auto bayered_buffer = reinterpret_cast<uint16_t *>(m_ImageBuffer);
-
-    // Data in R1G1B1, we need to copy them into 3 layers for FITS
-
-    uint16_t * rBuff = bayered_buffer;
-    uint16_t * gBuff = bayered_buffer + (m_Statistics.width * m_Statistics.height);
-    uint16_t * bBuff = bayered_buffer + (m_Statistics.width * m_Statistics.height * 2);
+    return new uint8_t[size];
+}
 
-    int imax = m_Statistics.samples_per_channel * 3 - 3;
-    for (int i = 0; i <= imax; i += 3)
+void FITSData::releasePlanes(uint8_t *planes, uint32_t size)
+{
+    if (size > MaxSparePlanesSize)
     {
-        *rBuff++ = bayer_destination_buffer[i];
-        *gBuff++ = bayer_destination_buffer[i + 1];
-        *bBuff++ = bayer_destination_buffer[i + 2];
+        delete[] planes;
+        return;
     }
 
-    m_Statistics.channels = (m_Mode == FITS_NORMAL) ? 3 : 1;
-    m_Statistics.dataType = TUSHORT;
-    delete[] destinationBuffer;
-    return true;
+    QMutexLocker locker(&m_SparePlanesMutex);
+    delete[] m_SparePlanes;
+    m_SparePlanes = planes;
+    m_SparePlanesSize = size;
 }
 
 double FITSData::getADU() const
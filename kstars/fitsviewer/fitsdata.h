@@ -42,6 +42,7 @@
 #include <fitsio.h>
 
 #include <QFuture>
+#include <QMutex>
 #include <QObject>
 #include <QRect>
 #include <QVariant>
@@ -502,6 +503,14 @@ class FITSData : public QObject
         // Templated functions
         template <typename T>
         bool debayer();
+        template <typename T>
+        bool debayerToPlanes(int dataType);
+
+        // Debayered planes of the given size in bytes, reusing those of a released frame if they fit
+        static uint8_t *takePlanes(uint32_t size);
+        // Keeps the planes of a released frame for the next frame of the same size and bit depth,
+        // unless they are larger than MaxSparePlanesSize
+        static void releasePlanes(uint8_t *planes, uint32_t size);
 
         template <typename T>
         bool rotFITS(int rotate, int mirror);
@@ -586,6 +595,8 @@ class FITSData : public QObject
         Edge *m_SelectedHFRStar { nullptr };
 
         //uint8_t *m_BayerBuffer { nullptr };
+        /// Debayered planes, while they are the image buffer
+        uint8_t *m_PlanesBuffer { nullptr };
         /// Bayer parameters
         BayerParams debayerParams;
 
@@ -611,4 +622,12 @@ class FITSData : public QObject
         QString lastError;
 
         static const QString m_TemporaryPath;
+
+        /// Debayered planes of the last released frame, freed with the last FITSData
+        static QMutex m_SparePlanesMutex;
+        static uint8_t *m_SparePlanes;
+        static uint32_t m_SparePlanesSize;
+        static int m_Instances;
+        /// Larger planes are not worth keeping around, 16-bit RGB planes of about 44 Mpixels
+        static constexpr uint32_t MaxSparePlanesSize { 256 * 1024 * 1024 };
 };
@@ -626,6 +626,7 @@ void FITSHistogramCommand::redo()
 {
     FITSView * image = tab->getView();
     FITSData * imageData = image->getImageData();
+    image->stopDisplayStretch();
 
     uint8_t const * image_buffer = imageData->getImageBuffer();
     uint8_t * buffer = nullptr;
@@ -715,6 +716,7 @@ void FITSHistogramCommand::undo()
 {
     FITSView * image = tab->getView();
     FITSData * imageData = image->getImageData();
+    image->stopDisplayStretch();
 
     QApplication::setOverrideCursor(Qt::WaitCursor);
 
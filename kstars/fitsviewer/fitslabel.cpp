@@ -26,6 +26,8 @@
 #include "indi/indilistener.h"
 #endif
 
+#include <QPainter>
+#include <QPaintEvent>
 #include <QScrollBar>
 #include <QToolTip>
 
@@ -53,6 +55,21 @@ bool FITSLabel::getMouseButtonDown()
     return mouseButtonDown;
 }
 
+/**
+Large images have no pixmap, the view paints the tiles and overlays that are exposed.
+ */
+void FITSLabel::paintEvent(QPaintEvent *e)
+{
+    if (!view->isLargeImage())
+    {
+        QLabel::paintEvent(e);
+        return;
+    }
+
+    QPainter painter(this);
+    view->paintTiles(&painter, e->rect());
+}
+
 /**
 This method was added to make the panning function work.
 If the mouse button is released, it resets mouseButtonDown variable and the mouse cursor.
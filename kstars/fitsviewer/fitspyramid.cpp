@@ -0,0 +1,196 @@
+/*  FITS tiled display pyramid
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include "fitspyramid.h"
+
+#include <QPainter>
+#include <QtConcurrent>
+
+#include <cmath>
+
+namespace
+{
+// Default tile budget, enough for a few screens of tiles.
+constexpr int defaultCacheKB = 64 * 1024;
+// Output rows stretched by each task of a level.
+constexpr int bandRows = 64;
+
+bool sameParams(const StretchParams1Channel &a, const StretchParams1Channel &b)
+{
+    return a.shadows == b.shadows && a.highlights == b.highlights && a.midtones == b.midtones &&
+           a.shadows_expansion == b.shadows_expansion && a.highlights_expansion == b.highlights_expansion;
+}
+
+bool sameParams(const StretchParams &a, const StretchParams &b)
+{
+    return sameParams(a.grey_red, b.grey_red) && sameParams(a.green, b.green) && sameParams(a.blue, b.blue);
+}
+}
+
+FITSPyramid::FITSPyramid()
+{
+    m_Tiles.setMaxCost(defaultCacheKB);
+}
+
+FITSPyramid::~FITSPyramid()
+{
+    clear();
+}
+
+void FITSPyramid::setSource(const uint8_t *buffer, int width, int height, int channels, int dataType,
+                            const StretchParams &params, int sampling)
+{
+    if (!isEmpty() && buffer == m_Buffer && width == m_Width && height == m_Height && channels == m_Channels &&
+            dataType == m_DataType && sampling == m_Sampling && sameParams(params, m_Params))
+        return;
+
+    clear();
+    if (buffer == nullptr || width <= 0 || height <= 0)
+        return;
+
+    m_Buffer = buffer;
+    m_Width = width;
+    m_Height = height;
+    m_Channels = channels;
+    m_DataType = dataType;
+    m_Sampling = std::max(1, sampling);
+    m_Params = params;
+
+    m_Stretch.reset(new Stretch(width, height, channels, dataType));
+    m_Stretch->setParams(params);
+    m_Stretch->recalculateInputRange(buffer);
+
+    // Add levels until the whole image fits in one tile.
+    m_Levels = 1;
+    while (((std::max(width, height) - 1) / (m_Sampling << (m_Levels - 1))) >= TileSize)
+        m_Levels++;
+
+    m_Images.assign(m_Levels, QImage());
+    m_Finest = m_Levels;
+    m_Abort = false;
+    m_Build = QtConcurrent::run(this, &FITSPyramid::build);
+}
+
+void FITSPyramid::clear()
+{
+    m_Abort = true;
+    m_Build.waitForFinished();
+    m_Build = QFuture<QImage>();
+
+    m_Tiles.clear();
+    m_Images.clear();
+    m_Stretch.reset();
+    m_Buffer = nullptr;
+    m_Width = m_Height = 0;
+    m_Levels = 0;
+    m_Finest = 0;
+}
+
+QImage FITSPyramid::build()
+{
+    for (int level = m_Levels - 1; level >= 0; --level)
+    {
+        const int sampling = m_Sampling << level;
+        QImage image((m_Width + sampling - 1) / sampling, (m_Height + sampling - 1) / sampling,
+                     m_Channels == 1 ? QImage::Format_Grayscale8 : QImage::Format_RGB32);
+
+        // Each band stretches straight into its rows of the level.
+        uchar *bits = image.bits();
+        const int bytesPerLine = image.bytesPerLine();
+        QVector<int> bands;
+        for (int row = 0; row < image.height(); row += bandRows)
+            bands.append(row);
+
+        QtConcurrent::blockingMap(bands, [&](int row)
+        {
+            if (m_Abort)
+                return;
+
+            const int rows = std::min(bandRows, image.height() - row);
+            const QRect source = QRect(0, row * sampling, m_Width, rows * sampling).intersected(QRect(0, 0, m_Width, m_Height));
+            QImage band(bits + row * bytesPerLine, image.width(), rows, bytesPerLine, image.format());
+            m_Stretch->run(m_Buffer, &band, source, sampling);
+        });
+
+        if (m_Abort)
+            return QImage();
+
+        m_Images[level] = image;
+        m_Finest = level;
+    }
+
+    return m_Images[0];
+}
+
+int FITSPyramid::levelForScale(double scale) const
+{
+    int level = 0;
+    while (level + 1 < m_Levels && scale * (m_Sampling << (level + 1)) <= 1.0)
+        level++;
+    return level;
+}
+
+QRect FITSPyramid::tileSourceRect(int level, int x, int y) const
+{
+    const int span = TileSize * (m_Sampling << level);
+    return QRect(x * span, y * span, span, span).intersected(QRect(0, 0, m_Width, m_Height));
+}
+
+void FITSPyramid::paint(QPainter *painter, const QRect &exposed, double scale)
+{
+    if (isEmpty() || scale <= 0)
+        return;
+
+    // Until its level is built, paint the finest level built so far.
+    const int level = std::max(levelForScale(scale), m_Finest.load());
+    if (level >= m_Levels)
+        return;
+
+    const QImage &image = m_Images[level];
+    const int sampling = m_Sampling << level;
+    const int span = TileSize * sampling;
+    const int columns = (m_Width + span - 1) / span;
+    const int rows = (m_Height + span - 1) / span;
+
+    // Tiles that intersect the exposed area.
+    const int left = std::max(0, static_cast<int>(std::floor(exposed.left() / scale / span)));
+    const int top = std::max(0, static_cast<int>(std::floor(exposed.top() / scale / span)));
+    const int right = std::min(columns - 1, static_cast<int>(std::floor((exposed.right() + 1) / scale / span)));
+    const int bottom = std::min(rows - 1, static_cast<int>(std::floor((exposed.bottom() + 1) / scale / span)));
+
+    painter->save();
+    if (scale * sampling != 1.0)
+        painter->setRenderHint(QPainter::SmoothPixmapTransform);
+    for (int y = top; y <= bottom; ++y)
+    {
+        for (int x = left; x <= right; ++x)
+        {
+            const quint64 key = tileKey(level, x, y);
+            QPixmap pixmap;
+            QPixmap *cached = m_Tiles.object(key);
+            if (cached != nullptr)
+                pixmap = *cached;
+            else
+            {
+                // Keep the tiles of this paint, even if the cache can't hold all of them.
+                pixmap = QPixmap::fromImage(image.copy(QRect(x * TileSize, y * TileSize, TileSize, TileSize)
+                                                       .intersected(image.rect())));
+                m_Tiles.insert(key, new QPixmap(pixmap), std::max(1, pixmap.width() * pixmap.height() * 4 / 1024));
+            }
+
+            // Round the tile edges, not the tile sizes, so that neighbours meet exactly.
+            const QRect source = tileSourceRect(level, x, y);
+            const QPoint topLeft(std::lround(source.left() * scale), std::lround(source.top() * scale));
+            const QPoint bottomRight(std::lround((source.right() + 1) * scale) - 1,
+                                     std::lround((source.bottom() + 1) * scale) - 1);
+            painter->drawPixmap(QRect(topLeft, bottomRight), pixmap);
+        }
+    }
+    painter->restore();
+}
@@ -0,0 +1,129 @@
+/*  FITS tiled display pyramid
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+#include "stretch.h"
+
+#include <QCache>
+#include <QFuture>
+#include <QPixmap>
+#include <QRect>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class QPainter;
+
+/**
+ * @class FITSPyramid
+ * @short Multi-resolution levels of a stretched image, for displaying large images.
+ *
+ * Level 0 holds the image at the preview sampling, and each following level samples
+ * every other pixel of the previous one, the same way FITSView's preview sampling
+ * does. The levels are stretched once per frame and stretch, on a worker thread and
+ * in parallel bands, from the coarsest to the finest. Until the level matching the
+ * zoom is ready, the finest level built so far is painted.
+ *
+ * Painting cuts the levels into square tiles, kept as pixmaps in a cache whose size
+ * follows the size of the screen area being painted, not the size of the sensor.
+ *
+ * The raw data must not change while the levels are built: call clear() first.
+ * Painting must be done on the GUI thread.
+ */
+class FITSPyramid
+{
+    public:
+        // Width and height of the tiles, in output pixels.
+        static constexpr int TileSize { 256 };
+
+        FITSPyramid();
+        ~FITSPyramid();
+
+        /**
+         * @brief setSource Set the raw data to display and how to stretch it, and start building the levels.
+         * @param buffer the raw data, which must outlive its use by the pyramid.
+         * @param sampling the sampling of level 0, see FITSView::setPreviewSampling.
+         * @note Nothing is rebuilt if neither the data nor the parameters changed.
+         */
+        void setSource(const uint8_t *buffer, int width, int height, int channels, int dataType,
+                       const StretchParams &params, int sampling = 1);
+        // Stops building the levels, and drops them and the source.
+        void clear();
+
+        bool isEmpty() const
+        {
+            return m_Buffer == nullptr;
+        }
+
+        // Returns the level to paint at the given display scale, that is the coarsest level
+        // whose resolution is still at least the display resolution.
+        int levelForScale(double scale) const;
+
+        /**
+         * @brief paint Paint the part of the image visible in a widget.
+         * @param painter painter of a widget showing the whole image at the given scale.
+         * @param exposed the part of the widget to paint, in widget coordinates.
+         * @param scale display pixels per image pixel.
+         */
+        void paint(QPainter *painter, const QRect &exposed, double scale);
+
+        /**
+         * @brief image Level 0, the whole image stretched at the preview sampling.
+         * @return a future, finished once all the levels are built. Its result is a null image
+         * if the pyramid was cleared before.
+         */
+        QFuture<QImage> image() const
+        {
+            return m_Build;
+        }
+
+        // Sets how much memory the cached tiles may use.
+        void setCacheLimit(int kilobytes)
+        {
+            m_Tiles.setMaxCost(kilobytes);
+        }
+
+        // Number of levels, the last one fitting in a single tile.
+        int levels() const
+        {
+            return m_Levels;
+        }
+
+    private:
+        static quint64 tileKey(int level, int x, int y)
+        {
+            return (static_cast<quint64>(level) << 48) | (static_cast<quint64>(y) << 24) | static_cast<quint64>(x);
+        }
+        // Part of the raw image covered by a tile.
+        QRect tileSourceRect(int level, int x, int y) const;
+        // Stretches all the levels, coarsest first. Runs on a worker thread.
+        QImage build();
+
+        const uint8_t *m_Buffer { nullptr };
+        int m_Width { 0 };
+        int m_Height { 0 };
+        int m_Channels { 1 };
+        int m_DataType { 0 };
+        int m_Sampling { 1 };
+        int m_Levels { 0 };
+        StretchParams m_Params;
+        std::unique_ptr<Stretch> m_Stretch;
+
+        // Written by the build, each level once before m_Finest is lowered to it.
+        std::vector<QImage> m_Images;
+        // Finest level built so far, m_Levels if none.
+        std::atomic<int> m_Finest { 0 };
+        std::atomic<bool> m_Abort { false };
+        QFuture<QImage> m_Build;
+
+        // Cost is in kilobytes.
+        QCache<quint64, QPixmap> m_Tiles;
+};
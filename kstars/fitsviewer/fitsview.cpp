@@ -13,6 +13,7 @@
 
 #include "fitsdata.h"
 #include "fitslabel.h"
+#include "fitspyramid.h"
 #include "kspopupmenu.h"
 #include "kstarsdata.h"
 #include "ksutils.h"
@@ -49,7 +50,6 @@
 #define ZOOM_MAX       300
 #define ZOOM_LOW_INCR  10
 #define ZOOM_HIGH_INCR 50
-#define FONT_SIZE      14
 
 namespace
 {
@@ -80,11 +80,28 @@ void ComputeGBStretchParams(const StretchParams &newParams, StretchParams* param
 
 }  // namespace
 
-// Runs the stretch checking the variables to see which parameters to use.
+// Computes new auto-stretch params if we're stretching with automatic parameters.
+void FITSView::updateStretchParams()
+{
+    if (imageData.isNull() || !stretchImage || !autoStretch)
+        return;
+    Stretch stretch(static_cast<int>(imageData->width()),
+                    static_cast<int>(imageData->height()),
+                    imageData->channels(), imageData->getStatistics().dataType);
+    stretchParams = stretch.computeParams(imageData->getImageBuffer());
+}
+
+// The params the image is displayed with.
 // We call stretch even if we're not stretching, as the stretch code still
 // converts the image to the uint8 output image which will be displayed.
 // In that case, it will use an identity stretch.
-void FITSView::doStretch(QImage *outputImage)
+StretchParams FITSView::displayStretchParams() const
+{
+    return stretchImage ? stretchParams : StretchParams();
+}
+
+// Runs the stretch with the current parameters, see updateStretchParams().
+void FITSView::doStretch(QImage *outputImage) const
 {
     if (outputImage->isNull() || imageData.isNull())
         return;
@@ -92,20 +109,7 @@ void FITSView::doStretch(QImage *outputImage)
                     static_cast<int>(imageData->height()),
                     imageData->channels(), imageData->getStatistics().dataType);
 
-    StretchParams tempParams;
-    if (!stretchImage)
-        tempParams = StretchParams();  // Keeping it linear
-    else if (autoStretch)
-    {
-        // Compute new auto-stretch params.
-        stretchParams = stretch.computeParams(imageData->getImageBuffer());
-        tempParams = stretchParams;
-    }
-    else
-        // Use the existing stretch params.
-        tempParams = stretchParams;
-
-    stretch.setParams(tempParams);
+    stretch.setParams(displayStretchParams());
     stretch.run(imageData->getImageBuffer(), outputImage, m_PreviewSampling);
 }
 
@@ -188,6 +192,7 @@ FITSView::FITSView(QWidget * parent, FITSMode fitsMode, FITSScale filterType) :
     grabGesture(Qt::PinchGesture);
 
     image_frame.reset(new FITSLabel(this));
+    pyramid.reset(new FITSPyramid());
     filter = filterType;
     mode   = fitsMode;
 
@@ -204,6 +209,11 @@ FITSView::FITSView(QWidget * parent, FITSMode fitsMode, FITSScale filterType) :
     connect(&wcsWatcher, SIGNAL(finished()), this, SLOT(syncWCSState()));
 
     connect(&fitsWatcher, &QFutureWatcher<bool>::finished, this, &FITSView::loadInFrame);
+    // Paint at full resolution once the levels of a large image are built.
+    connect(&pyramidWatcher, &QFutureWatcher<QImage>::finished, image_frame.get(), [this]()
+    {
+        image_frame->update();
+    });
 
     image_frame->setMouseTracking(true);
     setCursorMode(
@@ -224,6 +234,47 @@ FITSView::~FITSView()
 {
     fitsWatcher.waitForFinished();
     wcsWatcher.waitForFinished();
+    pyramid->clear();
+}
+
+QImage FITSView::getDisplayImage() const
+{
+    if (!pyramid->isEmpty())
+        return pyramid->image().result();
+
+    return rawImage;
+}
+
+QFuture<QImage> FITSView::getDisplayImageFuture() const
+{
+    if (!pyramid->isEmpty())
+        return pyramid->image();
+
+    QFutureInterface<QImage> image(QFutureInterfaceBase::Started);
+    image.reportFinished(&rawImage);
+    return image.future();
+}
+
+void FITSView::stopDisplayStretch()
+{
+    pyramid->clear();
+}
+
+const QPixmap &FITSView::getDisplayPixmap()
+{
+    // Large images are painted tile by tile, so only render the full image with its overlays on request.
+    if (displayPixmap.isNull() && isLargeImage() && displayPixmap.convertFromImage(getDisplayImage()))
+    {
+        QPainter painter(&displayPixmap);
+        if (m_PreviewSampling == 1)
+        {
+            m_FullResolutionOverlay = true;
+            drawOverlay(&painter, 1.0);
+            drawStarFilter(&painter, 1.0);
+            m_FullResolutionOverlay = false;
+        }
+    }
+    return displayPixmap;
 }
 
 /**
@@ -314,6 +365,8 @@ void FITSView::loadFile(const QString &inFilename, bool silent)
     fitsWatcher.waitForFinished();
     // In case loadWCS is still running for previous image data, let's wait until it's over
     wcsWatcher.waitForFinished();
+    // The display pyramid reads the previous image data
+    pyramid->clear();
 
     //    delete imageData;
     //    imageData = nullptr;
@@ -340,6 +393,8 @@ bool FITSView::loadData(const QSharedPointer<FITSData> &data)
 
     // In case loadWCS is still running for previous image data, let's wait until it's over
     wcsWatcher.waitForFinished();
+    // The display pyramid reads the previous image data
+    pyramid->clear();
 
     //    if (imageData != nullptr)
     //    {
@@ -471,7 +526,7 @@ bool FITSView::saveImage(const QString &newFilename)
     const QString ext = QFileInfo(newFilename).suffix();
     if (QImageReader::supportedImageFormats().contains(ext.toLatin1()))
     {
-        rawImage.save(newFilename, ext.toLatin1().constData());
+        getDisplayImage().save(newFilename, ext.toLatin1().constData());
         return true;
     }
 
@@ -615,9 +670,23 @@ bool FITSView::rescale(FITSZoom type)
             break;
     }
 
-    initDisplayImage();
+    updateStretchParams();
+    if (isLargeImage())
+    {
+        // Large images are painted from a pyramid of levels, stretched in the background.
+        rawImage = QImage();
+        pyramid->setSource(imageData->getImageBuffer(), imageData->width(), imageData->height(),
+                           imageData->channels(), imageData->getStatistics().dataType, displayStretchParams(),
+                           m_PreviewSampling);
+        pyramidWatcher.setFuture(pyramid->image());
+    }
+    else
+    {
+        pyramid->clear();
+        initDisplayImage();
+        doStretch(&rawImage);
+    }
     image_frame->setScaledContents(true);
-    doStretch(&rawImage);
     setWidget(image_frame.get());
 
     // This is needed by fitstab, even if the zoom doesn't change, to change the stretch UI.
@@ -685,7 +754,7 @@ void FITSView::ZoomOut()
 
 void FITSView::ZoomToFit()
 {
-    if (rawImage.isNull() == false)
+    if (imageData)
     {
         rescale(ZOOM_FIT_WINDOW);
         updateFrame();
@@ -705,31 +774,23 @@ int FITSView::filterStars()
 }
 
 // isImageLarge() returns whether we use the large-image rendering strategy or the small-image strategy.
-// See the comment below in getScale() for details.
-bool FITSView::isLargeImage()
+// See the comment below in updateFrame() for details.
+bool FITSView::isLargeImage() const
 {
+    if (imageData.isNull())
+        return false;
     constexpr int largeImageNumPixels = 1000 * 1000;
-    return rawImage.width() * rawImage.height() >= largeImageNumPixels;
+    const int w = (imageData->width() + m_PreviewSampling - 1) / m_PreviewSampling;
+    const int h = (imageData->height() + m_PreviewSampling - 1) / m_PreviewSampling;
+    return w * h >= largeImageNumPixels;
 }
 
-// getScale() is related to the image and overlay rendering strategy used.
-// If we're using a pixmap apprpriate for a large image, where we draw and render on a pixmap that's the image size
-// and we let the QLabel deal with scaling and zooming, then the scale is 1.0.
-// With smaller images, where memory use is not as severe, we create a pixmap that's the size of the scaled image
-// and get scale returns the ratio of that pixmap size to the image size.
+// getScale() returns the ratio of the surface the overlays are drawn on to the image size.
+// Both rendering strategies draw the overlays at the displayed size, except when
+// getDisplayPixmap() renders a large image at full resolution.
 double FITSView::getScale()
 {
-    return isLargeImage() ? 1.0 : currentZoom / ZOOM_DEFAULT;
-}
-
-// scaleSize() is only used with the large-image rendering strategy. It may increase the line
-// widths or font sizes, as we draw lines and render text on the full image and when zoomed out,
-// these sizes may be too small.
-double FITSView::scaleSize(double size)
-{
-    if (!isLargeImage())
-        return size;
-    return currentZoom > 100.0 ? size : std::round(size * 100.0 / currentZoom);
+    return m_FullResolutionOverlay ? 1.0 : currentZoom / ZOOM_DEFAULT;
 }
 
 void FITSView::updateFrame()
@@ -739,8 +800,8 @@ void FITSView::updateFrame()
 
     // We employ two schemes for managing the image and its overlays, depending on the size of the image
     // and whether we need to therefore conserve memory. The small-image strategy explicitly scales up
-    // the image, and writes overlays on the scaled pixmap. The large-image strategy uses a pixmap that's
-    // the size of the image itself, never scaling that up.
+    // the image, and writes overlays on the scaled pixmap. The large-image strategy never scales the
+    // whole image: FITSLabel paints the visible tiles of the pyramid, and the overlays on top of them.
     if (isLargeImage())
         updateFrameLargeImage();
     else
@@ -750,24 +811,29 @@ void FITSView::updateFrame()
 
 void FITSView::updateFrameLargeImage()
 {
-    if (!displayPixmap.convertFromImage(rawImage))
-        return;
+    // Rendered again on request, see getDisplayPixmap().
+    displayPixmap = QPixmap();
+    image_frame->clear();
 
-    QPainter painter(&displayPixmap);
+    // Keep a few screens worth of tiles.
+    const int viewportKB = viewport()->width() * viewport()->height() * 4 / 1024;
+    pyramid->setCacheLimit(std::max(32 * 1024, 4 * viewportKB));
 
-    // Possibly scale the fonts as we're drawing on the full image, not just the visible part of the scroll window.
-    QFont font = painter.font();
-    font.setPixelSize(scaleSize(FONT_SIZE));
-    painter.setFont(font);
+    image_frame->resize(currentWidth, currentHeight);
+    image_frame->update();
+}
+
+// Paints the exposed part of a large image, and its overlays, on image_frame.
+void FITSView::paintTiles(QPainter *painter, const QRect &exposed)
+{
+    const double scale = currentZoom / ZOOM_DEFAULT;
+    pyramid->paint(painter, exposed, scale);
 
     if (m_PreviewSampling == 1)
     {
-        drawOverlay(&painter, 1.0);
-        drawStarFilter(&painter, 1.0);
+        drawOverlay(painter, scale);
+        drawStarFilter(painter, scale);
     }
-    image_frame->setPixmap(displayPixmap);
-
-    image_frame->resize(((m_PreviewSampling * currentZoom) / 100.0) * image_frame->pixmap()->size());
 }
 
 void FITSView::updateFrameSmallImage()
@@ -798,7 +864,7 @@ void FITSView::drawStarFilter(QPainter *painter, double scale)
     int const outerRadius = std::lround(diagonal * starFilter.outerRadius);
     QPoint const center(w / 2, h / 2);
     painter->save();
-    painter->setPen(QPen(Qt::blue, scaleSize(1), Qt::DashLine));
+    painter->setPen(QPen(Qt::blue, 1, Qt::DashLine));
     painter->setOpacity(0.7);
     painter->setBrush(QBrush(Qt::transparent));
     painter->drawEllipse(center, outerRadius, outerRadius);
@@ -878,31 +944,31 @@ void FITSView::drawClipping(QPainter *painter)
     {
         case TBYTE:
             drawClip(reinterpret_cast<uint8_t const*>(input), imageData->channels(), painter, width, height, BYTE_CLIP,
-                     scaleSize(1));
+                     1);
             break;
         case TSHORT:
             drawClip(reinterpret_cast<short const*>(input), imageData->channels(), painter, width, height, SHORT_CLIP,
-                     scaleSize(1));
+                     1);
             break;
         case TUSHORT:
             drawClip(reinterpret_cast<unsigned short const*>(input), imageData->channels(), painter, width, height, USHORT_CLIP,
-                     scaleSize(1));
+                     1);
             break;
         case TLONG:
             drawClip(reinterpret_cast<long const*>(input), imageData->channels(), painter, width, height, USHORT_CLIP,
-                     scaleSize(1));
+                     1);
             break;
         case TFLOAT:
             drawClip(reinterpret_cast<float const*>(input), imageData->channels(), painter, width, height, FLOAT_CLIP,
-                     scaleSize(1));
+                     1);
             break;
         case TLONGLONG:
             drawClip(reinterpret_cast<long long const*>(input), imageData->channels(), painter, width, height, USHORT_CLIP,
-                     scaleSize(1));
+                     1);
             break;
         case TDOUBLE:
             drawClip(reinterpret_cast<double const*>(input), imageData->channels(), painter, width, height, FLOAT_CLIP,
-                     scaleSize(1));
+                     1);
             break;
         default:
             break;
@@ -965,7 +1031,7 @@ void FITSView::updateMode(FITSMode fmode)
 void FITSView::drawMarker(QPainter * painter, double scale)
 {
     painter->setPen(QPen(QColor(KStarsData::Instance()->colorScheme()->colorNamed("TargetColor")),
-                         scaleSize(2)));
+                         2));
     painter->setBrush(Qt::NoBrush);
     const float pxperdegree = scale * (57.3 / 1.8);
 
@@ -1004,9 +1070,9 @@ bool FITSView::drawHFR(QPainter * painter, const QString &hfr, int x, int y)
     // Render the HFR text only if it can be displayed entirely
     if (boundingRect.contains(hfrRect))
     {
-        painter->setPen(QPen(Qt::red, scaleSize(3)));
+        painter->setPen(QPen(Qt::red, 3));
         painter->drawText(hfrBottomLeft, hfr);
-        painter->setPen(QPen(Qt::red, scaleSize(2)));
+        painter->setPen(QPen(Qt::red, 2));
         return true;
     }
     return false;
@@ -1021,13 +1087,11 @@ void FITSView::drawStarCentroid(QPainter * painter, double scale)
     if (showStarsHFR)
     {
         // If we need to print the HFR out, give an arbitrarily sized font to the painter
-        if (isLargeImage())
-            fontSize = scaleSize(painterFont.pointSizeF());
         painterFont.setPointSizeF(fontSize);
         painter->setFont(painterFont);
     }
 
-    painter->setPen(QPen(Qt::red, scaleSize(2)));
+    painter->setPen(QPen(Qt::red, 2));
 
     for (auto const &starCenter : imageData->getStarCenters())
     {
@@ -1045,18 +1109,18 @@ void FITSView::drawStarCentroid(QPainter * painter, double scale)
         if (bEdge != nullptr)
         {
             // Draw lines of diffraction pattern
-            painter->setPen(QPen(Qt::red, scaleSize(2)));
+            painter->setPen(QPen(Qt::red, 2));
             painter->drawLine(bEdge->line[0].x1() * scale, bEdge->line[0].y1() * scale,
                               bEdge->line[0].x2() * scale, bEdge->line[0].y2() * scale);
-            painter->setPen(QPen(Qt::green, scaleSize(2)));
+            painter->setPen(QPen(Qt::green, 2));
             painter->drawLine(bEdge->line[1].x1() * scale, bEdge->line[1].y1() * scale,
                               bEdge->line[1].x2() * scale, bEdge->line[1].y2() * scale);
-            painter->setPen(QPen(Qt::darkGreen, scaleSize(2)));
+            painter->setPen(QPen(Qt::darkGreen, 2));
             painter->drawLine(bEdge->line[2].x1() * scale, bEdge->line[2].y1() * scale,
                               bEdge->line[2].x2() * scale, bEdge->line[2].y2() * scale);
 
             // Draw center circle
-            painter->setPen(QPen(Qt::white, scaleSize(2)));
+            painter->setPen(QPen(Qt::white, 2));
             painter->drawEllipse(xc, yc, w, w);
 
             // Draw offset circle
@@ -1064,11 +1128,11 @@ void FITSView::drawStarCentroid(QPainter * painter, double scale)
             QPointF offsetVector = (bEdge->offset - QPointF(starCenter->x, starCenter->y)) * factor;
             int const xo = std::round((starCenter->x + offsetVector.x() - starCenter->width / 2.0f) * scale);
             int const yo = std::round((starCenter->y + offsetVector.y() - starCenter->width / 2.0f) * scale);
-            painter->setPen(QPen(Qt::red, scaleSize(2)));
+            painter->setPen(QPen(Qt::red, 2));
             painter->drawEllipse(xo, yo, w, w);
 
             // Draw line between center circle and offset circle
-            painter->setPen(QPen(Qt::red, scaleSize(2)));
+            painter->setPen(QPen(Qt::red, 2));
             painter->drawLine(xc + hw, yc + hw, xo + hw, yo + hw);
         }
         else
@@ -1103,7 +1167,7 @@ void FITSView::drawStarCentroid(QPainter * painter, double scale)
 
 void FITSView::drawTrackingBox(QPainter * painter, double scale)
 {
-    painter->setPen(QPen(Qt::green, scaleSize(2)));
+    painter->setPen(QPen(Qt::green, 2));
 
     if (trackingBox.isNull())
         return;
@@ -1132,7 +1196,7 @@ void FITSView::drawCrosshair(QPainter * painter, double scale)
     const float maxY  = (float)image_height * scale;
     const float r = 50 * scale;
 
-    painter->setPen(QPen(QColor(KStarsData::Instance()->colorScheme()->colorNamed("TargetColor")), scaleSize(1)));
+    painter->setPen(QPen(QColor(KStarsData::Instance()->colorScheme()->colorNamed("TargetColor")), 1));
 
     //Horizontal Line to Circle
     painter->drawLine(0, midY, midX - r, midY);
@@ -1170,7 +1234,7 @@ void FITSView::drawPixelGrid(QPainter * painter, double scale)
     QFontMetrics fm(painter->font());
 
     //draw the Axes
-    painter->setPen(QPen(Qt::red, scaleSize(1)));
+    painter->setPen(QPen(Qt::red, 1));
     painter->drawText(cX - 30, height - 5, QString::number((int)((cX) / scale)));
     QString str = QString::number((int)((cY) / scale));
 #if QT_VERSION < QT_VERSION_CHECK(5,11,0)
@@ -1183,7 +1247,7 @@ void FITSView::drawPixelGrid(QPainter * painter, double scale)
         painter->drawLine(cX, 0, cX, height);
         painter->drawLine(0, cY, width, cY);
     }
-    painter->setPen(QPen(Qt::gray, scaleSize(1)));
+    painter->setPen(QPen(Qt::gray, 1));
     //Start one iteration past the Center and draw 4 lines on either side of 0
     for (int x = deltaX; x < cX - deltaX; x += deltaX)
     {
@@ -1875,25 +1939,32 @@ QPoint FITSView::getImagePoint(QPoint viewPortPoint)
     return imagePoint;
 }
 
-void FITSView::initDisplayImage()
+QImage FITSView::newDisplayImage() const
 {
     // Account for leftover when sampling. Thus a 5-wide image sampled by 2
     // would result in a width of 3 (samples 0, 2 and 4).
     int w = (imageData->width() + m_PreviewSampling - 1) / m_PreviewSampling;
     int h = (imageData->height() + m_PreviewSampling - 1) / m_PreviewSampling;
 
+    QImage image;
     if (imageData->channels() == 1)
     {
-        rawImage = QImage(w, h, QImage::Format_Indexed8);
+        image = QImage(w, h, QImage::Format_Indexed8);
 
-        rawImage.setColorCount(256);
+        image.setColorCount(256);
         for (int i = 0; i < 256; i++)
-            rawImage.setColor(i, qRgb(i, i, i));
+            image.setColor(i, qRgb(i, i, i));
     }
     else
     {
-        rawImage = QImage(w, h, QImage::Format_RGB32);
+        image = QImage(w, h, QImage::Format_RGB32);
     }
+    return image;
+}
+
+void FITSView::initDisplayImage()
+{
+    rawImage = newDisplayImage();
 }
 
 /**
@@ -45,6 +45,7 @@ class QToolBar;
 
 class FITSData;
 class FITSLabel;
+class FITSPyramid;
 
 class FITSView : public QScrollArea
 {
@@ -80,18 +81,24 @@ class FITSView : public QScrollArea
         {
             return imageData.data();
         }
-        double getCurrentZoom() const
-        {
-            return currentZoom;
-        }
-        QImage getDisplayImage() const
+        // Keeps the image data alive, e.g. while it is processed in the background
+        QSharedPointer<FITSData> getSharedImageData() const
         {
-            return rawImage;
+            return imageData;
         }
-        const QPixmap &getDisplayPixmap() const
+        double getCurrentZoom() const
         {
-            return displayPixmap;
+            return currentZoom;
         }
+        // Returns the stretched image. Large images are stretched once per frame and stretch, in
+        // the background, and this waits until they are.
+        QImage getDisplayImage() const;
+        // Returns the stretched image once it is available, without waiting for it.
+        QFuture<QImage> getDisplayImageFuture() const;
+        // Stops the background stretch of a large image, which must be done before modifying its data.
+        void stopDisplayStretch();
+        // Returns the image with its overlays. Large images are rendered on request.
+        const QPixmap &getDisplayPixmap();
 
         // Tracking square
         void setTrackingBoxEnabled(bool enable);
@@ -287,6 +294,7 @@ class FITSView : public QScrollArea
         double stddev();
         void calculateMaxPixel(double min, double max);
         void initDisplayImage();
+        QImage newDisplayImage() const;
 
         QPointF getPointForGridLabel(QPainter *painter, const QString &str, double scale);
         bool pointIsInImage(QPointF pt, double scale);
@@ -299,6 +307,8 @@ class FITSView : public QScrollArea
         QFutureWatcher<bool> wcsWatcher;
         /// FITS Future Watcher
         QFutureWatcher<bool> fitsWatcher;
+        /// Display pyramid Future Watcher
+        QFutureWatcher<QImage> pyramidWatcher;
         /// Cross hair
         QPointF markerCrosshair;
         /// Pointer to FITSData object
@@ -311,11 +321,13 @@ class FITSView : public QScrollArea
 
     private:
         bool processData();
-        void doStretch(QImage *outputImage);
-        double scaleSize(double size);
-        bool isLargeImage();
+        void updateStretchParams();
+        StretchParams displayStretchParams() const;
+        void doStretch(QImage *outputImage) const;
+        bool isLargeImage() const;
         void updateFrameLargeImage();
         void updateFrameSmallImage();
+        void paintTiles(QPainter *painter, const QRect &exposed);
         bool drawHFR(QPainter * painter, const QString &hfr, int x, int y);
 
         QLabel *noImageLabel { nullptr };
@@ -332,10 +344,14 @@ class FITSView : public QScrollArea
         /// Image zoom factor
         const double zoomFactor;
 
-        // Original full-size image
+        // Original full-size image, only for small images
         QImage rawImage;
         // Actual pixmap after all the overlays
         QPixmap displayPixmap;
+        // Stretched levels of large images
+        std::unique_ptr<FITSPyramid> pyramid;
+        // Set while drawing overlays on a full resolution pixmap, see getScale().
+        bool m_FullResolutionOverlay { false };
 
         bool firstLoad { true };
         bool markStars { false };
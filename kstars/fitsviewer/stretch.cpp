@@ -55,10 +55,13 @@ T median(T const *values, int size, int sampleBy)
 // The extension parameters are not used.
 // Sampling is applied to the output (that is, with sampling=2, we compute every other output
 // sample both in width and height, so the output would have about 4X fewer pixels.
+// Only the region of the input is stretched, with its top-left sample written at (0,0)
+// of the output. When threaded is false, runs on the calling thread.
 template <typename T>
 void stretchOneChannel(T *input_buffer, QImage *output_image,
                        const StretchParams &stretch_params,
-                       int input_range, int image_height, int image_width, int sampling)
+                       int input_range, int image_width, int sampling,
+                       const QRect &region, bool threaded)
 {
     QVector<QFuture<void>> futures;
 
@@ -82,26 +85,31 @@ void stretchOneChannel(T *input_buffer, QImage *output_image,
     const float k1 = (midtones - 1) * hsRangeFactor * maxOutput / maxInput;
     const float k2 = ((2 * midtones) - 1) * hsRangeFactor / maxInput;
 
-    // Increment the input index by the sampling, the output index increments by 1.
-    for (int j = 0, jout = 0; j < image_height; j += sampling, jout++)
+    auto stretchLine = [ = ](int j, int jout)
     {
-        futures.append(QtConcurrent::run([ = ]()
-        {
-            T * inputLine  = input_buffer + j * image_width;
-            auto * scanLine = output_image->scanLine(jout);
+        T * inputLine  = input_buffer + j * image_width;
+        auto * scanLine = output_image->scanLine(jout);
 
-            for (int i = 0, iout = 0; i < image_width; i += sampling, iout++)
+        for (int i = region.left(), iout = 0; i <= region.right(); i += sampling, iout++)
+        {
+            const T input = inputLine[i];
+            if (input < nativeShadows) scanLine[iout] = 0;
+            else if (input >= nativeHighlights) scanLine[iout] = maxOutput;
+            else
             {
-                const T input = inputLine[i];
-                if (input < nativeShadows) scanLine[iout] = 0;
-                else if (input >= nativeHighlights) scanLine[iout] = maxOutput;
-                else
-                {
-                    const T inputFloored = (input - nativeShadows);
-                    scanLine[iout] = (inputFloored * k1) / (inputFloored * k2 - midtones);
-                }
+                const T inputFloored = (input - nativeShadows);
+                scanLine[iout] = (inputFloored * k1) / (inputFloored * k2 - midtones);
             }
-        }));
+        }
+    };
+
+    // Increment the input index by the sampling, the output index increments by 1.
+    for (int j = region.top(), jout = 0; j <= region.bottom(); j += sampling, jout++)
+    {
+        if (threaded)
+            futures.append(QtConcurrent::run(stretchLine, j, jout));
+        else
+            stretchLine(j, jout);
     }
     for(QFuture<void> future : futures)
         future.waitForFinished();
@@ -117,7 +125,8 @@ void stretchOneChannel(T *input_buffer, QImage *output_image,
 template <typename T>
 void stretchThreeChannels(T *inputBuffer, QImage *outputImage,
                           const StretchParams &stretchParams,
-                          int inputRange, int imageHeight, int imageWidth, int sampling)
+                          int inputRange, int imageHeight, int imageWidth, int sampling,
+                          const QRect &region, bool threaded)
 {
     QVector<QFuture<void>> futures;
 
@@ -159,51 +168,56 @@ void stretchThreeChannels(T *inputBuffer, QImage *outputImage,
 
     const int size = imageWidth * imageHeight;
 
-    for (int j = 0, jout = 0; j < imageHeight; j += sampling, jout++)
+    auto stretchLine = [ = ](int j, int jout)
     {
-        futures.append(QtConcurrent::run([ = ]()
+        // R, G, B input images are stored one after another.
+        T * inputLineR  = inputBuffer + j * imageWidth;
+        T * inputLineG  = inputLineR + size;
+        T * inputLineB  = inputLineG + size;
+
+        auto * scanLine = reinterpret_cast<QRgb*>(outputImage->scanLine(jout));
+
+        for (int i = region.left(), iout = 0; i <= region.right(); i += sampling, iout++)
         {
-            // R, G, B input images are stored one after another.
-            T * inputLineR  = inputBuffer + j * imageWidth;
-            T * inputLineG  = inputLineR + size;
-            T * inputLineB  = inputLineG + size;
+            const T inputR = inputLineR[i];
+            const T inputG = inputLineG[i];
+            const T inputB = inputLineB[i];
 
-            auto * scanLine = reinterpret_cast<QRgb*>(outputImage->scanLine(jout));
+            uint8_t red, green, blue;
 
-            for (int i = 0, iout = 0; i < imageWidth; i += sampling, iout++)
+            if (inputR < nativeShadowsR) red = 0;
+            else if (inputR >= nativeHighlightsR) red = maxOutput;
+            else
             {
-                const T inputR = inputLineR[i];
-                const T inputG = inputLineG[i];
-                const T inputB = inputLineB[i];
-
-                uint8_t red, green, blue;
-
-                if (inputR < nativeShadowsR) red = 0;
-                else if (inputR >= nativeHighlightsR) red = maxOutput;
-                else
-                {
-                    const T inputFloored = (inputR - nativeShadowsR);
-                    red = (inputFloored * k1R) / (inputFloored * k2R - midtonesR);
-                }
-
-                if (inputG < nativeShadowsG) green = 0;
-                else if (inputG >= nativeHighlightsG) green = maxOutput;
-                else
-                {
-                    const T inputFloored = (inputG - nativeShadowsG);
-                    green = (inputFloored * k1G) / (inputFloored * k2G - midtonesG);
-                }
-
-                if (inputB < nativeShadowsB) blue = 0;
-                else if (inputB >= nativeHighlightsB) blue = maxOutput;
-                else
-                {
-                    const T inputFloored = (inputB - nativeShadowsB);
-                    blue = (inputFloored * k1B) / (inputFloored * k2B - midtonesB);
-                }
-                scanLine[iout] = qRgb(red, green, blue);
+                const T inputFloored = (inputR - nativeShadowsR);
+                red = (inputFloored * k1R) / (inputFloored * k2R - midtonesR);
             }
-        }));
+
+            if (inputG < nativeShadowsG) green = 0;
+            else if (inputG >= nativeHighlightsG) green = maxOutput;
+            else
+            {
+                const T inputFloored = (inputG - nativeShadowsG);
+                green = (inputFloored * k1G) / (inputFloored * k2G - midtonesG);
+            }
+
+            if (inputB < nativeShadowsB) blue = 0;
+            else if (inputB >= nativeHighlightsB) blue = maxOutput;
+            else
+            {
+                const T inputFloored = (inputB - nativeShadowsB);
+                blue = (inputFloored * k1B) / (inputFloored * k2B - midtonesB);
+            }
+            scanLine[iout] = qRgb(red, green, blue);
+        }
+    };
+
+    for (int j = region.top(), jout = 0; j <= region.bottom(); j += sampling, jout++)
+    {
+        if (threaded)
+            futures.append(QtConcurrent::run(stretchLine, j, jout));
+        else
+            stretchLine(j, jout);
     }
     for(QFuture<void> future : futures)
         future.waitForFinished();
@@ -212,14 +226,15 @@ void stretchThreeChannels(T *inputBuffer, QImage *outputImage,
 template <typename T>
 void stretchChannels(T *input_buffer, QImage *output_image,
                      const StretchParams &stretch_params,
-                     int input_range, int image_height, int image_width, int num_channels, int sampling)
+                     int input_range, int image_height, int image_width, int num_channels, int sampling,
+                     const QRect &region, bool threaded)
 {
     if (num_channels == 1)
         stretchOneChannel(input_buffer, output_image, stretch_params, input_range,
-                          image_height, image_width, sampling);
+                          image_width, sampling, region, threaded);
     else if (num_channels == 3)
         stretchThreeChannels(input_buffer, output_image, stretch_params, input_range,
-                             image_height, image_width, sampling);
+                             image_height, image_width, sampling, region, threaded);
 }
 
 // See section 8.5.7 in above link  https://pixinsight.com/doc/docs/XISF-1.0-spec/XISF-1.0-spec.html
@@ -326,35 +341,50 @@ void Stretch::run(uint8_t const *input, QImage *outputImage, int sampling)
     Q_ASSERT(outputImage->height() == (image_height + sampling - 1) / sampling);
     recalculateInputRange(input);
 
+    runRegion(input, outputImage, QRect(0, 0, image_width, image_height), sampling, true);
+}
+
+void Stretch::run(uint8_t const *input, QImage *outputImage, const QRect &region, int sampling) const
+{
+    Q_ASSERT(QRect(0, 0, image_width, image_height).contains(region));
+    Q_ASSERT(outputImage->width() == (region.width() + sampling - 1) / sampling);
+    Q_ASSERT(outputImage->height() == (region.height() + sampling - 1) / sampling);
+
+    runRegion(input, outputImage, region, sampling, false);
+}
+
+void Stretch::runRegion(uint8_t const *input, QImage *outputImage, const QRect &region, int sampling,
+                        bool threaded) const
+{
     switch (dataType)
     {
         case TBYTE:
             stretchChannels(reinterpret_cast<uint8_t const*>(input), outputImage, params,
-                            input_range, image_height, image_width, image_channels, sampling);
+                            input_range, image_height, image_width, image_channels, sampling, region, threaded);
             break;
         case TSHORT:
             stretchChannels(reinterpret_cast<short const*>(input), outputImage, params,
-                            input_range, image_height, image_width, image_channels, sampling);
+                            input_range, image_height, image_width, image_channels, sampling, region, threaded);
             break;
         case TUSHORT:
             stretchChannels(reinterpret_cast<unsigned short const*>(input), outputImage, params,
-                            input_range, image_height, image_width, image_channels, sampling);
+                            input_range, image_height, image_width, image_channels, sampling, region, threaded);
             break;
         case TLONG:
             stretchChannels(reinterpret_cast<long const*>(input), outputImage, params,
-                            input_range, image_height, image_width, image_channels, sampling);
+                            input_range, image_height, image_width, image_channels, sampling, region, threaded);
             break;
         case TFLOAT:
             stretchChannels(reinterpret_cast<float const*>(input), outputImage, params,
-                            input_range, image_height, image_width, image_channels, sampling);
+                            input_range, image_height, image_width, image_channels, sampling, region, threaded);
             break;
         case TLONGLONG:
             stretchChannels(reinterpret_cast<long long const*>(input), outputImage, params,
-                            input_range, image_height, image_width, image_channels, sampling);
+                            input_range, image_height, image_width, image_channels, sampling, region, threaded);
             break;
         case TDOUBLE:
             stretchChannels(reinterpret_cast<double const*>(input), outputImage, params,
-                            input_range, image_height, image_width, image_channels, sampling);
+                            input_range, image_height, image_width, image_channels, sampling, region, threaded);
             break;
         default:
             break;
@@ -83,10 +83,26 @@ class Stretch
          */
         void run(uint8_t const *input, QImage *output_image, int sampling=1);
 
- private:
+        /**
+         * @brief run Stretch a region of the raw data on the calling thread,
+         * so that several regions can be stretched concurrently.
+         * @param input the raw data buffer.
+         * @param output_image a QImage pointer that should be the size of the region
+         * downsampled by sampling. The top-left sample of the region goes to (0,0).
+         * @param region the part of the input to stretch.
+         * @param sampling The sampling parameter, as above.
+         * @note Unlike the full-image run(), this does not adjust the input range of
+         * float and double images: call recalculateInputRange() once beforehand.
+         */
+        void run(uint8_t const *input, QImage *output_image, const QRect &region, int sampling) const;
+
         // Adjusts input_range for float and double types.
         void recalculateInputRange(const uint8_t *input);
 
+ private:
+        void runRegion(uint8_t const *input, QImage *output_image, const QRect &region, int sampling,
+                       bool threaded) const;
+
         // Inputs.
         int image_width;
         int image_height;
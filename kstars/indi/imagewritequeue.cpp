@@ -0,0 +1,344 @@
+/*  Image Write Queue
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "imagewritequeue.h"
+
+#include "config-kstars.h"
+
+#include "indi_debug.h"
+#include "kstars.h"
+
+#include <KLocalizedString>
+
+#include <QCryptographicHash>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QThread>
+#include <QtConcurrent>
+
+#include <algorithm>
+
+#ifdef HAVE_CFITSIO
+#include <fitsio.h>
+#endif
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace
+{
+#ifdef HAVE_CFITSIO
+// Returns the size of a FITS file in memory, up to the end of its last HDU.
+LONGLONG fitsFileSize(fitsfile *fptr, int *status)
+{
+    int hdus = 0;
+    LONGLONG headStart = 0, dataStart = 0, dataEnd = 0;
+
+    fits_get_num_hdus(fptr, &hdus, status);
+    fits_movabs_hdu(fptr, hdus, nullptr, status);
+    fits_get_hduaddrll(fptr, &headStart, &dataStart, &dataEnd, status);
+    return dataEnd;
+}
+
+void updateFilterKeyword(fitsfile *fptr, const QString &filter, int *status)
+{
+    if (filter.isEmpty())
+        return;
+
+    QString filt(filter);
+    filt.replace(' ', '_');
+    fits_update_key_str(fptr, "FILTER", filt.toLatin1().data(), "Filter name", status);
+}
+
+// Adds the keywords to a FITS blob, and optionally tile compresses it as fpack does.
+// The blob is only replaced if everything succeeds.
+bool prepareFITS(QByteArray &data, bool compress, const QString &filter, QString &error)
+{
+    int status = 0;
+    fitsfile *in = nullptr, *out = nullptr;
+
+    // Opened read-write so the keywords may be added in place, cfitsio grows the memory as needed.
+    size_t inSize = data.size();
+    void *inMemory = malloc(inSize);
+    memcpy(inMemory, data.constData(), inSize);
+
+    size_t outSize = 0;
+    void *outMemory = nullptr;
+
+    if (fits_open_memfile(&in, "blob", READWRITE, &inMemory, &inSize, 2880, realloc, &status))
+    {
+        in = nullptr;
+    }
+    else if (fits_movabs_hdu(in, 1, nullptr, &status))
+    {
+        // Closing keeps the error status
+        fits_close_file(in, &status);
+        in = nullptr;
+    }
+    else if (compress)
+    {
+        int bitpix = 0;
+        outSize = inSize / 2 + 2880;
+        outMemory = malloc(outSize);
+
+        if (fits_get_img_type(in, &bitpix, &status) == 0 &&
+                fits_create_memfile(&out, &outMemory, &outSize, 2880, realloc, &status) == 0 &&
+                fits_create_img(out, BYTE_IMG, 0, nullptr, &status) == 0)
+        {
+            // Rice is lossless for integers only, floating point values would be quantized.
+            fits_set_compression_type(out, bitpix > 0 ? RICE_1 : GZIP_2, &status);
+            fits_img_compress(in, out, &status);
+            updateFilterKeyword(out, filter, &status);
+            fits_write_chksum(out, &status);
+            fits_flush_file(out, &status);
+        }
+    }
+    else
+    {
+        updateFilterKeyword(in, filter, &status);
+        fits_write_chksum(in, &status);
+        fits_flush_file(in, &status);
+    }
+
+    fitsfile *result = compress ? out : in;
+    const LONGLONG size = (status == 0 && result) ? fitsFileSize(result, &status) : 0;
+    const bool rc = status == 0 && size > 0;
+
+    if (rc)
+        data = QByteArray(static_cast<const char *>(compress ? outMemory : inMemory), static_cast<int>(size));
+    else
+    {
+        char message[FLEN_STATUS] = {0};
+        fits_get_errstatus(status, message);
+        error = QString::fromLatin1(message);
+    }
+
+    status = 0;
+    if (out)
+        fits_close_file(out, &status);
+    status = 0;
+    if (in)
+        fits_close_file(in, &status);
+
+    // Memory files do not own their memory
+    free(outMemory);
+    free(inMemory);
+    return rc;
+}
+#endif
+}
+
+namespace ISD
+{
+ImageWriteQueue *ImageWriteQueue::_ImageWriteQueue = nullptr;
+
+ImageWriteQueue *ImageWriteQueue::Instance()
+{
+    if (_ImageWriteQueue == nullptr)
+        _ImageWriteQueue = new ImageWriteQueue(KStars::Instance());
+
+    return _ImageWriteQueue;
+}
+
+ImageWriteQueue::ImageWriteQueue(QObject *parent) : QObject(parent)
+{
+    // A single writer keeps the files in order, and parallel writes do not help slow storage.
+    m_Pool.setMaxThreadCount(1);
+}
+
+ImageWriteQueue::~ImageWriteQueue()
+{
+    // Queued images are written before leaving.
+    m_Pool.waitForDone();
+    if (_ImageWriteQueue == this)
+        _ImageWriteQueue = nullptr;
+}
+
+void ImageWriteQueue::enqueue(const QString &filename, const QByteArray &data, Format format, const QString &filter)
+{
+    {
+        QMutexLocker locker(&m_Mutex);
+
+        // Losing the image would be worse than going over the limit, captures are deferred instead.
+        if (isFullLocked())
+            qCWarning(KSTARS_INDI) << "ISD:CCD Warning: Image write queue is over its memory limit, queuing"
+                                   << filename << "anyway";
+
+        m_Statistics.depth++;
+        m_Statistics.queuedBytes += data.size();
+    }
+
+    emit statisticsChanged();
+
+    QtConcurrent::run(&m_Pool, this, &ImageWriteQueue::write, filename, data, format, filter);
+}
+
+bool ImageWriteQueue::flush(int msecs)
+{
+    return m_Pool.waitForDone(msecs);
+}
+
+ImageWriteQueue::Statistics ImageWriteQueue::statistics() const
+{
+    QMutexLocker locker(&m_Mutex);
+    return m_Statistics;
+}
+
+bool ImageWriteQueue::isFull() const
+{
+    QMutexLocker locker(&m_Mutex);
+    return isFullLocked();
+}
+
+bool ImageWriteQueue::isFullLocked() const
+{
+    // At least one file is always queued
+    return m_Statistics.queuedBytes > 0 && m_Statistics.queuedBytes >= m_MemoryLimit;
+}
+
+void ImageWriteQueue::setMemoryLimit(qint64 bytes)
+{
+    QMutexLocker locker(&m_Mutex);
+    m_MemoryLimit = bytes;
+}
+
+void ImageWriteQueue::setSyncEnabled(bool enabled)
+{
+    QMutexLocker locker(&m_Mutex);
+    m_Sync = enabled;
+}
+
+void ImageWriteQueue::setVerifyEnabled(bool enabled)
+{
+    QMutexLocker locker(&m_Mutex);
+    m_Verify = enabled;
+}
+
+void ImageWriteQueue::write(const QString &filename, const QByteArray &data, Format format, const QString &filter)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QByteArray content = data;
+    QString error;
+
+#ifdef HAVE_CFITSIO
+    if (format != FORMAT_RAW && !prepareFITS(content, format == FORMAT_COMPRESSED_FITS, filter, error))
+    {
+        // Better keep the image as it was received than lose it.
+        qCWarning(KSTARS_INDI) << "ISD:CCD Error: Unable to add keywords to" << filename << error;
+        content = data;
+    }
+#else
+    Q_UNUSED(format)
+    Q_UNUSED(filter)
+#endif
+
+    bool written = false;
+    int attempt = 0;
+    for (; attempt <= MaxRetries && !written; attempt++)
+    {
+        if (attempt > 0)
+        {
+            qCWarning(KSTARS_INDI) << "ISD:CCD Error: Unable to write" << filename << error << "- retrying";
+            QThread::msleep(250 * attempt);
+        }
+        written = writeFile(filename, content, error);
+    }
+
+    const double rate = content.size() / std::max(timer.nsecsElapsed() / 1e9, 1e-3);
+    {
+        QMutexLocker locker(&m_Mutex);
+        m_Statistics.depth--;
+        m_Statistics.queuedBytes -= data.size();
+        m_Statistics.retried += attempt - 1;
+        if (written)
+        {
+            m_Statistics.written++;
+            m_Statistics.bytesPerSecond = m_Statistics.bytesPerSecond > 0 ?
+                                          0.7 * m_Statistics.bytesPerSecond + 0.3 * rate : rate;
+        }
+        else
+            m_Statistics.failed++;
+    }
+
+    if (written)
+        emit fileWritten(filename);
+    else
+    {
+        qCCritical(KSTARS_INDI) << "ISD:CCD Error: Unable to write" << filename << error;
+        emit writeFailed(filename, error);
+    }
+    emit statisticsChanged();
+}
+
+bool ImageWriteQueue::writeFile(const QString &filename, const QByteArray &data, QString &error)
+{
+    bool sync = false, verify = false;
+    {
+        QMutexLocker locker(&m_Mutex);
+        sync = m_Sync;
+        verify = m_Verify;
+    }
+
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        error = file.errorString();
+        return false;
+    }
+
+    if (file.write(data) != data.size() || !file.flush())
+    {
+        error = file.errorString();
+        return false;
+    }
+
+    if (sync)
+    {
+#ifdef Q_OS_WIN
+        const int rc = _commit(file.handle());
+#else
+        const int rc = fsync(file.handle());
+#endif
+        if (rc != 0)
+        {
+            error = i18n("Unable to sync the file to disk.");
+            return false;
+        }
+    }
+
+    file.close();
+    file.setPermissions(QFileDevice::ReadUser |
+                        QFileDevice::WriteUser |
+                        QFileDevice::ReadGroup |
+                        QFileDevice::ReadOther);
+
+    if (verify)
+    {
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            error = file.errorString();
+            return false;
+        }
+
+        QCryptographicHash hash(QCryptographicHash::Md5);
+        if (!hash.addData(&file) || hash.result() != QCryptographicHash::hash(data, QCryptographicHash::Md5))
+        {
+            error = i18n("The written file does not match the image.");
+            return false;
+        }
+    }
+
+    return true;
+}
+}
@@ -0,0 +1,118 @@
+/*  Image Write Queue
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#pragma once
+
+#include <QMutex>
+#include <QObject>
+#include <QThreadPool>
+
+namespace ISD
+{
+/**
+ * @class ImageWriteQueue
+ * @short Writes captured images to disk in the background, one file after the other.
+ *
+ * Captured images are queued with a copy of their data, so the next exposure can start
+ * while slow storage catches up. Queuing never waits, as images arrive on the GUI thread.
+ * Instead, the queue is full once its images take the memory limit, and the next capture
+ * is deferred until enough files are written.
+ *
+ * FITS files get their FILTER keyword and the standard FITS CHECKSUM and DATASUM keywords
+ * before being written, and may be tile compressed. Each file is optionally synced to disk
+ * and read back to verify it, and failed writes are retried a few times.
+ *
+ * @author KStars Developers
+ */
+class ImageWriteQueue : public QObject
+{
+        Q_OBJECT
+
+    public:
+        enum Format
+        {
+            // Written as is
+            FORMAT_RAW,
+            // FITS file, keywords are added
+            FORMAT_FITS,
+            // FITS file, keywords are added and the image is tile compressed, as fpack does
+            FORMAT_COMPRESSED_FITS
+        };
+
+        struct Statistics
+        {
+            // Files queued or being written
+            int depth { 0 };
+            qint64 queuedBytes { 0 };
+            // Write throughput of the last files
+            double bytesPerSecond { 0 };
+            quint64 written { 0 };
+            quint64 retried { 0 };
+            quint64 failed { 0 };
+        };
+
+        static ImageWriteQueue *Instance();
+
+        /**
+         * @brief enqueue Queue a file for writing.
+         * @param filename the file to write, replaced if it exists.
+         * @param data the content of the file.
+         * @param filter the name of the filter, for FITS files.
+         * @note The file is queued even if the queue is full, which is only logged.
+         */
+        void enqueue(const QString &filename, const QByteArray &data, Format format, const QString &filter = QString());
+
+        /**
+         * @brief flush Wait for the queued files to be written.
+         * @param msecs maximum time to wait, or -1 to wait until they are all written.
+         * @return true if all the files are written.
+         */
+        bool flush(int msecs = -1);
+
+        Statistics statistics() const;
+
+        // Whether the queued files take the memory limit, in which case captures should wait.
+        bool isFull() const;
+
+        // Memory the queued files may take, in bytes. At least one file is always queued.
+        void setMemoryLimit(qint64 bytes);
+        // Whether each file is synced to disk before the next one is written.
+        void setSyncEnabled(bool enabled);
+        // Whether each file is read back and compared to what was written.
+        void setVerifyEnabled(bool enabled);
+
+        // Times a failed write is tried again.
+        static const int MaxRetries = 3;
+
+    signals:
+        // Emitted from the writing thread.
+        void statisticsChanged();
+        void fileWritten(const QString &filename);
+        void writeFailed(const QString &filename, const QString &error);
+
+    private:
+        explicit ImageWriteQueue(QObject *parent = nullptr);
+        ~ImageWriteQueue() override;
+
+        static ImageWriteQueue *_ImageWriteQueue;
+
+        void write(const QString &filename, const QByteArray &data, Format format, const QString &filter);
+        bool writeFile(const QString &filename, const QByteArray &data, QString &error);
+        bool isFullLocked() const;
+
+        // Writes files one at a time, in their queuing order.
+        QThreadPool m_Pool;
+
+        mutable QMutex m_Mutex;
+        Statistics m_Statistics;
+        qint64 m_MemoryLimit { 1024LL * 1024 * 1024 };
+        bool m_Sync { false };
+        bool m_Verify { false };
+};
+}
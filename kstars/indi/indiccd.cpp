@@ -16,6 +16,7 @@
 #include "clientmanager.h"
 #include "driverinfo.h"
 #include "guimanager.h"
+#include "imagewritequeue.h"
 #include "kspaths.h"
 #include "kstars.h"
 #include "kstarsdata.h"
@@ -35,74 +36,6 @@
 
 const QStringList RAWFormats = { "cr2", "cr3", "crw", "nef", "raf", "dng", "arw" };
 
-namespace
-{
-void addFITSKeywords(const QString &filename, const QString &filter_used)
-{
-#ifdef HAVE_CFITSIO
-    int status = 0;
-
-    if (filter_used.isEmpty() == false)
-    {
-        QString filt(filter_used);
-        QString key_comment("Filter name");
-        filt.replace(' ', '_');
-
-        fitsfile *fptr = nullptr;
-
-        // Use open diskfile as it does not use extended file names which has problems opening
-        // files with [ ] or ( ) in their names.
-        if (fits_open_diskfile(&fptr, filename.toLatin1(), READONLY, &status))
-        {
-            fits_report_error(stderr, status);
-            return;
-        }
-
-        if (fits_movabs_hdu(fptr, 1, IMAGE_HDU, &status))
-        {
-            fits_report_error(stderr, status);
-            return;
-        }
-
-        if (fits_update_key_str(fptr, "FILTER", filt.toLatin1().data(), key_comment.toLatin1().data(), &status))
-        {
-            fits_report_error(stderr, status);
-            return;
-        }
-
-        fits_flush_file(fptr, &status);
-        fits_close_file(fptr, &status);
-    }
-#endif
-}
-
-// Internal function to write an image blob to disk.
-bool WriteImageFileInternal(const QString &filename, char *buffer, const size_t size,
-                            bool add_fits_keywords, const QString &filter)
-{
-    QFile file(filename);
-    if (!file.open(QIODevice::WriteOnly))
-    {
-        qCCritical(KSTARS_INDI) << "ISD:CCD Error: Unable to open write file: " <<
-                                filename;
-        return false;
-    }
-    size_t n = 0;
-    QDataStream out(&file);
-    for (size_t nr = 0; nr < size; nr += n)
-        n = out.writeRawData(buffer + nr, size - nr);
-    file.flush();
-    file.close();
-    file.setPermissions(QFileDevice::ReadUser |
-                        QFileDevice::WriteUser |
-                        QFileDevice::ReadGroup |
-                        QFileDevice::ReadOther);
-    if (add_fits_keywords)
-        addFITSKeywords(filename, filter);
-    return true;
-}
-}
-
 namespace ISD
 {
 CCDChip::CCDChip(ISD::CCD *ccd, ChipType cType)
@@ -909,10 +842,6 @@ CCD::~CCD()
 {
     if (m_ImageViewerWindow)
         m_ImageViewerWindow->close();
-    if (fileWriteThread.isRunning())
-        fileWriteThread.waitForFinished();
-    if (fileWriteBuffer != nullptr)
-        delete [] fileWriteBuffer;
 }
 
 void CCD::setBLOBManager(const char *device, INDI::Property *prop)
@@ -1437,45 +1366,23 @@ bool CCD::generateFilename(const QString &format, bool batch_mode, QString *file
 
 bool CCD::writeImageFile(const QString &filename, IBLOB *bp, bool is_fits)
 {
-    // TODO: Not yet threading the writes for non-fits files.
-    // Would need to deal with the raw conversion, etc.
+    ImageWriteQueue::Format format = ImageWriteQueue::FORMAT_RAW;
+#ifdef HAVE_CFITSIO
     if (is_fits)
-    {
-        // Check if the last write is still ongoing, and if so wait.
-        // It is using the fileWriteBuffer.
-        if (fileWriteThread.isRunning())
-        {
-            fileWriteThread.waitForFinished();
-        }
-
-        // Wait until the file is written before overwritting the filename.
-        fileWriteFilename = filename;
-
-        // Will write blob data in a separate thread, and can't depend on the blob
-        // memory, so copy it first.
+        format = filename.endsWith(".fz") ? ImageWriteQueue::FORMAT_COMPRESSED_FITS : ImageWriteQueue::FORMAT_FITS;
+#endif
 
-        // Check buffer size.
-        if (fileWriteBufferSize != bp->size)
-        {
-            if (fileWriteBuffer != nullptr)
-                delete [] fileWriteBuffer;
-            fileWriteBufferSize = bp->size;
-            fileWriteBuffer = new char[fileWriteBufferSize];
-        }
+    ImageWriteQueue *queue = ImageWriteQueue::Instance();
+    queue->setMemoryLimit(static_cast<qint64>(Options::imageWriteQueueSize()) * 1024 * 1024);
+    queue->setSyncEnabled(Options::syncImageWrites());
+    queue->setVerifyEnabled(Options::verifyImageWrites());
 
-        // Copy memory, and write file on a separate thread.
-        // Probably too late to return an error if the file couldn't write.
-        memcpy(fileWriteBuffer, bp->blob, bp->size);
-        fileWriteThread = QtConcurrent::run(WriteImageFileInternal, fileWriteFilename,
-                                            fileWriteBuffer, bp->size, is_fits, filter);
+    // The blob memory is reused by the client, so the queue keeps its own copy.
+    // Write errors are reported by the queue once its retries are exhausted.
+    queue->enqueue(filename, QByteArray(static_cast<const char *>(bp->blob), bp->size), format,
+                   is_fits ? filter : QString());
+    if (is_fits)
         filter = "";
-    }
-    else
-    {
-        if (!WriteImageFileInternal(filename, static_cast<char*>(bp->blob), bp->size,
-                                    false, filter))
-            return false;
-    }
     return true;
 }
 
@@ -1567,7 +1474,13 @@ void CCD::processBLOB(IBLOB *bp)
     {
         // If either generating file name or writing the image file fails
         // then return
-        if (!generateFilename(format, targetChip->isBatchMode(), &filename) ||
+        QString fileFormat = format;
+#ifdef HAVE_CFITSIO
+        // Compressed on the write thread, the received blob is loaded as is.
+        if (BType == BLOB_FITS && Options::compressFITS())
+            fileFormat += ".fz";
+#endif
+        if (!generateFilename(fileFormat, targetChip->isBatchMode(), &filename) ||
                 !writeImageFile(filename, bp, BType == BLOB_FITS))
         {
             emit BLOBUpdated(nullptr);
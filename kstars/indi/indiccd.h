@@ -417,11 +417,5 @@ class CCD : public DeviceDecorator
         // Typically for DSLRs
         QMap<QString, double> m_ExposurePresets;
         QPair<double, double> m_ExposurePresetsMinMax;
-
-        // Used when writing the image fits file to disk in a separate thread.
-        char *fileWriteBuffer { nullptr };
-        int fileWriteBufferSize { 0 };
-        QString fileWriteFilename;
-        QFuture<void> fileWriteThread;
 };
 }
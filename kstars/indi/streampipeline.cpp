@@ -0,0 +1,226 @@
+/*  Video Stream Pipeline
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+*/
+
+#include "streampipeline.h"
+
+#include "fitsviewer/bayerdecoder.h"
+
+#include "kstars_debug.h"
+
+#include <QImageReader>
+#include <QMutexLocker>
+#include <QtConcurrent>
+
+#include <algorithm>
+
+#include <cstring>
+
+StreamPipeline::StreamPipeline(int capacity, QObject *parent) : QObject(parent)
+{
+    m_Ring.resize(std::max(1, capacity));
+
+    m_GrayTable.resize(256);
+    for (int i = 0; i < 256; i++)
+        m_GrayTable[i] = qRgb(i, i, i);
+}
+
+StreamPipeline::~StreamPipeline()
+{
+    {
+        QMutexLocker locker(&m_Mutex);
+        m_Stopping = true;
+    }
+    m_Worker.waitForFinished();
+}
+
+bool StreamPipeline::push(const IBLOB *bp, int width, int height, const QSize &displaySize,
+                          const BayerParams *debayer)
+{
+    if (bp->size <= 0)
+        return false;
+
+    m_Received++;
+
+    QString format(bp->format);
+    if (m_RawFormat != format)
+    {
+        m_RawFormat = format;
+        format.remove('.');
+        format.remove("stream_");
+        m_RawFormatSupported = QImageReader::supportedImageFormats().contains(format.toLatin1());
+    }
+
+    QMutexLocker locker(&m_Mutex);
+
+    // Drop the oldest frame to make room for this one.
+    if (m_Count == m_Ring.size())
+    {
+        m_Head = (m_Head + 1) % m_Ring.size();
+        m_Count--;
+        m_Dropped++;
+    }
+
+    Frame &frame = m_Ring[(m_Head + m_Count) % m_Ring.size()];
+    frame.data.resize(bp->size);
+    memcpy(frame.data.data(), bp->blob, bp->size);
+    frame.compressed  = m_RawFormatSupported;
+    frame.width       = width;
+    frame.height      = height;
+    frame.displaySize = displaySize;
+    frame.debayer     = debayer != nullptr;
+    if (debayer)
+        frame.params = *debayer;
+    m_Count++;
+
+    if (!m_Processing)
+    {
+        m_Processing = true;
+        m_Worker = QtConcurrent::run(this, &StreamPipeline::process);
+    }
+
+    return true;
+}
+
+void StreamPipeline::process()
+{
+    forever
+    {
+        {
+            QMutexLocker locker(&m_Mutex);
+            if (m_Count == 0 || m_Stopping)
+            {
+                m_Processing = false;
+                return;
+            }
+            std::swap(m_Current, m_Ring[m_Head]);
+            m_Head = (m_Head + 1) % m_Ring.size();
+            m_Count--;
+        }
+
+        if (!decode(m_Current, &m_Image))
+        {
+            m_Failed++;
+            QMetaObject::invokeMethod(this, "frameFailed", Qt::QueuedConnection);
+            continue;
+        }
+        m_DecodedCount++;
+
+        QSharedPointer<QImage> decoded(new QImage(m_Image));
+        QImage scaled = m_Image.scaled(m_Current.displaySize, Qt::KeepAspectRatio);
+
+        QMutexLocker locker(&m_Mutex);
+        m_Decoded = decoded;
+        m_Scaled  = scaled;
+        if (m_DeliveryPending)
+            m_Dropped++;
+        else
+        {
+            m_DeliveryPending = true;
+            QMetaObject::invokeMethod(this, "deliverFrame", Qt::QueuedConnection);
+        }
+    }
+}
+
+bool StreamPipeline::decode(const Frame &frame, QImage *image)
+{
+    if (frame.compressed)
+        return image->loadFromData(frame.data.data(), static_cast<int>(frame.data.size()));
+
+    const size_t pixels = static_cast<size_t>(frame.width) * frame.height;
+
+    if (frame.debayer)
+    {
+        if (frame.data.size() < pixels)
+            return false;
+
+        if (image->width() != frame.width || image->height() != frame.height || image->format() != QImage::Format_RGB888)
+            *image = QImage(frame.width, frame.height, QImage::Format_RGB888);
+
+        const uint8_t *source = frame.data.data();
+        // offsetY is handled by the decoder.
+        if (frame.params.offsetX == 1)
+            source++;
+
+        dc1394error_t error_code = BayerDecoder::toImage(source, image, frame.width, frame.height, frame.params);
+        if (error_code != DC1394_SUCCESS)
+        {
+            qCCritical(KSTARS) << "Debayer failed" << error_code;
+            return false;
+        }
+        return true;
+    }
+
+    QImage::Format format;
+    int bytesPerPixel;
+    if (frame.data.size() == pixels)
+    {
+        format = QImage::Format_Indexed8;
+        bytesPerPixel = 1;
+    }
+    else if (frame.data.size() == pixels * 3)
+    {
+        format = QImage::Format_RGB888;
+        bytesPerPixel = 3;
+    }
+    else
+        return false;
+
+    if (image->width() != frame.width || image->height() != frame.height || image->format() != format)
+    {
+        *image = QImage(frame.width, frame.height, format);
+        if (format == QImage::Format_Indexed8)
+            image->setColorTable(m_GrayTable);
+    }
+    if (image->isNull())
+        return false;
+
+    const int rowBytes = frame.width * bytesPerPixel;
+    for (int row = 0; row < frame.height; ++row)
+        memcpy(image->scanLine(row), frame.data.data() + static_cast<size_t>(row) * rowBytes, rowBytes);
+    return true;
+}
+
+void StreamPipeline::deliverFrame()
+{
+    QSharedPointer<QImage> decoded;
+    QImage scaled;
+    {
+        QMutexLocker locker(&m_Mutex);
+        decoded.swap(m_Decoded);
+        std::swap(scaled, m_Scaled);
+        m_DeliveryPending = false;
+    }
+
+    if (decoded.isNull())
+        return;
+
+    m_Displayed++;
+    emit frameReady(decoded, scaled);
+}
+
+StreamPipeline::Statistics StreamPipeline::statistics() const
+{
+    Statistics stats;
+    stats.received  = m_Received;
+    stats.decoded   = m_DecodedCount;
+    stats.displayed = m_Displayed;
+    stats.dropped   = m_Dropped;
+    stats.failed    = m_Failed;
+    return stats;
+}
+
+void StreamPipeline::resetStatistics()
+{
+    m_Received     = 0;
+    m_DecodedCount = 0;
+    m_Displayed    = 0;
+    m_Dropped      = 0;
+    m_Failed       = 0;
+}
@@ -0,0 +1,129 @@
+/*  Video Stream Pipeline
+    Copyright (C) 2026 KStars Developers
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+*/
+
+#pragma once
+
+#include "fitsviewer/bayer.h"
+
+#include <indidevapi.h>
+
+#include <QFuture>
+#include <QImage>
+#include <QMutex>
+#include <QObject>
+#include <QSharedPointer>
+#include <QSize>
+#include <QVector>
+
+#include <atomic>
+#include <vector>
+
+/**
+ * @brief Decodes video stream frames away from the GUI thread.
+ *
+ * Received frames are copied into a bounded ring buffer. When the ring is full, the
+ * oldest frame waiting there is dropped. A worker decodes, debayers and scales the
+ * frames in order, and hands them over to the GUI thread through frameReady(). Only
+ * the newest decoded frame is displayed: a frame decoded while the previous one is
+ * still waiting for the GUI thread replaces it, and counts as dropped.
+ *
+ * push() and frameReady() belong to the GUI thread.
+ */
+class StreamPipeline : public QObject
+{
+        Q_OBJECT
+
+    public:
+        struct Statistics
+        {
+            quint64 received { 0 };
+            quint64 decoded { 0 };
+            quint64 displayed { 0 };
+            quint64 dropped { 0 };
+            quint64 failed { 0 };
+        };
+
+        explicit StreamPipeline(int capacity = 4, QObject *parent = nullptr);
+        ~StreamPipeline() override;
+
+        /**
+         * @brief push Queue a frame for decoding.
+         * @param bp the stream BLOB, copied before returning.
+         * @param width width of the stream, in pixels.
+         * @param height height of the stream, in pixels.
+         * @param displaySize size to scale the displayed frame to.
+         * @param debayer Bayer params, or nullptr if the frame is not to be debayered.
+         * @return false if the BLOB is empty. Frames that fail to decode are reported by frameFailed().
+         */
+        bool push(const IBLOB *bp, int width, int height, const QSize &displaySize, const BayerParams *debayer = nullptr);
+
+        Statistics statistics() const;
+        void resetStatistics();
+
+    signals:
+        /**
+         * @brief frameReady Emitted on the GUI thread when a decoded frame is to be displayed.
+         * @param frame the frame at the stream resolution.
+         * @param scaled the frame scaled to the display size.
+         */
+        void frameReady(const QSharedPointer<QImage> &frame, const QImage &scaled);
+        /** @brief frameFailed Emitted on the GUI thread when a queued frame could not be decoded. */
+        void frameFailed();
+
+    private slots:
+        void deliverFrame();
+
+    private:
+        struct Frame
+        {
+            std::vector<uint8_t> data;
+            bool compressed { false };
+            int width { 0 };
+            int height { 0 };
+            QSize displaySize;
+            bool debayer { false };
+            BayerParams params;
+        };
+
+        // Decodes the queued frames until none are left, on a worker thread.
+        void process();
+        bool decode(const Frame &frame, QImage *image);
+
+        // Ring of frames waiting for the worker. Taking a frame swaps its buffer with
+        // the worker's, so the buffers are reused.
+        QVector<Frame> m_Ring;
+        int m_Head { 0 };
+        int m_Count { 0 };
+        bool m_Processing { false };
+        bool m_Stopping { false };
+
+        // Newest decoded frame, waiting for the GUI thread.
+        QSharedPointer<QImage> m_Decoded;
+        QImage m_Scaled;
+        bool m_DeliveryPending { false };
+
+        mutable QMutex m_Mutex;
+        QFuture<void> m_Worker;
+
+        // Worker state.
+        Frame m_Current;
+        QImage m_Image;
+        QVector<QRgb> m_GrayTable;
+
+        // Only used in push().
+        QString m_RawFormat;
+        bool m_RawFormatSupported { false };
+
+        std::atomic<quint64> m_Received { 0 };
+        std::atomic<quint64> m_DecodedCount { 0 };
+        std::atomic<quint64> m_Displayed { 0 };
+        std::atomic<quint64> m_Dropped { 0 };
+        std::atomic<quint64> m_Failed { 0 };
+};
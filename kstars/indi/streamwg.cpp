@@ -116,6 +116,11 @@ StreamWG::StreamWG(ISD::CCD *ccd) : QDialog(KStars::Instance())
 
     connect(videoFrame, &VideoWG::newSelection, this, &StreamWG::setStreamingFrame);
     connect(videoFrame, &VideoWG::imageChanged, this, &StreamWG::imageChanged);
+    // Frames are decoded after newFrame() returns
+    connect(videoFrame, &VideoWG::frameFailed, this, []()
+    {
+        qCWarning(KSTARS) << "Failed to decode video frame.";
+    });
 
     resize(Options::streamWindowWidth(), Options::streamWindowHeight());
 
@@ -193,6 +198,9 @@ StreamWG::StreamWG(ISD::CCD *ccd) : QDialog(KStars::Instance())
         }
     });
 
+    m_CountersTimer.setInterval(1000);
+    connect(&m_CountersTimer, &QTimer::timeout, this, &StreamWG::updateFrameCounters);
+
     debayerB->setIcon(QIcon(":/icons/cfa.svg"));
     connect(debayerB, &QPushButton::clicked, this, [this]()
     {
@@ -271,6 +279,7 @@ void StreamWG::showEvent(QShowEvent *ev)
 void StreamWG::closeEvent(QCloseEvent * ev)
 {
     processStream = false;
+    m_CountersTimer.stop();
 
     Options::setStreamWindowWidth(width());
     Options::setStreamWindowHeight(height());
@@ -290,13 +299,17 @@ void StreamWG::enableStream(bool enable)
     if (enable)
     {
         processStream = true;
+        videoFrame->resetStatistics();
+        m_CountersTimer.start();
         show();
     }
     else
     {
         processStream = false;
+        m_CountersTimer.stop();
         //instFPS->setText("--");
         avgFPS->setText("--");
+        frameCounters->setText("--");
         hide();
     }
 }
@@ -385,7 +398,7 @@ void StreamWG::newFrame(IBLOB *bp)
                && !strcmp(bp->format, ".stream")) ? videoFrame->newBayerFrame(bp, m_DebayerParams) : videoFrame->newFrame(bp);
 
     if (rc == false)
-        qCWarning(KSTARS) << "Failed to load video frame.";
+        qCWarning(KSTARS) << "Failed to queue video frame.";
 }
 
 void StreamWG::resetFrame()
@@ -420,3 +433,10 @@ void StreamWG::updateFPS(double instantFPS, double averageFPS)
     //instFPS->setText(QString::number(instantFPS, 'f', 1));
     avgFPS->setText(QString::number(averageFPS, 'f', 1));
 }
+
+void StreamWG::updateFrameCounters()
+{
+    const StreamPipeline::Statistics stats = videoFrame->statistics();
+    frameCounters->setText(i18n("Received: %1 Decoded: %2 Displayed: %3 Dropped: %4 Failed: %5", stats.received,
+                                stats.decoded, stats.displayed, stats.dropped, stats.failed));
+}
@@ -23,6 +23,7 @@
 #include <QPaintEvent>
 #include <QPixmap>
 #include <QResizeEvent>
+#include <QTimer>
 #include <QVBoxLayout>
 #include <QVector>
 
@@ -84,6 +85,7 @@ class StreamWG : public QDialog, public Ui::streamForm
     protected slots:
         void setStreamingFrame(QRect newFrame);
         void updateFPS(double instantFPS, double averageFPS);
+        void updateFrameCounters();
 
     signals:
         void hidden();
@@ -108,4 +110,6 @@ class StreamWG : public QDialog, public Ui::streamForm
         // For Canon DSLRs
         INDI::Property *eoszoom {nullptr}, *eoszoomposition {nullptr};
         RecordOptions *options;
+
+        QTimer m_CountersTimer;
 };
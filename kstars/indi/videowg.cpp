@@ -10,9 +10,6 @@
 
 #include "videowg.h"
 
-#include "kstars_debug.h"
-
-#include <QImageReader>
 #include <QMouseEvent>
 #include <QResizeEvent>
 #include <QRubberBand>
@@ -21,55 +18,39 @@ VideoWG::VideoWG(QWidget *parent) : QLabel(parent)
 {
     streamImage.reset(new QImage());
 
-    grayTable.resize(256);
-
-    for (int i = 0; i < 256; i++)
-        grayTable[i] = qRgb(i, i, i);
+    m_Pipeline.reset(new StreamPipeline());
+    connect(m_Pipeline.get(), &StreamPipeline::frameReady, this, &VideoWG::displayFrame);
+    connect(m_Pipeline.get(), &StreamPipeline::frameFailed, this, &VideoWG::frameFailed);
 }
 
 bool VideoWG::newBayerFrame(IBLOB *bp, const BayerParams &params)
 {
-    return debayer(bp, params);
+    return m_Pipeline->push(bp, streamW, streamH, size(), &params);
 }
 
 bool VideoWG::newFrame(IBLOB *bp)
 {
-    if (bp->size <= 0)
-        return false;
+    return m_Pipeline->push(bp, streamW, streamH, size());
+}
 
-    bool rc = false;
-    QString format(bp->format);
-    if (m_RawFormat != format)
-    {
-        format.remove('.');
-        format.remove("stream_");
-        m_RawFormatSupported = QImageReader::supportedImageFormats().contains(format.toLatin1());
-        m_RawFormat = format;
-    }
+void VideoWG::displayFrame(const QSharedPointer<QImage> &frame, const QImage &scaled)
+{
+    streamImage = frame;
 
-    if (m_RawFormatSupported)
-        rc = streamImage->loadFromData(static_cast<uchar *>(bp->blob), bp->size);
-    else if (static_cast<uint32_t>(bp->size) == totalBaseCount)
-    {
-        streamImage.reset(new QImage(static_cast<uchar *>(bp->blob), streamW, streamH, QImage::Format_Indexed8));
-        streamImage->setColorTable(grayTable);
-        rc = !streamImage->isNull();
-    }
-    else if (static_cast<uint32_t>(bp->size) == totalBaseCount * 3)
-    {
-        streamImage.reset(new QImage(static_cast<uchar *>(bp->blob), streamW, streamH, QImage::Format_RGB888));
-        rc = !streamImage->isNull();
-    }
-
-    if (rc)
-    {
-        kPix = QPixmap::fromImage(streamImage->scaled(size(), Qt::KeepAspectRatio));
-        setPixmap(kPix);
-    }
+    kPix = QPixmap::fromImage(scaled);
+    setPixmap(kPix);
 
     emit imageChanged(streamImage);
+}
+
+StreamPipeline::Statistics VideoWG::statistics() const
+{
+    return m_Pipeline->statistics();
+}
 
-    return rc;
+void VideoWG::resetStatistics()
+{
+    m_Pipeline->resetStatistics();
 }
 
 bool VideoWG::save(const QString &filename, const char *format)
@@ -132,52 +113,3 @@ void VideoWG::mouseReleaseEvent(QMouseEvent *event)
     // determine selection, for example using QRect::intersects()
     // and QRect::contains().
 }
-
-bool VideoWG::debayer(const IBLOB *bp, const BayerParams &params)
-{
-    uint32_t rgb_size = streamW * streamH * 3;
-    auto * destinationBuffer = new uint8_t[rgb_size];
-
-    if (destinationBuffer == nullptr)
-    {
-        qCCritical(KSTARS) << "Unable to allocate memory for temporary bayer buffer.";
-        return false;
-    }
-
-    int ds1394_height = streamH;
-
-    uint8_t * dc1394_source = reinterpret_cast<uint8_t*>(bp->blob);
-    if (params.offsetY == 1)
-    {
-        dc1394_source += streamW;
-        ds1394_height--;
-    }
-    if (params.offsetX == 1)
-    {
-        dc1394_source++;
-    }
-    dc1394error_t error_code = dc1394_bayer_decoding_8bit(dc1394_source, destinationBuffer, streamW, ds1394_height,
-                               params.filter, params.method);
-
-    if (error_code != DC1394_SUCCESS)
-    {
-        qCCritical(KSTARS) << "Debayer failed" << error_code;
-        delete[] destinationBuffer;
-        return false;
-    }
-
-    streamImage.reset(new QImage(destinationBuffer, streamW, streamH, QImage::Format_RGB888));
-    bool rc = !streamImage->isNull();
-
-    if (rc)
-    {
-        kPix = QPixmap::fromImage(streamImage->scaled(size(), Qt::KeepAspectRatio));
-        setPixmap(kPix);
-    }
-
-    emit imageChanged(streamImage);
-
-    delete[] destinationBuffer;
-    return rc;
-}
-
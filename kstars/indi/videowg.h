@@ -11,6 +11,7 @@
 #pragma once
 
 #include "fitsviewer/bayer.h"
+#include "streampipeline.h"
 
 #include <indidevapi.h>
 
@@ -40,6 +41,10 @@ class VideoWG : public QLabel
 
         void setSize(uint16_t w, uint16_t h);
 
+        // Frame counters of the stream, see StreamPipeline.
+        StreamPipeline::Statistics statistics() const;
+        void resetStatistics();
+
     protected:
         //virtual void resizeEvent(QResizeEvent *ev) override;
         void mousePressEvent(QMouseEvent *event) override;
@@ -49,18 +54,19 @@ class VideoWG : public QLabel
     signals:
         void newSelection(QRect);
         void imageChanged(const QSharedPointer<QImage> &frame);
+        // A frame accepted by newFrame() or newBayerFrame() could not be decoded.
+        void frameFailed();
 
-    private:
-        bool debayer(const IBLOB *bp, const BayerParams &params);
+    private slots:
+        void displayFrame(const QSharedPointer<QImage> &frame, const QImage &scaled);
 
+    private:
         uint16_t streamW { 0 };
         uint16_t streamH { 0 };
         uint32_t totalBaseCount { 0 };
-        QVector<QRgb> grayTable;
         QSharedPointer<QImage> streamImage;
+        std::unique_ptr<StreamPipeline> m_Pipeline;
         QPixmap kPix;
         QRubberBand *rubberBand { nullptr };
         QPoint origin;
-        QString m_RawFormat;
-        bool m_RawFormatSupported { false };
 };
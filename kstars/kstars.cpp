@@ -269,12 +269,6 @@ KStars::~KStars()
     releaseResources();
     Q_ASSERT(pinstance);
     pinstance = nullptr;
-#ifdef PROFILE_COORDINATE_CONVERSION
-    qDebug() << "Spent " << SkyPoint::cpuTime_EqToHz << " seconds in " << SkyPoint::eqToHzCalls
-             << " calls to SkyPoint::EquatorialToHorizontal, for an average of "
-             << 1000. * (SkyPoint::cpuTime_EqToHz / SkyPoint::eqToHzCalls) << " ms per call";
-#endif
-
 #ifdef COUNT_DMS_SINCOS_CALLS
     qDebug() << "Constructed " << dms::dms_constructor_calls << " dms objects, of which " << dms::dms_with_sincos_called
              << " had trigonometric functions called on them = "
@@ -470,6 +470,19 @@ class KStars : public KXmlGuiWindow
              */
         Q_SCRIPTABLE QString getSkyMapDimensions();
 
+        /** DBUS interface function.  Enable or disable the runtime profiling counters.
+             * @param enable true to start collecting, false to stop. Counters keep their values while stopped.
+             */
+        Q_SCRIPTABLE Q_NOREPLY void setProfilingEnabled(bool enable);
+
+        /** DBUS interface function.  Restart the profiling counters from zero. */
+        Q_SCRIPTABLE Q_NOREPLY void resetProfiling();
+
+        /** DBUS interface function.  Get the profiling counters.
+             * @return a JSON array with the name, calls, seconds, callsPerSecond and load of each counter.
+             */
+        Q_SCRIPTABLE QString getProfilingStatistics();
+
         /** DBUS interface function.  Return a newline-separated list of objects in the observing wishlist.
              * @note Unfortunately, unnamed objects are troublesome. Hopefully, we don't have them on the observing list.
              */
@@ -23,6 +23,7 @@
 #include "eyepiecefield.h"
 #include "imageexporter.h"
 #include "ksdssdownloader.h"
+#include "ksprofiler.h"
 #include "kstarsdata.h"
 #include "observinglist.h"
 #include "Options.h"
@@ -971,6 +972,22 @@ QString KStars::getSkyMapDimensions()
 {
     return (QString::number(map()->width()) + 'x' + QString::number(map()->height()));
 }
+
+void KStars::setProfilingEnabled(bool enable)
+{
+    KSProfiler::Registry::Instance()->setEnabled(enable);
+}
+
+void KStars::resetProfiling()
+{
+    KSProfiler::Registry::Instance()->reset();
+}
+
+QString KStars::getProfilingStatistics()
+{
+    return KSProfiler::Registry::Instance()->toJson();
+}
+
 void KStars::printImage(bool usePrintDialog, bool useChartColors)
 {
     //QPRINTER_FOR_NOW
@@ -30,6 +30,7 @@
 #include "version.h"
 #if !defined(KSTARS_LITE)
 #include "kstars.h"
+#include "renderserver.h"
 #include "skymap.h"
 #endif
 
@@ -45,6 +46,7 @@
 #include <QCommandLineOption>
 #endif
 #include <QDebug>
+#include <QFile>
 #include <QPixmap>
 #include <QScreen>
 #include <QtGlobal>
@@ -169,6 +171,9 @@ int main(int argc, char *argv[])
     parser.addOption(QCommandLineOption("height", i18n("Height of sky image."), "value"));
     parser.addOption(QCommandLineOption("date", i18n("Date and time."), "string"));
     parser.addOption(QCommandLineOption("paused", i18n("Start with clock paused.")));
+    parser.addOption(QCommandLineOption("render-server",
+                                        i18n("Render sky images requested as JSON lines on a local socket, or on stdin if the name is -."),
+                                        "name"));
 
     // urls to open
     parser.addPositionalArgument(QStringLiteral("urls"), i18n("FITS file(s) to open."), QStringLiteral("[urls...]"));
@@ -310,6 +315,40 @@ int main(int argc, char *argv[])
         return 0;
     }
 
+    if (parser.isSet("render-server"))
+    {
+        KStarsData *dat = KStarsData::Create();
+        QObject::connect(dat, SIGNAL(progressText(QString)), dat, SLOT(slotConsoleMessage(QString)));
+        dat->initialize();
+        dat->setLocationFromOptions();
+        dat->colorScheme()->loadFromConfig();
+        // Each job sets the time it is rendered for
+        dat->clock()->stop();
+
+        SkyMap *map = SkyMap::Create();
+        RenderServer server(dat, map);
+        int result  = 0;
+
+        const QString name = parser.value("render-server");
+        if (name == "-")
+        {
+            QFile in, out;
+            in.open(stdin, QIODevice::ReadOnly);
+            out.open(stdout, QIODevice::WriteOnly);
+            server.serve(&in, &out);
+        }
+        else if (server.listen(name))
+        {
+            QObject::connect(&server, &RenderServer::quitRequested, qApp, &QCoreApplication::quit, Qt::QueuedConnection);
+            result = app.exec();
+        }
+        else
+            result = 1;
+
+        delete map;
+        return result;
+    }
+
     //Try to parse the given date string
     QString datestring = parser.value("date");
 
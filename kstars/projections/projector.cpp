@@ -103,6 +103,44 @@ double Projector::fov() const
     return m_fov;
 }
 
+quint64 Projector::stateKey() const
+{
+    // Only the focus coordinates of the projection are used, the other pair is recomputed on
+    // every clock tick. They are rounded to half a pixel, as the sidereal time in LineListIndex.
+    const double halfPixel = 0.5 / m_vp.zoomFactor / dms::DegToRad;
+    double focusX = 0, focusY = 0;
+    if (m_vp.focus && m_vp.useAltAz)
+    {
+        focusX = std::floor(m_vp.focus->az().Degrees() / halfPixel);
+        focusY = std::floor(m_vp.focus->alt().Degrees() / halfPixel);
+    }
+    else if (m_vp.focus)
+    {
+        focusX = std::floor(m_vp.focus->ra().Degrees() / halfPixel);
+        focusY = std::floor(m_vp.focus->dec().Degrees() / halfPixel);
+    }
+
+    const double state[] = { static_cast<double>(type()),
+                             m_vp.width,
+                             m_vp.height,
+                             m_vp.zoomFactor,
+                             static_cast<double>(m_vp.useRefraction),
+                             static_cast<double>(m_vp.useAltAz),
+                             static_cast<double>(m_vp.fillGround),
+                             focusX,
+                             focusY };
+
+    // FNV-1a
+    quint64 key             = 14695981039346656037ULL;
+    const unsigned char *it = reinterpret_cast<const unsigned char *>(state);
+    for (size_t i = 0; i < sizeof(state); i++)
+    {
+        key ^= it[i];
+        key *= 1099511628211ULL;
+    }
+    return key;
+}
+
 QPointF Projector::toScreen(const SkyPoint *o, bool oRefract, bool *onVisibleHemisphere) const
 {
     return KSUtils::vecToPoint(toScreenVec(o, oRefract, onVisibleHemisphere));
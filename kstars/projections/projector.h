@@ -98,6 +98,16 @@ class Projector
     /** Return the FOV of this projection */
     double fov() const;
 
+    /** Return the view parameters of this projection */
+    const ViewParams &viewParams() const { return m_vp; }
+
+    /**
+     * @return a key identifying the type, view parameters and focus of this projection.
+     * The focus is rounded to half a pixel, so points that do not move keep their screen
+     * coordinates within half a pixel while the key is unchanged.
+     */
+    quint64 stateKey() const;
+
     /**
      * Check if the current point on screen is a valid point on the sky. This is needed
      * to avoid a crash of the program if the user clicks on a point outside the sky (the
@@ -82,9 +82,7 @@ bool ArtificialHorizonComponent::load()
 void ArtificialHorizonComponent::save()
 {
     KStarsData::Instance()->userdb()->DeleteAllHorizons();
-
-    foreach (ArtificialHorizonEntity *horizon, m_HorizonList)
-        KStarsData::Instance()->userdb()->AddHorizon(horizon);
+    KStarsData::Instance()->userdb()->AddHorizons(m_HorizonList);
 }
 
 bool ArtificialHorizonComponent::selected()
@@ -22,6 +22,7 @@
 #endif
 #include "ksfilereader.h"
 #include "kstarsdata.h"
+#include "nameindex.h"
 #include "Options.h"
 #include "solarsystemcomposite.h"
 #include "skycomponent.h"
@@ -189,6 +190,8 @@ void AsteroidsComponent::loadDataFromText()
         objectNames(SkyObject::ASTEROID).append(name);
         objectLists(SkyObject::ASTEROID).append(QPair<QString, const SkyObject *>(name, new_asteroid));
     }
+
+    nameIndex().invalidate(SkyObject::ASTEROID);
 }
 
 void AsteroidsComponent::draw(SkyPainter *skyp)
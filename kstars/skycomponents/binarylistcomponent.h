@@ -20,6 +20,7 @@
 #include <QDataStream>
 
 #include "listcomponent.h"
+#include "nameindex.h"
 #include "binarylistcomponent.h"
 #include "auxiliary/kspaths.h"
 
@@ -216,6 +217,7 @@ void  BinaryListComponent<T, Component>::loadDataFromBinary(QFile &binfile)
         parent->objectNames(T::TYPE).append(new_object->name());
         parent->objectLists(T::TYPE).append(QPair<QString, const SkyObject *>(new_object->name(), new_object));
     }
+    parent->nameIndex().invalidate(T::TYPE);
     binfile.close();
 }
 
@@ -265,4 +267,5 @@ void  BinaryListComponent<T, Component>::clearData()
 
     parent->objectLists(T::TYPE).clear();
     parent->objectNames(T::TYPE).clear();
+    parent->nameIndex().invalidate(T::TYPE);
 }
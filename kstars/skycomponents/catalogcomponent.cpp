@@ -19,11 +19,14 @@
 
 #include "catalogdata.h"
 #include "kstarsdata.h"
+#include "nameindex.h"
 #include "skypainter.h"
 #include "skyobjects/starobject.h"
 #include "skyobjects/deepskyobject.h"
 #include "skycomponents/deepskycomponent.h"
 
+#include <QSet>
+
 CatalogComponent::CatalogComponent(SkyComposite *parent, const QString &catname, bool showerrs, int index,
                                    bool callLoadData)
     : ListComponent(parent), m_catName(catname), m_Showerrs(showerrs), m_ccIndex(index)
@@ -95,6 +98,7 @@ void CatalogComponent::_loadData(bool includeCatalogDesignation)
     }
 
     //FIXME - get rid of objectNames completely. For now only KStars Lite uses objectLists
+    QSet<int> types;
     for (auto obj : m_ObjectList)
     {
         Q_ASSERT(obj);
@@ -134,9 +138,14 @@ void CatalogComponent::_loadData(bool includeCatalogDesignation)
             {
                 objectLists(obj->type()).append(QPair<QString, const SkyObject *>(longname, obj));
             }
+
+            types.insert(obj->type());
         }
     }
 
+    for (int type : types)
+        nameIndex().invalidate(type);
+
     // Remove Duplicates (see FIXME by AS above)
     for (auto &list : objectNames())
         list.removeDuplicates();
@@ -31,6 +31,7 @@
 #else
 #include "kstarslite.h"
 #endif
+#include "nameindex.h"
 #include "Options.h"
 #include "skylabeler.h"
 #include "skypainter.h"
@@ -181,6 +182,8 @@ void CometsComponent::loadData()
         objectNames(SkyObject::COMET).append(com->name());
         objectLists(SkyObject::COMET).append(QPair<QString, const SkyObject *>(com->name(), com));
     }
+
+    nameIndex().invalidate(SkyObject::COMET);
 }
 
 void CometsComponent::draw(SkyPainter *skyp)
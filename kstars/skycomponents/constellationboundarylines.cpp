@@ -18,6 +18,7 @@
 #include "constellationboundarylines.h"
 
 #include "ksfilereader.h"
+#include "kspaths.h"
 #include "kstarsdata.h"
 #include "linelist.h"
 #include "Options.h"
@@ -31,8 +32,11 @@
 #include "htmesh/MeshIterator.h"
 #include "skycomponents/skymapcomposite.h"
 
+#include <QDir>
 #include <QHash>
 
+#include <kstars_debug.h>
+
 ConstellationBoundaryLines::ConstellationBoundaryLines(SkyComposite *parent)
     : NoPrecessIndex(parent, i18n("Constellation Boundaries"))
 {
@@ -87,7 +91,10 @@ ConstellationBoundaryLines::ConstellationBoundaryLines(SkyComposite *parent)
             lineList.reset();
 
             if (polyList.get())
+            {
                 appendPoly(polyList, idxFile, verbose);
+                m_Boundaries.append(polyList);
+            }
             QString cName = line.mid(1);
             polyList.reset(new PolyList(cName));
             if (verbose == -1)
@@ -147,7 +154,19 @@ ConstellationBoundaryLines::ConstellationBoundaryLines(SkyComposite *parent)
     if (lineList.get())
         appendLine(lineList);
     if (polyList.get())
+    {
         appendPoly(polyList, idxFile, verbose);
+        m_Boundaries.append(polyList);
+    }
+
+    // The lookup grid only depends on the boundaries, so it is built once and kept
+    const QString gridFile = QDir(KSPaths::writableLocation(QStandardPaths::GenericDataLocation)).filePath("cbounds.grid");
+    if (!m_LookupGrid.load(gridFile, m_Boundaries))
+    {
+        m_LookupGrid.build(m_Boundaries);
+        if (!m_LookupGrid.save(gridFile))
+            qCWarning(KSTARS) << "Cannot save constellation lookup grid" << gridFile;
+    }
 }
 
 bool ConstellationBoundaryLines::selected()
@@ -205,6 +224,13 @@ void ConstellationBoundaryLines::appendPoly(const std::shared_ptr<PolyList> &pol
 
 PolyList *ConstellationBoundaryLines::ContainingPoly(SkyPoint *p)
 {
+    if (!m_LookupGrid.isEmpty())
+    {
+        const int id = m_LookupGrid.find(p->ra().Hours(), p->dec().Degrees());
+        return id >= 0 ? m_Boundaries[id].get() : nullptr;
+    }
+
+    // Without the grid, fall back on the boundaries indexed in the sky mesh
     //printf("called ContainingPoly(p)\n");
 
     // we save the pointers in a hash because most often there is only one
@@ -276,7 +302,27 @@ PolyList *ConstellationBoundaryLines::ContainingPoly(SkyPoint *p)
 
 QString ConstellationBoundaryLines::constellationName(SkyPoint *p)
 {
-    PolyList *polyList = ContainingPoly(p);
+    return displayName(ContainingPoly(p));
+}
+
+QString ConstellationBoundaryLines::constellationName(int id)
+{
+    return displayName(id >= 0 && id < m_Boundaries.size() ? m_Boundaries[id].get() : nullptr);
+}
+
+std::vector<int> ConstellationBoundaryLines::constellationIds(const std::vector<SkyPoint> &points) const
+{
+    std::vector<int> ids;
+    ids.reserve(points.size());
+
+    for (const auto &p : points)
+        ids.push_back(m_LookupGrid.find(p.ra().Hours(), p.dec().Degrees()));
+
+    return ids;
+}
+
+QString ConstellationBoundaryLines::displayName(PolyList *polyList)
+{
     if (polyList)
     {
         return (Options::useLocalConstellNames() ?
@@ -17,11 +17,14 @@
 
 #pragma once
 
+#include "constellationlookupgrid.h"
 #include "noprecessindex.h"
 
 #include <QHash>
 #include <QPolygonF>
 
+#include <vector>
+
 class PolyList;
 class ConstellationBoundary;
 class KSFileReader;
@@ -54,6 +57,16 @@ class ConstellationBoundaryLines : public NoPrecessIndex
 
     QString constellationName(SkyPoint *p);
 
+    /** @return the name of a constellation returned by constellationIds(), or "Unknown" for -1 */
+    QString constellationName(int id);
+
+    /**
+     * @short Find the constellations of many points at once.
+     * @return for each point, the id of the constellation containing it, or -1 if unknown.
+     * @note Lookups use the precomputed grid, so they are safe to call from any thread.
+     */
+    std::vector<int> constellationIds(const std::vector<SkyPoint> &points) const;
+
     bool selected() override;
 
     void preDraw(SkyPainter *skyp) override;
@@ -70,7 +83,13 @@ class ConstellationBoundaryLines : public NoPrecessIndex
 
     PolyList *ContainingPoly(SkyPoint *p);
 
+    QString displayName(PolyList *polyList);
+
     SkyMesh *m_skyMesh { nullptr };
     PolyIndex m_polyIndex;
     int m_polyIndexCnt { 0 };
+
+    /// The boundaries in file order, their index is the constellation id
+    ConstellationLookupGrid::Boundaries m_Boundaries;
+    ConstellationLookupGrid m_LookupGrid;
 };
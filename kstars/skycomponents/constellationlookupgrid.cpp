@@ -0,0 +1,285 @@
+/***************************************************************************
+                 constellationlookupgrid.cpp  -  K Desktop Planetarium
+                             -------------------
+    begin                : 2026
+    copyright            : (C) 2026 KStars Developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "constellationlookupgrid.h"
+
+#include "polylist.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QFile>
+#include <QHash>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// "KSCG", followed by the format version
+const quint32 FileMagic   = 0x4B534347;
+const quint16 FileVersion = 1;
+
+// Widens the boxes marked around boundary edges, so that cells merely
+// touching an edge are treated as crossed
+const double Margin = 1e-6;
+}
+
+void ConstellationLookupGrid::build(const Boundaries &boundaries)
+{
+    m_Boundaries = boundaries;
+    m_Hash       = hash(boundaries);
+    m_Bounds.clear();
+    for (const auto &b : m_Boundaries)
+        m_Bounds.append(b->poly()->boundingRect());
+
+    const int cellCount = RAColumns * DecRows;
+
+    // Boundaries whose edges cross each cell
+    QVector<QVector<qint16>> crossing(cellCount);
+    for (int id = 0; id < m_Boundaries.size(); ++id)
+    {
+        const QPolygonF *poly = m_Boundaries[id]->poly();
+        const bool wrap       = m_Boundaries[id]->wrapRA();
+        const int n           = poly->size();
+
+        // containsPoint() closes the polygon, so does this
+        for (int i = 0; i < n; ++i)
+        {
+            const QPointF &a = poly->at(i);
+            const QPointF &b = poly->at((i + 1) % n);
+            const double x0 = std::min(a.x(), b.x()), x1 = std::max(a.x(), b.x());
+            const double y0 = std::min(a.y(), b.y()), y1 = std::max(a.y(), b.y());
+
+            // Negative hours of wrapping boundaries are looked up past 12h
+            if (wrap && x0 < 0)
+            {
+                mark(crossing, id, x0 + 24.0, std::min(x1, 0.0) + 24.0, y0, y1);
+                if (x1 >= 0)
+                    mark(crossing, id, 0.0, x1, y0, y1);
+            }
+            else
+                mark(crossing, id, x0, x1, y0, y1);
+        }
+    }
+
+    m_Cells.fill(-1, cellCount);
+    m_ListStart.clear();
+    m_ListData.clear();
+    m_ListStart.append(0);
+
+    QHash<QVector<qint16>, int> lists;
+
+    for (int row = 0; row < DecRows; ++row)
+    {
+        const double dec = -90.0 + (row + 0.5) * 180.0 / DecRows;
+        for (int column = 0; column < RAColumns; ++column)
+        {
+            const double ra = (column + 0.5) * 24.0 / RAColumns;
+            const int cell  = row * RAColumns + column;
+
+            QVector<qint16> candidates = crossing[cell];
+
+            // A boundary containing the center of the cell without crossing it covers the whole cell
+            const int cover = owner(ra, dec, candidates);
+
+            if (candidates.isEmpty())
+            {
+                m_Cells[cell] = cover;
+                continue;
+            }
+
+            // Lookups return the first boundary containing the point, as the polygon test does
+            std::sort(candidates.begin(), candidates.end());
+            if (cover >= 0)
+            {
+                if (cover < candidates.first())
+                {
+                    m_Cells[cell] = cover;
+                    continue;
+                }
+                candidates.erase(std::upper_bound(candidates.begin(), candidates.end(), cover), candidates.end());
+                candidates.append(cover);
+            }
+
+            auto it = lists.constFind(candidates);
+            if (it == lists.constEnd())
+            {
+                it = lists.insert(candidates, m_ListStart.size() - 1);
+                m_ListData += candidates;
+                m_ListStart.append(m_ListData.size());
+            }
+            m_Cells[cell] = -2 - it.value();
+        }
+    }
+}
+
+void ConstellationLookupGrid::mark(QVector<QVector<qint16>> &crossing, int id, double ra0, double ra1, double dec0,
+                                   double dec1) const
+{
+    const int c0 = cellIndex(ra0 - Margin, dec0 - Margin);
+    const int c1 = cellIndex(ra1 + Margin, dec1 + Margin);
+
+    for (int row = c0 / RAColumns; row <= c1 / RAColumns; ++row)
+    {
+        for (int column = c0 % RAColumns; column <= c1 % RAColumns; ++column)
+        {
+            QVector<qint16> &cell = crossing[row * RAColumns + column];
+            if (cell.isEmpty() || cell.last() != id)
+                cell.append(id);
+        }
+    }
+}
+
+int ConstellationLookupGrid::cellIndex(double ra, double dec)
+{
+    const int column = std::min(std::max(static_cast<int>(floor(ra * RAColumns / 24.0)), 0), RAColumns - 1);
+    const int row    = std::min(std::max(static_cast<int>(floor((dec + 90.0) * DecRows / 180.0)), 0), DecRows - 1);
+
+    return row * RAColumns + column;
+}
+
+bool ConstellationLookupGrid::contains(PolyList *boundary, double ra, double dec)
+{
+    const QPointF point((ra > 12.0 && boundary->wrapRA()) ? ra - 24.0 : ra, dec);
+    return boundary->poly()->containsPoint(point, Qt::OddEvenFill);
+}
+
+int ConstellationLookupGrid::owner(double ra, double dec, const QVector<qint16> &skip) const
+{
+    for (int id = 0; id < m_Boundaries.size(); ++id)
+    {
+        if (skip.contains(id))
+            continue;
+
+        const double x = (ra > 12.0 && m_Boundaries[id]->wrapRA()) ? ra - 24.0 : ra;
+        if (m_Bounds[id].contains(QPointF(x, dec)) && contains(m_Boundaries[id].get(), ra, dec))
+            return id;
+    }
+
+    return -1;
+}
+
+int ConstellationLookupGrid::find(double ra, double dec) const
+{
+    if (m_Cells.isEmpty())
+        return -1;
+
+    const int value = m_Cells[cellIndex(ra, dec)];
+    if (value >= -1)
+        return value;
+
+    const int list = -2 - value;
+    for (int i = m_ListStart[list]; i < m_ListStart[list + 1]; ++i)
+    {
+        if (contains(m_Boundaries[m_ListData[i]].get(), ra, dec))
+            return m_ListData[i];
+    }
+
+    return -1;
+}
+
+int ConstellationLookupGrid::mixedCells() const
+{
+    return static_cast<int>(std::count_if(m_Cells.constBegin(), m_Cells.constEnd(), [](qint16 value)
+    {
+        return value < -1;
+    }));
+}
+
+QByteArray ConstellationLookupGrid::hash(const Boundaries &boundaries)
+{
+    QCryptographicHash hash(QCryptographicHash::Md5);
+
+    for (const auto &b : boundaries)
+    {
+        hash.addData(b->name().toUtf8());
+        hash.addData(b->wrapRA() ? "w" : "n", 1);
+        hash.addData(reinterpret_cast<const char *>(b->poly()->constData()), b->poly()->size() * sizeof(QPointF));
+    }
+
+    return hash.result();
+}
+
+bool ConstellationLookupGrid::load(const QString &fileName, const Boundaries &boundaries)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic;
+    quint16 version;
+    QByteArray fileHash;
+    qint32 columns, rows;
+    in >> magic >> version >> fileHash >> columns >> rows;
+
+    if (in.status() != QDataStream::Ok || magic != FileMagic || version != FileVersion || columns != RAColumns ||
+            rows != DecRows || fileHash != hash(boundaries))
+        return false;
+
+    QVector<qint16> cells, listData;
+    QVector<qint32> listStart;
+    in >> cells >> listStart >> listData;
+
+    if (in.status() != QDataStream::Ok || cells.size() != RAColumns * DecRows || listStart.isEmpty() ||
+            listStart.last() != listData.size())
+        return false;
+
+    // Make sure a damaged file cannot send lookups out of bounds
+    for (qint16 value : cells)
+    {
+        if (value >= boundaries.size() || -2 - value >= listStart.size() - 1)
+            return false;
+    }
+    for (qint16 id : listData)
+    {
+        if (id < 0 || id >= boundaries.size())
+            return false;
+    }
+    for (int i = 1; i < listStart.size(); ++i)
+    {
+        if (listStart[i] < listStart[i - 1])
+            return false;
+    }
+
+    m_Boundaries = boundaries;
+    m_Hash       = fileHash;
+    m_Cells      = cells;
+    m_ListStart  = listStart;
+    m_ListData   = listData;
+    m_Bounds.clear();
+    for (const auto &b : m_Boundaries)
+        m_Bounds.append(b->poly()->boundingRect());
+
+    return true;
+}
+
+bool ConstellationLookupGrid::save(const QString &fileName) const
+{
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_0);
+    out << FileMagic << FileVersion << m_Hash << static_cast<qint32>(RAColumns) << static_cast<qint32>(DecRows);
+    out << m_Cells << m_ListStart << m_ListData;
+
+    return file.commit();
+}
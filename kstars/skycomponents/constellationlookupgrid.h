@@ -0,0 +1,105 @@
+/***************************************************************************
+                 constellationlookupgrid.h  -  K Desktop Planetarium
+                             -------------------
+    begin                : 2026
+    copyright            : (C) 2026 KStars Developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QByteArray>
+#include <QRectF>
+#include <QString>
+#include <QVector>
+
+#include <memory>
+
+class PolyList;
+
+/**
+ * @class ConstellationLookupGrid
+ * @short Equiangular RA/Dec grid answering which constellation contains a point.
+ *
+ * Each cell of the grid either stores the constellation that covers the whole
+ * cell, or a short list of candidate boundaries for the cells that boundary
+ * lines cross. Most lookups are a single array read; the others only test the
+ * few polygons of their cell.
+ *
+ * The grid is built once from the boundary polygons, and may be saved to a
+ * binary file. A saved grid is only loaded back for the same boundaries.
+ *
+ * Lookups are read-only and may be done from several threads.
+ *
+ * @author KStars Developers
+ */
+class ConstellationLookupGrid
+{
+  public:
+    typedef QVector<std::shared_ptr<PolyList>> Boundaries;
+
+    /** Grid size, half a degree in both directions */
+    static const int RAColumns = 720;
+    static const int DecRows   = 360;
+
+    /** @short Build the grid from the constellation boundaries. Boundary ids are their index in the list. */
+    void build(const Boundaries &boundaries);
+
+    /**
+     * @short Load a grid saved for the same boundaries.
+     * @return false if the file is missing, damaged or was saved for other boundaries.
+     */
+    bool load(const QString &fileName, const Boundaries &boundaries);
+
+    /** @short Save the grid, to be loaded back with load(). */
+    bool save(const QString &fileName) const;
+
+    bool isEmpty() const { return m_Cells.isEmpty(); }
+
+    /**
+     * @return the id of the boundary containing the point, or -1 if none does.
+     * @param ra right ascension in hours, in [0, 24)
+     * @param dec declination in degrees
+     */
+    int find(double ra, double dec) const;
+
+    /** @return the number of cells that need polygon tests */
+    int mixedCells() const;
+
+    /**
+     * @short The polygon test of a single boundary.
+     * Boundaries that wrap around RA 0h use negative hours, so points past
+     * 12h are shifted by 24h before being tested against them.
+     */
+    static bool contains(PolyList *boundary, double ra, double dec);
+
+  private:
+    static int cellIndex(double ra, double dec);
+    static QByteArray hash(const Boundaries &boundaries);
+
+    /**
+     * @return the first boundary containing the point, or -1. Bounding boxes are
+     * checked first to skip most boundaries, and the boundaries in skip are ignored.
+     */
+    int owner(double ra, double dec, const QVector<qint16> &skip) const;
+    /** Add a boundary to the lists of cells crossed by the box, in lookup coordinates */
+    void mark(QVector<QVector<qint16>> &crossing, int id, double ra0, double ra1, double dec0, double dec1) const;
+
+    Boundaries m_Boundaries;
+    QVector<QRectF> m_Bounds;
+    QByteArray m_Hash;
+
+    /// Boundary id, -1 for none, or -2 - n for the n-th candidate list
+    QVector<qint16> m_Cells;
+    /// Candidate list n is m_ListData[m_ListStart[n]] to m_ListData[m_ListStart[n + 1] - 1]
+    QVector<qint32> m_ListStart;
+    QVector<qint16> m_ListData;
+};
@@ -19,6 +19,7 @@
 
 #include "ksfilereader.h"
 #include "kstarsdata.h"
+#include "nameindex.h"
 #include "Options.h"
 #include "skylabeler.h"
 #ifndef KSTARS_LITE
@@ -99,6 +100,8 @@ void ConstellationNamesComponent::loadData(CultureList *cultures)
             objectLists(SkyObject::CONSTELLATION).append(QPair<QString, const SkyObject *>(name, o));
         }
     }
+
+    nameIndex().invalidate(SkyObject::CONSTELLATION);
 }
 
 bool ConstellationNamesComponent::selected()
@@ -17,10 +17,12 @@
 
 #include "deepskycomponent.h"
 
+#include "deepskysnapshot.h"
 #include "ksfilereader.h"
 #include "kspaths.h"
 #include "kstarsdata.h"
 #include "kstars_debug.h"
+#include "nameindex.h"
 #include "Options.h"
 #include "skylabeler.h"
 #ifndef KSTARS_LITE
@@ -32,6 +34,9 @@
 #include "projections/projector.h"
 #include "skyobjects/deepskyobject.h"
 
+#include <QDir>
+#include <QElapsedTimer>
+
 DeepSkyComponent::DeepSkyComponent(SkyComposite *parent) : SkyComponent(parent)
 {
     m_skyMesh = SkyMesh::Instance();
@@ -72,11 +77,44 @@ void DeepSkyComponent::update(KSNumbers *)
 
 void DeepSkyComponent::loadData()
 {
-    KStarsData *data = KStarsData::Instance();
     //Check whether we need to concatenate a split NGC/IC catalog
     //(i.e., if user has downloaded the Steinicke catalog)
     mergeSplitFiles();
 
+    QString file_name = KSPaths::locate(QStandardPaths::GenericDataLocation, QString("ngcic.dat"));
+    QString snapshotFile =
+        QDir(KSPaths::writableLocation(QStandardPaths::GenericDataLocation)).filePath("ngcic.snapshot");
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // The parsed catalog is saved once, and read back in one block on the next starts
+    DeepSkySnapshot snapshot;
+    if (snapshot.load(snapshotFile, file_name, m_skyMesh->size()))
+    {
+        for (const auto &record : snapshot.records())
+            appendObject(record, true);
+
+        qCInfo(KSTARS) << "Loaded" << snapshot.records().size() << "NGC/IC objects from" << snapshotFile << "in"
+                       << timer.elapsed() << "ms";
+    }
+    else
+    {
+        parseData(file_name, snapshot);
+
+        qCInfo(KSTARS) << "Parsed" << snapshot.records().size() << "NGC/IC objects from" << file_name << "in"
+                       << timer.elapsed() << "ms";
+
+        if (!snapshot.save(snapshotFile, file_name, m_skyMesh->size()))
+            qCWarning(KSTARS) << "Cannot save NGC/IC snapshot" << snapshotFile;
+    }
+
+    for (auto &list : objectNames())
+        list.removeDuplicates();
+}
+
+void DeepSkyComponent::parseData(const QString &file_name, DeepSkySnapshot &snapshot)
+{
     QList<QPair<QString, KSParser::DataTypes>> sequence;
     QList<int> widths;
     sequence.append(qMakePair(QString("Flag"), KSParser::D_QSTRING));
@@ -145,7 +183,6 @@ void DeepSkyComponent::loadData()
     sequence.append(qMakePair(QString("Longname"), KSParser::D_QSTRING));
     //No width to be appended for last sequence object
 
-    QString file_name = KSPaths::locate(QStandardPaths::GenericDataLocation, QString("ngcic.dat"));
     KSParser deep_sky_parser(file_name, '#', sequence, widths);
 
     deep_sky_parser.SetProgress(i18n("Loading NGC/IC objects"), 13444, 10);
@@ -299,82 +336,109 @@ void DeepSkyComponent::loadData()
             if (!longname.isEmpty())
                 name = longname;
             else
-            {
                 hasName = false;
-                name    = i18n("Unnamed Object");
-            }
         }
 
-        name = i18nc("object name (optional)", name.toLatin1().constData());
-        if (!longname.isEmpty())
-            longname = i18nc("object name (optional)", longname.toLatin1().constData());
-
-        // create new deepskyobject
-        DeepSkyObject *o = nullptr;
         if (type == 0)
             type = 1; //Make sure we use CATALOG_STAR, not STAR
-        o = new DeepSkyObject(type, r, d, mag, name, name2, longname, cat, a, b, pa, pgc, ugc);
-        o->EquatorialToHorizontal(data->lst(), data->geo()->lat());
 
-        // Add the name(s) to the nameHash for fast lookup -jbb
-        if (hasName)
-        {
-            nameHash[name.toLower()] = o;
-            if (!longname.isEmpty())
-                nameHash[longname.toLower()] = o;
-            if (!name2.isEmpty())
-                nameHash[name2.toLower()] = o;
-        }
+        DeepSkySnapshot::Record record;
+        record.type     = type;
+        record.ra       = r.Degrees();
+        record.dec      = d.Degrees();
+        record.mag      = mag;
+        record.name     = name;
+        record.name2    = name2;
+        record.longname = longname;
+        record.catalog  = cat;
+        record.a        = a;
+        record.b        = b;
+        record.pa       = pa;
+        record.pgc      = pgc;
+        record.ugc      = ugc;
+        record.hasName  = hasName;
+
+        record.trixel = appendObject(record, false);
+        snapshot.append(record);
 
-        Trixel trixel = m_skyMesh->index(o);
+        deep_sky_parser.ShowProgress();
+    }
+}
 
-        //Assign object to general DeepSkyObjects list,
-        //and a secondary list based on its catalog.
-        m_DeepSkyList.append(o);
-        appendIndex(o, &m_DeepSkyIndex, trixel);
+Trixel DeepSkyComponent::appendObject(const DeepSkySnapshot::Record &record, bool indexed)
+{
+    KStarsData *data = KStarsData::Instance();
 
-        if (o->isCatalogM())
-        {
-            m_MessierList.append(o);
-            appendIndex(o, &m_MessierIndex, trixel);
-        }
-        else if (o->isCatalogNGC())
-        {
-            m_NGCList.append(o);
-            appendIndex(o, &m_NGCIndex, trixel);
-        }
-        else if (o->isCatalogIC())
-        {
-            m_ICList.append(o);
-            appendIndex(o, &m_ICIndex, trixel);
-        }
-        else
-        {
-            m_OtherList.append(o);
-            appendIndex(o, &m_OtherIndex, trixel);
-        }
+    QString name = record.hasName ? record.name : i18n("Unnamed Object");
+    name = i18nc("object name (optional)", name.toLatin1().constData());
+    QString longname = record.longname;
+    if (!longname.isEmpty())
+        longname = i18nc("object name (optional)", longname.toLatin1().constData());
 
-        // JM: VERY INEFFICIENT. Disabling for now until we figure out how to deal with dups. QSet?
-        //if ( ! name.isEmpty() && !objectNames(type).contains(name))
-        if (!name.isEmpty())
-        {
-            objectNames(type).append(name);
-            objectLists(type).append(QPair<QString, SkyObject *>(name, o));
-        }
+    // create new deepskyobject
+    DeepSkyObject *o = new DeepSkyObject(record.type, dms(record.ra), dms(record.dec), record.mag, name, record.name2,
+                                         longname, record.catalog, record.a, record.b, record.pa, record.pgc,
+                                         record.ugc);
+    o->EquatorialToHorizontal(data->lst(), data->geo()->lat());
 
-        //Add long name to the list of object names
-        //if ( ! longname.isEmpty() && longname != name  && !objectNames(type).contains(longname))
-        if (!longname.isEmpty() && longname != name)
-        {
-            objectNames(type).append(longname);
-            objectLists(type).append(QPair<QString, SkyObject *>(longname, o));
-        }
+    // Add the name(s) to the nameHash for fast lookup -jbb
+    if (record.hasName)
+    {
+        nameHash[name.toLower()] = o;
+        if (!longname.isEmpty())
+            nameHash[longname.toLower()] = o;
+        if (!record.name2.isEmpty())
+            nameHash[record.name2.toLower()] = o;
+    }
 
-        deep_sky_parser.ShowProgress();
+    Trixel trixel = indexed ? record.trixel : m_skyMesh->index(o);
+
+    //Assign object to general DeepSkyObjects list,
+    //and a secondary list based on its catalog.
+    m_DeepSkyList.append(o);
+    appendIndex(o, &m_DeepSkyIndex, trixel);
+
+    if (o->isCatalogM())
+    {
+        m_MessierList.append(o);
+        appendIndex(o, &m_MessierIndex, trixel);
+    }
+    else if (o->isCatalogNGC())
+    {
+        m_NGCList.append(o);
+        appendIndex(o, &m_NGCIndex, trixel);
+    }
+    else if (o->isCatalogIC())
+    {
+        m_ICList.append(o);
+        appendIndex(o, &m_ICIndex, trixel);
+    }
+    else
+    {
+        m_OtherList.append(o);
+        appendIndex(o, &m_OtherIndex, trixel);
     }
 
-    for (auto &list : objectNames())
-        list.removeDuplicates();
+    // JM: VERY INEFFICIENT. Disabling for now until we figure out how to deal with dups. QSet?
+    //if ( ! name.isEmpty() && !objectNames(type).contains(name))
+    if (!name.isEmpty())
+    {
+        objectNames(record.type).append(name);
+        objectLists(record.type).append(QPair<QString, SkyObject *>(name, o));
+    }
+
+    //Add long name to the list of object names
+    //if ( ! longname.isEmpty() && longname != name  && !objectNames(type).contains(longname))
+    if (!longname.isEmpty() && longname != name)
+    {
+        objectNames(record.type).append(longname);
+        objectLists(record.type).append(QPair<QString, SkyObject *>(longname, o));
+    }
+
+    if (!name.isEmpty() || !longname.isEmpty())
+        nameIndex().invalidate(record.type);
+
+    return trixel;
 }
 
 void DeepSkyComponent::mergeSplitFiles()
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "deepskysnapshot.h"
 #include "skycomponent.h"
 #include "skylabel.h"
 
@@ -114,6 +115,13 @@ class DeepSkyComponent : public SkyComponent
 
 
   private:
+    /**
+     * @short Load the deep-sky objects.
+     * They are read from the snapshot of ngcic.dat if it is up to date. Otherwise
+     * the catalog is parsed, and the snapshot saved for the next starts.
+     */
+    void loadData();
+
     /**
      * @short Read the ngcic.dat deep-sky database.
      * Parse all lines from the deep-sky object catalog files. Construct a DeepSkyObject
@@ -140,9 +148,16 @@ class DeepSkyComponent : public SkyComponent
      * @li 64-69    PGC Catalog number [int] can be blank
      * @li 71-75    UGC Catalog number [int] can be blank
      * @li 77-END   Common name [string] can be blank
-     * @return true if data file is successfully read.
+     * @p snapshot receives the parsed records
      */
-    void loadData();
+    void parseData(const QString &file_name, DeepSkySnapshot &snapshot);
+
+    /**
+     * @short Create the object of a catalog record, and add it to the lists, indexes and names.
+     * @p indexed true if the trixel of the record is known, otherwise it is computed
+     * @return the trixel of the object
+     */
+    Trixel appendObject(const DeepSkySnapshot::Record &record, bool indexed);
 
     void clearList(QList<DeepSkyObject *> &list);
 
@@ -0,0 +1,123 @@
+/***************************************************************************
+                          deepskysnapshot.cpp  -  K Desktop Planetarium
+                             -------------------
+    begin                : 2026
+    copyright            : (C) 2026 KStars Developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "deepskysnapshot.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+namespace
+{
+// "KSDS", followed by the format version
+const quint32 FileMagic   = 0x4B534453;
+const quint16 FileVersion = 1;
+
+QDataStream &operator<<(QDataStream &out, const DeepSkySnapshot::Record &r)
+{
+    return out << r.type << r.ra << r.dec << r.mag << r.name << r.name2 << r.longname << r.catalog << r.a << r.b
+           << r.pa << r.pgc << r.ugc << r.hasName << r.trixel;
+}
+
+QDataStream &operator>>(QDataStream &in, DeepSkySnapshot::Record &r)
+{
+    return in >> r.type >> r.ra >> r.dec >> r.mag >> r.name >> r.name2 >> r.longname >> r.catalog >> r.a >> r.b >>
+           r.pa >> r.pgc >> r.ugc >> r.hasName >> r.trixel;
+}
+}
+
+bool DeepSkySnapshot::Record::operator==(const Record &other) const
+{
+    return type == other.type && ra == other.ra && dec == other.dec && mag == other.mag && name == other.name &&
+           name2 == other.name2 && longname == other.longname && catalog == other.catalog && a == other.a &&
+           b == other.b && pa == other.pa && pgc == other.pgc && ugc == other.ugc && hasName == other.hasName &&
+           trixel == other.trixel;
+}
+
+QByteArray DeepSkySnapshot::sourceKey(const QString &sourceFile)
+{
+    QFile file(sourceFile);
+    if (!file.open(QIODevice::ReadOnly))
+        return QByteArray();
+
+    // The time and size alone would miss a file replaced by a copy with an older time
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    if (!hash.addData(&file))
+        return QByteArray();
+
+    const QFileInfo info(sourceFile);
+    return QByteArray::number(info.lastModified().toMSecsSinceEpoch()) + ':' + QByteArray::number(info.size()) + ':' +
+           hash.result().toHex();
+}
+
+bool DeepSkySnapshot::load(const QString &fileName, const QString &sourceFile, int meshSize)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    // One read, the records are then decoded from memory
+    const QByteArray content = file.readAll();
+    QDataStream in(content);
+    in.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic;
+    quint16 version;
+    QByteArray key;
+    qint32 mesh, count;
+    in >> magic >> version >> key >> mesh >> count;
+
+    // A record takes more than a byte, this keeps a damaged count from allocating too much
+    if (in.status() != QDataStream::Ok || magic != FileMagic || version != FileVersion || mesh != meshSize ||
+            count < 0 || count > content.size() || key.isEmpty() || key != sourceKey(sourceFile))
+        return false;
+
+    QVector<Record> records(count);
+    for (auto &record : records)
+    {
+        in >> record;
+        // Make sure a damaged file cannot index objects out of the mesh
+        if (in.status() != QDataStream::Ok || record.trixel < 0 || record.trixel >= meshSize)
+            return false;
+    }
+    if (!in.atEnd())
+        return false;
+
+    m_Records = records;
+    return true;
+}
+
+bool DeepSkySnapshot::save(const QString &fileName, const QString &sourceFile, int meshSize) const
+{
+    const QByteArray key = sourceKey(sourceFile);
+    if (key.isEmpty())
+        return false;
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_0);
+    out << FileMagic << FileVersion << key << static_cast<qint32>(meshSize) << static_cast<qint32>(m_Records.size());
+    for (const auto &record : m_Records)
+        out << record;
+
+    return file.commit();
+}
@@ -0,0 +1,84 @@
+/***************************************************************************
+                          deepskysnapshot.h  -  K Desktop Planetarium
+                             -------------------
+    begin                : 2026
+    copyright            : (C) 2026 KStars Developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+/**
+ * @class DeepSkySnapshot
+ * @short Binary copy of the parsed NGC/IC catalog.
+ *
+ * Parsing ngcic.dat field by field is the slowest part of loading the deep-sky
+ * objects. DeepSkyComponent saves the parsed records once, with the trixel of
+ * each object, and reads them back in one block on the next starts.
+ *
+ * A snapshot is only loaded for the catalog file it was saved from, identified
+ * by its modification time, size and checksum, and for the same sky mesh.
+ * Names are stored untranslated, so that the snapshot does not depend on the
+ * language.
+ *
+ * @author KStars Developers
+ */
+class DeepSkySnapshot
+{
+  public:
+    /** The fields of a catalog line, as DeepSkyComponent::loadData() interprets them */
+    struct Record
+    {
+        qint32 type { 0 };
+        double ra { 0 };  ///< right ascension in degrees
+        double dec { 0 }; ///< declination in degrees
+        float mag { 0 };
+        QString name;
+        QString name2;
+        QString longname;
+        QString catalog;
+        float a { 0 };
+        float b { 0 };
+        qint32 pa { 0 };
+        qint32 pgc { 0 };
+        qint32 ugc { 0 };
+        bool hasName { false };
+        qint32 trixel { 0 };
+
+        bool operator==(const Record &other) const;
+        bool operator!=(const Record &other) const { return !(*this == other); }
+    };
+
+    /** @return the key identifying the contents of a catalog file, empty if the file cannot be read */
+    static QByteArray sourceKey(const QString &sourceFile);
+
+    /**
+     * @short Load a snapshot saved for the same catalog file and sky mesh.
+     * @param meshSize number of trixels of the sky mesh the objects are indexed in
+     * @return false if the file is missing, damaged or stale.
+     */
+    bool load(const QString &fileName, const QString &sourceFile, int meshSize);
+
+    /** @short Save the records, to be loaded back with load(). */
+    bool save(const QString &fileName, const QString &sourceFile, int meshSize) const;
+
+    void append(const Record &record) { m_Records.append(record); }
+    void clear() { m_Records.clear(); }
+
+    const QVector<Record> &records() const { return m_Records; }
+
+  private:
+    QVector<Record> m_Records;
+};
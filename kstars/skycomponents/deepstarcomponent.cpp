@@ -245,17 +245,6 @@ void DeepStarComponent::draw(SkyPainter *skyp)
     if (!fileOpened)
         return;
 
-#ifdef PROFILE_SINCOS
-    long trig_calls_here      = -dms::trig_function_calls;
-    long trig_redundancy_here = -dms::redundant_trig_function_calls;
-    long cachingdms_bad_uses  = -CachingDms::cachingdms_bad_uses;
-    dms::seconds_in_trig      = 0.;
-#endif
-
-#ifdef PROFILE_UPDATECOORDS
-    StarObject::updateCoordsCpuTime = 0.;
-    StarObject::starsUpdated        = 0;
-#endif
     SkyMap *map       = SkyMap::Instance();
     KStarsData *data  = KStarsData::Instance();
     UpdateID updateID = data->updateID();
@@ -409,24 +398,6 @@ void DeepStarComponent::draw(SkyPainter *skyp)
         t_drawUnnamed += t.restart();
     }
     m_skyMesh->inDraw(false);
-#ifdef PROFILE_SINCOS
-    trig_calls_here += dms::trig_function_calls;
-    trig_redundancy_here += dms::redundant_trig_function_calls;
-    cachingdms_bad_uses += CachingDms::cachingdms_bad_uses;
-    qDebug() << "Spent " << dms::seconds_in_trig << " seconds doing " << trig_calls_here
-             << " trigonometric function calls amounting to an average of "
-             << 1000.0 * dms::seconds_in_trig / double(trig_calls_here) << " ms per call";
-    qDebug() << "Redundancy of trig calls in this draw: "
-             << double(trig_redundancy_here) / double(trig_calls_here) * 100. << "%";
-    qDebug() << "CachedDms constructor calls so far: " << CachingDms::cachingdms_constructor_calls;
-    qDebug() << "Caching has prevented " << CachingDms::cachingdms_delta << " redundant trig function calls";
-    qDebug() << "Bad cache uses in this draw: " << cachingdms_bad_uses;
-#endif
-#ifdef PROFILE_UPDATECOORDS
-    qDebug() << "Spent " << StarObject::updateCoordsCpuTime << " seconds updating " << StarObject::starsUpdated
-             << " stars' coordinates (StarObject::updateCoords) for an average of "
-             << double(StarObject::updateCoordsCpuTime) / double(StarObject::starsUpdated) * 1.e6 << " us per star.";
-#endif
 
 #else
     Q_UNUSED(skyp)
@@ -146,14 +146,15 @@ void FlagComponent::saveToFile()
     TODO: This is a really bad way of storing things. Adding one flag shouldn't
     involve writing a new file/table every time. Needs fixing.
     */
-    KStarsData::Instance()->userdb()->DeleteAllFlags();    
+    KStarsData::Instance()->userdb()->DeleteAllFlags();
 
+    QList<QStringList> flags;
     for (int i = 0; i < size(); ++i)
     {
-        KStarsData::Instance()->userdb()->AddFlag(QString::number(epochCoords(i).first),
-                                                  QString::number(epochCoords(i).second), epoch(i),
-                                                  imageName(i).replace(' ', '_'), label(i), labelColor(i).name());
+        flags.append(QStringList() << QString::number(epochCoords(i).first) << QString::number(epochCoords(i).second)
+                                   << epoch(i) << imageName(i).replace(' ', '_') << label(i) << labelColor(i).name());
     }
+    KStarsData::Instance()->userdb()->AddFlags(flags);
 }
 
 void FlagComponent::add(const SkyPoint &flagPoint, QString epoch, QString image, QString label, QColor labelColor)
@@ -0,0 +1,307 @@
+/***************************************************************************
+                      labeloccupancy.cpp  -  K Desktop Planetarium
+                             -------------------
+    begin                : 2026
+    copyright            : (C) 2026 KStars Developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "labeloccupancy.h"
+
+#include <QtAlgorithms>
+
+#include <algorithm>
+
+//---------------------------------------------------------------------------//
+// Run lists
+//---------------------------------------------------------------------------//
+
+// We use Run Length Encoding to hold the information instead of an array of
+// chars.  This is both faster and smaller but the code is more complicated.
+//
+// This code is easy to break and hard to fix.
+
+LabelRunOccupancy::~LabelRunOccupancy()
+{
+    for (auto &row : m_rows)
+    {
+        qDeleteAll(*row);
+        delete row;
+    }
+}
+
+void LabelRunOccupancy::reset(int rows, int width, int minGap)
+{
+    Q_UNUSED(width)
+
+    m_minGap = minGap;
+
+    // Rows are never released, only cleared
+    for (auto &row : m_rows)
+    {
+        qDeleteAll(*row);
+        row->clear();
+    }
+    while (m_rows.size() < rows)
+        m_rows.append(new LabelRow());
+
+    m_elements = 0;
+}
+
+bool LabelRunOccupancy::mark(int minX, int maxX, int minY, int maxY)
+{
+    // check to see if we overlap any existing label
+    // We must check all rows before we start marking
+    for (int y = minY; y <= maxY; y++)
+    {
+        LabelRow *row = m_rows[y];
+        int i;
+        for (i = 0; i < row->size(); i++)
+        {
+            if (row->at(i)->end < minX)
+                continue; // skip past these
+            if (row->at(i)->start > maxX)
+                break;
+            return false;
+        }
+    }
+
+    // Okay, there was no overlap so let's insert the current rectangle into
+    // the rows.
+
+    for (int y = minY; y <= maxY; y++)
+    {
+        LabelRow *row = m_rows[y];
+
+        // Simplest case: an empty row
+        if (row->size() < 1)
+        {
+            row->append(new LabelRun(minX, maxX));
+            m_elements++;
+            continue;
+        }
+
+        // Find out our place in the universe (or row).
+        // H'mm.  Maybe we could cache these numbers above.
+        int i;
+        for (i = 0; i < row->size(); i++)
+        {
+            if (row->at(i)->end >= minX)
+                break;
+        }
+
+        // i now points to first label PAST ours
+
+        // if we are first, append or merge at start of list
+        if (i == 0)
+        {
+            if (row->at(0)->start - maxX < m_minGap)
+            {
+                row->at(0)->start = minX;
+            }
+            else
+            {
+                row->insert(0, new LabelRun(minX, maxX));
+                m_elements++;
+            }
+            continue;
+        }
+
+        // if we are past the last label, merge or append at end
+        else if (i == row->size())
+        {
+            if (minX - row->at(i - 1)->end < m_minGap)
+            {
+                row->at(i - 1)->end = maxX;
+            }
+            else
+            {
+                row->append(new LabelRun(minX, maxX));
+                m_elements++;
+            }
+            continue;
+        }
+
+        // if we got here, we must insert or merge the new label
+        //  between [i-1] and [i]
+
+        bool mergeHead = (minX - row->at(i - 1)->end < m_minGap);
+        bool mergeTail = (row->at(i)->start - maxX < m_minGap);
+
+        // double merge => combine all 3 into one
+        if (mergeHead && mergeTail)
+        {
+            row->at(i - 1)->end = row->at(i)->end;
+            delete row->at(i);
+            row->removeAt(i);
+            m_elements--;
+        }
+
+        // Merge label with [i-1]
+        else if (mergeHead)
+        {
+            row->at(i - 1)->end = maxX;
+        }
+
+        // Merge label with [i]
+        else if (mergeTail)
+        {
+            row->at(i)->start = minX;
+        }
+
+        // insert between the two
+        else
+        {
+            row->insert(i, new LabelRun(minX, maxX));
+            m_elements++;
+        }
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+// Bitmap
+//---------------------------------------------------------------------------//
+
+namespace
+{
+// Bits first % 64 to last % 64 of a word
+inline quint64 wordMask(int first, int last)
+{
+    return (~quint64(0) << (first & 63)) & (~quint64(0) >> (63 - (last & 63)));
+}
+}
+
+void LabelBitmapOccupancy::reset(int rows, int width, int minGap)
+{
+    m_width        = std::max(width, 1);
+    m_minGap       = minGap;
+    m_words        = (m_width + 63) / 64;
+    m_summaryWords = (m_words + 63) / 64;
+
+    m_bits.fill(0, rows * m_words);
+    m_summary.fill(0, rows * m_summaryWords);
+}
+
+bool LabelBitmapOccupancy::anySet(const quint64 *words, int first, int last)
+{
+    const int w0 = first >> 6, w1 = last >> 6;
+
+    if (w0 == w1)
+        return words[w0] & wordMask(first, last);
+
+    if (words[w0] & wordMask(first, 63))
+        return true;
+    for (int w = w0 + 1; w < w1; ++w)
+    {
+        if (words[w])
+            return true;
+    }
+    return words[w1] & wordMask(0, last);
+}
+
+int LabelBitmapOccupancy::highestSet(const quint64 *words, int first, int last)
+{
+    const int w0 = first >> 6;
+
+    for (int w = last >> 6; w >= w0; --w)
+    {
+        const quint64 bits = words[w] & wordMask(w == w0 ? first : 0, w == (last >> 6) ? last : 63);
+        if (bits)
+            return w * 64 + 63 - qCountLeadingZeroBits(bits);
+    }
+    return -1;
+}
+
+int LabelBitmapOccupancy::lowestSet(const quint64 *words, int first, int last)
+{
+    const int w1 = last >> 6;
+
+    for (int w = first >> 6; w <= w1; ++w)
+    {
+        const quint64 bits = words[w] & wordMask(w == (first >> 6) ? first : 0, w == w1 ? last : 63);
+        if (bits)
+            return w * 64 + qCountTrailingZeroBits(bits);
+    }
+    return -1;
+}
+
+void LabelBitmapOccupancy::setRange(quint64 *words, int first, int last)
+{
+    const int w0 = first >> 6, w1 = last >> 6;
+
+    if (w0 == w1)
+    {
+        words[w0] |= wordMask(first, last);
+        return;
+    }
+
+    words[w0] |= wordMask(first, 63);
+    for (int w = w0 + 1; w < w1; ++w)
+        words[w] = ~quint64(0);
+    words[w1] |= wordMask(0, last);
+}
+
+bool LabelBitmapOccupancy::overlaps(int row, int minX, int maxX) const
+{
+    // Check the summary first, wide ranges usually cross empty words
+    if (!anySet(m_summary.constData() + row * m_summaryWords, minX >> 6, maxX >> 6))
+        return false;
+    return anySet(m_bits.constData() + row * m_words, minX, maxX);
+}
+
+bool LabelBitmapOccupancy::mark(int minX, int maxX, int minY, int maxY)
+{
+    minX = std::max(minX, 0);
+    maxX = std::min(maxX, m_width - 1);
+    if (minX > maxX)
+        return true; // Off screen, nothing can be hidden
+
+    for (int y = minY; y <= maxY; y++)
+    {
+        if (overlaps(y, minX, maxX))
+            return false;
+    }
+
+    for (int y = minY; y <= maxY; y++)
+    {
+        quint64 *bits = m_bits.data() + y * m_words;
+        int first = minX, last = maxX;
+
+        // Merge with neighbours closer than the minimum gap, as the run lists do
+        if (minX > 0)
+        {
+            const int left = highestSet(bits, std::max(minX - m_minGap + 1, 0), minX - 1);
+            if (left >= 0)
+                first = left + 1;
+        }
+        if (maxX < m_width - 1)
+        {
+            const int right = lowestSet(bits, maxX + 1, std::min(maxX + m_minGap - 1, m_width - 1));
+            if (right >= 0)
+                last = right - 1;
+        }
+
+        setRange(bits, first, last);
+        setRange(m_summary.data() + y * m_summaryWords, first >> 6, last >> 6);
+    }
+
+    return true;
+}
+
+int LabelBitmapOccupancy::elements() const
+{
+    int count = 0;
+    for (quint64 word : m_summary)
+        count += qPopulationCount(word);
+    return count;
+}
@@ -0,0 +1,120 @@
+/***************************************************************************
+                      labeloccupancy.h  -  K Desktop Planetarium
+                             -------------------
+    begin                : 2026
+    copyright            : (C) 2026 KStars Developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QList>
+#include <QVector>
+
+/**
+ * @class LabelOccupancy
+ * @short Screen areas already covered by labels, used by SkyLabeler.
+ *
+ * The screen is divided in rows one label high. A label covers a range of
+ * pixel columns in one or more rows. When a label is marked, gaps narrower
+ * than the minimum gap between it and its neighbours in a row are marked too,
+ * which keeps labels from squeezing between close labels.
+ */
+class LabelOccupancy
+{
+  public:
+    virtual ~LabelOccupancy() = default;
+
+    /**
+     * @short Clear all marks and set up the screen.
+     * @param rows number of label rows
+     * @param width width of the screen in pixels
+     * @param minGap gaps narrower than this are merged when marking
+     */
+    virtual void reset(int rows, int width, int minGap) = 0;
+
+    /**
+     * @short Mark a region if it does not overlap any marked region.
+     * Columns are pixels, rows are label rows, both ranges are inclusive and
+     * the rows must be within the screen set up by reset().
+     * @return false if the region overlaps, in which case nothing is marked.
+     */
+    virtual bool mark(int minX, int maxX, int minY, int maxY) = 0;
+
+    /** @return the number of runs or words holding marks, for diagnostics */
+    virtual int elements() const = 0;
+};
+
+/**
+ * @class LabelRunOccupancy
+ * @short Keeps a sorted list of marked runs per row.
+ *
+ * Overlap tests and insertions are linear in the number of runs of a row.
+ * This is the original SkyLabeler implementation, kept for comparison.
+ */
+class LabelRunOccupancy : public LabelOccupancy
+{
+  public:
+    ~LabelRunOccupancy() override;
+
+    void reset(int rows, int width, int minGap) override;
+    bool mark(int minX, int maxX, int minY, int maxY) override;
+    int elements() const override { return m_elements; }
+
+  private:
+    struct LabelRun
+    {
+        LabelRun(int s, int e) : start(s), end(e) {}
+        int start;
+        int end;
+    };
+    typedef QList<LabelRun *> LabelRow;
+
+    QVector<LabelRow *> m_rows;
+    int m_minGap { 0 };
+    int m_elements { 0 };
+};
+
+/**
+ * @class LabelBitmapOccupancy
+ * @short Keeps one bit per pixel column in each row.
+ *
+ * Each row also has a summary bit per 64-column word telling whether the word
+ * holds any mark, so that tests over wide ranges skip empty words 64 at a time.
+ * Overlap tests and marks are done a word at a time. Columns outside the
+ * screen are not tracked.
+ */
+class LabelBitmapOccupancy : public LabelOccupancy
+{
+  public:
+    void reset(int rows, int width, int minGap) override;
+    bool mark(int minX, int maxX, int minY, int maxY) override;
+    int elements() const override;
+
+  private:
+    /** @return true if any bit from first to last is set */
+    static bool anySet(const quint64 *words, int first, int last);
+    /** @return the index of the highest set bit from first to last, or -1 */
+    static int highestSet(const quint64 *words, int first, int last);
+    /** @return the index of the lowest set bit from first to last, or -1 */
+    static int lowestSet(const quint64 *words, int first, int last);
+    static void setRange(quint64 *words, int first, int last);
+
+    bool overlaps(int row, int minX, int maxX) const;
+
+    int m_width { 0 };
+    int m_minGap { 0 };
+    /// Words per row, and summary words per row
+    int m_words { 0 };
+    int m_summaryWords { 0 };
+    QVector<quint64> m_bits;
+    QVector<quint64> m_summary;
+};
@@ -20,6 +20,9 @@
 #include "typedef.h"
 
 #include <QList>
+#include <QPointF>
+#include <QPolygonF>
+#include <QVector>
 
 class SkyPoint;
 class KSNumbers;
@@ -56,6 +59,22 @@ class LineList
     UpdateID updateID;
     UpdateID updateNumID;
 
+    /**
+     * Screen coordinates of the points, kept by SkyQPainter while the
+     * projection key of the painter does not change. A key of zero means
+     * nothing is cached.
+     */
+    struct Projection
+    {
+        quint64 lineKey { 0 };
+        QVector<QPointF> points;
+        QVector<bool> visible;
+
+        quint64 polygonKey { 0 };
+        QPolygonF polygon;
+    };
+    Projection projection;
+
   private:
     SkyList pointList;
 };
@@ -41,6 +41,7 @@
 #endif
 #include "skypainter.h"
 #include "htmesh/MeshIterator.h"
+#include "projections/projector.h"
 
 LineListIndex::LineListIndex(SkyComposite *parent, const QString &name) : SkyComponent(parent), m_name(name)
 {
@@ -188,11 +189,42 @@ SkipHashList *LineListIndex::skipList(LineList *lineList)
     return nullptr;
 }
 
+quint64 LineListIndex::projectionKey()
+{
+#ifdef KSTARS_LITE
+    return 0;
+#else
+    SkyMap *map = SkyMap::Instance();
+
+    if (map == nullptr || map->projector() == nullptr)
+        return 0;
+
+    return projectionKey(map->projector(), KStarsData::Instance());
+#endif
+}
+
+quint64 LineListIndex::projectionKey(const Projector *projector, KStarsData *data)
+{
+    // The sky turns by half a pixel in this many degrees of sidereal time
+    const double halfPixel = 0.5 / projector->viewParams().zoomFactor / dms::DegToRad;
+    const qint64 lstBucket = static_cast<qint64>(std::floor(data->lst()->Degrees() / halfPixel));
+
+    quint64 key = projector->stateKey();
+    key         = (key ^ static_cast<quint64>(lstBucket)) * 1099511628211ULL;
+    key         = (key ^ data->updateNumID()) * 1099511628211ULL;
+    key         = (key ^ qHash(data->geo()->lat()->Degrees())) * 1099511628211ULL;
+    key         = (key ^ qHash(data->geo()->lng()->Degrees())) * 1099511628211ULL;
+
+    return key == 0 ? 1 : key;
+}
+
 void LineListIndex::drawLines(SkyPainter *skyp)
 {
     DrawID drawID     = skyMesh()->drawID();
     UpdateID updateID = KStarsData::Instance()->updateID();
 
+    skyp->setProjectionKey(projectionKey());
+
     for (auto &lineListList : m_lineIndex->values())
     {
         for (int i = 0; i < lineListList->size(); i++)
@@ -209,6 +241,8 @@ void LineListIndex::drawLines(SkyPainter *skyp)
             skyp->drawSkyPolyline(lineList.get(), skipList(lineList.get()), label());
         }
     }
+
+    skyp->setProjectionKey(0);
 }
 
 void LineListIndex::drawFilled(SkyPainter *skyp)
@@ -218,6 +252,8 @@ void LineListIndex::drawFilled(SkyPainter *skyp)
 
     MeshIterator region(skyMesh(), drawBuffer());
 
+    skyp->setProjectionKey(projectionKey());
+
     while (region.hasNext())
     {
         std::shared_ptr<LineListList> lineListList = m_polyIndex->value(region.next());
@@ -240,6 +276,8 @@ void LineListIndex::drawFilled(SkyPainter *skyp)
             skyp->drawSkyPolygon(lineList.get());
         }
     }
+
+    skyp->setProjectionKey(0);
 }
 
 void LineListIndex::intro()
@@ -25,8 +25,10 @@
 #include <memory>
 #include <set>
 
+class KStarsData;
 class LineList;
 class LineListLabel;
+class Projector;
 class SkipHashList;
 class SkyPainter;
 
@@ -82,6 +84,18 @@ class LineListIndex : public SkyComponent
      */
     virtual void JITupdate(LineList *lineList);
 
+    /**
+     * @short Key of the current projection state, for the screen coordinates
+     * cached in the LineLists.
+     * Combines the projector state with the precession update, the location
+     * and the sidereal time, rounded to the time it takes the sky to drift
+     * by half a pixel. Zero when nothing may be cached.
+     */
+    static quint64 projectionKey();
+
+    /** @short Key of the state of @p projector, at the time and location of @p data. */
+    static quint64 projectionKey(const Projector *projector, KStarsData *data);
+
   protected:
     /**
      * @short as the name says, recreates the lineIndex using the LineLists
@@ -0,0 +1,240 @@
+/***************************************************************************
+                          nameindex.cpp  -  K Desktop Planetarium
+                             -------------------
+    begin                : 2026
+    copyright            : (C) 2026 KStars Developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "nameindex.h"
+
+#include "skyobject.h"
+
+#include <algorithm>
+
+namespace
+{
+// The order in which SkyMapComposite::findByName() searches its components:
+// solar system, deep-sky objects and catalogs, constellations, stars,
+// supernovae and satellites.
+const int SearchOrder[] =
+{
+    SkyObject::PLANET, SkyObject::MOON, SkyObject::COMET, SkyObject::ASTEROID,
+    SkyObject::OPEN_CLUSTER, SkyObject::GLOBULAR_CLUSTER, SkyObject::GASEOUS_NEBULA, SkyObject::PLANETARY_NEBULA,
+    SkyObject::SUPERNOVA_REMNANT, SkyObject::GALAXY, SkyObject::ASTERISM, SkyObject::GALAXY_CLUSTER,
+    SkyObject::DARK_NEBULA, SkyObject::QUASAR, SkyObject::MULT_STAR, SkyObject::RADIO_SOURCE,
+    SkyObject::CATALOG_STAR, SkyObject::TYPE_UNKNOWN, SkyObject::CONSTELLATION, SkyObject::STAR,
+    SkyObject::SUPERNOVA, SkyObject::SATELLITE
+};
+
+struct KeyLess
+{
+    template <typename T>
+    bool operator()(const T &item, const QByteArray &key) const
+    {
+        return item.key < key;
+    }
+    template <typename T>
+    bool operator()(const QByteArray &key, const T &item) const
+    {
+        return key < item.key;
+    }
+};
+}
+
+NameIndex::NameIndex(const Lists *lists) : m_Lists(lists)
+{
+    update();
+}
+
+QByteArray NameIndex::key(const QString &name)
+{
+    // UTF-8 keeps the code point order, and prefixes of names are prefixes of their keys
+    return name.simplified().toLower().toUtf8();
+}
+
+void NameIndex::invalidate(int type)
+{
+    QWriteLocker locker(&m_Lock);
+    m_Segments[type].stale = true;
+    m_Generation++;
+}
+
+void NameIndex::invalidateAll()
+{
+    QWriteLocker locker(&m_Lock);
+    for (auto &segment : m_Segments)
+        segment.stale = true;
+    m_Generation++;
+}
+
+quint64 NameIndex::generation() const
+{
+    QReadLocker locker(&m_Lock);
+    return m_Generation;
+}
+
+void NameIndex::update()
+{
+    // Sort outside of the lock, lookups of the other types go on meanwhile
+    QHash<int, QVector<Item>> sorted;
+    {
+        QReadLocker locker(&m_Lock);
+        for (auto list = m_Lists->constBegin(); list != m_Lists->constEnd(); ++list)
+        {
+            const auto segment = m_Segments.constFind(list.key());
+            if (segment == m_Segments.constEnd() || segment->stale)
+                sorted.insert(list.key(), QVector<Item>());
+        }
+        for (auto segment = m_Segments.constBegin(); segment != m_Segments.constEnd(); ++segment)
+        {
+            if (segment->stale && !m_Lists->contains(segment.key()))
+                sorted.insert(segment.key(), QVector<Item>());
+        }
+    }
+
+    if (sorted.isEmpty())
+        return;
+
+    for (auto it = sorted.begin(); it != sorted.end(); ++it)
+    {
+        const auto list = m_Lists->constFind(it.key());
+        if (list == m_Lists->constEnd())
+            continue;
+
+        QVector<Item> &items = it.value();
+        items.reserve(list->size());
+        for (const auto &entry : *list)
+        {
+            if (entry.second != nullptr && !entry.first.isEmpty())
+                items.append({ key(entry.first), entry });
+        }
+
+        // Stable, so that the first object listed under a name is found first
+        std::stable_sort(items.begin(), items.end(), [](const Item & a, const Item & b)
+        {
+            return a.key < b.key;
+        });
+    }
+
+    QWriteLocker locker(&m_Lock);
+    for (auto it = sorted.begin(); it != sorted.end(); ++it)
+    {
+        Segment &segment = m_Segments[it.key()];
+        segment.items.swap(it.value());
+        segment.stale = false;
+    }
+    m_Generation++;
+}
+
+const QVector<NameIndex::Item> &NameIndex::items(int type) const
+{
+    static const QVector<Item> none;
+
+    const auto segment = m_Segments.constFind(type);
+    if (segment == m_Segments.constEnd() || segment->stale)
+        return none;
+
+    return segment->items;
+}
+
+QVector<int> NameIndex::searchOrder(const QVector<int> &types) const
+{
+    if (!types.isEmpty())
+        return types;
+
+    QVector<int> order;
+    for (int type : SearchOrder)
+        order.append(type);
+
+    // Types unknown to findByName() come last
+    QList<int> others = m_Segments.keys();
+    std::sort(others.begin(), others.end());
+    for (int type : others)
+    {
+        if (!order.contains(type))
+            order.append(type);
+    }
+
+    return order;
+}
+
+const SkyObject *NameIndex::find(const QString &name, const QVector<int> &types) const
+{
+    const QByteArray k = key(name);
+    QReadLocker locker(&m_Lock);
+
+    for (int type : searchOrder(types))
+    {
+        const QVector<Item> &sorted = items(type);
+        const auto it = std::lower_bound(sorted.constBegin(), sorted.constEnd(), k, KeyLess());
+        if (it != sorted.constEnd() && it->key == k)
+            return it->entry.second;
+    }
+
+    return nullptr;
+}
+
+QVector<NameIndex::Entry> NameIndex::withPrefix(const QString &prefix, const QVector<int> &types, int limit) const
+{
+    const QByteArray k = key(prefix);
+    QReadLocker locker(&m_Lock);
+
+    QVector<Item> matches;
+    for (int type : searchOrder(types))
+    {
+        const QVector<Item> &sorted = items(type);
+        int count = 0;
+        for (auto it = std::lower_bound(sorted.constBegin(), sorted.constEnd(), k, KeyLess());
+                it != sorted.constEnd() && it->key.startsWith(k) && (limit < 0 || count < limit); ++it, ++count)
+            matches.append(*it);
+    }
+
+    // Merge the types, the search order breaks ties
+    std::stable_sort(matches.begin(), matches.end(), [](const Item & a, const Item & b)
+    {
+        return a.key < b.key;
+    });
+    if (limit >= 0 && matches.size() > limit)
+        matches.resize(limit);
+
+    QVector<Entry> result;
+    result.reserve(matches.size());
+    for (const auto &item : matches)
+        result.append(item.entry);
+
+    return result;
+}
+
+QVector<NameIndex::Entry> NameIndex::entries(const QVector<int> &types) const
+{
+    QVector<Entry> result;
+    QReadLocker locker(&m_Lock);
+
+    for (int type : searchOrder(types))
+    {
+        const QVector<Item> &sorted = items(type);
+        result.reserve(result.size() + sorted.size());
+        for (const auto &item : sorted)
+            result.append(item.entry);
+    }
+
+    return result;
+}
+
+int NameIndex::size() const
+{
+    int count = 0;
+    QReadLocker locker(&m_Lock);
+    for (int type : searchOrder(QVector<int>()))
+        count += items(type).size();
+    return count;
+}
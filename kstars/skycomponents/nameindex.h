@@ -0,0 +1,119 @@
+/***************************************************************************
+                          nameindex.h  -  K Desktop Planetarium
+                             -------------------
+    begin                : 2026
+    copyright            : (C) 2026 KStars Developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QPair>
+#include <QReadWriteLock>
+#include <QString>
+#include <QVector>
+
+class SkyObject;
+
+/**
+ * @class NameIndex
+ * @short Sorted index of the names in the object lists of SkyMapComposite.
+ *
+ * The object lists hold, for each object type, the primary and long names
+ * of the named objects, including catalog designations. The index keeps one
+ * array per type, sorted on normalized UTF-8 keys, which gives exact lookups
+ * and prefix enumeration by binary search.
+ *
+ * The lists stay the reference: the code that modifies a list marks its type
+ * stale, and update() sorts the stale types again. Reloading comets, asteroids
+ * or a custom catalog therefore leaves the other types alone.
+ *
+ * Lookups never read the lists, and may run on any thread. update() reads them,
+ * so it must run on the thread that modifies them. Until then, the names of a
+ * stale type are not found.
+ *
+ * Lookups are case-insensitive and ignore repeated and surrounding whitespace.
+ *
+ * @author KStars Developers
+ */
+class NameIndex
+{
+  public:
+    typedef QPair<QString, const SkyObject *> Entry;
+    typedef QHash<int, QVector<Entry>> Lists;
+
+    /** @short Index the given object lists, which must outlive the index. */
+    explicit NameIndex(const Lists *lists);
+
+    /** @short Sort the names of the stale types, and of the types not indexed yet. */
+    void update();
+
+    /** @return the key a name is indexed with */
+    static QByteArray key(const QString &name);
+
+    /** @short Mark the names of an object type as stale. */
+    void invalidate(int type);
+
+    /** @short Mark all names as stale. */
+    void invalidateAll();
+
+    /**
+     * @return a number that changes whenever names are marked stale, so that
+     * users of the index can tell when their copies are outdated.
+     */
+    quint64 generation() const;
+
+    /**
+     * @return the first object named name, or nullptr.
+     * @param types object types to look into, in this order. All types by default,
+     * in the order SkyMapComposite::findByName() searches its components.
+     */
+    const SkyObject *find(const QString &name, const QVector<int> &types = QVector<int>()) const;
+
+    /**
+     * @return the names that start with prefix, sorted on their keys.
+     * @param types object types to look into, all types by default
+     * @param limit maximum number of names returned, or -1 for all of them
+     */
+    QVector<Entry> withPrefix(const QString &prefix, const QVector<int> &types = QVector<int>(), int limit = -1) const;
+
+    /** @return all the names of the given types, all types by default */
+    QVector<Entry> entries(const QVector<int> &types = QVector<int>()) const;
+
+    /** @return the number of names of all types */
+    int size() const;
+
+  private:
+    struct Item
+    {
+        QByteArray key;
+        Entry entry;
+    };
+
+    struct Segment
+    {
+        QVector<Item> items;
+        bool stale { true };
+    };
+
+    /** @return the sorted names of a type, or no names if stale. The lock must be held. */
+    const QVector<Item> &items(int type) const;
+
+    /** @return types, or all types in search order if empty. The lock must be held. */
+    QVector<int> searchOrder(const QVector<int> &types) const;
+
+    const Lists *m_Lists { nullptr };
+    QHash<int, Segment> m_Segments;
+    quint64 m_Generation { 0 };
+    mutable QReadWriteLock m_Lock;
+};
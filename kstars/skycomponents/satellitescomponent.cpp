@@ -20,6 +20,7 @@
 #include "ksfilereader.h"
 #include "ksnotification.h"
 #include "kstarsdata.h"
+#include "nameindex.h"
 #include "Options.h"
 #include "skylabeler.h"
 #include "skymap.h"
@@ -79,6 +80,8 @@ void SatellitesComponent::loadData()
             }
         }
     }
+
+    nameIndex().invalidate(SkyObject::SATELLITE);
 }
 
 bool SatellitesComponent::selected()
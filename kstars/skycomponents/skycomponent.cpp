@@ -18,6 +18,7 @@
 #include "skycomponent.h"
 
 #include "Options.h"
+#include "nameindex.h"
 #include "skycomposite.h"
 #include "skyobjects/skyobject.h"
 
@@ -73,6 +74,18 @@ QHash<int, QVector<QPair<QString, const SkyObject *>>> &SkyComponent::getObjectL
     return parent()->objectLists();
 }
 
+NameIndex &SkyComponent::getNameIndex()
+{
+    if (!parent())
+    {
+        // Use a fake index if there is no parent object
+        static NameIndex temp(&getObjectLists());
+
+        return temp;
+    }
+    return parent()->nameIndex();
+}
+
 void SkyComponent::removeFromNames(const SkyObject *obj)
 {
     QStringList &names = getObjectNames()[obj->type()];
@@ -97,4 +110,6 @@ void SkyComponent::removeFromLists(const SkyObject *obj)
     i = names.indexOf(QPair<QString, const SkyObject *>(obj->longname(), obj));
     if (i >= 0)
         names.removeAt(i);
+
+    getNameIndex().invalidate(obj->type());
 }
@@ -25,6 +25,7 @@ class QString;
 class SkyObject;
 class SkyPoint;
 class SkyComposite;
+class NameIndex;
 class SkyPainter;
 
 /**
@@ -196,12 +197,20 @@ class SkyComponent
 
     inline QVector<QPair<QString, const SkyObject *>> &objectLists(int type) { return getObjectLists()[type]; }
 
+    /**
+     * @short The index of the names in the object lists.
+     * Code that modifies a list must invalidate its type in the index, which is sorted again by
+     * NameIndex::update(). Use the index rather than the lists when only reading names.
+     */
+    inline NameIndex &nameIndex() { return getNameIndex(); }
+
     void removeFromNames(const SkyObject *obj);
     void removeFromLists(const SkyObject *obj);
 
   private:
     virtual QHash<int, QStringList> &getObjectNames();
     virtual QHash<int, QVector<QPair<QString, const SkyObject *>>> &getObjectLists();
+    virtual NameIndex &getNameIndex();
 
     // Disallow copying and assignment
     SkyComponent(const SkyComponent &);
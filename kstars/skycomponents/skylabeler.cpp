@@ -27,18 +27,6 @@
 #include "skymap.h"
 #include "projections/projector.h"
 
-//---------------------------------------------------------------------------//
-// A Little data container class
-//---------------------------------------------------------------------------//
-
-typedef struct LabelRun
-{
-    LabelRun(int s, int e) : start(s), end(e) {}
-    int start;
-    int end;
-
-} LabelRun;
-
 //----- Now for the main event ----------------------------------------------//
 
 //----- Static Methods ------------------------------------------------------//
@@ -110,14 +98,6 @@ SkyLabeler::SkyLabeler()
 
 SkyLabeler::~SkyLabeler()
 {
-    for (auto &row : screenRows)
-    {
-        for (auto &item : *row)
-        {
-            delete item;
-        }
-        delete row;
-    }
 }
 
 bool SkyLabeler::drawGuideLabel(QPointF &o, const QString &text, double angle)
@@ -287,41 +267,13 @@ void SkyLabeler::reset(SkyMap *skyMap)
     if (maxY < 1)
         maxY = 1; // prevents a crash below?
 
-    int m_maxX = skyMap->width();
-    m_size     = (maxY + 1) * m_maxX;
-
-    // Resize if needed:
-    if (maxY > m_maxY)
-    {
-        screenRows.resize(m_maxY);
-        for (int y = m_maxY; y <= maxY; y++)
-        {
-            screenRows.append(new LabelRow());
-        }
-        //printf("resize: %d -> %d, size:%d\n", m_maxY, maxY, screenRows.size());
-    }
-
-    // Clear all pre-existing rows as needed
-
-    int minMaxY = (maxY < m_maxY) ? maxY : m_maxY;
-
-    for (int y = 0; y <= minMaxY; y++)
-    {
-        LabelRow *row = screenRows[y];
-
-        for (auto &item : *row)
-        {
-            delete item;
-        }
-        row->clear();
-    }
+    m_maxX = skyMap->width();
+    m_size = (maxY + 1) * m_maxX;
 
-    // never decrease m_maxY:
-    if (m_maxY < maxY)
-        m_maxY = maxY;
+    resetOccupancy(maxY);
 
     // reset the counters
-    m_marks = m_hits = m_misses = m_elements = 0;
+    m_marks = m_hits = m_misses = 0;
 
     //----- Clear out labelList -----
     for (auto &item : labelList)
@@ -352,40 +304,13 @@ void SkyLabeler::reset()
     if (maxY < 1)
         maxY = 1; // prevents a crash below?
 
-    int m_maxX = skyMap->width();
-    m_size     = (maxY + 1) * m_maxX;
+    m_maxX = skyMap->width();
+    m_size = (maxY + 1) * m_maxX;
 
-    // Resize if needed:
-    if (maxY > m_maxY)
-    {
-        screenRows.resize(m_maxY);
-        for (int y = m_maxY; y <= maxY; y++)
-        {
-            screenRows.append(new LabelRow());
-        }
-        //printf("resize: %d -> %d, size:%d\n", m_maxY, maxY, screenRows.size());
-    }
-
-    // Clear all pre-existing rows as needed
-
-    int minMaxY = (maxY < m_maxY) ? maxY : m_maxY;
-
-    for (int y = 0; y <= minMaxY; y++)
-    {
-        LabelRow *row = screenRows[y];
-        for (int i = 0; i < row->size(); i++)
-        {
-            delete row->at(i);
-        }
-        row->clear();
-    }
-
-    // never decrease m_maxY:
-    if (m_maxY < maxY)
-        m_maxY = maxY;
+    resetOccupancy(maxY);
 
     // reset the counters
-    m_marks = m_hits = m_misses = m_elements = 0;
+    m_marks = m_hits = m_misses = 0;
 
     //----- Clear out labelList -----
     for (int i = 0; i < labelList.size(); i++)
@@ -410,11 +335,6 @@ void SkyLabeler::draw(QPainter &p)
     //m_p.begin(&m_picture);
 }
 
-// We use Run Length Encoding to hold the information instead of an array of
-// chars.  This is both faster and smaller but the code is more complicated.
-//
-// This code is easy to break and hard to fix.
-
 bool SkyLabeler::markText(const QPointF &p, const QString &text)
 {
     qreal maxX = p.x() + m_fontMetrics.width(text);
@@ -460,118 +380,31 @@ bool SkyLabeler::markRegion(qreal left, qreal right, qreal top, qreal bot)
         minY     = temp;
     }
 
-    // check to see if we overlap any existing label
-    // We must check all rows before we start marking
-    for (int y = minY; y <= maxY; y++)
+    if (!m_occupancy->mark(minX, maxX, minY, maxY))
     {
-        LabelRow *row = screenRows[y];
-        int i;
-        for (i = 0; i < row->size(); i++)
-        {
-            if (row->at(i)->end < minX)
-                continue; // skip past these
-            if (row->at(i)->start > maxX)
-                break;
-            m_misses++;
-            return false;
-        }
+        m_misses++;
+        return false;
     }
 
     m_hits++;
     m_marks += (maxX - minX + 1) * (maxY - minY + 1);
 
-    // Okay, there was no overlap so let's insert the current rectangle into
-    // screenRows.
+    return true;
+}
 
-    for (int y = minY; y <= maxY; y++)
+void SkyLabeler::resetOccupancy(int maxY)
+{
+    if (!m_occupancy || m_runLists != Options::labelRunLists())
     {
-        LabelRow *row = screenRows[y];
-
-        // Simplest case: an empty row
-        if (row->size() < 1)
-        {
-            row->append(new LabelRun(minX, maxX));
-            m_elements++;
-            continue;
-        }
-
-        // Find out our place in the universe (or row).
-        // H'mm.  Maybe we could cache these numbers above.
-        int i;
-        for (i = 0; i < row->size(); i++)
-        {
-            if (row->at(i)->end >= minX)
-                break;
-        }
-
-        // i now points to first label PAST ours
-
-        // if we are first, append or merge at start of list
-        if (i == 0)
-        {
-            if (row->at(0)->start - maxX < m_minDeltaX)
-            {
-                row->at(0)->start = minX;
-            }
-            else
-            {
-                row->insert(0, new LabelRun(minX, maxX));
-                m_elements++;
-            }
-            continue;
-        }
-
-        // if we are past the last label, merge or append at end
-        else if (i == row->size())
-        {
-            if (minX - row->at(i - 1)->end < m_minDeltaX)
-            {
-                row->at(i - 1)->end = maxX;
-            }
-            else
-            {
-                row->append(new LabelRun(minX, maxX));
-                m_elements++;
-            }
-            continue;
-        }
-
-        // if we got here, we must insert or merge the new label
-        //  between [i-1] and [i]
-
-        bool mergeHead = (minX - row->at(i - 1)->end < m_minDeltaX);
-        bool mergeTail = (row->at(i)->start - maxX < m_minDeltaX);
-
-        // double merge => combine all 3 into one
-        if (mergeHead && mergeTail)
-        {
-            row->at(i - 1)->end = row->at(i)->end;
-            delete row->at(i);
-            row->removeAt(i);
-            m_elements--;
-        }
-
-        // Merge label with [i-1]
-        else if (mergeHead)
-        {
-            row->at(i - 1)->end = maxX;
-        }
-
-        // Merge label with [i]
-        else if (mergeTail)
-        {
-            row->at(i)->start = minX;
-        }
-
-        // insert between the two
+        m_runLists = Options::labelRunLists();
+        if (m_runLists)
+            m_occupancy.reset(new LabelRunOccupancy());
         else
-        {
-            row->insert(i, new LabelRun(minX, maxX));
-            m_elements++;
-        }
+            m_occupancy.reset(new LabelBitmapOccupancy());
     }
 
-    return true;
+    m_occupancy->reset(maxY + 1, m_maxX, m_minDeltaX);
+    m_maxY = maxY;
 }
 
 void SkyLabeler::addLabel(SkyObject *obj, SkyLabeler::label_t type)
@@ -687,8 +520,8 @@ void SkyLabeler::printInfo()
     printf("  hits=%d  misses=%d  ratio=%.1f%%\n", m_hits, m_misses, hitRatio());
     printf("  yScale=%.1f maxY=%d\n", m_yScale, m_maxY);
 
-    printf("  screenRows=%d elements=%d virtualSize=%.1f Kbytes\n", screenRows.size(), m_elements,
-           float(m_size) / 1024.0);
+    printf("  screenRows=%d elements=%d virtualSize=%.1f Kbytes\n", m_maxY + 1,
+           m_occupancy ? m_occupancy->elements() : 0, float(m_size) / 1024.0);
 
 //    static const char *labelName[NUM_LABEL_TYPES];
 //
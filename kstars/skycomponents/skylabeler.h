@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "labeloccupancy.h"
 #include "skylabel.h"
 
 #include <QFontMetricsF>
@@ -26,14 +27,12 @@
 #include <QPicture>
 #include <QFont>
 
+#include <memory>
+
 class QString;
 class QPointF;
 class SkyMap;
 class Projector;
-struct LabelRun;
-
-typedef QList<LabelRun *> LabelRow;
-typedef QVector<LabelRow *> ScreenRows;
 
 /**
  *@class SkyLabeler
@@ -332,7 +331,14 @@ class SkyLabeler
     int marks() { return m_marks; }
 
   private:
-    ScreenRows screenRows;
+    /**
+     * @short Clear the marked regions and size the virtual screen.
+     * @param maxY index of the last label row
+     */
+    void resetOccupancy(int maxY);
+
+    std::unique_ptr<LabelOccupancy> m_occupancy;
+    bool m_runLists { false };
     int m_maxX { 0 };
     int m_maxY { 0 };
     int m_size { 0 };
@@ -341,7 +347,6 @@ class SkyLabeler
     int m_marks { 0 };
     int m_hits { 0 };
     int m_misses { 0 };
-    int m_elements { 0 };
     int m_errors { 0 };
     qreal m_yScale { 0 };
     double m_offset { 0 };
@@ -34,6 +34,7 @@
 #include "localmeridiancomponent.h"
 #include "ksasteroid.h"
 #include "kscomet.h"
+#include "ksprofiler.h"
 #ifndef KSTARS_LITE
 #include "kstars.h"
 #endif
@@ -61,9 +62,29 @@
 #endif
 
 #include <QApplication>
+#include <QThread>
 
 #include <kstars_debug.h>
 
+namespace
+{
+// Component calls below are timed per component when profiling is enabled.
+// Each call site registers its counter once, in a static.
+template <typename Component>
+void drawTimed(int counter, const Component &component, SkyPainter *skyp)
+{
+    KSProfiler::ScopedTimer timer(counter);
+    component->draw(skyp);
+}
+
+template <typename Component>
+void updateTimed(int counter, const Component &component, KSNumbers *num)
+{
+    KSProfiler::ScopedTimer timer(counter);
+    component->update(num);
+}
+}
+
 SkyMapComposite::SkyMapComposite(SkyComposite *parent) : SkyComposite(parent), m_reindexNum(J2000)
 {
     m_skyLabeler.reset(SkyLabeler::Instance());
@@ -180,6 +201,9 @@ SkyMapComposite::SkyMapComposite(SkyComposite *parent) : SkyComposite(parent), m
     addComponent(m_Supernovae = new SupernovaeComponent(this), 7);
 #endif
     connect(this, SIGNAL(progressText(QString)), KStarsData::Instance(), SIGNAL(progressText(QString)));
+
+    // The object lists are loaded, index their names
+    m_NameIndex.update();
 }
 
 void SkyMapComposite::update(KSNumbers *num)
@@ -189,9 +213,11 @@ void SkyMapComposite::update(KSNumbers *num)
     //m_MilkyWay->update( data, num );
     //2. Coordinate grid
     //m_EquatorialCoordinateGrid->update( num );
-    m_HorizontalCoordinateGrid->update(num);
+    static const int horizontalCoordinateGridCounter = KSProfiler::counter(QStringLiteral("update/HorizontalCoordinateGrid"));
+    updateTimed(horizontalCoordinateGridCounter, m_HorizontalCoordinateGrid, num);
 #ifndef KSTARS_LITE
-    m_LocalMeridianComponent->update(num);
+    static const int localMeridianCounter = KSProfiler::counter(QStringLiteral("update/LocalMeridian"));
+    updateTimed(localMeridianCounter, m_LocalMeridianComponent, num);
 #endif
     //3. Constellation boundaries
     //m_CBounds->update( data, num );
@@ -199,7 +225,10 @@ void SkyMapComposite::update(KSNumbers *num)
     //m_CLines->update( data, num );
     //5. Constellation names
     if (m_CNames)
-        m_CNames->update(num);
+    {
+        static const int cNamesCounter = KSProfiler::counter(QStringLiteral("update/CNames"));
+        updateTimed(cNamesCounter, m_CNames, num);
+    }
     //6. Equator
     //m_Equator->update( data, num );
     //7. Ecliptic
@@ -207,24 +236,32 @@ void SkyMapComposite::update(KSNumbers *num)
     //8. Deep sky
     //m_DeepSky->update( data, num );
     //9. Custom catalogs
-    m_CustomCatalogs->update(num);
-    m_internetResolvedComponent->update(num);
-    m_manualAdditionsComponent->update(num);
+    static const int customCatalogsCounter = KSProfiler::counter(QStringLiteral("update/CustomCatalogs"));
+    updateTimed(customCatalogsCounter, m_CustomCatalogs, num);
+    static const int internetResolvedCounter = KSProfiler::counter(QStringLiteral("update/InternetResolved"));
+    updateTimed(internetResolvedCounter, m_internetResolvedComponent, num);
+    static const int manualAdditionsCounter = KSProfiler::counter(QStringLiteral("update/ManualAdditions"));
+    updateTimed(manualAdditionsCounter, m_manualAdditionsComponent, num);
     //10. Stars
     //m_Stars->update( data, num );
     //m_CLines->update( data, num );  // MUST follow stars.
 
     //12. Solar system
-    m_SolarSystem->update(num);
+    static const int solarSystemCounter = KSProfiler::counter(QStringLiteral("update/SolarSystem"));
+    updateTimed(solarSystemCounter, m_SolarSystem, num);
     //13. Satellites
-    m_Satellites->update(num);
+    static const int satellitesCounter = KSProfiler::counter(QStringLiteral("update/Satellites"));
+    updateTimed(satellitesCounter, m_Satellites, num);
     //14. Supernovae
-    m_Supernovae->update(num);
+    static const int supernovaeCounter = KSProfiler::counter(QStringLiteral("update/Supernovae"));
+    updateTimed(supernovaeCounter, m_Supernovae, num);
     //15. Horizon
-    m_Horizon->update(num);
+    static const int horizonCounter = KSProfiler::counter(QStringLiteral("update/Horizon"));
+    updateTimed(horizonCounter, m_Horizon, num);
 #ifndef KSTARS_LITE
     //16. Flags
-    m_Flags->update(num);
+    static const int flagsCounter = KSProfiler::counter(QStringLiteral("update/Flags"));
+    updateTimed(flagsCounter, m_Flags, num);
 #endif
 }
 
@@ -249,6 +286,9 @@ void SkyMapComposite::draw(SkyPainter *skyp)
 {
     Q_UNUSED(skyp)
 #ifndef KSTARS_LITE
+    static const int drawCounter = KSProfiler::counter(QStringLiteral("draw/SkyMapComposite"));
+    KSProfiler::ScopedTimer drawTimer(drawCounter);
+
     SkyMap *map      = SkyMap::Instance();
     KStarsData *data = KStarsData::Instance();
 
@@ -311,66 +351,99 @@ void SkyMapComposite::draw(SkyPainter *skyp)
             }
     }
 
-    m_MilkyWay->draw(skyp);
+    static const int milkyWayCounter = KSProfiler::counter(QStringLiteral("draw/MilkyWay"));
+    drawTimed(milkyWayCounter, m_MilkyWay, skyp);
 
     // Draw HIPS after milky way but before everything else
-    m_HiPS->draw(skyp);
+    static const int hipsCounter = KSProfiler::counter(QStringLiteral("draw/HiPS"));
+    drawTimed(hipsCounter, m_HiPS, skyp);
 
-    m_EquatorialCoordinateGrid->draw(skyp);
-    m_HorizontalCoordinateGrid->draw(skyp);
-    m_LocalMeridianComponent->draw(skyp);
+    static const int equatorialCoordinateGridCounter = KSProfiler::counter(QStringLiteral("draw/EquatorialCoordinateGrid"));
+    drawTimed(equatorialCoordinateGridCounter, m_EquatorialCoordinateGrid, skyp);
+    static const int horizontalCoordinateGridCounter = KSProfiler::counter(QStringLiteral("draw/HorizontalCoordinateGrid"));
+    drawTimed(horizontalCoordinateGridCounter, m_HorizontalCoordinateGrid, skyp);
+    static const int localMeridianCounter = KSProfiler::counter(QStringLiteral("draw/LocalMeridian"));
+    drawTimed(localMeridianCounter, m_LocalMeridianComponent, skyp);
 
     //Draw constellation boundary lines only if we draw western constellations
     if (m_Cultures->current() == "Western")
     {
-        m_CBoundLines->draw(skyp);
-        m_ConstellationArt->draw(skyp);
+        static const int cBoundLinesCounter = KSProfiler::counter(QStringLiteral("draw/CBoundLines"));
+        drawTimed(cBoundLinesCounter, m_CBoundLines, skyp);
+        static const int constellationArtCounter = KSProfiler::counter(QStringLiteral("draw/ConstellationArt"));
+        drawTimed(constellationArtCounter, m_ConstellationArt, skyp);
     }
     else if (m_Cultures->current() == "Inuit")
     {
-        m_ConstellationArt->draw(skyp);
+        static const int constellationArtCounter = KSProfiler::counter(QStringLiteral("draw/ConstellationArt"));
+        drawTimed(constellationArtCounter, m_ConstellationArt, skyp);
     }
 
-    m_CLines->draw(skyp);
+    static const int cLinesCounter = KSProfiler::counter(QStringLiteral("draw/CLines"));
+    drawTimed(cLinesCounter, m_CLines, skyp);
 
-    m_Equator->draw(skyp);
+    static const int equatorCounter = KSProfiler::counter(QStringLiteral("draw/Equator"));
+    drawTimed(equatorCounter, m_Equator, skyp);
 
-    m_Ecliptic->draw(skyp);
+    static const int eclipticCounter = KSProfiler::counter(QStringLiteral("draw/Ecliptic"));
+    drawTimed(eclipticCounter, m_Ecliptic, skyp);
 
-    m_DeepSky->draw(skyp);
+    static const int deepSkyCounter = KSProfiler::counter(QStringLiteral("draw/DeepSky"));
+    drawTimed(deepSkyCounter, m_DeepSky, skyp);
 
-    m_CustomCatalogs->draw(skyp);
-    m_internetResolvedComponent->draw(skyp);
-    m_manualAdditionsComponent->draw(skyp);
+    static const int customCatalogsCounter = KSProfiler::counter(QStringLiteral("draw/CustomCatalogs"));
+    drawTimed(customCatalogsCounter, m_CustomCatalogs, skyp);
+    static const int internetResolvedCounter = KSProfiler::counter(QStringLiteral("draw/InternetResolved"));
+    drawTimed(internetResolvedCounter, m_internetResolvedComponent, skyp);
+    static const int manualAdditionsCounter = KSProfiler::counter(QStringLiteral("draw/ManualAdditions"));
+    drawTimed(manualAdditionsCounter, m_manualAdditionsComponent, skyp);
 
-    m_Stars->draw(skyp);
+    static const int starsCounter = KSProfiler::counter(QStringLiteral("draw/Stars"));
+    drawTimed(starsCounter, m_Stars, skyp);
 
-    m_SolarSystem->drawTrails(skyp);
-    m_SolarSystem->draw(skyp);
+    {
+        static const int solarSystemTrailsCounter = KSProfiler::counter(QStringLiteral("draw/SolarSystemTrails"));
+        KSProfiler::ScopedTimer timer(solarSystemTrailsCounter);
+        m_SolarSystem->drawTrails(skyp);
+    }
+    static const int solarSystemCounter = KSProfiler::counter(QStringLiteral("draw/SolarSystem"));
+    drawTimed(solarSystemCounter, m_SolarSystem, skyp);
 
-    m_Satellites->draw(skyp);
+    static const int satellitesCounter = KSProfiler::counter(QStringLiteral("draw/Satellites"));
+    drawTimed(satellitesCounter, m_Satellites, skyp);
 
-    m_Supernovae->draw(skyp);
+    static const int supernovaeCounter = KSProfiler::counter(QStringLiteral("draw/Supernovae"));
+    drawTimed(supernovaeCounter, m_Supernovae, skyp);
+
+    {
+        static const int labelsCounter = KSProfiler::counter(QStringLiteral("draw/Labels"));
+        KSProfiler::ScopedTimer timer(labelsCounter);
 
-    map->drawObjectLabels(labelObjects());
+        map->drawObjectLabels(labelObjects());
 
-    m_skyLabeler->drawQueuedLabels();
-    m_CNames->draw(skyp);
-    m_Stars->drawLabels();
-    m_DeepSky->drawLabels();
+        m_skyLabeler->drawQueuedLabels();
+        m_CNames->draw(skyp);
+        m_Stars->drawLabels();
+        m_DeepSky->drawLabels();
+    }
 
     m_ObservingList->pen = QPen(QColor(data->colorScheme()->colorNamed("ObsListColor")), 1.);
     m_ObservingList->list2 = KStarsData::Instance()->observingList()->sessionList();
-    m_ObservingList->draw(skyp);
+    static const int observingListCounter = KSProfiler::counter(QStringLiteral("draw/ObservingList"));
+    drawTimed(observingListCounter, m_ObservingList, skyp);
 
-    m_Flags->draw(skyp);
+    static const int flagsCounter = KSProfiler::counter(QStringLiteral("draw/Flags"));
+    drawTimed(flagsCounter, m_Flags, skyp);
 
     m_StarHopRouteList->pen = QPen(QColor(data->colorScheme()->colorNamed("StarHopRouteColor")), 1.);
-    m_StarHopRouteList->draw(skyp);
+    static const int starHopRouteListCounter = KSProfiler::counter(QStringLiteral("draw/StarHopRouteList"));
+    drawTimed(starHopRouteListCounter, m_StarHopRouteList, skyp);
 
-    m_ArtificialHorizon->draw(skyp);
+    static const int artificialHorizonCounter = KSProfiler::counter(QStringLiteral("draw/ArtificialHorizon"));
+    drawTimed(artificialHorizonCounter, m_ArtificialHorizon, skyp);
 
-    m_Horizon->draw(skyp);
+    static const int horizonCounter = KSProfiler::counter(QStringLiteral("draw/Horizon"));
+    drawTimed(horizonCounter, m_Horizon, skyp);
 
     m_skyMesh->inDraw(false);
 
@@ -570,6 +643,11 @@ QHash<int, QVector<QPair<QString, const SkyObject *>>> &SkyMapComposite::getObje
     return m_ObjectLists;
 }
 
+NameIndex &SkyMapComposite::getNameIndex()
+{
+    return m_NameIndex;
+}
+
 QList<SkyObject *> SkyMapComposite::findObjectsInArea(const SkyPoint &p1, const SkyPoint &p2)
 {
     const SkyRegion &region = m_skyMesh->skyRegion(p1, p2);
@@ -590,6 +668,14 @@ SkyObject *SkyMapComposite::findByName(const QString &name)
         return nullptr;
 #endif
 
+    // Most names are in the object lists, which are indexed. Only the thread that modifies the
+    // lists may index them again, others do not find the names of modified lists in the index.
+    if (QThread::currentThread() == thread())
+        m_NameIndex.update();
+    if (const SkyObject *indexed = m_NameIndex.find(name))
+        return const_cast<SkyObject *>(indexed);
+
+    //Other names, like alternate and genetive names, are only known to the components.
     //We search the children in an "intelligent" order (most-used
     //object types first), in order to avoid wasting too much time
     //looking for a match.  The most important part of this ordering
@@ -709,6 +795,7 @@ void SkyMapComposite::reloadCNames()
     //     SkyMapDrawAbstract::setDrawLock( false );
     objectNames(SkyObject::CONSTELLATION).clear();
     objectLists(SkyObject::CONSTELLATION).clear();
+    nameIndex().invalidate(SkyObject::CONSTELLATION);
     removeComponent(m_CNames);
     delete m_CNames;
     addComponent(m_CNames = new ConstellationNamesComponent(this, m_Cultures.get()));
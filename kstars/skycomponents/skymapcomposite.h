@@ -19,6 +19,7 @@
 
 #include "culturelist.h"
 #include "ksnumbers.h"
+#include "nameindex.h"
 #include "skycomposite.h"
 #include "skylabeler.h"
 #include "skymesh.h"
@@ -239,6 +240,7 @@ class SkyMapComposite : public QObject, public SkyComposite
   private:
     QHash<int, QStringList> &getObjectNames() override;
     QHash<int, QVector<QPair<QString, const SkyObject *>>> &getObjectLists() override;
+    NameIndex &getNameIndex() override;
 
     std::unique_ptr<CultureList> m_Cultures;
     ConstellationBoundaryLines *m_CBoundLines { nullptr };
@@ -278,6 +280,7 @@ class SkyMapComposite : public QObject, public SkyComposite
     QList<SkyObject *> m_LabeledObjects;
     QHash<int, QStringList> m_ObjectNames;
     QHash<int, QVector<QPair<QString, const SkyObject *>>> m_ObjectLists;
+    NameIndex m_NameIndex { &m_ObjectLists };
     QHash<QString, QString> m_ConstellationNames;
     QString m_internetResolvedCat; // Holds the name of the internet resolved catalog
     QString m_manualAdditionsCat;
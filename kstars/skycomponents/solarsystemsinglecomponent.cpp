@@ -31,6 +31,7 @@
 #include "skymap.h"
 #endif
 
+#include "nameindex.h"
 #include "Options.h"
 #include "skylabeler.h"
 
@@ -52,6 +53,7 @@ SolarSystemSingleComponent::SolarSystemSingleComponent(SolarSystemComposite *par
         objectNames(m_Planet->type()).append(m_Planet->longname());
         objectLists(m_Planet->type()).append(QPair<QString, const SkyObject *>(m_Planet->longname(), m_Planet));
     }
+    nameIndex().invalidate(m_Planet->type());
 }
 
 SolarSystemSingleComponent::~SolarSystemSingleComponent()
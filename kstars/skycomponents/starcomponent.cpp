@@ -25,6 +25,7 @@
 #endif
 #include "kstarsdata.h"
 #include "kstarssplash.h"
+#include "nameindex.h"
 #include "Options.h"
 #include "skylabeler.h"
 #include "skymap.h"
@@ -575,6 +576,7 @@ bool StarComponent::loadStaticData()
     dataReader.closeFile();
     nameReader.closeFile();
 
+    nameIndex().invalidate(SkyObject::STAR);
     starsLoaded = true;
     return true;
 }
@@ -21,6 +21,7 @@
 #include "kstars_debug.h"
 #include "ksnotification.h"
 #include "kstarsdata.h"
+#include "nameindex.h"
 #include "Options.h"
 #include "skylabeler.h"
 #include "skymesh.h"
@@ -65,6 +66,7 @@ void SupernovaeComponent::loadData()
 
     objectNames(SkyObject::SUPERNOVA).clear();
     objectLists(SkyObject::SUPERNOVA).clear();
+    nameIndex().invalidate(SkyObject::SUPERNOVA);
 
     QString name, type, host, date, ra, de;
     float z, mag;
@@ -137,6 +139,8 @@ void SupernovaeComponent::loadData()
         objectLists(SkyObject::SUPERNOVA).append(QPair<QString, const SkyObject *>(name, sup));
     }
 
+    nameIndex().invalidate(SkyObject::SUPERNOVA);
+
     m_DataLoading = false;
     m_DataLoaded = true;
 }
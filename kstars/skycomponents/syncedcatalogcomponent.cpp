@@ -21,6 +21,7 @@
 #include "catalogdata.h"
 #include "deepskyobject.h"
 #include "kstarsdata.h"
+#include "nameindex.h"
 #include "Options.h"
 #include "tools/nameresolver.h"
 
@@ -110,6 +111,7 @@ DeepSkyObject *SyncedCatalogComponent::addObject(CatalogEntryData &catalogEntry)
         objectNames()[newObj->type()].append(newObj->name());
         objectLists()[newObj->type()].append(QPair<QString, const SkyObject *>(newObj->name(), newObj));
     }
+    nameIndex().invalidate(newObj->type());
     m_ObjectList.append(newObj);
     qDebug() << "Added new SkyObject " << newObj->name() << " to synced catalog " << m_catName << " which now contains "
              << m_ObjectList.count() << " objects.";
@@ -150,6 +152,7 @@ bool SyncedCatalogComponent::removeObject(SkyObject &object)
     {
         objectNames()[object.type()].removeAll(name);
         objectLists()[object.type()].removeAll(QPair<QString, const SkyObject *>(name, &object));
+        nameIndex().invalidate(object.type());
     } else {
         qWarning() << "Can't find SkyObject " << name << " in the synced catalog " << m_catName;
         return false;
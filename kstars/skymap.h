@@ -704,6 +704,8 @@ class SkyMap : public QGraphicsView
         // false while rulerMode is true, it means we are measuring angular
         // distance. FIXME: Find a better way to do this
         bool starHopDefineMode { false };
+        // True if the profiling counters are drawn over the map
+        bool profilerOverlay { false };
         double y0;
 
         double m_Scale;
@@ -20,6 +20,7 @@
 // Harris. Essentially, skymapdraw.cpp was renamed and modified.
 // -- asimha (2011)
 
+#include <QFontDatabase>
 #include <QPainter>
 #include <QPixmap>
 
@@ -30,6 +31,7 @@
 #include "kstars.h"
 #include "kstarsdata.h"
 #include "ksnumbers.h"
+#include "ksprofiler.h"
 #include "ksutils.h"
 #include "skyobjects/skyobject.h"
 #include "skyobjects/deepskyobject.h"
@@ -104,6 +106,37 @@ void SkyMapDrawAbstract::drawOverlays(QPainter &p, bool drawFov)
     }
 }
 
+void SkyMapDrawAbstract::drawProfilerOverlay(QPainter &p)
+{
+    if (!m_SkyMap->profilerOverlay)
+        return;
+
+    QStringList lines = KSProfiler::Registry::Instance()->report(20);
+    lines.prepend(i18n("Profiling (Q to close)"));
+
+    p.save();
+
+    const QFont font = QFontDatabase::systemFont(QFontDatabase::FixedFont);
+    const QFontMetrics fm(font);
+    int width = 0;
+    for (const auto &line : lines)
+        width = qMax(width, fm.width(line));
+
+    const int margin = 5;
+    const QRect box(10, p.viewport().height() - 10 - fm.lineSpacing() * lines.size() - 2 * margin,
+                    width + 2 * margin, fm.lineSpacing() * lines.size() + 2 * margin);
+
+    QColor background = m_KStarsData->colorScheme()->colorNamed("BoxBGColor");
+    background.setAlpha(200);
+    p.fillRect(box, background);
+    p.setPen(m_KStarsData->colorScheme()->colorNamed("BoxTextColor"));
+    p.setFont(font);
+    for (int i = 0; i < lines.size(); ++i)
+        p.drawText(box.left() + margin, box.top() + margin + fm.ascent() + i * fm.lineSpacing(), lines[i]);
+
+    p.restore();
+}
+
 void SkyMapDrawAbstract::drawAngleRuler(QPainter &p)
 {
     //FIXME use sky painter.
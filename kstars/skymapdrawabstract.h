@@ -91,6 +91,12 @@ class SkyMapDrawAbstract
         	*/
     void drawAngleRuler(QPainter &psky);
 
+    /**Draw the busiest profiling counters in a corner of the map, when the
+        	*profiler overlay is toggled on. It is only drawn on screen, never exported.
+        	*@param psky reference to the QPainter on which to draw.
+        	*/
+    void drawProfilerOverlay(QPainter &psky);
+
     /** @short Draw the current Sky map to a pixmap which is to be printed or exported to a file.
         	*
         	*@param pd pointer to the QPaintDevice on which to draw.
@@ -21,6 +21,7 @@
 
 #include "ksplanetbase.h"
 #include "kspopupmenu.h"
+#include "ksprofiler.h"
 #include "kstars.h"
 #include "observinglist.h"
 #include "Options.h"
@@ -361,6 +362,23 @@ void SkyMap::keyPressEvent(QKeyEvent *e)
             forceUpdate();
             break;
 
+        case Qt::Key_Q:
+        {
+            // Toggle the profiling overlay
+            KSProfiler::Registry *registry = KSProfiler::Registry::Instance();
+            profilerOverlay                = !profilerOverlay;
+            registry->setEnabled(profilerOverlay);
+            if (profilerOverlay)
+                connect(registry, &KSProfiler::Registry::updated, m_SkyMapDraw, [this]()
+                {
+                    m_SkyMapDraw->update();
+                });
+            else
+                disconnect(registry, &KSProfiler::Registry::updated, m_SkyMapDraw, nullptr);
+            m_SkyMapDraw->update();
+            break;
+        }
+
         case Qt::Key_K:
         {
             if (m_fovCaptureMode)
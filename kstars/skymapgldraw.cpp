@@ -70,6 +70,7 @@ void SkyMapGLDraw::paintEvent(QPaintEvent *event)
 
     p.endNativePainting();
     drawOverlays(p);
+    drawProfilerOverlay(p);
     p.end();
 
     setDrawLock(false);
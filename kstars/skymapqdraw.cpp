@@ -60,6 +60,7 @@ void SkyMapQDraw::paintEvent(QPaintEvent *event)
         p.drawLine(0, 0, 1, 1); // Dummy operation to circumvent bug. TODO: Add details
         p.drawPixmap(0, 0, *m_SkyPixmap);
         drawOverlays(p);
+        drawProfilerOverlay(p);
         p.end();
 
         setDrawLock(false);
@@ -93,6 +94,7 @@ void SkyMapQDraw::paintEvent(QPaintEvent *event)
     psky2.drawLine(0, 0, 1, 1); // Dummy op.
     psky2.drawPixmap(0, 0, *m_SkyPixmap);
     drawOverlays(psky2);
+    drawProfilerOverlay(psky2);
     psky2.end();
 
     if (m_SkyMap->m_previewLegend)
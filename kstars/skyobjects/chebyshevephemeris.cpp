@@ -0,0 +1,361 @@
+/***************************************************************************
+                 chebyshevephemeris.cpp  -  K Desktop Planetarium
+                             -------------------
+    begin                : 2026
+    copyright            : (C) 2026 KStars Developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "chebyshevephemeris.h"
+
+#include "kspaths.h"
+#include "Options.h"
+
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QtConcurrent>
+
+#include <cmath>
+
+#include <kstars_debug.h>
+
+namespace
+{
+// "KSCE", followed by the format version
+const quint32 FileMagic   = 0x4B534345;
+const quint16 FileVersion = 2;
+
+struct BodyParameters
+{
+    const char *name;
+    double span;
+    int degree;
+};
+
+// Segment lengths and degrees follow those of the JPL DE ephemerides, with a
+// little margin since the fits are checked against the series anyway.
+const BodyParameters bodyParameters[] =
+{
+    { "Moon", 4, 12 },     { "Mercury", 8, 13 }, { "Venus", 16, 10 },
+    { "Earth", 16, 12 },   { "Mars", 16, 11 },   { "Jupiter", 32, 9 },
+    { "Saturn", 32, 9 },   { "Uranus", 64, 9 },  { "Neptune", 64, 9 }
+};
+}
+
+ChebyshevEphemeris *ChebyshevEphemeris::Instance()
+{
+    static ChebyshevEphemeris instance;
+    return &instance;
+}
+
+ChebyshevEphemeris::ChebyshevEphemeris()
+{
+    m_Directory = QDir(KSPaths::writableLocation(QStandardPaths::GenericDataLocation)).filePath("ephemeris");
+}
+
+void ChebyshevEphemeris::setStorageDirectory(const QString &directory)
+{
+    QMutexLocker locker(&m_Mutex);
+    m_Directory = directory;
+    m_Bodies.clear();
+    m_Generation++;
+}
+
+void ChebyshevEphemeris::clear()
+{
+    QMutexLocker locker(&m_Mutex);
+    m_Bodies.clear();
+    m_Generation++;
+}
+
+void ChebyshevEphemeris::waitForFits()
+{
+    m_Pool.waitForDone();
+}
+
+double ChebyshevEphemeris::maxFitError() const
+{
+    QMutexLocker locker(&m_Mutex);
+    return m_MaxFitError;
+}
+
+bool ChebyshevEphemeris::position(const QString &name, double jd, const SeriesSource &source, EclipticPosition &ret)
+{
+    if (!Options::useEphemerisCache() || jd < MinJD || jd >= MaxJD)
+        return false;
+
+    QMutexLocker locker(&m_Mutex);
+
+    Body *b = body(name);
+    if (b == nullptr)
+        return false;
+    if (!b->loaded)
+    {
+        b->series = source();
+        load(name, *b);
+    }
+
+    const int index = static_cast<int>(floor((jd - MinJD) / (b->span * SegmentsPerBlock)));
+
+    // The neighbours are fitted ahead, so that a clock running either way finds them ready
+    request(name, *b, index);
+    request(name, *b, index + 1);
+    request(name, *b, index - 1);
+
+    auto it = b->blocks.constFind(index);
+    if (it == b->blocks.constEnd() || !it->valid)
+        return false;
+
+    double xyz[3];
+    evaluate(*b, *it, index, jd, xyz);
+    locker.unlock();
+
+    fromRectangular(xyz, ret);
+    return true;
+}
+
+void ChebyshevEphemeris::request(const QString &name, Body &b, int index)
+{
+    const int lastIndex = static_cast<int>(floor((MaxJD - MinJD) / (b.span * SegmentsPerBlock)));
+    if (index < 0 || index > lastIndex || !b.series.evaluate || b.blocks.contains(index) || b.pending.contains(index))
+        return;
+
+    b.pending.insert(index);
+
+    Body parameters;
+    parameters.span   = b.span;
+    parameters.degree = b.degree;
+    const SeriesFunction series = b.series.evaluate;
+    const quint32 generation    = m_Generation;
+
+    QtConcurrent::run(&m_Pool, [this, name, parameters, index, series, generation]()
+    {
+        const Block block = fitBlock(parameters, index, series);
+
+        QMutexLocker locker(&m_Mutex);
+        // The blocks in memory were discarded meanwhile
+        if (generation != m_Generation)
+            return;
+
+        Body *b = body(name);
+        b->pending.remove(index);
+        if (!b->blocks.contains(index))
+        {
+            b->blocks.insert(index, block);
+            store(name, *b, index, block);
+        }
+    });
+}
+
+ChebyshevEphemeris::Body *ChebyshevEphemeris::body(const QString &name)
+{
+    auto it = m_Bodies.find(name);
+    if (it == m_Bodies.end())
+    {
+        Body b;
+        for (const auto &p : bodyParameters)
+        {
+            if (name == QLatin1String(p.name))
+            {
+                b.span   = p.span;
+                b.degree = p.degree;
+                break;
+            }
+        }
+        // Unsupported bodies are kept too, with a null span, so they are only looked up once
+        it = m_Bodies.insert(name, b);
+    }
+
+    return it->span > 0 ? &it.value() : nullptr;
+}
+
+ChebyshevEphemeris::Block ChebyshevEphemeris::fitBlock(const Body &b, int index, const SeriesFunction &series)
+{
+    const int n = b.degree + 1;
+    Block block;
+    block.coefficients.resize(SegmentsPerBlock * 3 * n);
+    block.valid = true;
+
+    QVector<double> values(3 * n);
+    double maxError = 0;
+    EclipticPosition p;
+
+    for (int segment = 0; segment < SegmentsPerBlock; ++segment)
+    {
+        const double start = MinJD + (static_cast<double>(index) * SegmentsPerBlock + segment) * b.span;
+
+        // Sample the series at the Chebyshev nodes of the segment
+        for (int k = 0; k < n; ++k)
+        {
+            const double x = cos(dms::PI * (k + 0.5) / n);
+            series(start + 0.5 * (x + 1) * b.span, p);
+            toRectangular(p, &values[3 * k]);
+        }
+
+        double *c = block.coefficients.data() + segment * 3 * n;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            for (int j = 0; j < n; ++j)
+            {
+                double sum = 0;
+                for (int k = 0; k < n; ++k)
+                    sum += values[3 * k + axis] * cos(dms::PI * j * (k + 0.5) / n);
+                c[axis * n + j] = (j == 0 ? 1.0 : 2.0) * sum / n;
+            }
+        }
+
+        // Check the fit halfway between the nodes, where the error peaks
+        for (int k = 1; k < n; ++k)
+        {
+            const double x  = cos(dms::PI * k / n);
+            const double jd = start + 0.5 * (x + 1) * b.span;
+            double expected[3], fitted[3];
+
+            series(jd, p);
+            toRectangular(p, expected);
+            evaluate(b, block, index, jd, fitted);
+
+            const double dx = fitted[0] - expected[0], dy = fitted[1] - expected[1], dz = fitted[2] - expected[2];
+            const double r  = sqrt(expected[0] * expected[0] + expected[1] * expected[1] + expected[2] * expected[2]);
+            maxError        = std::max(maxError, sqrt(dx * dx + dy * dy + dz * dz) / r);
+        }
+    }
+
+    if (maxError > Tolerance)
+    {
+        qCWarning(KSTARS) << "Chebyshev fit of block" << index << "is off by" << maxError * 206264.806
+                          << "arcsec, using the series instead";
+        block.valid = false;
+        block.coefficients.clear();
+    }
+
+    QMutexLocker locker(&m_Mutex);
+    m_MaxFitError = std::max(m_MaxFitError, maxError);
+
+    return block;
+}
+
+void ChebyshevEphemeris::evaluate(const Body &b, const Block &block, int index, double jd, double xyz[3]) const
+{
+    const int n        = b.degree + 1;
+    const double local = (jd - MinJD) / b.span - static_cast<double>(index) * SegmentsPerBlock;
+    const int segment  = std::min(std::max(static_cast<int>(floor(local)), 0), SegmentsPerBlock - 1);
+    const double x     = 2 * (local - segment) - 1;
+
+    const double *c = block.coefficients.constData() + segment * 3 * n;
+    for (int axis = 0; axis < 3; ++axis, c += n)
+    {
+        // Clenshaw recurrence
+        double b1 = 0, b2 = 0;
+        for (int j = n - 1; j >= 1; --j)
+        {
+            const double b0 = 2 * x * b1 - b2 + c[j];
+            b2              = b1;
+            b1              = b0;
+        }
+        xyz[axis] = x * b1 - b2 + c[0];
+    }
+}
+
+QString ChebyshevEphemeris::fileName(const QString &name) const
+{
+    return QDir(m_Directory).filePath(name.toLower() + ".cheb");
+}
+
+void ChebyshevEphemeris::load(const QString &name, Body &b)
+{
+    b.loaded = true;
+    if (m_Directory.isEmpty() || !b.series.evaluate)
+        return;
+
+    QFile file(fileName(name));
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic;
+    quint16 version;
+    double span;
+    qint32 degree;
+    QByteArray checksum;
+    in >> magic >> version >> span >> degree;
+    if (in.status() == QDataStream::Ok && magic == FileMagic && version == FileVersion)
+        in >> checksum;
+
+    if (in.status() != QDataStream::Ok || magic != FileMagic || version != FileVersion || span != b.span ||
+            degree != b.degree || checksum != b.series.checksum)
+    {
+        // Written with other parameters or other series data, start over
+        file.close();
+        file.remove();
+        return;
+    }
+
+    const int expected = SegmentsPerBlock * 3 * (b.degree + 1);
+    while (!in.atEnd())
+    {
+        qint32 index;
+        Block block;
+        in >> index >> block.valid >> block.coefficients;
+
+        // A truncated record is simply computed again
+        if (in.status() != QDataStream::Ok || (block.valid && block.coefficients.size() != expected))
+            break;
+
+        b.blocks.insert(index, block);
+    }
+}
+
+void ChebyshevEphemeris::store(const QString &name, const Body &b, int index, const Block &block)
+{
+    if (m_Directory.isEmpty() || !QDir().mkpath(m_Directory))
+        return;
+
+    QFile file(fileName(name));
+    const bool fresh = !file.exists() || file.size() == 0;
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append))
+    {
+        qCWarning(KSTARS) << "Cannot write ephemeris cache" << file.fileName();
+        return;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_0);
+
+    if (fresh)
+        out << FileMagic << FileVersion << b.span << static_cast<qint32>(b.degree) << b.series.checksum;
+
+    out << static_cast<qint32>(index) << block.valid << block.coefficients;
+}
+
+void ChebyshevEphemeris::toRectangular(const EclipticPosition &p, double xyz[3])
+{
+    double sinL, cosL, sinB, cosB;
+    p.longitude.SinCos(sinL, cosL);
+    p.latitude.SinCos(sinB, cosB);
+
+    xyz[0] = p.radius * cosB * cosL;
+    xyz[1] = p.radius * cosB * sinL;
+    xyz[2] = p.radius * sinB;
+}
+
+void ChebyshevEphemeris::fromRectangular(const double xyz[3], EclipticPosition &p)
+{
+    const double rho = sqrt(xyz[0] * xyz[0] + xyz[1] * xyz[1]);
+
+    p.longitude.setRadians(atan2(xyz[1], xyz[0]));
+    p.longitude.setD(p.longitude.reduce().Degrees());
+    p.latitude.setRadians(atan2(xyz[2], rho));
+    p.radius = sqrt(rho * rho + xyz[2] * xyz[2]);
+}
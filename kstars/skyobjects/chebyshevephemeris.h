@@ -0,0 +1,167 @@
+/***************************************************************************
+                 chebyshevephemeris.h  -  K Desktop Planetarium
+                             -------------------
+    begin                : 2026
+    copyright            : (C) 2026 KStars Developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include "ksplanetbase.h"
+
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QSet>
+#include <QString>
+#include <QThreadPool>
+#include <QVector>
+
+#include <functional>
+
+/**
+ * @class ChebyshevEphemeris
+ * @short Cache of Chebyshev polynomial fits of the planetary and lunar series.
+ *
+ * Evaluating the VSOP87 series of a planet, or the lunar theory, is the most
+ * expensive part of KSPlanetBase::findPosition(). Tools that sample positions
+ * over long time ranges spend most of their time there. This cache replaces
+ * the series with piecewise Chebyshev polynomials, in the way of the JPL
+ * ephemerides.
+ *
+ * The rectangular coordinates of each body are fitted over short segments.
+ * Segments are generated by blocks, on a worker thread, the first time a date
+ * within the block or one of its neighbours is requested. Until a block is
+ * ready the callers sum the series themselves, so a request never waits for a
+ * fit. Each fit is checked against the series between the fit nodes, and a
+ * block that does not meet the accuracy target is never used.
+ * Blocks are appended to a small binary file per body, so they are only
+ * computed once. The file records a checksum of the series data, and it is
+ * discarded when the data changes.
+ *
+ * Only the series are replaced: light time, aberration, nutation and the
+ * topocentric correction are still computed exactly by the callers.
+ *
+ * The cache may be used from several threads.
+ *
+ * @author KStars Developers
+ */
+class ChebyshevEphemeris
+{
+  public:
+    /**
+     * Evaluates the series of a body.
+     * @param jd Julian Day
+     * @param ret ecliptic position of the body at jd
+     */
+    typedef std::function<void(double jd, EclipticPosition &ret)> SeriesFunction;
+
+    /** The series of a body */
+    struct Series
+    {
+        /// Evaluator of the series. It runs on a worker thread, so it must own the data it sums.
+        SeriesFunction evaluate;
+        /// Digest of the data summed by evaluate
+        QByteArray checksum;
+    };
+
+    /** Supplies the series of a body, called on the calling thread the first time the body is used */
+    typedef std::function<Series()> SeriesSource;
+
+    /** @return the cache instance */
+    static ChebyshevEphemeris *Instance();
+
+    /**
+     * @short Interpolate the position of a body.
+     * @param body untranslated name of the body, as used for its orbital data
+     * @param jd Julian Day
+     * @param source supplier of the series, used to fit the blocks of the body
+     * @param ret interpolated ecliptic position, longitude reduced to [0, 360)
+     * @return false if the cache is disabled, jd is out of range, the body is not supported,
+     * the block containing jd is still being fitted or the fit was not accurate enough.
+     * The caller must then evaluate the series itself.
+     */
+    bool position(const QString &body, double jd, const SeriesSource &source, EclipticPosition &ret);
+
+    /** @short Wait until the blocks being fitted are ready. */
+    void waitForFits();
+
+    /**
+     * @short Set the directory where fitted blocks are stored.
+     * An empty directory keeps the cache in memory only. Blocks already in
+     * memory are discarded.
+     */
+    void setStorageDirectory(const QString &directory);
+
+    /** @short Discard the blocks held in memory. Stored blocks are kept. */
+    void clear();
+
+    /** @return the largest error in radians found so far when checking a fit against the series */
+    double maxFitError() const;
+
+    /** First and last Julian Days covered by the cache, 1800-01-01 and 2200-01-01 */
+    static constexpr double MinJD { 2378496.5 };
+    static constexpr double MaxJD { 2524593.5 };
+
+    /** Accuracy target of the fits, in radians (0.05 arcsecond) */
+    static constexpr double Tolerance { 2.4e-7 };
+
+  private:
+    ChebyshevEphemeris();
+
+    /** A block of consecutive segments */
+    struct Block
+    {
+        bool valid { false };
+        /// Per segment, per coordinate, degree + 1 coefficients
+        QVector<double> coefficients;
+    };
+
+    struct Body
+    {
+        /// Length of a segment in days
+        double span { 0 };
+        int degree { 0 };
+        bool loaded { false };
+        Series series;
+        QHash<int, Block> blocks;
+        /// Blocks being fitted
+        QSet<int> pending;
+    };
+
+    /** @return the fitting parameters of a body, or nullptr if it is not supported */
+    Body *body(const QString &name);
+
+    /** Fit a block on the worker pool, unless it is out of range, ready or pending. Called with m_Mutex held. */
+    void request(const QString &name, Body &b, int index);
+
+    Block fitBlock(const Body &b, int index, const SeriesFunction &series);
+    void evaluate(const Body &b, const Block &block, int index, double jd, double xyz[3]) const;
+
+    QString fileName(const QString &name) const;
+    void load(const QString &name, Body &b);
+    void store(const QString &name, const Body &b, int index, const Block &block);
+
+    static void toRectangular(const EclipticPosition &p, double xyz[3]);
+    static void fromRectangular(const double xyz[3], EclipticPosition &p);
+
+    static constexpr int SegmentsPerBlock { 32 };
+
+    mutable QMutex m_Mutex;
+    QHash<QString, Body> m_Bodies;
+    QString m_Directory;
+    double m_MaxFitError { 0 };
+    /// Incremented when the blocks in memory are discarded, so that pending fits are dropped
+    quint32 m_Generation { 0 };
+    /// Destroyed first, which waits for the pending fits
+    QThreadPool m_Pool;
+};
@@ -17,6 +17,7 @@
 
 #include "ksmoon.h"
 
+#include "chebyshevephemeris.h"
 #include "ksnumbers.h"
 #include "ksutils.h"
 #include "kssun.h"
@@ -28,6 +29,7 @@
 #include "skycomponents/solarsystemcomposite.h"
 #include "texturemanager.h"
 
+#include <QCryptographicHash>
 #include <QFile>
 #include <QTextStream>
 
@@ -158,18 +160,20 @@ bool KSMoon::loadData()
     return true;
 }
 
-bool KSMoon::findGeocentricPosition(const KSNumbers *num, const KSPlanetBase *)
+void KSMoon::calcEclipticSeries(double T, EclipticPosition &ret) const
+{
+    sumSeries(LRData, BData, T, ret);
+}
+
+void KSMoon::sumSeries(const QList<MoonLRData> &LRTerms, const QList<MoonBData> &BTerms, double T, EclipticPosition &ret)
 {
     //Algorithms in this subroutine are taken from Chapter 45 of "Astronomical Algorithms"
     //by Jean Meeus (1991, Willmann-Bell, Inc. ISBN 0-943396-35-2.  https://www.willbell.com/math/mc1.htm)
     //updated to Jean Messus (1998, Willmann-Bell, http://www.naughter.com/aa.html )
 
-    double T, L, D, M, M1, F, A1, A2, A3;
+    double L, D, M, M1, F, A1, A2, A3;
     double sumL, sumR, sumB;
 
-    //Julian centuries since J2000
-    T = num->julianCenturies();
-
     double Et = 1.0 - 0.002516 * T - 0.0000074 * T * T;
 
     //Moon's mean longitude
@@ -196,10 +200,7 @@ bool KSMoon::findGeocentricPosition(const KSNumbers *num, const KSPlanetBase *)
     sumL = 0.0;
     sumR = 0.0;
 
-    if (!loadData())
-        return false;
-
-    for (const auto &mlrd : LRData)
+    for (const auto &mlrd : LRTerms)
     {
         double E = 1.0;
 
@@ -214,7 +215,7 @@ bool KSMoon::findGeocentricPosition(const KSNumbers *num, const KSPlanetBase *)
     }
 
     sumB = 0.0;
-    for (const auto &mbd : BData)
+    for (const auto &mbd : BTerms)
     {
         double E = 1.0;
 
@@ -233,9 +234,51 @@ bool KSMoon::findGeocentricPosition(const KSNumbers *num, const KSPlanetBase *)
              115.0 * sin(L + M1));
 
     //Geocentric coordinates
-    setEcLong(dms(sumL / 1000000.0 + L * 180.0 / dms::PI)); //convert radians to degrees
-    setEcLat(dms(sumB / 1000000.0));
-    Rearth = (385000.56 + sumR / 1000.0) / AU_KM; //distance from Earth, in AU
+    ret.longitude = dms(sumL / 1000000.0 + L * 180.0 / dms::PI); //convert radians to degrees
+    ret.longitude.setD(ret.longitude.reduce().Degrees());
+    ret.latitude  = dms(sumB / 1000000.0);
+    ret.radius    = 385000.56 + sumR / 1000.0; //distance from Earth, in km
+}
+
+bool KSMoon::findGeocentricPosition(const KSNumbers *num, const KSPlanetBase *)
+{
+    if (!loadData())
+        return false;
+
+    // The cache fits the series on a worker thread, with its own copy of the terms
+    auto source = []()
+    {
+        ChebyshevEphemeris::Series series;
+        QCryptographicHash checksum(QCryptographicHash::Sha1);
+        for (const auto &mlrd : LRData)
+        {
+            for (int n : { mlrd.nd, mlrd.nm, mlrd.nm1, mlrd.nf })
+                checksum.addData(reinterpret_cast<const char *>(&n), sizeof(int));
+            checksum.addData(reinterpret_cast<const char *>(&mlrd.Li), sizeof(double));
+            checksum.addData(reinterpret_cast<const char *>(&mlrd.Ri), sizeof(double));
+        }
+        for (const auto &mbd : BData)
+        {
+            for (int n : { mbd.nd, mbd.nm, mbd.nm1, mbd.nf })
+                checksum.addData(reinterpret_cast<const char *>(&n), sizeof(int));
+            checksum.addData(reinterpret_cast<const char *>(&mbd.Bi), sizeof(double));
+        }
+        series.checksum = checksum.result();
+        series.evaluate = [LR = LRData, B = BData](double jd, EclipticPosition & ret)
+        {
+            sumSeries(LR, B, (jd - J2000) / 36525.0, ret);
+        };
+        return series;
+    };
+
+    EclipticPosition pos;
+    if (!ChebyshevEphemeris::Instance()->position(QStringLiteral("Moon"), num->julianDay(), source, pos))
+        calcEclipticSeries(num->julianCenturies(), pos);
+
+    //Geocentric coordinates
+    setEcLong(pos.longitude);
+    setEcLat(pos.latitude);
+    Rearth = pos.radius / AU_KM; //distance from Earth, in AU
 
     EclipticToEquatorial(num->obliquity());
 
@@ -83,6 +83,14 @@ class KSMoon : public KSPlanetBase
      */
     bool findGeocentricPosition(const KSNumbers *num, const KSPlanetBase *) override;
 
+    /**
+     * Sums the series of the lunar theory. findGeocentricPosition() interpolates
+     * them from ChebyshevEphemeris instead when it covers the date.
+     * @param T Julian centuries since J2000
+     * @param ret geocentric ecliptic coordinates, the radius is the distance in km
+     */
+    void calcEclipticSeries(double T, EclipticPosition &ret) const;
+
     /**
      * @brief updateMag calls findMagnitude() to calculate current magnitude of moon
      * according to current phase. This function is required to perform findMagnitude()
@@ -131,6 +139,11 @@ class KSMoon : public KSPlanetBase
     };
 
     static QList<MoonBData> BData;
+
+    /** Sums the series of the given terms, see calcEclipticSeries() */
+    static void sumSeries(const QList<MoonLRData> &LRTerms, const QList<MoonBData> &BTerms, double T,
+                          EclipticPosition &ret);
+
     unsigned int iPhase { 0 };
     KSSun *defaultSun=nullptr;
 };
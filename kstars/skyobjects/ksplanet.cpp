@@ -17,10 +17,14 @@
 
 #include "ksplanet.h"
 
+#include "chebyshevephemeris.h"
 #include "ksnumbers.h"
+#include "kstarsdatetime.h"
 #include "ksutils.h"
 #include "ksfilereader.h"
 
+#include <QCryptographicHash>
+
 #include <cmath>
 #include <typeinfo>
 
@@ -199,15 +203,42 @@ bool KSPlanet::loadData()
 
 void KSPlanet::calcEcliptic(double Tau, EclipticPosition &epret) const
 {
-    double sum[6];
-    OrbitDataColl odc;
-    double Tpow[6];
-
-    Tpow[0] = 1.0;
-    for (int i = 1; i < 6; ++i)
+    // The cache fits the series on a worker thread, with its own reference to the orbital data
+    auto source = [this]()
     {
-        Tpow[i] = Tpow[i - 1] * Tau;
-    }
+        ChebyshevEphemeris::Series series;
+        OrbitDataColl odc;
+        if (!odm.loadData(odc, untranslatedName()))
+            return series;
+
+        QCryptographicHash checksum(QCryptographicHash::Sha1);
+        for (const OBArray *terms : { &odc.Lon, &odc.Lat, &odc.Dst })
+        {
+            for (int i = 0; i < 6; ++i)
+            {
+                for (const OrbitData &term : (*terms)[i])
+                {
+                    checksum.addData(reinterpret_cast<const char *>(&term.A), sizeof(double));
+                    checksum.addData(reinterpret_cast<const char *>(&term.B), sizeof(double));
+                    checksum.addData(reinterpret_cast<const char *>(&term.C), sizeof(double));
+                }
+            }
+        }
+        series.checksum = checksum.result();
+        series.evaluate = [odc](double jd, EclipticPosition & ret)
+        {
+            sumSeries(odc, (jd - J2000) / 365250.0, ret);
+        };
+        return series;
+    };
+
+    if (!ChebyshevEphemeris::Instance()->position(untranslatedName(), J2000 + Tau * 365250.0, source, epret))
+        calcEclipticSeries(Tau, epret);
+}
+
+void KSPlanet::calcEclipticSeries(double Tau, EclipticPosition &epret) const
+{
+    OrbitDataColl odc;
 
     if (!odm.loadData(odc, untranslatedName()))
     {
@@ -218,6 +249,20 @@ void KSPlanet::calcEcliptic(double Tau, EclipticPosition &epret) const
         return;
     }
 
+    sumSeries(odc, Tau, epret);
+}
+
+void KSPlanet::sumSeries(const OrbitDataColl &odc, double Tau, EclipticPosition &epret)
+{
+    double sum[6];
+    double Tpow[6];
+
+    Tpow[0] = 1.0;
+    for (int i = 1; i < 6; ++i)
+    {
+        Tpow[i] = Tpow[i - 1] * Tau;
+    }
+
     //Ecliptic Longitude
     for (int i = 0; i < 6; ++i)
     {
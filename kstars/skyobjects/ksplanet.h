@@ -81,9 +81,17 @@ class KSPlanet : public KSPlanetBase
      * to the ecliptic coordinates is returned as the second object.
      * @param jm Julian Millenia (=jd/1000)
      * @param ret The ecliptic coordinates are returned by reference through this argument.
+     * @note The positions are interpolated from ChebyshevEphemeris when it covers the date.
      */
     virtual void calcEcliptic(double jm, EclipticPosition &ret) const;
 
+    /**
+     * Same as calcEcliptic(), but always sums the VSOP87 series.
+     * @param jm Julian Millenia (=jd/1000)
+     * @param ret The ecliptic coordinates are returned by reference through this argument.
+     */
+    void calcEclipticSeries(double jm, EclipticPosition &ret) const;
+
   protected:
     /**
      * Calculate the geocentric RA, Dec coordinates of the Planet.
@@ -180,6 +188,9 @@ class KSPlanet : public KSPlanetBase
   private:
     void findMagnitude(const KSNumbers *) override;
 
+    /** Sums the VSOP87 series of the given orbital data, see calcEclipticSeries() */
+    static void sumSeries(const OrbitDataColl &odc, double jm, EclipticPosition &ret);
+
   protected:
     bool data_loaded { false };
     static OrbitDataManager odm;
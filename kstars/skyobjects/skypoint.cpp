@@ -23,6 +23,7 @@
 #include "ksnumbers.h"
 #include "kstarsdatetime.h"
 #include "kssun.h"
+#include "ksprofiler.h"
 #include "kstarsdata.h"
 #include "Options.h"
 #include "skyobject.h"
@@ -39,12 +40,6 @@
 #ifdef HAVE_LIBNOVA
 #include <libnova/libnova.h>
 #endif
-#ifdef PROFILE_COORDINATE_CONVERSION
-#include <ctime> // For profiling, remove if not profiling.
-long unsigned SkyPoint::eqToHzCalls = 0;
-double SkyPoint::cpuTime_EqToHz     = 0.;
-#endif
-
 KSSun *SkyPoint::m_Sun         = nullptr;
 const double SkyPoint::altCrit = -1.0;
 
@@ -74,9 +69,8 @@ void SkyPoint::EquatorialToHorizontal(const dms *LST, const dms *lat)
 
 void SkyPoint::EquatorialToHorizontal(const CachingDms *LST, const CachingDms *lat)
 {
-#ifdef PROFILE_COORDINATE_CONVERSION
-    std::clock_t start = std::clock();
-#endif
+    KSProfiler::ScopedTimer timer(KSProfiler::EquatorialToHorizontal);
+
     //Uncomment for spherical trig version
     double AltRad, AzRad;
     double sindec, cosdec, sinlat, coslat, sinHA, cosHA;
@@ -112,11 +106,6 @@ void SkyPoint::EquatorialToHorizontal(const CachingDms *LST, const CachingDms *l
 
     Alt.setRadians(AltRad);
     Az.setRadians(AzRad);
-#ifdef PROFILE_COORDINATE_CONVERSION
-    std::clock_t stop = std::clock();
-    cpuTime_EqToHz += double(stop - start) / double(CLOCKS_PER_SEC); // Accumulate time in seconds
-    ++eqToHzCalls;
-#endif
 
     // //Uncomment for XYZ version
     //  	double xr, yr, zr, xr1, zr1, sa, ca;
@@ -27,8 +27,6 @@
 #include <QtDBus/QtDBus>
 #endif
 
-//#define PROFILE_COORDINATE_CONVERSION
-
 class KSNumbers;
 class KSSun;
 class GeoLocation;
@@ -743,11 +741,6 @@ class SkyPoint
          */
         double minAlt(const dms &lat) const;
 
-#ifdef PROFILE_COORDINATE_CONVERSION
-        static double cpuTime_EqToHz;
-        static long unsigned eqToHzCalls;
-#endif
-
     protected:
         /**
          * Precess this SkyPoint's catalog coordinates to the epoch described by the
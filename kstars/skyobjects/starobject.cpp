@@ -19,6 +19,7 @@
 
 #include "deepstardata.h"
 #include "ksnumbers.h"
+#include "ksprofiler.h"
 #ifndef KSTARS_LITE
 #include "kspopupmenu.h"
 #endif
@@ -30,13 +31,6 @@
 
 #include <typeinfo>
 
-#ifdef PROFILE_UPDATECOORDS
-double StarObject::updateCoordsCpuTime = 0.;
-unsigned int StarObject::starsUpdated  = 0;
-#include <cstdlib>
-#include <ctime>
-#endif
-
 // DEBUG EDIT. Uncomment for testing Proper Motion
 //#include "skycomponents/skymesh.h"
 // END DEBUG
@@ -271,10 +265,8 @@ void StarObject::updateCoords(const KSNumbers *num, bool, const CachingDms *, co
 // Correction:  The method below computes the proper motion before the
 // precession.  If we precessed first then the direction of the proper
 // motion correction would depend on how far we've precessed.  -jbb
-#ifdef PROFILE_UPDATECOORDS
-    std::clock_t start, stop;
-    start = std::clock();
-#endif
+    KSProfiler::ScopedTimer timer(KSProfiler::StarUpdateCoords);
+
     CachingDms saveRA = ra0(), saveDec = dec0();
     CachingDms newRA, newDec;
 
@@ -285,12 +277,6 @@ void StarObject::updateCoords(const KSNumbers *num, bool, const CachingDms *, co
     SkyPoint::updateCoords(num);
     setRA0(saveRA);
     setDec0(saveDec);
-
-#ifdef PROFILE_UPDATECOORDS
-    stop = std::clock();
-    updateCoordsCpuTime += double(stop - start) / double(CLOCKS_PER_SEC);
-    ++starsUpdated;
-#endif
 }
 
 bool StarObject::getIndexCoords(const KSNumbers *num, CachingDms &ra, CachingDms &dec)
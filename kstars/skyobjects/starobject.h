@@ -17,8 +17,6 @@
 
 #pragma once
 
-//#define PROFILE_UPDATECOORDS
-
 #include "skyobject.h"
 
 #include <QString>
@@ -290,11 +288,6 @@ class StarObject : public SkyObject
     quint64 updateID { 0 };
     quint64 updateNumID { 0 };
 
-#ifdef PROFILE_UPDATECOORDS
-    static double updateCoordsCpuTime;
-    static unsigned int starsUpdated;
-#endif
-
   protected:
     // DEBUG EDIT. For testing proper motion, uncomment this, and related blocks
     // See starobject.cpp for further info.
@@ -183,8 +183,17 @@ class SkyPainter
      */
     virtual bool drawHips() = 0;
 
+    /**
+     * @short Set the key of the current projection state.
+     * While the key does not change, the screen coordinates cached in the LineLists
+     * drawn are reused. Zero, the default, disables the cache.
+     * @see LineListIndex::projectionKey()
+     */
+    void setProjectionKey(quint64 key) { m_projectionKey = key; }
+
   protected:
     SkyMap *m_sm { nullptr };
+    quint64 m_projectionKey { 0 };
 
   private:
     float m_sizeMagLim { 10.0f };
@@ -22,6 +22,7 @@
 #include <QPointer>
 
 #include "kstarsdata.h"
+#include "ksprofiler.h"
 #include "Options.h"
 #include "skymap.h"
 #include "projections/projector.h"
@@ -297,52 +298,53 @@ void SkyQPainter::drawSkyLine(SkyPoint *a, SkyPoint *b)
 
 void SkyQPainter::drawSkyPolyline(LineList *list, SkipHashList *skipList, LineListLabel *label)
 {
-    SkyList *points = list->points();
-    bool isVisible, isVisibleLast;
+    SkyList *points              = list->points();
+    LineList::Projection &cache  = list->projection;
+    static const int hitCounter  = KSProfiler::counter(QStringLiteral("LineList/projectionHits"));
+    static const int missCounter = KSProfiler::counter(QStringLiteral("LineList/projectionMisses"));
 
-    QPointF oLast = m_proj->toScreen(points->first().get(), true, &isVisibleLast);
-    // & with the result of checkVisibility to clip away things below horizon
-    isVisibleLast &= m_proj->checkVisibility(points->first().get());
-    QPointF oThis, oThis2;
+    if (points->isEmpty())
+        return;
 
-    for (int j = 1; j < points->size(); j++)
+    if (m_projectionKey == 0 || cache.lineKey != m_projectionKey || cache.points.size() != points->size())
     {
-        SkyPoint *pThis = points->at(j).get();
-
-        oThis2 = oThis = m_proj->toScreen(pThis, true, &isVisible);
-        // & with the result of checkVisibility to clip away things below horizon
-        isVisible &= m_proj->checkVisibility(pThis);
-        bool doSkip = false;
-        if (skipList)
+        cache.points.resize(points->size());
+        cache.visible.resize(points->size());
+        for (int j = 0; j < points->size(); j++)
         {
-            doSkip = skipList->skip(j);
-        }
+            SkyPoint *pThis = points->at(j).get();
+            bool isVisible  = false;
 
-        bool pointsVisible = false;
-        //Temporary solution to avoid random lines in Gnomonic projection and draw lines up to horizon
-        if (SkyMap::Instance()->projector()->type() == Projector::Gnomonic)
-        {
-            if (isVisible && isVisibleLast)
-                pointsVisible = true;
-        }
-        else
-        {
-            if (isVisible || isVisibleLast)
-                pointsVisible = true;
+            cache.points[j] = m_proj->toScreen(pThis, true, &isVisible);
+            // & with the result of checkVisibility to clip away things below horizon
+            cache.visible[j] = isVisible && m_proj->checkVisibility(pThis);
         }
+        cache.lineKey = m_projectionKey;
+        KSProfiler::count(missCounter);
+    }
+    else
+        KSProfiler::count(hitCounter);
+
+    //Temporary solution to avoid random lines in Gnomonic projection and draw lines up to horizon
+    const bool gnomonic = (m_proj->type() == Projector::Gnomonic);
 
-        if (!doSkip)
+    for (int j = 1; j < points->size(); j++)
+    {
+        if (skipList && skipList->skip(j))
+            continue;
+
+        const bool isVisible     = cache.visible[j];
+        const bool isVisibleLast = cache.visible[j - 1];
+        const bool pointsVisible = gnomonic ? (isVisible && isVisibleLast) : (isVisible || isVisibleLast);
+
+        if (pointsVisible)
         {
-            if (pointsVisible)
-            {
-                drawLine(oLast, oThis);
-                if (label)
-                    label->updateLabelCandidates(oThis.x(), oThis.y(), list, j);
-            }
-        }
+            const QPointF &oThis = cache.points[j];
 
-        oLast         = oThis2;
-        isVisibleLast = isVisible;
+            drawLine(cache.points[j - 1], oThis);
+            if (label)
+                label->updateLabelCandidates(oThis.x(), oThis.y(), list, j);
+        }
     }
 }
 
@@ -367,6 +369,18 @@ void SkyQPainter::drawSkyPolygon(LineList *list, bool forceClip)
         return;
     }
 
+    LineList::Projection &cache  = list->projection;
+    static const int hitCounter  = KSProfiler::counter(QStringLiteral("LineList/projectionHits"));
+    static const int missCounter = KSProfiler::counter(QStringLiteral("LineList/projectionMisses"));
+
+    if (m_projectionKey != 0 && cache.polygonKey == m_projectionKey)
+    {
+        KSProfiler::count(hitCounter);
+        if (cache.polygon.size())
+            drawPolygon(cache.polygon);
+        return;
+    }
+
     SkyPoint *pLast = points->last().get();
     QPointF oLast   = m_proj->toScreen(pLast, true, &isVisibleLast);
     // & with the result of checkVisibility to clip away things below horizon
@@ -400,6 +414,13 @@ void SkyQPainter::drawSkyPolygon(LineList *list, bool forceClip)
         isVisibleLast = isVisible;
     }
 
+    if (m_projectionKey != 0)
+    {
+        cache.polygonKey = m_projectionKey;
+        cache.polygon    = polygon;
+        KSProfiler::count(missCounter);
+    }
+
     if (polygon.size())
         drawPolygon(polygon);
 }
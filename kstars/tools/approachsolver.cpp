@@ -59,6 +59,9 @@ QMap<long double, dms> ApproachSolver::findClosestApproach(long double startJD,
     jd += step;
     while (jd <= stopJD)
     {
+        if (m_abort && *m_abort)
+            break;
+
         int progress = int(100.0 * (jd - startJD) / (stopJD - startJD));
         emit solverMadeProgress(progress);
 
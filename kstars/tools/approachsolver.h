@@ -22,6 +22,7 @@
 
 #include <QObject>
 #include <QMap>
+#include <atomic>
 #include <memory>
 
 /**
@@ -75,6 +76,12 @@ public:
     void setMaxSeparation(double sep) { m_maxSeparation = sep; }
     void setMaxSeparation(dms sep) { m_maxSeparation = sep.radians(); }
 
+    /**
+     * @brief setAbortFlag
+     * @param abort - findClosestApproach returns what it found so far as soon as this becomes true
+     */
+    void setAbortFlag(const std::atomic<bool> *abort) { m_abort = abort; }
+
 signals:
     /**
      * @brief solverMadeProgress
@@ -158,4 +165,5 @@ private:
 
     GeoLocation * m_geoPlace { nullptr };
     double m_maxSeparation;
+    const std::atomic<bool> *m_abort { nullptr };
 };
@@ -85,11 +85,11 @@ ConjunctionsTool::ConjunctionsTool(QWidget *parentSplit) : QFrame(parentSplit)
     // Mode Change
     connect(ModeSelector, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this, &ConjunctionsTool::setMode);
 
-    //connect(ComputeButton, SIGNAL(clicked()), this, SLOT(slotCompute()));
-    connect(ComputeButton, &QPushButton::clicked, [this]()
-    {
-        QtConcurrent::run(this, &ConjunctionsTool::slotCompute);
-    });
+    connect(ComputeButton, SIGNAL(clicked()), this, SLOT(slotCompute()));
+    connect(AbortButton, SIGNAL(clicked()), this, SLOT(slotAbort()));
+    connect(this, &ConjunctionsTool::conjunctionFound, this, &ConjunctionsTool::showConjunction);
+    connect(this, &ConjunctionsTool::objectDone, this, &ConjunctionsTool::showObjectDone);
+    connect(&m_Watcher, &QFutureWatcher<void>::finished, this, &ConjunctionsTool::slotComputeFinished);
     connect(FilterTypeComboBox, SIGNAL(currentIndexChanged(int)), SLOT(slotFilterType(int)));
     connect(ClearButton, SIGNAL(clicked()), this, SLOT(slotClear()));
     connect(ExportButton, SIGNAL(clicked()), this, SLOT(slotExport()));
@@ -141,6 +141,13 @@ ConjunctionsTool::ConjunctionsTool(QWidget *parentSplit) : QFrame(parentSplit)
     show();
 }
 
+ConjunctionsTool::~ConjunctionsTool()
+{
+    // The jobs reference this tool, let them wind down first
+    m_Abort = true;
+    m_Watcher.waitForFinished();
+}
+
 void ConjunctionsTool::slotGoto()
 {
     int index      = m_SortModel->mapToSource(OutputList->currentIndex()).row(); // Get the number of the line
@@ -245,6 +252,10 @@ void ConjunctionsTool::slotFilterReg(const QString &filter)
 
 void ConjunctionsTool::slotCompute(void)
 {
+    // A search is still running
+    if (m_Watcher.isRunning())
+        return;
+
     KStarsDateTime dtStart(startDate->dateTime()); // Start date
     KStarsDateTime dtStop(stopDate->dateTime());  // Stop date
     long double startJD    = dtStart.djd();         // Start julian day
@@ -254,7 +265,6 @@ void ConjunctionsTool::slotCompute(void)
         opposition = true;
     QStringList objects; // List of sky object used as Object1
     KStarsData *data = KStarsData::Instance();
-    int progress     = 0;
 
     // Check if we have a valid angle in maxSeparationBox
     dms maxSeparation(0.0);
@@ -274,19 +284,15 @@ void ConjunctionsTool::slotCompute(void)
         KSNotification::sorry(i18n("Please select an object to check conjunctions with, by clicking on the \'Find Object\' button."));
         return;
     }
-    Object2.reset(KSPlanetBase::createPlanet(Obj2ComboBox->currentIndex()));
+    const int planet = Obj2ComboBox->currentIndex();
+    Object2.reset(KSPlanetBase::createPlanet(planet));
     if (FilterTypeComboBox->currentIndex() == 0 && Object1->name() == Object2->name())
     {
-        // FIXME: Must free the created Objects
         KSNotification::sorry(i18n("Please select two different objects to check conjunctions with."));
+        Object2.reset();
         return;
     }
 
-    // Init KSConjunct object
-    KSConjunct ksc;
-    connect(&ksc, SIGNAL(madeProgress(int)), this, SLOT(showProgress(int)));
-    ksc.setGeoLocation(geoPlace);
-
     switch (FilterTypeComboBox->currentIndex())
     {
         case 1: // All object types
@@ -353,55 +359,115 @@ void ConjunctionsTool::slotCompute(void)
         objects.removeAll("Iapetus");
     }
 
-    ksc.setMaxSeparation(maxSeparation);
-    ksc.setObject2(Object2);
-    ksc.setOpposition(opposition);
-
+    // Everything that is not thread-safe (catalog lookups, creation of the
+    // planets and of their shared orbital data) is done here, on the main thread.
+    m_Jobs.clear();
     if (FilterTypeComboBox->currentIndex() != 0)
     {
-        // Show a progress dialog while processing
-        QProgressDialog progressDlg(i18n("Compute conjunction..."), i18n("Abort"), 0, objects.count(), this);
-        progressDlg.setWindowTitle(i18n("Conjunction"));
-        progressDlg.setWindowModality(Qt::WindowModal);
-        progressDlg.setValue(0);
-
         for (auto &object : objects)
         {
-            // If the user click on the 'cancel' button
-            if (progressDlg.wasCanceled())
-                break;
-
-            // Update progress dialog
-            ++progress;
-            progressDlg.setValue(progress);
-            progressDlg.setLabelText(i18n("Compute conjunction between %1 and %2", Object2->name(), object));
-
-            // Compute conjuction
-            Object1 = std::shared_ptr<SkyObject>(data->skyComposite()->findByName(object)->clone());
-            ksc.setObject1(Object1);
-            showConjunctions(ksc.findClosestApproach(startJD, stopJD),
-                             object, Object2->name());
+            SkyObject *o = data->skyComposite()->findByName(object);
+            if (o == nullptr)
+                continue;
+
+            ConjunctionJob job;
+            job.object1 = SkyObject_s(o->clone());
+            job.object2 = KSPlanetBase_s(KSPlanetBase::createPlanet(planet));
+            m_Jobs.append(job);
         }
-
-        progressDlg.setValue(objects.count());
     }
     else
+    {
+        m_Jobs.append({ Object1, Object2 });
+    }
+
+    m_Abort = false;
+    m_Ephemeris = std::make_shared<ApproachEphemeris>(planet, geoPlace, startJD, stopJD);
+
+    const bool singleObject = FilterTypeComboBox->currentIndex() == 0;
+    if (singleObject)
     {
         // Change cursor while we search for conjunction
         QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
-
+        progress->setValue(0);
         ComputeStack->setCurrentIndex(1);
+    }
+    else
+    {
+        // Show a progress dialog while processing
+        m_ProgressDlg = new QProgressDialog(i18n("Compute conjunction with %1...", Object2->name()), i18n("Abort"), 0,
+                                            m_Jobs.count(), this);
+        m_ProgressDlg->setWindowTitle(i18n("Conjunction"));
+        m_ProgressDlg->setWindowModality(Qt::WindowModal);
+        m_ProgressDlg->setAutoClose(false);
+        m_ProgressDlg->setAutoReset(false);
+        m_ProgressDlg->setValue(0);
+        connect(m_ProgressDlg, &QProgressDialog::canceled, this, &ConjunctionsTool::slotAbort);
+        m_ProgressDlg->show();
+    }
+    ComputeButton->setEnabled(false);
 
-        ksc.setObject1(Object1);
-        showConjunctions(ksc.findClosestApproach(startJD, stopJD),
-                         Object1->name(), Object2->name());
-        ComputeStack->setCurrentIndex(0);
+    m_Watcher.setFuture(QtConcurrent::run([ = ]()
+    {
+        // An incomplete table is simply not used by the searches
+        m_Ephemeris->compute(m_Abort);
+
+        std::atomic<int> done { 0 };
+        QtConcurrent::blockingMap(m_Jobs, [&](ConjunctionJob & job)
+        {
+            if (m_Abort)
+                return;
+            runJob(job, startJD, stopJD, maxSeparation, opposition, singleObject);
+            emit objectDone(++done);
+        });
+    }));
+}
+
+void ConjunctionsTool::runJob(ConjunctionJob &job, long double startJD, long double stopJD, dms maxSeparation,
+                              bool opposition, bool reportProgress)
+{
+    KSConjunct ksc;
+    if (reportProgress)
+        connect(&ksc, &KSConjunct::madeProgress, this, &ConjunctionsTool::showProgress);
+    ksc.setGeoLocation(geoPlace);
+    ksc.setMaxSeparation(maxSeparation);
+    ksc.setObject1(job.object1);
+    ksc.setObject2(job.object2);
+    ksc.setOpposition(opposition);
+    ksc.setAbortFlag(&m_Abort);
+    ksc.setObject2Ephemeris(m_Ephemeris);
+
+    const QString object1 = job.object1->name();
+    const QString object2 = job.object2->name();
+    ksc.findClosestApproach(startJD, stopJD, [&](long double jd, dms separation)
+    {
+        emit conjunctionFound(static_cast<double>(jd), separation.Degrees(), object1, object2);
+    });
+}
+
+void ConjunctionsTool::slotAbort()
+{
+    m_Abort = true;
+}
 
+void ConjunctionsTool::slotComputeFinished()
+{
+    m_Jobs.clear();
+    m_Ephemeris.reset();
+    Object2.reset();
+
+    if (m_ProgressDlg)
+    {
+        m_ProgressDlg->deleteLater();
+        m_ProgressDlg = nullptr;
+    }
+    else
+    {
+        ComputeStack->setCurrentIndex(0);
         // Restore cursor
         QApplication::restoreOverrideCursor();
     }
-
-    Object2.reset();
+    ComputeButton->setEnabled(true);
 }
 
 void ConjunctionsTool::showProgress(int n)
@@ -409,34 +475,34 @@ void ConjunctionsTool::showProgress(int n)
     progress->setValue(n);
 }
 
-void ConjunctionsTool::showConjunctions(const QMap<long double, dms> &conjunctionlist, const QString &object1,
-                                        const QString &object2)
+void ConjunctionsTool::showObjectDone(int count)
+{
+    if (m_ProgressDlg)
+        m_ProgressDlg->setValue(count);
+}
+
+void ConjunctionsTool::showConjunction(double jd, double separation, const QString &object1, const QString &object2)
 {
     KStarsDateTime dt;
-    QList<QStandardItem *> itemList;
+    dt.setDJD(jd);
+    QStandardItem *typeItem;
 
-    for (auto it = conjunctionlist.constBegin(); it != conjunctionlist.constEnd(); ++it)
-    {
-        dt.setDJD(it.key());
-        QStandardItem *typeItem;
-
-        if (mode == CONJUNCTION)
-            typeItem = new QStandardItem(i18n("Conjunction"));
-        else
-            typeItem = new QStandardItem(i18n("Opposition"));
-
-        itemList << typeItem
-                 //FIXME TODO is this ISO date? is there a ready format to use?
-                 //<< new QStandardItem( QLocale().toString( dt.dateTime(), "YYYY-MM-DDTHH:mm:SS" ) )
-                 //<< new QStandardItem( QLocale().toString( dt, Qt::ISODate) )
-                 << new QStandardItem(dt.toString(Qt::ISODate)) << new QStandardItem(object1)
-                 << new QStandardItem(object2) << new QStandardItem(it.value().toDMSString());
-        m_Model->appendRow(itemList);
-        itemList.clear();
-
-        outputJDList.insert(m_index, it.key());
-        ++m_index;
-    }
+    if (mode == CONJUNCTION)
+        typeItem = new QStandardItem(i18n("Conjunction"));
+    else
+        typeItem = new QStandardItem(i18n("Opposition"));
+
+    QList<QStandardItem *> itemList;
+    itemList << typeItem
+             //FIXME TODO is this ISO date? is there a ready format to use?
+             //<< new QStandardItem( QLocale().toString( dt.dateTime(), "YYYY-MM-DDTHH:mm:SS" ) )
+             //<< new QStandardItem( QLocale().toString( dt, Qt::ISODate) )
+             << new QStandardItem(dt.toString(Qt::ISODate)) << new QStandardItem(object1)
+             << new QStandardItem(object2) << new QStandardItem(dms(separation).toDMSString());
+    m_Model->appendRow(itemList);
+
+    outputJDList.insert(m_index, jd);
+    ++m_index;
 }
 
 void ConjunctionsTool::setUpConjunctionOpposition()
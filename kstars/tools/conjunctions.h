@@ -28,14 +28,21 @@
 #include "ui_conjunctions.h"
 
 #include <QFrame>
+#include <QFutureWatcher>
 #include <QMap>
+#include <QPointer>
 #include <QString>
+#include <QVector>
 #include "skycomponents/typedef.h"
+
+#include <atomic>
 #include <memory>
 
+class QProgressDialog;
 class QSortFilterProxyModel;
 class QStandardItemModel;
 
+class ApproachEphemeris;
 class GeoLocation;
 class KSPlanetBase;
 class SkyObject;
@@ -44,6 +51,11 @@ class SkyObject;
 
 /**
   * @short Predicts conjunctions using KSConjunct in the background
+  *
+  * Each object checked against the planet is searched in its own task on the
+  * global thread pool. The positions of the planet are tabulated once for the
+  * whole run and shared by all tasks. Conjunctions are added to the table as
+  * soon as they are found, and the run can be aborted at any time.
   */
 class ConjunctionsTool : public QFrame, public Ui::ConjunctionsDlg
 {
@@ -51,7 +63,7 @@ class ConjunctionsTool : public QFrame, public Ui::ConjunctionsDlg
 
   public:
     explicit ConjunctionsTool(QWidget *p);
-    virtual ~ConjunctionsTool() override = default;
+    virtual ~ConjunctionsTool() override;
 
   public slots:
 
@@ -65,10 +77,29 @@ class ConjunctionsTool : public QFrame, public Ui::ConjunctionsDlg
     void slotClear();
     void slotExport();
     void slotFilterReg(const QString &);
+    void slotAbort();
+
+  signals:
+    /** Emitted from the worker threads for each conjunction found, separation is in degrees */
+    void conjunctionFound(double jd, double separation, const QString &object1, const QString &object2);
+    /** Emitted from the worker threads each time the search for an object is over */
+    void objectDone(int count);
+
+  private slots:
+    void showConjunction(double jd, double separation, const QString &object1, const QString &object2);
+    void showObjectDone(int count);
+    void slotComputeFinished();
 
   private:
-    void showConjunctions(const QMap<long double, dms> &conjunctionlist, const QString &object1,
-                          const QString &object2);
+    /** One object searched against Object2, set up on the main thread and run on the thread pool */
+    struct ConjunctionJob
+    {
+        SkyObject_s object1;
+        KSPlanetBase_s object2;
+    };
+
+    void runJob(ConjunctionJob &job, long double startJD, long double stopJD, dms maxSeparation,
+                bool opposition, bool reportProgress);
 
     /**
      * @brief setUpConjunctionOpposition
@@ -96,4 +127,10 @@ class ConjunctionsTool : public QFrame, public Ui::ConjunctionsDlg
     QStandardItemModel *m_Model { nullptr };
     QSortFilterProxyModel *m_SortModel { nullptr };
     int m_index { 0 };
+
+    QVector<ConjunctionJob> m_Jobs;
+    std::shared_ptr<ApproachEphemeris> m_Ephemeris;
+    std::atomic<bool> m_Abort { false };
+    QFutureWatcher<void> m_Watcher;
+    QPointer<QProgressDialog> m_ProgressDlg;
 };
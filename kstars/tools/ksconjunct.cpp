@@ -17,13 +17,157 @@
 
 #include "ksconjunct.h"
 
+#include "geolocation.h"
 #include "ksnumbers.h"
 #include "kstarsdata.h"
+#include "kstarsdatetime.h"
 #include "skyobjects/skyobject.h"
 #include "skyobjects/ksplanetbase.h"
 
+#include <QtConcurrent>
+
 #include <cmath>
 
+ApproachEphemeris::ApproachEphemeris(int planet, GeoLocation *geo, long double startJD, long double stopJD)
+    : m_Geo(geo)
+{
+    m_Step = stepForPlanet(planet);
+
+    // ApproachSolver looks a few days around the range to qualify minima
+    const double margin = 10.0;
+    m_StartJD = startJD - margin;
+    const double samples = ceil(static_cast<double>(stopJD - startJD + 2 * margin) / m_Step) + 1;
+
+    // Very long ranges would not fit comfortably in memory, those are left
+    // to the direct computation
+    if (samples > MaxSamples)
+        return;
+    m_Count = static_cast<int>(samples);
+
+    m_X.resize(m_Count);
+    m_Y.resize(m_Count);
+    m_Z.resize(m_Count);
+
+    // Planets keep shared orbital data that is loaded lazily, so create and
+    // prime them here before they are used from several threads.
+    const int chunks = std::max(1, std::min(QThread::idealThreadCount(), m_Count / 64));
+    KSNumbers num(startJD);
+    for (int i = 0; i < chunks; ++i)
+    {
+        KSPlanetBase *p = KSPlanetBase::createPlanet(planet);
+        KSPlanet *earth = new KSPlanet(i18n("Earth"), QString(), QColor("white"), 12756.28 /*diameter in km*/);
+        earth->findPosition(&num);
+        p->findPosition(&num, nullptr, nullptr, earth);
+        m_Planets.append(p);
+        m_Earths.append(earth);
+    }
+}
+
+ApproachEphemeris::~ApproachEphemeris()
+{
+    qDeleteAll(m_Planets);
+    qDeleteAll(m_Earths);
+}
+
+double ApproachEphemeris::stepForPlanet(int planet)
+{
+    // Steps are small enough for the cubic interpolation to stay well below
+    // the one minute resolution of ApproachSolver::findPrecise()
+    switch (planet)
+    {
+        case KSPlanetBase::MOON:
+            return 1.0 / 24.0;
+        case KSPlanetBase::SUN:
+        case KSPlanetBase::MERCURY:
+        case KSPlanetBase::VENUS:
+        case KSPlanetBase::MARS:
+            return 0.25;
+        default:
+            return 1.0;
+    }
+}
+
+bool ApproachEphemeris::compute(const std::atomic<bool> &abort)
+{
+    if (m_Planets.isEmpty())
+        return false;
+
+    const int chunks = m_Planets.size();
+    const int perChunk = (m_Count + chunks - 1) / chunks;
+
+    QVector<int> chunkIndexes;
+    for (int i = 0; i < chunks; ++i)
+        chunkIndexes.append(i);
+
+    QtConcurrent::blockingMap(chunkIndexes, [&](int chunk)
+    {
+        const int first = chunk * perChunk;
+        const int last  = std::min(m_Count, first + perChunk);
+        for (int i = first; i < last && !abort; i += 256)
+            computeRange(chunk, i, std::min(last, i + 256));
+    });
+
+    m_Complete = !abort;
+    return m_Complete;
+}
+
+void ApproachEphemeris::computeRange(int chunk, int first, int last)
+{
+    KSPlanetBase *planet = m_Planets[chunk];
+    KSPlanet *earth      = m_Earths[chunk];
+    double sinRA, cosRA, sinDec, cosDec;
+
+    for (int i = first; i < last; ++i)
+    {
+        const long double jd = m_StartJD + static_cast<long double>(i) * m_Step;
+        KStarsDateTime t(jd);
+        KSNumbers num(jd);
+        CachingDms LST(m_Geo->GSTtoLST(t.gst()));
+
+        earth->findPosition(&num);
+        planet->findPosition(&num, m_Geo->lat(), &LST, earth);
+
+        planet->ra().SinCos(sinRA, cosRA);
+        planet->dec().SinCos(sinDec, cosDec);
+        m_X[i] = cosDec * cosRA;
+        m_Y[i] = cosDec * sinRA;
+        m_Z[i] = sinDec;
+    }
+}
+
+bool ApproachEphemeris::contains(long double jd) const
+{
+    if (!m_Complete)
+        return false;
+
+    // Cubic interpolation needs one sample before and two after the interval
+    const double index = static_cast<double>(jd - m_StartJD) / m_Step;
+    return index >= 1 && index < m_Count - 2;
+}
+
+void ApproachEphemeris::position(long double jd, SkyPoint *p) const
+{
+    const double index = static_cast<double>(jd - m_StartJD) / m_Step;
+    const int i        = static_cast<int>(floor(index));
+    const double t     = index - i;
+
+    // Four-point Lagrange interpolation on the samples i-1 .. i+2
+    const double w0 = -t * (t - 1) * (t - 2) / 6.0;
+    const double w1 = (t + 1) * (t - 1) * (t - 2) / 2.0;
+    const double w2 = -(t + 1) * t * (t - 2) / 2.0;
+    const double w3 = (t + 1) * t * (t - 1) / 6.0;
+
+    const double x = w0 * m_X[i - 1] + w1 * m_X[i] + w2 * m_X[i + 1] + w3 * m_X[i + 2];
+    const double y = w0 * m_Y[i - 1] + w1 * m_Y[i] + w2 * m_Y[i + 1] + w3 * m_Y[i + 2];
+    const double z = w0 * m_Z[i - 1] + w1 * m_Z[i] + w2 * m_Z[i + 1] + w3 * m_Z[i + 2];
+
+    dms ra, dec;
+    ra.setRadians(atan2(y, x));
+    dec.setRadians(atan2(z, sqrt(x * x + y * y)));
+    p->setRA(CachingDms(ra.reduce()));
+    p->setDec(dec);
+}
+
 KSConjunct::KSConjunct() : ApproachSolver ()
 {
     connect(this, &ApproachSolver::solverMadeProgress, this, &KSConjunct::madeProgress);
@@ -31,7 +175,7 @@ KSConjunct::KSConjunct() : ApproachSolver ()
 
 dms KSConjunct::findDistance()
 {
-    dms dist = findSkyPointDistance(m_object1.get(), m_object2.get());
+    dms dist = findSkyPointDistance(m_object1.get(), m_object2Point ? m_object2Point : m_object2.get());
     if (m_opposition)
     {
         dist.setD(180 - dist.Degrees());
@@ -45,16 +189,29 @@ void KSConjunct::updatePositions(long double jd)
     KStarsDateTime t(jd);
     KSNumbers num(jd);
 
-    m_Earth.findPosition(&num);
+    const bool tabulated = m_ephemeris && m_ephemeris->contains(jd);
+    KSPlanetBase *p = dynamic_cast<KSPlanetBase*>(m_object1.get());
+
+    // The Earth is only needed for planets that are not tabulated
+    if (p || !tabulated)
+        m_Earth.findPosition(&num);
     CachingDms LST(getGeoLocation()->GSTtoLST(t.gst()));
 
-    KSPlanetBase *p = dynamic_cast<KSPlanetBase*>(m_object1.get());
     if (p)
         p->findPosition(&num, getGeoLocation()->lat(), &LST, &m_Earth);
     else
         m_object1->updateCoordsNow(&num);
 
-    m_object2->findPosition(&num, getGeoLocation()->lat(), &LST, &m_Earth);
+    if (tabulated)
+    {
+        m_ephemeris->position(jd, &m_object2Position);
+        m_object2Point = &m_object2Position;
+    }
+    else
+    {
+        m_object2->findPosition(&num, getGeoLocation()->lat(), &LST, &m_Earth);
+        m_object2Point = m_object2.get();
+    }
 }
 
 double KSConjunct::findInitialStep(long double startJD, long double stopJD)
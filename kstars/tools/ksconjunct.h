@@ -18,10 +18,71 @@
 #pragma once
 #include "approachsolver.h"
 
+#include <QVector>
+
+#include <atomic>
+#include <memory>
+
 class GeoLocation;
 class KSPlanetBase;
 class SkyObject;
 
+/**
+ * @class ApproachEphemeris
+ * @short Positions of a planet tabulated over a time range.
+ *
+ * When the same planet is searched against many objects, its position is
+ * computed once on a regular grid and interpolated by the concurrent searches,
+ * instead of being recomputed from the full theory for every step of each search.
+ * The table is filled in parallel, each thread using its own planet instance.
+ *
+ * The planet instances are created and destroyed with the table, so that must
+ * happen on the main thread; compute() may run on any thread.
+ */
+class ApproachEphemeris
+{
+  public:
+    /**
+     * @param planet index of the planet, as expected by KSPlanetBase::createPlanet()
+     * @param geo location of the observer, for topocentric positions
+     * @param startJD first Julian Day to tabulate
+     * @param stopJD last Julian Day to tabulate
+     */
+    ApproachEphemeris(int planet, GeoLocation *geo, long double startJD, long double stopJD);
+    ~ApproachEphemeris();
+
+    /**
+     * @short Fill the table, in parallel. Returns early if abort is set.
+     * @return true if the table is complete
+     */
+    bool compute(const std::atomic<bool> &abort);
+
+    /** @return true if the position at jd can be interpolated from the table */
+    bool contains(long double jd) const;
+
+    /** @short Sets p to the interpolated equatorial position of the planet at jd */
+    void position(long double jd, SkyPoint *p) const;
+
+    /** @return the tabulation step in days for the planet */
+    static double stepForPlanet(int planet);
+
+  private:
+    void computeRange(int chunk, int first, int last);
+
+    static constexpr double MaxSamples { 2e6 };
+
+    long double m_StartJD { 0 };
+    double m_Step { 1 };
+    int m_Count { 0 };
+    bool m_Complete { false };
+    GeoLocation *m_Geo { nullptr };
+    // Unit vectors of the position of the planet at each step
+    QVector<double> m_X, m_Y, m_Z;
+    // One planet and one Earth per chunk computed in parallel
+    QVector<KSPlanetBase *> m_Planets;
+    QVector<KSPlanet *> m_Earths;
+};
+
 /**
  * @class KSConjunct
  * @short Implements algorithms to find close conjunctions of planets in a given time range.
@@ -43,6 +104,12 @@ public:
     void setObject2(KSPlanetBase_s &obj) { m_object2 = obj; }
     void setOpposition(bool opposition) { m_opposition = opposition; }
 
+    /**
+     * @short Use a precomputed table for the positions of Object 2 where possible
+     * @note The table must have been computed already, it is only read.
+     */
+    void setObject2Ephemeris(const std::shared_ptr<const ApproachEphemeris> &ephemeris) { m_ephemeris = ephemeris; }
+
 signals:
     void madeProgress(int);
 
@@ -57,5 +124,11 @@ private:
     SkyObject_s m_object1;
     KSPlanetBase_s m_object2;
     bool m_opposition { false };
+
+    std::shared_ptr<const ApproachEphemeris> m_ephemeris;
+    /// Interpolated position of Object 2 when the ephemeris is used
+    SkyPoint m_object2Position;
+    /// Points either to m_object2 or to m_object2Position
+    SkyPoint *m_object2Point { nullptr };
 };
 
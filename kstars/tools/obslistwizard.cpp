@@ -23,6 +23,7 @@
 #include "skycomponents/constellationboundarylines.h"
 #include "skycomponents/skymapcomposite.h"
 #include "skyobjects/deepskyobject.h"
+#include "tools/visibilityengine.h"
 
 ObsListWizardUI::ObsListWizardUI(QWidget *p) : QFrame(p)
 {
@@ -442,6 +443,9 @@ void ObsListWizard::applyFilters(bool doBuildList)
     if (olw->SelectByMagnitude->isChecked())
         maglimit = olw->Mag->value();
 
+    if (olw->SelectByDate->isChecked())
+        prepareObservableFilter();
+
     //Stars
     if (isItemSelected(i18n("Stars"), olw->TypeList))
     {
@@ -907,15 +911,11 @@ bool ObsListWizard::applyRegionFilter(SkyObject *o, bool doBuildList, bool doAdj
     return true;
 }
 
-bool ObsListWizard::applyObservableFilter(SkyObject *o, bool doBuildList, bool doAdjustCount)
+void ObsListWizard::observableWindow(KStarsDateTime &startUT, KStarsDateTime &endUT) const
 {
-    SkyPoint p = *o;
-
-    //Check altitude of object every hour from 18:00 to midnight
-    //If it's ever above 15 degrees, flag it as visible
+    //Check altitude of object from 18:00 to midnight by default
     KStarsDateTime Evening(olw->Date->date(), QTime(18, 0, 0), Qt::LocalTime);
     KStarsDateTime Midnight(olw->Date->date().addDays(1), QTime(0, 0, 0), Qt::LocalTime);
-    double minAlt = 15, maxAlt = 90;
 
     // Or use user-selected values, if they're valid
     if (olw->timeFrom->time().isValid() && olw->timeTo->time().isValid())
@@ -936,25 +936,91 @@ bool ObsListWizard::applyObservableFilter(SkyObject *o, bool doBuildList, bool d
         }
     }
 
-    minAlt = olw->minAlt->value();
-    maxAlt = olw->maxAlt->value();
+    // Times are entered in the local time of the selected location
+    startUT = geo->LTtoUT(Evening);
+    endUT   = geo->LTtoUT(Midnight);
+}
 
-    // This is the "relaxed" search mode
-    // where if the object obeys the restrictions in 50% of the time of the range
-    // then it qualifies as "visible"
-    double totalCount = 0, visibleCount = 0;
-    for (KStarsDateTime t = Evening; t < Midnight; t = t.addSecs(3600.0))
+VisibilityEngine *ObsListWizard::visibilityEngine()
+{
+    // Coordinates are kept for the night of the selected date, whatever the time range
+    KStarsDateTime midnight(olw->Date->date().addDays(1), QTime(0, 0, 0), Qt::LocalTime);
+    const KStarsDateTime midnightUT = geo->LTtoUT(midnight);
+    if (!m_Visibility || !m_Visibility->isForNight(geo, midnightUT))
+        m_Visibility.reset(new VisibilityEngine(geo, midnightUT));
+    return m_Visibility.get();
+}
+
+void ObsListWizard::prepareObservableFilter()
+{
+    KStarsData *data = KStarsData::Instance();
+    QVector<const SkyObject *> objects;
+
+    if (isItemSelected(i18n("Stars"), olw->TypeList))
     {
-        dms LST = geo->GSTtoLST(t.gst());
-        p.EquatorialToHorizontal(&LST, geo->lat());
-        totalCount++;
-        if (p.alt().Degrees() >= minAlt && p.alt().Degrees() <= maxAlt)
-            visibleCount++;
+        for (const SkyObject *o : data->skyComposite()->stars())
+            objects.append(o);
     }
 
-    // If the object is within the min/max alt at least coverage % of the time range
-    // then consider it visible
-    if (visibleCount / totalCount >= olw->coverage->value() / 100.0)
+    if (isItemSelected(i18n("Sun, moon, planets"), olw->TypeList))
+    {
+        for (const QString &name : { i18n("Sun"), i18n("Moon"), i18n("Mercury"), i18n("Venus"), i18n("Mars"),
+                                     i18n("Jupiter"), i18n("Saturn"), i18n("Uranus"), i18n("Neptune") })
+        {
+            const SkyObject *o = data->skyComposite()->findByName(name);
+            if (o)
+                objects.append(o);
+        }
+    }
+
+    if (isItemSelected(i18n("Open clusters"), olw->TypeList) ||
+            isItemSelected(i18n("Globular clusters"), olw->TypeList) ||
+            isItemSelected(i18n("Gaseous nebulae"), olw->TypeList) ||
+            isItemSelected(i18n("Planetary nebulae"), olw->TypeList) || isItemSelected(i18n("Galaxies"), olw->TypeList))
+    {
+        for (const DeepSkyObject *o : data->skyComposite()->deepSkyObjects())
+            objects.append(o);
+    }
+
+    if (isItemSelected(i18n("Comets"), olw->TypeList))
+    {
+        for (const SkyObject *o : data->skyComposite()->comets())
+            objects.append(o);
+    }
+
+    if (isItemSelected(i18n("Asteroids"), olw->TypeList))
+    {
+        for (const SkyObject *o : data->skyComposite()->asteroids())
+            objects.append(o);
+    }
+
+    KStarsDateTime startUT, endUT;
+    observableWindow(startUT, endUT);
+
+    const QVector<double> fractions =
+        visibilityEngine()->visibleFractions(objects, startUT, endUT, olw->minAlt->value(), olw->maxAlt->value());
+
+    m_ObservableFraction.clear();
+    m_ObservableFraction.reserve(objects.size());
+    for (int i = 0; i < objects.size(); ++i)
+        m_ObservableFraction.insert(objects[i], fractions[i]);
+}
+
+bool ObsListWizard::applyObservableFilter(SkyObject *o, bool doBuildList, bool doAdjustCount)
+{
+    double visibleFraction = m_ObservableFraction.value(o, -1);
+    if (visibleFraction < 0)
+    {
+        KStarsDateTime startUT, endUT;
+        observableWindow(startUT, endUT);
+        visibleFraction = visibilityEngine()->visibleFraction(o, startUT, endUT, olw->minAlt->value(), olw->maxAlt->value());
+    }
+
+    // This is the "relaxed" search mode
+    // where if the object obeys the restrictions in 50% of the time of the range
+    // then it qualifies as "visible". The strict mode, where ANY object that does
+    // not meet the min & max altitude at ANY time is removed, is visibleFraction >= 1.
+    if (visibleFraction >= olw->coverage->value() / 100.0)
         return true;
 
     if (doAdjustCount)
@@ -963,24 +1029,4 @@ bool ObsListWizard::applyObservableFilter(SkyObject *o, bool doBuildList, bool d
         obsList().takeAt(obsList().indexOf(o));
 
     return false;
-
-    // This is the strict mode where ANY object that does not meet the min & max
-    // altitude at ANY time would be removed from the list.
-#if 0
-    for (KStarsDateTime t = Evening; t < Midnight; t = t.addSecs(3600.0))
-    {
-        dms LST = geo->GSTtoLST(t.gst());
-        p.EquatorialToHorizontal(&LST, geo->lat());
-        if (p.alt().Degrees() < minAlt || p.alt().Degrees() > maxAlt)
-        {
-            if (doAdjustCount)
-                --ObjectCount;
-            if (doBuildList)
-                obsList().takeAt(obsList().indexOf(o));
-            return false;
-        }
-    }
-    return true;
-#endif
-
 }
@@ -17,15 +17,20 @@
 #pragma once
 
 #include "ui_obslistwizard.h"
+#include "kstarsdatetime.h"
 #include "skyobjects/skypoint.h"
 
 #include <QDialog>
+#include <QHash>
+
+#include <memory>
 
 class QListWidget;
 class QPushButton;
 
 class SkyObject;
 class GeoLocation;
+class VisibilityEngine;
 
 class ObsListWizardUI : public QFrame, public Ui::ObsListWizard
 {
@@ -77,6 +82,19 @@ class ObsListWizard : public QDialog
     bool applyRegionFilter(SkyObject *o, bool doBuildList, bool doAdjustCount = true);
     bool applyObservableFilter(SkyObject *o, bool doBuildList, bool doAdjustCount = true);
 
+    /**
+     * @short Evaluate in one parallel batch the fraction of the selected time range during
+     * which each object of the selected types is within the altitude limits.
+     * @note applyObservableFilter() uses these results, this is called by applyFilters().
+     */
+    void prepareObservableFilter();
+
+    /** @short Compute the time range selected for the observable filter, in UT */
+    void observableWindow(KStarsDateTime &startUT, KStarsDateTime &endUT) const;
+
+    /** @return the visibility engine for the selected night and location */
+    VisibilityEngine *visibilityEngine();
+
     /**
      * Convenience function for safely getting the selected state of a QListWidget item by name.
      * QListWidget has no method for easily selecting a single item based on its text.
@@ -97,6 +115,8 @@ class ObsListWizard : public QDialog
     void setItemSelected(const QString &name, QListWidget *listWidget, bool value, bool *ok = nullptr);
 
     QList<SkyObject *> ObsList;
+    QHash<const SkyObject *, double> m_ObservableFraction;
+    std::shared_ptr<VisibilityEngine> m_Visibility;
     ObsListWizardUI *olw { nullptr };
     uint ObjectCount { 0 };
     uint StarCount { 0 };
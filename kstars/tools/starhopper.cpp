@@ -24,6 +24,10 @@
 
 #include <kstars_debug.h>
 
+#include <algorithm>
+#include <functional>
+#include <queue>
+
 QList<StarObject *> *StarHopper::computePath(const SkyPoint &src, const SkyPoint &dest, float fov__, float maglim__,
                                              QStringList *metadata_)
 {
@@ -44,51 +48,51 @@ QList<const StarObject *> StarHopper::computePath_const(const SkyPoint &src, con
     start  = &src;
     end    = &dest;
 
-    came_from.clear();
     result_path.clear();
-
-    // Implements the A* search algorithm
-
-    QList<SkyPoint const *> cSet;
-    QList<SkyPoint const *> oSet;
-    QHash<SkyPoint const *, double> g_score;
-    QHash<SkyPoint const *, double> f_score;
-    QHash<SkyPoint const *, double> h_score;
+    patternNames.clear();
 
     qCDebug(KSTARS) << "StarHopper is trying to compute a path from source: " << src.ra().toHMSString()
              << src.dec().toDMSString() << " to destination: " << dest.ra().toHMSString() << dest.dec().toDMSString()
              << "; a starhop of " << src.angularDistanceTo(&dest).Degrees() << " degrees!";
 
-    oSet.append(&src);
-    g_score[&src] = 0;
-    h_score[&src] = src.angularDistanceTo(&dest).Degrees() / fov;
-    f_score[&src] = h_score[&src];
+    if (!buildSearchRegion(src, dest))
+    {
+        qCDebug(KSTARS) << "REGRET! Returning empty list!";
+        return QList<StarObject const *>();
+    }
+
+    // Implements the A* search algorithm. The open set is a binary heap of
+    // (f_score, node) entries; instead of updating entries in place when a
+    // better path to a node is found, a new entry is pushed and stale ones
+    // are skipped when popped.
+
+    using QueueEntry = std::pair<double, int>;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> oSet;
+
+    m_Nodes[0].g_score = 0;
+    m_Nodes[0].open    = true;
+    oSet.push(QueueEntry(m_Nodes[0].h_score, 0));
 
-    while (!oSet.isEmpty())
+    const double src_h_score = m_Nodes[0].h_score;
+
+    while (!oSet.empty())
     {
-        qCDebug(KSTARS) << "Next step";
         // Find the node with the lowest f_score value
-        SkyPoint const *curr_node = nullptr;
-        double lowfscore          = 1.0e8;
+        const QueueEntry top = oSet.top();
+        oSet.pop();
 
-        foreach (const SkyPoint *sp, oSet)
-        {
-            if (f_score[sp] < lowfscore)
-            {
-                lowfscore = f_score[sp];
-                curr_node = sp;
-            }
-        }
-        if (curr_node == nullptr)
+        const int curr_node = top.second;
+        HopNode &curr       = m_Nodes[curr_node];
+        if (curr.closed || top.first > curr.g_score + curr.h_score)
             continue;
 
-        qCDebug(KSTARS) << "Lowest fscore (vertex distance-plus-cost score) is " << lowfscore
-                 << " with coords: " << curr_node->ra().toHMSString() << curr_node->dec().toDMSString()
+        qCDebug(KSTARS) << "Lowest fscore (vertex distance-plus-cost score) is " << top.first
+                 << " with coords: " << curr.point->ra().toHMSString() << curr.point->dec().toDMSString()
                  << ". Considering this node now.";
-        if (curr_node == &dest || (curr_node != &src && h_score[curr_node] < 0.5))
+        if (curr_node != 0 && curr.h_score < 0.5)
         {
             // We are at destination
-            reconstructPath(came_from[curr_node]);
+            reconstructPath(curr.came_from);
             qCDebug(KSTARS) << "We've arrived at the destination! Yay! Result path count: " << result_path.count();
 
             // Just a test -- try to print out useful instructions to the debug console. Once we make star hopper unexperimental, we should move this to some sort of a display
@@ -132,60 +136,49 @@ QList<const StarObject *> StarHopper::computePath_const(const SkyPoint &src, con
             return result_path;
         }
 
-        oSet.removeOne(curr_node);
-        cSet.append(curr_node);
+        curr.open   = false;
+        curr.closed = true;
 
         // FIXME: Make sense. If current node ---> dest distance is
         // larger than src --> dest distance by more than 20%, don't
         // even bother considering it.
 
-        if (h_score[curr_node] > h_score[&src] * 1.2)
+        if (curr.h_score > src_h_score * 1.2)
         {
             qCDebug(KSTARS) << "Node under consideration has larger distance to destination (h-score) than start node! "
                         "Ignoring it.";
             continue;
         }
 
-        // Get the list of stars that are neighbours of this node
-        QList<StarObject *> neighbors;
-
-        // FIXME: Actually, this should be done in
-        // HorizontalToEquatorial, but we do it here because SkyPoint
-        // needs a lot of fixing to handle unprecessed and precessed,
-        // equatorial and horizontal coordinates nicely
-        SkyPoint *CurrentNode = const_cast<SkyPoint *>(curr_node);
-        //CurrentNode->deprecess(KStarsData::Instance()->updateNum());
-        CurrentNode->catalogueCoord(KStarsData::Instance()->updateNum()->julianDay());
-        //qCDebug(KSTARS) << "Calling starsInAperture";
-        StarComponent::Instance()->starsInAperture(neighbors, *curr_node, fov, maglim);
-        qCDebug(KSTARS) << "Choosing next node from a set of " << neighbors.count();
-        // Look for the potential next node
-        double curr_g_score = g_score[curr_node];
-
-        for (auto &nhd_node : neighbors)
+        // Look for the potential next node among the stars that are neighbours of this node
+        const double curr_g_score = curr.g_score;
+
+        // N.B. cost() computes neighbour lists of other nodes while we iterate; m_Neighbors is
+        // reserved for one list per node in buildSearchRegion(), so this list is never moved
+        for (const Neighbor &nhd : neighbors(curr_node))
         {
-            if (cSet.contains(nhd_node))
+            HopNode &nhd_node = m_Nodes[nhd.node];
+            if (nhd_node.closed || nhd_node.mag > maglim)
                 continue;
 
             // Compute the tentative g_score
-            double tentative_g_score = curr_g_score + cost(curr_node, nhd_node);
+            double tentative_g_score = curr_g_score + cost(curr_node, nhd.node);
             bool tentative_better;
-            if (!oSet.contains(nhd_node))
+            if (!nhd_node.open)
             {
-                oSet.append(nhd_node);
+                nhd_node.open    = true;
                 tentative_better = true;
             }
-            else if (tentative_g_score < g_score[nhd_node])
+            else if (tentative_g_score < nhd_node.g_score)
                 tentative_better = true;
             else
                 tentative_better = false;
 
             if (tentative_better)
             {
-                came_from[nhd_node] = curr_node;
-                g_score[nhd_node]   = tentative_g_score;
-                h_score[nhd_node]   = nhd_node->angularDistanceTo(&dest).Degrees() / fov;
-                f_score[nhd_node]   = g_score[nhd_node] + h_score[nhd_node];
+                nhd_node.came_from = curr_node;
+                nhd_node.g_score   = tentative_g_score;
+                oSet.push(QueueEntry(nhd_node.g_score + nhd_node.h_score, nhd.node));
             }
         }
     }
@@ -193,83 +186,184 @@ QList<const StarObject *> StarHopper::computePath_const(const SkyPoint &src, con
     return QList<StarObject const *>(); // Return an empty QList
 }
 
-void StarHopper::reconstructPath(SkyPoint const *curr_node)
+bool StarHopper::buildSearchRegion(const SkyPoint &src, const SkyPoint &dest)
 {
-    if (curr_node != start)
+    m_Nodes.clear();
+    m_NodesByZ.clear();
+    m_Neighbors.clear();
+
+    // Nodes farther than 1.2 times the hop length from the destination are
+    // never expanded, so the stars the search can ever reach, and their own
+    // neighbours used by the cost function, all lie within this radius of the
+    // destination. The extra margin absorbs the difference between the
+    // catalogue and the current epoch coordinates used by the aperture test.
+    const double hopLength = src.angularDistanceTo(&dest).Degrees();
+    const double radius    = 1.2 * hopLength + 2 * fov + std::max(fov, 1.0f);
+
+    // FIXME: Actually, this should be done in
+    // HorizontalToEquatorial, but we do it here because SkyPoint
+    // needs a lot of fixing to handle unprecessed and precessed,
+    // equatorial and horizontal coordinates nicely
+    SkyPoint center(dest);
+    center.catalogueCoord(KStarsData::Instance()->updateNum()->julianDay());
+
+    QList<StarObject *> stars;
+    StarComponent::Instance()->starsInAperture(stars, center, radius, maglim + 1.0);
+    qCDebug(KSTARS) << "StarHopper search region of radius" << radius << "degrees holds" << stars.count() << "stars";
+
+    if (stars.isEmpty())
+        return false;
+
+    double sinDec, cosDec, sinRA, cosRA;
+    dest.dec().SinCos(sinDec, cosDec);
+    dest.ra().SinCos(sinRA, cosRA);
+    HopNode endNode;
+    endNode.x = cosDec * cosRA;
+    endNode.y = cosDec * sinRA;
+    endNode.z = sinDec;
+
+    m_Nodes.reserve(stars.count() + 1);
+    auto addNode = [&](SkyPoint const * point, float mag)
     {
-        StarObject const *s = dynamic_cast<StarObject const *>(curr_node);
-        Q_ASSERT(s);
-        result_path.prepend(s);
-        reconstructPath(came_from[s]);
+        HopNode node;
+        point->dec().SinCos(sinDec, cosDec);
+        point->ra().SinCos(sinRA, cosRA);
+        node.point   = point;
+        node.x       = cosDec * cosRA;
+        node.y       = cosDec * sinRA;
+        node.z       = sinDec;
+        node.mag     = mag;
+        node.h_score = distance(node, endNode) / fov;
+        m_Nodes.push_back(node);
+    };
+
+    addNode(&src, 0);
+    for (const StarObject *star : stars)
+    {
+        if (star)
+            addNode(star, star->mag());
     }
+
+    m_Neighbors.reserve(m_Nodes.size());
+    m_NodesByZ.reserve(m_Nodes.size() - 1);
+    for (int i = 1; i < static_cast<int>(m_Nodes.size()); ++i)
+        m_NodesByZ.push_back(i);
+    std::sort(m_NodesByZ.begin(), m_NodesByZ.end(), [this](int a, int b)
+    {
+        return m_Nodes[a].z < m_Nodes[b].z;
+    });
+
+    return true;
 }
 
-float StarHopper::cost(const SkyPoint *curr, const SkyPoint *next)
+const std::vector<StarHopper::Neighbor> &StarHopper::neighbors(int node)
 {
-    // This is a very heuristic method, that tries to produce a cost
-    // for each hop.
+    if (m_Nodes[node].neighbors >= 0)
+        return m_Neighbors[m_Nodes[node].neighbors];
+
+    const HopNode &center = m_Nodes[node];
+    std::vector<Neighbor> list;
 
-    float netcost = 0;
+    // Only stars in the declination band [dec - fov, dec + fov] may be within one FOV
+    const double dec = asin(std::max(-1.0, std::min(1.0, center.z))) * 180.0 / M_PI;
+    const double zlo = sin(std::max(-90.0, dec - fov) * M_PI / 180.0);
+    const double zhi = sin(std::min(90.0, dec + fov) * M_PI / 180.0);
 
-    // Convert 'next' into a StarObject
-    if (next == start)
+    auto first = std::lower_bound(m_NodesByZ.cbegin(), m_NodesByZ.cend(), zlo, [this](int a, double z)
     {
-        // If the next hop is back to square one, junk it
-        return 1e8;
+        return m_Nodes[a].z < z;
+    });
+    for (auto it = first; it != m_NodesByZ.cend() && m_Nodes[*it].z <= zhi; ++it)
+    {
+        if (*it == node)
+            continue;
+        const double d = distance(center, m_Nodes[*it]);
+        if (d <= fov)
+            list.push_back(Neighbor{ *it, d });
     }
-    bool isThisTheEnd = (next == end);
 
-    float magcost, speccost;
-    magcost = speccost = 0;
+    m_Nodes[node].neighbors = static_cast<int>(m_Neighbors.size());
+    m_Neighbors.push_back(std::move(list));
+    return m_Neighbors.back();
+}
 
-    if (!isThisTheEnd)
+double StarHopper::distance(const HopNode &a, const HopNode &b) const
+{
+    // The chord length is better conditioned than the dot product for small angles
+    const double dx    = a.x - b.x;
+    const double dy    = a.y - b.y;
+    const double dz    = a.z - b.z;
+    const double chord = sqrt(dx * dx + dy * dy + dz * dz);
+    return 2.0 * asin(std::min(1.0, chord / 2.0)) * 180.0 / M_PI;
+}
+
+void StarHopper::reconstructPath(int curr_node)
+{
+    while (curr_node > 0)
     {
-        // We ought to be dealing with a star
-        StarObject const *nextstar = dynamic_cast<StarObject const *>(next);
-        Q_ASSERT(nextstar);
-
-        // Test 1: How bright is the star?
-        magcost =
-            nextstar->mag() - 7.0 +
-            5 * log10(
-                    fov); // The brighter, the better. FIXME: 8.0 is now an arbitrary reference to the average faint star. Should actually depend on FOV, something like log( FOV ).
-
-        // Test 2: Is the star strikingly red / yellow coloured?
-        QString SpType = nextstar->sptype();
-        char spclass   = SpType.at(0).toLatin1();
-        speccost       = (spclass == 'G' || spclass == 'K' || spclass == 'M') ? -0.3 : 0;
-        /*
-        // Test 3: Is the star in the general direction of the object?
-        // We use the cosine rule to find the angle between the hop direction, and the direction to destination
-        // a = side joining curr to end
-        // b = side joining curr to next
-        // c = side joining next to end
-        // C = angle between curr-next and curr-end
-        double sina, sinb, cosa, cosb;
-        curr->angularDistanceTo(dest).SinCos( &sina, &cosa );
-        curr->angularDistanceTo(next).SinCos( &sinb, &cosb );
-        double cosc = cos(next->angularDistanceTo(end).radians());
-        double cosC = ( cosc - cosa * cosb ) / (sina * sinb);
-        float dircost;
-        if( cosC < 0 ) // Wrong direction!
-        dircost = 1e8; // Some humongous number;
-        else
-        dircost = sqrt( 1 - cosC * cosC ) / cosC; // tan( C )
-        */
+        StarObject const *s = dynamic_cast<StarObject const *>(m_Nodes[curr_node].point);
+        Q_ASSERT(s);
+        result_path.prepend(s);
+        curr_node = m_Nodes[curr_node].came_from;
     }
+}
+
+float StarHopper::cost(int curr, int next)
+{
+    // This is a very heuristic method, that tries to produce a cost
+    // for each hop.
+
+    // If the next hop is back to square one, junk it
+    if (next == 0)
+        return 1e8;
 
     // Test 4: How far is the hop?
     double distcost =
-        (curr->angularDistanceTo(next).Degrees() /
+        (distance(m_Nodes[curr], m_Nodes[next]) /
          fov); // 1 "magnitude" incremental cost for 1 FOV. Is this even required, or is it just equivalent to halving our distance unit? I think it is required since the hop is not necessarily in the direction of the object -- asimha
 
     // Test 5: How effective is the hop? [Might not be required with A*]
     //    double distredcost = -((src->angularDistanceTo( dest ).Degrees() - next->angularDistanceTo( dest ).Degrees()) * 60 / fov)*3; // 3 "magnitudes" for 1 FOV closer
 
+    float netcost = localCost(next) + distcost;
+    if (netcost < 0)
+        netcost = 0.1; // FIXME: Heuristics aren't supposed to be entirely random. This one is.
+    return netcost;
+}
+
+double StarHopper::localCost(int next)
+{
+    if (m_Nodes[next].has_local_cost)
+        return m_Nodes[next].local_cost;
+
+    // We ought to be dealing with a star
+    StarObject const *nextstar = dynamic_cast<StarObject const *>(m_Nodes[next].point);
+    Q_ASSERT(nextstar);
+
+    float magcost, speccost;
+
+    // Test 1: How bright is the star?
+    magcost =
+        nextstar->mag() - 7.0 +
+        5 * log10(
+                fov); // The brighter, the better. FIXME: 8.0 is now an arbitrary reference to the average faint star. Should actually depend on FOV, something like log( FOV ).
+
+    // Test 2: Is the star strikingly red / yellow coloured?
+    QString SpType = nextstar->sptype();
+    char spclass   = SpType.isEmpty() ? 0 : SpType.at(0).toLatin1();
+    speccost       = (spclass == 'G' || spclass == 'K' || spclass == 'M') ? -0.3 : 0;
+
+    const std::vector<Neighbor> &nextNeighbors = neighbors(next);
+
     // Test 6: Is the destination an asterism? Are there bright stars clustered nearby?
-    QList<StarObject *> localNeighbors;
-    StarComponent::Instance()->starsInAperture(localNeighbors, *next, fov / 10, maglim + 1.0);
-    double stardensitycost = 1 - localNeighbors.count(); // -1 "magnitude" for every neighbouring star
+    // The search region holds all stars down to maglim + 1, and the star itself is part of the count.
+    int localNeighbors = 1;
+    for (const Neighbor &nhd : nextNeighbors)
+    {
+        if (nhd.distance <= fov / 10)
+            ++localNeighbors;
+    }
+    double stardensitycost = 1 - localNeighbors; // -1 "magnitude" for every neighbouring star
 
 // Test 7: Identify star patterns
 
@@ -278,86 +372,84 @@ float StarHopper::cost(const SkyPoint *curr, const SkyPoint *next)
 
     double patterncost = 0;
     QString patternName;
-    if (!isThisTheEnd)
+
+    // Use a larger aperture for pattern identification; max 1.0 mag difference
+    std::vector<Neighbor> similar;
+    for (const Neighbor &nhd : nextNeighbors)
     {
-        // We ought to be dealing with a star
-        StarObject const *nextstar = dynamic_cast<StarObject const *>(next);
-        Q_ASSERT(nextstar);
+        if (fabs(m_Nodes[nhd.node].mag - nextstar->mag()) <= 1.0)
+            similar.push_back(nhd);
+    }
 
-        float factor = 1.0;
-        while (factor <= 10.0)
+    QList<StarObject const *> patternNeighbors;
+    float factor = 1.0;
+    while (factor <= 10.0)
+    {
+        patternNeighbors.clear();
+        for (const Neighbor &nhd : similar)
         {
-            localNeighbors.clear();
-            StarComponent::Instance()->starsInAperture(
-                localNeighbors, *next, fov / factor,
-                nextstar->mag() + 1.0); // Use a larger aperture for pattern identification; max 1.0 mag difference
-            foreach (StarObject *star, localNeighbors)
-            {
-                if (star == nextstar)
-                    localNeighbors.removeOne(star);
-                else if (fabs(star->mag() - nextstar->mag()) > 1.0)
-                    localNeighbors.removeOne(star);
-            } // Now, we should have a pruned list
-            factor += 1.0;
-            if (localNeighbors.size() == 2)
-                break;
+            if (nhd.distance <= fov / factor)
+                patternNeighbors.append(static_cast<StarObject const *>(m_Nodes[nhd.node].point));
+        } // Now, we should have a pruned list
+        factor += 1.0;
+        if (patternNeighbors.size() == 2)
+            break;
+    }
+    factor -= 1.0;
+    if (patternNeighbors.size() == 2)
+    {
+        patternName = i18n("triangle (of similar magnitudes)"); // any three stars form a triangle!
+        // Try to find triangles. Note that we assume that the standard Euclidian metric works on a sphere for small angles, i.e. the celestial sphere is nearly flat over our FOV.
+        StarObject const *star1 = patternNeighbors[0];
+        double dRA1             = nextstar->ra().radians() - star1->ra().radians();
+        double dDec1            = nextstar->dec().radians() - star1->dec().radians();
+        double dist1sqr         = dRA1 * dRA1 + dDec1 * dDec1;
+
+        StarObject const *star2 = patternNeighbors[1];
+        double dRA2             = nextstar->ra().radians() - star2->ra().radians();
+        double dDec2            = nextstar->dec().radians() - star2->dec().radians();
+        double dist2sqr         = dRA2 * dRA2 + dDec2 * dDec2;
+
+        // Check for right-angled triangles (without loss of generality, right angle is at this vertex)
+        if (fabs((dRA1 * dRA2 - dDec1 * dDec2) / sqrt(dist1sqr * dist2sqr)) < RIGHT_ANGLE_THRESHOLD)
+        {
+            // We have a right angled triangle! Give -3 magnitudes!
+            patterncost += -3;
+            patternName = i18n("right-angled triangle");
         }
-        factor -= 1.0;
-        if (localNeighbors.size() == 2)
+
+        // Check for isosceles triangles (without loss of generality, this is the vertex)
+        if (fabs((dist1sqr - dist2sqr) / (dist1sqr)) < EQUAL_EDGE_THRESHOLD)
         {
-            patternName = i18n("triangle (of similar magnitudes)"); // any three stars form a triangle!
-            // Try to find triangles. Note that we assume that the standard Euclidian metric works on a sphere for small angles, i.e. the celestial sphere is nearly flat over our FOV.
-            StarObject *star1 = localNeighbors[0];
-            double dRA1       = nextstar->ra().radians() - star1->ra().radians();
-            double dDec1      = nextstar->dec().radians() - star1->dec().radians();
-            double dist1sqr   = dRA1 * dRA1 + dDec1 * dDec1;
-
-            StarObject *star2 = localNeighbors[1];
-            double dRA2       = nextstar->ra().radians() - star2->ra().radians();
-            double dDec2      = nextstar->dec().radians() - star2->dec().radians();
-            double dist2sqr   = dRA2 * dRA2 + dDec2 * dDec2;
-
-            // Check for right-angled triangles (without loss of generality, right angle is at this vertex)
-            if (fabs((dRA1 * dRA2 - dDec1 * dDec2) / sqrt(dist1sqr * dist2sqr)) < RIGHT_ANGLE_THRESHOLD)
+            patterncost += -1;
+            patternName = i18n("isosceles triangle");
+            if (fabs((dRA2 * dDec1 - dRA1 * dDec2) / sqrt(dist1sqr * dist2sqr)) < RIGHT_ANGLE_THRESHOLD)
             {
-                // We have a right angled triangle! Give -3 magnitudes!
-                patterncost += -3;
-                patternName = i18n("right-angled triangle");
+                patterncost += -1;
+                patternName = i18n("straight line of 3 stars");
             }
-
-            // Check for isosceles triangles (without loss of generality, this is the vertex)
-            if (fabs((dist1sqr - dist2sqr) / (dist1sqr)) < EQUAL_EDGE_THRESHOLD)
+            // Check for equilateral triangles
+            double dist3    = star1->angularDistanceTo(star2).radians();
+            double dist3sqr = dist3 * dist3;
+            if (fabs((dist3sqr - dist1sqr) / dist1sqr) < EQUAL_EDGE_THRESHOLD)
             {
                 patterncost += -1;
-                patternName = i18n("isosceles triangle");
-                if (fabs((dRA2 * dDec1 - dRA1 * dDec2) / sqrt(dist1sqr * dist2sqr)) < RIGHT_ANGLE_THRESHOLD)
-                {
-                    patterncost += -1;
-                    patternName = i18n("straight line of 3 stars");
-                }
-                // Check for equilateral triangles
-                double dist3    = star1->angularDistanceTo(star2).radians();
-                double dist3sqr = dist3 * dist3;
-                if (fabs((dist3sqr - dist1sqr) / dist1sqr) < EQUAL_EDGE_THRESHOLD)
-                {
-                    patterncost += -1;
-                    patternName = i18n("equilateral triangle");
-                }
+                patternName = i18n("equilateral triangle");
             }
         }
-        // TODO: Identify squares.
-        if (!patternName.isEmpty())
-        {
-            patternName += i18n(" within %1% of FOV of the marked star", (int)(100.0 / factor));
-            patternNames.insert(nextstar, patternName);
-        }
+    }
+    // TODO: Identify squares.
+    if (!patternName.isEmpty())
+    {
+        patternName += i18n(" within %1% of FOV of the marked star", (int)(100.0 / factor));
+        patternNames.insert(nextstar, patternName);
     }
 
-    netcost = magcost + speccost + distcost + stardensitycost + patterncost;
-    if (netcost < 0)
-        netcost = 0.1; // FIXME: Heuristics aren't supposed to be entirely random. This one is.
-    qCDebug(KSTARS) << "Mag cost: " << magcost << "; Spec Cost: " << speccost << "; Dist Cost: " << distcost
-             << "; Density cost: " << stardensitycost << "; Pattern cost: " << patterncost << "; Net cost: " << netcost
-             << "; Pattern: " << patternName;
+    const double netcost = magcost + speccost + stardensitycost + patterncost;
+    qCDebug(KSTARS) << "Mag cost: " << magcost << "; Spec Cost: " << speccost << "; Density cost: " << stardensitycost
+             << "; Pattern cost: " << patterncost << "; Local cost: " << netcost << "; Pattern: " << patternName;
+
+    m_Nodes[next].local_cost     = netcost;
+    m_Nodes[next].has_local_cost = true;
     return netcost;
 }
@@ -20,6 +20,8 @@
 #include <QHash>
 #include <QList>
 
+#include <vector>
+
 class QStringList;
 
 class SkyPoint;
@@ -54,21 +56,75 @@ class StarHopper
                                                 QStringList *metadata = nullptr);
 
   private:
+    /**
+     * @short A node of the A* search graph
+     *
+     * Nodes are stored contiguously in m_Nodes. Node 0 is the source of the
+     * hop, all other nodes are stars inside the search region. Stars down to
+     * maglim + 1 are kept so that the local star density and pattern tests
+     * of the cost function can be answered without further catalog queries,
+     * but only those brighter than maglim are used as hops.
+     */
+    struct HopNode
+    {
+        SkyPoint const *point { nullptr };
+        // Unit vector of the (RA, Dec) of the point, used for fast distances
+        double x { 0 }, y { 0 }, z { 0 };
+        float mag { 0 };
+        double g_score { 0 };
+        double h_score { 0 };
+        // Cost of hopping onto this node that does not depend on where we come from.
+        // Negative magnitude costs are allowed, hence the separate flag.
+        double local_cost { 0 };
+        bool has_local_cost { false };
+        int came_from { -1 };
+        bool open { false };
+        bool closed { false };
+        // Index into m_Neighbors, or -1 if the neighbours were not computed yet
+        int neighbors { -1 };
+    };
+
+    /** A neighbour of a node within one FOV, with its angular distance in degrees */
+    struct Neighbor
+    {
+        int node;
+        double distance;
+    };
+
+    /**
+     * @short Fetches all stars of the search region with a single catalog query
+     * @return false if no stars could be found
+     */
+    bool buildSearchRegion(const SkyPoint &src, const SkyPoint &dest);
+
+    /**
+     * @short Returns the list of nodes within one FOV of the given node,
+     * computing it on the first request.
+     */
+    const std::vector<Neighbor> &neighbors(int node);
+
+    /** @return the angular distance in degrees between two nodes */
+    double distance(const HopNode &a, const HopNode &b) const;
+
     /**
      * @short The cost function for hopping from current position to the a given star, in view of the final destination
-     * @param curr Source SkyPoint
-     * @param next Next point in the hop.
-     * @note If 'next' is neither the starting point of the hop, nor
-     * the ending point, it _has_ to be a StarObject. A dynamic cast
-     * followed by a Q_ASSERT will ensure this.
+     * @param curr Index of the source node
+     * @param next Index of the next node in the hop.
+     * @note 'next' is always a star, the source node is never hopped back to.
+     */
+    float cost(int curr, int next);
+
+    /**
+     * @short Computes the part of the cost function that only depends on the
+     * star hopped onto: brightness, colour, local star density and patterns.
      */
-    float cost(const SkyPoint *curr, const SkyPoint *next);
+    double localCost(int next);
 
     /**
      * @short For internal use by the A* Search Algorithm. Completes
      * the star-hop path. See https://en.wikipedia.org/wiki/A*_search_algorithm for details
      */
-    void reconstructPath(SkyPoint const *curr_node);
+    void reconstructPath(int curr_node);
 
     float fov { 0 };
     float maglim { 0 };
@@ -76,7 +132,9 @@ class StarHopper
     // Useful for internal computations
     SkyPoint const *start { nullptr };
     SkyPoint const *end { nullptr };
-    QHash<const SkyPoint *, const SkyPoint *> came_from; // Used by the A* search algorithm
+    std::vector<HopNode> m_Nodes;                  // Node 0 is the source
+    std::vector<int> m_NodesByZ;                   // Node indices sorted by z, for declination band lookups
+    std::vector<std::vector<Neighbor>> m_Neighbors; // Neighbour lists, shared by the search and the cost function
     QList<StarObject const *> result_path;
     QHash<SkyPoint const *, QString> patternNames; // if patterns were identified, they are added to this hash.
 };
@@ -0,0 +1,208 @@
+/***************************************************************************
+               visibilityengine.cpp  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (C) 2026 by KStars Developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "visibilityengine.h"
+
+#include "Options.h"
+#include "skyobjects/skyobject.h"
+
+#include <QtConcurrent>
+
+#include <cmath>
+
+namespace
+{
+// A point whose apparent coordinates are computed without the bending of light by the Sun,
+// which is the only part of SkyPoint::updateCoords() writing shared data.
+class UnbentPoint : public SkyPoint
+{
+  public:
+    UnbentPoint(const dms &ra0, const dms &dec0) : SkyPoint(ra0, dec0) {}
+
+    void update(const KSNumbers *num)
+    {
+        precess(num);
+        nutate(num);
+        aberrate(num);
+    }
+};
+
+QPair<double, double> catalogCoordinates(const SkyObject *o)
+{
+    return qMakePair(o->ra0().Degrees(), o->dec0().Degrees());
+}
+}
+
+VisibilityEngine::VisibilityEngine(const GeoLocation *geo, const KStarsDateTime &midnightUT)
+    : m_Geo(*geo), m_Latitude(geo->lat()->Degrees()), m_MidnightUT(midnightUT), m_Num(midnightUT.djd())
+{
+}
+
+bool VisibilityEngine::isForNight(const GeoLocation *geo, const KStarsDateTime &midnightUT) const
+{
+    return m_Latitude == geo->lat()->Degrees() && m_Geo.lng()->Degrees() == geo->lng()->Degrees() &&
+           m_MidnightUT.djd() == midnightUT.djd();
+}
+
+double VisibilityEngine::visibleFraction(const SkyObject *o, const KStarsDateTime &startUT,
+                                         const KStarsDateTime &endUT, double minAlt, double maxAlt)
+{
+    const QPair<double, double> coords = apparentCoordinates(o);
+    return visibleFraction(coords.first, coords.second, startUT, endUT, minAlt, maxAlt);
+}
+
+QVector<double> VisibilityEngine::visibleFractions(const QVector<const SkyObject *> &objects,
+                                                   const KStarsDateTime &startUT, const KStarsDateTime &endUT,
+                                                   double minAlt, double maxAlt)
+{
+    QVector<QPair<double, double>> coords(objects.size());
+    QVector<int> missing;
+
+    // Solar system bodies use the shared orbital data and are positioned on this
+    // thread; cached coordinates of the other objects are picked up here as well.
+    for (int i = 0; i < objects.size(); ++i)
+    {
+        const SkyObject *o = objects[i];
+        if (o->isSolarSystem() || m_Coordinates.contains(catalogCoordinates(o)))
+            coords[i] = apparentCoordinates(o);
+        else
+            missing.append(i);
+    }
+
+    // Precession, nutation and aberration of the remaining objects only read
+    // the shared KSNumbers, so they are computed in parallel.
+    QtConcurrent::blockingMap(missing, [&](int i)
+    {
+        coords[i] = precessed(objects[i], false);
+    });
+
+    // The few objects close enough to the Sun for their light to bend are done again here.
+    if (Options::useRelativistic())
+    {
+        for (int i : missing)
+        {
+            SkyPoint p(coords[i].first / 15.0, coords[i].second);
+            if (p.checkBendLight())
+                coords[i] = precessed(objects[i], true);
+        }
+    }
+
+    for (int i : missing)
+        m_Coordinates.insert(catalogCoordinates(objects[i]), coords[i]);
+
+    QVector<double> fractions(objects.size());
+    for (int i = 0; i < objects.size(); ++i)
+        fractions[i] = visibleFraction(coords[i].first, coords[i].second, startUT, endUT, minAlt, maxAlt);
+
+    return fractions;
+}
+
+double VisibilityEngine::visibleFraction(double ra, double dec, const KStarsDateTime &startUT,
+                                         const KStarsDateTime &endUT, double minAlt, double maxAlt) const
+{
+    // Hour angle at the start of the range, and the hour angle swept during the range
+    const double H1     = m_Geo.GSTtoLST(startUT.gst()).Degrees() - ra;
+    const double length = static_cast<double>(endUT.djd() - startUT.djd()) * 360.0 * SIDEREALSECOND;
+
+    if (length <= 0)
+    {
+        // Degenerate range, check the single instant
+        const double DegToRad = M_PI / 180.0;
+        const double alt = asin(sin(m_Latitude * DegToRad) * sin(dec * DegToRad) +
+                                cos(m_Latitude * DegToRad) * cos(dec * DegToRad) * cos(H1 * DegToRad)) / DegToRad;
+        return (alt >= minAlt && alt <= maxAlt) ? 1.0 : 0.0;
+    }
+
+    const double minH0 = crossingHourAngle(dec, minAlt);
+    const double maxH0 = crossingHourAngle(dec, maxAlt);
+
+    // Time above minAlt, minus the time spent above maxAlt
+    const double visible = hourAngleOverlap(H1, length, minH0) - hourAngleOverlap(H1, length, maxH0);
+    return std::max(0.0, std::min(1.0, visible / length));
+}
+
+QPair<double, double> VisibilityEngine::apparentCoordinates(const SkyObject *o)
+{
+    if (o->isSolarSystem())
+    {
+        // Moving objects are not cached, their elements may be updated at any time
+        SkyPoint p = o->recomputeCoords(m_MidnightUT, &m_Geo);
+        return qMakePair(p.ra().Degrees(), p.dec().Degrees());
+    }
+
+    auto it = m_Coordinates.constFind(catalogCoordinates(o));
+    if (it != m_Coordinates.constEnd())
+        return it.value();
+
+    const QPair<double, double> coords = precessed(o, true);
+    m_Coordinates.insert(catalogCoordinates(o), coords);
+    return coords;
+}
+
+QPair<double, double> VisibilityEngine::precessed(const SkyObject *o, bool bendLight) const
+{
+    if (bendLight)
+    {
+        SkyPoint p(o->ra0(), o->dec0());
+        p.updateCoordsNow(&m_Num);
+        return qMakePair(p.ra().Degrees(), p.dec().Degrees());
+    }
+
+    UnbentPoint p(o->ra0(), o->dec0());
+    p.update(&m_Num);
+    return qMakePair(p.ra().Degrees(), p.dec().Degrees());
+}
+
+double VisibilityEngine::crossingHourAngle(double dec, double alt) const
+{
+    const double DegToRad = M_PI / 180.0;
+    const double sinLat = sin(m_Latitude * DegToRad), cosLat = cos(m_Latitude * DegToRad);
+    const double sinDec = sin(dec * DegToRad), cosDec = cos(dec * DegToRad);
+    const double sinAlt = sin(alt * DegToRad);
+
+    // sin(alt) = sin(lat) sin(dec) + cos(lat) cos(dec) cos(H)
+    const double denominator = cosLat * cosDec;
+    if (fabs(denominator) < 1e-12)
+        // At the poles, or for a point at a pole, the altitude does not change
+        return sinLat * sinDec >= sinAlt ? 180.0 : -1.0;
+
+    const double cosH = (sinAlt - sinLat * sinDec) / denominator;
+    if (cosH <= -1.0)
+        return 180.0;
+    if (cosH > 1.0)
+        return -1.0;
+    return acos(cosH) / DegToRad;
+}
+
+double VisibilityEngine::hourAngleOverlap(double H1, double length, double H0)
+{
+    if (H0 < 0)
+        return 0;
+    if (H0 >= 180.0)
+        return length;
+
+    // The hour angle is within [-H0, H0] around each meridian transit at 360k degrees
+    const double H2 = H1 + length;
+    double overlap  = 0;
+    for (int k = static_cast<int>(floor((H1 - H0) / 360.0)); k <= static_cast<int>(ceil((H2 + H0) / 360.0)); ++k)
+    {
+        const double lo = std::max(H1, 360.0 * k - H0);
+        const double hi = std::min(H2, 360.0 * k + H0);
+        if (hi > lo)
+            overlap += hi - lo;
+    }
+    return overlap;
+}
@@ -0,0 +1,121 @@
+/***************************************************************************
+                visibilityengine.h  -  K Desktop Planetarium
+                             -------------------
+    begin                : Sun 18 Oct 2026
+    copyright            : (C) 2026 by KStars Developers
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include "geolocation.h"
+#include "kstarsdatetime.h"
+#include "ksnumbers.h"
+
+#include <QHash>
+#include <QPair>
+#include <QVector>
+
+class SkyObject;
+class SkyPoint;
+
+/**
+ * @class VisibilityEngine
+ * @short Evaluates how long objects stay within an altitude range during a night.
+ *
+ * Instead of recomputing the coordinates of every object for each hour of the
+ * night, the apparent coordinates are computed once for the middle of the night,
+ * and the time spent between two altitudes is derived analytically from the
+ * hour angle at which the object crosses them. Catalogs are evaluated in
+ * parallel batches, and the apparent coordinates of objects outside the solar
+ * system are cached for the night, by catalog coordinates, so that refreshing
+ * the What's Up Tonight dialog or refining the observing list wizard filters is
+ * nearly free. Each dialog owns its engine, which only lives as long as it does.
+ *
+ * Solar system bodies are evaluated at their position in the middle of the
+ * night, which is accurate to a few minutes for all of them but the Moon.
+ *
+ * An engine is not meant to be used from several threads at once, batches are
+ * parallelized internally.
+ */
+class VisibilityEngine
+{
+  public:
+    /**
+     * @short Constructor
+     * @param geo the location of the observer
+     * @param midnightUT the universal time of the middle of the night
+     */
+    VisibilityEngine(const GeoLocation *geo, const KStarsDateTime &midnightUT);
+
+    /** @return true if this engine evaluates the night around the given midnight at the given location */
+    bool isForNight(const GeoLocation *geo, const KStarsDateTime &midnightUT) const;
+
+    /**
+     * @short Computes the fraction of a time range during which an object lies between two altitudes
+     * @param o the object to evaluate
+     * @param startUT start of the time range
+     * @param endUT end of the time range
+     * @param minAlt lowest altitude in degrees
+     * @param maxAlt highest altitude in degrees
+     * @return the fraction of the range, between 0 and 1, during which minAlt <= alt <= maxAlt
+     */
+    double visibleFraction(const SkyObject *o, const KStarsDateTime &startUT, const KStarsDateTime &endUT,
+                           double minAlt, double maxAlt = 90.0);
+
+    /**
+     * @short Batch version of visibleFraction(), evaluating objects in parallel
+     * @return the visible fractions, in the order of the objects
+     */
+    QVector<double> visibleFractions(const QVector<const SkyObject *> &objects, const KStarsDateTime &startUT,
+                                     const KStarsDateTime &endUT, double minAlt, double maxAlt = 90.0);
+
+    /**
+     * @short Computes the fraction of a time range during which a fixed position lies between two altitudes
+     * @param ra apparent right ascension, in degrees
+     * @param dec apparent declination, in degrees
+     * @note This is the analytic core of the engine, exposed for testing.
+     */
+    double visibleFraction(double ra, double dec, const KStarsDateTime &startUT, const KStarsDateTime &endUT,
+                           double minAlt, double maxAlt = 90.0) const;
+
+  private:
+    /** @return the apparent (RA, Dec) of the object for this night, in degrees */
+    QPair<double, double> apparentCoordinates(const SkyObject *o);
+
+    /**
+     * @return apparent (RA, Dec) of a fixed object at the epoch of the engine
+     * @param bendLight whether to correct for the bending of light by the Sun when enabled.
+     * Only the calling thread may do so, as it sets up the Sun shared by all the points.
+     */
+    QPair<double, double> precessed(const SkyObject *o, bool bendLight) const;
+
+    /**
+     * @return the length, in degrees of hour angle, of the part of [H1, H1 + length]
+     * during which the hour angle lies within [-H0, H0], modulo 360 degrees
+     */
+    static double hourAngleOverlap(double H1, double length, double H0);
+
+    /**
+     * @return the hour angle in degrees at which a point at declination dec crosses
+     * the given altitude; 180 if it is always above, -1 if it is always below
+     */
+    double crossingHourAngle(double dec, double alt) const;
+
+    // A copy, as the location may be edited while the dialog is open
+    GeoLocation m_Geo;
+    double m_Latitude { 0 };
+    KStarsDateTime m_MidnightUT;
+    KSNumbers m_Num;
+    // Apparent coordinates by catalog coordinates, which unlike the objects stay valid
+    // when catalogs are reloaded
+    QHash<QPair<double, double>, QPair<double, double>> m_Coordinates;
+};
@@ -26,6 +26,7 @@
 #include "skyobjects/ksmoon.h"
 #include "skycomponents/skymapcomposite.h"
 #include "tools/observinglist.h"
+#include "tools/visibilityengine.h"
 
 WUTDialogUI::WUTDialogUI(QWidget *p) : QFrame(p)
 {
@@ -127,6 +128,10 @@ void WUTDialog::init()
         m_CategoryInitialized[c] = false;
     }
 
+    // Location or date may have changed, coordinates of the objects are kept for the night
+    if (!m_Visibility || !m_Visibility->isForNight(geo, UT0))
+        m_Visibility.reset(new VisibilityEngine(geo, UT0));
+
     // sun almanac information
     KSSun *oSun     = dynamic_cast<KSSun *>(data->objectNamed(i18n("Sun")));
 
@@ -269,85 +274,90 @@ void WUTDialog::slotLoadList(const QString &c)
     {
         if (c == m_Categories[0]) //Planets
         {
+            QVector<const SkyObject *> planets;
             foreach (const QString &name, data->skyComposite()->objectNames(SkyObject::PLANET))
-            {
-                SkyObject *o = data->skyComposite()->findByName(name);
-
-                if (checkVisibility(o) && o->mag() <= m_Mag)
-                    visibleObjects(c).insert(o);
-            }
+                planets.append(data->skyComposite()->findByName(name));
 
+            insertVisible(c, planets);
             m_CategoryInitialized[c] = true;
         }
 
         else if (c == m_Categories[1]) //Stars
         {
-
             QVector<QPair<QString, const SkyObject *>> starObjects;
             starObjects.append(data->skyComposite()->objectLists(SkyObject::STAR));
             starObjects.append(data->skyComposite()->objectLists(SkyObject::CATALOG_STAR));
 
+            QVector<const SkyObject *> stars;
+            stars.reserve(starObjects.size());
             for (const auto &object : starObjects)
-            {
-                const SkyObject *o =  object.second;
+                stars.append(object.second);
 
-                if (checkVisibility(o) && o->mag() <= m_Mag)
-                {
-                    visibleObjects(c).insert(o);
-                }
-            }
+            insertVisible(c, stars);
             m_CategoryInitialized[c] = true;
         }
 
         else if (c == m_Categories[5]) //Constellations
         {
+            QVector<const SkyObject *> constellations;
             foreach (SkyObject *o, data->skyComposite()->constellationNames())
-                if (checkVisibility(o))
-                    visibleObjects(c).insert(o);
+                constellations.append(o);
 
+            insertVisible(c, constellations, false);
             m_CategoryInitialized[c] = true;
         }
 
         else if (c == m_Categories[6]) //Asteroids
         {
+            QVector<const SkyObject *> asteroids;
             foreach (SkyObject *o, data->skyComposite()->asteroids())
-                if (checkVisibility(o) && o->name() != i18nc("Asteroid name (optional)", "Pluto") && o->mag() <= m_Mag)
-                    visibleObjects(c).insert(o);
+                if (o->name() != i18nc("Asteroid name (optional)", "Pluto"))
+                    asteroids.append(o);
 
+            insertVisible(c, asteroids);
             m_CategoryInitialized[c] = true;
         }
 
         else if (c == m_Categories[7]) //Comets
         {
+            QVector<const SkyObject *> comets;
             foreach (SkyObject *o, data->skyComposite()->comets())
-                if (checkVisibility(o) && o->mag() <= m_Mag)
-                    visibleObjects(c).insert(o);
+                comets.append(o);
 
+            insertVisible(c, comets);
             m_CategoryInitialized[c] = true;
         }
 
         else //all deep-sky objects, need to split clusters, nebulae and galaxies
         {
+            QVector<const SkyObject *> dsos;
             foreach (DeepSkyObject *dso, data->skyComposite()->deepSkyObjects())
             {
-                SkyObject *o = (SkyObject *)dso;
-                if (checkVisibility(o) && o->mag() <= m_Mag)
+                if (dso->mag() <= m_Mag)
+                    dsos.append(dso);
+            }
+
+            const QVector<bool> visible = checkVisibility(dsos);
+            for (int i = 0; i < dsos.size(); ++i)
+            {
+                if (!visible[i])
+                    continue;
+
+                const SkyObject *o = dsos[i];
+                switch (o->type())
                 {
-                    switch (o->type())
-                    {
-                        case SkyObject::OPEN_CLUSTER: //fall through
-                        case SkyObject::GLOBULAR_CLUSTER:
-                            visibleObjects(m_Categories[4]).insert(o); //star clusters
-                            break;
-                        case SkyObject::GASEOUS_NEBULA:   //fall through
-                        case SkyObject::PLANETARY_NEBULA: //fall through
-                        case SkyObject::SUPERNOVA_REMNANT:
-                            visibleObjects(m_Categories[2]).insert(o); //nebulae
-                            break;
-                        case SkyObject::GALAXY:
-                            visibleObjects(m_Categories[3]).insert(o); //galaxies
-                            break;
-                    }
+                    case SkyObject::OPEN_CLUSTER: //fall through
+                    case SkyObject::GLOBULAR_CLUSTER:
+                        visibleObjects(m_Categories[4]).insert(o); //star clusters
+                        break;
+                    case SkyObject::GASEOUS_NEBULA:   //fall through
+                    case SkyObject::PLANETARY_NEBULA: //fall through
+                    case SkyObject::SUPERNOVA_REMNANT:
+                        visibleObjects(m_Categories[2]).insert(o); //nebulae
+                        break;
+                    case SkyObject::GALAXY:
+                        visibleObjects(m_Categories[3]).insert(o); //galaxies
+                        break;
                 }
             }
 
@@ -372,15 +382,26 @@ void WUTDialog::slotLoadList(const QString &c)
     }
 }
 
-bool WUTDialog::checkVisibility(const SkyObject *o)
+void WUTDialog::insertVisible(const QString &category, const QVector<const SkyObject *> &objects, bool checkMagnitude)
 {
-    bool visible(false);
-    double minAlt = 6.0; //An object is considered 'visible' if it is above horizon during civil twilight.
+    QVector<const SkyObject *> candidates;
+    candidates.reserve(objects.size());
+    for (const SkyObject *o : objects)
+    {
+        if (o && (!checkMagnitude || o->mag() <= m_Mag))
+            candidates.append(o);
+    }
 
-    // reject objects that never rise
-    if (o->checkCircumpolar(geo->lat()) == true && o->alt().Degrees() <= 0)
-        return false;
+    const QVector<bool> visible = checkVisibility(candidates);
+    for (int i = 0; i < candidates.size(); ++i)
+    {
+        if (visible[i])
+            visibleObjects(category).insert(candidates[i]);
+    }
+}
 
+void WUTDialog::nightWindow(KStarsDateTime &startUT, KStarsDateTime &endUT) const
+{
     //Initial values for T1, T2 assume all night option of EveningMorningBox
     KStarsDateTime T1 = Evening;
     T1.setTime(sunSetToday);
@@ -397,23 +418,31 @@ bool WUTDialog::checkVisibility(const SkyObject *o)
         T1 = T0; //midnight
     }
 
-    for (KStarsDateTime test = T1; test < T2; test = test.addSecs(3600))
-    {
-        //Need LST of the test time, expressed as a dms object.
-        KStarsDateTime ut = geo->LTtoUT(test);
-        dms LST           = geo->GSTtoLST(ut.gst());
-        SkyPoint sp       = o->recomputeCoords(ut, geo);
+    startUT = geo->LTtoUT(T1);
+    endUT   = geo->LTtoUT(T2);
+}
 
-        //check altitude of object at this time.
-        sp.EquatorialToHorizontal(&LST, geo->lat());
+bool WUTDialog::checkVisibility(const SkyObject *o)
+{
+    return checkVisibility(QVector<const SkyObject *> { o }).first();
+}
 
-        if (sp.alt().Degrees() > minAlt)
-        {
-            visible = true;
-            break;
-        }
-    }
+QVector<bool> WUTDialog::checkVisibility(const QVector<const SkyObject *> &objects)
+{
+    double minAlt = 6.0; //An object is considered 'visible' if it is above horizon during civil twilight.
+
+    if (!m_Visibility || !m_Visibility->isForNight(geo, UT0))
+        m_Visibility.reset(new VisibilityEngine(geo, UT0));
+
+    KStarsDateTime startUT, endUT;
+    nightWindow(startUT, endUT);
+
+    // Objects are visible if they spend any time above minAlt during the selected part of the night
+    const QVector<double> fractions = m_Visibility->visibleFractions(objects, startUT, endUT, minAlt);
 
+    QVector<bool> visible(objects.size());
+    for (int i = 0; i < objects.size(); ++i)
+        visible[i] = fractions[i] > 0;
     return visible;
 }
 
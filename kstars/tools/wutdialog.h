@@ -24,8 +24,11 @@
 #include <QFrame>
 #include <QDialog>
 
+#include <memory>
+
 class GeoLocation;
 class SkyObject;
+class VisibilityEngine;
 
 class WUTDialogUI : public QFrame, public Ui::WUTDialog
 {
@@ -61,6 +64,13 @@ class WUTDialog : public QDialog
      */
     bool checkVisibility(const SkyObject *o);
 
+    /**
+     * @short Check visibility of a batch of objects, evaluated in parallel
+     * @p objects the objects to check
+     * @return for each object, true if visible
+     */
+    QVector<bool> checkVisibility(const QVector<const SkyObject *> &objects);
+
   public slots:
     /**
      * @short Determine which objects are visible, and store them in
@@ -119,6 +129,10 @@ class WUTDialog : public QDialog
     void makeConnections();
     /** @short Initialize category list, used in constructor */
     void initCategories();
+    /** @short Compute the part of the night selected with the EveningMorningBox, in UT */
+    void nightWindow(KStarsDateTime &startUT, KStarsDateTime &endUT) const;
+    /** @short Add the visible objects among the list, brighter than the magnitude limit, to a category */
+    void insertVisible(const QString &category, const QVector<const SkyObject *> &objects, bool checkMagnitude = true);
 
     WUTDialogUI *WUT { nullptr };
     bool session { false };
@@ -131,4 +145,5 @@ class WUTDialog : public QDialog
     QStringList m_Categories;
     QHash<QString, QSet<const SkyObject *>> m_VisibleList;
     QHash<QString, bool> m_CategoryInitialized;
+    std::shared_ptr<VisibilityEngine> m_Visibility;
 };